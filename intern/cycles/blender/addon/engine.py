@@ -11,6 +11,9 @@ def _configure_argument_parser():
     parser.add_argument("--cycles-print-stats",
                         help="Print rendering statistics to stderr",
                         action='store_true')
+    parser.add_argument("--cycles-stats-json",
+                        help="Append rendering statistics in JSON format to the given file, one line per rendered view",
+                        default=None)
     parser.add_argument("--cycles-device",
                         help="Set the device to use for Cycles, overriding user preferences and the scene setting."
                              "Valid options are 'CPU', 'CUDA', 'OPTIX', 'HIP', 'ONEAPI', or 'METAL'."
@@ -33,6 +36,10 @@ def _parse_command_line():
         import _cycles
         _cycles.enable_print_stats()
 
+    if args.cycles_stats_json:
+        import _cycles
+        _cycles.set_render_stats_filepath(args.cycles_stats_json)
+
     if args.cycles_device:
         import _cycles
         _cycles.set_device_override(args.cycles_device)
@@ -597,6 +597,14 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=128,
     )
 
+    reuse_guiding_field: BoolProperty(
+        name="Reuse Guiding Field",
+        description="Keep the trained guiding field when the scene changes, and continue training it instead "
+        "of starting over. Speeds up convergence of similar consecutive frames when rendering animations "
+        "with persistent data, and of viewport rendering",
+        default=False,
+    )
+
     volume_guiding_probability: FloatProperty(
         name="Volume Guiding Probability",
         description="The probability of guiding a direction inside a volume",
@@ -859,6 +867,16 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         unit='LENGTH'
     )
 
+    hair_simplify_distance: FloatProperty(
+        name="Hair Simplify Distance",
+        description="Reduce the number of hair curves of objects further away from the camera than this "
+        "distance, using thicker curves to keep a similar look. The number of curves halves every time "
+        "the distance doubles (0 disables)",
+        default=0.0,
+        min=0.0,
+        unit='LENGTH'
+    )
+
     motion_blur_position: EnumProperty(
         name="Motion Blur Position",
         default='CENTER',
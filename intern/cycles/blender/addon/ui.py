@@ -315,6 +315,7 @@ class CYCLES_RENDER_PT_sampling_path_guiding(CyclesButtonsPanel, Panel):
         layout.active = cscene.use_guiding
 
         layout.prop(cscene, "guiding_training_samples")
+        layout.prop(cscene, "reuse_guiding_field")
 
         col = layout.column(align=True)
         col.prop(cscene, "use_surface_guiding", text="Surface")
@@ -2226,6 +2227,8 @@ class CYCLES_RENDER_PT_simplify_culling(CyclesButtonsPanel, Panel):
         sub.active = cscene.use_distance_cull
         sub.prop(cscene, "distance_cull_margin", text="")
 
+        layout.prop(cscene, "hair_simplify_distance", text="Hair Distance")
+
 
 class CyclesShadingButtonsPanel(CyclesButtonsPanel):
     bl_space_type = 'VIEW_3D'
@@ -67,6 +67,7 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
                                      BObjectInfo &b_ob_info,
                                      bool object_updated,
                                      bool use_particle_hair,
+                                     float hair_simplify_fraction,
                                      TaskPool *task_pool)
 {
   /* Test if we can instance or if the object is modified. */
@@ -77,9 +78,6 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
                         b_ob_info.object_data;
   GeometryKey key(b_key_id.ptr.data, geom_type);
 
-  /* Find shader indices. */
-  array<Node *> used_shaders = find_used_shaders(b_ob_info.iter_object);
-
   /* Ensure we only sync instanced geometry once. */
   Geometry *geom = geometry_map.find(key);
   if (geom) {
@@ -88,6 +86,9 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
     }
   }
 
+  /* Find shader indices. Done after the check above, which is hit for every instance. */
+  array<Node *> used_shaders = find_used_shaders(b_ob_info.iter_object);
+
   /* Test if we need to sync. */
   bool sync = true;
   if (geom == NULL) {
@@ -116,6 +117,11 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
     if (object_updated && geom->transform_applied) {
       ;
     }
+    /* Hair was simplified for a different distance to the camera. */
+    else if (geom_type == Geometry::HAIR &&
+             hair_simplify_fractions[geom] != hair_simplify_fraction) {
+      ;
+    }
     /* Test if shaders changed, these can be object level so geometry
      * does not get tagged for recalc. */
     else if (geom->get_used_shaders() != used_shaders) {
@@ -141,6 +147,10 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
 
   geometry_synced.insert(geom);
 
+  if (geom_type == Geometry::HAIR) {
+    hair_simplify_fractions[geom] = hair_simplify_fraction;
+  }
+
   geom->name = ustring(b_ob_info.object_data.name().c_str());
 
   /* Store the shaders immediately for the object attribute code. */
@@ -181,6 +191,18 @@ Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
   return geom;
 }
 
+void BlenderSync::simplify_synced_hair()
+{
+  /* Done after all motion steps are exported, since those expect the curves to match the Blender
+   * data. */
+  for (const auto &it : hair_simplify_fractions) {
+    Geometry *geom = it.first;
+    if (it.second < 1.0f && geometry_synced.find(geom) != geometry_synced.end()) {
+      static_cast<Hair *>(geom)->reduce_curves(it.second);
+    }
+  }
+}
+
 void BlenderSync::sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                                        BObjectInfo &b_ob_info,
                                        Object *object,
@@ -207,31 +207,11 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
-  /* Visibility flags for both parent and child. */
-  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
-  bool use_holdout = b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
-  uint visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
-
-  if (b_parent.ptr.data != b_ob.ptr.data) {
-    visibility &= object_ray_visibility(b_parent);
-  }
-
-  /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
-#if 0
-  if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
-    visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
-  }
-#endif
-
-  /* Clear camera visibility for indirect only objects. */
-  bool use_indirect_only = !use_holdout &&
-                           b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
-  if (use_indirect_only) {
-    visibility &= ~PATH_RAY_CAMERA;
-  }
+  const ObjectSyncProperties &properties = get_object_sync_properties(
+      b_view_layer, b_ob, b_parent);
 
   /* Don't export completely invisible objects. */
-  if (visibility == 0) {
+  if (properties.visibility == 0) {
     return NULL;
   }
 
@@ -270,8 +250,13 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
                         (tfm != object->get_tfm());
 
   /* mesh sync */
-  Geometry *geometry = sync_geometry(
-      b_depsgraph, b_ob_info, object_updated, use_particle_hair, object_geom_task_pool);
+  const float hair_simplify_fraction = culling.hair_simplify_fraction(scene, b_ob, tfm);
+  Geometry *geometry = sync_geometry(b_depsgraph,
+                                     b_ob_info,
+                                     object_updated,
+                                     use_particle_hair,
+                                     hair_simplify_fraction,
+                                     object_geom_task_pool);
   object->set_geometry(geometry);
 
   /* special case not tracked by object update flags */
@@ -281,56 +266,32 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   }
 
   /* holdout */
-  object->set_use_holdout(use_holdout);
+  object->set_use_holdout(properties.use_holdout);
 
-  object->set_visibility(visibility);
+  object->set_visibility(properties.visibility);
 
-  object->set_is_shadow_catcher(b_ob.is_shadow_catcher() || b_parent.is_shadow_catcher());
+  object->set_is_shadow_catcher(properties.is_shadow_catcher);
 
-  float shadow_terminator_shading_offset = get_float(cobject, "shadow_terminator_offset");
-  object->set_shadow_terminator_shading_offset(shadow_terminator_shading_offset);
+  object->set_shadow_terminator_shading_offset(properties.shadow_terminator_shading_offset);
+  object->set_shadow_terminator_geometry_offset(properties.shadow_terminator_geometry_offset);
 
-  float shadow_terminator_geometry_offset = get_float(cobject,
-                                                      "shadow_terminator_geometry_offset");
-  object->set_shadow_terminator_geometry_offset(shadow_terminator_geometry_offset);
+  object->set_ao_distance(properties.ao_distance);
 
-  float ao_distance = get_float(cobject, "ao_distance");
-  if (ao_distance == 0.0f && b_parent.ptr.data != b_ob.ptr.data) {
-    PointerRNA cparent = RNA_pointer_get(&b_parent.ptr, "cycles");
-    ao_distance = get_float(cparent, "ao_distance");
-  }
-  object->set_ao_distance(ao_distance);
-
-  bool is_caustics_caster = get_boolean(cobject, "is_caustics_caster");
-  object->set_is_caustics_caster(is_caustics_caster);
-
-  bool is_caustics_receiver = get_boolean(cobject, "is_caustics_receiver");
-  object->set_is_caustics_receiver(is_caustics_receiver);
+  object->set_is_caustics_caster(properties.is_caustics_caster);
+  object->set_is_caustics_receiver(properties.is_caustics_receiver);
 
   /* sync the asset name for Cryptomatte */
-  BL::Object parent = b_ob.parent();
-  ustring parent_name;
-  if (parent) {
-    while (parent.parent()) {
-      parent = parent.parent();
-    }
-    parent_name = parent.name();
-  }
-  else {
-    parent_name = b_ob.name();
-  }
-  object->set_asset_name(parent_name);
+  object->set_asset_name(properties.asset_name);
 
   /* object sync
    * transform comparison should not be needed, but duplis don't work perfect
    * in the depsgraph and may not signal changes, so this is a workaround */
   if (object->is_modified() || object_updated ||
       (object->get_geometry() && object->get_geometry()->is_modified())) {
-    object->name = b_ob.name().c_str();
-    object->set_pass_id(b_ob.pass_index());
-    const BL::Array<float, 4> object_color = b_ob.color();
-    object->set_color(get_float3(object_color));
-    object->set_alpha(object_color[3]);
+    object->name = properties.name;
+    object->set_pass_id(properties.pass_id);
+    object->set_color(float4_to_float3(properties.color));
+    object->set_alpha(properties.color.w);
     object->set_tfm(tfm);
 
     /* dupli texture coordinates and random_id */
@@ -347,7 +308,7 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     }
 
     /* lightgroup */
-    object->set_lightgroup(ustring(b_ob.lightgroup()));
+    object->set_lightgroup(properties.lightgroup);
 
     object->tag_update(scene);
   }
@@ -362,6 +323,79 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   return object;
 }
 
+const BlenderSync::ObjectSyncProperties &BlenderSync::get_object_sync_properties(
+    BL::ViewLayer &b_view_layer, BL::Object &b_ob, BL::Object &b_parent)
+{
+  const std::pair<void *, void *> key(b_ob.ptr.data, b_parent.ptr.data);
+  auto it = object_sync_properties.find(key);
+  if (it != object_sync_properties.end()) {
+    return it->second;
+  }
+
+  ObjectSyncProperties &properties = object_sync_properties[key];
+
+  /* Visibility flags for both parent and child. */
+  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
+  properties.use_holdout = b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
+  uint visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
+
+  if (b_parent.ptr.data != b_ob.ptr.data) {
+    visibility &= object_ray_visibility(b_parent);
+  }
+
+  /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
+#if 0
+  if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
+    visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
+  }
+#endif
+
+  /* Clear camera visibility for indirect only objects. */
+  bool use_indirect_only = !properties.use_holdout &&
+                           b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
+  if (use_indirect_only) {
+    visibility &= ~PATH_RAY_CAMERA;
+  }
+  properties.visibility = visibility;
+
+  properties.is_shadow_catcher = b_ob.is_shadow_catcher() || b_parent.is_shadow_catcher();
+
+  properties.shadow_terminator_shading_offset = get_float(cobject, "shadow_terminator_offset");
+  properties.shadow_terminator_geometry_offset = get_float(cobject,
+                                                           "shadow_terminator_geometry_offset");
+
+  float ao_distance = get_float(cobject, "ao_distance");
+  if (ao_distance == 0.0f && b_parent.ptr.data != b_ob.ptr.data) {
+    PointerRNA cparent = RNA_pointer_get(&b_parent.ptr, "cycles");
+    ao_distance = get_float(cparent, "ao_distance");
+  }
+  properties.ao_distance = ao_distance;
+
+  properties.is_caustics_caster = get_boolean(cobject, "is_caustics_caster");
+  properties.is_caustics_receiver = get_boolean(cobject, "is_caustics_receiver");
+
+  /* The asset name for Cryptomatte. */
+  BL::Object parent = b_ob.parent();
+  if (parent) {
+    while (parent.parent()) {
+      parent = parent.parent();
+    }
+    properties.asset_name = parent.name();
+  }
+  else {
+    properties.asset_name = b_ob.name();
+  }
+
+  properties.name = b_ob.name();
+  properties.pass_id = b_ob.pass_index();
+  const BL::Array<float, 4> object_color = b_ob.color();
+  properties.color = make_float4(
+      object_color[0], object_color[1], object_color[2], object_color[3]);
+  properties.lightgroup = ustring(b_ob.lightgroup());
+
+  return properties;
+}
+
 extern "C" DupliObject *rna_hack_DepsgraphObjectInstance_dupli_object_get(PointerRNA *ptr);
 
 static float4 lookup_instance_property(BL::DepsgraphObjectInstance &b_instance,
@@ -387,7 +421,7 @@ static float4 lookup_instance_property(BL::DepsgraphObjectInstance &b_instance,
 bool BlenderSync::sync_object_attributes(BL::DepsgraphObjectInstance &b_instance, Object *object)
 {
   /* Find which attributes are needed. */
-  AttributeRequestSet requests = object->get_geometry()->needed_attributes();
+  const AttributeRequestSet &requests = get_geometry_attribute_requests(object->get_geometry());
 
   /* Delete attributes that became unnecessary. */
   vector<ParamValue> &attributes = object->attributes;
@@ -401,7 +435,7 @@ bool BlenderSync::sync_object_attributes(BL::DepsgraphObjectInstance &b_instance
   }
 
   /* Update attribute values. */
-  foreach (AttributeRequest &req, requests.requests) {
+  foreach (const AttributeRequest &req, requests.requests) {
     ustring name = req.name;
 
     std::string real_name;
@@ -440,6 +474,16 @@ bool BlenderSync::sync_object_attributes(BL::DepsgraphObjectInstance &b_instance
   return changed;
 }
 
+const AttributeRequestSet &BlenderSync::get_geometry_attribute_requests(Geometry *geometry)
+{
+  /* All instances of a geometry need the same attributes, only look them up once. */
+  auto it = geometry_attribute_requests.find(geometry);
+  if (it != geometry_attribute_requests.end()) {
+    return it->second;
+  }
+  return geometry_attribute_requests[geometry] = geometry->needed_attributes();
+}
+
 /* Object Loop */
 
 void BlenderSync::sync_procedural(BL::Object &b_ob,
@@ -542,6 +586,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
     geometry_motion_synced.clear();
   }
   instance_geometries_by_object.clear();
+  object_sync_properties.clear();
+  geometry_attribute_requests.clear();
 
   /* initialize culling */
   BlenderObjectCulling culling(scene, b_scene);
@@ -627,6 +673,9 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
 
   geom_task_pool.wait_work();
 
+  object_sync_properties.clear();
+  geometry_attribute_requests.clear();
+
   progress.set_sync_status("");
 
   if (!cancel && !motion) {
@@ -16,7 +16,8 @@ BlenderObjectCulling::BlenderObjectCulling(Scene *scene, BL::Scene &b_scene)
       camera_cull_margin_(0.0f),
       use_scene_distance_cull_(false),
       use_distance_cull_(false),
-      distance_cull_margin_(0.0f)
+      distance_cull_margin_(0.0f),
+      hair_simplify_distance_(0.0f)
 {
   if (b_scene.render().use_simplify()) {
     PointerRNA cscene = RNA_pointer_get(&b_scene.ptr, "cycles");
@@ -34,6 +35,11 @@ BlenderObjectCulling::BlenderObjectCulling(Scene *scene, BL::Scene &b_scene)
     if (distance_cull_margin_ == 0.0f) {
       use_scene_distance_cull_ = false;
     }
+
+    if (scene->camera->get_camera_type() != CAMERA_PANORAMA &&
+        !b_scene.render().use_multiview()) {
+      hair_simplify_distance_ = get_float(cscene, "hair_simplify_distance");
+    }
   }
 }
 
@@ -60,13 +66,8 @@ bool BlenderObjectCulling::test(Scene *scene, BL::Object &b_ob, Transform &tfm)
     return false;
   }
 
-  /* Compute world space bounding box corners. */
   float3 bb[8];
-  BL::Array<float, 24> boundbox = b_ob.bound_box();
-  for (int i = 0; i < 8; ++i) {
-    float3 p = make_float3(boundbox[3 * i + 0], boundbox[3 * i + 1], boundbox[3 * i + 2]);
-    bb[i] = transform_point(&tfm, p);
-  }
+  compute_bounding_box(b_ob, tfm, bb);
 
   bool camera_culled = use_camera_cull_ && test_camera(scene, bb);
   bool distance_culled = use_distance_cull_ && test_distance(scene, bb);
@@ -75,6 +76,39 @@ bool BlenderObjectCulling::test(Scene *scene, BL::Object &b_ob, Transform &tfm)
           (distance_culled && !use_camera_cull_));
 }
 
+float BlenderObjectCulling::hair_simplify_fraction(Scene *scene,
+                                                   BL::Object &b_ob,
+                                                   Transform &tfm)
+{
+  if (hair_simplify_distance_ == 0.0f) {
+    return 1.0f;
+  }
+
+  float3 bb[8];
+  compute_bounding_box(b_ob, tfm, bb);
+
+  /* The projected width of a curve is inversely proportional to its distance, so halve the number
+   * of curves every time the distance doubles. Use discrete levels so that small camera movements
+   * in the viewport do not cause the hair to be synchronized again. */
+  const float distance = camera_distance(scene, bb);
+  if (distance <= hair_simplify_distance_) {
+    return 1.0f;
+  }
+
+  const int level = min((int)floorf(log2f(distance / hair_simplify_distance_)), 6);
+  return 1.0f / (float)(1 << level);
+}
+
+void BlenderObjectCulling::compute_bounding_box(BL::Object &b_ob, Transform &tfm, float3 bb[8])
+{
+  /* Compute world space bounding box corners. */
+  BL::Array<float, 24> boundbox = b_ob.bound_box();
+  for (int i = 0; i < 8; ++i) {
+    float3 p = make_float3(boundbox[3 * i + 0], boundbox[3 * i + 1], boundbox[3 * i + 2]);
+    bb[i] = transform_point(&tfm, p);
+  }
+}
+
 /* TODO(sergey): Not really optimal, consider approaches based on k-DOP in order
  * to reduce number of objects which are wrongly considered visible.
  */
@@ -109,6 +143,11 @@ bool BlenderObjectCulling::test_camera(Scene *scene, float3 bb[8])
 }
 
 bool BlenderObjectCulling::test_distance(Scene *scene, float3 bb[8])
+{
+  return camera_distance(scene, bb) > distance_cull_margin_;
+}
+
+float BlenderObjectCulling::camera_distance(Scene *scene, float3 bb[8])
 {
   float3 camera_position = transform_get_column(&scene->camera->get_matrix(), 3);
   float3 bb_min = make_float3(FLT_MAX, FLT_MAX, FLT_MAX),
@@ -122,8 +161,7 @@ bool BlenderObjectCulling::test_distance(Scene *scene, float3 bb[8])
   }
 
   float3 closest_point = max(min(bb_max, camera_position), bb_min);
-  return (len_squared(camera_position - closest_point) >
-          distance_cull_margin_ * distance_cull_margin_);
+  return len(camera_position - closest_point);
 }
 
 CCL_NAMESPACE_END
@@ -18,9 +18,14 @@ class BlenderObjectCulling {
   void init_object(Scene *scene, BL::Object &b_ob);
   bool test(Scene *scene, BL::Object &b_ob, Transform &tfm);
 
+  /* Fraction of the hair curves to keep for the object, based on its distance to the camera. */
+  float hair_simplify_fraction(Scene *scene, BL::Object &b_ob, Transform &tfm);
+
  private:
+  void compute_bounding_box(BL::Object &b_ob, Transform &tfm, float3 bb[8]);
   bool test_camera(Scene *scene, float3 bb[8]);
   bool test_distance(Scene *scene, float3 bb[8]);
+  float camera_distance(Scene *scene, float3 bb[8]);
 
   bool use_scene_camera_cull_;
   bool use_camera_cull_;
@@ -28,6 +33,7 @@ class BlenderObjectCulling {
   bool use_scene_distance_cull_;
   bool use_distance_cull_;
   float distance_cull_margin_;
+  float hair_simplify_distance_;
 };
 
 CCL_NAMESPACE_END
@@ -40,6 +40,7 @@ CCL_NAMESPACE_BEGIN
 DeviceTypeMask BlenderSession::device_override = DEVICE_MASK_ALL;
 bool BlenderSession::headless = false;
 bool BlenderSession::print_render_stats = false;
+string BlenderSession::render_stats_filepath = "";
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -280,6 +281,28 @@ static void add_cryptomatte_layer(BL::RenderResult &b_rr, string name, string ma
   render_add_metadata(b_rr, prefix + "manifest", manifest);
 }
 
+void BlenderSession::write_render_stats_json(const string &view_layer_name,
+                                             const string &view_name)
+{
+  RenderStats stats;
+  session->collect_statistics(&stats);
+
+  const string line = string_printf(
+      "{\"frame\": %d, \"view_layer\": \"%s\", \"view\": \"%s\", \"stats\": %s}\n",
+      b_scene.frame_current(),
+      string_json_escape(view_layer_name).c_str(),
+      string_json_escape(view_name).c_str(),
+      stats.json_report().c_str());
+
+  FILE *file = path_fopen(render_stats_filepath, "a");
+  if (!file) {
+    LOG(ERROR) << "Failed to open render statistics file " << render_stats_filepath;
+    return;
+  }
+  fwrite(line.data(), 1, line.size(), file);
+  fclose(file);
+}
+
 void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_layer_name)
 {
   BL::RenderResult b_rr = b_engine.get_result();
@@ -444,6 +467,10 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       printf("Render statistics:\n%s\n", stats.full_report().c_str());
     }
 
+    if (!b_engine.is_preview() && background && !render_stats_filepath.empty()) {
+      write_render_stats_json(b_view_layer.name(), b_rview_name);
+    }
+
     if (session->progress.get_cancel())
       break;
   }
@@ -119,9 +119,16 @@ class BlenderSession {
 
   static bool print_render_stats;
 
+  /* File to which render statistics are appended in JSON format, one line per rendered view.
+   * Empty if statistics are not to be written. */
+  static string render_stats_filepath;
+
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
 
+  /* Append statistics of the current render to render_stats_filepath. */
+  void write_render_stats_json(const string &view_layer_name, const string &view_name);
+
   /* Check whether session error happened.
    * If so, it is reported to the render engine and true is returned.
    * Otherwise false is returned. */
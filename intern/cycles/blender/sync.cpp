@@ -253,6 +253,8 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
                             int height,
                             void **python_thread_state)
 {
+  MEM_TagScope mem_tag(MEM_TAG_CYCLES);
+
   /* For auto refresh images. */
   ImageManager *image_manager = scene->image_manager;
   const int frame = b_scene.frame_current();
@@ -284,6 +286,8 @@ void BlenderSync::sync_data(BL::RenderSettings &b_render,
   }
   sync_motion(b_render, b_depsgraph, b_v3d, b_override, width, height, python_thread_state);
 
+  simplify_synced_hair();
+
   geometry_synced.clear();
 
   /* Shader sync done at the end, since object sync uses it.
@@ -431,6 +435,7 @@ void BlenderSync::sync_integrator(BL::ViewLayer &b_view_layer, bool background)
   integrator->set_use_surface_guiding(get_boolean(cscene, "use_surface_guiding"));
   integrator->set_use_volume_guiding(get_boolean(cscene, "use_volume_guiding"));
   integrator->set_guiding_training_samples(get_int(cscene, "guiding_training_samples"));
+  integrator->set_reuse_guiding_field(get_boolean(cscene, "reuse_guiding_field"));
 
   if (use_developer_ui) {
     integrator->set_deterministic_guiding(get_boolean(cscene, "use_deterministic_guiding"));
@@ -14,6 +14,7 @@
 #include "blender/util.h"
 #include "blender/viewport.h"
 
+#include "scene/attribute.h"
 #include "scene/scene.h"
 #include "session/session.h"
 
@@ -137,11 +138,33 @@ class BlenderSync {
                       TaskPool *geom_task_pool);
   void sync_object_motion_init(BL::Object &b_parent, BL::Object &b_ob, Object *object);
 
+  /* Properties of an object which are the same for all instances of the object with the same
+   * parent. They are looked up once per object sync, to avoid RNA access for every instance. */
+  struct ObjectSyncProperties {
+    uint visibility;
+    bool use_holdout;
+    bool is_shadow_catcher;
+    float shadow_terminator_shading_offset;
+    float shadow_terminator_geometry_offset;
+    float ao_distance;
+    bool is_caustics_caster;
+    bool is_caustics_receiver;
+    ustring name;
+    ustring asset_name;
+    ustring lightgroup;
+    int pass_id;
+    float4 color;
+  };
+  const ObjectSyncProperties &get_object_sync_properties(BL::ViewLayer &b_view_layer,
+                                                         BL::Object &b_ob,
+                                                         BL::Object &b_parent);
+
   void sync_procedural(BL::Object &b_ob,
                        BL::MeshSequenceCacheModifier &b_mesh_cache,
                        bool has_subdivision);
 
   bool sync_object_attributes(BL::DepsgraphObjectInstance &b_instance, Object *object);
+  const AttributeRequestSet &get_geometry_attribute_requests(Geometry *geometry);
 
   /* Volume */
   void sync_volume(BObjectInfo &b_ob_info, Volume *volume);
@@ -177,8 +200,11 @@ class BlenderSync {
                           BObjectInfo &b_ob_info,
                           bool object_updated,
                           bool use_particle_hair,
+                          float hair_simplify_fraction,
                           TaskPool *task_pool);
 
+  void simplify_synced_hair();
+
   void sync_geometry_motion(BL::Depsgraph &b_depsgraph,
                             BObjectInfo &b_ob_info,
                             Object *object,
@@ -232,6 +258,11 @@ class BlenderSync {
   set<Geometry *> geometry_motion_attribute_synced;
   /** Remember which geometries come from which objects to be able to sync them after changes. */
   map<void *, set<BL::ID>> instance_geometries_by_object;
+  /** Per object sync caches, see #get_object_sync_properties. */
+  map<std::pair<void *, void *>, ObjectSyncProperties> object_sync_properties;
+  map<Geometry *, AttributeRequestSet> geometry_attribute_requests;
+  /** Fraction of curves kept for hair geometry, see #BlenderObjectCulling. */
+  map<Geometry *, float> hair_simplify_fractions;
   set<float> motion_times;
   void *world_map;
   bool world_recalc;
@@ -275,6 +275,11 @@ string CUDADevice::compile_kernel(const string &common_cflags,
   }
 
   /* Try to use locally compiled kernel. */
+  /* Devices of a multi-device load their kernels in parallel. Only let one of them compile at a
+   * time, so that devices with the same architecture find the cubin the first one compiled. */
+  static thread_mutex compile_mutex;
+  thread_scoped_lock compile_lock(compile_mutex);
+
   string source_path = path_get("source");
   const string source_md5 = path_files_md5_hash(source_path);
 
@@ -242,6 +242,11 @@ string HIPDevice::compile_kernel(const uint kernel_features, const char *name, c
   }
 
   /* Try to use locally compiled kernel. */
+  /* Devices of a multi-device load their kernels in parallel. Only let one of them compile at a
+   * time, so that devices with the same architecture find the fatbin the first one compiled. */
+  static thread_mutex compile_mutex;
+  thread_scoped_lock compile_lock(compile_mutex);
+
   string source_path = path_get("source");
   const string source_md5 = path_files_md5_hash(source_path);
 
@@ -17,6 +17,7 @@
 #include "util/list.h"
 #include "util/log.h"
 #include "util/map.h"
+#include "util/tbb.h"
 #include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
@@ -131,8 +132,19 @@ class MultiDevice : public Device {
 
   bool load_kernels(const uint kernel_features) override
   {
+    /* Load kernels of all devices at the same time, compiling kernels and creating pipelines can
+     * take a long time and is mostly independent per device. */
+    vector<SubDevice *> sub_devices;
     foreach (SubDevice &sub, devices)
-      if (!sub.device->load_kernels(kernel_features))
+      sub_devices.push_back(&sub);
+
+    vector<char> loaded(sub_devices.size(), false);
+    parallel_for(size_t(0), sub_devices.size(), [&](const size_t i) {
+      loaded[i] = sub_devices[i]->device->load_kernels(kernel_features);
+    });
+
+    foreach (const char success, loaded)
+      if (!success)
         return false;
 
     return true;
@@ -53,9 +53,8 @@ DeviceQueue::~DeviceQueue()
 
 void DeviceQueue::debug_init_execution()
 {
-  if (VLOG_DEVICE_STATS_IS_ON) {
-    last_sync_time_ = time_dt();
-  }
+  /* Kernel times are always accumulated, so that they can be reported in render statistics. */
+  last_sync_time_ = time_dt();
 
   last_kernels_enqueued_ = 0;
 }
@@ -79,20 +78,18 @@ void DeviceQueue::debug_enqueue_end()
 
 void DeviceQueue::debug_synchronize()
 {
-  if (VLOG_DEVICE_STATS_IS_ON) {
-    const double new_time = time_dt();
-    const double elapsed_time = new_time - last_sync_time_;
-    VLOG_DEVICE_STATS << "GPU queue synchronize, elapsed " << std::setw(10) << elapsed_time << "s";
-
-    /* There is no sense to have an entries in the performance data
-     * container without related kernel information. */
-    if (last_kernels_enqueued_ != 0) {
-      stats_kernel_time_[last_kernels_enqueued_] += elapsed_time;
-    }
-
-    last_sync_time_ = new_time;
+  const double new_time = time_dt();
+  const double elapsed_time = new_time - last_sync_time_;
+  VLOG_DEVICE_STATS << "GPU queue synchronize, elapsed " << std::setw(10) << elapsed_time << "s";
+
+  /* There is no sense to have an entries in the performance data
+   * container without related kernel information. */
+  if (last_kernels_enqueued_ != 0) {
+    stats_kernel_time_[last_kernels_enqueued_] += elapsed_time;
   }
 
+  last_sync_time_ = new_time;
+
   last_kernels_enqueued_ = 0;
 }
 
@@ -153,6 +153,13 @@ class DeviceQueue {
     return nullptr;
   }
 
+  /* Accumulated execution time for combinations of kernels launched together, since the queue
+   * has been created. */
+  const map<DeviceKernelMask, double> &kernel_times() const
+  {
+    return stats_kernel_time_;
+  }
+
   /* Device this queue has been created for. */
   Device *device;
 
@@ -17,6 +17,8 @@ struct GuidingParams {
   GuidingDistributionType type = GUIDING_TYPE_PARALLAX_AWARE_VMM;
   int training_samples = 128;
   bool deterministic = false;
+  /* Keep the trained field on reset and continue training it, instead of starting over. */
+  bool reuse_field = false;
 
   GuidingParams() = default;
 
@@ -25,7 +27,7 @@ struct GuidingParams {
     return !((use == other.use) && (use_surface_guiding == other.use_surface_guiding) &&
              (use_volume_guiding == other.use_volume_guiding) && (type == other.type) &&
              (training_samples == other.training_samples) &&
-             (deterministic == other.deterministic));
+             (deterministic == other.deterministic) && (reuse_field == other.reuse_field));
   }
 };
 
@@ -11,6 +11,7 @@
 #include "integrator/render_scheduler.h"
 #include "scene/pass.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/tile.h"
 #include "util/algorithm.h"
 #include "util/log.h"
@@ -1261,6 +1262,15 @@ string PathTrace::full_report() const
   return result;
 }
 
+void PathTrace::collect_statistics(RenderStats *stats) const
+{
+  for (const unique_ptr<PathTraceWork> &path_trace_work : path_trace_works_) {
+    DeviceStats device_stats;
+    path_trace_work->collect_statistics(device_stats);
+    stats->devices.push_back(device_stats);
+  }
+}
+
 void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bool reset)
 {
 #ifdef WITH_PATH_GUIDING
@@ -1305,6 +1315,7 @@ void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bo
       if (guiding_device) {
         guiding_sample_data_storage_ = make_unique<openpgl::cpp::SampleStorage>();
         guiding_field_ = make_unique<openpgl::cpp::Field>(guiding_device, field_args);
+        guiding_training_start_iteration_ = 0;
       }
       else {
         guiding_sample_data_storage_ = nullptr;
@@ -1318,7 +1329,16 @@ void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bo
   }
   else if (reset) {
     if (guiding_field_) {
-      guiding_field_->Reset();
+      if (guiding_params_.reuse_field) {
+        /* Continue training the existing field with samples of the changed scene, the field
+         * then starts from a good approximation when the change is small. */
+        guiding_sample_data_storage_->Clear();
+        guiding_training_start_iteration_ = guiding_field_->GetIteration();
+      }
+      else {
+        guiding_field_->Reset();
+        guiding_training_start_iteration_ = 0;
+      }
     }
   }
 #else
@@ -1330,8 +1350,10 @@ void PathTrace::set_guiding_params(const GuidingParams &guiding_params, const bo
 void PathTrace::guiding_prepare_structures()
 {
 #ifdef WITH_PATH_GUIDING
+  const size_t training_iterations = guiding_field_->GetIteration() -
+                                     guiding_training_start_iteration_;
   const bool train = (guiding_params_.training_samples == 0) ||
-                     (guiding_field_->GetIteration() < guiding_params_.training_samples);
+                     (training_iterations < guiding_params_.training_samples);
 
   for (auto &&path_trace_work : path_trace_works_) {
     path_trace_work->guiding_init_kernel_globals(
@@ -26,6 +26,7 @@ class DisplayDriver;
 class Film;
 class RenderBuffers;
 class RenderScheduler;
+class RenderStats;
 class RenderWork;
 class PathTraceDisplay;
 class OutputDriver;
@@ -174,6 +175,9 @@ class PathTrace {
    * times, and so on. */
   string full_report() const;
 
+  /* Add statistics of all devices used for path tracing to the render statistics. */
+  void collect_statistics(RenderStats *stats) const;
+
   /* Callback which is called to report current rendering progress.
    *
    * It is supposed to be cheaper than buffer update/write, hence can be called more often.
@@ -296,6 +300,10 @@ class PathTrace {
 
   /* The number of already performed training iterations for the guiding field.*/
   int guiding_update_count = 0;
+
+  /* Iteration of the guiding field when training was last restarted, for counting the training
+   * samples of a field that is reused after a reset. */
+  size_t guiding_training_start_iteration_ = 0;
 #endif
 
   /* State which is common for all the steps of the render work.
@@ -9,6 +9,7 @@
 #include "integrator/path_trace_work_gpu.h"
 #include "scene/film.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 
 #include "kernel/types.h"
@@ -48,6 +49,11 @@ PathTraceWork::~PathTraceWork()
 {
 }
 
+void PathTraceWork::collect_statistics(DeviceStats &stats) const
+{
+  stats.name = device_->info.description;
+}
+
 RenderBuffers *PathTraceWork::get_render_buffers()
 {
   return buffers_.get();
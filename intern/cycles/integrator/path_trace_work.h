@@ -14,6 +14,7 @@ CCL_NAMESPACE_BEGIN
 class BufferParams;
 class Device;
 class DeviceScene;
+class DeviceStats;
 class Film;
 class PathTraceDisplay;
 class RenderBuffers;
@@ -125,6 +126,9 @@ class PathTraceWork {
   /* Run cryptomatte pass post-processing kernels. */
   virtual void cryptomatte_postproces() = 0;
 
+  /* Fill in statistics of the device, accumulated over all samples rendered by this work. */
+  virtual void collect_statistics(DeviceStats &stats) const;
+
   /* Cheap-ish request to see whether rendering is requested and is to be stopped as soon as
    * possible, without waiting for any samples to be finished. */
   inline bool is_cancel_requested() const
@@ -8,6 +8,7 @@
 
 #include "integrator/pass_accessor_gpu.h"
 #include "scene/scene.h"
+#include "scene/stats.h"
 #include "session/buffers.h"
 #include "util/log.h"
 #include "util/string.h"
@@ -340,6 +341,23 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
   }
 
   statistics.occupancy = static_cast<float>(num_busy_accum) / num_iterations / max_num_paths_;
+
+  stats_num_busy_accum_ += num_busy_accum;
+  stats_num_iterations_ += num_iterations;
+}
+
+void PathTraceWorkGPU::collect_statistics(DeviceStats &stats) const
+{
+  PathTraceWork::collect_statistics(stats);
+
+  if (stats_num_iterations_ && max_num_paths_) {
+    stats.occupancy = static_cast<float>(stats_num_busy_accum_) / stats_num_iterations_ /
+                      max_num_paths_;
+  }
+
+  for (const auto &[mask, time] : queue_->kernel_times()) {
+    stats.kernels.add_entry(NamedTimeEntry(device_kernel_mask_as_string(mask), time));
+  }
 }
 
 DeviceKernel PathTraceWorkGPU::get_most_queued_kernel() const
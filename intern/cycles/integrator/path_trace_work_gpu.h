@@ -48,6 +48,8 @@ class PathTraceWorkGPU : public PathTraceWork {
   virtual int adaptive_sampling_converge_filter_count_active(float threshold, bool reset) override;
   virtual void cryptomatte_postproces() override;
 
+  virtual void collect_statistics(DeviceStats &stats) const override;
+
  protected:
   void alloc_integrator_soa();
   void alloc_integrator_queue();
@@ -170,6 +172,11 @@ class PathTraceWorkGPU : public PathTraceWork {
    * the size of the integrator_state_ buffer so can avoid iterating over the
    * full buffer. */
   int max_active_main_path_index_;
+
+  /* Number of busy paths and path iterations accumulated over all rendered samples, to report
+   * the average occupancy in render statistics. */
+  uint64_t stats_num_busy_accum_ = 0;
+  uint64_t stats_num_iterations_ = 0;
 };
 
 CCL_NAMESPACE_END
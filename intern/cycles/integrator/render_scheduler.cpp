@@ -931,6 +931,10 @@ float RenderScheduler::work_adaptive_threshold() const
   return max(state_.adaptive_sampling_threshold, adaptive_sampling_.threshold);
 }
 
+/* Maximum fraction of the viewport render time which is spent on denoising once the render is
+ * past the start sample. */
+static const double MAX_VIEWPORT_DENOISE_FRACTION = 0.5;
+
 bool RenderScheduler::work_need_denoise(bool &delayed, bool &ready_to_display)
 {
   delayed = false;
@@ -979,11 +983,24 @@ bool RenderScheduler::work_need_denoise(bool &delayed, bool &ready_to_display)
     return false;
   }
 
+  const double time_since_display_update = time_dt() - state_.last_display_update_time;
+
   /* Avoid excessive denoising in viewport after reaching a certain sample count and render time.
    */
   /* TODO(sergey): Consider making time interval and sample configurable. */
   delayed = (path_trace_time_.get_wall() > 4 && num_samples_finished >= 20 &&
-             (time_dt() - state_.last_display_update_time) < 1.0);
+             time_since_display_update < 1.0);
+
+  /* Limit the fraction of time spent on denoising, based on the measured denoising time. For
+   * large viewports the denoiser can otherwise take most of the time between display updates,
+   * which slows down convergence. During navigation the above returns earlier, so that the
+   * low resolution result is still denoised immediately. */
+  const double denoise_time = denoise_time_.get_average();
+  if (!delayed && denoise_time > 0.0) {
+    const double min_time_between_denoise = denoise_time * (1.0 - MAX_VIEWPORT_DENOISE_FRACTION) /
+                                            MAX_VIEWPORT_DENOISE_FRACTION;
+    delayed = time_since_display_update < min_time_between_denoise;
+  }
 
   return !delayed;
 }
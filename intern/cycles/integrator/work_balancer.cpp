@@ -37,9 +37,9 @@ static double calculate_total_time(const vector<WorkBalanceInfo> &work_balance_i
   return total_time;
 }
 
-/* The balance is based on equalizing time which devices spent performing a task. Assume that
- * average of the observed times is usable for estimating whether more or less work is to be
- * scheduled, and how difference in the work scheduling is needed. */
+/* The balance is based on equalizing time which devices spent performing a task. The amount of
+ * work a device did per unit of time is used to estimate how much work it can do in the time all
+ * devices are to spend, assuming that the time scales linearly with the amount of work. */
 
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
 {
@@ -52,22 +52,23 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
   vector<double> new_weights;
   new_weights.reserve(num_infos);
 
-  /* Equalize the overall average time. This means that we don't make it so every work will perform
-   * amount of work based on the current average, but that after the weights changes the time will
-   * equalize.
-   * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
-
+  /* Give every device a share of the work that is proportional to its throughput. Moving the
+   * weights all the way to the estimate, rather than a fraction of the way, lets devices with very
+   * different performance (like a fast GPU, a slow GPU and a CPU) converge in few rebalances,
+   * instead of rendering at the pace of the slowest device until they do. */
   bool has_big_difference = false;
 
   for (const WorkBalanceInfo &info : work_balance_infos) {
-    const double time_target = lerp(info.time_spent, time_average, lerp_weight);
-    const double new_weight = info.weight * time_target / info.time_spent;
+    if (info.time_spent <= 0.0) {
+      /* Not enough statistics for this device yet. */
+      return false;
+    }
+
+    const double new_weight = info.weight / info.time_spent;
     new_weights.push_back(new_weight);
     total_weight += new_weight;
 
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
+    if (std::fabs(1.0 - info.time_spent / time_average) > 0.02) {
       has_big_difference = true;
     }
   }
@@ -15,6 +15,8 @@
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
+#include "util/system.h"
+#include "util/tbb.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -749,6 +751,7 @@ NODE_DEFINE(AlembicProcedural)
 AlembicProcedural::AlembicProcedural() : Procedural(get_node_type())
 {
   objects_loaded = false;
+  use_threaded_reads = false;
   scene_ = nullptr;
 }
 
@@ -830,6 +833,8 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
   if (!archive.valid() || filepath_is_modified() || layers_is_modified()) {
     Alembic::AbcCoreFactory::IFactory factory;
     factory.setPolicy(Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+    /* Use one stream per thread so that objects can be read in parallel. */
+    factory.setOgawaNumStreams(system_cpu_thread_count());
 
     std::vector<std::string> filenames;
     filenames.push_back(filepath.c_str());
@@ -841,7 +846,10 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
     /* We need to reverse the order as overriding archives should come first. */
     std::reverse(filenames.begin(), filenames.end());
 
-    archive = factory.getArchive(filenames);
+    Alembic::AbcCoreFactory::IFactory::CoreType core_type;
+    archive = factory.getArchive(filenames, core_type);
+    /* Only Ogawa archives support reading from multiple threads. */
+    use_threaded_reads = (core_type == Alembic::AbcCoreFactory::IFactory::kOgawa);
 
     if (!archive.valid()) {
       /* avoid potential infinite update loops in viewport synchronization */
@@ -1438,79 +1446,98 @@ void AlembicProcedural::walk_hierarchy(
   }
 }
 
-void AlembicProcedural::build_caches(Progress &progress)
+void AlembicProcedural::build_cache(AlembicObject *object, Progress &progress)
 {
-  size_t memory_used = 0;
-
-  for (Node *node : objects) {
-    AlembicObject *object = static_cast<AlembicObject *>(node);
+  if (progress.get_cancel()) {
+    return;
+  }
 
-    if (progress.get_cancel()) {
-      return;
+  if (object->schema_type == AlembicObject::POLY_MESH) {
+    if (!object->has_data_loaded()) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
-
-    if (object->schema_type == AlembicObject::POLY_MESH) {
-      if (!object->has_data_loaded()) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
+    else if (object->need_shader_update) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
     }
-    else if (object->schema_type == AlembicObject::CURVES) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified()) {
-        ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
-        ICurvesSchema schema = curves.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
+  }
+  else if (object->schema_type == AlembicObject::CURVES) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified()) {
+      ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
+      ICurvesSchema schema = curves.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
-    else if (object->schema_type == AlembicObject::POINTS) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified()) {
-        IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
-        IPointsSchema schema = points.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
+  }
+  else if (object->schema_type == AlembicObject::POINTS) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified()) {
+      IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
+      IPointsSchema schema = points.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
-    else if (object->schema_type == AlembicObject::SUBD) {
-      if (!object->has_data_loaded()) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
+  }
+  else if (object->schema_type == AlembicObject::SUBD) {
+    if (!object->has_data_loaded()) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
+    else if (object->need_shader_update) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
+    }
+  }
+
+  if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
+    object->setup_transform_cache(object->get_cached_data(), scale);
+  }
+}
 
-    if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
-      object->setup_transform_cache(object->get_cached_data(), scale);
+void AlembicProcedural::build_caches(Progress &progress)
+{
+  /* Reading the data of many objects is mostly bound by the time spent waiting for I/O and
+   * decompressing samples, so the caches of the objects are built in parallel. */
+  if (use_threaded_reads) {
+    parallel_for(size_t(0), objects.size(), [&](const size_t i) {
+      build_cache(static_cast<AlembicObject *>(objects[i]), progress);
+    });
+  }
+  else {
+    for (Node *node : objects) {
+      build_cache(static_cast<AlembicObject *>(node), progress);
     }
+  }
+
+  if (progress.get_cancel()) {
+    return;
+  }
 
+  size_t memory_used = 0;
+
+  for (Node *node : objects) {
+    AlembicObject *object = static_cast<AlembicObject *>(node);
     memory_used += object->get_cached_data().memory_used();
+  }
 
-    if (use_prefetch) {
-      if (memory_used > get_prefetch_cache_size_in_bytes()) {
-        progress.set_error("Error: Alembic Procedural memory limit reached");
-        return;
-      }
+  if (use_prefetch) {
+    if (memory_used > get_prefetch_cache_size_in_bytes()) {
+      progress.set_error("Error: Alembic Procedural memory limit reached");
+      return;
     }
   }
 
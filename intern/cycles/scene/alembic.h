@@ -460,6 +460,7 @@ class AlembicObject : public Node {
 class AlembicProcedural : public Procedural {
   Alembic::AbcGeom::IArchive archive;
   bool objects_loaded;
+  bool use_threaded_reads;
   Scene *scene_;
 
  public:
@@ -557,6 +558,10 @@ class AlembicProcedural : public Procedural {
    * Object Nodes in the Cycles scene if none exist yet. */
   void read_subd(AlembicObject *abc_object, Alembic::AbcGeom::Abc::chrono_t frame_time);
 
+  /* Load the data of a single object in its cache, if it is not already loaded or outdated. */
+  void build_cache(AlembicObject *object, Progress &progress);
+
+  /* Load the data of all objects, in parallel if the archive allows it. */
   void build_caches(Progress &progress);
 
   size_t get_prefetch_cache_size_in_bytes() const
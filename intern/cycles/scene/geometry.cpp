@@ -63,6 +63,7 @@ Geometry::Geometry(const NodeType *node_type, const Type type)
   has_surface_bssrdf = false;
 
   bvh = NULL;
+  bvh_refit_count = 0;
   attr_map_offset = 0;
   prim_offset = 0;
 }
@@ -217,12 +218,18 @@ void Geometry::compute_bvh(Device *device,
     vector<Object *> objects;
     objects.push_back(&object);
 
-    if (bvh && !need_update_rebuild) {
+    /* A refit keeps the tree structure of the last build, which gets less efficient to traverse
+     * the further the geometry moves away from the shape it was built for. Rebuild after a number
+     * of refits so that the quality of the tree can't degrade indefinitely. */
+    static const int MAX_BVH_REFITS = 32;
+
+    if (bvh && !need_update_rebuild && bvh_refit_count < MAX_BVH_REFITS) {
       progress->set_status(msg, "Refitting BVH");
 
       bvh->replace_geometry(geometry, objects);
 
       device->build_bvh(bvh, *progress, true);
+      bvh_refit_count++;
     }
     else {
       progress->set_status(msg, "Building BVH");
@@ -242,6 +249,7 @@ void Geometry::compute_bvh(Device *device,
       delete bvh;
       bvh = BVH::create(bparams, geometry, objects, device);
       MEM_GUARDED_CALL(progress, device->build_bvh, bvh, *progress, false);
+      bvh_refit_count = 0;
     }
   }
 
@@ -1059,6 +1067,10 @@ void GeometryManager::device_update_mesh(Device *,
 
   size_t patch_size = 0;
 
+  /* Grain size for packing geometries in parallel, to avoid too much threading overhead for
+   * scenes with many small geometries. */
+  static const int GEOMETRY_PER_TASK = 8;
+
   foreach (Geometry *geom, scene->geometry) {
     if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
       Mesh *mesh = static_cast<Mesh *>(geom);
@@ -1097,7 +1109,7 @@ void GeometryManager::device_update_mesh(Device *,
 
     packed_float3 *tri_verts = dscene->tri_verts.alloc(tri_size * 3);
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
-    packed_float3 *vnormal = dscene->tri_vnormal.alloc(vert_size);
+    uint *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
@@ -1108,31 +1120,44 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->tri_patch.need_realloc() ||
                                dscene->tri_patch_uv.need_realloc();
 
-    foreach (Geometry *geom, scene->geometry) {
-      if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
-        Mesh *mesh = static_cast<Mesh *>(geom);
-
-        if (mesh->shader_is_modified() || mesh->smooth_is_modified() ||
-            mesh->triangles_is_modified() || copy_all_data) {
-          mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
-        }
-
-        if (mesh->verts_is_modified() || copy_all_data) {
-          mesh->pack_normals(&vnormal[mesh->vert_offset]);
-        }
-
-        if (mesh->verts_is_modified() || mesh->triangles_is_modified() ||
-            mesh->vert_patch_uv_is_modified() || copy_all_data) {
-          mesh->pack_verts(&tri_verts[mesh->prim_offset * 3],
-                           &tri_vindex[mesh->prim_offset],
-                           &tri_patch[mesh->prim_offset],
-                           &tri_patch_uv[mesh->vert_offset]);
-        }
-
-        if (progress.get_cancel())
-          return;
-      }
-    }
+    /* Every mesh is packed into its own range of the arrays, so meshes can be packed in
+     * parallel. */
+    parallel_for(blocked_range<size_t>(0, scene->geometry.size(), GEOMETRY_PER_TASK),
+                 [&](const blocked_range<size_t> &r) {
+                   for (size_t i = r.begin(); i != r.end(); i++) {
+                     Geometry *geom = scene->geometry[i];
+                     if (geom->geometry_type != Geometry::MESH &&
+                         geom->geometry_type != Geometry::VOLUME) {
+                       continue;
+                     }
+                     Mesh *mesh = static_cast<Mesh *>(geom);
+
+                     if (mesh->shader_is_modified() || mesh->smooth_is_modified() ||
+                         mesh->triangles_is_modified() || copy_all_data) {
+                       mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
+                     }
+
+                     if (mesh->verts_is_modified() || copy_all_data) {
+                       mesh->pack_normals(&vnormal[mesh->vert_offset]);
+                     }
+
+                     if (mesh->verts_is_modified() || mesh->triangles_is_modified() ||
+                         mesh->vert_patch_uv_is_modified() || copy_all_data) {
+                       mesh->pack_verts(&tri_verts[mesh->prim_offset * 3],
+                                        &tri_vindex[mesh->prim_offset],
+                                        &tri_patch[mesh->prim_offset],
+                                        &tri_patch_uv[mesh->vert_offset]);
+                     }
+
+                     if (progress.get_cancel()) {
+                       parallel_for_cancel();
+                       return;
+                     }
+                   }
+                 });
+
+    if (progress.get_cancel())
+      return;
 
     /* vertex coordinates */
     progress.set_status("Updating Mesh", "Copying Mesh to device");
@@ -1156,27 +1181,37 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->curves.need_realloc() ||
                                dscene->curve_segments.need_realloc();
 
-    foreach (Geometry *geom, scene->geometry) {
-      if (geom->is_hair()) {
-        Hair *hair = static_cast<Hair *>(geom);
-
-        bool curve_keys_co_modified = hair->curve_radius_is_modified() ||
-                                      hair->curve_keys_is_modified();
-        bool curve_data_modified = hair->curve_shader_is_modified() ||
-                                   hair->curve_first_key_is_modified();
-
-        if (!curve_keys_co_modified && !curve_data_modified && !copy_all_data) {
-          continue;
-        }
-
-        hair->pack_curves(scene,
-                          &curve_keys[hair->curve_key_offset],
-                          &curves[hair->prim_offset],
-                          &curve_segments[hair->curve_segment_offset]);
-        if (progress.get_cancel())
-          return;
-      }
-    }
+    parallel_for(blocked_range<size_t>(0, scene->geometry.size(), GEOMETRY_PER_TASK),
+                 [&](const blocked_range<size_t> &r) {
+                   for (size_t i = r.begin(); i != r.end(); i++) {
+                     Geometry *geom = scene->geometry[i];
+                     if (!geom->is_hair()) {
+                       continue;
+                     }
+                     Hair *hair = static_cast<Hair *>(geom);
+
+                     bool curve_keys_co_modified = hair->curve_radius_is_modified() ||
+                                                   hair->curve_keys_is_modified();
+                     bool curve_data_modified = hair->curve_shader_is_modified() ||
+                                                hair->curve_first_key_is_modified();
+
+                     if (!curve_keys_co_modified && !curve_data_modified && !copy_all_data) {
+                       continue;
+                     }
+
+                     hair->pack_curves(scene,
+                                       &curve_keys[hair->curve_key_offset],
+                                       &curves[hair->prim_offset],
+                                       &curve_segments[hair->curve_segment_offset]);
+                     if (progress.get_cancel()) {
+                       parallel_for_cancel();
+                       return;
+                     }
+                   }
+                 });
+
+    if (progress.get_cancel())
+      return;
 
     dscene->curve_keys.copy_to_device_if_modified();
     dscene->curves.copy_to_device_if_modified();
@@ -1947,13 +1982,12 @@ void GeometryManager::device_update(Device *device,
       }
     });
 
+    vector<Mesh *> modified_meshes;
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_modified()) {
         if (geom->is_mesh()) {
-          Mesh *mesh = static_cast<Mesh *>(geom);
-          if (displace(device, scene, mesh, progress)) {
-            displacement_done = true;
-          }
+          modified_meshes.push_back(static_cast<Mesh *>(geom));
         }
         else if (geom->geometry_type == Geometry::HAIR) {
           Hair *hair = static_cast<Hair *>(geom);
@@ -1973,6 +2007,10 @@ void GeometryManager::device_update(Device *device,
         return;
       }
     }
+
+    if (displace(device, scene, modified_meshes, progress)) {
+      displacement_done = true;
+    }
   }
 
   if (progress.get_cancel()) {
@@ -68,6 +68,8 @@ class Geometry : public Node {
 
   /* BVH */
   BVH *bvh;
+  /* Number of times the BVH was refit since it was last built. */
+  int bvh_refit_count;
   size_t attr_map_offset;
   size_t prim_offset;
 
@@ -214,7 +216,10 @@ class GeometryManager {
   void collect_statistics(const Scene *scene, RenderStats *stats);
 
  protected:
-  bool displace(Device *device, Scene *scene, Mesh *mesh, Progress &progress);
+  /* Apply true displacement to the meshes, evaluating the shaders of all meshes at once. */
+  bool displace(Device *device, Scene *scene, const vector<Mesh *> &meshes, Progress &progress);
+  /* Stitch vertices and recompute normals after the displacement was applied. */
+  void displace_finish(const Scene *scene, Mesh *mesh);
 
   void create_volume_mesh(const Scene *scene, Volume *volume, Progress &progress);
 
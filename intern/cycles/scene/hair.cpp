@@ -10,6 +10,7 @@
 
 #include "integrator/shader_eval.h"
 
+#include "util/hash.h"
 #include "util/progress.h"
 
 CCL_NAMESPACE_BEGIN
@@ -356,6 +357,93 @@ void Hair::copy_center_to_motion_step(const int motion_step)
   }
 }
 
+void Hair::reduce_curves(const float fraction)
+{
+  if (fraction >= 1.0f || num_curves() == 0) {
+    return;
+  }
+
+  /* Keep a random subset of the curves, using the curve index as seed so that the same curves are
+   * kept every time the same hair is reduced. The radius of the remaining curves is scaled up, so
+   * that the hair covers about the same area. */
+  const float radius_scale = 1.0f / fraction;
+  const size_t old_num_keys = num_keys();
+
+  vector<int> kept_curves;
+  vector<int> kept_keys;
+  array<float3> new_curve_keys;
+  array<float> new_curve_radius;
+  array<int> new_curve_first_key;
+  array<int> new_curve_shader;
+
+  for (size_t i = 0; i < num_curves(); i++) {
+    if (hash_uint2_to_float(i, 0xa1b2c3d4) >= fraction) {
+      continue;
+    }
+
+    const Curve curve = get_curve(i);
+    kept_curves.push_back(i);
+    new_curve_first_key.push_back_slow(new_curve_keys.size());
+    new_curve_shader.push_back_slow(curve_shader[i]);
+
+    for (int k = 0; k < curve.num_keys; k++) {
+      const int key = curve.first_key + k;
+      kept_keys.push_back(key);
+      new_curve_keys.push_back_slow(curve_keys[key]);
+      new_curve_radius.push_back_slow(curve_radius[key] * radius_scale);
+    }
+  }
+
+  for (Attribute &attr : attributes.attributes) {
+    const vector<int> *kept_elements;
+    if (attr.element == ATTR_ELEMENT_CURVE) {
+      kept_elements = &kept_curves;
+    }
+    else if (attr.element == ATTR_ELEMENT_CURVE_KEY ||
+             attr.element == ATTR_ELEMENT_CURVE_KEY_MOTION) {
+      kept_elements = &kept_keys;
+    }
+    else {
+      continue;
+    }
+
+    /* Motion attributes store one block of keys per motion step. */
+    const size_t element_size = attr.data_sizeof();
+    const size_t old_num_elements = (attr.element == ATTR_ELEMENT_CURVE_KEY_MOTION) ?
+                                        old_num_keys :
+                                        attr.buffer.size() / element_size;
+    const size_t num_blocks = (old_num_elements) ?
+                                  attr.buffer.size() / (element_size * old_num_elements) :
+                                  0;
+
+    vector<char> buffer(num_blocks * kept_elements->size() * element_size);
+    char *dst = buffer.data();
+    for (size_t block = 0; block < num_blocks; block++) {
+      const char *src = attr.buffer.data() + block * old_num_elements * element_size;
+      for (const int element : *kept_elements) {
+        memcpy(dst, src + element * element_size, element_size);
+        dst += element_size;
+      }
+    }
+    attr.buffer.swap(buffer);
+
+    /* Motion keys store the radius in the fourth component. */
+    if (attr.std == ATTR_STD_MOTION_VERTEX_POSITION && element_size == sizeof(float4)) {
+      float4 *motion_keys = attr.data_float4();
+      const size_t num_motion_keys = attr.buffer.size() / element_size;
+      for (size_t k = 0; k < num_motion_keys; k++) {
+        motion_keys[k].w *= radius_scale;
+      }
+    }
+    attr.modified = true;
+  }
+
+  set_curve_keys(new_curve_keys);
+  set_curve_radius(new_curve_radius);
+  set_curve_first_key(new_curve_first_key);
+  set_curve_shader(new_curve_shader);
+}
+
 void Hair::get_uv_tiles(ustring map, unordered_set<int> &tiles)
 {
   Attribute *attr;
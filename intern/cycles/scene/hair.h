@@ -102,6 +102,10 @@ class Hair : public Geometry {
 
   void copy_center_to_motion_step(const int motion_step);
 
+  /* Keep only about the given fraction of the curves, with a larger radius to compensate. Used to
+   * simplify hair that is far away from the camera. */
+  void reduce_curves(const float fraction);
+
   void compute_bounds() override;
   void apply_transform(const Transform &tfm, const bool apply_to_motion) override;
 
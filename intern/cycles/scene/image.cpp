@@ -244,6 +244,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
+      mip_levels(1),
+      mip_level(0),
       compress_as_srgb(false)
 {
 }
@@ -539,20 +541,38 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
+  ImageMetaData metadata = img->metadata;
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
 
   /* Read pixels. */
   vector<StorageType> pixels_storage;
   StorageType *pixels;
-  const size_t max_size = max(max(width, height), depth);
+  size_t max_size = max(max(width, height), depth);
   if (max_size == 0) {
     /* Don't bother with empty images. */
     return false;
   }
 
+  /* Read a smaller MIP level from the file when it has one, instead of reading the full image
+   * and scaling it down. */
+  if (texture_limit > 0 && max_size > texture_limit && depth <= 1) {
+    while (metadata.mip_level + 1 < metadata.mip_levels && max_size > texture_limit) {
+      metadata.mip_level++;
+      width = max(width / 2, 1);
+      height = max(height / 2, 1);
+      max_size = max(width, height);
+    }
+    if (metadata.mip_level > 0) {
+      VLOG_WORK << "Loading MIP level " << metadata.mip_level << " of image "
+                << img->loader->name() << ".";
+      metadata.width = width;
+      metadata.height = height;
+    }
+  }
+
   /* Allocate memory as needed, may be smaller to resize down. */
   if (texture_limit > 0 && max_size > texture_limit) {
     pixels_storage.resize(((size_t)width) * height * depth * 4);
@@ -569,8 +589,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
@@ -76,6 +76,12 @@ class ImageMetaData {
   bool use_transform_3d;
   Transform transform_3d;
 
+  /* Optional number of MIP levels stored in the file, each level having half the width and
+   * height of the previous one, rounded down. */
+  int mip_levels;
+  /* MIP level to load pixels from, the width and height are the ones of this level. */
+  int mip_level;
+
   /* Automatically set. */
   bool compress_as_srgb;
 
@@ -87,6 +87,23 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
   metadata.colorspace_file_format = in->format_name();
   metadata.colorspace_file_hint = spec.get_string_attribute("oiio:ColorSpace");
 
+  /* Count the MIP levels stored in the file, e.g. for `.tx` files. Levels with other sizes or
+   * formats than expected are not used. */
+  metadata.mip_levels = 1;
+  if (spec.depth <= 1) {
+    while (in->seek_subimage(0, metadata.mip_levels)) {
+      const ImageSpec &mip_spec = in->spec();
+      const int level_width = max(spec.width >> metadata.mip_levels, 1);
+      const int level_height = max(spec.height >> metadata.mip_levels, 1);
+      if (mip_spec.width != level_width || mip_spec.height != level_height ||
+          mip_spec.depth != spec.depth || mip_spec.nchannels != spec.nchannels ||
+          mip_spec.format != spec.format) {
+        break;
+      }
+      metadata.mip_levels++;
+    }
+  }
+
   in->close();
 
   return true;
@@ -114,7 +131,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
   if (depth <= 1) {
     size_t scanlinesize = width * components * sizeof(StorageType);
     in->read_image(0,
-                   0,
+                   metadata.mip_level,
                    0,
                    components,
                    FileFormat,
@@ -124,7 +141,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
                    AutoStride);
   }
   else {
-    in->read_image(0, 0, 0, components, FileFormat, (uchar *)readpixels);
+    in->read_image(0, metadata.mip_level, 0, components, FileFormat, (uchar *)readpixels);
   }
 
   if (components > 4) {
@@ -72,6 +72,7 @@ NODE_DEFINE(Integrator)
   SOCKET_BOOLEAN(use_volume_guiding, "Volume Guiding", true);
   SOCKET_FLOAT(volume_guiding_probability, "Volume Guiding Probability", 0.5f);
   SOCKET_INT(guiding_training_samples, "Training Samples", 128);
+  SOCKET_BOOLEAN(reuse_guiding_field, "Reuse Guiding Field", false);
   SOCKET_BOOLEAN(use_guiding_direct_light, "Guide Direct Light", true);
   SOCKET_BOOLEAN(use_guiding_mis_weights, "Use MIS Weights", true);
   SOCKET_ENUM(guiding_distribution_type,
@@ -312,8 +313,9 @@ void Integrator::tag_update(Scene *scene, uint32_t flag)
   if (filter_glossy_is_modified()) {
     foreach (Shader *shader, scene->shaders) {
       if (shader->has_integrator_dependency) {
+        /* Tag the shader itself, so that it is not reused from the previous compilation. */
+        shader->tag_modified();
         scene->shader_manager->tag_update(scene, ShaderManager::INTEGRATOR_MODIFIED);
-        break;
       }
     }
   }
@@ -409,6 +411,7 @@ GuidingParams Integrator::get_guiding_params(const Device *device) const
   guiding_params.type = guiding_distribution_type;
   guiding_params.training_samples = guiding_training_samples;
   guiding_params.deterministic = deterministic_guiding;
+  guiding_params.reuse_field = reuse_guiding_field;
 
   return guiding_params;
 }
@@ -51,6 +51,7 @@ class Integrator : public Node {
   NODE_SOCKET_API(bool, use_volume_guiding);
   NODE_SOCKET_API(float, volume_guiding_probability);
   NODE_SOCKET_API(int, guiding_training_samples);
+  NODE_SOCKET_API(bool, reuse_guiding_field);
   NODE_SOCKET_API(bool, use_guiding_direct_light);
   NODE_SOCKET_API(bool, use_guiding_mis_weights);
   NODE_SOCKET_API(GuidingDistributionType, guiding_distribution_type);
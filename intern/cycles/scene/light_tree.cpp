@@ -5,6 +5,8 @@
 #include "scene/mesh.h"
 #include "scene/object.h"
 
+#include "util/task.h"
+
 CCL_NAMESPACE_BEGIN
 
 float OrientationBounds::calculate_measure() const
@@ -210,8 +212,8 @@ LightTree::LightTree(vector<LightTreePrimitive> &prims,
   /* The amount of nodes is estimated to be twice the amount of primitives */
   nodes_.reserve(2 * num_prims);
 
-  nodes_.emplace_back();                             /* root node */
-  recursive_build(0, num_local_lights, prims, 0, 1); /* build tree */
+  nodes_.emplace_back();                                     /* root node */
+  recursive_build(0, num_local_lights, prims, 0, 1, nodes_); /* build tree */
   nodes_[0].make_interior(nodes_.size());
 
   /* All distant lights are grouped to one node (right child of the root node) */
@@ -233,15 +235,32 @@ const vector<LightTreeNode> &LightTree::get_nodes() const
   return nodes_;
 }
 
-int LightTree::recursive_build(
-    int start, int end, vector<LightTreePrimitive> &prims, uint bit_trail, int depth)
+/* Append the nodes of a subtree that was built separately, adjusting the child indices to the
+ * position of the subtree in the array. */
+static void append_subtree(vector<LightTreeNode> &nodes, const vector<LightTreeNode> &subtree)
+{
+  const int offset = nodes.size();
+  nodes.insert(nodes.end(), subtree.begin(), subtree.end());
+  for (int i = offset; i < nodes.size(); i++) {
+    if (!nodes[i].is_leaf()) {
+      nodes[i].right_child_index += offset;
+    }
+  }
+}
+
+int LightTree::recursive_build(int start,
+                               int end,
+                               vector<LightTreePrimitive> &prims,
+                               uint bit_trail,
+                               int depth,
+                               vector<LightTreeNode> &nodes)
 {
   BoundBox bbox = BoundBox::empty;
   OrientationBounds bcone = OrientationBounds::empty;
   BoundBox centroid_bounds = BoundBox::empty;
   float energy_total = 0.0;
   int num_prims = end - start;
-  int current_index = nodes_.size();
+  int current_index = nodes.size();
 
   for (int i = start; i < end; i++) {
     const LightTreePrimitive &prim = prims.at(i);
@@ -252,7 +271,7 @@ int LightTree::recursive_build(
     energy_total += prim.energy;
   }
 
-  nodes_.emplace_back(bbox, bcone, energy_total, bit_trail);
+  nodes.emplace_back(bbox, bcone, energy_total, bit_trail);
 
   bool try_splitting = num_prims > 1 && len(centroid_bounds.size()) > 0.0f;
   int split_dim = -1, split_bucket = 0, num_left_prims = 0;
@@ -283,13 +302,42 @@ int LightTree::recursive_build(
       middle = (start + end) / 2;
     }
 
-    [[maybe_unused]] int left_index = recursive_build(start, middle, prims, bit_trail, depth + 1);
-    int right_index = recursive_build(middle, end, prims, bit_trail | (1u << depth), depth + 1);
-    assert(left_index == current_index + 1);
-    nodes_[current_index].make_interior(right_index);
+    const uint right_bit_trail = bit_trail | (1u << depth);
+    int right_index;
+
+    /* Minimum number of primitives for building the two subtrees in parallel, to avoid threading
+     * overhead for small subtrees. */
+    static const int MIN_PRIMS_PER_TASK = 4096;
+
+    if (num_prims >= MIN_PRIMS_PER_TASK) {
+      /* The subtrees partition disjoint ranges of the primitives, so they can be built in
+       * parallel into separate arrays, which are then appended in depth-first order. */
+      vector<LightTreeNode> left_nodes;
+      vector<LightTreeNode> right_nodes;
+      parallel_for(0, 2, [&](int child) {
+        if (child == 0) {
+          left_nodes.reserve(2 * (middle - start));
+          recursive_build(start, middle, prims, bit_trail, depth + 1, left_nodes);
+        }
+        else {
+          right_nodes.reserve(2 * (end - middle));
+          recursive_build(middle, end, prims, right_bit_trail, depth + 1, right_nodes);
+        }
+      });
+      append_subtree(nodes, left_nodes);
+      right_index = nodes.size();
+      append_subtree(nodes, right_nodes);
+    }
+    else {
+      [[maybe_unused]] int left_index = recursive_build(
+          start, middle, prims, bit_trail, depth + 1, nodes);
+      right_index = recursive_build(middle, end, prims, right_bit_trail, depth + 1, nodes);
+      assert(left_index == current_index + 1);
+    }
+    nodes[current_index].make_interior(right_index);
   }
   else {
-    nodes_[current_index].make_leaf(start, num_prims);
+    nodes[current_index].make_leaf(start, num_prims);
   }
   return current_index;
 }
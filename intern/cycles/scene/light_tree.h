@@ -142,8 +142,12 @@ class LightTree {
   const vector<LightTreeNode> &get_nodes() const;
 
  private:
-  int recursive_build(
-      int start, int end, vector<LightTreePrimitive> &prims, uint bit_trail, int depth);
+  int recursive_build(int start,
+                      int end,
+                      vector<LightTreePrimitive> &prims,
+                      uint bit_trail,
+                      int depth,
+                      vector<LightTreeNode> &nodes);
   float min_split_saoh(const BoundBox &centroid_bbox,
                        int start,
                        int end,
@@ -14,6 +14,7 @@
 #include "util/map.h"
 #include "util/progress.h"
 #include "util/set.h"
+#include "util/tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -36,10 +37,9 @@ static float3 compute_face_normal(const Mesh::Triangle &t, float3 *verts)
 static int fill_shader_input(const Scene *scene,
                              const Mesh *mesh,
                              const int object_index,
-                             device_vector<KernelShaderEvalInput> &d_input)
+                             KernelShaderEvalInput *d_input_data)
 {
   int d_input_size = 0;
-  KernelShaderEvalInput *d_input_data = d_input.data();
 
   const array<int> &mesh_shaders = mesh->get_shader();
   const array<Node *> &mesh_used_shaders = mesh->get_used_shaders();
@@ -100,9 +100,7 @@ static int fill_shader_input(const Scene *scene,
 }
 
 /* Read back mesh displacement shader output. */
-static void read_shader_output(const Scene *scene,
-                               Mesh *mesh,
-                               const device_vector<float> &d_output)
+static void read_shader_output(const Scene *scene, Mesh *mesh, const float *d_output_data)
 {
   const array<int> &mesh_shaders = mesh->get_shader();
   const array<Node *> &mesh_used_shaders = mesh->get_used_shaders();
@@ -112,7 +110,6 @@ static void read_shader_output(const Scene *scene,
   const int num_motion_steps = mesh->get_motion_steps();
   vector<bool> done(num_verts, false);
 
-  const float *d_output_data = d_output.data();
   int d_output_index = 0;
 
   Attribute *attr_mP = mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
@@ -150,43 +147,11 @@ static void read_shader_output(const Scene *scene,
   }
 }
 
-bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progress &progress)
+void GeometryManager::displace_finish(const Scene *scene, Mesh *mesh)
 {
-  /* verify if we have a displacement shader */
-  if (!mesh->has_true_displacement()) {
-    return false;
-  }
-
   const size_t num_verts = mesh->verts.size();
   const size_t num_triangles = mesh->num_triangles();
 
-  if (num_triangles == 0) {
-    return false;
-  }
-
-  string msg = string_printf("Computing Displacement %s", mesh->name.c_str());
-  progress.set_status("Updating Mesh", msg);
-
-  /* find object index. todo: is arbitrary */
-  size_t object_index = OBJECT_NONE;
-
-  for (size_t i = 0; i < scene->objects.size(); i++) {
-    if (scene->objects[i]->get_geometry() == mesh) {
-      object_index = i;
-      break;
-    }
-  }
-
-  /* Evaluate shader on device. */
-  ShaderEval shader_eval(device, progress);
-  if (!shader_eval.eval(SHADER_EVAL_DISPLACE,
-                        num_verts,
-                        3,
-                        function_bind(&fill_shader_input, scene, mesh, object_index, _1),
-                        function_bind(&read_shader_output, scene, mesh, _1))) {
-    return false;
-  }
-
   /* stitch */
   unordered_set<int> stitch_keys;
   for (pair<int, int> i : mesh->vert_to_stitching_key_map) {
@@ -390,6 +355,75 @@ bool GeometryManager::displace(Device *device, Scene *scene, Mesh *mesh, Progres
       }
     }
   }
+}
+
+bool GeometryManager::displace(Device *device,
+                               Scene *scene,
+                               const vector<Mesh *> &meshes,
+                               Progress &progress)
+{
+  /* Gather meshes with a displacement shader. */
+  vector<Mesh *> displace_meshes;
+  size_t num_verts = 0;
+
+  for (Mesh *mesh : meshes) {
+    if (mesh->has_true_displacement() && mesh->num_triangles() != 0) {
+      displace_meshes.push_back(mesh);
+      num_verts += mesh->verts.size();
+    }
+  }
+
+  if (displace_meshes.empty()) {
+    return false;
+  }
+
+  const string msg = (displace_meshes.size() == 1) ?
+                         string_printf("Computing Displacement %s",
+                                       displace_meshes[0]->name.c_str()) :
+                         string_printf("Computing Displacement of %d meshes",
+                                       (int)displace_meshes.size());
+  progress.set_status("Updating Mesh", msg);
+
+  /* Find object index of every mesh. todo: is arbitrary */
+  unordered_map<const Geometry *, int> object_indices;
+  for (size_t i = 0; i < scene->objects.size(); i++) {
+    object_indices.insert({scene->objects[i]->get_geometry(), (int)i});
+  }
+
+  /* Evaluate shaders of all meshes on the device at once. Evaluating every mesh separately
+   * causes a launch and synchronization for each mesh, which dominates for many small meshes. */
+  vector<int> num_mesh_inputs(displace_meshes.size(), 0);
+
+  auto fill_input = [&](device_vector<KernelShaderEvalInput> &d_input) {
+    int num_inputs = 0;
+    for (size_t i = 0; i < displace_meshes.size(); i++) {
+      const Mesh *mesh = displace_meshes[i];
+      const auto it = object_indices.find(mesh);
+      const int object_index = (it != object_indices.end()) ? it->second : OBJECT_NONE;
+      num_mesh_inputs[i] = fill_shader_input(
+          scene, mesh, object_index, d_input.data() + num_inputs);
+      num_inputs += num_mesh_inputs[i];
+    }
+    return num_inputs;
+  };
+
+  auto read_output = [&](device_vector<float> &d_output) {
+    size_t offset = 0;
+    for (size_t i = 0; i < displace_meshes.size(); i++) {
+      read_shader_output(scene, displace_meshes[i], d_output.data() + offset);
+      offset += num_mesh_inputs[i] * 3;
+    }
+  };
+
+  ShaderEval shader_eval(device, progress);
+  if (!shader_eval.eval(SHADER_EVAL_DISPLACE, num_verts, 3, fill_input, read_output)) {
+    return false;
+  }
+
+  /* Meshes are independent, so stitching and normals can be computed in parallel. */
+  parallel_for(size_t(0), displace_meshes.size(), [&](const size_t i) {
+    displace_finish(scene, displace_meshes[i]);
+  });
 
   return true;
 }
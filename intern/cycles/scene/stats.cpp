@@ -239,11 +239,105 @@ string ImageStats::full_report(int indent_level)
   return result;
 }
 
+/* Device statistics. */
+
+DeviceStats::DeviceStats() : occupancy(1.0f)
+{
+}
+
+string DeviceStats::full_report(int indent_level)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+  string result = "";
+  result += indent + name + ":\n";
+  result += string_printf("%s  Occupancy: %.2f\n", indent.c_str(), occupancy);
+  if (!kernels.entries.empty()) {
+    result += indent + "  Kernels:\n" + kernels.full_report(indent_level + 1);
+  }
+  return result;
+}
+
+/* JSON reports. */
+
+static string json_string(const string &str)
+{
+  return "\"" + string_json_escape(str) + "\"";
+}
+
+static string stats_to_json(const NamedSizeStats &stats)
+{
+  string result = string_printf("{\"total_size\": %zu, \"entries\": [", stats.total_size);
+  for (size_t i = 0; i < stats.entries.size(); i++) {
+    const NamedSizeEntry &entry = stats.entries[i];
+    result += string_printf("%s{\"name\": %s, \"size\": %zu}",
+                            i ? ", " : "",
+                            json_string(entry.name).c_str(),
+                            entry.size);
+  }
+  return result + "]}";
+}
+
+static string stats_to_json(const NamedTimeStats &stats)
+{
+  string result = string_printf("{\"total_time\": %f, \"entries\": [", stats.total_time);
+  for (size_t i = 0; i < stats.entries.size(); i++) {
+    const NamedTimeEntry &entry = stats.entries[i];
+    result += string_printf("%s{\"name\": %s, \"time\": %f}",
+                            i ? ", " : "",
+                            json_string(entry.name).c_str(),
+                            entry.time);
+  }
+  return result + "]}";
+}
+
+static string stats_to_json(const NamedNestedSampleStats &stats)
+{
+  /* Profiler samples are taken every millisecond. */
+  string result = string_printf("{\"name\": %s, \"total_time\": %f, \"self_time\": %f",
+                                json_string(stats.name).c_str(),
+                                stats.sum_samples * 0.001,
+                                stats.self_samples * 0.001);
+  if (!stats.entries.empty()) {
+    result += ", \"entries\": [";
+    for (size_t i = 0; i < stats.entries.size(); i++) {
+      result += (i ? ", " : "") + stats_to_json(stats.entries[i]);
+    }
+    result += "]";
+  }
+  return result + "}";
+}
+
+static string stats_to_json(const NamedSampleCountStats &stats)
+{
+  string result = "[";
+  bool first = true;
+  foreach (NamedSampleCountStats::entry_map::const_reference entry, stats.entries) {
+    const NamedSampleCountPair &pair = entry.second;
+    result += string_printf("%s{\"name\": %s, \"time\": %f, \"hits\": %llu}",
+                            first ? "" : ", ",
+                            json_string(pair.name.string()).c_str(),
+                            pair.samples * 0.001,
+                            (unsigned long long)pair.hits);
+    first = false;
+  }
+  return result + "]";
+}
+
+static string stats_to_json(const DeviceStats &stats)
+{
+  return string_printf("{\"name\": %s, \"occupancy\": %f, \"kernels\": %s}",
+                       json_string(stats.name).c_str(),
+                       stats.occupancy,
+                       stats_to_json(stats.kernels).c_str());
+}
+
 /* Overall statistics. */
 
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  device_mem_used = 0;
+  device_mem_peak = 0;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -302,6 +396,15 @@ string RenderStats::full_report()
   string result = "";
   result += "Mesh statistics:\n" + mesh.full_report(1);
   result += "Image statistics:\n" + image.full_report(1);
+  result += string_printf("Device memory: %s (peak %s)\n",
+                          string_human_readable_size(device_mem_used).c_str(),
+                          string_human_readable_size(device_mem_peak).c_str());
+  if (!devices.empty()) {
+    result += "Device statistics:\n";
+    foreach (DeviceStats &device, devices) {
+      result += device.full_report(1);
+    }
+  }
   if (has_profiling) {
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
@@ -313,6 +416,29 @@ string RenderStats::full_report()
   return result;
 }
 
+string RenderStats::json_report()
+{
+  kernel.update_sum();
+
+  string result = "{";
+  result += "\"mesh\": {\"geometry\": " + stats_to_json(mesh.geometry) + "}, ";
+  result += "\"image\": {\"textures\": " + stats_to_json(image.textures) + "}, ";
+  result += string_printf(
+      "\"device_memory\": {\"used\": %zu, \"peak\": %zu}, ", device_mem_used, device_mem_peak);
+  result += "\"devices\": [";
+  for (size_t i = 0; i < devices.size(); i++) {
+    result += (i ? ", " : "") + stats_to_json(devices[i]);
+  }
+  result += "]";
+  if (has_profiling) {
+    result += ", \"profiling\": {";
+    result += "\"kernel\": " + stats_to_json(kernel) + ", ";
+    result += "\"shaders\": " + stats_to_json(shaders) + ", ";
+    result += "\"objects\": " + stats_to_json(objects) + "}";
+  }
+  return result + "}";
+}
+
 NamedTimeStats::NamedTimeStats() : total_time(0.0)
 {
 }
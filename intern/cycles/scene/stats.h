@@ -160,6 +160,24 @@ class ImageStats {
   NamedSizeStats textures;
 };
 
+/* Statistics of a device which was used for path tracing. */
+class DeviceStats {
+ public:
+  DeviceStats();
+
+  /* Generate full human-readable report. */
+  string full_report(int indent_level = 0);
+
+  string name;
+
+  /* Average fraction of the integrator states which were busy while path tracing. */
+  float occupancy;
+
+  /* Execution time of GPU kernels. Kernels which were enqueued together without waiting for the
+   * queue in between share one entry. */
+  NamedTimeStats kernels;
+};
+
 /* Render process statistics. */
 class RenderStats {
  public:
@@ -168,6 +186,9 @@ class RenderStats {
   /* Return full report as string. */
   string full_report();
 
+  /* Return full report in JSON format, for processing by external tools. */
+  string json_report();
+
   /* Collect kernel sampling information from Stats. */
   void collect_profiling(Scene *scene, Profiler &prof);
 
@@ -175,6 +196,10 @@ class RenderStats {
 
   MeshStats mesh;
   ImageStats image;
+  vector<DeviceStats> devices;
+  /* Current and peak memory allocated on all devices. */
+  size_t device_mem_used;
+  size_t device_mem_peak;
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
@@ -32,6 +32,7 @@ SVMShaderManager::~SVMShaderManager()
 
 void SVMShaderManager::reset(Scene * /*scene*/)
 {
+  compiled_shaders_.clear();
 }
 
 void SVMShaderManager::device_update_shader(Scene *scene,
@@ -77,29 +78,54 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
-  /* Build all shaders. */
+  /* Build modified shaders, reuse the nodes of the other ones from the previous update. The
+   * compiled nodes only depend on the shader graph and on whether the shader is used as world
+   * shader. Everything else which is referenced, such as image slots and attribute IDs, stays the
+   * same as long as the shader graph is not changed. */
+  unordered_map<const Shader *, CompiledShader> compiled_shaders;
+  vector<const array<int4> *> shader_svm_nodes(num_shaders);
+  int num_compiled_shaders = 0;
+
   TaskPool task_pool;
-  vector<array<int4>> shader_svm_nodes(num_shaders);
   for (int i = 0; i < num_shaders; i++) {
+    Shader *shader = scene->shaders[i];
+    const bool background = (shader == scene->background->get_shader(scene));
+
+    CompiledShader &compiled = compiled_shaders[shader];
+    shader_svm_nodes[i] = &compiled.svm_nodes;
+
+    auto cached = compiled_shaders_.find(shader);
+    if (cached != compiled_shaders_.end() && !shader->is_modified() &&
+        cached->second.background == background) {
+      compiled.svm_nodes.steal_data(cached->second.svm_nodes);
+      compiled.background = background;
+      continue;
+    }
+
+    compiled.background = background;
     task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
                                  this,
                                  scene,
-                                 scene->shaders[i],
+                                 shader,
                                  &progress,
-                                 &shader_svm_nodes[i]));
+                                 &compiled.svm_nodes));
+    ++num_compiled_shaders;
   }
   task_pool.wait_work();
 
   if (progress.get_cancel()) {
+    compiled_shaders_.clear();
     return;
   }
 
+  compiled_shaders_.swap(compiled_shaders);
+
   /* The global node list contains a jump table (one node per shader)
    * followed by the nodes of all shaders. */
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    svm_nodes_size += shader_svm_nodes[i]->size() - 1;
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
@@ -117,22 +143,22 @@ void SVMShaderManager::device_update_specific(Device *device,
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes[i][0];
+    const int4 &local_jump_node = (*shader_svm_nodes[i])[0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
     global_jump_node.y = local_jump_node.y - 1 + node_offset;
     global_jump_node.z = local_jump_node.z - 1 + node_offset;
     global_jump_node.w = local_jump_node.w - 1 + node_offset;
 
-    node_offset += shader_svm_nodes[i].size() - 1;
+    node_offset += shader_svm_nodes[i]->size() - 1;
   }
 
   /* Copy the nodes of each shader into the correct location. */
   svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    int shader_size = shader_svm_nodes[i].size() - 1;
+    int shader_size = shader_svm_nodes[i]->size() - 1;
 
-    memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
+    memcpy(svm_nodes, &(*shader_svm_nodes[i])[1], sizeof(int4) * shader_size);
     svm_nodes += shader_size;
   }
 
@@ -146,8 +172,8 @@ void SVMShaderManager::device_update_specific(Device *device,
 
   update_flags = UPDATE_NONE;
 
-  VLOG_INFO << "Shader manager updated " << num_shaders << " shaders in " << time_dt() - start_time
-            << " seconds.";
+  VLOG_INFO << "Shader manager updated " << num_shaders << " shaders (" << num_compiled_shaders
+            << " compiled) in " << time_dt() - start_time << " seconds.";
 }
 
 void SVMShaderManager::device_free(Device *device, DeviceScene *dscene, Scene *scene)
@@ -9,6 +9,7 @@
 #include "scene/shader_graph.h"
 
 #include "util/array.h"
+#include "util/map.h"
 #include "util/set.h"
 #include "util/string.h"
 #include "util/thread.h"
@@ -44,6 +45,15 @@ class SVMShaderManager : public ShaderManager {
                             Shader *shader,
                             Progress *progress,
                             array<int4> *svm_nodes);
+
+  /* Compiled SVM nodes of a shader, with the local jump node at the beginning. */
+  struct CompiledShader {
+    array<int4> svm_nodes;
+    bool background = false;
+  };
+
+  /* Result of the previous update, reused for shaders which are not modified since then. */
+  unordered_map<const Shader *, CompiledShader> compiled_shaders_;
 };
 
 /* Graph Compiler */
@@ -557,6 +557,12 @@ static openvdb::FloatGrid::ConstPtr get_vdb_for_attribute(Volume *volume, Attrib
   return openvdb::gridConstPtrCast<openvdb::FloatGrid>(grid);
 }
 
+static bool is_volume_velocity_attribute(const AttributeStandard std)
+{
+  return std == ATTR_STD_VOLUME_VELOCITY || std == ATTR_STD_VOLUME_VELOCITY_X ||
+         std == ATTR_STD_VOLUME_VELOCITY_Y || std == ATTR_STD_VOLUME_VELOCITY_Z;
+}
+
 class MergeScalarGrids {
   typedef openvdb::FloatTree ScalarTree;
 
@@ -675,11 +681,30 @@ void GeometryManager::create_volume_mesh(const Scene *scene, Volume *volume, Pro
 #ifdef WITH_OPENVDB
   merge_scalar_grids_for_velocity(scene, volume);
 
+  /* Velocity is only used to offset the lookups of the other grids for motion blur, which is
+   * accounted for by the padding below. Simulation caches often have velocity far outside of the
+   * smoke or fire, so leaving it out of the mesh avoids ray marching through empty space. Unless
+   * there are no other grids, in which case the shader can only use velocity. */
+  bool has_non_velocity_grid = false;
+  for (const Attribute &attr : volume->attributes.attributes) {
+    if (attr.element == ATTR_ELEMENT_VOXEL && !is_volume_velocity_attribute(attr.std)) {
+      has_non_velocity_grid = true;
+      break;
+    }
+  }
+
   for (Attribute &attr : volume->attributes.attributes) {
     if (attr.element != ATTR_ELEMENT_VOXEL) {
       continue;
     }
 
+    const bool use_for_mesh = !(has_non_velocity_grid && is_volume_velocity_attribute(attr.std));
+    const bool use_for_padding = attr.std == ATTR_STD_VOLUME_VELOCITY &&
+                                 scene->need_motion() != Scene::MOTION_NONE;
+    if (!use_for_mesh && !use_for_padding) {
+      continue;
+    }
+
     bool do_clipping = false;
 
     ImageHandle &handle = attr.data_voxel();
@@ -714,12 +739,14 @@ void GeometryManager::create_volume_mesh(const Scene *scene, Volume *volume, Pro
 
     if (grid) {
       /* Add padding based on the maximum velocity vector. */
-      if (attr.std == ATTR_STD_VOLUME_VELOCITY && scene->need_motion() != Scene::MOTION_NONE) {
+      if (use_for_padding) {
         pad_size = max(pad_size,
                        estimate_required_velocity_padding(grid, volume->get_velocity_scale()));
       }
 
-      builder.add_grid(grid, do_clipping, volume->get_clipping());
+      if (use_for_mesh) {
+        builder.add_grid(grid, do_clipping, volume->get_clipping());
+      }
     }
   }
 #else
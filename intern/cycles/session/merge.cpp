@@ -6,6 +6,7 @@
 #include "util/array.h"
 #include "util/map.h"
 #include "util/system.h"
+#include "util/task.h"
 #include "util/time.h"
 #include "util/unique_ptr.h"
 
@@ -387,6 +388,63 @@ static void alloc_pixels(const ImageSpec &spec, array<float> &pixels)
   pixels.resize(num_pixels * num_channels);
 }
 
+static void merge_pass(const MergeImageLayer &layer,
+                       const MergeImagePass &pass,
+                       const size_t stride,
+                       const size_t out_stride,
+                       const unordered_map<string, SampleCount> &layer_samples,
+                       const array<float> &pixels,
+                       array<float> &out_pixels)
+{
+  const size_t num_pixels = pixels.size();
+  size_t offset = pass.offset;
+  size_t out_offset = pass.merge_offset;
+
+  switch (pass.op) {
+    case MERGE_CHANNEL_NOP:
+      break;
+    case MERGE_CHANNEL_COPY:
+      for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
+        out_pixels[out_offset] = pixels[offset];
+      }
+      break;
+    case MERGE_CHANNEL_SUM:
+      for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
+        out_pixels[out_offset] += pixels[offset];
+      }
+      break;
+    case MERGE_CHANNEL_AVERAGE: {
+      /* Weights based on sample count passes and sample metadata. Per channel since not
+       * all files are guaranteed to have the same channels. */
+      size_t sample_pass_offset = layer.sample_pass_offset;
+      const auto &samples = layer_samples.at(layer.name);
+
+      for (size_t i = 0; offset < num_pixels;
+           offset += stride, sample_pass_offset += stride, out_offset += out_stride, i++) {
+        const float total_samples = samples.per_pixel[i];
+
+        float layer_samples;
+        if (layer.has_sample_pass) {
+          layer_samples = pixels[sample_pass_offset] * layer.samples;
+        }
+        else {
+          layer_samples = layer.samples;
+        }
+
+        out_pixels[out_offset] += pixels[offset] * (1.0f * layer_samples / total_samples);
+      }
+      break;
+    }
+    case MERGE_CHANNEL_SAMPLES: {
+      const auto &samples = layer_samples.at(layer.name);
+      for (size_t i = 0; offset < num_pixels; offset += stride, out_offset += out_stride, i++) {
+        out_pixels[out_offset] = 1.0f * samples.per_pixel[i] / samples.total;
+      }
+      break;
+    }
+  }
+}
+
 static bool merge_pixels(const vector<MergeImage> &images,
                          const ImageSpec &out_spec,
                          const unordered_map<string, SampleCount> &layer_samples,
@@ -407,61 +465,25 @@ static bool merge_pixels(const vector<MergeImage> &images,
       return false;
     }
 
+    /* Every pass of the image is merged into different channels of the output, so passes can be
+     * merged in parallel. */
+    vector<const MergeImageLayer *> pass_layers;
+    vector<const MergeImagePass *> passes;
     for (const MergeImageLayer &layer : image.layers) {
-      const size_t stride = image.in->spec().nchannels;
-      const size_t out_stride = out_spec.nchannels;
-      const size_t num_pixels = pixels.size();
-
       for (const MergeImagePass &pass : layer.passes) {
-        size_t offset = pass.offset;
-        size_t out_offset = pass.merge_offset;
-
-        switch (pass.op) {
-          case MERGE_CHANNEL_NOP:
-            break;
-          case MERGE_CHANNEL_COPY:
-            for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
-              out_pixels[out_offset] = pixels[offset];
-            }
-            break;
-          case MERGE_CHANNEL_SUM:
-            for (; offset < num_pixels; offset += stride, out_offset += out_stride) {
-              out_pixels[out_offset] += pixels[offset];
-            }
-            break;
-          case MERGE_CHANNEL_AVERAGE: {
-            /* Weights based on sample count passes and sample metadata. Per channel since not
-             * all files are guaranteed to have the same channels. */
-            size_t sample_pass_offset = layer.sample_pass_offset;
-            const auto &samples = layer_samples.at(layer.name);
-
-            for (size_t i = 0; offset < num_pixels;
-                 offset += stride, sample_pass_offset += stride, out_offset += out_stride, i++) {
-              const float total_samples = samples.per_pixel[i];
-
-              float layer_samples;
-              if (layer.has_sample_pass) {
-                layer_samples = pixels[sample_pass_offset] * layer.samples;
-              }
-              else {
-                layer_samples = layer.samples;
-              }
-
-              out_pixels[out_offset] += pixels[offset] * (1.0f * layer_samples / total_samples);
-            }
-            break;
-          }
-          case MERGE_CHANNEL_SAMPLES: {
-            const auto &samples = layer_samples.at(layer.name);
-            for (size_t i = 0; offset < num_pixels;
-                 offset += stride, out_offset += out_stride, i++) {
-              out_pixels[out_offset] = 1.0f * samples.per_pixel[i] / samples.total;
-            }
-            break;
-          }
-        }
+        pass_layers.push_back(&layer);
+        passes.push_back(&pass);
       }
     }
+
+    const size_t stride = image.in->spec().nchannels;
+    const size_t out_stride = out_spec.nchannels;
+    parallel_for(blocked_range<size_t>(0, passes.size(), 1), [&](const blocked_range<size_t> &r) {
+      for (size_t i = r.begin(); i != r.end(); i++) {
+        merge_pass(
+            *pass_layers[i], *passes[i], stride, out_stride, layer_samples, pixels, out_pixels);
+      }
+    });
   }
 
   return true;
@@ -732,6 +732,9 @@ void Session::device_free()
 void Session::collect_statistics(RenderStats *render_stats)
 {
   scene->collect_statistics(render_stats);
+  path_trace_->collect_statistics(render_stats);
+  render_stats->device_mem_used = stats.mem_used;
+  render_stats->device_mem_peak = stats.mem_peak;
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
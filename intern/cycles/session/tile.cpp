@@ -321,6 +321,7 @@ TileManager::TileManager()
 
 TileManager::~TileManager()
 {
+  stop_tile_writer_thread();
 }
 
 int TileManager::compute_render_tile_size(const int suggested_tile_size) const
@@ -468,6 +469,10 @@ bool TileManager::open_tile_output()
   }
 
   write_state_.num_tiles_written = 0;
+  write_state_.write_error = false;
+
+  write_state_.writer_thread = make_unique<thread>(
+      function_bind(&TileManager::tile_writer_thread_run, this));
 
   VLOG_WORK << "Opened tile file " << write_state_.filename;
 
@@ -480,7 +485,9 @@ bool TileManager::close_tile_output()
     return true;
   }
 
-  const bool success = write_state_.tile_out->close();
+  stop_tile_writer_thread();
+
+  const bool success = write_state_.tile_out->close() && !write_state_.write_error;
   write_state_.tile_out = nullptr;
 
   if (!success) {
@@ -513,68 +520,131 @@ bool TileManager::write_tile(const RenderBuffers &tile_buffers)
   const int64_t pass_stride = tile_params.pass_stride;
   const int64_t tile_row_stride = tile_params.width * pass_stride;
 
-  vector<float> pixel_storage;
+  /* Copy pixels of the tile window into a single continuous block of memory without any "gaps".
+   * The copy is needed since the render buffers are re-used for the next tile while this one is
+   * written on the writer thread.
+   * Not having gaps is also a workaround for bug in OIIO
+   * (https://github.com/OpenImageIO/oiio/pull/3176). Our task reference: T93008. */
+  WriteState::PendingTile tile;
+  tile.x = tile_x;
+  tile.y = tile_y;
+  tile.width = tile_params.window_width;
+  tile.height = tile_params.window_height;
+  tile.pass_stride = pass_stride;
+  tile.pixels.resize(pass_stride * tile_params.window_width * tile_params.window_height);
+
   const float *pixels = tile_buffers.buffer.data() + tile_params.window_x * pass_stride +
                         tile_params.window_y * tile_row_stride;
+  float *pixels_continuous = tile.pixels.data();
 
-  /* If there is an overscan used for the tile copy pixels into single continuous block of memory
-   * without any "gaps".
-   * This is a workaround for bug in OIIO (https://github.com/OpenImageIO/oiio/pull/3176).
-   * Our task reference: T93008. */
-  if (tile_params.window_x || tile_params.window_y ||
-      tile_params.window_width != tile_params.width ||
-      tile_params.window_height != tile_params.height) {
-    pixel_storage.resize(pass_stride * tile_params.window_width * tile_params.window_height);
-    float *pixels_continuous = pixel_storage.data();
-
-    const int64_t pixels_row_stride = pass_stride * tile_params.width;
-    const int64_t pixels_continuous_row_stride = pass_stride * tile_params.window_width;
-
-    for (int i = 0; i < tile_params.window_height; ++i) {
-      memcpy(pixels_continuous, pixels, sizeof(float) * pixels_continuous_row_stride);
-      pixels += pixels_row_stride;
-      pixels_continuous += pixels_continuous_row_stride;
-    }
+  const int64_t pixels_continuous_row_stride = pass_stride * tile_params.window_width;
 
-    pixels = pixel_storage.data();
-  }
-
-  VLOG_WORK << "Write tile at " << tile_x << ", " << tile_y;
-
-  /* The image tile sizes in the OpenEXR file are different from the size of our big tiles. The
-   * write_tiles() method expects a contiguous image region that will be split into tiles
-   * internally. OpenEXR expects the size of this region to be a multiple of the tile size,
-   * however OpenImageIO automatically adds the required padding.
-   *
-   * The only thing we have to ensure is that the tile_x and tile_y are a multiple of the
-   * image tile size, which happens in compute_render_tile_size. */
-
-  const int64_t xstride = pass_stride * sizeof(float);
-  const int64_t ystride = xstride * tile_params.window_width;
-  const int64_t zstride = ystride * tile_params.window_height;
-
-  if (!write_state_.tile_out->write_tiles(tile_x,
-                                          tile_x + tile_params.window_width,
-                                          tile_y,
-                                          tile_y + tile_params.window_height,
-                                          0,
-                                          1,
-                                          TypeDesc::FLOAT,
-                                          pixels,
-                                          xstride,
-                                          ystride,
-                                          zstride)) {
-    LOG(ERROR) << "Error writing tile " << write_state_.tile_out->geterror();
-    return false;
+  for (int i = 0; i < tile_params.window_height; ++i) {
+    memcpy(pixels_continuous, pixels, sizeof(float) * pixels_continuous_row_stride);
+    pixels += tile_row_stride;
+    pixels_continuous += pixels_continuous_row_stride;
   }
 
+  VLOG_WORK << "Queue tile at " << tile_x << ", " << tile_y << " for writing";
+
+  {
+    thread_scoped_lock lock(write_state_.mutex);
+    write_state_.cond.wait(lock, [&]() {
+      return write_state_.pending_tiles.size() < size_t(MAX_PENDING_TILES) ||
+             write_state_.write_error;
+    });
+    if (write_state_.write_error) {
+      return false;
+    }
+    write_state_.pending_tiles.push_back(std::move(tile));
+  }
+  write_state_.cond.notify_all();
+
   ++write_state_.num_tiles_written;
 
-  VLOG_WORK << "Tile written in " << time_dt() - time_start << " seconds.";
+  VLOG_WORK << "Tile queued in " << time_dt() - time_start << " seconds.";
 
   return true;
 }
 
+void TileManager::tile_writer_thread_run()
+{
+  thread_scoped_lock lock(write_state_.mutex);
+
+  while (true) {
+    write_state_.cond.wait(
+        lock, [&]() { return !write_state_.pending_tiles.empty() || write_state_.stop_writer; });
+    if (write_state_.pending_tiles.empty()) {
+      /* Stop was requested and all queued tiles are written. */
+      break;
+    }
+
+    const WriteState::PendingTile tile = std::move(write_state_.pending_tiles.front());
+    write_state_.pending_tiles.pop_front();
+
+    lock.unlock();
+    write_state_.cond.notify_all();
+
+    const double time_start = time_dt();
+
+    /* The image tile sizes in the OpenEXR file are different from the size of our big tiles. The
+     * write_tiles() method expects a contiguous image region that will be split into tiles
+     * internally. OpenEXR expects the size of this region to be a multiple of the tile size,
+     * however OpenImageIO automatically adds the required padding.
+     *
+     * The only thing we have to ensure is that the tile_x and tile_y are a multiple of the
+     * image tile size, which happens in compute_render_tile_size. */
+
+    const int64_t xstride = tile.pass_stride * sizeof(float);
+    const int64_t ystride = xstride * tile.width;
+    const int64_t zstride = ystride * tile.height;
+
+    const bool success = write_state_.tile_out->write_tiles(tile.x,
+                                                            tile.x + tile.width,
+                                                            tile.y,
+                                                            tile.y + tile.height,
+                                                            0,
+                                                            1,
+                                                            TypeDesc::FLOAT,
+                                                            tile.pixels.data(),
+                                                            xstride,
+                                                            ystride,
+                                                            zstride);
+
+    if (success) {
+      VLOG_WORK << "Tile at " << tile.x << ", " << tile.y << " written in "
+                << time_dt() - time_start << " seconds.";
+    }
+    else {
+      LOG(ERROR) << "Error writing tile " << write_state_.tile_out->geterror();
+    }
+
+    lock.lock();
+
+    if (!success) {
+      write_state_.write_error = true;
+      write_state_.cond.notify_all();
+    }
+  }
+}
+
+void TileManager::stop_tile_writer_thread()
+{
+  if (!write_state_.writer_thread) {
+    return;
+  }
+
+  {
+    thread_scoped_lock lock(write_state_.mutex);
+    write_state_.stop_writer = true;
+  }
+  write_state_.cond.notify_all();
+
+  write_state_.writer_thread->join();
+  write_state_.writer_thread.reset();
+  write_state_.stop_writer = false;
+}
+
 void TileManager::finish_write_tiles()
 {
   if (!write_state_.tile_out) {
@@ -4,9 +4,12 @@
 #pragma once
 
 #include "session/buffers.h"
+#include "util/deque.h"
 #include "util/image.h"
 #include "util/string.h"
+#include "util/thread.h"
 #include "util/unique_ptr.h"
+#include "util/vector.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -83,9 +86,12 @@ class TileManager {
 
   /* Write render buffer of a tile to a file on disk.
    *
-   * Opens file for write when first tile is written.
+   * Opens file for write when first tile is written. The pixels are copied and the actual write
+   * happens on a background thread, so that the render thread does not wait for the compression
+   * and the disk. At most MAX_PENDING_TILES tiles are queued, after which the call blocks until
+   * the writer catches up.
    *
-   * Returns true on success. */
+   * Returns true on success. An error of a previous background write is reported here. */
   bool write_tile(const RenderBuffers &tile_buffers);
 
   /* Inform the tile manager that no more tiles will be written to disk.
@@ -117,6 +123,10 @@ class TileManager {
    * Use conservative value which is safe for most of OpenGL drivers and GPUs. */
   static const int MAX_TILE_SIZE = 8192;
 
+  /* Maximum number of tiles which are queued for writing by the background thread. Every queued
+   * tile holds a copy of its pixels, so this bounds the extra memory used by the writer. */
+  static const int MAX_PENDING_TILES = 2;
+
  protected:
   /* Get tile configuration for its index.
    * The tile index must be within [0, state_.tile_state_). */
@@ -125,6 +135,10 @@ class TileManager {
   bool open_tile_output();
   bool close_tile_output();
 
+  /* Background writing of tiles. The writer thread owns the tile output while it is running. */
+  void tile_writer_thread_run();
+  void stop_tile_writer_thread();
+
   string temp_dir_;
 
   /* Part of an on-disk tile file name which avoids conflicts between several Cycles instances or
@@ -150,7 +164,7 @@ class TileManager {
   } tile_state_;
 
   /* State of tiles writing to a file on disk. */
-  struct {
+  struct WriteState {
     /* Index of a tile file used during the current session.
      * This number is used for the file name construction, making it possible to render several
      * scenes throughout duration of the session and keep all results available for later read
@@ -173,6 +187,23 @@ class TileManager {
     unique_ptr<ImageOutput> tile_out;
 
     int num_tiles_written = 0;
+
+    /* Tile which is copied from the render buffers and waits to be written to the file. */
+    struct PendingTile {
+      int x, y;
+      int width, height;
+      int pass_stride;
+      vector<float> pixels;
+    };
+
+    unique_ptr<thread> writer_thread;
+    thread_mutex mutex;
+    thread_condition_variable cond;
+    deque<PendingTile> pending_tiles;
+    /* Set when the writer thread is to exit once the pending tiles are written. */
+    bool stop_writer = false;
+    /* Set by the writer thread when writing of a tile failed. */
+    bool write_error = false;
   } write_state_;
 };
 
@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(work_balance_do_rebalance, Balanced)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 1.01;
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.5, 1e-6);
+}
+
+TEST(work_balance_do_rebalance, Heterogeneous)
+{
+  /* Devices which are 10, 2 and 1 times as fast as the slowest one. */
+  const double speed[3] = {10.0, 2.0, 1.0};
+
+  vector<WorkBalanceInfo> infos(3);
+  work_balance_do_initial(infos);
+  for (int i = 0; i < 3; i++) {
+    infos[i].time_spent = infos[i].weight / speed[i];
+  }
+
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 10.0 / 13.0, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 2.0 / 13.0, 1e-6);
+  EXPECT_NEAR(infos[2].weight, 1.0 / 13.0, 1e-6);
+
+  /* With the new weights all devices take the same time, so no further rebalance is needed. */
+  for (int i = 0; i < 3; i++) {
+    infos[i].time_spent = infos[i].weight / speed[i];
+  }
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+}
+
+TEST(work_balance_do_rebalance, NoStatistics)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 0.0;
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5, 1e-6);
+}
+
+CCL_NAMESPACE_END
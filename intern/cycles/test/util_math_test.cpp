@@ -45,4 +45,23 @@ TEST(math, reverse_integer_bits)
   EXPECT_EQ(reverse_integer_bits(0xAAAAAAAA), 0x55555555);
 }
 
+TEST(math, octahedral_normal)
+{
+  const float3 normals[] = {make_float3(1.0f, 0.0f, 0.0f),
+                            make_float3(0.0f, -1.0f, 0.0f),
+                            make_float3(0.0f, 0.0f, 1.0f),
+                            make_float3(0.0f, 0.0f, -1.0f),
+                            normalize(make_float3(1.0f, -2.0f, 3.0f)),
+                            normalize(make_float3(-0.5f, 0.25f, -1.0f))};
+  for (const float3 n : normals) {
+    const float3 decoded = octahedral_to_float3(float3_to_octahedral(n));
+    EXPECT_NEAR(decoded.x, n.x, 1e-4f);
+    EXPECT_NEAR(decoded.y, n.y, 1e-4f);
+    EXPECT_NEAR(decoded.z, n.z, 1e-4f);
+  }
+
+  const float3 zero = octahedral_to_float3(float3_to_octahedral(zero_float3()));
+  EXPECT_EQ(zero.z, 1.0f);
+}
+
 CCL_NAMESPACE_END
@@ -304,4 +304,16 @@ TEST(string_endswith, basic)
   EXPECT_FALSE(string_endswith("Hello", "WorldHello"));
 }
 
+/* ******** Tests for string_json_escape() ******** */
+
+TEST(string_json_escape, basic)
+{
+  EXPECT_EQ(string_json_escape(""), "");
+  EXPECT_EQ(string_json_escape("Hello"), "Hello");
+  EXPECT_EQ(string_json_escape("say \"hi\""), "say \\\"hi\\\"");
+  EXPECT_EQ(string_json_escape("C:\\tmp"), "C:\\\\tmp");
+  EXPECT_EQ(string_json_escape("a\nb\tc"), "a\\nb\\tc");
+  EXPECT_EQ(string_json_escape("\x01"), "\\u0001");
+}
+
 CCL_NAMESPACE_END
@@ -412,6 +412,42 @@ ccl_device_inline float3 safe_normalize_len(const float3 a, ccl_private float *t
   return (*t != 0.0f) ? a / (*t) : a;
 }
 
+/* Octahedral encoding of unit vectors into two 16 bit signed normalized integers packed in one
+ * uint, used for compact storage of normals. A zero vector is encoded as +Z. */
+#ifndef __KERNEL_GPU__
+ccl_device_inline uint float3_to_octahedral(const float3 n)
+{
+  const float l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+  float x = 0.0f, y = 0.0f;
+  if (l1 > 0.0f) {
+    x = n.x / l1;
+    y = n.y / l1;
+    if (n.z < 0.0f) {
+      /* Fold the lower hemisphere over the diagonals. */
+      const float folded_x = (1.0f - fabsf(y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+      const float folded_y = (1.0f - fabsf(x)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+      x = folded_x;
+      y = folded_y;
+    }
+  }
+  const int ix = (int)roundf(clamp(x, -1.0f, 1.0f) * 32767.0f);
+  const int iy = (int)roundf(clamp(y, -1.0f, 1.0f) * 32767.0f);
+  return ((uint)ix & 0xFFFFu) | ((uint)iy << 16);
+}
+#endif
+
+ccl_device_inline float3 octahedral_to_float3(const uint code)
+{
+  /* Sign extend the two 16 bit halves. */
+  const float x = (float)((int)(code << 16) >> 16) * (1.0f / 32767.0f);
+  const float y = (float)((int)code >> 16) * (1.0f / 32767.0f);
+  float3 n = make_float3(x, y, 1.0f - fabsf(x) - fabsf(y));
+  const float t = max(-n.z, 0.0f);
+  n.x += (n.x >= 0.0f) ? -t : t;
+  n.y += (n.y >= 0.0f) ? -t : t;
+  return normalize(n);
+}
+
 ccl_device_inline float3 safe_divide(const float3 a, const float3 b)
 {
   return make_float3((b.x != 0.0f) ? a.x / b.x : 0.0f,
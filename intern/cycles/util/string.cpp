@@ -189,6 +189,40 @@ string string_to_lower(const string &s)
   return r;
 }
 
+string string_json_escape(const string &s)
+{
+  string result;
+  result.reserve(s.size());
+  for (const char c : s) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          result += string_printf("\\u%04x", (unsigned char)c);
+        }
+        else {
+          result += c;
+        }
+        break;
+    }
+  }
+  return result;
+}
+
 /* Wide char strings helpers for Windows. */
 
 #ifdef _WIN32
@@ -47,6 +47,8 @@ string string_from_bool(const bool var);
 string to_string(const char *str);
 string to_string(const float4 &v);
 string string_to_lower(const string &s);
+/* Escape the string for use inside of a quoted JSON string. */
+string string_json_escape(const string &s);
 
 /* Wide char strings are only used on Windows to deal with non-ASCII
  * characters in file names and such. No reason to use such strings
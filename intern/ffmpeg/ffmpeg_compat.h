@@ -44,6 +44,17 @@
 #  define FFMPEG_USE_OLD_CHANNEL_VARS
 #endif
 
+#if (LIBAVFORMAT_VERSION_MAJOR >= 59)
+/* Since ffmpeg 5.0, swscale can convert slices of a frame in parallel. */
+#  define FFMPEG_SWSCALE_THREADING
+#endif
+
+#if (LIBAVFORMAT_VERSION_MAJOR > 58) || \
+    ((LIBAVFORMAT_VERSION_MAJOR == 58) && (LIBAVFORMAT_VERSION_MINOR >= 12))
+/* Hardware decoder configurations can be queried since ffmpeg 4.0. */
+#  define FFMPEG_HAVE_HW_DECODE
+#endif
+
 #if (LIBAVFORMAT_VERSION_MAJOR < 58) || \
     ((LIBAVFORMAT_VERSION_MAJOR == 58) && (LIBAVFORMAT_VERSION_MINOR < 76))
 #  define FFMPEG_USE_DURATION_WORKAROUND 1
@@ -172,6 +172,34 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including `mmap` allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/** Subsystems that memory usage is accounted to, see #MEM_tag_set. */
+typedef enum eMemTag {
+  MEM_TAG_NONE = 0,
+  MEM_TAG_DEPSGRAPH,
+  MEM_TAG_GEOMETRY,
+  MEM_TAG_DRAW,
+  MEM_TAG_UNDO,
+  MEM_TAG_IMAGE,
+  MEM_TAG_CYCLES,
+  MEM_TAG_PYTHON,
+} eMemTag;
+#define MEM_TAG_NUM (MEM_TAG_PYTHON + 1)
+
+/**
+ * Account the memory allocated by the calling thread to the given tag, until the tag is changed
+ * again. Returns the previous tag of the thread, which should be restored afterwards.
+ *
+ * Only the lock-free allocator keeps track of tags. Work done by other threads (e.g. in parallel
+ * loops) is accounted to the tag of those threads.
+ */
+eMemTag MEM_tag_set(eMemTag tag);
+
+/** Name of the tag for the UI and reports. */
+const char *MEM_tag_name(eMemTag tag) ATTR_WARN_UNUSED_RESULT;
+
+/** Get the memory usage in bytes of the blocks allocated with the given tag. */
+size_t MEM_get_memory_in_use_by_tag(eMemTag tag) ATTR_WARN_UNUSED_RESULT;
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -247,6 +275,16 @@ void MEM_use_lockfree_allocator(void);
  * NOTE: The switch between allocator types can only happen before any allocation did happen. */
 void MEM_use_guarded_allocator(void);
 
+/* Serve small blocks of the lock-free allocator from per-thread caches of size-class slabs,
+ * instead of calling the system allocator for each of them.
+ *
+ * Memory usage statistics and leak detection are not affected. Slabs are kept for reuse and never
+ * returned to the system allocator. Enabled by default when built with `WITH_MEM_SLAB_ALLOCATOR`.
+ *
+ * NOTE: This can be changed at any time, blocks are always freed by the allocator which created
+ * them. */
+void MEM_use_slab_allocator(bool enabled);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -290,6 +328,27 @@ template<typename T> inline void MEM_delete(const T *ptr)
   MEM_freeN(const_cast<T *>(ptr));
 }
 
+/**
+ * Account the memory allocated by the current thread to a tag while this is in scope,
+ * see #MEM_tag_set.
+ */
+class MEM_TagScope {
+  eMemTag prev_tag_;
+
+ public:
+  explicit MEM_TagScope(const eMemTag tag) : prev_tag_(MEM_tag_set(tag))
+  {
+  }
+
+  ~MEM_TagScope()
+  {
+    MEM_tag_set(prev_tag_);
+  }
+
+  MEM_TagScope(const MEM_TagScope &other) = delete;
+  MEM_TagScope &operator=(const MEM_TagScope &other) = delete;
+};
+
 /**
  * Allocates zero-initialized memory for an object of type #T. The constructor of #T is not called,
  * therefor this should only used with trivial types (like all C types).
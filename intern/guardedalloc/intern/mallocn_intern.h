@@ -90,13 +90,24 @@ extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
 void memory_usage_init(void);
-void memory_usage_block_alloc(size_t size);
-void memory_usage_block_free(size_t size);
+/* Returns the #eMemTag of the calling thread, which has to be passed back when freeing. */
+int memory_usage_block_alloc(size_t size);
+void memory_usage_block_free(size_t size, int tag);
 size_t memory_usage_block_num(void);
 size_t memory_usage_current(void);
+size_t memory_usage_current_by_tag(int tag);
 size_t memory_usage_peak(void);
 void memory_usage_peak_reset(void);
 
+/* Size-class slab allocator used for small blocks by the lock-free allocator, when enabled with
+ * #MEM_use_slab_allocator. Sizes include the #MemHead. */
+#define MEM_SLAB_BLOCK_SIZE_MAX 512
+
+void mem_slab_init(void);
+void *mem_slab_alloc(size_t size);
+void mem_slab_free(void *ptr, size_t size);
+size_t mem_slab_reserved(void);
+
 /* Prototypes for counted allocator functions */
 size_t MEM_lockfree_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_lockfree_freeN(void *vmemh);
@@ -7,6 +7,7 @@
  */
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h> /* printf */
 #include <stdlib.h>
 #include <string.h> /* memcpy */
@@ -32,17 +33,40 @@ typedef struct MemHeadAligned {
 
 static bool malloc_debug_memset = false;
 
+#ifdef WITH_MEM_SLAB_ALLOCATOR
+static bool use_slab_allocator = true;
+#else
+static bool use_slab_allocator = false;
+#endif
+
 static void (*error_callback)(const char *) = NULL;
 
 enum {
   MEMHEAD_ALIGN_FLAG = 1,
+  /* The block was allocated by the slab allocator. */
+  MEMHEAD_SLAB_FLAG = 2,
 };
 
 #define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
 #define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
-#define MEMHEAD_LEN(memhead) ((memhead)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG)))
+#define MEMHEAD_IS_SLAB(memhead) ((memhead)->len & (size_t)MEMHEAD_SLAB_FLAG)
+
+/* The #eMemTag of a block is stored in the highest byte of its length, which is never used by
+ * actual lengths on 64-bit platforms. Tags are not stored on 32-bit platforms. */
+#if SIZE_MAX > 0xFFFFFFFFu
+#  define MEMHEAD_TAG_SHIFT 56
+#  define MEMHEAD_TAG_BITS(tag) ((size_t)(tag) << MEMHEAD_TAG_SHIFT)
+#  define MEMHEAD_TAG(memhead) ((int)((memhead)->len >> MEMHEAD_TAG_SHIFT))
+#else
+#  define MEMHEAD_TAG_BITS(tag) ((size_t)0)
+#  define MEMHEAD_TAG(memhead) MEM_TAG_NONE
+#endif
+
+#define MEMHEAD_LEN(memhead) \
+  ((memhead)->len & \
+   ~((size_t)(MEMHEAD_ALIGN_FLAG | MEMHEAD_SLAB_FLAG) | MEMHEAD_TAG_BITS(UINT8_MAX)))
 
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
@@ -63,6 +87,43 @@ print_error(const char *str, ...)
   }
 }
 
+/* Report which subsystems use memory, helps finding out why an allocation failed. */
+static void print_memory_usage_by_tag(void)
+{
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    print_error("  %s: %.3f MB\n",
+                MEM_tag_name((eMemTag)tag),
+                (double)memory_usage_current_by_tag(tag) / (double)(1024 * 1024));
+  }
+}
+
+/**
+ * Allocate a block with a #MemHead followed by `len` bytes, which are cleared when `clear` is set.
+ * Small blocks come from the slab allocator when it is enabled.
+ */
+static MemHead *memhead_alloc(const size_t len, const bool clear)
+{
+  const size_t size = len + sizeof(MemHead);
+  MemHead *memh;
+
+  if (use_slab_allocator && size <= MEM_SLAB_BLOCK_SIZE_MAX) {
+    memh = (MemHead *)mem_slab_alloc(size);
+    if (LIKELY(memh)) {
+      if (clear) {
+        memset(memh + 1, 0, len);
+      }
+      memh->len = len | (size_t)MEMHEAD_SLAB_FLAG;
+    }
+    return memh;
+  }
+
+  memh = (MemHead *)(clear ? calloc(1, size) : malloc(size));
+  if (LIKELY(memh)) {
+    memh->len = len;
+  }
+  return memh;
+}
+
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (LIKELY(vmemh)) {
@@ -89,7 +150,7 @@ void MEM_lockfree_freeN(void *vmemh)
   MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
   size_t len = MEMHEAD_LEN(memh);
 
-  memory_usage_block_free(len);
+  memory_usage_block_free(len, MEMHEAD_TAG(memh));
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -98,6 +159,9 @@ void MEM_lockfree_freeN(void *vmemh)
     MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
+  else if (MEMHEAD_IS_SLAB(memh)) {
+    mem_slab_free(memh, len + sizeof(MemHead));
+  }
   else {
     free(memh);
   }
@@ -205,11 +269,10 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  memh = memhead_alloc(len, true);
 
   if (LIKELY(memh)) {
-    memh->len = len;
-    memory_usage_block_alloc(len);
+    memh->len |= MEMHEAD_TAG_BITS(memory_usage_block_alloc(len));
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -217,6 +280,7 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
               SIZET_ARG(len),
               str,
               (uint)memory_usage_current());
+  print_memory_usage_by_tag();
   return NULL;
 }
 
@@ -244,15 +308,14 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  memh = memhead_alloc(len, false);
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
-    memory_usage_block_alloc(len);
+    memh->len |= MEMHEAD_TAG_BITS(memory_usage_block_alloc(len));
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -260,6 +323,7 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
               SIZET_ARG(len),
               str,
               (uint)memory_usage_current());
+  print_memory_usage_by_tag();
   return NULL;
 }
 
@@ -319,9 +383,9 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    const int tag = memory_usage_block_alloc(len);
+    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG | MEMHEAD_TAG_BITS(tag);
     memh->alignment = (short)alignment;
-    memory_usage_block_alloc(len);
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -329,6 +393,7 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
               SIZET_ARG(len),
               str,
               (uint)memory_usage_current());
+  print_memory_usage_by_tag();
   return NULL;
 }
 
@@ -350,6 +415,16 @@ void MEM_lockfree_printmemlist_stats(void)
 {
   printf("\ntotal memory len: %.3f MB\n", (double)memory_usage_current() / (double)(1024 * 1024));
   printf("peak memory len: %.3f MB\n", (double)memory_usage_peak() / (double)(1024 * 1024));
+  printf("\nmemory len by tag:\n");
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    printf("  %s: %.3f MB\n",
+           MEM_tag_name((eMemTag)tag),
+           (double)memory_usage_current_by_tag(tag) / (double)(1024 * 1024));
+  }
+  if (use_slab_allocator) {
+    printf("slab allocator reserved: %.3f MB\n",
+           (double)mem_slab_reserved() / (double)(1024 * 1024));
+  }
   printf(
       "\nFor more detailed per-block statistics run Blender with memory debugging command line "
       "argument.\n");
@@ -375,6 +450,14 @@ void MEM_lockfree_set_memory_debug(void)
   malloc_debug_memset = true;
 }
 
+void MEM_use_slab_allocator(bool enabled)
+{
+  if (enabled) {
+    mem_slab_init();
+  }
+  use_slab_allocator = enabled;
+}
+
 size_t MEM_lockfree_get_memory_in_use(void)
 {
   return memory_usage_current();
@@ -0,0 +1,289 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Size-class slab allocator for small blocks of the lock-free allocator.
+ *
+ * Every thread keeps a cache of free blocks for each size class, so that most allocations and
+ * frees do not need any synchronization. Blocks are moved between the thread caches and global
+ * free lists in batches, and new slabs are only requested from the system allocator when the
+ * global free list of a size class is empty. Slabs are never returned to the system allocator.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+namespace {
+
+/** Block sizes of all size classes are multiples of this, which keeps blocks aligned like the
+ * system allocator does. */
+constexpr size_t class_size_step = 16;
+constexpr size_t classes_num = MEM_SLAB_BLOCK_SIZE_MAX / class_size_step;
+/** Number of blocks moved at once between a thread cache and the global free lists, which is
+ * also the number of blocks of a slab. */
+constexpr int batch_size = 64;
+/** A thread cache returns a batch to the global free list when it has this many free blocks. */
+constexpr int local_blocks_max = batch_size * 2;
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+struct LocalFreeList {
+  FreeBlock *first = nullptr;
+  int blocks_num = 0;
+};
+
+struct GlobalFreeList {
+  std::mutex mutex;
+  FreeBlock *first = nullptr;
+};
+
+struct Global;
+
+/**
+ * Free blocks cached by a thread. Blocks are returned to #Global when the thread exits.
+ */
+struct Local {
+  /**
+   * Retain shared ownership of #Global to make sure that it is not destructed.
+   */
+  std::shared_ptr<Global> global;
+  /** The first created #Local, see #Local.is_main in `memory_usage.cc`. */
+  bool is_main = false;
+  LocalFreeList free_lists[classes_num];
+
+  Local();
+  ~Local();
+};
+
+struct Global {
+  /** Protects #is_main_created. */
+  std::mutex main_mutex;
+  bool is_main_created = false;
+  GlobalFreeList free_lists[classes_num];
+  /** Total size of all slabs allocated from the system allocator. */
+  std::atomic<size_t> reserved = 0;
+};
+
+}  // namespace
+
+/**
+ * False once the main thread started shutting down, after which thread-locals can not be relied
+ * on anymore and the global free lists are used directly.
+ */
+static std::atomic<bool> use_local_caches = true;
+
+static std::shared_ptr<Global> &get_global_ptr()
+{
+  static std::shared_ptr<Global> global = std::make_shared<Global>();
+  return global;
+}
+
+static Global &get_global()
+{
+  return *get_global_ptr();
+}
+
+static Local &get_local_data()
+{
+  static thread_local Local local;
+  return local;
+}
+
+static size_t class_index_from_size(const size_t size)
+{
+  assert(size > 0 && size <= MEM_SLAB_BLOCK_SIZE_MAX);
+  return (size - 1) / class_size_step;
+}
+
+static size_t block_size_from_class_index(const size_t class_index)
+{
+  return (class_index + 1) * class_size_step;
+}
+
+/**
+ * Allocate a new slab and return its blocks as a list of #batch_size blocks.
+ */
+static FreeBlock *slab_alloc(Global &global, const size_t class_index)
+{
+  const size_t block_size = block_size_from_class_index(class_index);
+  char *slab = static_cast<char *>(malloc(block_size * size_t(batch_size)));
+  if (UNLIKELY(slab == nullptr)) {
+    return nullptr;
+  }
+  global.reserved.fetch_add(block_size * size_t(batch_size), std::memory_order_relaxed);
+
+  for (int i = 0; i < batch_size - 1; i++) {
+    reinterpret_cast<FreeBlock *>(slab + block_size * size_t(i))->next =
+        reinterpret_cast<FreeBlock *>(slab + block_size * size_t(i + 1));
+  }
+  reinterpret_cast<FreeBlock *>(slab + block_size * size_t(batch_size - 1))->next = nullptr;
+  return reinterpret_cast<FreeBlock *>(slab);
+}
+
+/**
+ * Move up to #batch_size blocks from the global free list to an empty thread cache, or allocate
+ * a new slab for it.
+ */
+static void local_free_list_refill(Global &global,
+                                   const size_t class_index,
+                                   LocalFreeList &local_list)
+{
+  assert(local_list.first == nullptr);
+  GlobalFreeList &global_list = global.free_lists[class_index];
+  {
+    std::lock_guard lock{global_list.mutex};
+    if (global_list.first != nullptr) {
+      FreeBlock *last = global_list.first;
+      int blocks_num = 1;
+      while (blocks_num < batch_size && last->next != nullptr) {
+        last = last->next;
+        blocks_num++;
+      }
+      local_list.first = global_list.first;
+      local_list.blocks_num = blocks_num;
+      global_list.first = last->next;
+      last->next = nullptr;
+      return;
+    }
+  }
+  local_list.first = slab_alloc(global, class_index);
+  local_list.blocks_num = local_list.first ? batch_size : 0;
+}
+
+/**
+ * Prepend the list of blocks from `first` to `last` to the global free list.
+ */
+static void global_free_list_prepend(Global &global,
+                                     const size_t class_index,
+                                     FreeBlock *first,
+                                     FreeBlock *last)
+{
+  GlobalFreeList &global_list = global.free_lists[class_index];
+  std::lock_guard lock{global_list.mutex};
+  last->next = global_list.first;
+  global_list.first = first;
+}
+
+Local::Local()
+{
+  this->global = get_global_ptr();
+
+  std::lock_guard lock{this->global->main_mutex};
+  if (!this->global->is_main_created) {
+    /* This is the first thread creating #Local, it is therefore the main thread because it's
+     * created through #mem_slab_init. */
+    this->is_main = true;
+    this->global->is_main_created = true;
+  }
+}
+
+Local::~Local()
+{
+  /* Give the cached blocks back, they may still be used by other threads. */
+  for (size_t class_index = 0; class_index < classes_num; class_index++) {
+    LocalFreeList &local_list = this->free_lists[class_index];
+    if (local_list.first == nullptr) {
+      continue;
+    }
+    FreeBlock *last = local_list.first;
+    while (last->next != nullptr) {
+      last = last->next;
+    }
+    global_free_list_prepend(*this->global, class_index, local_list.first, last);
+    local_list.first = nullptr;
+    local_list.blocks_num = 0;
+  }
+
+  if (this->is_main) {
+    use_local_caches.store(false, std::memory_order_relaxed);
+  }
+}
+
+void mem_slab_init()
+{
+  /* Makes sure that the static and thread-local variables on the main thread are initialized. */
+  get_local_data();
+}
+
+void *mem_slab_alloc(const size_t size)
+{
+  const size_t class_index = class_index_from_size(size);
+
+  if (LIKELY(use_local_caches.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    LocalFreeList &local_list = local.free_lists[class_index];
+    if (UNLIKELY(local_list.first == nullptr)) {
+      local_free_list_refill(*local.global, class_index, local_list);
+      if (UNLIKELY(local_list.first == nullptr)) {
+        return nullptr;
+      }
+    }
+    FreeBlock *block = local_list.first;
+    local_list.first = block->next;
+    local_list.blocks_num--;
+    return block;
+  }
+
+  Global &global = get_global();
+  GlobalFreeList &global_list = global.free_lists[class_index];
+  std::lock_guard lock{global_list.mutex};
+  if (global_list.first == nullptr) {
+    global_list.first = slab_alloc(global, class_index);
+    if (UNLIKELY(global_list.first == nullptr)) {
+      return nullptr;
+    }
+  }
+  FreeBlock *block = global_list.first;
+  global_list.first = block->next;
+  return block;
+}
+
+void mem_slab_free(void *ptr, const size_t size)
+{
+  const size_t class_index = class_index_from_size(size);
+  FreeBlock *block = static_cast<FreeBlock *>(ptr);
+
+  if (LIKELY(use_local_caches.load(std::memory_order_relaxed))) {
+    Local &local = get_local_data();
+    LocalFreeList &local_list = local.free_lists[class_index];
+    block->next = local_list.first;
+    local_list.first = block;
+    local_list.blocks_num++;
+
+    if (UNLIKELY(local_list.blocks_num >= local_blocks_max)) {
+      /* Keep the most recently freed blocks, they are more likely to still be in the cache. */
+      FreeBlock *last = local_list.first;
+      for (int i = 1; i < local_blocks_max - batch_size; i++) {
+        last = last->next;
+      }
+      FreeBlock *first = last->next;
+      last->next = nullptr;
+      local_list.blocks_num -= batch_size;
+
+      last = first;
+      while (last->next != nullptr) {
+        last = last->next;
+      }
+      global_free_list_prepend(*local.global, class_index, first, last);
+    }
+    return;
+  }
+
+  global_free_list_prepend(get_global(), class_index, block, block);
+}
+
+size_t mem_slab_reserved()
+{
+  return get_global().reserved.load(std::memory_order_relaxed);
+}
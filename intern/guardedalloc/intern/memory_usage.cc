@@ -52,6 +52,15 @@ struct alignas(128) Local {
    * accurate, but it's still good enough for practical purposes.
    */
   std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+  /**
+   * Number of bytes per allocation tag, can be negative and is atomic for the same reason as
+   * #mem_in_use.
+   */
+  std::atomic<int64_t> mem_in_use_by_tag[MEM_TAG_NUM] = {};
+  /**
+   * Tag of allocations done by this thread, see #MEM_tag_set. Only accessed by the thread itself.
+   */
+  eMemTag tag = MEM_TAG_NONE;
 
   Local();
   ~Local();
@@ -88,6 +97,11 @@ struct Global {
    * Number of blocks that are not tracked by #Local, for the same reason as above.
    */
   std::atomic<int64_t> blocks_num_outside_locals = 0;
+  /**
+   * Number of bytes per allocation tag that are not tracked by #Local, for the same reason as
+   * above.
+   */
+  std::atomic<int64_t> mem_in_use_by_tag_outside_locals[MEM_TAG_NUM] = {};
   /**
    * Peak memory usage since the last reset.
    */
@@ -150,6 +164,10 @@ Local::~Local()
   /* Don't forget the memory counts stored locally. */
   this->global->blocks_num_outside_locals.fetch_add(this->blocks_num, std::memory_order_relaxed);
   this->global->mem_in_use_outside_locals.fetch_add(this->mem_in_use, std::memory_order_relaxed);
+  for (int i = 0; i < MEM_TAG_NUM; i++) {
+    this->global->mem_in_use_by_tag_outside_locals[i].fetch_add(this->mem_in_use_by_tag[i],
+                                                                std::memory_order_relaxed);
+  }
 
   if (this->is_main) {
     /* The main thread started shutting down. Use global counters from now on to avoid accessing
@@ -183,7 +201,7 @@ void memory_usage_init()
   get_local_data();
 }
 
-void memory_usage_block_alloc(const size_t size)
+int memory_usage_block_alloc(const size_t size)
 {
   if (LIKELY(use_local_counters.load(std::memory_order_relaxed))) {
     Local &local = get_local_data();
@@ -193,27 +211,32 @@ void memory_usage_block_alloc(const size_t size)
      * time, which is very rare compared to doing allocations. */
     local.blocks_num.fetch_add(1, std::memory_order_relaxed);
     local.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+    local.mem_in_use_by_tag[local.tag].fetch_add(int64_t(size), std::memory_order_relaxed);
 
     /* If a certain amount of new memory has been allocated, update the peak. */
     if (local.mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
       update_global_peak();
     }
+    return local.tag;
   }
-  else {
-    Global &global = get_global();
-    /* Increase global memory counts. */
-    global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
-    global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
-  }
+
+  Global &global = get_global();
+  /* Increase global memory counts. */
+  global.blocks_num_outside_locals.fetch_add(1, std::memory_order_relaxed);
+  global.mem_in_use_outside_locals.fetch_add(int64_t(size), std::memory_order_relaxed);
+  global.mem_in_use_by_tag_outside_locals[MEM_TAG_NONE].fetch_add(int64_t(size),
+                                                                  std::memory_order_relaxed);
+  return MEM_TAG_NONE;
 }
 
-void memory_usage_block_free(const size_t size)
+void memory_usage_block_free(const size_t size, const int tag)
 {
   if (LIKELY(use_local_counters)) {
     /* Decrease local memory counts. See comment in #memory_usage_block_alloc for details regarding
      * thread synchronization. */
     Local &local = get_local_data();
     local.mem_in_use.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    local.mem_in_use_by_tag[tag].fetch_sub(int64_t(size), std::memory_order_relaxed);
     local.blocks_num.fetch_sub(1, std::memory_order_relaxed);
   }
   else {
@@ -221,6 +244,8 @@ void memory_usage_block_free(const size_t size)
     /* Decrease global memory counts. */
     global.blocks_num_outside_locals.fetch_sub(1, std::memory_order_relaxed);
     global.mem_in_use_outside_locals.fetch_sub(int64_t(size), std::memory_order_relaxed);
+    global.mem_in_use_by_tag_outside_locals[tag].fetch_sub(int64_t(size),
+                                                           std::memory_order_relaxed);
   }
 }
 
@@ -250,6 +275,19 @@ size_t memory_usage_current()
   return size_t(mem_in_use);
 }
 
+size_t memory_usage_current_by_tag(const int tag)
+{
+  Global &global = get_global();
+  std::lock_guard lock{global.locals_mutex};
+
+  int64_t mem_in_use = global.mem_in_use_by_tag_outside_locals[tag];
+  for (Local *local : global.locals) {
+    mem_in_use += local->mem_in_use_by_tag[tag];
+  }
+  /* Counters of different threads are not read at once, so the sum can be negative briefly. */
+  return size_t(std::max<int64_t>(mem_in_use, 0));
+}
+
 /**
  * Get the approximate peak memory usage since the last call to #memory_usage_peak_reset.
  * This is approximate, because the peak usage is not updated after every allocation (see
@@ -271,3 +309,42 @@ void memory_usage_peak_reset()
   Global &global = get_global();
   global.peak = memory_usage_current();
 }
+
+eMemTag MEM_tag_set(const eMemTag tag)
+{
+  if (UNLIKELY(!use_local_counters.load(std::memory_order_relaxed))) {
+    return MEM_TAG_NONE;
+  }
+  Local &local = get_local_data();
+  const eMemTag prev_tag = local.tag;
+  local.tag = tag;
+  return prev_tag;
+}
+
+const char *MEM_tag_name(const eMemTag tag)
+{
+  switch (tag) {
+    case MEM_TAG_NONE:
+      return "Untagged";
+    case MEM_TAG_DEPSGRAPH:
+      return "Depsgraph";
+    case MEM_TAG_GEOMETRY:
+      return "Geometry";
+    case MEM_TAG_DRAW:
+      return "Draw";
+    case MEM_TAG_UNDO:
+      return "Undo";
+    case MEM_TAG_IMAGE:
+      return "Image";
+    case MEM_TAG_CYCLES:
+      return "Cycles";
+    case MEM_TAG_PYTHON:
+      return "Python";
+  }
+  return "";
+}
+
+size_t MEM_get_memory_in_use_by_tag(const eMemTag tag)
+{
+  return memory_usage_current_by_tag(tag);
+}
@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+class SlabAllocatorTest : public LockFreeAllocatorTest {
+ protected:
+  void SetUp() override
+  {
+    LockFreeAllocatorTest::SetUp();
+    MEM_use_slab_allocator(true);
+  }
+
+  void TearDown() override
+  {
+    MEM_use_slab_allocator(false);
+  }
+};
+
+}  // namespace
+
+TEST_F(SlabAllocatorTest, sizes)
+{
+  const uint blocks_num = MEM_get_memory_blocks_in_use();
+  const size_t mem_in_use = MEM_get_memory_in_use();
+
+  std::vector<char *> blocks;
+  for (int size = 0; size < 1024; size++) {
+    char *block = static_cast<char *>(MEM_mallocN(size_t(size), __func__));
+    EXPECT_EQ(size_t(block) % sizeof(void *), 0);
+    EXPECT_GE(MEM_allocN_len(block), size_t(size));
+    memset(block, size & 0xff, size_t(size));
+    blocks.push_back(block);
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num + 1024);
+
+  for (int size = 0; size < 1024; size++) {
+    for (int i = 0; i < size; i++) {
+      EXPECT_EQ(blocks[size_t(size)][i], char(size & 0xff));
+    }
+    MEM_freeN(blocks[size_t(size)]);
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+  EXPECT_EQ(MEM_get_memory_in_use(), mem_in_use);
+}
+
+TEST_F(SlabAllocatorTest, calloc_realloc)
+{
+  char *block = static_cast<char *>(MEM_mallocN(32, __func__));
+  memset(block, 1, 32);
+  MEM_freeN(block);
+
+  /* Likely reuses the block freed above. */
+  block = static_cast<char *>(MEM_callocN(32, __func__));
+  for (int i = 0; i < 32; i++) {
+    EXPECT_EQ(block[i], 0);
+  }
+  memset(block, 7, 32);
+
+  block = static_cast<char *>(MEM_recallocN(block, 2000));
+  EXPECT_EQ(block[31], 7);
+  EXPECT_EQ(block[32], 0);
+  EXPECT_EQ(block[1999], 0);
+
+  block = static_cast<char *>(MEM_reallocN(block, 16));
+  EXPECT_EQ(MEM_allocN_len(block), size_t(16));
+  EXPECT_EQ(block[15], 7);
+
+  char *copy = static_cast<char *>(MEM_dupallocN(block));
+  EXPECT_EQ(copy[0], 7);
+  MEM_freeN(copy);
+  MEM_freeN(block);
+}
+
+TEST_F(SlabAllocatorTest, switch_allocator)
+{
+  /* Blocks are freed by the allocator that created them. */
+  void *block = MEM_mallocN(64, __func__);
+  MEM_use_slab_allocator(false);
+  void *system_block = MEM_mallocN(64, __func__);
+  MEM_freeN(block);
+  MEM_use_slab_allocator(true);
+  MEM_freeN(system_block);
+}
+
+TEST_F(SlabAllocatorTest, threads)
+{
+  const uint blocks_num = MEM_get_memory_blocks_in_use();
+
+  /* Allocate on some threads and free on others, so that blocks move between thread caches, and
+   * threads exit with blocks in their cache. */
+  const int threads_num = 8;
+  const int blocks_per_thread = 10000;
+  std::vector<std::vector<void *>> thread_blocks(threads_num);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < blocks_per_thread; j++) {
+        thread_blocks[size_t(i)].push_back(MEM_mallocN(size_t(j % 300), __func__));
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num + threads_num * blocks_per_thread);
+
+  for (int i = 0; i < threads_num; i++) {
+    threads.emplace_back([&, i]() {
+      for (void *block : thread_blocks[size_t((i + 1) % threads_num)]) {
+        MEM_freeN(block);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, MEM_tag_set)
+{
+  const size_t mem_undo = MEM_get_memory_in_use_by_tag(MEM_TAG_UNDO);
+  const size_t mem_none = MEM_get_memory_in_use_by_tag(MEM_TAG_NONE);
+
+  const eMemTag prev_tag = MEM_tag_set(MEM_TAG_UNDO);
+  void *block = MEM_mallocN(1000, __func__);
+  void *aligned_block = MEM_mallocN_aligned(2000, 64, __func__);
+  EXPECT_EQ(MEM_tag_set(prev_tag), MEM_TAG_UNDO);
+
+  EXPECT_EQ(MEM_allocN_len(block), size_t(1000));
+  EXPECT_EQ(MEM_allocN_len(aligned_block), size_t(2000));
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_UNDO), mem_undo + 3000);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_NONE), mem_none);
+
+  /* Blocks are accounted to their tag, regardless of the tag used when they are freed. */
+  MEM_freeN(block);
+  block = MEM_reallocN(aligned_block, 500);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_UNDO), mem_undo);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_NONE), mem_none + 500);
+  MEM_freeN(block);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_NONE), mem_none);
+}
+
+TEST_F(LockFreeAllocatorTest, MEM_TagScope)
+{
+  const size_t mem_draw = MEM_get_memory_in_use_by_tag(MEM_TAG_DRAW);
+  void *block;
+  {
+    MEM_TagScope mem_tag(MEM_TAG_DRAW);
+    {
+      MEM_TagScope mem_tag_nested(MEM_TAG_IMAGE);
+    }
+    block = MEM_callocN(100, __func__);
+  }
+  EXPECT_EQ(MEM_tag_set(MEM_TAG_NONE), MEM_TAG_NONE);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_DRAW), mem_draw + 100);
+  MEM_freeN(block);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_DRAW), mem_draw);
+}
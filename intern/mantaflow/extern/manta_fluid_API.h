@@ -42,6 +42,8 @@ bool manta_read_guiding(struct MANTA *fluid,
                         struct FluidModifierData *fmd,
                         int framenr,
                         bool sourceDomain);
+void manta_prefetch_cache(struct MANTA *fluid, struct FluidModifierData *fmd, int framenr);
+void manta_cancel_prefetch(struct MANTA *fluid);
 bool manta_bake_data(struct MANTA *fluid, struct FluidModifierData *fmd, int framenr);
 bool manta_bake_noise(struct MANTA *fluid, struct FluidModifierData *fmd, int framenr);
 bool manta_bake_mesh(struct MANTA *fluid, struct FluidModifierData *fmd, int framenr);
@@ -5,10 +5,14 @@
  * \ingroup intern_mantaflow
  */
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <zlib.h>
 
 #include "MANTA_main.h"
@@ -71,6 +75,9 @@ MANTA::MANTA(int *res, FluidModifierData *fmd)
   mUsingInvel = (fds->active_fields & FLUID_DOMAIN_ACTIVE_INVEL);
   mUsingOutflow = (fds->active_fields & FLUID_DOMAIN_ACTIVE_OUTFLOW);
 
+  mCachePrefetcher = nullptr;
+  mPrefetchFrame = 0;
+
   /* Simulation constants */
   mResX = res[0]; /* Current size of domain (will adjust with adaptive domain). */
   mResY = res[1];
@@ -546,6 +553,9 @@ MANTA::~MANTA()
     cout << "~FLUID: " << mCurrentID << " with res(" << mResX << ", " << mResY << ", " << mResZ
          << ")" << endl;
 
+  cancelPrefetch();
+  delete mCachePrefetcher;
+
   /* Destruction string for Python. */
   string tmpString = "";
   vector<string> pythonCommands;
@@ -1385,6 +1395,141 @@ bool MANTA::readNoise(FluidModifierData *fmd, int framenr, bool resumable)
   return (mNoiseFromFile = runPythonString(pythonCommands));
 }
 
+/**
+ * Reads files on a background thread without keeping their contents, so that the operating system
+ * keeps them in the file system cache. The synchronous loads through Python then don't have to
+ * wait for the disk.
+ */
+class MANTACachePrefetcher {
+ public:
+  ~MANTACachePrefetcher()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mFiles.clear();
+      mStop = true;
+      mCancel = true;
+    }
+    mCondition.notify_all();
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+  }
+
+  void add(const vector<string> &files)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mFiles.insert(mFiles.end(), files.begin(), files.end());
+      mCancel = false;
+      if (!mThread.joinable()) {
+        mThread = std::thread([this]() { run(); });
+      }
+    }
+    mCondition.notify_all();
+  }
+
+  void cancel()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mFiles.clear();
+    mCancel = true;
+    mCondition.wait(lock, [this]() { return !mBusy; });
+  }
+
+ private:
+  void run()
+  {
+    vector<char> buffer(1 << 20);
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+      mCondition.wait(lock, [this]() { return mStop || !mFiles.empty(); });
+      if (mStop) {
+        return;
+      }
+      const string file = mFiles.front();
+      mFiles.pop_front();
+      mBusy = true;
+      lock.unlock();
+
+      /* Missing files are fine, not every frame has every type of cache file. */
+      FILE *fp = BLI_fopen(file.c_str(), "rb");
+      if (fp) {
+        while (!mCancel && fread(buffer.data(), 1, buffer.size(), fp) == buffer.size()) {
+        }
+        fclose(fp);
+      }
+
+      lock.lock();
+      mBusy = false;
+      mCondition.notify_all();
+    }
+  }
+
+  std::thread mThread;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  std::deque<string> mFiles;
+  bool mBusy = false;
+  bool mStop = false;
+  atomic<bool> mCancel{false};
+};
+
+void MANTA::prefetchCache(FluidModifierData *fmd, int framenr)
+{
+  /* Number of frames that are read ahead of the current frame. */
+  const int prefetch_frames = 2;
+
+  FluidDomainSettings *fds = fmd->domain;
+  const int end_frame = std::min(framenr + prefetch_frames, fds->cache_frame_end);
+
+  /* Only queue the frames that were not queued yet, unless the playback jumped. */
+  int start_frame = framenr + 1;
+  if (mCachePrefetcher && mPrefetchFrame >= start_frame && mPrefetchFrame <= end_frame) {
+    start_frame = mPrefetchFrame + 1;
+  }
+  else if (mCachePrefetcher) {
+    mCachePrefetcher->cancel();
+  }
+  if (start_frame > end_frame) {
+    return;
+  }
+
+  string data_format = getCacheFileEnding(fds->cache_data_format);
+  string mesh_format = getCacheFileEnding(fds->cache_mesh_format);
+  vector<string> files;
+  for (int frame = start_frame; frame <= end_frame; frame++) {
+    files.push_back(getFile(
+        fmd, FLUID_DOMAIN_DIR_CONFIG, FLUID_NAME_CONFIG, FLUID_DOMAIN_EXTENSION_UNI, frame));
+    if (mUsingSmoke || mUsingLiquid) {
+      files.push_back(getFile(fmd, FLUID_DOMAIN_DIR_DATA, FLUID_NAME_DATA, data_format, frame));
+    }
+    if (mUsingNoise) {
+      files.push_back(getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_NOISE, data_format, frame));
+    }
+    if (mUsingMesh) {
+      files.push_back(getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_MESH, mesh_format, frame));
+    }
+    if (mUsingDrops || mUsingBubbles || mUsingFloats || mUsingTracers) {
+      files.push_back(
+          getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PARTICLES, data_format, frame));
+    }
+  }
+  mPrefetchFrame = end_frame;
+
+  if (!mCachePrefetcher) {
+    mCachePrefetcher = new MANTACachePrefetcher();
+  }
+  mCachePrefetcher->add(files);
+}
+
+void MANTA::cancelPrefetch()
+{
+  if (mCachePrefetcher) {
+    mCachePrefetcher->cancel();
+  }
+}
+
 bool MANTA::readMesh(FluidModifierData *fmd, int framenr)
 {
   if (with_debug)
@@ -19,6 +19,8 @@ using std::string;
 using std::unordered_map;
 using std::vector;
 
+class MANTACachePrefetcher;
+
 struct MANTA {
  public:
   MANTA(int *res, struct FluidModifierData *fmd);
@@ -78,6 +80,12 @@ struct MANTA {
   bool readParticles(FluidModifierData *fmd, int framenr, bool resumable);
   bool readGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain);
 
+  /* Read the cache files of the frames after the given frame on a background thread, so that they
+   * are in the file system cache when they are loaded. */
+  void prefetchCache(FluidModifierData *fmd, int framenr);
+  /* Stop prefetching and wait until no cache file is open anymore. */
+  void cancelPrefetch();
+
   /* Propagate variable changes from RNA to Python. */
   bool updateVariables(FluidModifierData *fmd);
 
@@ -751,6 +759,10 @@ struct MANTA {
   bool mUsingFloats;
   bool mUsingTracers;
 
+  MANTACachePrefetcher *mCachePrefetcher;
+  /* Last frame that was queued for prefetching. */
+  int mPrefetchFrame;
+
   bool mFlipFromFile;
   bool mMeshFromFile;
   bool mParticlesFromFile;
@@ -83,6 +83,16 @@ bool manta_read_guiding(MANTA *fluid, FluidModifierData *fmd, int framenr, bool
   return fluid->readGuiding(fmd, framenr, sourceDomain);
 }
 
+void manta_prefetch_cache(MANTA *fluid, FluidModifierData *fmd, int framenr)
+{
+  fluid->prefetchCache(fmd, framenr);
+}
+
+void manta_cancel_prefetch(MANTA *fluid)
+{
+  fluid->cancelPrefetch();
+}
+
 bool manta_bake_data(MANTA *fluid, FluidModifierData *fmd, int framenr)
 {
   return fluid->bakeData(fmd, framenr);
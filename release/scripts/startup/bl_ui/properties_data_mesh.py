@@ -207,6 +207,9 @@ class DATA_PT_normals(MeshButtonsPanel, Panel):
         sub.prop(mesh, "auto_smooth_angle", text="")
         row.prop_decorator(mesh, "auto_smooth_angle")
 
+        col = layout.column()
+        col.prop(mesh, "use_stable_triangulation")
+
 
 class DATA_PT_texture_space(MeshButtonsPanel, Panel):
     bl_label = "Texture Space"
@@ -665,6 +665,7 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col = layout.column()
         col.prop(system, "texture_time_out", text="Texture Time Out")
         col.prop(system, "texture_collection_rate", text="Garbage Collection Rate")
+        col.prop(system, "texture_memory_limit", text="Texture Memory Limit")
 
         layout.separator()
 
@@ -695,6 +696,7 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
         layout.separator()
 
         layout.prop(system, "sequencer_proxy_setup")
+        layout.prop(system, "use_video_hardware_decode")
 
 
 # -----------------------------------------------------------------------------
@@ -365,6 +365,17 @@ void BKE_animsys_eval_driver(struct Depsgraph *depsgraph,
 
 void BKE_animsys_update_driver_array(struct ID *id);
 
+/**
+ * Runtime cache of resolved RNA paths for the F-Curves and drivers evaluated for an ID, avoiding
+ * to parse the paths on every evaluation. The cache is created for evaluated copies only, since
+ * the resolved pointers stay valid until the copy is updated from the original again, which
+ * creates a new #AnimData.
+ */
+void BKE_animsys_path_cache_ensure(struct ID *id);
+/** Remove all resolved paths, e.g. after the relations of the depsgraph have been updated. */
+void BKE_animsys_path_cache_clear(struct ID *id);
+void BKE_animsys_path_cache_free(struct AnimData *adt);
+
 /* ************************************* */
 
 #ifdef __cplusplus
@@ -240,12 +240,18 @@ float bvhtree_sphereray_tri_intersection(const BVHTreeRay *ray,
 
 typedef struct BVHTreeFromPointCloud {
   struct BVHTree *tree;
+  /** The tree is owned by the point cloud's runtime cache and must not be freed. */
+  bool cached;
 
   BVHTree_NearestPointCallback nearest_callback;
 
   const float (*coords)[3];
 } BVHTreeFromPointCloud;
 
+/**
+ * The tree is cached on the point cloud and reused until its positions change, so the tree type
+ * is only used when the tree has to be built.
+ */
 BVHTree *BKE_bvhtree_from_pointcloud_get(struct BVHTreeFromPointCloud *data,
                                          const struct PointCloud *pointcloud,
                                          int tree_type);
@@ -264,6 +270,12 @@ struct BVHCache *bvhcache_init(void);
  * Frees a BVH-cache.
  */
 void bvhcache_free(struct BVHCache *bvh_cache);
+/**
+ * Tag the cached trees as outdated after the vertex positions changed without a change in
+ * topology. Trees that contain all elements are kept and refit on their next use, others are
+ * freed.
+ */
+void bvhcache_tag_positions_changed(struct BVHCache *bvh_cache);
 
 #ifdef __cplusplus
 }
@@ -52,6 +52,23 @@ struct BasisCache {
   bool invalid = false;
 };
 
+/**
+ * Basis caches for all curves. The basis only depends on the number of control and evaluated
+ * points, the order, the cyclic state and the knots mode, so curves that share all of these also
+ * share the same cache. This is common when many curves are created the same way, like hair.
+ */
+struct BasisCaches {
+  /** Unique basis caches. */
+  Vector<BasisCache> caches;
+  /** Index into #caches for every curve, or -1 for curves that are not NURBS curves. */
+  Vector<int> cache_indices;
+
+  const BasisCache &operator[](const int curve_index) const
+  {
+    return this->caches[this->cache_indices[curve_index]];
+  }
+};
+
 }  // namespace curves::nurbs
 
 /**
@@ -75,7 +92,7 @@ class CurvesGeometryRuntime {
   };
   mutable SharedCache<EvaluatedOffsets> evaluated_offsets_cache;
 
-  mutable SharedCache<Vector<curves::nurbs::BasisCache>> nurbs_basis_cache;
+  mutable SharedCache<curves::nurbs::BasisCaches> nurbs_basis_cache;
 
   /** Cache of evaluated positions. */
   struct EvaluatedPositions {
@@ -87,6 +87,12 @@ typedef enum eCDAllocType {
    * if all layer values will be set by the caller after creating the layer.
    */
   CD_CONSTRUCT = 5,
+  /**
+   * Share the data of the source layers with implicit sharing instead of copying it. The data is
+   * copied lazily when one of the layers is accessed for writing. Only supported by
+   * #CustomData_copy and #CustomData_merge, with the same requirements as #CD_DUPLICATE.
+   */
+  CD_SHARE = 6,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (eCustomDataMask)((eCustomDataMask)1 << (eCustomDataMask)(_type))
@@ -167,6 +173,18 @@ void CustomData_copy(const struct CustomData *source,
                      eCDAllocType alloctype,
                      int totelem);
 
+/**
+ * Same as #CustomData_copy with #CD_SET_DEFAULT, but the data of all new layers is allocated from
+ * a single memory block instead of with one allocation per layer. This reduces the allocation
+ * overhead when many small meshes are created. The layers can be used like any other layer, a
+ * layer gets a separate allocation when it is resized or when its data is taken over by other
+ * code. The block is freed with the last layer that uses it.
+ */
+void CustomData_copy_layout_single_allocation(const struct CustomData *source,
+                                              struct CustomData *dest,
+                                              eCustomDataMask mask,
+                                              int totelem);
+
 /* BMESH_TODO, not really a public function but readfile.c needs it */
 void CustomData_update_typemap(struct CustomData *data);
 
@@ -288,6 +306,13 @@ int CustomData_number_of_layers_typemask(const struct CustomData *data, eCustomD
  */
 void CustomData_duplicate_referenced_layers(CustomData *data, int totelem);
 
+/**
+ * Make sure the layer owns its data exclusively, by copying it when it is shared with other
+ * layers (see #CD_SHARE). Has to be called before writing to #CustomDataLayer.data directly or
+ * before taking ownership of it. The `_for_write` accessors do this already.
+ */
+void CustomData_ensure_layer_is_mutable(struct CustomDataLayer *layer, int totelem);
+
 /**
  * Set the #CD_FLAG_NOCOPY flag in custom data layers where the mask is
  * zero for the layer type, so only layer types specified by the mask will be copied
@@ -14,6 +14,7 @@
 extern "C" {
 #endif
 
+struct DataTransferRemapCache;
 struct Depsgraph;
 struct Object;
 struct ReportList;
@@ -192,8 +193,17 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  float mix_factor,
                                  const char *vgroup_name,
                                  bool invert_vgroup,
+                                 struct DataTransferRemapCache *remap_cache,
                                  struct ReportList *reports);
 
+/**
+ * Storage for the element mappings of a transfer, so that they don't have to be computed again
+ * as long as the element counts and mapping settings stay the same. Can be passed to
+ * #BKE_object_data_transfer_ex.
+ */
+struct DataTransferRemapCache *BKE_data_transfer_remap_cache_new(void);
+void BKE_data_transfer_remap_cache_free(struct DataTransferRemapCache *cache);
+
 #ifdef __cplusplus
 }
 #endif
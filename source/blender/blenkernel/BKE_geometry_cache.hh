@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Geometry cache files store the realized meshes, point clouds and curves of a geometry set with
+ * all their named attributes. They are meant to pass evaluated geometry between Blender sessions
+ * (e.g. the stages of a procedural pipeline) without converting it to an interchange format.
+ *
+ * A file starts with a fixed header followed by JSON metadata (see #BLI_serialize.hh) describing
+ * the components and their attributes. The arrays follow as raw blobs that are aligned, so that
+ * they can be copied straight from a memory mapped file. The arrays are stored in the layout of
+ * the Blender version that wrote the file, other versions refuse to read it.
+ */
+
+#include <string>
+
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+
+#include "BKE_geometry_set.hh"
+
+namespace blender::bke {
+
+/** The file extension used for geometry cache files. */
+#define GEOMETRY_CACHE_FILE_EXTENSION ".bgc"
+
+/**
+ * Serialize the mesh, point cloud and curves components of the geometry. Instances are not
+ * stored, they should be realized first. The file is passed to `write_fn` in consecutive pieces.
+ */
+void geometry_cache_serialize(const GeometrySet &geometry, FunctionRef<void(Span<char>)> write_fn);
+
+/**
+ * Create the geometry stored in a geometry cache buffer.
+ * \return False and an error message when the buffer is not a valid geometry cache.
+ */
+bool geometry_cache_deserialize(Span<char> buffer, GeometrySet &r_geometry, std::string &r_error);
+
+bool geometry_cache_write(const GeometrySet &geometry, const char *filepath, std::string &r_error);
+/** Read a geometry cache file. The file is memory mapped when possible. */
+bool geometry_cache_read(const char *filepath, GeometrySet &r_geometry, std::string &r_error);
+
+}  // namespace blender::bke
@@ -290,20 +290,26 @@ void BKE_image_free_all_textures(struct Main *bmain);
 
 /**
  * Operates on one image only!
- * \param except_frame: This is weak, only works for sequences without offset.
+ * \param except_first_frame, except_last_frame: The range of frames that are kept.
+ * This is weak, only works for sequences without offset.
  */
-void BKE_image_free_anim_ibufs(struct Image *ima, int except_frame);
+void BKE_image_free_anim_ibufs(struct Image *ima, int except_first_frame, int except_last_frame);
 
 /**
- * Does all images with type MOVIE or SEQUENCE.
+ * Does all images with type MOVIE or SEQUENCE, keeping the frames from \a cfra to
+ * \a last_kept_frame, which can be used to keep frames that were loaded ahead of time.
  */
-void BKE_image_all_free_anim_ibufs(struct Main *bmain, int cfra);
+void BKE_image_all_free_anim_ibufs(struct Main *bmain, int cfra, int last_kept_frame);
 
 void BKE_image_free_all_gputextures(struct Main *bmain);
 /**
  * Same as above but only free animated images.
  */
 void BKE_image_free_anim_gputextures(struct Main *bmain);
+/**
+ * Free the GPU textures of images that weren't used for a while, or of the least recently used
+ * images when the texture memory limit from the preferences is exceeded.
+ */
 void BKE_image_free_old_gputextures(struct Main *bmain);
 
 /**
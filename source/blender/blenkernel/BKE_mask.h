@@ -401,6 +401,17 @@ void BKE_maskrasterize_handle_init(MaskRasterHandle *mr_handle,
                                    bool do_mask_aa,
                                    bool do_feather);
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2]);
+/**
+ * Sample `span_len` pixels of a row at once, which is faster than sampling them one by one.
+ * Sample `i` is at `{(x_start + i) * x_scale + x_offset, y}`, written to `r_values[i]`.
+ */
+void BKE_maskrasterize_handle_sample_span(MaskRasterHandle *mr_handle,
+                                          int x_start,
+                                          int span_len,
+                                          float x_scale,
+                                          float x_offset,
+                                          float y,
+                                          float *r_values);
 
 /**
  * \brief Rasterize a buffer from a single mask (threaded execution).
@@ -18,6 +18,7 @@ struct MEdge;
 struct MLoop;
 struct MLoopTri;
 struct MPoly;
+struct Mesh;
 
 /* UvVertMap */
 #define STD_UV_CONNECT_LIMIT 0.0001f
@@ -355,6 +356,14 @@ Array<Vector<int>> build_vert_to_loop_map(Span<MLoop> loops, int verts_num);
 Array<Vector<int>> build_edge_to_loop_map(Span<MLoop> loops, int edges_num);
 Vector<Vector<int>> build_edge_to_loop_map_resizable(Span<MLoop> loops, int edges_num);
 
+/**
+ * Versions of the maps above that are cached on the mesh. They are shared between meshes with
+ * the same topology and are only rebuilt after the topology changed.
+ */
+Span<int> loop_to_poly_map(const Mesh &mesh);
+Span<Vector<int>> vert_to_edge_map(const Mesh &mesh);
+Span<Vector<int>> vert_to_loop_map(const Mesh &mesh);
+
 inline int poly_loop_prev(const MPoly &poly, int loop_i)
 {
   return loop_i - 1 + (loop_i == poly.loopstart) * poly.totloop;
@@ -19,6 +19,7 @@
 #  include "BLI_math_vector_types.hh"
 #  include "BLI_shared_cache.hh"
 #  include "BLI_span.hh"
+#  include "BLI_vector.hh"
 
 #  include "DNA_customdata_types.h"
 #  include "DNA_meshdata_types.h"
@@ -38,6 +39,8 @@ extern "C" {
 
 typedef enum eMeshBatchDirtyMode {
   BKE_MESH_BATCH_DIRTY_ALL = 0,
+  /** Only vertex positions changed, topology and the other attributes are the same. */
+  BKE_MESH_BATCH_DIRTY_DEFORM,
   BKE_MESH_BATCH_DIRTY_SELECT,
   BKE_MESH_BATCH_DIRTY_SELECT_PAINT,
   BKE_MESH_BATCH_DIRTY_SHADING,
@@ -166,6 +169,14 @@ struct MeshRuntime {
    */
   SharedCache<LooseEdgeCache> loose_edges_cache;
 
+  /**
+   * Topology maps that can be shared with other data-blocks with unchanged topology. Accessed
+   * with #mesh_topology::loop_to_poly_map() and similar functions.
+   */
+  SharedCache<Array<int>> loop_to_poly_map_cache;
+  SharedCache<Array<Vector<int>>> vert_to_edge_map_cache;
+  SharedCache<Array<Vector<int>>> vert_to_loop_map_cache;
+
   /**
    * A #BLI_bitmap containing tags for the center vertices of subdivided polygons, set by the
    * subdivision surface modifier and used by drawing code instead of polygon center face dots.
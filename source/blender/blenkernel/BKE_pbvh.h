@@ -166,6 +166,11 @@ typedef enum {
   PBVH_TexLeaf = 1 << 16,
   PBVH_TopologyUpdated = 1 << 17, /* Used internally by pbvh_bmesh.c */
 
+  /* Set together with #PBVH_UpdateDrawBuffers when more than the mask and color attributes
+   * changed. Without it, only the mask and color draw buffers of mesh and grids nodes are filled
+   * again. */
+  PBVH_UpdateDrawBuffersAll = 1 << 18,
+
 } PBVHNodeFlags;
 
 typedef struct PBVHFrustumPlanes {
@@ -100,7 +100,10 @@ typedef struct PTCacheFile {
   void *cur[BPHYS_TOT_DATA];
 } PTCacheFile;
 
+/* PTCacheID->flag */
 #define PTCACHE_VEL_PER_SEC 1
+/** Reading or interpolating a point only accesses that point, so they can be read in parallel. */
+#define PTCACHE_POINTS_INDEPENDENT 2
 
 enum {
   PTCACHE_FILE_PTCACHE = 0,
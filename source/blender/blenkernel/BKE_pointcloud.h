@@ -8,6 +8,7 @@
  */
 
 #ifdef __cplusplus
+#  include <memory>
 #  include <mutex>
 
 #  include "BLI_bounds_types.hh"
@@ -19,6 +20,7 @@
 extern "C" {
 #endif
 
+struct BVHTree;
 struct BoundBox;
 struct Depsgraph;
 struct Main;
@@ -33,6 +35,10 @@ extern const char *POINTCLOUD_ATTR_RADIUS;
 #ifdef __cplusplus
 namespace blender::bke {
 
+struct BVHTreeDeleter {
+  void operator()(BVHTree *tree) const;
+};
+
 struct PointCloudRuntime {
   /**
    * A cache of bounds shared between data-blocks with unchanged positions and radii.
@@ -41,6 +47,13 @@ struct PointCloudRuntime {
    */
   mutable SharedCache<Bounds<float3>> bounds_cache;
 
+  /**
+   * A BVH tree of the point positions, used by nodes that search for nearby points. It is shared
+   * between data-blocks with unchanged positions like #bounds_cache, so that repeated lookups and
+   * copies of the same point cloud don't have to build the tree again.
+   */
+  mutable SharedCache<std::unique_ptr<BVHTree, BVHTreeDeleter>> bvh_cache;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("PointCloudRuntime");
 };
 
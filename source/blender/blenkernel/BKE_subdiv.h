@@ -168,6 +168,9 @@ typedef struct Subdiv {
   struct SubdivDisplacement *displacement_evaluator;
   /* Statistics for debugging. */
   SubdivStats stats;
+  /* Identity of the mesh data the topology refiner was created from, used to skip the topology
+   * comparison in #BKE_subdiv_update_from_mesh when only vertex positions changed. */
+  struct SubdivTopologyFingerprint *topology_fingerprint;
 
   /* Cached values, are not supposed to be accessed directly. */
   struct {
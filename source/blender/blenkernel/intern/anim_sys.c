@@ -16,10 +16,13 @@
 #include "BLI_alloca.h"
 #include "BLI_blenlib.h"
 #include "BLI_dynstr.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -410,6 +413,109 @@ bool BKE_animsys_rna_path_resolve(PointerRNA *ptr,
   return true;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Resolved Path Cache
+ * \{ */
+
+typedef struct AnimPathCacheEntry {
+  /* Copy of the path the entry was resolved for, F-Curves might be freed and reallocated at the
+   * same address with a different path. */
+  char *rna_path;
+  int array_index;
+  bool is_resolved;
+  PathResolvedRNA result;
+} AnimPathCacheEntry;
+
+typedef struct AnimDataPathCache {
+  /* Maps #FCurve pointers to #AnimPathCacheEntry. */
+  GHash *entries;
+  /* Drivers of the same ID are evaluated from multiple threads. */
+  ThreadRWMutex mutex;
+} AnimDataPathCache;
+
+static void anim_path_cache_entry_free(void *entry_v)
+{
+  AnimPathCacheEntry *entry = entry_v;
+  MEM_freeN(entry->rna_path);
+  MEM_freeN(entry);
+}
+
+void BKE_animsys_path_cache_ensure(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == NULL || adt->path_cache != NULL) {
+    return;
+  }
+  AnimDataPathCache *cache = MEM_mallocN(sizeof(AnimDataPathCache), __func__);
+  cache->entries = BLI_ghash_ptr_new(__func__);
+  BLI_rw_mutex_init(&cache->mutex);
+  adt->path_cache = cache;
+}
+
+void BKE_animsys_path_cache_clear(ID *id)
+{
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == NULL || adt->path_cache == NULL) {
+    return;
+  }
+  BLI_ghash_clear(adt->path_cache->entries, NULL, anim_path_cache_entry_free);
+}
+
+void BKE_animsys_path_cache_free(AnimData *adt)
+{
+  AnimDataPathCache *cache = adt->path_cache;
+  if (cache == NULL) {
+    return;
+  }
+  BLI_ghash_free(cache->entries, NULL, anim_path_cache_entry_free);
+  BLI_rw_mutex_end(&cache->mutex);
+  MEM_freeN(cache);
+  adt->path_cache = NULL;
+}
+
+/**
+ * Same as #BKE_animsys_rna_path_resolve for the path of the F-Curve, but uses the path cache of
+ * the ID when the path is relative to an evaluated ID. Can be called from multiple threads.
+ */
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            const FCurve *fcu,
+                                            PathResolvedRNA *r_result)
+{
+  AnimData *adt = (ptr->owner_id != NULL && ptr->data == ptr->owner_id) ?
+                      BKE_animdata_from_id(ptr->owner_id) :
+                      NULL;
+  AnimDataPathCache *cache = (adt != NULL) ? adt->path_cache : NULL;
+  if (cache == NULL || fcu->rna_path == NULL) {
+    return BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, r_result);
+  }
+
+  BLI_rw_mutex_lock(&cache->mutex, THREAD_LOCK_READ);
+  const AnimPathCacheEntry *entry = BLI_ghash_lookup(cache->entries, fcu);
+  if (entry != NULL && entry->array_index == fcu->array_index &&
+      STREQ(entry->rna_path, fcu->rna_path)) {
+    const bool is_resolved = entry->is_resolved;
+    *r_result = entry->result;
+    BLI_rw_mutex_unlock(&cache->mutex);
+    return is_resolved;
+  }
+  BLI_rw_mutex_unlock(&cache->mutex);
+
+  AnimPathCacheEntry *new_entry = MEM_callocN(sizeof(AnimPathCacheEntry), __func__);
+  new_entry->rna_path = BLI_strdup(fcu->rna_path);
+  new_entry->array_index = fcu->array_index;
+  new_entry->is_resolved = BKE_animsys_rna_path_resolve(
+      ptr, fcu->rna_path, fcu->array_index, &new_entry->result);
+  *r_result = new_entry->result;
+  const bool is_resolved = new_entry->is_resolved;
+
+  BLI_rw_mutex_lock(&cache->mutex, THREAD_LOCK_WRITE);
+  BLI_ghash_reinsert(cache->entries, (void *)fcu, new_entry, NULL, anim_path_cache_entry_free);
+  BLI_rw_mutex_unlock(&cache->mutex);
+  return is_resolved;
+}
+
+/** \} */
+
 /* less than 1.0 evaluates to false, use epsilon to avoid float error */
 #define ANIMSYS_FLOAT_AS_BOOL(value) ((value) > (1.0f - FLT_EPSILON))
 
@@ -580,6 +686,94 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/* Minimum number of F-Curves in a list to evaluate them in parallel, for smaller lists the
+ * threading overhead is larger than the gain. */
+#define FCURVES_PARALLEL_EVALUATION_MIN 256
+
+typedef struct FCurvesEvalData {
+  PointerRNA *ptr;
+  const AnimationEvalContext *anim_eval_context;
+  FCurve **fcurves;
+  PathResolvedRNA *anim_rnas;
+  bool *is_resolved;
+  float *values;
+} FCurvesEvalData;
+
+static void animsys_evaluate_fcurve_task(void *__restrict userdata,
+                                         const int index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  FCurvesEvalData *data = userdata;
+  FCurve *fcu = data->fcurves[index];
+  data->is_resolved[index] = animsys_rna_path_resolve_cached(
+      data->ptr, fcu, &data->anim_rnas[index]);
+  if (data->is_resolved[index]) {
+    data->values[index] = calculate_fcurve(
+        &data->anim_rnas[index], fcu, data->anim_eval_context);
+  }
+}
+
+/**
+ * Resolve the paths and evaluate the F-Curves in parallel. Writing the values to RNA is done
+ * afterwards in the order of the list, since property setters are not expected to be called from
+ * multiple threads, and later curves for the same property have to overwrite earlier ones.
+ * Returns false when the F-Curves have to be evaluated on a single thread.
+ */
+static bool animsys_evaluate_fcurves_parallel(PointerRNA *ptr,
+                                              ListBase *list,
+                                              const AnimationEvalContext *anim_eval_context,
+                                              bool flush_to_original)
+{
+  int fcurves_num = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, list) {
+    if (fcu->driver != NULL) {
+      /* Drivers may run Python expressions. */
+      return false;
+    }
+    fcurves_num++;
+  }
+  if (fcurves_num < FCURVES_PARALLEL_EVALUATION_MIN) {
+    return false;
+  }
+
+  FCurvesEvalData data;
+  data.ptr = ptr;
+  data.anim_eval_context = anim_eval_context;
+  data.fcurves = MEM_malloc_arrayN(fcurves_num, sizeof(FCurve *), __func__);
+  data.anim_rnas = MEM_malloc_arrayN(fcurves_num, sizeof(PathResolvedRNA), __func__);
+  data.is_resolved = MEM_malloc_arrayN(fcurves_num, sizeof(bool), __func__);
+  data.values = MEM_malloc_arrayN(fcurves_num, sizeof(float), __func__);
+
+  int evaluated_num = 0;
+  LISTBASE_FOREACH (FCurve *, fcu, list) {
+    if (is_fcurve_evaluatable(fcu)) {
+      data.fcurves[evaluated_num++] = fcu;
+    }
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, evaluated_num, &data, animsys_evaluate_fcurve_task, &settings);
+
+  for (int i = 0; i < evaluated_num; i++) {
+    if (!data.is_resolved[i]) {
+      continue;
+    }
+    BKE_animsys_write_to_rna_path(&data.anim_rnas[i], data.values[i]);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(
+          ptr, data.fcurves[i]->rna_path, data.fcurves[i]->array_index, data.values[i]);
+    }
+  }
+
+  MEM_freeN(data.fcurves);
+  MEM_freeN(data.anim_rnas);
+  MEM_freeN(data.is_resolved);
+  MEM_freeN(data.values);
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -590,6 +784,10 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  if (animsys_evaluate_fcurves_parallel(ptr, list, anim_eval_context, flush_to_original)) {
+    return;
+  }
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -598,7 +796,7 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(ptr, fcu, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
       if (flush_to_original) {
@@ -670,7 +868,7 @@ static void animsys_blend_in_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (!animsys_rna_path_resolve_cached(ptr, fcu, &anim_rna)) {
       continue;
     }
 
@@ -759,7 +957,7 @@ static void animsys_evaluate_drivers(PointerRNA *ptr,
          * NOTE: for 'layering' option later on, we should check if we should remove old value
          * before adding new to only be done when drivers only changed. */
         PathResolvedRNA anim_rna;
-        if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+        if (animsys_rna_path_resolve_cached(ptr, fcu, &anim_rna)) {
           const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
           ok = BKE_animsys_write_to_rna_path(&anim_rna, curval);
         }
@@ -839,7 +1037,7 @@ void animsys_evaluate_action_group(PointerRNA *ptr,
     /* check if this curve should be skipped */
     if ((fcu->flag & (FCURVE_MUTED | FCURVE_DISABLED)) == 0 && !BKE_fcurve_is_empty(fcu)) {
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_rna_path_resolve_cached(ptr, fcu, &anim_rna)) {
         const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
         BKE_animsys_write_to_rna_path(&anim_rna, curval);
       }
@@ -4155,7 +4353,7 @@ void BKE_animsys_eval_driver(Depsgraph *depsgraph, ID *id, int driver_index, FCu
       // printf("\told val = %f\n", fcu->curval);
 
       PathResolvedRNA anim_rna;
-      if (BKE_animsys_rna_path_resolve(&id_ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      if (animsys_rna_path_resolve_cached(&id_ptr, fcu, &anim_rna)) {
         /* Evaluate driver, and write results to COW-domain destination */
         const float ctime = DEG_get_ctime(depsgraph);
         const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(
@@ -241,6 +241,12 @@ typedef struct ArmatureUserdata {
 
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
+  /**
+   * Deform matrix of the bone of every vertex group, already combined with #premat and #postmat
+   * so that it transforms coordinates of the target directly. Only set when all deforming bones
+   * can use #armature_vert_deform_linear.
+   */
+  float (*defbase_deform_mats)[4][4];
 
   float premat[4][4];
   float postmat[4][4];
@@ -251,10 +257,71 @@ typedef struct ArmatureUserdata {
   } bmesh;
 } ArmatureUserdata;
 
+/**
+ * Linear blend skinning of a vertex with the matrices in #ArmatureUserdata.defbase_deform_mats.
+ * Returns false when none of the vertex groups of the vertex belong to a deforming bone, the
+ * generic code path has to handle the vertex then.
+ */
+static bool armature_vert_deform_linear(const ArmatureUserdata *data,
+                                        const int i,
+                                        const MDeformVert *dvert)
+{
+  float armature_weight = 1.0f;
+  if (data->armature_def_nr != -1) {
+    armature_weight = BKE_defvert_find_weight(dvert, data->armature_def_nr);
+    if (data->invert_vgroup) {
+      armature_weight = 1.0f - armature_weight;
+    }
+  }
+  if (armature_weight == 0.0f) {
+    return true;
+  }
+
+  float *co = data->vert_coords[i];
+  float sum[3] = {0.0f, 0.0f, 0.0f};
+  float contrib = 0.0f;
+  bool deformed = false;
+
+  const MDeformWeight *dw = dvert->dw;
+  for (uint j = dvert->totweight; j != 0; j--, dw++) {
+    const uint index = dw->def_nr;
+    if (index >= data->defbase_len || data->pchan_from_defbase[index] == NULL) {
+      continue;
+    }
+    deformed = true;
+
+    const float weight = dw->weight;
+    const float(*mat)[4] = data->defbase_deform_mats[index];
+    sum[0] += weight * (mat[0][0] * co[0] + mat[1][0] * co[1] + mat[2][0] * co[2] + mat[3][0]);
+    sum[1] += weight * (mat[0][1] * co[0] + mat[1][1] * co[1] + mat[2][1] * co[2] + mat[3][1]);
+    sum[2] += weight * (mat[0][2] * co[0] + mat[1][2] * co[1] + mat[2][2] * co[2] + mat[3][2]);
+    contrib += weight;
+  }
+
+  if (!deformed) {
+    return false;
+  }
+
+  /* Same threshold as #armature_vert_task_with_dvert. */
+  if (contrib > 0.0001f) {
+    const float fac = armature_weight / contrib;
+    co[0] += (sum[0] - contrib * co[0]) * fac;
+    co[1] += (sum[1] - contrib * co[1]) * fac;
+    co[2] += (sum[2] - contrib * co[2]) * fac;
+  }
+  return true;
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
 {
+  if (data->defbase_deform_mats && dvert && dvert->totweight) {
+    if (armature_vert_deform_linear(data, i, dvert)) {
+      return;
+    }
+  }
+
   float(*const vert_coords)[3] = data->vert_coords;
   float(*const vert_deform_mats)[3][3] = data->vert_deform_mats;
   float(*const vert_coords_prev)[3] = data->vert_coords_prev;
@@ -459,6 +526,37 @@ static void armature_vert_task_editmesh_no_dvert(void *__restrict userdata,
   armature_vert_task_with_dvert(data, BM_elem_index_get(v), NULL);
 }
 
+/**
+ * Create the matrices for #armature_vert_deform_linear, or return null when some deforming bone
+ * needs the generic code path for B-Bone segments or envelope multiplication.
+ */
+static float (*armature_defbase_deform_mats_create(const ArmatureUserdata *data))[4][4]
+{
+  for (int i = 0; i < data->defbase_len; i++) {
+    const bPoseChannel *pchan = data->pchan_from_defbase[i];
+    if (pchan == NULL) {
+      continue;
+    }
+    const Bone *bone = pchan->bone;
+    if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+      return NULL;
+    }
+    if (bone->flag & BONE_MULT_VG_ENV) {
+      return NULL;
+    }
+  }
+
+  float(*mats)[4][4] = MEM_malloc_arrayN(
+      (size_t)max_ii(data->defbase_len, 1), sizeof(*mats), __func__);
+  for (int i = 0; i < data->defbase_len; i++) {
+    const bPoseChannel *pchan = data->pchan_from_defbase[i];
+    if (pchan != NULL) {
+      mul_m4_series(mats[i], data->postmat, pchan->chan_mat, data->premat);
+    }
+  }
+  return mats;
+}
+
 static void armature_deform_coords_impl(const Object *ob_arm,
                                         const Object *ob_target,
                                         float (*vert_coords)[3],
@@ -589,6 +687,12 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   mul_m4_m4m4(data.postmat, obinv, ob_arm->object_to_world);
   invert_m4_m4(data.premat, data.postmat);
 
+  /* Plain linear blend skinning doesn't need the per-vertex transform into armature space, the
+   * transforms are folded into one matrix per vertex group instead. */
+  if (use_dverts && !use_quaternion && !vert_deform_mats && !vert_coords_prev) {
+    data.defbase_deform_mats = armature_defbase_deform_mats_create(&data);
+  }
+
   if (em_target != NULL) {
     /* While this could cause an extra loop over mesh data, in most cases this will
      * have already been properly set. */
@@ -616,6 +720,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   if (pchan_from_defbase) {
     MEM_freeN(pchan_from_defbase);
   }
+  MEM_SAFE_FREE(data.defbase_deform_mats);
 }
 
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
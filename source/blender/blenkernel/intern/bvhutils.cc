@@ -18,6 +18,7 @@
 #include "BLI_math.h"
 #include "BLI_span.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -26,6 +27,7 @@
 #include "BKE_editmesh.h"
 #include "BKE_mesh.h"
 #include "BKE_mesh_runtime.h"
+#include "BKE_pointcloud.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -41,6 +43,12 @@ using blender::VArray;
 
 struct BVHCacheItem {
   bool is_filled;
+  /**
+   * The positions the tree was built from have changed but the topology did not. The tree is
+   * kept so it can be refit to the new positions instead of being rebuilt from scratch.
+   * Only set when #is_filled is false.
+   */
+  bool is_outdated;
   BVHTree *tree;
 };
 
@@ -135,10 +143,53 @@ static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType typ
 {
   BVHCacheItem *item = &bvh_cache->items[type];
   BLI_assert(!item->is_filled);
+  BLI_assert(!item->is_outdated);
   item->tree = tree;
   item->is_filled = true;
 }
 
+/**
+ * Trees of these types contain every element of the mesh, inserted in index order, so the leaf
+ * index is the element index and they can be refit without recomputing a mask.
+ */
+static bool bvhcache_type_is_refittable(const BVHCacheType type)
+{
+  return ELEM(type, BVHTREE_FROM_VERTS, BVHTREE_FROM_EDGES, BVHTREE_FROM_LOOPTRI);
+}
+
+void bvhcache_tag_positions_changed(BVHCache *bvh_cache)
+{
+  for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
+    BVHCacheItem *item = &bvh_cache->items[index];
+    if (!item->is_filled) {
+      continue;
+    }
+    item->is_filled = false;
+    if (item->tree && bvhcache_type_is_refittable(BVHCacheType(index))) {
+      item->is_outdated = true;
+      continue;
+    }
+    BLI_bvhtree_free(item->tree);
+    item->tree = nullptr;
+  }
+}
+
+/**
+ * Take ownership of the outdated tree of the given type, if any.
+ * Must be called with the cache mutex locked.
+ */
+static BVHTree *bvhcache_take_outdated(BVHCache *bvh_cache, const BVHCacheType type)
+{
+  BVHCacheItem *item = &bvh_cache->items[type];
+  if (!item->is_outdated) {
+    return nullptr;
+  }
+  BVHTree *tree = item->tree;
+  item->tree = nullptr;
+  item->is_outdated = false;
+  return tree;
+}
+
 void bvhcache_free(BVHCache *bvh_cache)
 {
   for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
@@ -1200,6 +1251,56 @@ static BitVector<> looptri_no_hidden_map_get(const Span<MPoly> polys,
   return looptri_mask;
 }
 
+/**
+ * Refit the leaves of a tree built from outdated positions, keeping its hierarchy.
+ * Returns false when the element count changed and the tree has to be rebuilt.
+ *
+ * The quality of the hierarchy degrades when the deformation is large, but rebuilding
+ * is considerably more expensive than an update of the bounds.
+ */
+static bool bvhtree_refit_from_mesh(BVHTree *tree,
+                                    const BVHCacheType bvh_cache_type,
+                                    const float (*positions)[3],
+                                    const Span<MEdge> edges,
+                                    const Span<MLoop> loops,
+                                    const MLoopTri *looptri,
+                                    const int elems_num)
+{
+  if (BLI_bvhtree_get_len(tree) != elems_num) {
+    return false;
+  }
+
+  /* Running inside the cache mutex lock, see #bvhtree_balance_isolated. */
+  blender::threading::isolate_task([&]() {
+    blender::threading::parallel_for(IndexRange(elems_num), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        float co[3][3];
+        switch (bvh_cache_type) {
+          case BVHTREE_FROM_VERTS:
+            BLI_bvhtree_update_node(tree, i, positions[i], nullptr, 1);
+            break;
+          case BVHTREE_FROM_EDGES:
+            copy_v3_v3(co[0], positions[edges[i].v1]);
+            copy_v3_v3(co[1], positions[edges[i].v2]);
+            BLI_bvhtree_update_node(tree, i, co[0], nullptr, 2);
+            break;
+          case BVHTREE_FROM_LOOPTRI:
+            copy_v3_v3(co[0], positions[loops[looptri[i].tri[0]].v]);
+            copy_v3_v3(co[1], positions[loops[looptri[i].tri[1]].v]);
+            copy_v3_v3(co[2], positions[loops[looptri[i].tri[2]].v]);
+            BLI_bvhtree_update_node(tree, i, co[0], nullptr, 3);
+            break;
+          default:
+            BLI_assert_unreachable();
+            break;
+        }
+      }
+    });
+    BLI_bvhtree_update_tree(tree);
+  });
+  return true;
+}
+
 BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
                                    const struct Mesh *mesh,
                                    const BVHCacheType bvh_cache_type,
@@ -1238,6 +1339,22 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
     return data->tree;
   }
 
+  /* Refit the tree when only the positions changed since it was built. */
+  if (BVHTree *tree = bvhcache_take_outdated(*bvh_cache_p, bvh_cache_type)) {
+    const int elems_num = bvh_cache_type == BVHTREE_FROM_VERTS ? mesh->totvert :
+                          bvh_cache_type == BVHTREE_FROM_EDGES ? mesh->totedge :
+                                                                 looptri_len;
+    if (bvhtree_refit_from_mesh(
+            tree, bvh_cache_type, positions, edges, loops, looptri, elems_num)) {
+      data->tree = tree;
+      data->cached = true;
+      bvhcache_insert(*bvh_cache_p, data->tree, bvh_cache_type);
+      bvhcache_unlock(*bvh_cache_p, lock_started);
+      return data->tree;
+    }
+    BLI_bvhtree_free(tree);
+  }
+
   /* Create BVHTree. */
   BitVector<> mask;
   int mask_bits_act_len = -1;
@@ -1424,31 +1541,38 @@ BVHTree *BKE_bvhtree_from_pointcloud_get(BVHTreeFromPointCloud *data,
                                          const PointCloud *pointcloud,
                                          const int tree_type)
 {
-  BVHTree *tree = BLI_bvhtree_new(pointcloud->totpoint, 0.0f, tree_type, 6);
-  if (!tree) {
-    return nullptr;
-  }
-
-  blender::bke::AttributeAccessor attributes = pointcloud->attributes();
-  blender::VArraySpan<blender::float3> positions = attributes.lookup_or_default<blender::float3>(
-      "position", ATTR_DOMAIN_POINT, blender::float3(0));
-
-  for (const int i : positions.index_range()) {
-    BLI_bvhtree_insert(tree, i, positions[i], 1);
-  }
-  BLI_assert(BLI_bvhtree_get_len(tree) == pointcloud->totpoint);
-  bvhtree_balance(tree, false);
-
-  data->coords = (const float(*)[3])positions.data();
-  data->tree = tree;
+  const float(*positions)[3] = static_cast<const float(*)[3]>(
+      CustomData_get_layer_named(&pointcloud->pdata, CD_PROP_FLOAT3, "position"));
+
+  pointcloud->runtime->bvh_cache.ensure(
+      [&](std::unique_ptr<BVHTree, blender::bke::BVHTreeDeleter> &r_tree) {
+        r_tree.reset();
+        if (positions == nullptr) {
+          return;
+        }
+        BVHTree *tree = BLI_bvhtree_new(pointcloud->totpoint, 0.0f, tree_type, 6);
+        if (!tree) {
+          return;
+        }
+        for (const int i : blender::IndexRange(pointcloud->totpoint)) {
+          BLI_bvhtree_insert(tree, i, positions[i], 1);
+        }
+        BLI_assert(BLI_bvhtree_get_len(tree) == pointcloud->totpoint);
+        bvhtree_balance(tree, false);
+        r_tree.reset(tree);
+      });
+
+  data->tree = pointcloud->runtime->bvh_cache.data().get();
+  data->cached = true;
+  data->coords = positions;
   data->nearest_callback = nullptr;
 
-  return tree;
+  return data->tree;
 }
 
 void free_bvhtree_from_pointcloud(BVHTreeFromPointCloud *data)
 {
-  if (data->tree) {
+  if (data->tree && !data->cached) {
     BLI_bvhtree_free(data->tree);
   }
   memset(data, 0, sizeof(*data));
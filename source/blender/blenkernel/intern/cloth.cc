@@ -17,6 +17,7 @@
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_rand.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DEG_depsgraph.h"
@@ -117,11 +118,10 @@ static BVHTree *bvhtree_build_from_cloth(ClothModifierData *clmd, float epsilon)
 
 void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
 {
-  uint i = 0;
+  using namespace blender;
   Cloth *cloth = clmd->clothObject;
   BVHTree *bvhtree;
-  ClothVertex *verts = cloth->verts;
-  const MVertTri *vt;
+  const ClothVertex *verts = cloth->verts;
 
   BLI_assert(!(clmd->hairdata != nullptr && self));
 
@@ -136,41 +136,42 @@ void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
     return;
   }
 
-  vt = cloth->tri;
+  /* The tree is only refit to the new positions. Every primitive updates its own leaf,
+   * so they can be updated in parallel before the inner nodes are updated. */
+  BLI_assert(int(cloth->primitive_num) <= BLI_bvhtree_get_len(bvhtree));
+  const IndexRange primitives(cloth->primitive_num);
 
   /* update vertex position in bvh tree */
   if (clmd->hairdata == nullptr) {
-    if (verts && vt) {
-      for (i = 0; i < cloth->primitive_num; i++, vt++) {
-        float co[3][3], co_moving[3][3];
-        bool ret;
-
-        /* copy new locations into array */
-        if (moving) {
-          copy_v3_v3(co[0], verts[vt->tri[0]].txold);
-          copy_v3_v3(co[1], verts[vt->tri[1]].txold);
-          copy_v3_v3(co[2], verts[vt->tri[2]].txold);
-
-          /* update moving positions */
-          copy_v3_v3(co_moving[0], verts[vt->tri[0]].tx);
-          copy_v3_v3(co_moving[1], verts[vt->tri[1]].tx);
-          copy_v3_v3(co_moving[2], verts[vt->tri[2]].tx);
-
-          ret = BLI_bvhtree_update_node(bvhtree, i, co[0], co_moving[0], 3);
-        }
-        else {
-          copy_v3_v3(co[0], verts[vt->tri[0]].tx);
-          copy_v3_v3(co[1], verts[vt->tri[1]].tx);
-          copy_v3_v3(co[2], verts[vt->tri[2]].tx);
-
-          ret = BLI_bvhtree_update_node(bvhtree, i, co[0], nullptr, 3);
-        }
+    const MVertTri *tri = cloth->tri;
+    if (verts && tri) {
+      threading::parallel_for(primitives, 1024, [&](const IndexRange range) {
+        for (const int i : range) {
+          const MVertTri *vt = &tri[i];
+          float co[3][3], co_moving[3][3];
+
+          /* copy new locations into array */
+          if (moving) {
+            copy_v3_v3(co[0], verts[vt->tri[0]].txold);
+            copy_v3_v3(co[1], verts[vt->tri[1]].txold);
+            copy_v3_v3(co[2], verts[vt->tri[2]].txold);
+
+            /* update moving positions */
+            copy_v3_v3(co_moving[0], verts[vt->tri[0]].tx);
+            copy_v3_v3(co_moving[1], verts[vt->tri[1]].tx);
+            copy_v3_v3(co_moving[2], verts[vt->tri[2]].tx);
+
+            BLI_bvhtree_update_node(bvhtree, i, co[0], co_moving[0], 3);
+          }
+          else {
+            copy_v3_v3(co[0], verts[vt->tri[0]].tx);
+            copy_v3_v3(co[1], verts[vt->tri[1]].tx);
+            copy_v3_v3(co[2], verts[vt->tri[2]].tx);
 
-        /* check if tree is already full */
-        if (ret == false) {
-          break;
+            BLI_bvhtree_update_node(bvhtree, i, co[0], nullptr, 3);
+          }
         }
-      }
+      });
 
       BLI_bvhtree_update_tree(bvhtree);
     }
@@ -179,16 +180,16 @@ void bvhtree_update_from_cloth(ClothModifierData *clmd, bool moving, bool self)
     if (verts) {
       const MEdge *edges = cloth->edges;
 
-      for (i = 0; i < cloth->primitive_num; i++) {
-        float co[2][3];
+      threading::parallel_for(primitives, 1024, [&](const IndexRange range) {
+        for (const int i : range) {
+          float co[2][3];
 
-        copy_v3_v3(co[0], verts[edges[i].v1].tx);
-        copy_v3_v3(co[1], verts[edges[i].v2].tx);
+          copy_v3_v3(co[0], verts[edges[i].v1].tx);
+          copy_v3_v3(co[1], verts[edges[i].v2].tx);
 
-        if (!BLI_bvhtree_update_node(bvhtree, i, co[0], nullptr, 2)) {
-          break;
+          BLI_bvhtree_update_node(bvhtree, i, co[0], nullptr, 2);
         }
-      }
+      });
 
       BLI_bvhtree_update_tree(bvhtree);
     }
@@ -12,6 +12,7 @@
 #include <string.h>
 
 #include "BLI_blenlib.h"
+#include "BLI_ghash.h"
 #include "BLI_iterator.h"
 #include "BLI_listbase.h"
 #include "BLI_math_base.h"
@@ -72,6 +73,8 @@ static CollectionParent *collection_find_parent(Collection *child, Collection *c
 static bool collection_find_child_recursive(const Collection *parent,
                                             const Collection *collection);
 
+static void collection_gobject_hash_free(Collection *collection);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -115,6 +118,7 @@ static void collection_copy_data(Main *bmain, ID *id_dst, const ID *id_src, cons
   collection_dst->flag &= ~(COLLECTION_HAS_OBJECT_CACHE | COLLECTION_HAS_OBJECT_CACHE_INSTANCED);
   BLI_listbase_clear(&collection_dst->runtime.object_cache);
   BLI_listbase_clear(&collection_dst->runtime.object_cache_instanced);
+  collection_dst->runtime.gobject_hash = NULL;
 
   BLI_listbase_clear(&collection_dst->gobject);
   BLI_listbase_clear(&collection_dst->children);
@@ -136,6 +140,7 @@ static void collection_free_data(ID *id)
   BKE_previewimg_free(&collection->preview);
 
   BLI_freelistN(&collection->gobject);
+  collection_gobject_hash_free(collection);
   BLI_freelistN(&collection->children);
   BLI_freelistN(&collection->runtime.parents);
 
@@ -150,7 +155,12 @@ static void collection_foreach_id(ID *id, LibraryForeachIDData *data)
       data, collection->runtime.owner_id, IDWALK_CB_LOOPBACK | IDWALK_CB_NEVER_SELF);
 
   LISTBASE_FOREACH (CollectionObject *, cob, &collection->gobject) {
+    Object *cob_ob_old = cob->ob;
     BKE_LIB_FOREACHID_PROCESS_IDSUPER(data, cob->ob, IDWALK_CB_USER);
+    if (cob->ob != cob_ob_old) {
+      /* Remapped, the lookup is keyed by the old object. */
+      collection_gobject_hash_free(collection);
+    }
   }
   LISTBASE_FOREACH (CollectionChild *, child, &collection->children) {
     BKE_LIB_FOREACHID_PROCESS_IDSUPER(
@@ -933,13 +943,48 @@ bool BKE_collection_object_cyclic_check(Main *bmain, Object *object, Collection
 /** \name Collection Object Membership
  * \{ */
 
+static void collection_gobject_hash_free(Collection *collection)
+{
+  if (collection->runtime.gobject_hash) {
+    BLI_ghash_free(collection->runtime.gobject_hash, NULL, NULL);
+    collection->runtime.gobject_hash = NULL;
+  }
+}
+
+static GHash *collection_gobject_hash_ensure(Collection *collection)
+{
+  if (collection->runtime.gobject_hash == NULL) {
+    GHash *gobject_hash = BLI_ghash_ptr_new_ex(__func__,
+                                               BLI_listbase_count(&collection->gobject));
+    LISTBASE_FOREACH (CollectionObject *, cob, &collection->gobject) {
+      BLI_ghash_insert(gobject_hash, cob->ob, cob);
+    }
+    collection->runtime.gobject_hash = gobject_hash;
+  }
+  return collection->runtime.gobject_hash;
+}
+
+/**
+ * Find the #CollectionObject of `ob`, using the lookup when it exists.
+ * \note Doesn't create the lookup, so it is safe to call from multiple threads.
+ */
+static CollectionObject *collection_gobject_find(const Collection *collection, const Object *ob)
+{
+  if (collection->runtime.gobject_hash) {
+    CollectionObject *cob = BLI_ghash_lookup(collection->runtime.gobject_hash, ob);
+    BLI_assert(cob == NULL || cob->ob == ob);
+    return cob;
+  }
+  return BLI_findptr(&collection->gobject, ob, offsetof(CollectionObject, ob));
+}
+
 bool BKE_collection_has_object(Collection *collection, const Object *ob)
 {
   if (ELEM(NULL, collection, ob)) {
     return false;
   }
 
-  return BLI_findptr(&collection->gobject, ob, offsetof(CollectionObject, ob));
+  return collection_gobject_find(collection, ob) != NULL;
 }
 
 bool BKE_collection_has_object_recursive(Collection *collection, Object *ob)
@@ -1070,13 +1115,15 @@ static bool collection_object_add(
     }
   }
 
-  CollectionObject *cob = BLI_findptr(&collection->gobject, ob, offsetof(CollectionObject, ob));
-  if (cob) {
+  GHash *gobject_hash = collection_gobject_hash_ensure(collection);
+  void **cob_p;
+  if (BLI_ghash_ensure_p(gobject_hash, ob, &cob_p)) {
     return false;
   }
 
-  cob = MEM_callocN(sizeof(CollectionObject), __func__);
+  CollectionObject *cob = MEM_callocN(sizeof(CollectionObject), __func__);
   cob->ob = ob;
+  *cob_p = cob;
   BLI_addtail(&collection->gobject, cob);
   BKE_collection_object_cache_free(collection);
 
@@ -1100,7 +1147,7 @@ static bool collection_object_remove(Main *bmain,
                                      Object *ob,
                                      const bool free_us)
 {
-  CollectionObject *cob = BLI_findptr(&collection->gobject, ob, offsetof(CollectionObject, ob));
+  CollectionObject *cob = BLI_ghash_popkey(collection_gobject_hash_ensure(collection), ob, NULL);
   if (cob == NULL) {
     return false;
   }
@@ -1219,15 +1266,24 @@ bool BKE_collection_object_replace(Main *bmain,
                                    Object *ob_old,
                                    Object *ob_new)
 {
-  CollectionObject *cob = BLI_findptr(
-      &collection->gobject, ob_old, offsetof(CollectionObject, ob));
+  GHash *gobject_hash = collection_gobject_hash_ensure(collection);
+  CollectionObject *cob = BLI_ghash_lookup(gobject_hash, ob_old);
   if (cob == NULL) {
     return false;
   }
 
+  BLI_ghash_remove(gobject_hash, ob_old, NULL, NULL);
   id_us_min(&cob->ob->id);
   cob->ob = ob_new;
   id_us_plus(&cob->ob->id);
+  void **cob_p;
+  if (BLI_ghash_ensure_p(gobject_hash, ob_new, &cob_p)) {
+    /* The new object was already in the collection, rebuild the lookup on demand. */
+    collection_gobject_hash_free(collection);
+  }
+  else {
+    *cob_p = cob;
+  }
 
   if (BKE_collection_is_in_scene(collection)) {
     BKE_main_collection_sync(bmain);
@@ -1290,6 +1346,7 @@ static void collection_object_remove_nulls(Collection *collection)
   }
 
   if (changed) {
+    collection_gobject_hash_free(collection);
     BKE_collection_object_cache_free(collection);
   }
 }
@@ -1329,6 +1386,7 @@ static void collection_object_remove_duplicates(Collection *collection)
   }
 
   if (changed) {
+    collection_gobject_hash_free(collection);
     BKE_collection_object_cache_free(collection);
   }
 }
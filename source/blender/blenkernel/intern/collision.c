@@ -118,6 +118,40 @@ BVHTree *bvhtree_build_from_mvert(const float (*positions)[3],
   return tree;
 }
 
+typedef struct BVHTreeUpdateData {
+  BVHTree *bvhtree;
+  const float (*positions)[3];
+  const float (*positions_moving)[3];
+  const MVertTri *tri;
+} BVHTreeUpdateData;
+
+static void bvhtree_update_from_mvert_cb(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHTreeUpdateData *data = (const BVHTreeUpdateData *)userdata;
+  const MVertTri *vt = &data->tri[i];
+  float co[3][3];
+
+  copy_v3_v3(co[0], data->positions[vt->tri[0]]);
+  copy_v3_v3(co[1], data->positions[vt->tri[1]]);
+  copy_v3_v3(co[2], data->positions[vt->tri[2]]);
+
+  /* copy new locations into array */
+  if (data->positions_moving) {
+    float co_moving[3][3];
+    /* update moving positions */
+    copy_v3_v3(co_moving[0], data->positions_moving[vt->tri[0]]);
+    copy_v3_v3(co_moving[1], data->positions_moving[vt->tri[1]]);
+    copy_v3_v3(co_moving[2], data->positions_moving[vt->tri[2]]);
+
+    BLI_bvhtree_update_node(data->bvhtree, i, &co[0][0], &co_moving[0][0], 3);
+  }
+  else {
+    BLI_bvhtree_update_node(data->bvhtree, i, &co[0][0], NULL, 3);
+  }
+}
+
 void bvhtree_update_from_mvert(BVHTree *bvhtree,
                                const float (*positions)[3],
                                const float (*positions_moving)[3],
@@ -130,39 +164,20 @@ void bvhtree_update_from_mvert(BVHTree *bvhtree,
     return;
   }
 
-  if (positions_moving == NULL) {
-    moving = false;
-  }
-
-  const MVertTri *vt;
-  int i;
-  for (i = 0, vt = tri; i < tri_num; i++, vt++) {
-    float co[3][3];
-    bool ret;
-
-    copy_v3_v3(co[0], positions[vt->tri[0]]);
-    copy_v3_v3(co[1], positions[vt->tri[1]]);
-    copy_v3_v3(co[2], positions[vt->tri[2]]);
-
-    /* copy new locations into array */
-    if (moving) {
-      float co_moving[3][3];
-      /* update moving positions */
-      copy_v3_v3(co_moving[0], positions_moving[vt->tri[0]]);
-      copy_v3_v3(co_moving[1], positions_moving[vt->tri[1]]);
-      copy_v3_v3(co_moving[2], positions_moving[vt->tri[2]]);
-
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], &co_moving[0][0], 3);
-    }
-    else {
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], NULL, 3);
-    }
+  BVHTreeUpdateData data = {
+      .bvhtree = bvhtree,
+      .positions = positions,
+      .positions_moving = moving ? positions_moving : NULL,
+      .tri = tri,
+  };
 
-    /* check if tree is already full */
-    if (ret == false) {
-      break;
-    }
-  }
+  /* The tree was built from the same triangles, so the leaves are only refit to the new
+   * positions. Every triangle updates its own leaf, so they can be updated in parallel. */
+  BLI_assert(tri_num <= BLI_bvhtree_get_len(bvhtree));
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, tri_num, &data, bvhtree_update_from_mvert_cb, &settings);
 
   BLI_bvhtree_update_tree(bvhtree);
 }
@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_curve_types.h"
@@ -193,6 +194,82 @@ static bool calc_curve_deform(
  * #BKE_curve_deform and related functions.
  * \{ */
 
+typedef struct CurveDeformUserdata {
+  const Object *ob_curve;
+  const CurveDeform *cd;
+  float (*vert_coords)[3];
+  const MDeformVert *dvert;
+  int defgrp_index;
+  short defaxis;
+  bool invert_vgroup;
+  /** The coordinates were already transformed into curve-space to calculate the bounds. */
+  bool is_curvespace;
+
+  /** Specific data types. */
+  struct {
+    int cd_dvert_offset;
+  } bmesh;
+} CurveDeformUserdata;
+
+static float curve_deform_dvert_weight(const CurveDeformUserdata *data, const MDeformVert *dvert)
+{
+  const float weight = BKE_defvert_find_weight(dvert, data->defgrp_index);
+  return data->invert_vgroup ? 1.0f - weight : weight;
+}
+
+static void curve_deform_vert_with_dvert(const CurveDeformUserdata *data,
+                                         const int index,
+                                         const MDeformVert *dvert)
+{
+  float *co = data->vert_coords[index];
+  const float weight = dvert ? curve_deform_dvert_weight(data, dvert) : 1.0f;
+  if (weight <= 0.0f) {
+    return;
+  }
+
+  if (!data->is_curvespace) {
+    mul_m4_v3(data->cd->curvespace, co);
+  }
+  if (dvert) {
+    float vec[3];
+    copy_v3_v3(vec, co);
+    calc_curve_deform(data->ob_curve, vec, data->defaxis, data->cd, NULL);
+    interp_v3_v3v3(co, co, vec, weight);
+  }
+  else {
+    calc_curve_deform(data->ob_curve, co, data->defaxis, data->cd, NULL);
+  }
+  mul_m4_v3(data->cd->objectspace, co);
+}
+
+static void curve_deform_vert_task(void *__restrict userdata,
+                                   const int index,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveDeformUserdata *data = userdata;
+  curve_deform_vert_with_dvert(data, index, data->dvert ? &data->dvert[index] : NULL);
+}
+
+static void curve_deform_vert_task_editmesh(void *__restrict userdata,
+                                            MempoolIterData *iter,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CurveDeformUserdata *data = userdata;
+  BMVert *v = (BMVert *)iter;
+  const MDeformVert *dvert = BM_ELEM_CD_GET_VOID_P(v, data->bmesh.cd_dvert_offset);
+  curve_deform_vert_with_dvert(data, BM_elem_index_get(v), dvert);
+}
+
+static void curve_deform_vert_task_editmesh_no_dvert(void *__restrict userdata,
+                                                     MempoolIterData *iter,
+                                                     const TaskParallelTLS *__restrict
+                                                         UNUSED(tls))
+{
+  const CurveDeformUserdata *data = userdata;
+  BMVert *v = (BMVert *)iter;
+  curve_deform_vert_with_dvert(data, BM_elem_index_get(v), NULL);
+}
+
 static void curve_deform_coords_impl(const Object *ob_curve,
                                      const Object *ob_target,
                                      float (*vert_coords)[3],
@@ -204,12 +281,9 @@ static void curve_deform_coords_impl(const Object *ob_curve,
                                      BMEditMesh *em_target)
 {
   Curve *cu;
-  int a;
   CurveDeform cd;
   const bool is_neg_axis = (defaxis > 2);
-  const bool invert_vgroup = (flag & MOD_CURVE_INVERT_VGROUP) != 0;
-  bool use_dverts = false;
-  int cd_dvert_offset;
+  int cd_dvert_offset = -1;
 
   if (ob_curve->type != OB_CURVES_LEGACY) {
     return;
@@ -219,6 +293,28 @@ static void curve_deform_coords_impl(const Object *ob_curve,
 
   init_curve_deform(ob_curve, ob_target, &cd);
 
+  if (em_target != NULL) {
+    cd_dvert_offset = CustomData_get_offset(&em_target->bm->vdata, CD_MDEFORMVERT);
+    /* While this could cause an extra loop over mesh data, in most cases this will
+     * have already been properly set. */
+    BM_mesh_elem_index_ensure(em_target->bm, BM_VERT);
+  }
+
+  CurveDeformUserdata data = {
+      .ob_curve = ob_curve,
+      .cd = &cd,
+      .vert_coords = vert_coords,
+      .dvert = em_target ? NULL : dvert,
+      .defgrp_index = defgrp_index,
+      .defaxis = defaxis,
+      .invert_vgroup = (flag & MOD_CURVE_INVERT_VGROUP) != 0,
+      .is_curvespace = false,
+      .bmesh =
+          {
+              .cd_dvert_offset = cd_dvert_offset,
+          },
+  };
+
   if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
     /* Dummy bounds. */
     if (is_neg_axis == false) {
@@ -232,133 +328,55 @@ static void curve_deform_coords_impl(const Object *ob_curve,
     }
   }
   else {
-    /* Set mesh min/max bounds. */
+    /* Set mesh min/max bounds of the deformed vertices in curve-space. This has to be done
+     * before deforming any vertex, so it's a separate loop. */
     INIT_MINMAX(cd.dmin, cd.dmax);
-  }
 
-  if (em_target != NULL) {
-    cd_dvert_offset = CustomData_get_offset(&em_target->bm->vdata, CD_MDEFORMVERT);
-    if (cd_dvert_offset != -1) {
-      use_dverts = true;
-    }
-  }
-  else {
-    if (dvert != NULL) {
-      use_dverts = true;
-    }
-  }
-
-  if (use_dverts) {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-
-#define DEFORM_OP(dvert) \
-  { \
-    const float weight = invert_vgroup ? 1.0f - BKE_defvert_find_weight(dvert, defgrp_index) : \
-                                         BKE_defvert_find_weight(dvert, defgrp_index); \
-    if (weight > 0.0f) { \
-      float vec[3]; \
-      mul_m4_v3(cd.curvespace, vert_coords[a]); \
-      copy_v3_v3(vec, vert_coords[a]); \
-      calc_curve_deform(ob_curve, vec, defaxis, &cd, NULL); \
-      interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight); \
-      mul_m4_v3(cd.objectspace, vert_coords[a]); \
-    } \
-  } \
-  ((void)0)
-
-      if (em_target != NULL) {
-        BMIter iter;
-        BMVert *v;
-        BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
-          dvert = BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset);
-          DEFORM_OP(dvert);
-        }
-      }
-      else {
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP(&dvert[a]);
+    if (em_target != NULL) {
+      BMIter iter;
+      BMVert *v;
+      int a;
+      BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
+        if (cd_dvert_offset != -1 &&
+            curve_deform_dvert_weight(&data, BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset)) <= 0.0f) {
+          continue;
         }
+        mul_m4_v3(cd.curvespace, vert_coords[a]);
+        minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
       }
-
-#undef DEFORM_OP
     }
     else {
-
-#define DEFORM_OP_MINMAX(dvert) \
-  { \
-    const float weight = invert_vgroup ? 1.0f - BKE_defvert_find_weight(dvert, defgrp_index) : \
-                                         BKE_defvert_find_weight(dvert, defgrp_index); \
-    if (weight > 0.0f) { \
-      mul_m4_v3(cd.curvespace, vert_coords[a]); \
-      minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]); \
-    } \
-  } \
-  ((void)0)
-
-      /* Already in 'cd.curvespace', previous for loop. */
-#define DEFORM_OP_CLAMPED(dvert) \
-  { \
-    const float weight = invert_vgroup ? 1.0f - BKE_defvert_find_weight(dvert, defgrp_index) : \
-                                         BKE_defvert_find_weight(dvert, defgrp_index); \
-    if (weight > 0.0f) { \
-      float vec[3]; \
-      copy_v3_v3(vec, vert_coords[a]); \
-      calc_curve_deform(ob_curve, vec, defaxis, &cd, NULL); \
-      interp_v3_v3v3(vert_coords[a], vert_coords[a], vec, weight); \
-      mul_m4_v3(cd.objectspace, vert_coords[a]); \
-    } \
-  } \
-  ((void)0)
-
-      if (em_target != NULL) {
-        BMIter iter;
-        BMVert *v;
-        BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
-          dvert = BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset);
-          DEFORM_OP_MINMAX(dvert);
-        }
-
-        BM_ITER_MESH_INDEX (v, &iter, em_target->bm, BM_VERTS_OF_MESH, a) {
-          dvert = BM_ELEM_CD_GET_VOID_P(v, cd_dvert_offset);
-          DEFORM_OP_CLAMPED(dvert);
-        }
-      }
-      else {
-
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP_MINMAX(&dvert[a]);
-        }
-
-        for (a = 0; a < vert_coords_len; a++) {
-          DEFORM_OP_CLAMPED(&dvert[a]);
+      for (int a = 0; a < vert_coords_len; a++) {
+        if (dvert && curve_deform_dvert_weight(&data, &dvert[a]) <= 0.0f) {
+          continue;
         }
+        mul_m4_v3(cd.curvespace, vert_coords[a]);
+        minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
       }
     }
-
-#undef DEFORM_OP_MINMAX
-#undef DEFORM_OP_CLAMPED
+    data.is_curvespace = true;
   }
-  else {
-    if (cu->flag & CU_DEFORM_BOUNDS_OFF) {
-      for (a = 0; a < vert_coords_len; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
+
+  /* Every vertex is deformed independently, reading the curve path only. */
+  if (em_target != NULL) {
+    TaskParallelSettings settings;
+    BLI_parallel_mempool_settings_defaults(&settings);
+
+    if (cd_dvert_offset != -1) {
+      BLI_task_parallel_mempool(
+          em_target->bm->vpool, &data, curve_deform_vert_task_editmesh, &settings);
     }
     else {
-      for (a = 0; a < vert_coords_len; a++) {
-        mul_m4_v3(cd.curvespace, vert_coords[a]);
-        minmax_v3v3_v3(cd.dmin, cd.dmax, vert_coords[a]);
-      }
-
-      for (a = 0; a < vert_coords_len; a++) {
-        /* Already in 'cd.curvespace', previous for loop. */
-        calc_curve_deform(ob_curve, vert_coords[a], defaxis, &cd, NULL);
-        mul_m4_v3(cd.objectspace, vert_coords[a]);
-      }
+      BLI_task_parallel_mempool(
+          em_target->bm->vpool, &data, curve_deform_vert_task_editmesh_no_dvert, &settings);
     }
   }
+  else {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 32;
+    BLI_task_parallel_range(0, vert_coords_len, &data, curve_deform_vert_task, &settings);
+  }
 }
 
 void BKE_curve_deform_coords(const Object *ob_curve,
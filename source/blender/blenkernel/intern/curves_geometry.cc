@@ -13,6 +13,7 @@
 #include "BLI_bounds.hh"
 #include "BLI_index_mask_ops.hh"
 #include "BLI_length_parameterize.hh"
+#include "BLI_map.hh"
 #include "BLI_math_rotation_legacy.hh"
 #include "BLI_task.hh"
 
@@ -82,8 +83,9 @@ static void copy_curves_geometry(CurvesGeometry &dst, const CurvesGeometry &src)
   CustomData_free(&dst.curve_data, dst.curve_num);
   dst.point_num = src.point_num;
   dst.curve_num = src.curve_num;
-  CustomData_copy(&src.point_data, &dst.point_data, CD_MASK_ALL, CD_DUPLICATE, dst.point_num);
-  CustomData_copy(&src.curve_data, &dst.curve_data, CD_MASK_ALL, CD_DUPLICATE, dst.curve_num);
+  /* Attributes are only copied when one of the geometries modifies them. */
+  CustomData_copy(&src.point_data, &dst.point_data, CD_MASK_ALL, CD_SHARE, dst.point_num);
+  CustomData_copy(&src.curve_data, &dst.curve_data, CD_MASK_ALL, CD_SHARE, dst.curve_num);
 
   MEM_SAFE_FREE(dst.curve_offsets);
   dst.curve_offsets = (int *)MEM_malloc_arrayN(dst.point_num + 1, sizeof(int), __func__);
@@ -561,25 +563,63 @@ Array<int> CurvesGeometry::point_to_curve_map() const
 void CurvesGeometry::ensure_nurbs_basis_cache() const
 {
   const bke::CurvesGeometryRuntime &runtime = *this->runtime;
-  runtime.nurbs_basis_cache.ensure([&](Vector<curves::nurbs::BasisCache> &r_data) {
+  runtime.nurbs_basis_cache.ensure([&](curves::nurbs::BasisCaches &r_data) {
     Vector<int64_t> nurbs_indices;
     const IndexMask nurbs_mask = this->indices_for_curve_type(CURVE_TYPE_NURBS, nurbs_indices);
     if (nurbs_mask.is_empty()) {
-      r_data.clear_and_shrink();
+      r_data.caches.clear_and_shrink();
+      r_data.cache_indices.clear_and_shrink();
       return;
     }
 
-    r_data.resize(this->curves_num());
-
     const OffsetIndices<int> points_by_curve = this->points_by_curve();
     const OffsetIndices<int> evaluated_points_by_curve = this->evaluated_points_by_curve();
     const VArray<bool> cyclic = this->cyclic();
     const VArray<int8_t> orders = this->nurbs_orders();
     const VArray<int8_t> knots_modes = this->nurbs_knots_modes();
 
-    threading::parallel_for(nurbs_mask.index_range(), 64, [&](const IndexRange range) {
+    /* Find the curves that can share a basis cache. */
+    struct BasisKey {
+      int points_num;
+      int evaluated_num;
+      int8_t order;
+      bool cyclic;
+      int8_t mode;
+
+      uint64_t hash() const
+      {
+        return get_default_hash_4(
+            points_num, evaluated_num, order, (int(cyclic) << 8) | int(uint8_t(mode)));
+      }
+
+      bool operator==(const BasisKey &other) const
+      {
+        return points_num == other.points_num && evaluated_num == other.evaluated_num &&
+               order == other.order && cyclic == other.cyclic && mode == other.mode;
+      }
+    };
+    Map<BasisKey, int> cache_index_by_key;
+    Vector<int> first_curves;
+    r_data.cache_indices.reinitialize(this->curves_num());
+    r_data.cache_indices.fill(-1);
+    for (const int curve_index : nurbs_mask) {
+      const BasisKey key{int(points_by_curve.size(curve_index)),
+                         int(evaluated_points_by_curve.size(curve_index)),
+                         orders[curve_index],
+                         cyclic[curve_index],
+                         knots_modes[curve_index]};
+      r_data.cache_indices[curve_index] = cache_index_by_key.lookup_or_add_cb(key, [&]() {
+        first_curves.append(curve_index);
+        return int(first_curves.size() - 1);
+      });
+    }
+
+    r_data.caches.clear();
+    r_data.caches.resize(first_curves.size());
+    threading::parallel_for(first_curves.index_range(), 64, [&](const IndexRange range) {
       Vector<float, 32> knots;
-      for (const int curve_index : nurbs_mask.slice(range)) {
+      for (const int cache_index : range) {
+        const int curve_index = first_curves[cache_index];
         const IndexRange points = points_by_curve[curve_index];
         const IndexRange evaluated_points = evaluated_points_by_curve[curve_index];
 
@@ -588,14 +628,18 @@ void CurvesGeometry::ensure_nurbs_basis_cache() const
         const KnotsMode mode = KnotsMode(knots_modes[curve_index]);
 
         if (!curves::nurbs::check_valid_num_and_order(points.size(), order, is_cyclic, mode)) {
-          r_data[curve_index].invalid = true;
+          r_data.caches[cache_index].invalid = true;
           continue;
         }
 
         knots.reinitialize(curves::nurbs::knots_num(points.size(), order, is_cyclic));
         curves::nurbs::calculate_knots(points.size(), mode, order, is_cyclic, knots);
-        curves::nurbs::calculate_basis_cache(
-            points.size(), evaluated_points.size(), order, is_cyclic, knots, r_data[curve_index]);
+        curves::nurbs::calculate_basis_cache(points.size(),
+                                             evaluated_points.size(),
+                                             order,
+                                             is_cyclic,
+                                             knots,
+                                             r_data.caches[cache_index]);
       }
     });
   });
@@ -629,7 +673,7 @@ Span<float3> CurvesGeometry::evaluated_positions() const
 
     const VArray<int8_t> nurbs_orders = this->nurbs_orders();
     const Span<float> nurbs_weights = this->nurbs_weights();
-    const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
+    const curves::nurbs::BasisCaches &nurbs_basis_cache = runtime.nurbs_basis_cache.data();
 
     threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
       for (const int curve_index : curves_range) {
@@ -747,7 +791,7 @@ static void evaluate_generic_data_for_curve(
     const VArray<bool> &cyclic,
     const VArray<int> &resolution,
     const Span<int> all_bezier_evaluated_offsets,
-    const Span<curves::nurbs::BasisCache> nurbs_basis_cache,
+    const curves::nurbs::BasisCaches &nurbs_basis_cache,
     const VArray<int8_t> &nurbs_orders,
     const Span<float> nurbs_weights,
     const GSpan src,
@@ -790,7 +834,7 @@ Span<float3> CurvesGeometry::evaluated_normals() const
     const VArray<int8_t> nurbs_orders = this->nurbs_orders();
     const Span<float> nurbs_weights = this->nurbs_weights();
     const Span<int> all_bezier_offsets = runtime.evaluated_offsets_cache.data().all_bezier_offsets;
-    const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
+    const curves::nurbs::BasisCaches &nurbs_basis_cache = runtime.nurbs_basis_cache.data();
 
     const Span<float3> evaluated_tangents = this->evaluated_tangents();
     const VArray<float> tilt = this->tilt();
@@ -887,7 +931,7 @@ void CurvesGeometry::interpolate_to_evaluated(const GSpan src, GMutableSpan dst)
   const VArray<int8_t> nurbs_orders = this->nurbs_orders();
   const Span<float> nurbs_weights = this->nurbs_weights();
   const Span<int> all_bezier_offsets = runtime.evaluated_offsets_cache.data().all_bezier_offsets;
-  const Span<curves::nurbs::BasisCache> nurbs_basis_cache = runtime.nurbs_basis_cache.data();
+  const curves::nurbs::BasisCaches &nurbs_basis_cache = runtime.nurbs_basis_cache.data();
 
   threading::parallel_for(this->curves_range(), 512, [&](IndexRange curves_range) {
     for (const int curve_index : curves_range) {
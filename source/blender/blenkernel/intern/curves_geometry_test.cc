@@ -405,6 +405,45 @@ TEST(curves_geometry, NURBSEvaluation)
   }
 }
 
+TEST(curves_geometry, NURBSSharedBasisEvaluation)
+{
+  /* The first and last curves share the same basis, the middle one has a different order. */
+  CurvesGeometry curves(12, 3);
+  curves.fill_curve_types(CURVE_TYPE_NURBS);
+  curves.resolution_for_write().fill(10);
+  curves.nurbs_orders_for_write()[1] = 3;
+  curves.offsets_for_write().copy_from({0, 4, 8, 12});
+
+  MutableSpan<float3> positions = curves.positions_for_write();
+  const float3 offset(2, 0, 0);
+  for (const int i : IndexRange(2)) {
+    positions[i * 4 + 0] = float3(1, 1, 0) + offset * float(i);
+    positions[i * 4 + 1] = float3(0, 1, 0) + offset * float(i);
+    positions[i * 4 + 2] = float3(0, 0, 0) + offset * float(i);
+    positions[i * 4 + 3] = float3(-1, 0, 0) + offset * float(i);
+  }
+  positions.slice(8, 4).copy_from(positions.slice(0, 4));
+  for (float3 &position : positions.slice(8, 4)) {
+    position += float3(0, 0, 1);
+  }
+
+  const OffsetIndices evaluated_points_by_curve = curves.evaluated_points_by_curve();
+  const Span<float3> evaluated_positions = curves.evaluated_positions();
+  const Span<float3> first = evaluated_positions.slice(evaluated_points_by_curve[0]);
+  const Span<float3> last = evaluated_positions.slice(evaluated_points_by_curve[2]);
+  ASSERT_EQ(first.size(), last.size());
+  EXPECT_V3_NEAR(first.first(), float3(0.166667, 0.833333, 0), 1e-5f);
+  EXPECT_V3_NEAR(first.last(), float3(-0.166667, 0.166667, 0), 1e-5f);
+  for (const int i : first.index_range()) {
+    EXPECT_V3_NEAR(last[i], first[i] + float3(0, 0, 1), 1e-5f);
+  }
+
+  /* An order of 3 evaluates a different curve between the same control points. */
+  const Span<float3> middle = evaluated_positions.slice(evaluated_points_by_curve[1]);
+  EXPECT_V3_NEAR(middle.first(), float3(0.5, 1, 0) + offset, 1e-5f);
+  EXPECT_V3_NEAR(middle.last(), float3(-0.5, 0, 0) + offset, 1e-5f);
+}
+
 TEST(curves_geometry, BezierGenericEvaluation)
 {
   CurvesGeometry curves(3, 1);
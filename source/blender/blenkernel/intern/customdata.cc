@@ -10,6 +10,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 /* Since we have versioning code here (CustomData_verify_versions()). */
 #define DNA_DEPRECATED_ALLOW
 
@@ -17,9 +19,11 @@
 #include "DNA_customdata_types.h"
 #include "DNA_meshdata_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_bitmap.h"
 #include "BLI_color.hh"
 #include "BLI_endian_switch.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_index_range.hh"
 #include "BLI_math.h"
 #include "BLI_math_color_blend.h"
@@ -59,6 +63,7 @@
 #include "data_transfer_intern.h"
 
 using blender::float2;
+using blender::ImplicitSharingInfo;
 using blender::IndexRange;
 using blender::Set;
 using blender::Span;
@@ -2195,6 +2200,155 @@ static bool customdata_typemap_is_valid(const CustomData *data)
 }
 #endif
 
+static void *copy_layer_data(const int type, const void *data, const int totelem)
+{
+  const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+  void *new_data = MEM_malloc_arrayN(size_t(totelem), typeInfo->size, layerType_getName(type));
+  if (typeInfo->copy) {
+    typeInfo->copy(data, new_data, totelem);
+  }
+  else {
+    memcpy(new_data, data, size_t(totelem) * typeInfo->size);
+  }
+  return new_data;
+}
+
+namespace {
+
+/**
+ * Memory that stores the data of multiple layers, see
+ * #CustomData_copy_layout_single_allocation. It is freed when the last layer stored in it is
+ * freed.
+ */
+struct CustomDataBlock {
+  std::atomic<int> users;
+
+  void remove_user_and_delete_if_last()
+  {
+    if (users.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      this->~CustomDataBlock();
+      MEM_freeN(this);
+    }
+  }
+};
+
+/**
+ * Owns the data of a layer once it is shared with #CD_SHARE. The layers that use the data only
+ * keep a user of the sharing info, the data itself is freed together with the last user.
+ *
+ * Layers allocated in a #CustomDataBlock always have a sharing info, which is stored in the
+ * block as well. Their data can't be taken over by a layer, it has to be copied instead.
+ */
+class CustomDataLayerSharingInfo : public ImplicitSharingInfo {
+ public:
+  void *data;
+  int type;
+  int totelem;
+  CustomDataBlock *block;
+
+  CustomDataLayerSharingInfo(void *data,
+                             const int type,
+                             const int totelem,
+                             CustomDataBlock *block = nullptr)
+      : ImplicitSharingInfo(1), data(data), type(type), totelem(totelem), block(block)
+  {
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    if (data != nullptr) {
+      const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+      if (typeInfo->free) {
+        typeInfo->free(data, totelem, typeInfo->size);
+      }
+      if (block == nullptr) {
+        MEM_freeN(data);
+      }
+    }
+    if (block != nullptr) {
+      CustomDataBlock *owner = block;
+      this->~CustomDataLayerSharingInfo();
+      owner->remove_user_and_delete_if_last();
+    }
+    else {
+      MEM_delete(this);
+    }
+  }
+};
+
+}  // namespace
+
+/**
+ * Get the sharing info of the layer, creating it when the layer owns its data exclusively so far.
+ * The source of a copy is not modified otherwise, but multiple threads may copy the same data
+ * concurrently, so the sharing info is published atomically.
+ */
+static const CustomDataLayerSharingInfo *layer_ensure_sharing_info(CustomDataLayer &layer,
+                                                                   const int totelem)
+{
+  if (layer.sharing_info == nullptr) {
+    CustomDataLayerSharingInfo *sharing_info = MEM_new<CustomDataLayerSharingInfo>(
+        __func__, layer.data, layer.type, totelem);
+    if (atomic_cas_ptr((void **)&layer.sharing_info, nullptr, sharing_info) != nullptr) {
+      /* Another thread created the sharing info first, the data is owned by that one. */
+      sharing_info->data = nullptr;
+      sharing_info->remove_user_and_delete_if_last();
+    }
+  }
+  return static_cast<const CustomDataLayerSharingInfo *>(layer.sharing_info);
+}
+
+/**
+ * Make the layer the exclusive owner of its data again, copying the data if it is still used by
+ * other layers or if it is stored in a #CustomDataBlock. Afterwards the data is a separate
+ * allocation that can be resized, freed or passed on.
+ */
+static void layer_ensure_data_is_owned(CustomDataLayer &layer)
+{
+  if (layer.sharing_info == nullptr) {
+    return;
+  }
+  CustomDataLayerSharingInfo *sharing_info = const_cast<CustomDataLayerSharingInfo *>(
+      static_cast<const CustomDataLayerSharingInfo *>(layer.sharing_info));
+  if (sharing_info->is_mutable() && sharing_info->block == nullptr) {
+    /* This layer is the last user, so it can take the data from the sharing info. */
+    sharing_info->data = nullptr;
+  }
+  else {
+    layer.data = copy_layer_data(layer.type, layer.data, sharing_info->totelem);
+  }
+  sharing_info->remove_user_and_delete_if_last();
+  layer.sharing_info = nullptr;
+}
+
+/**
+ * Make sure that the layer data can be modified, copying the data if it is still used by other
+ * layers.
+ */
+static void layer_ensure_data_is_mutable(CustomDataLayer &layer)
+{
+  if (layer.sharing_info == nullptr) {
+    return;
+  }
+  const CustomDataLayerSharingInfo *sharing_info =
+      static_cast<const CustomDataLayerSharingInfo *>(layer.sharing_info);
+  if (sharing_info->block != nullptr && sharing_info->is_mutable()) {
+    /* The data can be modified in place, it just can't be separated from its block. */
+    return;
+  }
+  layer_ensure_data_is_owned(layer);
+}
+
+void CustomData_ensure_layer_is_mutable(CustomDataLayer *layer, const int totelem)
+{
+  BLI_assert(layer->sharing_info == nullptr ||
+             static_cast<const CustomDataLayerSharingInfo *>(layer->sharing_info)->totelem ==
+                 totelem);
+  UNUSED_VARS_NDEBUG(totelem);
+  layer_ensure_data_is_owned(*layer);
+}
+
 bool CustomData_merge(const CustomData *source,
                       CustomData *dest,
                       eCustomDataMask mask,
@@ -2245,6 +2399,7 @@ bool CustomData_merge(const CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -2252,10 +2407,23 @@ bool CustomData_merge(const CustomData *source,
         break;
     }
 
+    const CustomDataLayerSharingInfo *sharing_info = nullptr;
     if ((alloctype == CD_ASSIGN) && (flag & CD_FLAG_NOFREE)) {
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if (alloctype == CD_SHARE) {
+      if ((flag & CD_FLAG_NOFREE) || data == nullptr || totelem == 0) {
+        /* Referenced data is not owned by the source, so it cannot be shared. */
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_DUPLICATE, data, totelem, layer->name);
+      }
+      else {
+        sharing_info = layer_ensure_sharing_info(*layer, totelem);
+        newlayer = customData_add_layer__internal(
+            dest, type, CD_SHARE, data, totelem, layer->name);
+      }
+    }
     else {
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
     }
@@ -2279,7 +2447,13 @@ bool CustomData_merge(const CustomData *source,
           layer->anonymous_id->user_add();
         }
       }
+      if (sharing_info != nullptr && newlayer->data == data) {
+        sharing_info->add_user();
+        newlayer->sharing_info = sharing_info;
+      }
       if (alloctype == CD_ASSIGN) {
+        newlayer->sharing_info = layer->sharing_info;
+        layer->sharing_info = nullptr;
         layer->data = nullptr;
       }
     }
@@ -2334,6 +2508,7 @@ void CustomData_realloc(CustomData *data, const int old_size, const int new_size
   for (int i = 0; i < data->totlayer; i++) {
     CustomDataLayer *layer = &data->layers[i];
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    layer_ensure_data_is_owned(*layer);
 
     const int64_t old_size_in_bytes = int64_t(old_size) * typeInfo->size;
     const int64_t new_size_in_bytes = int64_t(new_size) * typeInfo->size;
@@ -2377,6 +2552,54 @@ void CustomData_copy(const CustomData *source,
   CustomData_merge(source, dest, mask, alloctype, totelem);
 }
 
+void CustomData_copy_layout_single_allocation(const CustomData *source,
+                                              CustomData *dest,
+                                              const eCustomDataMask mask,
+                                              const int totelem)
+{
+  /* Add the layers without data first, so that the size of the block is known. */
+  CustomData_copy(source, dest, mask, CD_SET_DEFAULT, 0);
+  if (totelem == 0 || dest->totlayer == 0) {
+    return;
+  }
+
+  /* The block starts with the header and the sharing infos of all layers, followed by the data
+   * of every layer, each aligned to a cache line. */
+  const size_t data_alignment = 64;
+  const size_t infos_offset = ceil_to_multiple_ul(sizeof(CustomDataBlock),
+                                                  alignof(CustomDataLayerSharingInfo));
+  size_t block_size = ceil_to_multiple_ul(
+      infos_offset + sizeof(CustomDataLayerSharingInfo) * size_t(dest->totlayer), data_alignment);
+  blender::Array<size_t, 32> data_offsets(dest->totlayer);
+  for (const int i : IndexRange(dest->totlayer)) {
+    const LayerTypeInfo *typeInfo = layerType_getInfo(dest->layers[i].type);
+    data_offsets[i] = block_size;
+    block_size += ceil_to_multiple_ul(size_t(totelem) * typeInfo->size, data_alignment);
+  }
+
+  void *block_memory = MEM_mallocN_aligned(block_size, data_alignment, __func__);
+  CustomDataBlock *block = new (block_memory) CustomDataBlock();
+  block->users = dest->totlayer;
+
+  for (const int i : IndexRange(dest->totlayer)) {
+    CustomDataLayer &layer = dest->layers[i];
+    const LayerTypeInfo *typeInfo = layerType_getInfo(layer.type);
+    BLI_assert(layer.data == nullptr && layer.sharing_info == nullptr);
+    void *data = POINTER_OFFSET(block_memory, data_offsets[i]);
+    if (typeInfo->set_default_value) {
+      typeInfo->set_default_value(data, totelem);
+    }
+    else {
+      memset(data, 0, size_t(totelem) * typeInfo->size);
+    }
+    void *info_memory = POINTER_OFFSET(block_memory,
+                                       infos_offset + sizeof(CustomDataLayerSharingInfo) * i);
+    layer.data = data;
+    layer.sharing_info = new (info_memory)
+        CustomDataLayerSharingInfo(data, layer.type, totelem, block);
+  }
+}
+
 static void customData_free_layer__internal(CustomDataLayer *layer, const int totelem)
 {
   const LayerTypeInfo *typeInfo;
@@ -2385,7 +2608,12 @@ static void customData_free_layer__internal(CustomDataLayer *layer, const int to
     layer->anonymous_id->user_remove();
     layer->anonymous_id = nullptr;
   }
-  if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
+  if (layer->sharing_info != nullptr) {
+    /* The data is freed together with the last layer that uses it. */
+    layer->sharing_info->remove_user_and_delete_if_last();
+    layer->sharing_info = nullptr;
+  }
+  else if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
     typeInfo = layerType_getInfo(layer->type);
 
     if (typeInfo->free) {
@@ -2775,6 +3003,11 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
         flag |= CD_FLAG_NOFREE;
       }
       break;
+    case CD_SHARE:
+      /* The caller is responsible for adding a user to the sharing info of the data. */
+      BLI_assert(totelem > 0 && layerdata != nullptr);
+      newlayerdata = layerdata;
+      break;
     case CD_DUPLICATE:
       if (totelem > 0) {
         newlayerdata = MEM_malloc_arrayN(totelem, typeInfo->size, layerType_getName(type));
@@ -3027,6 +3260,7 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
   }
 
   CustomDataLayer *layer = &data->layers[layer_index];
+  layer_ensure_data_is_mutable(*layer);
 
   if (layer->flag & CD_FLAG_NOFREE) {
     /* MEM_dupallocN won't work in case of complex layers, like e.g.
@@ -3125,6 +3359,7 @@ void CustomData_copy_data_layer(const CustomData *source,
 {
   const LayerTypeInfo *typeInfo;
 
+  layer_ensure_data_is_mutable(dest->layers[dst_layer_index]);
   const void *src_data = source->layers[src_layer_index].data;
   void *dst_data = dest->layers[dst_layer_index].data;
 
@@ -3240,6 +3475,7 @@ void CustomData_free_elem(CustomData *data, const int index, const int count)
       const LayerTypeInfo *typeInfo = layerType_getInfo(data->layers[i].type);
 
       if (typeInfo->free) {
+        layer_ensure_data_is_mutable(data->layers[i]);
         size_t offset = size_t(index) * typeInfo->size;
 
         typeInfo->free(POINTER_OFFSET(data->layers[i].data, offset), count, typeInfo->size);
@@ -3304,6 +3540,7 @@ void CustomData_interp(const CustomData *source,
 
     /* if we found a matching layer, copy the data */
     if (dest->layers[dest_i].type == source->layers[src_i].type) {
+      layer_ensure_data_is_mutable(dest->layers[dest_i]);
       void *src_data = source->layers[src_i].data;
 
       for (int j = 0; j < count; j++) {
@@ -3339,6 +3576,7 @@ void CustomData_swap_corners(CustomData *data, const int index, const int *corne
     const LayerTypeInfo *typeInfo = layerType_getInfo(data->layers[i].type);
 
     if (typeInfo->swap) {
+      layer_ensure_data_is_mutable(data->layers[i]);
       const size_t offset = size_t(index) * typeInfo->size;
 
       typeInfo->swap(POINTER_OFFSET(data->layers[i].data, offset), corner_indices);
@@ -3359,6 +3597,7 @@ void CustomData_swap(CustomData *data, const int index_a, const int index_b)
     const size_t size = typeInfo->size;
     const size_t offset_a = size * index_a;
     const size_t offset_b = size * index_b;
+    layer_ensure_data_is_mutable(data->layers[i]);
 
     void *buff = size <= sizeof(buff_static) ? buff_static : MEM_mallocN(size, __func__);
     memcpy(buff, POINTER_OFFSET(data->layers[i].data, offset_a), size);
@@ -4169,6 +4408,7 @@ void CustomData_from_bmesh_block(const CustomData *source,
     /* if we found a matching layer, copy the data */
     if (dest->layers[dest_i].type == source->layers[src_i].type) {
       const LayerTypeInfo *typeInfo = layerType_getInfo(dest->layers[dest_i].type);
+      layer_ensure_data_is_mutable(dest->layers[dest_i]);
       int offset = source->layers[src_i].offset;
       const void *src_data = POINTER_OFFSET(src_block, offset);
       void *dst_data = POINTER_OFFSET(dest->layers[dest_i].data,
@@ -4213,6 +4453,8 @@ void CustomData_blend_write_prepare(CustomData &data,
       continue;
     }
     layers_to_write.append(layer);
+    /* The sharing info is run-time data. */
+    layers_to_write.last().sharing_info = nullptr;
   }
   data.totlayer = layers_to_write.size();
   data.maxlayer = data.totlayer;
@@ -5182,6 +5424,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, const int
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing_info = nullptr;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
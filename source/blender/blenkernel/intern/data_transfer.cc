@@ -38,6 +38,61 @@
 
 static CLG_LogRef LOG = {"bke.data_transfer"};
 
+/**
+ * Element mappings kept between evaluations of the same transfer. The mappings are only reused
+ * while the element counts and the mapping settings are unchanged, the positions of the elements
+ * are not compared.
+ */
+struct DataTransferRemapCache {
+  /** Everything the element mappings depend on, apart from the geometry itself. */
+  struct Key {
+    int data_types;
+    int map_modes[4];
+    int src_num[4];
+    int dst_num[4];
+    float max_distance;
+    float ray_radius;
+    float islands_handling_precision;
+    bool use_split_nors_dst;
+    float split_angle_dst;
+  } key;
+
+  MeshPairRemap maps[4];
+  bool maps_init[4];
+};
+
+DataTransferRemapCache *BKE_data_transfer_remap_cache_new(void)
+{
+  return MEM_cnew<DataTransferRemapCache>(__func__);
+}
+
+static void data_transfer_remap_cache_clear(DataTransferRemapCache *cache)
+{
+  for (int i = 0; i < 4; i++) {
+    BKE_mesh_remap_free(&cache->maps[i]);
+    cache->maps_init[i] = false;
+  }
+}
+
+void BKE_data_transfer_remap_cache_free(DataTransferRemapCache *cache)
+{
+  if (cache == nullptr) {
+    return;
+  }
+  data_transfer_remap_cache_clear(cache);
+  MEM_freeN(cache);
+}
+
+/** Free the cached mappings when they were computed with different counts or settings. */
+static void data_transfer_remap_cache_validate(DataTransferRemapCache *cache,
+                                               const DataTransferRemapCache::Key &key)
+{
+  if (memcmp(&cache->key, &key, sizeof(key)) != 0) {
+    data_transfer_remap_cache_clear(cache);
+    cache->key = key;
+  }
+}
+
 void BKE_object_data_transfer_dttypes_to_cdmask(const int dtdata_types,
                                                 CustomData_MeshMasks *r_data_masks)
 {
@@ -1210,6 +1265,7 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
                                  const float mix_factor,
                                  const char *vgroup_name,
                                  const bool invert_vgroup,
+                                 DataTransferRemapCache *remap_cache,
                                  ReportList *reports)
 {
 #define VDATA 0
@@ -1228,8 +1284,11 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
   int vg_idx = -1;
   float *weights[DATAMAX] = {nullptr};
 
-  MeshPairRemap geom_map[DATAMAX] = {{0}};
-  bool geom_map_init[DATAMAX] = {false};
+  MeshPairRemap geom_map_local[DATAMAX] = {{0}};
+  bool geom_map_init_local[DATAMAX] = {false};
+  /* Mappings computed here are kept for the next transfer when there is a cache. */
+  MeshPairRemap *geom_map = remap_cache ? remap_cache->maps : geom_map_local;
+  bool *geom_map_init = remap_cache ? remap_cache->maps_init : geom_map_init_local;
   ListBase lay_map = {nullptr};
   bool changed = false;
   bool is_modifier = false;
@@ -1288,6 +1347,31 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
         BKE_mesh_vert_positions(me_dst), me_dst->totvert, me_src, space_transform);
   }
 
+  if (remap_cache) {
+    /* Zero-initialize to make the padding of the key comparable. */
+    DataTransferRemapCache::Key key;
+    memset(&key, 0, sizeof(key));
+    key.data_types = data_types;
+    key.map_modes[VDATA] = map_vert_mode;
+    key.map_modes[EDATA] = map_edge_mode;
+    key.map_modes[LDATA] = map_loop_mode;
+    key.map_modes[PDATA] = map_poly_mode;
+    key.src_num[VDATA] = me_src->totvert;
+    key.src_num[EDATA] = me_src->totedge;
+    key.src_num[LDATA] = me_src->totloop;
+    key.src_num[PDATA] = me_src->totpoly;
+    key.dst_num[VDATA] = me_dst->totvert;
+    key.dst_num[EDATA] = me_dst->totedge;
+    key.dst_num[LDATA] = me_dst->totloop;
+    key.dst_num[PDATA] = me_dst->totpoly;
+    key.max_distance = max_distance;
+    key.ray_radius = ray_radius;
+    key.islands_handling_precision = islands_handling_precision;
+    key.use_split_nors_dst = (me_dst->flag & ME_AUTOSMOOTH) != 0;
+    key.split_angle_dst = me_dst->smoothresh;
+    data_transfer_remap_cache_validate(remap_cache, key);
+  }
+
   /* Check all possible data types.
    * Note item mappings and dest mix weights are cached. */
   for (int i = 0; i < DT_TYPE_MAX; i++) {
@@ -1668,7 +1752,9 @@ bool BKE_object_data_transfer_ex(struct Depsgraph *depsgraph,
   }
 
   for (int i = 0; i < DATAMAX; i++) {
-    BKE_mesh_remap_free(&geom_map[i]);
+    if (remap_cache == nullptr) {
+      BKE_mesh_remap_free(&geom_map[i]);
+    }
     MEM_SAFE_FREE(weights[i]);
   }
 
@@ -1726,5 +1812,6 @@ bool BKE_object_data_transfer_mesh(struct Depsgraph *depsgraph,
                                      mix_factor,
                                      vgroup_name,
                                      invert_vgroup,
+                                     nullptr,
                                      reports);
 }
@@ -844,6 +844,21 @@ static void surfaceGenerateGrid(DynamicPaintSurface *surface)
   }
 }
 
+/**
+ * Append the surface points of grid cell `c_index` to `points`, so brushes can process the
+ * points of all intersecting cells in a single parallel range.
+ */
+static void grid_cell_points_append(const VolumeGrid *grid,
+                                    const int c_index,
+                                    int *points,
+                                    int *points_num)
+{
+  memcpy(&points[*points_num],
+         &grid->t_index[grid->s_pos[c_index]],
+         sizeof(int) * size_t(grid->s_num[c_index]));
+  *points_num += grid->s_num[c_index];
+}
+
 /***************************** Freeing data ******************************/
 
 void dynamicPaint_freeBrush(DynamicPaintModifierData *pmd)
@@ -3911,7 +3926,8 @@ struct DynamicPaintPaintData {
   Object *brushOb;
   const Scene *scene;
   float timescale;
-  int c_index;
+  /** Surface points of all grid cells that intersect the brush. */
+  const int *points;
 
   Mesh *mesh;
   const float (*positions)[3];
@@ -3941,12 +3957,10 @@ static void dynamic_paint_paint_mesh_cell_point_cb_ex(void *__restrict userdata,
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
   const PaintBakeData *bData = sData->bData;
-  VolumeGrid *grid = bData->grid;
 
   const DynamicPaintBrushSettings *brush = data->brush;
 
   const float timescale = data->timescale;
-  const int c_index = data->c_index;
 
   const float(*positions)[3] = data->positions;
   const MLoop *mloop = data->mloop;
@@ -3957,7 +3971,7 @@ static void dynamic_paint_paint_mesh_cell_point_cb_ex(void *__restrict userdata,
 
   BVHTreeFromMesh *treeData = static_cast<BVHTreeFromMesh *>(data->treeData);
 
-  const int index = grid->t_index[grid->s_pos[c_index] + id];
+  const int index = data->points[id];
   const int samples = bData->s_num[index];
   int ss;
   float total_sample = float(samples);
@@ -4333,43 +4347,44 @@ static bool dynamicPaint_paintMesh(Depsgraph *depsgraph,
     if (grid && meshBrush_boundsIntersect(&grid->grid_bounds, &mesh_bb, brush, brush_radius)) {
       /* Build a bvh tree from transformed vertices */
       if (BKE_bvhtree_from_mesh_get(&treeData, mesh, BVHTREE_FROM_LOOPTRI, 4)) {
-        int c_index;
         int total_cells = grid->dim[0] * grid->dim[1] * grid->dim[2];
+        int *points = static_cast<int *>(
+            MEM_malloc_arrayN(sData->total_points, sizeof(int), "dp brush points"));
+        int points_num = 0;
 
         /* loop through space partitioning grid */
-        for (c_index = 0; c_index < total_cells; c_index++) {
+        for (int c_index = 0; c_index < total_cells; c_index++) {
           /* check grid cell bounding box */
-          if (!grid->s_num[c_index] ||
-              !meshBrush_boundsIntersect(&grid->bounds[c_index], &mesh_bb, brush, brush_radius)) {
-            continue;
+          if (grid->s_num[c_index] &&
+              meshBrush_boundsIntersect(&grid->bounds[c_index], &mesh_bb, brush, brush_radius)) {
+            grid_cell_points_append(grid, c_index, points, &points_num);
           }
+        }
 
-          /* loop through cell points and process brush */
-          DynamicPaintPaintData data{};
-          data.surface = surface;
-          data.brush = brush;
-          data.brushOb = brushOb;
-          data.scene = scene;
-          data.timescale = timescale;
-          data.c_index = c_index;
-          data.mesh = mesh;
-          data.positions = positions;
-          data.mloop = mloop;
-          data.mlooptri = mlooptri;
-          data.brush_radius = brush_radius;
-          data.avg_brushNor = avg_brushNor;
-          data.brushVelocity = brushVelocity;
-          data.treeData = &treeData;
+        /* loop through points of all intersecting cells and process brush */
+        DynamicPaintPaintData data{};
+        data.surface = surface;
+        data.brush = brush;
+        data.brushOb = brushOb;
+        data.scene = scene;
+        data.timescale = timescale;
+        data.points = points;
+        data.mesh = mesh;
+        data.positions = positions;
+        data.mloop = mloop;
+        data.mlooptri = mlooptri;
+        data.brush_radius = brush_radius;
+        data.avg_brushNor = avg_brushNor;
+        data.brushVelocity = brushVelocity;
+        data.treeData = &treeData;
 
-          TaskParallelSettings settings;
-          BLI_parallel_range_settings_defaults(&settings);
-          settings.use_threading = (grid->s_num[c_index] > 250);
-          BLI_task_parallel_range(0,
-                                  grid->s_num[c_index],
-                                  &data,
-                                  dynamic_paint_paint_mesh_cell_point_cb_ex,
-                                  &settings);
-        }
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (points_num > 250);
+        BLI_task_parallel_range(
+            0, points_num, &data, dynamic_paint_paint_mesh_cell_point_cb_ex, &settings);
+
+        MEM_freeN(points);
       }
     }
     /* free bvh tree */
@@ -4396,14 +4411,12 @@ static void dynamic_paint_paint_particle_cell_point_cb_ex(
   const DynamicPaintSurface *surface = data->surface;
   const PaintSurfaceData *sData = surface->data;
   const PaintBakeData *bData = sData->bData;
-  VolumeGrid *grid = bData->grid;
 
   const DynamicPaintBrushSettings *brush = data->brush;
 
   const ParticleSystem *psys = data->psys;
 
   const float timescale = data->timescale;
-  const int c_index = data->c_index;
 
   KDTree_3d *tree = static_cast<KDTree_3d *>(data->treeData);
 
@@ -4412,7 +4425,7 @@ static void dynamic_paint_paint_particle_cell_point_cb_ex(
   const float range = solidradius + smooth;
   const float particle_timestep = 0.04f * psys->part->timetweak;
 
-  const int index = grid->t_index[grid->s_pos[c_index] + id];
+  const int index = data->points[id];
   float disp_intersect = 0.0f;
   float radius = 0.0f;
   float strength = 0.0f;
@@ -4636,38 +4649,39 @@ static bool dynamicPaint_paintParticles(DynamicPaintSurface *surface,
 
   /* only continue if particle bb is close enough to canvas bb */
   if (boundsIntersectDist(&grid->grid_bounds, &part_bb, range)) {
-    int c_index;
     int total_cells = grid->dim[0] * grid->dim[1] * grid->dim[2];
+    int *points = static_cast<int *>(
+        MEM_malloc_arrayN(sData->total_points, sizeof(int), "dp particle points"));
+    int points_num = 0;
 
     /* balance tree */
     BLI_kdtree_3d_balance(tree);
 
     /* loop through space partitioning grid */
-    for (c_index = 0; c_index < total_cells; c_index++) {
+    for (int c_index = 0; c_index < total_cells; c_index++) {
       /* check cell bounding box */
-      if (!grid->s_num[c_index] || !boundsIntersectDist(&grid->bounds[c_index], &part_bb, range)) {
-        continue;
+      if (grid->s_num[c_index] && boundsIntersectDist(&grid->bounds[c_index], &part_bb, range)) {
+        grid_cell_points_append(grid, c_index, points, &points_num);
       }
+    }
 
-      /* loop through cell points */
-      DynamicPaintPaintData data{};
-      data.surface = surface;
-      data.brush = brush;
-      data.psys = psys;
-      data.solidradius = solidradius;
-      data.timescale = timescale;
-      data.c_index = c_index;
-      data.treeData = tree;
+    /* loop through points of all intersecting cells */
+    DynamicPaintPaintData data{};
+    data.surface = surface;
+    data.brush = brush;
+    data.psys = psys;
+    data.solidradius = solidradius;
+    data.timescale = timescale;
+    data.points = points;
+    data.treeData = tree;
 
-      TaskParallelSettings settings;
-      BLI_parallel_range_settings_defaults(&settings);
-      settings.use_threading = (grid->s_num[c_index] > 250);
-      BLI_task_parallel_range(0,
-                              grid->s_num[c_index],
-                              &data,
-                              dynamic_paint_paint_particle_cell_point_cb_ex,
-                              &settings);
-    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (points_num > 250);
+    BLI_task_parallel_range(
+        0, points_num, &data, dynamic_paint_paint_particle_cell_point_cb_ex, &settings);
+
+    MEM_freeN(points);
   }
   BLI_kdtree_3d_free(tree);
 
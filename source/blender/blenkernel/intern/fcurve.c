@@ -41,6 +41,8 @@
 
 #include "CLG_log.h"
 
+#include "atomic_ops.h"
+
 #define SMALL -1.0e-10
 #define SELECT 1
 
@@ -1899,9 +1901,7 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
   /* Evaltime occurs somewhere in the middle of the curve. */
   bool exact = false;
 
-  /* Use binary search to find appropriate keyframes...
-   *
-   * The threshold here has the following constraints:
+  /* The threshold for the keyframe search has the following constraints:
    * - 0.001 is too coarse:
    *   We get artifacts with 2cm driver movements at 1BU = 1m (see T40332).
    *
@@ -1909,7 +1909,29 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
    *   Weird errors, like selecting the wrong keyframe range (see T39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  const float threshold = 0.0001f;
+
+  /* During playback, evaltime is usually in the same segment as in the last evaluation or in the
+   * next one. When it is clearly inside of one of them, the binary search would return the end of
+   * that segment, so it can be skipped. Evaltime close to a keyframe still uses the search. */
+  int32_t *segment_hint = &((FCurve *)fcu)->segment_hint;
+  const int hint = atomic_load_int32(segment_hint);
+  int segment = -1;
+  for (int i = hint; i <= hint + 1; i++) {
+    if (i >= 1 && i < (int)fcu->totvert && evaltime - bezts[i - 1].vec[1][0] > threshold &&
+        bezts[i].vec[1][0] - evaltime > threshold) {
+      segment = i;
+      break;
+    }
+  }
+  if (segment == -1) {
+    segment = BKE_fcurve_bezt_binarysearch_index_ex(
+        bezts, evaltime, fcu->totvert, threshold, &exact);
+  }
+  if (segment != hint) {
+    atomic_store_int32(segment_hint, segment);
+  }
+  a = (uint)segment;
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -12,7 +12,9 @@
 #include "DNA_object_types.h"
 
 #include "BLI_alloca.h"
+#include "BLI_dynstr.h"
 #include "BLI_expr_pylike_eval.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_string_utils.h"
@@ -690,6 +692,110 @@ static const DriverVarTypeInfo *get_dvar_typeinfo(int type)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Shared Simple Expressions
+ *
+ * Rigs often contain thousands of drivers with the same expression and variable names, e.g.
+ * correctives that are mirrored or generated by scripts. Their compiled programs are identical,
+ * so drivers share them instead of each keeping its own copy. The programs are reference counted
+ * and only freed when the last driver using them is freed.
+ * \{ */
+
+typedef struct SharedSimpleExpr {
+  /** Expression and parameter names, see #simple_expr_key. */
+  char *key;
+  ExprPyLike_Parsed *expr;
+  int users;
+} SharedSimpleExpr;
+
+static ThreadMutex shared_simple_expr_lock = BLI_MUTEX_INITIALIZER;
+/** #SharedSimpleExpr by key, the entries are owned by #shared_simple_expr_by_expr. */
+static GHash *shared_simple_expr_by_key = NULL;
+/** #SharedSimpleExpr by compiled program. */
+static GHash *shared_simple_expr_by_expr = NULL;
+
+static char *simple_expr_key(const char *expression, const char **names, int names_len)
+{
+  DynStr *ds = BLI_dynstr_new();
+  /* Variable names are identifiers, but the expression can contain anything. Prefix it with its
+   * length so that the key is unambiguous. */
+  BLI_dynstr_appendf(ds, "%d:%s", (int)strlen(expression), expression);
+  for (int i = 0; i < names_len; i++) {
+    BLI_dynstr_appendf(ds, " %s", names[i]);
+  }
+  char *key = BLI_dynstr_get_cstring(ds);
+  BLI_dynstr_free(ds);
+  return key;
+}
+
+/**
+ * Get the compiled program for the expression, parsing it only if no other driver uses the same
+ * expression with the same parameter names yet. Release with #simple_expr_release.
+ */
+static ExprPyLike_Parsed *simple_expr_parse_shared(const char *expression,
+                                                   const char **names,
+                                                   int names_len)
+{
+  char *key = simple_expr_key(expression, names, names_len);
+
+  BLI_mutex_lock(&shared_simple_expr_lock);
+
+  if (shared_simple_expr_by_key == NULL) {
+    shared_simple_expr_by_key = BLI_ghash_str_new(__func__);
+    shared_simple_expr_by_expr = BLI_ghash_ptr_new(__func__);
+  }
+
+  SharedSimpleExpr *shared = BLI_ghash_lookup(shared_simple_expr_by_key, key);
+  if (shared != NULL) {
+    MEM_freeN(key);
+  }
+  else {
+    shared = MEM_callocN(sizeof(*shared), __func__);
+    shared->key = key;
+    shared->expr = BLI_expr_pylike_parse(expression, names, names_len);
+    BLI_ghash_insert(shared_simple_expr_by_key, shared->key, shared);
+    BLI_ghash_insert(shared_simple_expr_by_expr, shared->expr, shared);
+  }
+  shared->users++;
+
+  BLI_mutex_unlock(&shared_simple_expr_lock);
+
+  return shared->expr;
+}
+
+static void simple_expr_release(ExprPyLike_Parsed *expr)
+{
+  if (expr == NULL) {
+    return;
+  }
+
+  BLI_mutex_lock(&shared_simple_expr_lock);
+
+  SharedSimpleExpr *shared = BLI_ghash_lookup(shared_simple_expr_by_expr, expr);
+  BLI_assert(shared != NULL && shared->users > 0);
+
+  if (--shared->users == 0) {
+    BLI_ghash_remove(shared_simple_expr_by_key, shared->key, NULL, NULL);
+    BLI_ghash_remove(shared_simple_expr_by_expr, shared->expr, NULL, NULL);
+    BLI_expr_pylike_free(shared->expr);
+    MEM_freeN(shared->key);
+    MEM_freeN(shared);
+
+    /* Don't keep the maps around when no driver uses simple expressions anymore, so nothing is
+     * left to free on exit. */
+    if (BLI_ghash_len(shared_simple_expr_by_expr) == 0) {
+      BLI_ghash_free(shared_simple_expr_by_key, NULL, NULL);
+      BLI_ghash_free(shared_simple_expr_by_expr, NULL, NULL);
+      shared_simple_expr_by_key = NULL;
+      shared_simple_expr_by_expr = NULL;
+    }
+  }
+
+  BLI_mutex_unlock(&shared_simple_expr_lock);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Driver API
  * \{ */
@@ -904,7 +1010,7 @@ void fcurve_free_driver(FCurve *fcu)
   }
 #endif
 
-  BLI_expr_pylike_free(driver->expr_simple);
+  simple_expr_release(driver->expr_simple);
 
   /* Free driver itself, then set F-Curve's point to this to NULL
    * (as the curve may still be used). */
@@ -963,7 +1069,7 @@ static ExprPyLike_Parsed *driver_compile_simple_expr_impl(ChannelDriver *driver)
     names[i++] = dvar->name;
   }
 
-  return BLI_expr_pylike_parse(driver->expression, names, names_len + VAR_INDEX_CUSTOM);
+  return simple_expr_parse_shared(driver->expression, names, names_len + VAR_INDEX_CUSTOM);
 }
 
 static bool driver_check_simple_expr_depends_on_time(ExprPyLike_Parsed *expr)
@@ -1027,14 +1133,14 @@ static bool driver_compile_simple_expr(ChannelDriver *driver)
     return false;
   }
 
-  /* It's safe to parse in multiple threads; at worst it'll
-   * waste some effort, but in return avoids mutex contention. */
+  /* It's safe to compile in multiple threads; the program is looked up in or added to the
+   * shared programs, and the store below keeps whichever reference was published first. */
   ExprPyLike_Parsed *expr = driver_compile_simple_expr_impl(driver);
 
-  /* Store the result if the field is still NULL, or discard
+  /* Store the result if the field is still NULL, or release
    * it if another thread got here first. */
   if (atomic_cas_ptr((void **)&driver->expr_simple, NULL, expr) != NULL) {
-    BLI_expr_pylike_free(expr);
+    simple_expr_release(expr);
   }
 
   return true;
@@ -1100,7 +1206,7 @@ void BKE_driver_invalidate_expression(ChannelDriver *driver,
                                       bool varname_changed)
 {
   if (expr_changed || varname_changed) {
-    BLI_expr_pylike_free(driver->expr_simple);
+    simple_expr_release(driver->expr_simple);
     driver->expr_simple = NULL;
   }
 
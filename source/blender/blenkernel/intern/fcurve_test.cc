@@ -4,6 +4,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_math_base.h"
+
 #include "BKE_fcurve.h"
 
 #include "ED_keyframing.h"
@@ -78,6 +80,41 @@ TEST(evaluate_fcurve, InterpolationLinear)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  for (int i = 0; i < 10; i++) {
+    insert_vert_fcurve(fcu, float(i), float(i * i), BEZT_KEYTYPE_KEYFRAME, INSERTKEY_NO_USERPREF);
+    fcu->bezt[i].ipo = BEZT_IPO_LIN;
+  }
+  auto expected_value = [](const float frame) {
+    const float start = floorf(frame);
+    return interpf((start + 1.0f) * (start + 1.0f), start * start, frame - start);
+  };
+
+  /* Forward playback, the segment from the last evaluation is used as hint. */
+  for (float frame = 0.25f; frame < 9.0f; frame += 0.5f) {
+    EXPECT_NEAR(evaluate_fcurve(fcu, frame), expected_value(frame), 1e-5f);
+  }
+  /* Backward playback and jumps. */
+  for (float frame = 8.75f; frame > 0.0f; frame -= 0.5f) {
+    EXPECT_NEAR(evaluate_fcurve(fcu, frame), expected_value(frame), 1e-5f);
+  }
+  EXPECT_NEAR(evaluate_fcurve(fcu, 7.5f), expected_value(7.5f), 1e-5f);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 1.5f), expected_value(1.5f), 1e-5f);
+
+  /* Keys close to the evaluated time are still found. */
+  EXPECT_NEAR(evaluate_fcurve(fcu, 2.00008f), 4.0f, EPSILON);
+  EXPECT_NEAR(evaluate_fcurve(fcu, 2.99992f), 9.0f, EPSILON);
+
+  /* A hint that is out of range is ignored. */
+  fcu->segment_hint = 100;
+  EXPECT_NEAR(evaluate_fcurve(fcu, 4.5f), expected_value(4.5f), 1e-5f);
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(evaluate_fcurve, InterpolationBezier)
 {
   FCurve *fcu = BKE_fcurve_create();
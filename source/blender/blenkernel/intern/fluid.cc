@@ -320,6 +320,11 @@ void BKE_fluid_cache_free(FluidDomainSettings *fds, Object *ob, int cache_map)
   int flags = fds->cache_flag;
   const char *relbase = BKE_modifier_path_relbase_from_global(ob);
 
+  /* Don't keep cache files open while they are deleted. */
+  if (fds->fluid) {
+    manta_cancel_prefetch(fds->fluid);
+  }
+
   if (cache_map & FLUID_DOMAIN_OUTDATED_DATA) {
     flags &= ~(FLUID_DOMAIN_BAKING_DATA | FLUID_DOMAIN_BAKED_DATA | FLUID_DOMAIN_OUTDATED_DATA);
     BLI_path_join(temp_dir, sizeof(temp_dir), fds->cache_directory, FLUID_DOMAIN_DIR_CONFIG);
@@ -3993,6 +3998,13 @@ static void fluid_modifier_processDomain(FluidModifierData *fmd,
       read_all = !read_partial && with_resumable_cache;
       has_data = manta_read_data(fds->fluid, fmd, data_frame, read_all);
     }
+
+    /* When playing back a baked cache, start reading the files of the next frames in the
+     * background so that loading them does not have to wait for the disk. */
+    if (has_data && !baking_data && !baking_noise && !baking_mesh && !baking_particles &&
+        !baking_guide) {
+      manta_prefetch_cache(fds->fluid, fmd, data_frame);
+    }
   }
 
   /* Cache mode specific settings */
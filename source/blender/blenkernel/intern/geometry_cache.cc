@@ -0,0 +1,625 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <sstream>
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_endian_defines.h"
+#include "BLI_fileops.h"
+#include "BLI_mmap.h"
+#include "BLI_serialize.hh"
+#include "BLI_task.hh"
+
+#include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_attribute.hh"
+#include "BKE_blender_version.h"
+#include "BKE_curves.hh"
+#include "BKE_customdata.h"
+#include "BKE_lib_id.h"
+#include "BKE_geometry_cache.hh"
+#include "BKE_mesh.h"
+#include "BKE_pointcloud.h"
+
+namespace blender::bke {
+
+using namespace io::serialize;
+
+static constexpr char file_magic[8] = {'B', 'L', 'E', 'N', 'D', 'G', 'E', 'O'};
+
+/** Alignment of the arrays in the file, relative to the start of the file. */
+static constexpr int64_t array_alignment = 64;
+
+/** The fixed size start of a geometry cache file, followed by the JSON metadata. */
+struct FileHeader {
+  char magic[8];
+  /** #ENDIAN_ORDER of the writer, a single byte so that it can be read on any platform. */
+  uint8_t endian;
+  uint8_t _pad[3];
+  /** #BLENDER_VERSION of the writer, arrays of DNA structs are stored in its layout. */
+  int32_t blender_version;
+  int64_t metadata_size;
+};
+static_assert(sizeof(FileHeader) == 24, "The header is part of the file format");
+
+static int64_t align_size(const int64_t size)
+{
+  return (size + array_alignment - 1) / array_alignment * array_alignment;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Writing
+ * \{ */
+
+/** The arrays written after the metadata, and their offsets relative to the first array. */
+class ArraysWriter {
+  Vector<Span<char>> arrays_;
+  Vector<int64_t> offsets_;
+  /** Copies of attributes that are not stored as arrays in the geometry. */
+  Vector<std::unique_ptr<GVArraySpan>> owned_spans_;
+  int64_t size_ = 0;
+
+ public:
+  /** Add an array and return the description of its position in the file for the metadata. */
+  std::shared_ptr<DictionaryValue> add(const Span<char> data)
+  {
+    size_ = align_size(size_);
+    std::shared_ptr<DictionaryValue> value = std::make_shared<DictionaryValue>();
+    value->elements().append_as(std::pair("offset", new IntValue(size_)));
+    value->elements().append_as(std::pair("size", new IntValue(data.size())));
+    arrays_.append(data);
+    offsets_.append(size_);
+    size_ += data.size();
+    return value;
+  }
+
+  std::shared_ptr<DictionaryValue> add_varray(GVArray varray)
+  {
+    std::unique_ptr<GVArraySpan> span = std::make_unique<GVArraySpan>(std::move(varray));
+    const Span<char> data(static_cast<const char *>(span->data()),
+                          span->size() * span->type().size());
+    owned_spans_.append(std::move(span));
+    return this->add(data);
+  }
+
+  void write(const FunctionRef<void(Span<char>)> write_fn) const
+  {
+    static const char padding[array_alignment] = {0};
+    int64_t written_size = 0;
+    for (const int64_t i : arrays_.index_range()) {
+      write_fn(Span<char>(padding, offsets_[i] - written_size));
+      write_fn(arrays_[i]);
+      written_size = offsets_[i] + arrays_[i].size();
+    }
+  }
+};
+
+static void append_int(DictionaryValue &dict, const char *key, const int64_t value)
+{
+  dict.elements().append_as(std::pair(key, new IntValue(value)));
+}
+
+static std::shared_ptr<ArrayValue> serialize_attributes(const AttributeAccessor &attributes,
+                                                        ArraysWriter &arrays)
+{
+  std::shared_ptr<ArrayValue> attributes_value = std::make_shared<ArrayValue>();
+  attributes.for_all([&](const AttributeIDRef &attribute_id, const AttributeMetaData &meta_data) {
+    if (attribute_id.is_anonymous()) {
+      return true;
+    }
+    if (custom_data_type_to_cpp_type(meta_data.data_type) == nullptr) {
+      return true;
+    }
+    std::shared_ptr<DictionaryValue> value = std::make_shared<DictionaryValue>();
+    value->elements().append_as(std::pair("name", new StringValue(attribute_id.name())));
+    append_int(*value, "domain", meta_data.domain);
+    append_int(*value, "type", meta_data.data_type);
+    GVArray varray = attributes.lookup(attribute_id).varray;
+    value->elements().append_as(std::pair("data", arrays.add_varray(std::move(varray))));
+    attributes_value->elements().append(value);
+    return true;
+  });
+  return attributes_value;
+}
+
+static std::shared_ptr<DictionaryValue> serialize_mesh(const Mesh &mesh, ArraysWriter &arrays)
+{
+  std::shared_ptr<DictionaryValue> value = std::make_shared<DictionaryValue>();
+  value->elements().append_as(std::pair("type", new StringValue("mesh")));
+  append_int(*value, "verts_num", mesh.totvert);
+  append_int(*value, "edges_num", mesh.totedge);
+  append_int(*value, "polys_num", mesh.totpoly);
+  append_int(*value, "loops_num", mesh.totloop);
+  value->elements().append_as(std::pair("edges", arrays.add(mesh.edges().cast<char>())));
+  value->elements().append_as(std::pair("polys", arrays.add(mesh.polys().cast<char>())));
+  value->elements().append_as(std::pair("loops", arrays.add(mesh.loops().cast<char>())));
+  value->elements().append_as(
+      std::pair("attributes", serialize_attributes(mesh.attributes(), arrays)));
+  return value;
+}
+
+static std::shared_ptr<DictionaryValue> serialize_pointcloud(const PointCloud &pointcloud,
+                                                             ArraysWriter &arrays)
+{
+  std::shared_ptr<DictionaryValue> value = std::make_shared<DictionaryValue>();
+  value->elements().append_as(std::pair("type", new StringValue("pointcloud")));
+  append_int(*value, "points_num", pointcloud.totpoint);
+  value->elements().append_as(
+      std::pair("attributes", serialize_attributes(pointcloud.attributes(), arrays)));
+  return value;
+}
+
+static std::shared_ptr<DictionaryValue> serialize_curves(const Curves &curves_id,
+                                                         ArraysWriter &arrays)
+{
+  const CurvesGeometry &curves = curves_id.geometry.wrap();
+  std::shared_ptr<DictionaryValue> value = std::make_shared<DictionaryValue>();
+  value->elements().append_as(std::pair("type", new StringValue("curves")));
+  append_int(*value, "points_num", curves.points_num());
+  append_int(*value, "curves_num", curves.curves_num());
+  value->elements().append_as(std::pair("offsets", arrays.add(curves.offsets().cast<char>())));
+  value->elements().append_as(
+      std::pair("attributes", serialize_attributes(curves.attributes(), arrays)));
+  return value;
+}
+
+void geometry_cache_serialize(const GeometrySet &geometry,
+                              const FunctionRef<void(Span<char>)> write_fn)
+{
+  ArraysWriter arrays;
+  DictionaryValue metadata;
+  std::shared_ptr<ArrayValue> components = std::make_shared<ArrayValue>();
+  if (const Mesh *mesh = geometry.get_mesh_for_read()) {
+    components->elements().append(serialize_mesh(*mesh, arrays));
+  }
+  if (const PointCloud *pointcloud = geometry.get_pointcloud_for_read()) {
+    components->elements().append(serialize_pointcloud(*pointcloud, arrays));
+  }
+  if (const Curves *curves = geometry.get_curves_for_read()) {
+    components->elements().append(serialize_curves(*curves, arrays));
+  }
+  metadata.elements().append_as(std::pair("components", components));
+
+  std::stringstream stream;
+  JsonFormatter formatter;
+  formatter.serialize(stream, metadata);
+  const std::string metadata_str = stream.str();
+
+  FileHeader header{};
+  memcpy(header.magic, file_magic, sizeof(file_magic));
+  header.endian = ENDIAN_ORDER;
+  header.blender_version = BLENDER_VERSION;
+  header.metadata_size = int64_t(metadata_str.size());
+  write_fn(Span<char>(reinterpret_cast<const char *>(&header), sizeof(header)));
+  write_fn(Span<char>(metadata_str.data(), int64_t(metadata_str.size())));
+
+  static const char padding[array_alignment] = {0};
+  const int64_t start_size = sizeof(header) + header.metadata_size;
+  write_fn(Span<char>(padding, align_size(start_size) - start_size));
+  arrays.write(write_fn);
+}
+
+bool geometry_cache_write(const GeometrySet &geometry, const char *filepath, std::string &r_error)
+{
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    r_error = "Failed to open file for writing";
+    return false;
+  }
+  bool success = true;
+  geometry_cache_serialize(geometry, [&](const Span<char> data) {
+    if (success && !data.is_empty() &&
+        fwrite(data.data(), 1, size_t(data.size()), file) != size_t(data.size())) {
+      success = false;
+    }
+  });
+  if (fclose(file) != 0) {
+    success = false;
+  }
+  if (!success) {
+    r_error = "Failed to write file";
+  }
+  return success;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Reading
+ * \{ */
+
+class CacheReader {
+  Span<char> arrays_;
+
+ public:
+  std::string error;
+
+  CacheReader(const Span<char> arrays) : arrays_(arrays)
+  {
+  }
+
+  bool get_int(const DictionaryValue::Lookup &lookup, const char *key, int &r_value)
+  {
+    const std::shared_ptr<Value> *value = lookup.lookup_ptr(key);
+    if (value == nullptr || (*value)->type() != eValueType::Int) {
+      error = std::string("Missing value \"") + key + "\"";
+      return false;
+    }
+    const int64_t int_value = (*value)->as_int_value()->value();
+    if (int_value < 0 || int_value > INT32_MAX) {
+      error = std::string("Invalid value \"") + key + "\"";
+      return false;
+    }
+    r_value = int(int_value);
+    return true;
+  }
+
+  /** Find the array described by `value`, which must have the expected size. */
+  bool get_array(const Value *value, const int64_t expected_size, Span<char> &r_data)
+  {
+    if (value == nullptr || value->type() != eValueType::Dictionary) {
+      error = "Missing array";
+      return false;
+    }
+    const DictionaryValue::Lookup lookup = value->as_dictionary_value()->create_lookup();
+    const std::shared_ptr<Value> *offset = lookup.lookup_ptr("offset");
+    const std::shared_ptr<Value> *size = lookup.lookup_ptr("size");
+    if (offset == nullptr || size == nullptr || (*offset)->type() != eValueType::Int ||
+        (*size)->type() != eValueType::Int) {
+      error = "Invalid array";
+      return false;
+    }
+    const int64_t offset_value = (*offset)->as_int_value()->value();
+    const int64_t size_value = (*size)->as_int_value()->value();
+    if (size_value != expected_size || offset_value < 0 ||
+        offset_value > arrays_.size() - size_value) {
+      error = "Array size mismatch, the file may be truncated";
+      return false;
+    }
+    r_data = arrays_.slice(offset_value, size_value);
+    return true;
+  }
+
+  bool get_array(const DictionaryValue::Lookup &lookup,
+                 const char *key,
+                 const int64_t expected_size,
+                 Span<char> &r_data)
+  {
+    const std::shared_ptr<Value> *value = lookup.lookup_ptr(key);
+    return this->get_array(value ? value->get() : nullptr, expected_size, r_data);
+  }
+
+  bool read_attributes(const DictionaryValue::Lookup &lookup, MutableAttributeAccessor attributes)
+  {
+    const std::shared_ptr<Value> *attributes_value = lookup.lookup_ptr("attributes");
+    if (attributes_value == nullptr || (*attributes_value)->type() != eValueType::Array) {
+      error = "Missing attributes";
+      return false;
+    }
+
+    /* Create all attributes first, then copy their data in parallel. */
+    Vector<GSpanAttributeWriter> writers;
+    Vector<Span<char>> sources;
+    bool success = true;
+    for (const ArrayValue::Item &item : (*attributes_value)->as_array_value()->elements()) {
+      if (item->type() != eValueType::Dictionary) {
+        error = "Invalid attribute";
+        success = false;
+        break;
+      }
+      const DictionaryValue::Lookup attribute = item->as_dictionary_value()->create_lookup();
+      const std::shared_ptr<Value> *name = attribute.lookup_ptr("name");
+      int domain, type;
+      if (name == nullptr || (*name)->type() != eValueType::String ||
+          !this->get_int(attribute, "domain", domain) || !this->get_int(attribute, "type", type)) {
+        error = "Invalid attribute";
+        success = false;
+        break;
+      }
+      const std::string &attribute_name = (*name)->as_string_value()->value();
+      const CPPType *cpp_type = custom_data_type_to_cpp_type(eCustomDataType(type));
+      if (cpp_type == nullptr || domain >= ATTR_DOMAIN_NUM ||
+          !attributes.domain_supported(eAttrDomain(domain))) {
+        error = "Unsupported attribute \"" + attribute_name + "\"";
+        success = false;
+        break;
+      }
+      Span<char> data;
+      const int64_t size = int64_t(attributes.domain_size(eAttrDomain(domain))) *
+                           cpp_type->size();
+      if (!this->get_array(attribute, "data", size, data)) {
+        success = false;
+        break;
+      }
+      GSpanAttributeWriter writer = attributes.lookup_or_add_for_write_only_span(
+          attribute_name, eAttrDomain(domain), eCustomDataType(type));
+      if (!writer) {
+        if (attributes.is_builtin(attribute_name)) {
+          /* Read-only built-in attributes like face normals are derived from other data. */
+          continue;
+        }
+        error = "Failed to create attribute \"" + attribute_name + "\"";
+        success = false;
+        break;
+      }
+      writers.append(std::move(writer));
+      sources.append(data);
+    }
+
+    threading::parallel_for(writers.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        memcpy(writers[i].span.data(), sources[i].data(), size_t(sources[i].size()));
+      }
+    });
+    for (GSpanAttributeWriter &writer : writers) {
+      writer.finish();
+    }
+    return success;
+  }
+
+  Mesh *read_mesh(const DictionaryValue::Lookup &lookup)
+  {
+    int verts_num, edges_num, polys_num, loops_num;
+    Span<char> edges_data, polys_data, loops_data;
+    if (!this->get_int(lookup, "verts_num", verts_num) ||
+        !this->get_int(lookup, "edges_num", edges_num) ||
+        !this->get_int(lookup, "polys_num", polys_num) ||
+        !this->get_int(lookup, "loops_num", loops_num) ||
+        !this->get_array(lookup, "edges", int64_t(edges_num) * sizeof(MEdge), edges_data) ||
+        !this->get_array(lookup, "polys", int64_t(polys_num) * sizeof(MPoly), polys_data) ||
+        !this->get_array(lookup, "loops", int64_t(loops_num) * sizeof(MLoop), loops_data)) {
+      return nullptr;
+    }
+    const Span<MEdge> edges = edges_data.cast<MEdge>();
+    const Span<MPoly> polys = polys_data.cast<MPoly>();
+    const Span<MLoop> loops = loops_data.cast<MLoop>();
+
+    /* Check the indices, so that a corrupted file cannot cause out of bounds access later. */
+    const bool valid_edges = threading::parallel_reduce(
+        edges.index_range(),
+        4096,
+        true,
+        [&](const IndexRange range, bool valid) {
+          for (const MEdge &edge : edges.slice(range)) {
+            valid &= edge.v1 < uint(verts_num) && edge.v2 < uint(verts_num);
+          }
+          return valid;
+        },
+        std::logical_and<bool>());
+    const bool valid_polys = threading::parallel_reduce(
+        polys.index_range(),
+        4096,
+        true,
+        [&](const IndexRange range, bool valid) {
+          for (const MPoly &poly : polys.slice(range)) {
+            valid &= poly.loopstart >= 0 && poly.totloop >= 0 &&
+                     poly.loopstart <= loops_num - poly.totloop;
+          }
+          return valid;
+        },
+        std::logical_and<bool>());
+    const bool valid_loops = threading::parallel_reduce(
+        loops.index_range(),
+        4096,
+        true,
+        [&](const IndexRange range, bool valid) {
+          for (const MLoop &loop : loops.slice(range)) {
+            valid &= loop.v < uint(verts_num) && loop.e < uint(edges_num);
+          }
+          return valid;
+        },
+        std::logical_and<bool>());
+    if (!valid_edges || !valid_polys || !valid_loops) {
+      error = "Invalid mesh topology";
+      return nullptr;
+    }
+
+    Mesh *mesh = BKE_mesh_new_nomain(verts_num, edges_num, 0, loops_num, polys_num);
+    mesh->edges_for_write().copy_from(edges);
+    mesh->polys_for_write().copy_from(polys);
+    mesh->loops_for_write().copy_from(loops);
+    if (!this->read_attributes(lookup, mesh->attributes_for_write())) {
+      BKE_id_free(nullptr, mesh);
+      return nullptr;
+    }
+    BKE_mesh_tag_coords_changed(mesh);
+    return mesh;
+  }
+
+  PointCloud *read_pointcloud(const DictionaryValue::Lookup &lookup)
+  {
+    int points_num;
+    if (!this->get_int(lookup, "points_num", points_num)) {
+      return nullptr;
+    }
+    PointCloud *pointcloud = BKE_pointcloud_new_nomain(points_num);
+    if (!this->read_attributes(lookup, pointcloud->attributes_for_write())) {
+      BKE_id_free(nullptr, pointcloud);
+      return nullptr;
+    }
+    return pointcloud;
+  }
+
+  Curves *read_curves(const DictionaryValue::Lookup &lookup)
+  {
+    int points_num, curves_num;
+    Span<char> offsets_data;
+    if (!this->get_int(lookup, "points_num", points_num) ||
+        !this->get_int(lookup, "curves_num", curves_num) ||
+        !this->get_array(
+            lookup, "offsets", int64_t(curves_num + 1) * sizeof(int), offsets_data)) {
+      return nullptr;
+    }
+    const Span<int> offsets = offsets_data.cast<int>();
+    bool valid_offsets = offsets.first() == 0 && offsets.last() == points_num;
+    for (const int i : IndexRange(curves_num)) {
+      valid_offsets &= offsets[i] <= offsets[i + 1];
+    }
+    if (!valid_offsets) {
+      error = "Invalid curve offsets";
+      return nullptr;
+    }
+
+    Curves *curves_id = curves_new_nomain(points_num, curves_num);
+    CurvesGeometry &curves = curves_id->geometry.wrap();
+    curves.offsets_for_write().copy_from(offsets);
+    if (!this->read_attributes(lookup, curves.attributes_for_write())) {
+      BKE_id_free(nullptr, curves_id);
+      return nullptr;
+    }
+    curves.update_curve_types();
+    curves.tag_topology_changed();
+    return curves_id;
+  }
+};
+
+bool geometry_cache_deserialize(const Span<char> buffer,
+                                GeometrySet &r_geometry,
+                                std::string &r_error)
+{
+  FileHeader header;
+  if (buffer.size() < int64_t(sizeof(header))) {
+    r_error = "Not a geometry cache file";
+    return false;
+  }
+  memcpy(&header, buffer.data(), sizeof(header));
+  if (memcmp(header.magic, file_magic, sizeof(file_magic)) != 0) {
+    r_error = "Not a geometry cache file";
+    return false;
+  }
+  if (header.endian != ENDIAN_ORDER) {
+    r_error = "Geometry cache was written on a platform with different endianness";
+    return false;
+  }
+  if (header.blender_version != BLENDER_VERSION) {
+    r_error = "Geometry cache was written by a different Blender version";
+    return false;
+  }
+  const int64_t metadata_start = sizeof(header);
+  const int64_t arrays_start = align_size(metadata_start + header.metadata_size);
+  if (header.metadata_size < 0 || arrays_start > buffer.size()) {
+    r_error = "Geometry cache file is truncated";
+    return false;
+  }
+
+  std::unique_ptr<Value> metadata;
+  try {
+    std::istringstream stream(
+        std::string(buffer.data() + metadata_start, size_t(header.metadata_size)));
+    JsonFormatter formatter;
+    metadata = formatter.deserialize(stream);
+  }
+  catch (const std::exception &) {
+  }
+  if (!metadata || metadata->type() != eValueType::Dictionary) {
+    r_error = "Invalid geometry cache metadata";
+    return false;
+  }
+  const DictionaryValue::Lookup metadata_lookup = metadata->as_dictionary_value()->create_lookup();
+  const std::shared_ptr<Value> *components = metadata_lookup.lookup_ptr("components");
+  if (components == nullptr || (*components)->type() != eValueType::Array) {
+    r_error = "Invalid geometry cache metadata";
+    return false;
+  }
+
+  CacheReader reader(buffer.drop_front(arrays_start));
+  GeometrySet geometry;
+  for (const ArrayValue::Item &item : (*components)->as_array_value()->elements()) {
+    if (item->type() != eValueType::Dictionary) {
+      r_error = "Invalid geometry cache metadata";
+      return false;
+    }
+    const DictionaryValue::Lookup lookup = item->as_dictionary_value()->create_lookup();
+    const std::shared_ptr<Value> *type = lookup.lookup_ptr("type");
+    if (type == nullptr || (*type)->type() != eValueType::String) {
+      r_error = "Invalid geometry cache metadata";
+      return false;
+    }
+    const std::string &type_name = (*type)->as_string_value()->value();
+    if (type_name == "mesh") {
+      Mesh *mesh = reader.read_mesh(lookup);
+      if (mesh == nullptr) {
+        r_error = reader.error;
+        return false;
+      }
+      geometry.replace_mesh(mesh);
+    }
+    else if (type_name == "pointcloud") {
+      PointCloud *pointcloud = reader.read_pointcloud(lookup);
+      if (pointcloud == nullptr) {
+        r_error = reader.error;
+        return false;
+      }
+      geometry.replace_pointcloud(pointcloud);
+    }
+    else if (type_name == "curves") {
+      Curves *curves = reader.read_curves(lookup);
+      if (curves == nullptr) {
+        r_error = reader.error;
+        return false;
+      }
+      geometry.replace_curves(curves);
+    }
+    /* Unknown component types are skipped, so that files with new types can still be read. */
+  }
+
+  r_geometry = std::move(geometry);
+  return true;
+}
+
+bool geometry_cache_read(const char *filepath, GeometrySet &r_geometry, std::string &r_error)
+{
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    r_error = "Failed to open file";
+    return false;
+  }
+  size_t buffer_size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  close(file);
+
+  const char *buffer = nullptr;
+  void *file_mem = nullptr;
+  if (mmap_file) {
+    buffer = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+  }
+  else {
+    file_mem = BLI_file_read_binary_as_mem(filepath, 0, &buffer_size);
+    buffer = static_cast<const char *>(file_mem);
+  }
+
+  bool success = false;
+  if (buffer == nullptr) {
+    r_error = "Failed to read file";
+  }
+  else {
+    success = geometry_cache_deserialize(
+        Span<char>(buffer, int64_t(buffer_size)), r_geometry, r_error);
+  }
+
+  if (mmap_file) {
+    BLI_mmap_free(mmap_file);
+  }
+  MEM_SAFE_FREE(file_mem);
+  return success;
+}
+
+/** \} */
+
+}  // namespace blender::bke
@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "testing/testing.h"
+
+#include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_attribute.hh"
+#include "BKE_curves.hh"
+#include "BKE_geometry_cache.hh"
+#include "BKE_idtype.h"
+#include "BKE_mesh.h"
+#include "BKE_pointcloud.h"
+
+namespace blender::bke::tests {
+
+class geometry_cache : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+static std::string serialize(const GeometrySet &geometry)
+{
+  std::string str;
+  geometry_cache_serialize(geometry, [&](const Span<char> buffer) {
+    str.append(buffer.data(), size_t(buffer.size()));
+  });
+  return str;
+}
+
+static bool deserialize(const std::string &str, GeometrySet &r_geometry, std::string &r_error)
+{
+  return geometry_cache_deserialize(
+      Span<char>(str.data(), int64_t(str.size())), r_geometry, r_error);
+}
+
+static Mesh *create_quad_mesh()
+{
+  Mesh *mesh = BKE_mesh_new_nomain(4, 4, 0, 4, 1);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  positions[0] = float3(0.0f, 0.0f, 0.0f);
+  positions[1] = float3(1.0f, 0.0f, 0.0f);
+  positions[2] = float3(1.0f, 1.0f, 0.0f);
+  positions[3] = float3(0.0f, 1.0f, 0.0f);
+  MutableSpan<MEdge> edges = mesh->edges_for_write();
+  MutableSpan<MLoop> loops = mesh->loops_for_write();
+  for (const int i : IndexRange(4)) {
+    edges[i].v1 = i;
+    edges[i].v2 = (i + 1) % 4;
+    loops[i].v = i;
+    loops[i].e = i;
+  }
+  mesh->polys_for_write()[0].loopstart = 0;
+  mesh->polys_for_write()[0].totloop = 4;
+  return mesh;
+}
+
+TEST_F(geometry_cache, mesh_round_trip)
+{
+  Mesh *mesh = create_quad_mesh();
+  SpanAttributeWriter<float> weight =
+      mesh->attributes_for_write().lookup_or_add_for_write_only_span<float>("weight",
+                                                                            ATTR_DOMAIN_CORNER);
+  weight.span.copy_from({0.5f, 1.5f, 2.5f, 3.5f});
+  weight.finish();
+  const std::string str = serialize(GeometrySet::create_with_mesh(mesh));
+
+  GeometrySet result;
+  std::string error;
+  ASSERT_TRUE(deserialize(str, result, error)) << error;
+  const Mesh *result_mesh = result.get_mesh_for_read();
+  ASSERT_NE(result_mesh, nullptr);
+  EXPECT_EQ(result_mesh->totvert, 4);
+  EXPECT_EQ(result_mesh->totpoly, 1);
+  EXPECT_EQ(result_mesh->vert_positions()[2], float3(1.0f, 1.0f, 0.0f));
+  EXPECT_EQ(result_mesh->edges()[3].v2, 0u);
+  EXPECT_EQ(result_mesh->loops()[1].e, 1u);
+  const VArray<float> result_weight = result_mesh->attributes().lookup<float>("weight");
+  ASSERT_TRUE(bool(result_weight));
+  EXPECT_EQ(result_weight[3], 3.5f);
+}
+
+TEST_F(geometry_cache, pointcloud_and_curves_round_trip)
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(100);
+  MutableAttributeAccessor pointcloud_attributes = pointcloud->attributes_for_write();
+  SpanAttributeWriter<float3> positions =
+      pointcloud_attributes.lookup_or_add_for_write_only_span<float3>("position",
+                                                                      ATTR_DOMAIN_POINT);
+  for (const int i : positions.span.index_range()) {
+    positions.span[i] = float3(float(i), 0.0f, -float(i));
+  }
+  positions.finish();
+  SpanAttributeWriter<int> ids = pointcloud_attributes.lookup_or_add_for_write_only_span<int>(
+      "id", ATTR_DOMAIN_POINT);
+  for (const int i : ids.span.index_range()) {
+    ids.span[i] = i * 3;
+  }
+  ids.finish();
+
+  Curves *curves_id = curves_new_nomain(6, 2);
+  CurvesGeometry &curves = curves_id->geometry.wrap();
+  curves.offsets_for_write().copy_from({0, 2, 6});
+  curves.fill_curve_types(CURVE_TYPE_POLY);
+  curves.positions_for_write().fill(float3(2.0f));
+
+  GeometrySet geometry = GeometrySet::create_with_pointcloud(pointcloud);
+  geometry.replace_curves(curves_id);
+  const std::string str = serialize(geometry);
+
+  GeometrySet result;
+  std::string error;
+  ASSERT_TRUE(deserialize(str, result, error)) << error;
+  const PointCloud *result_pointcloud = result.get_pointcloud_for_read();
+  ASSERT_NE(result_pointcloud, nullptr);
+  EXPECT_EQ(result_pointcloud->totpoint, 100);
+  const AttributeAccessor result_attributes = result_pointcloud->attributes();
+  EXPECT_EQ(result_attributes.lookup<float3>("position")[99], float3(99.0f, 0.0f, -99.0f));
+  EXPECT_EQ(result_attributes.lookup<int>("id")[10], 30);
+
+  const Curves *result_curves_id = result.get_curves_for_read();
+  ASSERT_NE(result_curves_id, nullptr);
+  const CurvesGeometry &result_curves = result_curves_id->geometry.wrap();
+  EXPECT_EQ(result_curves.curves_num(), 2);
+  EXPECT_EQ(result_curves.offsets()[1], 2);
+  EXPECT_EQ(result_curves.positions()[5], float3(2.0f));
+  EXPECT_TRUE(result_curves.has_curve_with_type(CURVE_TYPE_POLY));
+}
+
+TEST_F(geometry_cache, invalid)
+{
+  GeometrySet result;
+  std::string error;
+  EXPECT_FALSE(deserialize("", result, error));
+  EXPECT_FALSE(deserialize(std::string(64, 'x'), result, error));
+
+  const std::string str = serialize(GeometrySet::create_with_mesh(create_quad_mesh()));
+  ASSERT_TRUE(deserialize(str, result, error)) << error;
+  /* The arrays are at the end of the file, so removing the last byte truncates one of them. */
+  EXPECT_FALSE(deserialize(str.substr(0, str.size() - 1), result, error));
+
+  /* Point the first edge to a vertex that does not exist. */
+  const Mesh *mesh = result.get_mesh_for_read();
+  const MEdge &edge = mesh->edges()[0];
+  std::string edge_bytes(reinterpret_cast<const char *>(&edge), sizeof(MEdge));
+  const size_t edge_pos = str.find(edge_bytes);
+  ASSERT_NE(edge_pos, std::string::npos);
+  MEdge invalid_edge = edge;
+  invalid_edge.v2 = 100;
+  std::string invalid_str = str;
+  invalid_str.replace(
+      edge_pos, sizeof(MEdge), reinterpret_cast<const char *>(&invalid_edge), sizeof(MEdge));
+  EXPECT_FALSE(deserialize(invalid_str, result, error));
+}
+
+}  // namespace blender::bke::tests
@@ -142,6 +142,7 @@ static void greasepencil_blend_write(BlendWriter *writer, ID *id, const void *id
   gpd->runtime.sbuffer_size = 0;
   gpd->runtime.tot_cp_points = 0;
   gpd->runtime.update_cache = NULL;
+  gpd->runtime.batch_cache_partial_update = false;
 
   /* write gpd data block to file */
   BLO_write_id_struct(writer, bGPdata, id_address, &gpd->id);
@@ -206,6 +207,7 @@ void BKE_gpencil_blend_read_data(BlendDataReader *reader, bGPdata *gpd)
   gpd->runtime.sbuffer_size = 0;
   gpd->runtime.tot_cp_points = 0;
   gpd->runtime.update_cache = NULL;
+  gpd->runtime.batch_cache_partial_update = false;
 
   /* Relink palettes (old palettes deprecated, only to convert old files). */
   BLO_read_list(reader, &gpd->palettes);
@@ -2913,6 +2915,8 @@ static bool gpencil_update_on_write_layer_cb(GPencilUpdateCache *gpl_cache, void
 
     BKE_gpencil_layer_original_pointers_update(gpl, td->gpl_eval);
     td->gpl_eval->runtime.gpl_orig = gpl;
+    /* The strokes of the layer are not tagged, the batch cache has to be rebuilt. */
+    td->gpd_eval->runtime.batch_cache_partial_update = false;
     return true;
   }
   if (gpl_cache->flag == GP_UPDATE_NODE_LIGHT_COPY) {
@@ -2953,6 +2957,8 @@ static bool gpencil_update_on_write_frame_cb(GPencilUpdateCache *gpf_cache, void
       td->gpl_eval->actframe = td->gpf_eval;
     }
 
+    /* The strokes of the frame are not tagged, the batch cache has to be rebuilt. */
+    td->gpd_eval->runtime.batch_cache_partial_update = false;
     return true;
   }
   if (gpf_cache->flag == GP_UPDATE_NODE_LIGHT_COPY) {
@@ -2996,11 +3002,13 @@ static bool gpencil_update_on_write_stroke_cb(GPencilUpdateCache *gps_cache, voi
       pt_eval->runtime.pt_orig = pt_orig;
       pt_eval->runtime.idx_orig = i;
     }
+    td->gps_eval->runtime.is_updated = true;
   }
   else if (gps_cache->flag == GP_UPDATE_NODE_LIGHT_COPY) {
     BLI_assert(gps != NULL);
     BKE_gpencil_stroke_copy_settings(gps, td->gps_eval);
     td->gps_eval->runtime.gps_orig = gps;
+    td->gps_eval->runtime.is_updated = true;
   }
 
   return false;
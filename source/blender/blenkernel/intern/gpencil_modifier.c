@@ -771,6 +771,10 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
   BLI_assert(ob->data != NULL);
   /* Only copy strokes from visible frames to evaluated data. */
   gpencil_copy_visible_frames_to_eval(depsgraph, scene, ob);
+
+  /* The strokes are copied again and modified without being tagged, so the batch cache has to be
+   * rebuilt. */
+  ((bGPdata *)ob->data)->runtime.batch_cache_partial_update = false;
 }
 
 void BKE_gpencil_modifiers_calc(Depsgraph *depsgraph, Scene *scene, Object *ob)
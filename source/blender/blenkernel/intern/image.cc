@@ -1606,28 +1606,30 @@ static bool imagecache_check_free_anim(ImBuf *ibuf, void * /*userkey*/, void *us
   if (ibuf == nullptr) {
     return true;
   }
-  int except_frame = *(int *)userdata;
+  const int *except_frames = static_cast<const int *>(userdata);
+  const int frame = IMA_INDEX_ENTRY(ibuf->index);
   return (ibuf->userflags & IB_BITMAPDIRTY) == 0 && (ibuf->index != IMA_NO_INDEX) &&
-         (except_frame != IMA_INDEX_ENTRY(ibuf->index));
+         (frame < except_frames[0] || frame > except_frames[1]);
 }
 
-void BKE_image_free_anim_ibufs(Image *ima, int except_frame)
+void BKE_image_free_anim_ibufs(Image *ima, int except_first_frame, int except_last_frame)
 {
+  int except_frames[2] = {except_first_frame, except_last_frame};
   BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
   if (ima->cache != nullptr) {
-    IMB_moviecache_cleanup(ima->cache, imagecache_check_free_anim, &except_frame);
+    IMB_moviecache_cleanup(ima->cache, imagecache_check_free_anim, except_frames);
   }
   BLI_mutex_unlock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
 }
 
-void BKE_image_all_free_anim_ibufs(Main *bmain, int cfra)
+void BKE_image_all_free_anim_ibufs(Main *bmain, int cfra, int last_kept_frame)
 {
   Image *ima;
 
   for (ima = static_cast<Image *>(bmain->images.first); ima;
        ima = static_cast<Image *>(ima->id.next)) {
     if (BKE_image_is_animated(ima)) {
-      BKE_image_free_anim_ibufs(ima, cfra);
+      BKE_image_free_anim_ibufs(ima, cfra, last_kept_frame);
     }
   }
 }
@@ -4745,6 +4747,7 @@ ImBuf *BKE_image_acquire_ibuf(Image *ima, ImageUser *iuser, void **r_lock)
   }
 
   ImBuf *ibuf;
+  MEM_TagScope mem_tag(MEM_TAG_IMAGE);
 
   BLI_mutex_lock(static_cast<ThreadMutex *>(ima->runtime.cache_mutex));
 
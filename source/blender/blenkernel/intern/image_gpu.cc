@@ -5,6 +5,8 @@
  * \ingroup bke
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_bitmap.h"
@@ -12,6 +14,7 @@
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -549,11 +552,66 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+static size_t image_gpu_memory_size(const Image *ima)
+{
+  size_t size = 0;
+  for (int eye = 0; eye < 2; eye++) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      if (ima->gputexture[i][eye] != nullptr) {
+        size += GPU_texture_memory_size(ima->gputexture[i][eye]);
+      }
+    }
+  }
+  return size;
+}
+
+/**
+ * Free the GPU textures of the least recently used images until the memory used by all image
+ * textures is below the limit from the preferences. Images that were used during the last second
+ * are kept, so that textures needed to draw the current frame aren't freed and recreated on
+ * every redraw.
+ */
+static void image_free_gputextures_over_limit(Main *bmain, const int ctime)
+{
+  if (U.texture_memory_limit <= 0) {
+    return;
+  }
+  const size_t limit = size_t(U.texture_memory_limit) * 1024 * 1024;
+
+  size_t total_size = 0;
+  blender::Vector<Image *> candidates;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    const size_t size = image_gpu_memory_size(ima);
+    total_size += size;
+    if (size > 0 && (ima->flag & IMA_NOCOLLECT) == 0 && ima->lastused < ctime) {
+      candidates.append(ima);
+    }
+  }
+  if (total_size <= limit) {
+    return;
+  }
+
+  std::sort(candidates.begin(), candidates.end(), [](const Image *a, const Image *b) {
+    return a->lastused < b->lastused;
+  });
+  for (Image *ima : candidates) {
+    total_size -= image_gpu_memory_size(ima);
+    BKE_image_free_gputextures(ima);
+    if (total_size <= limit) {
+      break;
+    }
+  }
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
   int ctime = int(PIL_check_seconds_timer());
 
+  if (!G.is_rendering) {
+    image_free_gputextures_over_limit(bmain, ctime);
+  }
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
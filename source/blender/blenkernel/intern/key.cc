@@ -11,11 +11,15 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_string_utils.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.h"
 
@@ -51,6 +55,16 @@
 
 #include "BLO_read_write.h"
 
+#include "atomic_ops.h"
+
+using blender::Array;
+using blender::float3;
+using blender::IndexRange;
+using blender::Span;
+using blender::Vector;
+
+static void key_sparse_deltas_free(Key *key);
+
 static void shapekey_copy_data(Main * /*bmain*/, ID *id_dst, const ID *id_src, const int /*flag*/)
 {
   Key *key_dst = (Key *)id_dst;
@@ -69,6 +83,7 @@ static void shapekey_copy_data(Main * /*bmain*/, ID *id_dst, const ID *id_src, c
       key_dst->refkey = kb_dst;
     }
   }
+  key_dst->sparse_deltas = nullptr;
 }
 
 static void shapekey_free_data(ID *id)
@@ -76,6 +91,8 @@ static void shapekey_free_data(ID *id)
   Key *key = (Key *)id;
   KeyBlock *kb;
 
+  key_sparse_deltas_free(key);
+
   while ((kb = static_cast<KeyBlock *>(BLI_pophead(&key->block)))) {
     if (kb->data) {
       MEM_freeN(kb->data);
@@ -169,6 +186,7 @@ static void shapekey_blend_read_data(BlendDataReader *reader, ID *id)
   BKE_animdata_blend_read_data(reader, key->adt);
 
   BLO_read_data_address(reader, &key->refkey);
+  key->sparse_deltas = nullptr;
 
   LISTBASE_FOREACH (KeyBlock *, kb, &key->block) {
     BLO_read_data_address(reader, &kb->data);
@@ -245,6 +263,8 @@ void BKE_key_free_nolib(Key *key)
 {
   KeyBlock *kb;
 
+  key_sparse_deltas_free(key);
+
   while ((kb = static_cast<KeyBlock *>(BLI_pophead(&key->block)))) {
     if (kb->data) {
       MEM_freeN(kb->data);
@@ -1383,6 +1403,182 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Sparse Relative Mesh Shape Keys
+ *
+ * Corrective shapes usually move only a small part of the mesh. For evaluated copies, the offsets
+ * of every key-block to its reference are stored as (index, offset) pairs of the vertices that
+ * actually move, so blending a key only touches those vertices. The cache is freed together with
+ * the copy, so it never outlives the shape data it was built from. Original data-blocks can be
+ * edited in place, they always use the dense evaluation.
+ * \{ */
+
+struct KeyBlockSparseDelta {
+  /** False when so many vertices move that the dense evaluation is faster. */
+  bool is_sparse = false;
+  /** Sorted indices of the moving vertices. */
+  Array<int> indices;
+  /** Offset from the reference key-block, for every index. */
+  Array<float3> offsets;
+};
+
+struct KeySparseDeltas {
+  /** Same order as #Key.block. */
+  Array<KeyBlockSparseDelta> blocks;
+};
+
+static void key_sparse_deltas_free(Key *key)
+{
+  MEM_delete(key->sparse_deltas);
+  key->sparse_deltas = nullptr;
+}
+
+static void key_block_sparse_delta_build(const KeyBlock *kb,
+                                         const KeyBlock *refb,
+                                         KeyBlockSparseDelta &r_delta)
+{
+  const Span<float3> positions(static_cast<const float3 *>(kb->data), kb->totelem);
+  const Span<float3> ref_positions(static_cast<const float3 *>(refb->data), refb->totelem);
+
+  Vector<int> indices;
+  for (const int i : positions.index_range()) {
+    if (positions[i] != ref_positions[i]) {
+      indices.append(i);
+      /* Give up early when the key moves too much of the mesh. */
+      if (indices.size() > positions.size() / 2) {
+        return;
+      }
+    }
+  }
+
+  r_delta.is_sparse = true;
+  r_delta.indices = indices.as_span();
+  r_delta.offsets.reinitialize(indices.size());
+  for (const int i : indices.index_range()) {
+    r_delta.offsets[i] = positions[indices[i]] - ref_positions[indices[i]];
+  }
+}
+
+static const KeySparseDeltas *key_sparse_deltas_ensure(Key *key)
+{
+  if ((key->id.tag & LIB_TAG_COPIED_ON_WRITE) == 0) {
+    return nullptr;
+  }
+  if (key->sparse_deltas != nullptr) {
+    return key->sparse_deltas;
+  }
+
+  Vector<KeyBlock *> blocks;
+  LISTBASE_FOREACH (KeyBlock *, kb, &key->block) {
+    blocks.append(kb);
+  }
+
+  KeySparseDeltas *sparse_deltas = MEM_new<KeySparseDeltas>(__func__);
+  sparse_deltas->blocks.reinitialize(blocks.size());
+  blender::threading::parallel_for(blocks.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const KeyBlock *kb = blocks[i];
+      if (kb == key->refkey || kb->data == nullptr || kb->relative < 0 ||
+          kb->relative >= blocks.size()) {
+        continue;
+      }
+      const KeyBlock *refb = blocks[kb->relative];
+      if (refb->data == nullptr || refb->totelem != kb->totelem) {
+        continue;
+      }
+      key_block_sparse_delta_build(kb, refb, sparse_deltas->blocks[i]);
+    }
+  });
+
+  /* Multiple objects can evaluate the same key at the same time, keep the first result. */
+  if (atomic_cas_ptr((void **)&key->sparse_deltas, nullptr, sparse_deltas) != nullptr) {
+    MEM_delete(sparse_deltas);
+  }
+  return key->sparse_deltas;
+}
+
+/**
+ * Same as #key_evaluate_relative for meshes, but multi-threaded and skipping the vertices that a
+ * key-block doesn't move.
+ */
+static void key_evaluate_relative_mesh(
+    Key *key, KeyBlock *actkb, float **per_keyblock_weights, float (*out)[3], const int tot)
+{
+  BLI_assert(key->elemsize == sizeof(float[KEYELEM_FLOAT_LEN_COORD]));
+
+  cp_key(0, tot, tot, (char *)out, key, actkb, key->refkey, nullptr, KEY_MODE_DUMMY);
+
+  const KeySparseDeltas *sparse_deltas = key_sparse_deltas_ensure(key);
+
+  struct ActiveBlock {
+    const float (*ref)[3];
+    const float (*from)[3];
+    char *freefrom;
+    const float *weights;
+    float factor;
+    const KeyBlockSparseDelta *sparse;
+  };
+  Vector<ActiveBlock> active_blocks;
+
+  int keyblock_index;
+  KeyBlock *kb;
+  for (kb = static_cast<KeyBlock *>(key->block.first), keyblock_index = 0; kb;
+       kb = kb->next, keyblock_index++) {
+    if (kb == key->refkey || (kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f ||
+        kb->totelem != tot) {
+      continue;
+    }
+    const KeyBlock *refb = static_cast<const KeyBlock *>(BLI_findlink(&key->block, kb->relative));
+    if (refb == nullptr) {
+      continue;
+    }
+
+    ActiveBlock block;
+    block.ref = static_cast<const float(*)[3]>(refb->data);
+    block.from = reinterpret_cast<const float(*)[3]>(
+        key_block_get_data(key, actkb, kb, &block.freefrom));
+    block.weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] : nullptr;
+    block.factor = kb->curval;
+    block.sparse = nullptr;
+    /* The edit-mesh coordinates of the active key-block don't match the cached offsets. */
+    if (sparse_deltas && block.freefrom == nullptr &&
+        sparse_deltas->blocks[keyblock_index].is_sparse) {
+      block.sparse = &sparse_deltas->blocks[keyblock_index];
+    }
+    active_blocks.append(block);
+  }
+
+  /* Every vertex accumulates the key-blocks in the same order as #key_evaluate_relative. */
+  blender::threading::parallel_for(IndexRange(tot), 2048, [&](const IndexRange range) {
+    for (const ActiveBlock &block : active_blocks) {
+      if (block.sparse) {
+        const Span<int> indices = block.sparse->indices;
+        const int64_t start = std::lower_bound(indices.begin(), indices.end(), range.start()) -
+                              indices.begin();
+        for (int64_t i = start; i < indices.size() && indices[i] < range.one_after_last(); i++) {
+          const int vert = indices[i];
+          const float weight = block.weights ? block.weights[vert] * block.factor : block.factor;
+          madd_v3_v3fl(out[vert], block.sparse->offsets[i], weight);
+        }
+      }
+      else {
+        for (const int vert : range) {
+          const float weight = block.weights ? block.weights[vert] * block.factor : block.factor;
+          rel_flerp(KEYELEM_FLOAT_LEN_COORD, out[vert], block.ref[vert], block.from[vert], weight);
+        }
+      }
+    }
+  });
+
+  for (const ActiveBlock &block : active_blocks) {
+    if (block.freefrom) {
+      MEM_freeN(block.freefrom);
+    }
+  }
+}
+
+/** \} */
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1393,8 +1589,7 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, nullptr};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    key_evaluate_relative_mesh(key, actkb, per_keyblock_weights, (float(*)[3])out, tot);
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
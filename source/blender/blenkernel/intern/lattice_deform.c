@@ -135,6 +135,23 @@ LatticeDeformData *BKE_lattice_deform_data_create(const Object *oblatt, const Ob
   return lattice_deform_data;
 }
 
+/**
+ * Find the range of the 4 interpolation taps with a non-zero weight, linear interpolation and
+ * lattices with a single point along an axis only use 2 and 1 of them.
+ */
+static void lattice_deform_taps_range(const float t[4], int *r_first, int *r_last)
+{
+  int first = 0, last = 3;
+  while (first < last && t[first] == 0.0f) {
+    first++;
+  }
+  while (last > first && t[last] == 0.0f) {
+    last--;
+  }
+  *r_first = first;
+  *r_last = last;
+}
+
 void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
                                      float co[3],
                                      float weight)
@@ -147,6 +164,7 @@ void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
   float vec[3];
   int idx_w, idx_v, idx_u;
   int ui, vi, wi, uu, vv, ww;
+  int u_first, u_last, v_first, v_last, w_first, w_last;
 
   /* vgroup influence */
   float co_prev[4] = {0}, weight_blend = 0.0f;
@@ -196,19 +214,24 @@ void BKE_lattice_deform_data_eval_co(LatticeDeformData *lattice_deform_data,
     wi = 0;
   }
 
+  /* Skip the taps that don't contribute, to avoid reading lattice points that are not used. */
+  lattice_deform_taps_range(tu, &u_first, &u_last);
+  lattice_deform_taps_range(tv, &v_first, &v_last);
+  lattice_deform_taps_range(tw, &w_first, &w_last);
+
   const int w_stride = lt->pntsu * lt->pntsv;
   const int idx_w_max = (lt->pntsw - 1) * lt->pntsu * lt->pntsv;
   const int v_stride = lt->pntsu;
   const int idx_v_max = (lt->pntsv - 1) * lt->pntsu;
   const int idx_u_max = (lt->pntsu - 1);
 
-  for (ww = wi - 1; ww <= wi + 2; ww++) {
+  for (ww = wi - 1 + w_first; ww <= wi - 1 + w_last; ww++) {
     w = weight * tw[ww - wi + 1];
     idx_w = CLAMPIS(ww * w_stride, 0, idx_w_max);
-    for (vv = vi - 1; vv <= vi + 2; vv++) {
+    for (vv = vi - 1 + v_first; vv <= vi - 1 + v_last; vv++) {
       v = w * tv[vv - vi + 1];
       idx_v = CLAMPIS(vv * v_stride, 0, idx_v_max);
-      for (uu = ui - 1; uu <= ui + 2; uu++) {
+      for (uu = ui - 1 + u_first; uu <= ui - 1 + u_last; uu++) {
         u = v * tu[uu - ui + 1];
         idx_u = CLAMPIS(uu, 0, idx_u_max);
         const int idx = idx_w + idx_v + idx_u;
@@ -252,6 +275,9 @@ void BKE_lattice_deform_data_destroy(LatticeDeformData *lattice_deform_data)
   if (lattice_deform_data->latticedata) {
     MEM_freeN(lattice_deform_data->latticedata);
   }
+  if (lattice_deform_data->lattice_weights) {
+    MEM_freeN(lattice_deform_data->lattice_weights);
+  }
 
   MEM_freeN(lattice_deform_data);
 }
@@ -701,9 +701,14 @@ static void lib_override_group_tag_data_object_to_collection_init_collection_pro
  * other simple data.
  *
  * NOTE: Currently creates a mapping from linked object to all of their instantiating collections
- * (as returned by #BKE_collection_object_find). */
+ * (as returned by #BKE_collection_object_find). This mapping is only used when creating new
+ * overrides, so it is not built at all in resync case. */
 static void lib_override_group_tag_data_object_to_collection_init(LibOverrideGroupTagData *data)
 {
+  if (data->is_resync) {
+    return;
+  }
+
   data->mem_arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, __func__);
 
   data->linked_object_to_instantiating_collections = BLI_ghash_new(
@@ -719,8 +724,12 @@ static void lib_override_group_tag_data_object_to_collection_init(LibOverrideGro
 
 static void lib_override_group_tag_data_clear(LibOverrideGroupTagData *data)
 {
-  BLI_ghash_free(data->linked_object_to_instantiating_collections, nullptr, nullptr);
-  BLI_memarena_free(data->mem_arena);
+  if (data->linked_object_to_instantiating_collections != nullptr) {
+    BLI_ghash_free(data->linked_object_to_instantiating_collections, nullptr, nullptr);
+  }
+  if (data->mem_arena != nullptr) {
+    BLI_memarena_free(data->mem_arena);
+  }
   memset(data, 0, sizeof(*data));
 }
 
@@ -2434,6 +2443,14 @@ static void lib_override_library_main_resync_on_library_indirect_level(
       continue;
     }
 
+    if (id->override_library->reference->tag & LIB_TAG_DOIT) {
+      /* The linked reference was already reached (and all of its dependencies processed) from
+       * the reference of another override of the same hierarchy. Processing it again would only
+       * add more full scans of Main for each override ID, which gets very expensive with
+       * hundreds of overridden hierarchies. */
+      continue;
+    }
+
     data.id_root = id->override_library->reference;
     lib_override_linked_group_tag(&data);
     BKE_main_relations_tag_set(bmain, MAINIDRELATIONS_ENTRY_TAGS_PROCESSED, false);
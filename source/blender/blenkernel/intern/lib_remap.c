@@ -8,6 +8,7 @@
 
 #include "CLG_log.h"
 
+#include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_utildefines.h"
 
@@ -528,6 +529,15 @@ static void libblock_remap_data(Main *bmain,
 typedef struct LibblockRemapMultipleUserData {
   Main *bmain;
   short remap_flags;
+
+  /* Post-processing that has to check the whole Main database is only done once for all
+   * remapped pairs, see #libblock_remap_multiple_postprocess. */
+  bool do_objects_remove_nulls;
+  bool do_objects_remove_duplicates;
+  bool do_collections_remove_nulls;
+  bool do_collections_parent_relations_rebuild;
+  /** New object data IDs that objects may have been relinked to. */
+  GSet *obdata_new_ids;
 } LibBlockRemapMultipleUserData;
 
 static void libblock_remap_foreach_idpair_cb(ID *old_id, ID *new_id, void *user_data)
@@ -579,13 +589,31 @@ static void libblock_remap_foreach_idpair_cb(ID *old_id, ID *new_id, void *user_
    * This is a bit ugly, but cannot see a way to avoid it.
    * Maybe we should do a per-ID callback for this instead? */
   switch (GS(old_id->name)) {
-    case ID_OB:
-      libblock_remap_data_postprocess_object_update(
-          bmain, (Object *)old_id, (Object *)new_id, true);
+    case ID_OB: {
+      Object *old_ob = (Object *)old_id;
+      if (new_id == NULL) {
+        data->do_objects_remove_nulls = true;
+      }
+      else {
+        data->do_objects_remove_duplicates = true;
+      }
+      if (old_ob->type == OB_MBALL) {
+        for (Object *ob = bmain->objects.first; ob != NULL; ob = ob->id.next) {
+          if (ob->type == OB_MBALL && BKE_mball_is_basis_for(ob, old_ob)) {
+            DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+            break; /* There is only one basis... */
+          }
+        }
+      }
       break;
+    }
     case ID_GR:
-      libblock_remap_data_postprocess_collection_update(
-          bmain, NULL, (Collection *)old_id, (Collection *)new_id);
+      if (new_id == NULL) {
+        data->do_collections_remove_nulls = true;
+      }
+      else {
+        data->do_collections_parent_relations_rebuild = true;
+      }
       break;
     case ID_ME:
     case ID_CU_LEGACY:
@@ -594,9 +622,10 @@ static void libblock_remap_foreach_idpair_cb(ID *old_id, ID *new_id, void *user_
     case ID_PT:
     case ID_VO:
       if (new_id) { /* Only affects us in case obdata was relinked (changed). */
-        for (Object *ob = bmain->objects.first; ob; ob = ob->id.next) {
-          libblock_remap_data_postprocess_obdata_relink(bmain, ob, new_id);
+        if (data->obdata_new_ids == NULL) {
+          data->obdata_new_ids = BLI_gset_ptr_new(__func__);
         }
+        BLI_gset_add(data->obdata_new_ids, new_id);
       }
       break;
     default:
@@ -607,16 +636,57 @@ static void libblock_remap_foreach_idpair_cb(ID *old_id, ID *new_id, void *user_
   /* XXX Yuck!!!! nodetree update can do pretty much any thing when talking about py nodes,
    *     including creating new data-blocks (see T50385), so we need to unlock main here. :(
    *     Why can't we have re-entrent locks? */
-  BKE_main_unlock(bmain);
-  libblock_remap_data_postprocess_nodetree_update(bmain, new_id);
-  BKE_main_lock(bmain);
-
-  /* Full rebuild of DEG! */
-  DEG_relations_tag_update(bmain);
+  if (new_id != NULL) {
+    BKE_main_unlock(bmain);
+    libblock_remap_data_postprocess_nodetree_update(bmain, new_id);
+    BKE_main_lock(bmain);
+  }
 
   BKE_libblock_runtime_reset_remapping_status(old_id);
 }
 
+/**
+ * Do the post-processing collected by #libblock_remap_foreach_idpair_cb, each Main-wide check is
+ * done only once however many IDs were remapped.
+ */
+static void libblock_remap_multiple_postprocess(LibBlockRemapMultipleUserData *data)
+{
+  Main *bmain = data->bmain;
+
+  if (data->do_objects_remove_nulls) {
+    /* In case we unlinked objects, they have already been removed from the scenes and their
+     * collections. We still have to remove the NULL children from collections not used in any
+     * scene. */
+    BKE_collections_object_remove_nulls(bmain);
+  }
+  if (data->do_objects_remove_duplicates) {
+    /* Remapping may have created duplicates of CollectionObject pointing to the same object
+     * within the same collection. */
+    BKE_collections_object_remove_duplicates(bmain);
+  }
+  if (data->do_collections_remove_nulls) {
+    BKE_collections_child_remove_nulls(bmain, NULL, NULL);
+  }
+  if (data->do_collections_parent_relations_rebuild) {
+    /* NOTE: Also takes care of duplicated child collections that remapping may have created. */
+    BKE_main_collections_parent_relations_rebuild(bmain);
+  }
+  if (data->do_objects_remove_nulls || data->do_objects_remove_duplicates ||
+      data->do_collections_remove_nulls || data->do_collections_parent_relations_rebuild) {
+    BKE_main_collection_sync_remap(bmain);
+  }
+
+  if (data->obdata_new_ids) {
+    for (Object *ob = bmain->objects.first; ob; ob = ob->id.next) {
+      if (ob->data && BLI_gset_haskey(data->obdata_new_ids, ob->data)) {
+        libblock_remap_data_postprocess_obdata_relink(bmain, ob, ob->data);
+      }
+    }
+    BLI_gset_free(data->obdata_new_ids, NULL);
+    data->obdata_new_ids = NULL;
+  }
+}
+
 void BKE_libblock_remap_multiple_locked(Main *bmain,
                                         struct IDRemapper *mappings,
                                         const short remap_flags)
@@ -633,6 +703,7 @@ void BKE_libblock_remap_multiple_locked(Main *bmain,
   user_data.remap_flags = remap_flags;
 
   BKE_id_remapper_iter(mappings, libblock_remap_foreach_idpair_cb, &user_data);
+  libblock_remap_multiple_postprocess(&user_data);
 
   /* We assume editors do not hold references to their IDs... This is false in some cases
    * (Image is especially tricky here),
@@ -1314,6 +1314,87 @@ static float layer_bucket_depth_from_xy(MaskRasterLayer *layer, const float xy[2
   return 1.0f;
 }
 
+BLI_INLINE float maskrasterize_layer_falloff(const MaskRasterLayer *layer, float value_layer)
+{
+  switch (layer->falloff) {
+    case PROP_SMOOTH:
+      /* ease - gives less hard lines for dilate/erode feather */
+      value_layer = (3.0f * value_layer * value_layer -
+                     2.0f * value_layer * value_layer * value_layer);
+      break;
+    case PROP_SPHERE:
+      value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
+      break;
+    case PROP_ROOT:
+      value_layer = sqrtf(value_layer);
+      break;
+    case PROP_SHARP:
+      value_layer = value_layer * value_layer;
+      break;
+    case PROP_INVSQUARE:
+      value_layer = value_layer * (2.0f - value_layer);
+      break;
+    case PROP_LIN:
+    default:
+      /* nothing */
+      break;
+  }
+
+  if (layer->blend != MASK_BLEND_REPLACE) {
+    value_layer *= layer->alpha;
+  }
+  return value_layer;
+}
+
+BLI_INLINE float maskrasterize_layer_blend(const MaskRasterLayer *layer,
+                                           float value,
+                                           float value_layer)
+{
+  if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
+    value_layer = 1.0f - value_layer;
+  }
+
+  switch (layer->blend) {
+    case MASK_BLEND_MERGE_ADD:
+      value += value_layer * (1.0f - value);
+      break;
+    case MASK_BLEND_MERGE_SUBTRACT:
+      value -= value_layer * value;
+      break;
+    case MASK_BLEND_ADD:
+      value += value_layer;
+      break;
+    case MASK_BLEND_SUBTRACT:
+      value -= value_layer;
+      break;
+    case MASK_BLEND_LIGHTEN:
+      value = max_ff(value, value_layer);
+      break;
+    case MASK_BLEND_DARKEN:
+      value = min_ff(value, value_layer);
+      break;
+    case MASK_BLEND_MUL:
+      value *= value_layer;
+      break;
+    case MASK_BLEND_REPLACE:
+      value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
+      break;
+    case MASK_BLEND_DIFFERENCE:
+      value = fabsf(value - value_layer);
+      break;
+    default: /* same as add */
+      CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
+      BLI_assert(0);
+      value += value_layer;
+      break;
+  }
+
+  /* clamp after applying each layer so we don't get
+   * issues subtracting after accumulating over 1.0f */
+  CLAMP(value, 0.0f, 1.0f);
+  return value;
+}
+
 float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float xy[2])
 {
   /* can't do this because some layers may invert */
@@ -1331,84 +1412,90 @@ float BKE_maskrasterize_handle_sample(MaskRasterHandle *mr_handle, const float x
     /* also used as signal for unused layer (when render is disabled) */
     if (layer->alpha != 0.0f && BLI_rctf_isect_pt_v(&layer->bounds, xy)) {
       value_layer = 1.0f - layer_bucket_depth_from_xy(layer, xy);
-
-      switch (layer->falloff) {
-        case PROP_SMOOTH:
-          /* ease - gives less hard lines for dilate/erode feather */
-          value_layer = (3.0f * value_layer * value_layer -
-                         2.0f * value_layer * value_layer * value_layer);
-          break;
-        case PROP_SPHERE:
-          value_layer = sqrtf(2.0f * value_layer - value_layer * value_layer);
-          break;
-        case PROP_ROOT:
-          value_layer = sqrtf(value_layer);
-          break;
-        case PROP_SHARP:
-          value_layer = value_layer * value_layer;
-          break;
-        case PROP_INVSQUARE:
-          value_layer = value_layer * (2.0f - value_layer);
-          break;
-        case PROP_LIN:
-        default:
-          /* nothing */
-          break;
-      }
-
-      if (layer->blend != MASK_BLEND_REPLACE) {
-        value_layer *= layer->alpha;
-      }
+      value_layer = maskrasterize_layer_falloff(layer, value_layer);
     }
     else {
       value_layer = 0.0f;
     }
 
-    if (layer->blend_flag & MASK_BLENDFLAG_INVERT) {
-      value_layer = 1.0f - value_layer;
-    }
+    value = maskrasterize_layer_blend(layer, value, value_layer);
+  }
+
+  return value;
+}
+
+/* Number of samples which are processed at once by #BKE_maskrasterize_handle_sample_span, small
+ * enough for the values of a layer to stay on the stack. */
+#define MASK_SAMPLE_SPAN_CHUNK_SIZE 256
 
-    switch (layer->blend) {
-      case MASK_BLEND_MERGE_ADD:
-        value += value_layer * (1.0f - value);
-        break;
-      case MASK_BLEND_MERGE_SUBTRACT:
-        value -= value_layer * value;
-        break;
-      case MASK_BLEND_ADD:
-        value += value_layer;
-        break;
-      case MASK_BLEND_SUBTRACT:
-        value -= value_layer;
-        break;
-      case MASK_BLEND_LIGHTEN:
-        value = max_ff(value, value_layer);
-        break;
-      case MASK_BLEND_DARKEN:
-        value = min_ff(value, value_layer);
-        break;
-      case MASK_BLEND_MUL:
-        value *= value_layer;
-        break;
-      case MASK_BLEND_REPLACE:
-        value = (value * (1.0f - layer->alpha)) + (value_layer * layer->alpha);
-        break;
-      case MASK_BLEND_DIFFERENCE:
-        value = fabsf(value - value_layer);
-        break;
-      default: /* same as add */
-        CLOG_ERROR(&LOG, "unhandled blend type: %d", layer->blend);
-        BLI_assert(0);
-        value += value_layer;
-        break;
+/**
+ * Same as #BKE_maskrasterize_handle_sample for every sample of the span, but goes over the layers
+ * in the outer loop. The buckets of a layer stay in cache while its samples are looked up, and
+ * layers which don't overlap the row are skipped entirely.
+ */
+static void maskrasterize_sample_span_chunk(MaskRasterHandle *mr_handle,
+                                            const int x_start,
+                                            const int span_len,
+                                            const float x_scale,
+                                            const float x_offset,
+                                            const float y,
+                                            float *r_values)
+{
+  const uint layers_tot = mr_handle->layers_tot;
+  MaskRasterLayer *layer = mr_handle->layers;
+  float values_layer[MASK_SAMPLE_SPAN_CHUNK_SIZE];
+
+  BLI_assert(span_len <= MASK_SAMPLE_SPAN_CHUNK_SIZE);
+
+  for (int i = 0; i < span_len; i++) {
+    r_values[i] = 0.0f;
+  }
+
+  for (uint layer_index = 0; layer_index < layers_tot; layer_index++, layer++) {
+    /* also used as signal for unused layer (when render is disabled) */
+    if (layer->alpha != 0.0f && y >= layer->bounds.ymin && y <= layer->bounds.ymax) {
+      for (int i = 0; i < span_len; i++) {
+        const float xy[2] = {(float)(x_start + i) * x_scale + x_offset, y};
+        if (xy[0] >= layer->bounds.xmin && xy[0] <= layer->bounds.xmax) {
+          const float value_layer = 1.0f - layer_bucket_depth_from_xy(layer, xy);
+          values_layer[i] = maskrasterize_layer_falloff(layer, value_layer);
+        }
+        else {
+          values_layer[i] = 0.0f;
+        }
+      }
+    }
+    else {
+      for (int i = 0; i < span_len; i++) {
+        values_layer[i] = 0.0f;
+      }
     }
 
-    /* clamp after applying each layer so we don't get
-     * issues subtracting after accumulating over 1.0f */
-    CLAMP(value, 0.0f, 1.0f);
+    for (int i = 0; i < span_len; i++) {
+      r_values[i] = maskrasterize_layer_blend(layer, r_values[i], values_layer[i]);
+    }
   }
+}
 
-  return value;
+void BKE_maskrasterize_handle_sample_span(MaskRasterHandle *mr_handle,
+                                          const int x_start,
+                                          const int span_len,
+                                          const float x_scale,
+                                          const float x_offset,
+                                          const float y,
+                                          float *r_values)
+{
+  for (int chunk_start = 0; chunk_start < span_len;
+       chunk_start += MASK_SAMPLE_SPAN_CHUNK_SIZE) {
+    const int chunk_len = min_ii(span_len - chunk_start, MASK_SAMPLE_SPAN_CHUNK_SIZE);
+    maskrasterize_sample_span_chunk(mr_handle,
+                                    x_start + chunk_start,
+                                    chunk_len,
+                                    x_scale,
+                                    x_offset,
+                                    y,
+                                    r_values + chunk_start);
+  }
 }
 
 typedef struct MaskRasterizeBufferData {
@@ -1433,14 +1520,9 @@ static void maskrasterize_buffer_cb(void *__restrict userdata,
   const float x_inv = data->x_inv;
   const float x_px_ofs = data->x_px_ofs;
 
-  uint i = (uint)y * width;
-  float xy[2];
-  xy[1] = ((float)y * data->y_inv) + data->y_px_ofs;
-  for (uint x = 0; x < width; x++, i++) {
-    xy[0] = ((float)x * x_inv) + x_px_ofs;
-
-    buffer[i] = BKE_maskrasterize_handle_sample(mr_handle, xy);
-  }
+  const float y_co = ((float)y * data->y_inv) + data->y_px_ofs;
+  BKE_maskrasterize_handle_sample_span(
+      mr_handle, 0, (int)width, x_inv, x_px_ofs, y_co, &buffer[(size_t)y * width]);
 }
 
 void BKE_maskrasterize_buffer(MaskRasterHandle *mr_handle,
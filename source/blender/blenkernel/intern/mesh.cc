@@ -132,6 +132,9 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
   mesh_dst->runtime->bounds_cache = mesh_src->runtime->bounds_cache;
   mesh_dst->runtime->loose_edges_cache = mesh_src->runtime->loose_edges_cache;
   mesh_dst->runtime->looptris_cache = mesh_src->runtime->looptris_cache;
+  mesh_dst->runtime->loop_to_poly_map_cache = mesh_src->runtime->loop_to_poly_map_cache;
+  mesh_dst->runtime->vert_to_edge_map_cache = mesh_src->runtime->vert_to_edge_map_cache;
+  mesh_dst->runtime->vert_to_loop_map_cache = mesh_src->runtime->vert_to_loop_map_cache;
 
   /* Only do tessface if we have no polys. */
   const bool do_tessface = ((mesh_src->totface != 0) && (mesh_src->totpoly == 0));
@@ -151,7 +154,15 @@ static void mesh_copy_data(Main *bmain, ID *id_dst, const ID *id_src, const int
   mesh_dst->default_color_attribute = static_cast<char *>(
       MEM_dupallocN(mesh_src->default_color_attribute));
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  eCDAllocType alloc_type = CD_DUPLICATE;
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    alloc_type = CD_REFERENCE;
+  }
+  else if (flag & (LIB_ID_COPY_SET_COPIED_ON_WRITE | LIB_ID_CREATE_NO_MAIN)) {
+    /* Evaluated and temporary copies (e.g. from #BKE_mesh_copy_for_eval) only need their own
+     * arrays when they are modified, which is often not the case for most attributes. */
+    alloc_type = CD_SHARE;
+  }
   CustomData_copy(&mesh_src->vdata, &mesh_dst->vdata, mask.vmask, alloc_type, mesh_dst->totvert);
   CustomData_copy(&mesh_src->edata, &mesh_dst->edata, mask.emask, alloc_type, mesh_dst->totedge);
   CustomData_copy(&mesh_src->ldata, &mesh_dst->ldata, mask.lmask, alloc_type, mesh_dst->totloop);
@@ -1080,10 +1091,12 @@ Mesh *BKE_mesh_new_nomain_from_template_ex(const Mesh *me_src,
 
   BKE_mesh_copy_parameters_for_eval(me_dst, me_src);
 
-  CustomData_copy(&me_src->vdata, &me_dst->vdata, mask.vmask, CD_SET_DEFAULT, verts_len);
-  CustomData_copy(&me_src->edata, &me_dst->edata, mask.emask, CD_SET_DEFAULT, edges_len);
-  CustomData_copy(&me_src->ldata, &me_dst->ldata, mask.lmask, CD_SET_DEFAULT, loops_len);
-  CustomData_copy(&me_src->pdata, &me_dst->pdata, mask.pmask, CD_SET_DEFAULT, polys_len);
+  /* Modifiers and nodes create many meshes that often have a lot of layers, allocating the layers
+   * of a domain together avoids most of the allocation overhead. */
+  CustomData_copy_layout_single_allocation(&me_src->vdata, &me_dst->vdata, mask.vmask, verts_len);
+  CustomData_copy_layout_single_allocation(&me_src->edata, &me_dst->edata, mask.emask, edges_len);
+  CustomData_copy_layout_single_allocation(&me_src->ldata, &me_dst->ldata, mask.lmask, loops_len);
+  CustomData_copy_layout_single_allocation(&me_src->pdata, &me_dst->pdata, mask.pmask, polys_len);
   if (do_tessface) {
     CustomData_copy(&me_src->fdata, &me_dst->fdata, mask.fmask, CD_SET_DEFAULT, tessface_len);
   }
@@ -243,6 +243,7 @@ void BKE_mesh_calc_edges(Mesh *mesh, bool keep_existing_edges, const bool select
   CustomData_reset(&mesh->edata);
   CustomData_add_layer(&mesh->edata, CD_MEDGE, CD_ASSIGN, new_edges.data(), new_totedge);
   mesh->totedge = new_totedge;
+  mesh->runtime->vert_to_edge_map_cache.tag_dirty();
 
   if (select_new_edges) {
     MutableAttributeAccessor attributes = mesh->attributes_for_write();
@@ -1105,6 +1105,7 @@ static void move_shapekey_layers_to_keyblocks(const Mesh &mesh,
       mesh.attributes().lookup<float3>("position").materialize(kb_coords);
     }
     else {
+      CustomData_ensure_layer_is_mutable(&layer, mesh.totvert);
       kb->data = layer.data;
       layer.data = nullptr;
     }
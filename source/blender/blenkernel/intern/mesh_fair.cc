@@ -8,6 +8,7 @@
 
 #include "BLI_map.hh"
 #include "BLI_math.h"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
@@ -27,7 +28,9 @@
 #include "eigen_capi.h"
 
 using blender::Array;
+using blender::double3;
 using blender::float3;
+using blender::IndexRange;
 using blender::Map;
 using blender::MutableSpan;
 using blender::Span;
@@ -46,6 +49,26 @@ class LoopWeight {
   virtual ~LoopWeight() = default;
 };
 
+/** Values of one row of the fairing matrix and of its right hand side. */
+struct FairingRow {
+  /** Column and value of the non-zero matrix values, accumulated in double precision like the
+   * solver does. */
+  Vector<std::pair<int, double>> values;
+  double3 rhs = double3(0.0);
+
+  void matrix_add(const int col, const double value)
+  {
+    /* The same column is added many times, merging them keeps the solver input small. */
+    for (std::pair<int, double> &item : values) {
+      if (item.first == col) {
+        item.second += value;
+        return;
+      }
+    }
+    values.append({col, value});
+  }
+};
+
 class FairingContext {
  public:
   /* Get coordinates of vertices which are adjacent to the loop with specified index. */
@@ -98,23 +121,19 @@ class FairingContext {
 
  private:
   void fair_setup_fairing(const int v,
-                          const int i,
-                          LinearSolver *solver,
+                          FairingRow &row,
                           float multiplier,
                           const int depth,
-                          Map<int, int> &vert_col_map,
+                          const Map<int, int> &vert_col_map,
                           VertexWeight *vertex_weight,
                           LoopWeight *loop_weight)
   {
     if (depth == 0) {
-      if (vert_col_map.contains(v)) {
-        const int j = vert_col_map.lookup(v);
-        EIG_linear_solver_matrix_add(solver, i, j, -multiplier);
+      if (const int *j = vert_col_map.lookup_ptr(v)) {
+        row.matrix_add(*j, -multiplier);
         return;
       }
-      for (int j = 0; j < 3; j++) {
-        EIG_linear_solver_right_hand_side_add(solver, j, i, multiplier * co_[v][j]);
-      }
+      row.rhs += double(multiplier) * double3(float3(co_[v]));
       return;
     }
 
@@ -127,8 +146,7 @@ class FairingContext {
       const float w_ij = loop_weight->weight_at_index(l_index);
       w_ij_sum += w_ij;
       fair_setup_fairing(other_vert,
-                         i,
-                         solver,
+                         row,
                          w_i * w_ij * multiplier,
                          depth - 1,
                          vert_col_map,
@@ -136,8 +154,7 @@ class FairingContext {
                          loop_weight);
     }
     fair_setup_fairing(v,
-                       i,
-                       solver,
+                       row,
                        -1 * w_i * w_ij_sum * multiplier,
                        depth - 1,
                        vert_col_map,
@@ -151,35 +168,54 @@ class FairingContext {
                      LoopWeight *loop_weight)
   {
     Map<int, int> vert_col_map;
-    int affected_verts_num = 0;
+    Vector<int> affected_verts;
     for (int i = 0; i < totvert_; i++) {
       if (!affected[i]) {
         continue;
       }
-      vert_col_map.add(i, affected_verts_num);
-      affected_verts_num++;
+      vert_col_map.add(i, affected_verts.size());
+      affected_verts.append(i);
     }
+    const int affected_verts_num = affected_verts.size();
 
     /* Early return, nothing to do. */
     if (ELEM(affected_verts_num, 0, totvert_)) {
       return;
     }
 
-    /* Setup fairing matrices */
+    /* Setup fairing matrices. The rows are computed in parallel, since the recursion over the
+     * neighborhood is the most expensive part. Adding them to the solver is not thread-safe. */
+    Array<FairingRow> rows(affected_verts_num);
+    blender::threading::parallel_for(
+        IndexRange(affected_verts_num), 256, [&](const IndexRange range) {
+          for (const int col : range) {
+            fair_setup_fairing(affected_verts[col],
+                               rows[col],
+                               1.0f,
+                               order,
+                               vert_col_map,
+                               vertex_weight,
+                               loop_weight);
+          }
+        });
+
     LinearSolver *solver = EIG_linear_solver_new(affected_verts_num, affected_verts_num, 3);
-    for (auto item : vert_col_map.items()) {
-      const int v = item.key;
-      const int col = item.value;
-      fair_setup_fairing(v, col, solver, 1.0f, order, vert_col_map, vertex_weight, loop_weight);
+    for (const int row_index : rows.index_range()) {
+      const FairingRow &row = rows[row_index];
+      for (const std::pair<int, double> &item : row.values) {
+        EIG_linear_solver_matrix_add(solver, row_index, item.first, item.second);
+      }
+      for (int j = 0; j < 3; j++) {
+        EIG_linear_solver_right_hand_side_add(solver, j, row_index, row.rhs[j]);
+      }
     }
 
     /* Solve linear system */
     EIG_linear_solver_solve(solver);
 
     /* Copy the result back to the mesh */
-    for (auto item : vert_col_map.items()) {
-      const int v = item.key;
-      const int col = item.value;
+    for (const int col : affected_verts.index_range()) {
+      const int v = affected_verts[col];
       for (int j = 0; j < 3; j++) {
         co_[v][j] = EIG_linear_solver_variable_get(solver, j, col);
       }
@@ -335,16 +371,18 @@ class UniformVertexWeight : public VertexWeight {
   UniformVertexWeight(FairingContext *fairing_context)
   {
     const int totvert = fairing_context->vertex_count_get();
-    vertex_weights_.reserve(totvert);
-    for (int i = 0; i < totvert; i++) {
-      const int tot_loop = fairing_context->vertex_loop_map_get(i)->count;
-      if (tot_loop != 0) {
-        vertex_weights_[i] = 1.0f / tot_loop;
-      }
-      else {
-        vertex_weights_[i] = FLT_MAX;
+    vertex_weights_.reinitialize(totvert);
+    blender::threading::parallel_for(IndexRange(totvert), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const int tot_loop = fairing_context->vertex_loop_map_get(i)->count;
+        if (tot_loop != 0) {
+          vertex_weights_[i] = 1.0f / tot_loop;
+        }
+        else {
+          vertex_weights_[i] = FLT_MAX;
+        }
       }
-    }
+    });
   }
 
   float weight_at_index(const int index) override
@@ -353,7 +391,7 @@ class UniformVertexWeight : public VertexWeight {
   }
 
  private:
-  Vector<float> vertex_weights_;
+  Array<float> vertex_weights_;
 };
 
 class VoronoiVertexWeight : public VertexWeight {
@@ -363,41 +401,42 @@ class VoronoiVertexWeight : public VertexWeight {
   {
 
     const int totvert = fairing_context->vertex_count_get();
-    vertex_weights_.reserve(totvert);
-    for (int i = 0; i < totvert; i++) {
-
-      float area = 0.0f;
-      float a[3];
-      copy_v3_v3(a, fairing_context->vertex_deformation_co_get(i));
-      const float acute_threshold = M_PI_2;
-
-      MeshElemMap *vlmap_elem = fairing_context->vertex_loop_map_get(i);
-      for (int l = 0; l < vlmap_elem->count; l++) {
-        const int l_index = vlmap_elem->indices[l];
-
-        float b[3], c[3], d[3];
-        fairing_context->adjacents_coords_from_loop(l_index, b, c);
-
-        if (angle_v3v3v3(c, fairing_context->vertex_deformation_co_get(i), b) < acute_threshold) {
-          calc_circumcenter(d, a, b, c);
-        }
-        else {
-          add_v3_v3v3(d, b, c);
-          mul_v3_fl(d, 0.5f);
+    vertex_weights_.reinitialize(totvert);
+    blender::threading::parallel_for(IndexRange(totvert), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        float area = 0.0f;
+        float a[3];
+        copy_v3_v3(a, fairing_context->vertex_deformation_co_get(i));
+        const float acute_threshold = M_PI_2;
+
+        MeshElemMap *vlmap_elem = fairing_context->vertex_loop_map_get(i);
+        for (int l = 0; l < vlmap_elem->count; l++) {
+          const int l_index = vlmap_elem->indices[l];
+
+          float b[3], c[3], d[3];
+          fairing_context->adjacents_coords_from_loop(l_index, b, c);
+
+          if (angle_v3v3v3(c, a, b) < acute_threshold) {
+            calc_circumcenter(d, a, b, c);
+          }
+          else {
+            add_v3_v3v3(d, b, c);
+            mul_v3_fl(d, 0.5f);
+          }
+
+          float t[3];
+          add_v3_v3v3(t, a, b);
+          mul_v3_fl(t, 0.5f);
+          area += area_tri_v3(a, t, d);
+
+          add_v3_v3v3(t, a, c);
+          mul_v3_fl(t, 0.5f);
+          area += area_tri_v3(a, d, t);
         }
 
-        float t[3];
-        add_v3_v3v3(t, a, b);
-        mul_v3_fl(t, 0.5f);
-        area += area_tri_v3(a, t, d);
-
-        add_v3_v3v3(t, a, c);
-        mul_v3_fl(t, 0.5f);
-        area += area_tri_v3(a, d, t);
+        vertex_weights_[i] = area != 0.0f ? 1.0f / area : 1e12;
       }
-
-      vertex_weights_[i] = area != 0.0f ? 1.0f / area : 1e12;
-    }
+    });
   }
 
   float weight_at_index(const int index) override
@@ -406,7 +445,7 @@ class VoronoiVertexWeight : public VertexWeight {
   }
 
  private:
-  Vector<float> vertex_weights_;
+  Array<float> vertex_weights_;
 
   void calc_circumcenter(float r[3], const float a[3], const float b[3], const float c[3])
   {
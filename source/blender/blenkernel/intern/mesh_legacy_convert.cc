@@ -1231,6 +1231,7 @@ void BKE_mesh_legacy_face_set_from_generic(Mesh *mesh,
   void *faceset_data = nullptr;
   for (CustomDataLayer &layer : poly_layers) {
     if (StringRef(layer.name) == ".sculpt_face_set") {
+      CustomData_ensure_layer_is_mutable(&layer, mesh->totpoly);
       faceset_data = layer.data;
       layer.data = nullptr;
       CustomData_free_layer_named(&mesh->pdata, ".sculpt_face_set", mesh->totpoly);
@@ -1252,6 +1253,7 @@ void BKE_mesh_legacy_face_set_to_generic(Mesh *mesh)
   void *faceset_data = nullptr;
   for (const int i : IndexRange(mesh->pdata.totlayer)) {
     if (mesh->pdata.layers[i].type == CD_SCULPT_FACE_SETS) {
+      CustomData_ensure_layer_is_mutable(&mesh->pdata.layers[i], mesh->totpoly);
       faceset_data = mesh->pdata.layers[i].data;
       mesh->pdata.layers[i].data = nullptr;
       CustomData_free_layer(&mesh->pdata, CD_SCULPT_FACE_SETS, mesh->totpoly, i);
@@ -9,6 +9,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_vec_types.h"
 
@@ -21,6 +22,7 @@
 
 #include "BKE_customdata.h"
 #include "BKE_mesh_mapping.h"
+#include "BKE_mesh_types.h"
 #include "BLI_memarena.h"
 
 #include "BLI_strict_flags.h"
@@ -619,6 +621,29 @@ Vector<Vector<int>> build_edge_to_loop_map_resizable(const Span<MLoop> loops, co
   return map;
 }
 
+Span<int> loop_to_poly_map(const Mesh &mesh)
+{
+  mesh.runtime->loop_to_poly_map_cache.ensure(
+      [&](Array<int> &r_data) { r_data = build_loop_to_poly_map(mesh.polys(), mesh.totloop); });
+  return mesh.runtime->loop_to_poly_map_cache.data();
+}
+
+Span<Vector<int>> vert_to_edge_map(const Mesh &mesh)
+{
+  mesh.runtime->vert_to_edge_map_cache.ensure([&](Array<Vector<int>> &r_data) {
+    r_data = build_vert_to_edge_map(mesh.edges(), mesh.totvert);
+  });
+  return mesh.runtime->vert_to_edge_map_cache.data();
+}
+
+Span<Vector<int>> vert_to_loop_map(const Mesh &mesh)
+{
+  mesh.runtime->vert_to_loop_map_cache.ensure([&](Array<Vector<int>> &r_data) {
+    r_data = build_vert_to_loop_map(mesh.loops(), mesh.totvert);
+  });
+  return mesh.runtime->vert_to_loop_map_cache.data();
+}
+
 }  // namespace blender::bke::mesh_topology
 
 /** \} */
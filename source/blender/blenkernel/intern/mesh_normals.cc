@@ -25,10 +25,10 @@
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
 #include "BLI_stack.h"
-#include "BLI_task.h"
 #include "BLI_task.hh"
 #include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.h"
@@ -46,6 +46,7 @@ using blender::MutableSpan;
 using blender::short2;
 using blender::Span;
 using blender::VArray;
+using blender::Vector;
 
 // #define DEBUG_TIME
 
@@ -746,25 +747,6 @@ void BKE_lnor_space_custom_normal_to_data(const MLoopNorSpace *lnor_space,
   }
 }
 
-#define LOOP_SPLIT_TASK_BLOCK_SIZE 1024
-
-struct LoopSplitTaskData {
-  enum class Type : int8_t {
-    BlockEnd = 0, /* Set implicitly by calloc. */
-    Fan = 1,
-    Single = 2,
-  };
-
-  /** We have to create those outside of tasks, since #MemArena is not thread-safe. */
-  MLoopNorSpace *lnor_space;
-  int ml_curr_index;
-  /** Also used a flag to switch between single or fan process! */
-  int ml_prev_index;
-  int mp_index;
-
-  Type flag;
-};
-
 struct LoopSplitTaskDataCommon {
   /* Read/write.
    * Note we do not need to protect it, though, since two different tasks will *always* affect
@@ -935,7 +917,9 @@ static void loop_manifold_fan_around_vert_next(const Span<MLoop> loops,
   }
 }
 
-static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data, LoopSplitTaskData *data)
+static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data,
+                                     MLoopNorSpace *lnor_space,
+                                     const int ml_curr_index)
 {
   MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
   const Span<short2> clnors_data = common_data->clnors_data;
@@ -943,13 +927,14 @@ static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data, LoopS
   const Span<float3> positions = common_data->positions;
   const Span<MEdge> edges = common_data->edges;
   const Span<MLoop> loops = common_data->loops;
+  const Span<MPoly> polys = common_data->polys;
+  const Span<int> loop_to_poly = common_data->loop_to_poly;
   const Span<float3> poly_normals = common_data->poly_normals;
   MutableSpan<float3> loop_normals = common_data->loop_normals;
 
-  MLoopNorSpace *lnor_space = data->lnor_space;
-  const int ml_curr_index = data->ml_curr_index;
-  const int ml_prev_index = data->ml_prev_index;
-  const int mp_index = data->mp_index;
+  const int mp_index = loop_to_poly[ml_curr_index];
+  const int ml_prev_index = blender::bke::mesh_topology::poly_loop_prev(polys[mp_index],
+                                                                        ml_curr_index);
 
   /* Simple case (both edges around that vertex are sharp in current polygon),
    * this loop just takes its poly normal.
@@ -991,7 +976,8 @@ static void split_loop_nor_single_do(LoopSplitTaskDataCommon *common_data, LoopS
 }
 
 static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data,
-                                  LoopSplitTaskData *data,
+                                  MLoopNorSpace *lnor_space,
+                                  const int ml_curr_index,
                                   BLI_Stack *edge_vectors)
 {
   MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
@@ -1006,13 +992,9 @@ static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data,
   const Span<int> loop_to_poly = common_data->loop_to_poly;
   const Span<float3> poly_normals = common_data->poly_normals;
 
-  MLoopNorSpace *lnor_space = data->lnor_space;
-#if 0 /* Not needed for 'fan' loops. */
-  float(*lnor)[3] = data->lnor;
-#endif
-  const int ml_curr_index = data->ml_curr_index;
-  const int ml_prev_index = data->ml_prev_index;
-  const int mp_index = data->mp_index;
+  const int mp_index = loop_to_poly[ml_curr_index];
+  const int ml_prev_index = blender::bke::mesh_topology::poly_loop_prev(polys[mp_index],
+                                                                        ml_curr_index);
 
   /* Sigh! we have to fan around current vertex, until we find the other non-smooth edge,
    * and accumulate face normals into the vertex!
@@ -1191,43 +1173,6 @@ static void split_loop_nor_fan_do(LoopSplitTaskDataCommon *common_data,
   }
 }
 
-static void loop_split_worker_do(LoopSplitTaskDataCommon *common_data,
-                                 LoopSplitTaskData *data,
-                                 BLI_Stack *edge_vectors)
-{
-  if (data->flag == LoopSplitTaskData::Type::Fan) {
-    BLI_assert((edge_vectors == nullptr) || BLI_stack_is_empty(edge_vectors));
-    split_loop_nor_fan_do(common_data, data, edge_vectors);
-  }
-  else {
-    /* No need for edge_vectors for 'single' case! */
-    split_loop_nor_single_do(common_data, data);
-  }
-}
-
-static void loop_split_worker(TaskPool *__restrict pool, void *taskdata)
-{
-  LoopSplitTaskDataCommon *common_data = (LoopSplitTaskDataCommon *)BLI_task_pool_user_data(pool);
-  LoopSplitTaskData *data = (LoopSplitTaskData *)taskdata;
-
-  /* Temp edge vectors stack, only used when computing lnor spacearr. */
-  BLI_Stack *edge_vectors = common_data->lnors_spacearr ?
-                                BLI_stack_new(sizeof(float[3]), __func__) :
-                                nullptr;
-
-  for (int i = 0; i < LOOP_SPLIT_TASK_BLOCK_SIZE; i++, data++) {
-    if (data->flag == LoopSplitTaskData::Type::BlockEnd) {
-      break;
-    }
-
-    loop_split_worker_do(common_data, data, edge_vectors);
-  }
-
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
-  }
-}
-
 /**
  * Check whether given loop is part of an unknown-so-far cyclic smooth fan, or not.
  * Needed because cyclic smooth fans have no obvious 'entry point',
@@ -1297,11 +1242,17 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const Span<MLoop> mloop
   }
 }
 
-static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common_data)
+/**
+ * Find the corners that start a new smooth fan (or are alone in a "single" fan, when both
+ * edges around the vertex are sharp in that polygon), so that all fans can be processed in
+ * parallel afterwards.
+ */
+static void loop_split_generator(const LoopSplitTaskDataCommon *common_data,
+                                 Vector<int> &r_single_corners,
+                                 Vector<int> &r_fan_corners)
 {
   using namespace blender;
   using namespace blender::bke;
-  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
 
   const Span<MLoop> loops = common_data->loops;
   const Span<MPoly> polys = common_data->polys;
@@ -1310,23 +1261,10 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
 
   BitVector<> skip_loops(loops.size(), false);
 
-  LoopSplitTaskData *data_buff = nullptr;
-  int data_idx = 0;
-
-  /* Temp edge vectors stack, only used when computing lnor spacearr
-   * (and we are not multi-threading). */
-  BLI_Stack *edge_vectors = nullptr;
-
 #ifdef DEBUG_TIME
   SCOPED_TIMER_AVERAGED(__func__);
 #endif
 
-  if (!pool) {
-    if (lnors_spacearr) {
-      edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
-    }
-  }
-
   /* We now know edges that can be smoothed (with their vector, and their two loops),
    * and edges that will be hard! Now, time to generate the normals.
    */
@@ -1369,31 +1307,9 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
         // printf("SKIPPING!\n");
       }
       else {
-        LoopSplitTaskData *data, data_local;
-
-        // printf("PROCESSING!\n");
-
-        if (pool) {
-          if (data_idx == 0) {
-            data_buff = (LoopSplitTaskData *)MEM_calloc_arrayN(
-                LOOP_SPLIT_TASK_BLOCK_SIZE, sizeof(*data_buff), __func__);
-          }
-          data = &data_buff[data_idx];
-        }
-        else {
-          data = &data_local;
-          memset(data, 0, sizeof(*data));
-        }
-
         if (IS_EDGE_SHARP(edge_to_loops[loops[ml_curr_index].e]) &&
             IS_EDGE_SHARP(edge_to_loops[loops[ml_prev_index].e])) {
-          data->ml_curr_index = ml_curr_index;
-          data->ml_prev_index = ml_prev_index;
-          data->flag = LoopSplitTaskData::Type::Single;
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
+          r_single_corners.append(ml_curr_index);
         }
         else {
           /* We do not need to check/tag loops as already computed. Due to the fact that a loop
@@ -1403,36 +1319,11 @@ static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common
            * current edge, smooth previous edge), and not the alternative (smooth current edge,
            * sharp previous edge). All this due/thanks to the link between normals and loop
            * ordering (i.e. winding). */
-          data->ml_curr_index = ml_curr_index;
-          data->ml_prev_index = ml_prev_index;
-          data->flag = LoopSplitTaskData::Type::Fan;
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
-
-        if (pool) {
-          data_idx++;
-          if (data_idx == LOOP_SPLIT_TASK_BLOCK_SIZE) {
-            BLI_task_pool_push(pool, loop_split_worker, data_buff, true, nullptr);
-            data_idx = 0;
-          }
-        }
-        else {
-          loop_split_worker_do(common_data, data, edge_vectors);
+          r_fan_corners.append(ml_curr_index);
         }
       }
     }
   }
-
-  if (pool && data_idx) {
-    BLI_task_pool_push(pool, loop_split_worker, data_buff, true, nullptr);
-  }
-
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
-  }
 }
 
 void BKE_mesh_normals_loop_split(const float (*vert_positions)[3],
@@ -1569,19 +1460,39 @@ void BKE_mesh_normals_loop_split(const float (*vert_positions)[3],
                        edge_to_loops,
                        {});
 
-  if (numLoops < LOOP_SPLIT_TASK_BLOCK_SIZE * 8) {
-    /* Not enough loops to be worth the whole threading overhead. */
-    loop_split_generator(nullptr, &common_data);
-  }
-  else {
-    TaskPool *task_pool = BLI_task_pool_create(&common_data, TASK_PRIORITY_HIGH);
+  Vector<int> single_corners;
+  Vector<int> fan_corners;
+  loop_split_generator(&common_data, single_corners, fan_corners);
 
-    loop_split_generator(task_pool, &common_data);
+  /* Allocate all spaces at once, since #MemArena is not thread-safe. The spaces of the single
+   * corners come first, followed by the spaces of the fans. */
+  MLoopNorSpace *lnor_spaces = nullptr;
+  if (r_lnors_spacearr) {
+    const int64_t spaces_num = single_corners.size() + fan_corners.size();
+    r_lnors_spacearr->spaces_num += int(spaces_num);
+    lnor_spaces = static_cast<MLoopNorSpace *>(BLI_memarena_calloc(
+        r_lnors_spacearr->mem, sizeof(MLoopNorSpace) * size_t(spaces_num)));
+  }
 
-    BLI_task_pool_work_and_wait(task_pool);
+  threading::parallel_for(single_corners.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      split_loop_nor_single_do(
+          &common_data, lnor_spaces ? &lnor_spaces[i] : nullptr, single_corners[i]);
+    }
+  });
 
-    BLI_task_pool_free(task_pool);
-  }
+  threading::parallel_for(fan_corners.index_range(), 1024, [&](const IndexRange range) {
+    /* Temp edge vectors stack, only used when computing lnor spacearr. */
+    BLI_Stack *edge_vectors = r_lnors_spacearr ? BLI_stack_new(sizeof(float[3]), __func__) :
+                                                 nullptr;
+    for (const int i : range) {
+      MLoopNorSpace *lnor_space = lnor_spaces ? &lnor_spaces[single_corners.size() + i] : nullptr;
+      split_loop_nor_fan_do(&common_data, lnor_space, fan_corners[i], edge_vectors);
+    }
+    if (edge_vectors) {
+      BLI_stack_free(edge_vectors);
+    }
+  });
 
   if (r_lnors_spacearr) {
     if (r_lnors_spacearr == &_lnors_spacearr) {
@@ -193,16 +193,20 @@ static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
   std::vector<openvdb::Vec3s> points(mesh->totvert);
   std::vector<openvdb::Vec3I> triangles(looptris.size());
 
-  for (const int i : IndexRange(mesh->totvert)) {
-    const float3 &co = positions[i];
-    points[i] = openvdb::Vec3s(co.x, co.y, co.z);
-  }
+  blender::threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float3 &co = positions[i];
+      points[i] = openvdb::Vec3s(co.x, co.y, co.z);
+    }
+  });
 
-  for (const int i : IndexRange(looptris.size())) {
-    const MLoopTri &loop_tri = looptris[i];
-    triangles[i] = openvdb::Vec3I(
-        loops[loop_tri.tri[0]].v, loops[loop_tri.tri[1]].v, loops[loop_tri.tri[2]].v);
-  }
+  blender::threading::parallel_for(looptris.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MLoopTri &loop_tri = looptris[i];
+      triangles[i] = openvdb::Vec3I(
+          loops[loop_tri.tri[0]].v, loops[loop_tri.tri[1]].v, loops[loop_tri.tri[2]].v);
+    }
+  });
 
   openvdb::math::Transform::Ptr transform = openvdb::math::Transform::createLinearTransform(
       voxel_size);
@@ -229,31 +233,40 @@ static Mesh *remesh_voxel_volume_to_mesh(const openvdb::FloatGrid::Ptr level_set
   MutableSpan<MPoly> mesh_polys = mesh->polys_for_write();
   MutableSpan<MLoop> mesh_loops = mesh->loops_for_write();
 
-  for (const int i : vert_positions.index_range()) {
-    vert_positions[i] = float3(vertices[i].x(), vertices[i].y(), vertices[i].z());
-  }
+  /* The output of the extraction is written in parallel, since for high resolutions copying it
+   * serially takes a noticeable part of the whole remesh. */
+  blender::threading::parallel_for(
+      vert_positions.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          vert_positions[i] = float3(vertices[i].x(), vertices[i].y(), vertices[i].z());
+        }
+      });
 
-  for (const int i : IndexRange(quads.size())) {
-    MPoly &poly = mesh_polys[i];
-    const int loopstart = i * 4;
-    poly.loopstart = loopstart;
-    poly.totloop = 4;
-    mesh_loops[loopstart].v = quads[i][0];
-    mesh_loops[loopstart + 1].v = quads[i][3];
-    mesh_loops[loopstart + 2].v = quads[i][2];
-    mesh_loops[loopstart + 3].v = quads[i][1];
-  }
+  blender::threading::parallel_for(IndexRange(quads.size()), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      MPoly &poly = mesh_polys[i];
+      const int loopstart = i * 4;
+      poly.loopstart = loopstart;
+      poly.totloop = 4;
+      mesh_loops[loopstart].v = quads[i][0];
+      mesh_loops[loopstart + 1].v = quads[i][3];
+      mesh_loops[loopstart + 2].v = quads[i][2];
+      mesh_loops[loopstart + 3].v = quads[i][1];
+    }
+  });
 
   const int triangle_loop_start = quads.size() * 4;
-  for (const int i : IndexRange(tris.size())) {
-    MPoly &poly = mesh_polys[quads.size() + i];
-    const int loopstart = triangle_loop_start + i * 3;
-    poly.loopstart = loopstart;
-    poly.totloop = 3;
-    mesh_loops[loopstart].v = tris[i][2];
-    mesh_loops[loopstart + 1].v = tris[i][1];
-    mesh_loops[loopstart + 2].v = tris[i][0];
-  }
+  blender::threading::parallel_for(IndexRange(tris.size()), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      MPoly &poly = mesh_polys[quads.size() + i];
+      const int loopstart = triangle_loop_start + i * 3;
+      poly.loopstart = loopstart;
+      poly.totloop = 3;
+      mesh_loops[loopstart].v = tris[i][2];
+      mesh_loops[loopstart + 1].v = tris[i][1];
+      mesh_loops[loopstart + 2].v = tris[i][0];
+    }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
 
@@ -78,6 +78,13 @@ static void free_bvh_cache(MeshRuntime &mesh_runtime)
   }
 }
 
+static void tag_bvh_cache_positions_changed(MeshRuntime &mesh_runtime)
+{
+  if (mesh_runtime.bvh_cache) {
+    bvhcache_tag_positions_changed(mesh_runtime.bvh_cache);
+  }
+}
+
 static void free_normals(MeshRuntime &mesh_runtime)
 {
   MEM_SAFE_FREE(mesh_runtime.vert_normals);
@@ -230,6 +237,9 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->bounds_cache.tag_dirty();
   mesh->runtime->loose_edges_cache.tag_dirty();
   mesh->runtime->looptris_cache.tag_dirty();
+  mesh->runtime->loop_to_poly_map_cache.tag_dirty();
+  mesh->runtime->vert_to_edge_map_cache.tag_dirty();
+  mesh->runtime->vert_to_loop_map_cache.tag_dirty();
   if (mesh->runtime->shrinkwrap_data) {
     BKE_shrinkwrap_boundary_data_free(mesh->runtime->shrinkwrap_data);
   }
@@ -245,24 +255,39 @@ void BKE_mesh_tag_edges_split(struct Mesh *mesh)
   free_normals(*mesh->runtime);
   free_subdiv_ccg(*mesh->runtime);
   mesh->runtime->loose_edges_cache.tag_dirty();
+  mesh->runtime->vert_to_edge_map_cache.tag_dirty();
   if (mesh->runtime->shrinkwrap_data) {
     BKE_shrinkwrap_boundary_data_free(mesh->runtime->shrinkwrap_data);
   }
   MEM_SAFE_FREE(mesh->runtime->subsurf_face_dot_tags);
 }
 
+/**
+ * The triangulation of triangles never depends on the vertex positions. For other faces it is
+ * only kept when the mesh asks for it, to avoid re-triangulating deforming meshes.
+ */
+static bool triangulation_depends_on_positions(const Mesh &mesh)
+{
+  if (mesh.flag & ME_STABLE_TRIANGULATION) {
+    return false;
+  }
+  return mesh.totloop != mesh.totpoly * 3;
+}
+
 void BKE_mesh_tag_coords_changed(Mesh *mesh)
 {
   BKE_mesh_normals_tag_dirty(mesh);
-  free_bvh_cache(*mesh->runtime);
-  mesh->runtime->looptris_cache.tag_dirty();
+  tag_bvh_cache_positions_changed(*mesh->runtime);
+  if (triangulation_depends_on_positions(*mesh)) {
+    mesh->runtime->looptris_cache.tag_dirty();
+  }
   mesh->runtime->bounds_cache.tag_dirty();
 }
 
 void BKE_mesh_tag_coords_changed_uniformly(Mesh *mesh)
 {
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
-  free_bvh_cache(*mesh->runtime);
+  tag_bvh_cache_positions_changed(*mesh->runtime);
   mesh->runtime->bounds_cache.tag_dirty();
 }
 
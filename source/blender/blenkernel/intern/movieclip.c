@@ -637,7 +637,7 @@ static ImBuf *movieclip_load_sequence_file(MovieClip *clip,
     colorspace = clip->colorspace_settings.name;
   }
 
-  loadflag = IB_rect | IB_multilayer | IB_alphamode_detect | IB_metadata;
+  loadflag = IB_rect | IB_multilayer | IB_multilayer_combined | IB_alphamode_detect | IB_metadata;
 
   /* read ibuf */
   ibuf = IMB_loadiffname(name, loadflag, colorspace);
@@ -682,7 +682,8 @@ static ImBuf *movieclip_load_movie_file(MovieClip *clip,
   if (clip->anim) {
     int fra = framenr - clip->start_frame + clip->frame_offset;
 
-    ibuf = IMB_anim_absolute(clip->anim, fra, tc, proxy);
+    /* Share decoded frames with sequencer strips using the same movie file. */
+    ibuf = IMB_anim_absolute_shared(clip->anim, fra, tc, proxy);
   }
 
   return ibuf;
@@ -92,6 +92,8 @@ struct DupliContext {
   Scene *scene;
   /** Root parent object at the scene level. */
   Object *root_object;
+  /** Hash of the name of #root_object, used for the random number of every instance. */
+  uint root_object_name_hash;
   /** Immediate parent object in the context. */
   Object *object;
   float space_mat[4][4];
@@ -154,6 +156,7 @@ static void init_context(DupliContext *r_ctx,
   r_ctx->collection = nullptr;
 
   r_ctx->root_object = ob;
+  r_ctx->root_object_name_hash = BLI_hash_int(BLI_hash_string(ob->id.name + 2));
   r_ctx->object = ob;
   r_ctx->obedit = OBEDIT_FROM_OBACT(ob);
   r_ctx->instance_stack = &instance_stack;
@@ -302,7 +305,7 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   }
 
   if (ctx->root_object != ob) {
-    dob->random_id ^= BLI_hash_int(BLI_hash_string(ctx->root_object->id.name + 2));
+    dob->random_id ^= ctx->root_object_name_hash;
   }
 
   return dob;
@@ -318,6 +321,15 @@ static DupliObject *make_dupli(const DupliContext *ctx,
   return make_dupli(ctx, ob, static_cast<ID *>(ob->data), mat, index, geometry, instance_index);
 }
 
+/**
+ * Quick check to avoid setting up a sub-context for every instance of objects that can't have
+ * instances themselves, see #get_dupli_generator.
+ */
+static bool object_may_generate_duplis(const Object *ob)
+{
+  return (ob->transflag & OB_DUPLI) != 0 || ob->runtime.geometry_set_eval != nullptr;
+}
+
 /**
  * Recursive dupli-objects.
  *
@@ -330,6 +342,9 @@ static void make_recursive_duplis(const DupliContext *ctx,
                                   const GeometrySet *geometry = nullptr,
                                   int64_t instance_index = 0)
 {
+  if (!object_may_generate_duplis(ob)) {
+    return;
+  }
   if (ctx->instance_stack->contains(ob)) {
     /* Avoid recursive instances. */
     printf("Warning: '%s' object is trying to instance itself.\n", ob->id.name + 2);
@@ -959,6 +974,9 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
         mul_m4_m4m4(matrix, parent_transform, instance_offset_matrices[i].values);
         make_dupli(ctx_for_instance, &object, matrix, id, &geometry_set, i);
 
+        if (!object_may_generate_duplis(&object)) {
+          break;
+        }
         float space_matrix[4][4];
         mul_m4_m4m4(space_matrix, instance_offset_matrices[i].values, object.world_to_object);
         mul_m4_m4_pre(space_matrix, parent_transform);
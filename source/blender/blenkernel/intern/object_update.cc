@@ -134,6 +134,7 @@ void BKE_object_eval_transform_final(Depsgraph *depsgraph, Object *ob)
 void BKE_object_handle_data_update(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
+  MEM_TagScope mem_tag(MEM_TAG_GEOMETRY);
 
   /* includes all keys and modifiers */
   switch (ob->type) {
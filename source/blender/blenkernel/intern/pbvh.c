@@ -36,6 +36,7 @@
 #include "pbvh_intern.h"
 
 #include <limits.h>
+#include <stdlib.h>
 
 #define LEAF_LIMIT 10000
 
@@ -304,6 +305,13 @@ static int map_insert_vert(PBVH *pbvh, GHash *map, uint *face_verts, uint *uniq_
   return POINTER_AS_INT(*value_p);
 }
 
+static int vert_index_cmp(const void *a, const void *b)
+{
+  const int index_a = *(const int *)a;
+  const int index_b = *(const int *)b;
+  return (index_a > index_b) - (index_a < index_b);
+}
+
 /* Find vertices used by the faces in this node and update the draw buffers */
 static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
 {
@@ -354,13 +362,22 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
   }
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+  /* The hash map iteration order is effectively random. Sort the unique and the shared vertices
+   * separately, so that iterating over the vertices of the node accesses the mesh data in memory
+   * order. */
+  qsort(vert_indices, node->uniq_verts, sizeof(int), vert_index_cmp);
+  qsort(vert_indices + node->uniq_verts, node->face_verts, sizeof(int), vert_index_cmp);
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+  for (int i = 0; i < node->uniq_verts + node->face_verts; i++) {
+    void **value_p = BLI_ghash_lookup_p(map, POINTER_FROM_INT(vert_indices[i]));
+    *value_p = POINTER_FROM_INT(i);
+  }
+
+  for (int i = 0; i < totface; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = POINTER_AS_INT(
+          BLI_ghash_lookup(map, POINTER_FROM_INT(pbvh->mloop[lt->tri[j]].v)));
     }
   }
 
@@ -1655,6 +1672,9 @@ static void pbvh_update_draw_buffer_cb(void *__restrict userdata,
       PBVH_GPU_Args args;
 
       pbvh_draw_args_init(pbvh, &args, node);
+      /* BMesh nodes fill their buffers in one go, so they always update everything. */
+      args.update_only_mask_and_color = !(node->flag & PBVH_UpdateDrawBuffersAll) &&
+                                        pbvh->header.type != PBVH_BMESH;
       DRW_pbvh_node_update(node->draw_batches, &args);
     }
   }
@@ -1727,7 +1747,7 @@ static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode,
       }
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers | PBVH_UpdateDrawBuffersAll);
   }
 }
 
@@ -2080,7 +2100,8 @@ int BKE_pbvh_get_grid_num_faces(const PBVH *pbvh)
 void BKE_pbvh_node_mark_update(PBVHNode *node)
 {
   node->flag |= PBVH_UpdateNormals | PBVH_UpdateBB | PBVH_UpdateOriginalBB |
-                PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw | PBVH_RebuildPixels;
+                PBVH_UpdateDrawBuffers | PBVH_UpdateDrawBuffersAll | PBVH_UpdateRedraw |
+                PBVH_RebuildPixels;
 }
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
@@ -2095,7 +2116,7 @@ void BKE_pbvh_node_mark_update_color(PBVHNode *node)
 
 void BKE_pbvh_node_mark_update_face_sets(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateDrawBuffersAll | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_mark_rebuild_pixels(PBVH *pbvh)
@@ -2111,17 +2132,18 @@ void BKE_pbvh_mark_rebuild_pixels(PBVH *pbvh)
 void BKE_pbvh_node_mark_update_visibility(PBVHNode *node)
 {
   node->flag |= PBVH_UpdateVisibility | PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers |
-                PBVH_UpdateRedraw;
+                PBVH_UpdateDrawBuffersAll | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_rebuild_draw(PBVHNode *node)
 {
-  node->flag |= PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers | PBVH_UpdateDrawBuffersAll |
+                PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_redraw(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateDrawBuffersAll | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_normals_update(PBVHNode *node)
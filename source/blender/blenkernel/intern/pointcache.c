@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -872,6 +873,7 @@ void BKE_ptcache_id_from_softbody(PTCacheID *pid, Object *ob, SoftBody *sb)
   pid->write_point = ptcache_softbody_write;
   pid->read_point = ptcache_softbody_read;
   pid->interpolate_point = ptcache_softbody_interpolate;
+  pid->flag |= PTCACHE_POINTS_INDEPENDENT;
 
   pid->write_stream = NULL;
   pid->read_stream = NULL;
@@ -915,6 +917,7 @@ void BKE_ptcache_id_from_particles(PTCacheID *pid, Object *ob, ParticleSystem *p
   pid->write_point = ptcache_particle_write;
   pid->read_point = ptcache_particle_read;
   pid->interpolate_point = ptcache_particle_interpolate;
+  pid->flag |= PTCACHE_POINTS_INDEPENDENT;
 
   pid->write_stream = NULL;
   pid->read_stream = NULL;
@@ -971,6 +974,7 @@ void BKE_ptcache_id_from_cloth(PTCacheID *pid, Object *ob, ClothModifierData *cl
   pid->write_point = ptcache_cloth_write;
   pid->read_point = ptcache_cloth_read;
   pid->interpolate_point = ptcache_cloth_interpolate;
+  pid->flag |= PTCACHE_POINTS_INDEPENDENT;
 
   pid->write_stream = NULL;
   pid->read_stream = NULL;
@@ -1624,19 +1628,6 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, uint tot, uint siz
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
-{
-  int i;
-
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
-    }
-  }
-
-  return 1;
-}
 static int ptcache_file_data_write(PTCacheFile *pf)
 {
   int i;
@@ -1957,19 +1948,32 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
+    else if (pm->totpoint > 0) {
+      /* Uncompressed points are stored interleaved. Read all of them at once and split them into
+       * the arrays of the memory cache, rather than reading every value separately. */
+      uint point_size = 0;
+      for (i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pm->data_types & (1 << i)) {
+          point_size += ptcache_data_size[i];
+        }
+      }
 
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
+      char *points = MEM_mallocN((size_t)pm->totpoint * point_size, "PTCache points");
+      if (ptcache_file_read(pf, points, pm->totpoint, point_size)) {
+        const char *src = points;
+        for (uint p = 0; p < pm->totpoint; p++) {
+          for (i = 0; i < BPHYS_TOT_DATA; i++) {
+            if (pm->data_types & (1 << i)) {
+              memcpy((char *)pm->data[i] + p * ptcache_data_size[i], src, ptcache_data_size[i]);
+              src += ptcache_data_size[i];
+            }
+          }
         }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
       }
+      else {
+        error = 1;
+      }
+      MEM_freeN(points);
     }
   }
 
@@ -2154,11 +2158,68 @@ static int ptcache_read_stream(PTCacheID *pid, int cfra)
   return error == 0;
 }
 
+typedef struct PTCacheReadPointsData {
+  PTCacheID *pid;
+  PTCacheMem *pm;
+  float cfra, cfra1, cfra2;
+  bool interpolate;
+} PTCacheReadPointsData;
+
+static void ptcache_read_points_cb(void *__restrict userdata,
+                                   const int point,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PTCacheReadPointsData *data = userdata;
+  PTCacheID *pid = data->pid;
+  PTCacheMem *pm = data->pm;
+  void *cur[BPHYS_TOT_DATA];
+
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    cur[i] = (pm->data_types & (1 << i)) ? (char *)pm->data[i] + point * ptcache_data_size[i] :
+                                           NULL;
+  }
+
+  const int index = cur[BPHYS_DATA_INDEX] ? *(int *)cur[BPHYS_DATA_INDEX] : point;
+
+  if (data->interpolate) {
+    pid->interpolate_point(index, pid->calldata, cur, data->cfra, data->cfra1, data->cfra2, NULL);
+  }
+  else {
+    pid->read_point(index, pid->calldata, cur, data->cfra, NULL);
+  }
+}
+
+/**
+ * Copy the first `totpoint` points of the memory cache to the simulation data, or interpolate
+ * towards them. Points are processed in parallel when their callbacks allow it.
+ */
+static void ptcache_read_points(PTCacheID *pid,
+                                PTCacheMem *pm,
+                                const int totpoint,
+                                const float cfra,
+                                const float cfra1,
+                                const float cfra2,
+                                const bool interpolate)
+{
+  PTCacheReadPointsData data = {
+      .pid = pid,
+      .pm = pm,
+      .cfra = cfra,
+      .cfra1 = cfra1,
+      .cfra2 = cfra2,
+      .interpolate = interpolate,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (pid->flag & PTCACHE_POINTS_INDEPENDENT) != 0;
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, totpoint, &data, ptcache_read_points_cb, &settings);
+}
+
 static int ptcache_read(PTCacheID *pid, int cfra)
 {
   PTCacheMem *pm = NULL;
-  int i;
-  int *index = &i;
 
   /* get a memory cache to read from */
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
@@ -2185,18 +2246,7 @@ static int ptcache_read(PTCacheID *pid, int cfra)
       }
     }
 
-    void *cur[BPHYS_TOT_DATA];
-    BKE_ptcache_mem_pointers_init(pm, cur);
-
-    for (i = 0; i < totpoint; i++) {
-      if (pm->data_types & (1 << BPHYS_DATA_INDEX)) {
-        index = cur[BPHYS_DATA_INDEX];
-      }
-
-      pid->read_point(*index, pid->calldata, cur, (float)pm->frame, NULL);
-
-      BKE_ptcache_mem_pointers_incr(cur);
-    }
+    ptcache_read_points(pid, pm, totpoint, (float)pm->frame, 0.0f, 0.0f, false);
 
     if (pid->read_extra_data && pm->extradata.first) {
       pid->read_extra_data(pid->calldata, pm, (float)pm->frame);
@@ -2214,8 +2264,6 @@ static int ptcache_read(PTCacheID *pid, int cfra)
 static int ptcache_interpolate(PTCacheID *pid, float cfra, int cfra1, int cfra2)
 {
   PTCacheMem *pm = NULL;
-  int i;
-  int *index = &i;
 
   /* get a memory cache to read from */
   if (pid->cache->flag & PTCACHE_DISK_CACHE) {
@@ -2242,17 +2290,7 @@ static int ptcache_interpolate(PTCacheID *pid, float cfra, int cfra1, int cfra2)
       }
     }
 
-    void *cur[BPHYS_TOT_DATA];
-    BKE_ptcache_mem_pointers_init(pm, cur);
-
-    for (i = 0; i < totpoint; i++) {
-      if (pm->data_types & (1 << BPHYS_DATA_INDEX)) {
-        index = cur[BPHYS_DATA_INDEX];
-      }
-
-      pid->interpolate_point(*index, pid->calldata, cur, cfra, (float)cfra1, (float)cfra2, NULL);
-      BKE_ptcache_mem_pointers_incr(cur);
-    }
+    ptcache_read_points(pid, pm, totpoint, cfra, (float)cfra1, (float)cfra2, true);
 
     if (pid->interpolate_extra_data && pm->extradata.first) {
       pid->interpolate_extra_data(pid->calldata, pm, cfra, (float)cfra1, (float)cfra2);
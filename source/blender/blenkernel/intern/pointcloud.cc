@@ -13,6 +13,7 @@
 
 #include "BLI_bounds.hh"
 #include "BLI_index_range.hh"
+#include "BLI_kdopbvh.h"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.hh"
 #include "BLI_rand.h"
@@ -78,7 +79,13 @@ static void pointcloud_copy_data(Main * /*bmain*/, ID *id_dst, const ID *id_src,
   const PointCloud *pointcloud_src = (const PointCloud *)id_src;
   pointcloud_dst->mat = static_cast<Material **>(MEM_dupallocN(pointcloud_src->mat));
 
-  const eCDAllocType alloc_type = (flag & LIB_ID_COPY_CD_REFERENCE) ? CD_REFERENCE : CD_DUPLICATE;
+  eCDAllocType alloc_type = CD_DUPLICATE;
+  if (flag & LIB_ID_COPY_CD_REFERENCE) {
+    alloc_type = CD_REFERENCE;
+  }
+  else if (flag & (LIB_ID_COPY_SET_COPIED_ON_WRITE | LIB_ID_CREATE_NO_MAIN)) {
+    alloc_type = CD_SHARE;
+  }
   CustomData_copy(&pointcloud_src->pdata,
                   &pointcloud_dst->pdata,
                   CD_MASK_ALL,
@@ -87,6 +94,7 @@ static void pointcloud_copy_data(Main * /*bmain*/, ID *id_dst, const ID *id_src,
 
   pointcloud_dst->runtime = new blender::bke::PointCloudRuntime();
   pointcloud_dst->runtime->bounds_cache = pointcloud_src->runtime->bounds_cache;
+  pointcloud_dst->runtime->bvh_cache = pointcloud_src->runtime->bvh_cache;
 
   pointcloud_dst->batch_cache = nullptr;
 }
@@ -432,6 +440,7 @@ void BKE_pointcloud_data_update(struct Depsgraph *depsgraph, struct Scene *scene
 void PointCloud::tag_positions_changed()
 {
   this->runtime->bounds_cache.tag_dirty();
+  this->runtime->bvh_cache.tag_dirty();
 }
 
 void PointCloud::tag_radii_changed()
@@ -439,6 +448,15 @@ void PointCloud::tag_radii_changed()
   this->runtime->bounds_cache.tag_dirty();
 }
 
+namespace blender::bke {
+
+void BVHTreeDeleter::operator()(BVHTree *tree) const
+{
+  BLI_bvhtree_free(tree);
+}
+
+}  // namespace blender::bke
+
 /* Draw Cache */
 
 void (*BKE_pointcloud_batch_cache_dirty_tag_cb)(PointCloud *pointcloud, int mode) = nullptr;
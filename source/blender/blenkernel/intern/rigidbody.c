@@ -19,6 +19,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -1658,16 +1659,13 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(Depsgraph *depsgraph, Object *ob, RigidBodyOb *rbo)
+static void rigidbody_update_sim_ob(ViewLayer *view_layer, Object *ob, RigidBodyOb *rbo)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
     return;
   }
 
-  const Scene *scene = DEG_get_input_scene(depsgraph);
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  BKE_view_layer_synced_ensure(scene, view_layer);
   Base *base = BKE_view_layer_base_find(view_layer, ob);
   const bool is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
 
@@ -1755,6 +1753,10 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* The input view layer is the same for all objects, so only ensure it is synced once. */
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  BKE_view_layer_synced_ensure(DEG_get_input_scene(depsgraph), view_layer);
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1805,7 +1807,7 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, ob, rbo);
+      rigidbody_update_sim_ob(view_layer, ob, rbo);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
@@ -1937,67 +1939,126 @@ static void rigidbody_update_kinematic_obj_substep(ListBase *substep_targets, fl
   }
 }
 
-static void rigidbody_update_external_forces(Depsgraph *depsgraph,
-                                             Scene *scene,
-                                             RigidBodyWorld *rbw)
+static bool rigidbody_is_effected_object(const Object *ob)
+{
+  /* only update if rigid body exists */
+  const RigidBodyOb *rbo = ob->rigidbody_object;
+  if (ob->type != OB_MESH || rbo->shared->physics_object == NULL) {
+    return false;
+  }
+  /* update influence of effectors - but don't do it on an effector */
+  /* only dynamic bodies need effector update */
+  /* NOTE: passive objects don't need to be updated since they don't move */
+  return rbo->type == RBO_TYPE_ACTIVE && ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL));
+}
+
+/** Get the bodies that force fields act on, so they can be updated in parallel. */
+static Object **rigidbody_get_effected_objects(RigidBodyWorld *rbw, int *r_objects_num)
 {
+  int objects_num = 0;
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
-    /* only update if rigid body exists */
-    RigidBodyOb *rbo = ob->rigidbody_object;
-    if (ob->type != OB_MESH || rbo->shared->physics_object == NULL) {
-      continue;
+    if (rigidbody_is_effected_object(ob)) {
+      objects_num++;
+    }
+  }
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+
+  Object **objects = MEM_mallocN(sizeof(Object *) * max_ii(objects_num, 1), __func__);
+  int i = 0;
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
+    if (rigidbody_is_effected_object(ob)) {
+      objects[i++] = ob;
     }
+  }
+  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
-    /* update influence of effectors - but don't do it on an effector */
-    /* only dynamic bodies need effector update */
-    if (rbo->type == RBO_TYPE_ACTIVE &&
-        ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL))) {
-      EffectorWeights *effector_weights = rbw->effector_weights;
-      EffectedPoint epoint;
-      ListBase *effectors;
+  *r_objects_num = objects_num;
+  return objects;
+}
 
-      /* get effectors present in the group specified by effector_weights */
-      effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights, false);
-      if (effectors) {
-        float eff_force[3] = {0.0f, 0.0f, 0.0f};
-        float eff_loc[3], eff_vel[3];
+typedef struct RigidBodyExternalForcesData {
+  Scene *scene;
+  EffectorWeights *effector_weights;
+  ListBase *effectors;
+  Object **objects;
+} RigidBodyExternalForcesData;
 
-        /* create dummy 'point' which represents last known position of object as result of sim
-         */
-        /* XXX: this can create some inaccuracies with sim position,
-         * but is probably better than using un-simulated values? */
-        RB_body_get_position(rbo->shared->physics_object, eff_loc);
-        RB_body_get_linear_velocity(rbo->shared->physics_object, eff_vel);
-
-        pd_point_from_loc(scene, eff_loc, eff_vel, 0, &epoint);
-
-        /* Calculate net force of effectors, and apply to sim object:
-         * - we use 'central force' since apply force requires a "relative position"
-         *   which we don't have... */
-        BKE_effectors_apply(effectors, NULL, effector_weights, &epoint, eff_force, NULL, NULL);
-        if (G.f & G_DEBUG) {
-          printf("\tapplying force (%f,%f,%f) to '%s'\n",
-                 eff_force[0],
-                 eff_force[1],
-                 eff_force[2],
-                 ob->id.name + 2);
-        }
-        /* activate object in case it is deactivated */
-        if (!is_zero_v3(eff_force)) {
-          RB_body_activate(rbo->shared->physics_object);
-        }
-        RB_body_apply_central_force(rbo->shared->physics_object, eff_force);
-      }
-      else if (G.f & G_DEBUG) {
-        printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
-      }
+static void rigidbody_update_external_forces_cb(void *__restrict userdata,
+                                                const int index,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const RigidBodyExternalForcesData *data = userdata;
+  Object *ob = data->objects[index];
+  RigidBodyOb *rbo = ob->rigidbody_object;
+
+  float eff_force[3] = {0.0f, 0.0f, 0.0f};
+  float eff_loc[3], eff_vel[3];
+  EffectedPoint epoint;
+
+  /* create dummy 'point' which represents last known position of object as result of sim */
+  /* XXX: this can create some inaccuracies with sim position,
+   * but is probably better than using un-simulated values? */
+  RB_body_get_position(rbo->shared->physics_object, eff_loc);
+  RB_body_get_linear_velocity(rbo->shared->physics_object, eff_vel);
+
+  pd_point_from_loc(data->scene, eff_loc, eff_vel, 0, &epoint);
+
+  /* Calculate net force of effectors, and apply to sim object:
+   * - we use 'central force' since apply force requires a "relative position"
+   *   which we don't have... */
+  BKE_effectors_apply(
+      data->effectors, NULL, data->effector_weights, &epoint, eff_force, NULL, NULL);
+  if (G.f & G_DEBUG) {
+    printf("\tapplying force (%f,%f,%f) to '%s'\n",
+           eff_force[0],
+           eff_force[1],
+           eff_force[2],
+           ob->id.name + 2);
+  }
+  /* activate object in case it is deactivated */
+  if (!is_zero_v3(eff_force)) {
+    RB_body_activate(rbo->shared->physics_object);
+  }
+  RB_body_apply_central_force(rbo->shared->physics_object, eff_force);
+}
 
-      /* cleanup */
-      BKE_effectors_free(effectors);
+static void rigidbody_update_external_forces(Depsgraph *depsgraph,
+                                             Scene *scene,
+                                             RigidBodyWorld *rbw,
+                                             Object **objects,
+                                             const int objects_num)
+{
+  if (objects_num == 0) {
+    return;
+  }
+
+  /* Get effectors present in the group specified by effector_weights. None of the objects are
+   * effectors themselves, so the same effectors act on all of them. */
+  EffectorWeights *effector_weights = rbw->effector_weights;
+  ListBase *effectors = BKE_effectors_create(depsgraph, NULL, NULL, effector_weights, false);
+  if (effectors == NULL) {
+    if (G.f & G_DEBUG) {
+      for (int i = 0; i < objects_num; i++) {
+        printf("\tno forces to apply to '%s'\n", objects[i]->id.name + 2);
+      }
     }
-    /* NOTE: passive objects don't need to be updated since they don't move */
+    return;
   }
-  FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
+
+  /* Evaluating the effectors only reads them, and every task only changes its own body. */
+  RigidBodyExternalForcesData data = {
+      .scene = scene,
+      .effector_weights = effector_weights,
+      .effectors = effectors,
+      .objects = objects,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, objects_num, &data, rigidbody_update_external_forces_cb, &settings);
+
+  /* cleanup */
+  BKE_effectors_free(effectors);
 }
 
 static void rigidbody_free_substep_data(ListBase *substep_targets)
@@ -2250,13 +2311,18 @@ void BKE_rigidbody_do_simulation(Depsgraph *depsgraph, Scene *scene, float ctime
     /* update and validate simulation */
     rigidbody_update_simulation(depsgraph, scene, rbw, false);
 
+    int effected_objects_num;
+    Object **effected_objects = rigidbody_get_effected_objects(rbw, &effected_objects_num);
+
     for (int i = 0; i < rbw->substeps_per_frame; i++) {
-      rigidbody_update_external_forces(depsgraph, scene, rbw);
+      rigidbody_update_external_forces(
+          depsgraph, scene, rbw, effected_objects, effected_objects_num);
       rigidbody_update_kinematic_obj_substep(&kinematic_substep_targets, cur_interp_val);
       RB_dworld_step_simulation(rbw->shared->physics_world, substep, 0, substep);
       cur_interp_val += interp_step;
     }
     rigidbody_free_substep_data(&kinematic_substep_targets);
+    MEM_freeN(effected_objects);
 
     rigidbody_update_simulation_post_step(depsgraph, rbw);
 
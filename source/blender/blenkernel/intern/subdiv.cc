@@ -11,7 +11,11 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_implicit_sharing.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "BKE_customdata.h"
 
 #include "BKE_modifier.h"
 #include "BKE_subdiv_modifier.h"
@@ -136,6 +140,118 @@ Subdiv *BKE_subdiv_new_from_mesh(const SubdivSettings *settings, const Mesh *mes
   return subdiv;
 }
 
+/* Topology fingerprint. */
+
+/**
+ * The implicit sharing info of every layer the converter reads topology from. A user of each
+ * sharing info is held, which keeps the data immutable and alive. A mesh that uses the very same
+ * sharing info for all of these layers is therefore known to have the same topology, which is the
+ * common case for deform-only updates where the evaluated mesh shares its topology arrays with the
+ * original.
+ */
+struct SubdivTopologyFingerprint {
+  int totvert;
+  int totedge;
+  int totpoly;
+  int totloop;
+  blender::Vector<const blender::ImplicitSharingInfo *> sharing_infos;
+};
+
+/**
+ * Gather the sharing info of all layers that affect the topology refiner, null for layers that
+ * don't exist. Returns false when one of the existing layers isn't shared, its identity can't be
+ * tracked across updates then.
+ */
+static bool subdiv_topology_sharing_infos_get(
+    const Mesh &mesh, blender::Vector<const blender::ImplicitSharingInfo *> &r_sharing_infos)
+{
+  auto add_layer = [&](const CustomData &data, const int layer_index) {
+    if (layer_index == -1) {
+      r_sharing_infos.append(nullptr);
+      return true;
+    }
+    const CustomDataLayer &layer = data.layers[layer_index];
+    if (layer.sharing_info == nullptr) {
+      return false;
+    }
+    r_sharing_infos.append(layer.sharing_info);
+    return true;
+  };
+  if (!add_layer(mesh.edata, CustomData_get_layer_index(&mesh.edata, CD_MEDGE)) ||
+      !add_layer(mesh.pdata, CustomData_get_layer_index(&mesh.pdata, CD_MPOLY)) ||
+      !add_layer(mesh.ldata, CustomData_get_layer_index(&mesh.ldata, CD_MLOOP)) ||
+      !add_layer(mesh.vdata, CustomData_get_layer_index(&mesh.vdata, CD_CREASE)) ||
+      !add_layer(mesh.edata, CustomData_get_layer_index(&mesh.edata, CD_CREASE))) {
+    return false;
+  }
+  /* UV maps define the face-varying topology. Hidden and selected faces are taken into account
+   * when the UV islands are built. */
+  const int num_uv_layers = CustomData_number_of_layers(&mesh.ldata, CD_PROP_FLOAT2);
+  for (int layer_index = 0; layer_index < num_uv_layers; layer_index++) {
+    if (!add_layer(mesh.ldata,
+                   CustomData_get_layer_index_n(&mesh.ldata, CD_PROP_FLOAT2, layer_index))) {
+      return false;
+    }
+  }
+  if (!add_layer(mesh.pdata,
+                 CustomData_get_named_layer_index(&mesh.pdata, CD_PROP_BOOL, ".hide_poly")) ||
+      !add_layer(mesh.pdata,
+                 CustomData_get_named_layer_index(&mesh.pdata, CD_PROP_BOOL, ".select_poly"))) {
+    return false;
+  }
+  return true;
+}
+
+static SubdivTopologyFingerprint *subdiv_topology_fingerprint_create(const Mesh &mesh)
+{
+  blender::Vector<const blender::ImplicitSharingInfo *> sharing_infos;
+  if (!subdiv_topology_sharing_infos_get(mesh, sharing_infos)) {
+    return nullptr;
+  }
+  for (const blender::ImplicitSharingInfo *sharing_info : sharing_infos) {
+    if (sharing_info != nullptr) {
+      sharing_info->add_user();
+    }
+  }
+  SubdivTopologyFingerprint *fingerprint = MEM_new<SubdivTopologyFingerprint>(__func__);
+  fingerprint->totvert = mesh.totvert;
+  fingerprint->totedge = mesh.totedge;
+  fingerprint->totpoly = mesh.totpoly;
+  fingerprint->totloop = mesh.totloop;
+  fingerprint->sharing_infos = std::move(sharing_infos);
+  return fingerprint;
+}
+
+static void subdiv_topology_fingerprint_free(SubdivTopologyFingerprint *fingerprint)
+{
+  if (fingerprint == nullptr) {
+    return;
+  }
+  for (const blender::ImplicitSharingInfo *sharing_info : fingerprint->sharing_infos) {
+    if (sharing_info != nullptr) {
+      sharing_info->remove_user_and_delete_if_last();
+    }
+  }
+  MEM_delete(fingerprint);
+}
+
+static bool subdiv_topology_fingerprint_matches(const SubdivTopologyFingerprint *fingerprint,
+                                                const Mesh &mesh)
+{
+  if (fingerprint == nullptr) {
+    return false;
+  }
+  if (fingerprint->totvert != mesh.totvert || fingerprint->totedge != mesh.totedge ||
+      fingerprint->totpoly != mesh.totpoly || fingerprint->totloop != mesh.totloop) {
+    return false;
+  }
+  blender::Vector<const blender::ImplicitSharingInfo *> sharing_infos;
+  if (!subdiv_topology_sharing_infos_get(mesh, sharing_infos)) {
+    return false;
+  }
+  return sharing_infos.as_span() == fingerprint->sharing_infos.as_span();
+}
+
 /* Creation with cached-aware semantic. */
 
 Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
@@ -172,10 +288,24 @@ Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
                                     const SubdivSettings *settings,
                                     const Mesh *mesh)
 {
+  if (subdiv != nullptr && subdiv->topology_refiner != nullptr &&
+      BKE_subdiv_settings_equal(&subdiv->settings, settings)) {
+    BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+    const bool topology_is_shared = subdiv_topology_fingerprint_matches(
+        subdiv->topology_fingerprint, *mesh);
+    BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+    if (topology_is_shared) {
+      /* Avoid creating the converter and comparing the topology, which both traverse the entire
+       * mesh. Evaluators are refined for the new positions when they are used. */
+      return subdiv;
+    }
+  }
   OpenSubdiv_Converter converter;
   BKE_subdiv_converter_init_for_mesh(&converter, settings, mesh);
   subdiv = BKE_subdiv_update_from_converter(subdiv, settings, &converter);
   BKE_subdiv_converter_free(&converter);
+  subdiv_topology_fingerprint_free(subdiv->topology_fingerprint);
+  subdiv->topology_fingerprint = subdiv_topology_fingerprint_create(*mesh);
   return subdiv;
 }
 
@@ -196,6 +326,7 @@ void BKE_subdiv_free(Subdiv *subdiv)
     openSubdiv_deleteTopologyRefiner(subdiv->topology_refiner);
   }
   BKE_subdiv_displacement_detach(subdiv);
+  subdiv_topology_fingerprint_free(subdiv->topology_fingerprint);
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
   }
@@ -383,3 +383,12 @@ void BKE_subdiv_eval_final_point(
     BKE_subdiv_eval_limit_point(subdiv, ptex_face_index, u, v, r_P);
   }
 }
+
+void BKE_subdiv_eval_limit_points(Subdiv *subdiv,
+                                  const OpenSubdiv_PatchCoord *patch_coords,
+                                  const int num_patch_coords,
+                                  float (*r_P)[3])
+{
+  subdiv->evaluator->evaluatePatchesLimit(
+      subdiv->evaluator, patch_coords, num_patch_coords, &r_P[0][0], nullptr, nullptr);
+}
@@ -17,6 +17,8 @@
 #include "BLI_bitmap.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_key.h"
@@ -29,6 +31,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
+
 using blender::float2;
 using blender::float3;
 using blender::Span;
@@ -67,6 +71,10 @@ struct SubdivMeshContext {
   /* Per-subdivided vertex counter of averaged values. */
   int *accumulated_counters;
   bool have_displacement;
+  /* Patch coordinates of inner ptex vertices, indexed by subdivided vertex. Their positions are
+   * evaluated in batches after the traversal, see #subdiv_mesh_evaluate_inner_vertices. Only
+   * allocated when there is no displacement. Unused vertices have a negative ptex face index. */
+  OpenSubdiv_PatchCoord *inner_vertex_patch_coords;
 
   /* Lazily initialize a map from vertices to connected edges. */
   std::mutex vert_to_edge_map_mutex;
@@ -118,9 +126,61 @@ static void subdiv_mesh_prepare_accumulator(SubdivMeshContext *ctx, int num_vert
       MEM_calloc_arrayN(num_vertices, sizeof(*ctx->accumulated_counters), __func__));
 }
 
+static void subdiv_mesh_prepare_inner_vertex_patch_coords(SubdivMeshContext *ctx,
+                                                          const int num_vertices)
+{
+  if (ctx->have_displacement) {
+    return;
+  }
+  ctx->inner_vertex_patch_coords = static_cast<OpenSubdiv_PatchCoord *>(
+      MEM_malloc_arrayN(num_vertices, sizeof(*ctx->inner_vertex_patch_coords), __func__));
+  blender::threading::parallel_for(
+      blender::IndexRange(num_vertices), 4096, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          ctx->inner_vertex_patch_coords[i].ptex_face = -1;
+        }
+      });
+}
+
+/* Evaluate the limit positions of all inner vertices gathered during the traversal. Evaluating
+ * many patch coordinates with one evaluator call is much cheaper than evaluating them one by
+ * one. */
+static void subdiv_mesh_evaluate_inner_vertices(SubdivMeshContext *ctx)
+{
+  if (ctx->inner_vertex_patch_coords == nullptr) {
+    return;
+  }
+  const OpenSubdiv_PatchCoord *patch_coords = ctx->inner_vertex_patch_coords;
+  blender::threading::parallel_for(
+      blender::IndexRange(ctx->subdiv_mesh->totvert), 4096, [&](const blender::IndexRange range) {
+        blender::Vector<OpenSubdiv_PatchCoord> batch_coords;
+        blender::Vector<int> batch_indices;
+        batch_coords.reserve(range.size());
+        batch_indices.reserve(range.size());
+        for (const int i : range) {
+          if (patch_coords[i].ptex_face >= 0) {
+            batch_coords.append(patch_coords[i]);
+            batch_indices.append(i);
+          }
+        }
+        if (batch_coords.is_empty()) {
+          return;
+        }
+        blender::Array<float3> positions(batch_coords.size());
+        BKE_subdiv_eval_limit_points(ctx->subdiv,
+                                     batch_coords.data(),
+                                     batch_coords.size(),
+                                     reinterpret_cast<float(*)[3]>(positions.data()));
+        for (const int i : batch_indices.index_range()) {
+          ctx->subdiv_positions[batch_indices[i]] = positions[i];
+        }
+      });
+}
+
 static void subdiv_mesh_context_free(SubdivMeshContext *ctx)
 {
   MEM_SAFE_FREE(ctx->accumulated_counters);
+  MEM_SAFE_FREE(ctx->inner_vertex_patch_coords);
   MEM_SAFE_FREE(ctx->vert_to_edge_buffer);
   MEM_SAFE_FREE(ctx->vert_to_edge_map);
 }
@@ -534,6 +594,7 @@ static bool subdiv_mesh_topology_info(const SubdivForeachContext *foreach_contex
       subdiv_context->coarse_mesh, num_vertices, num_edges, 0, num_loops, num_polygons, mask);
   subdiv_mesh_ctx_cache_custom_data_layers(subdiv_context);
   subdiv_mesh_prepare_accumulator(subdiv_context, num_vertices);
+  subdiv_mesh_prepare_inner_vertex_patch_coords(subdiv_context, num_vertices);
   MEM_SAFE_FREE(subdiv_context->subdiv_mesh->runtime->subsurf_face_dot_tags);
   subdiv_context->subdiv_mesh->runtime->subsurf_face_dot_tags = BLI_BITMAP_NEW(num_vertices,
                                                                                __func__);
@@ -770,10 +831,16 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
   Subdiv *subdiv = ctx->subdiv;
   const MPoly *coarse_poly = &ctx->coarse_polys[coarse_poly_index];
   Mesh *subdiv_mesh = ctx->subdiv_mesh;
-  float3 &subdiv_position = ctx->subdiv_positions[subdiv_vertex_index];
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_poly, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vertex_index, &tls->vertex_interpolation, u, v);
-  BKE_subdiv_eval_final_point(subdiv, ptex_face_index, u, v, subdiv_position);
+  if (ctx->inner_vertex_patch_coords) {
+    /* Evaluated in a batch later on, see #subdiv_mesh_evaluate_inner_vertices. */
+    ctx->inner_vertex_patch_coords[subdiv_vertex_index] = {ptex_face_index, u, v};
+  }
+  else {
+    float3 &subdiv_position = ctx->subdiv_positions[subdiv_vertex_index];
+    BKE_subdiv_eval_final_point(subdiv, ptex_face_index, u, v, subdiv_position);
+  }
   subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vertex_index, u, v, subdiv_mesh);
   subdiv_vertex_orco_evaluate(ctx, ptex_face_index, u, v, subdiv_vertex_index);
 }
@@ -1204,6 +1271,7 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   foreach_context.user_data_tls_size = sizeof(SubdivMeshTLS);
   foreach_context.user_data_tls = &tls;
   BKE_subdiv_foreach_subdiv_geometry(subdiv, &foreach_context, settings, coarse_mesh);
+  subdiv_mesh_evaluate_inner_vertices(&subdiv_context);
   BKE_subdiv_stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   Mesh *result = subdiv_context.subdiv_mesh;
   // BKE_mesh_validate(result, true, true);
@@ -37,6 +37,9 @@ typedef struct AutoTrackClip {
    *
    * NOTE: All frames within a clip are expected to have match3ed dimensions. */
   int width, height;
+
+  /* Frame of the clip from which markers are tracked on the next tracking step. */
+  int current_frame;
 } AutoTrackClip;
 
 typedef struct AutoTrackTrack {
@@ -131,6 +134,10 @@ typedef struct AutoTrackContext {
   ListBase results_to_sync;
   int synchronized_scene_frame;
 
+  /* Pool of tasks which load the frame after the one being tracked to, so that decoding the
+   * footage overlaps with tracking. */
+  TaskPool *prefetch_pool;
+
   SpinLock spin_lock;
 } AutoTrackContext;
 
@@ -348,6 +355,8 @@ static void autotrack_context_init_clips(AutoTrackContext *context,
   context->autotrack_clips[0].clip = clip;
   BKE_movieclip_get_size(
       clip, user, &context->autotrack_clips[0].width, &context->autotrack_clips[0].height);
+  context->autotrack_clips[0].current_frame = BKE_movieclip_remap_scene_to_clip_frame(
+      clip, context->start_scene_frame);
 }
 
 /* Initialize flat list of tracks for quick index-based access for the specified clip.
@@ -604,12 +613,18 @@ static void reference_keyframed_image_buffers(AutoTrackContext *context)
     ibuf->userflags |= IB_PERSISTENT;
 
     context->referenced_image_buffers[context->num_referenced_image_buffers++] = ibuf;
+
+    /* Keyframes are accessed on every tracking step. */
+    tracking_image_accessor_hold_frame(
+        context->image_accessor, clip_index, autotrack_marker->libmv_marker.reference_frame);
   }
 }
 
 void BKE_autotrack_context_start(AutoTrackContext *context)
 {
   reference_keyframed_image_buffers(context);
+
+  context->prefetch_pool = BLI_task_pool_create(context, TASK_PRIORITY_LOW);
 }
 
 /** \} */
@@ -688,6 +703,74 @@ static void autotrack_context_step_cb(void *__restrict userdata,
   BLI_addtail(&autotrack_tls->results, autotrack_result);
 }
 
+typedef struct AutoTrackPrefetchTaskData {
+  int clip_index;
+  int frame;
+} AutoTrackPrefetchTaskData;
+
+static void autotrack_prefetch_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  AutoTrackContext *context = BLI_task_pool_user_data(pool);
+  const AutoTrackPrefetchTaskData *task_data = taskdata;
+  tracking_image_accessor_hold_frame(
+      context->image_accessor, task_data->clip_index, task_data->frame);
+}
+
+/* Make sure the frames markers are tracked to are loaded before tracking, and start loading the
+ * frames for the next step in the background. */
+static void autotrack_context_prefetch_frames(AutoTrackContext *context)
+{
+  const int frame_delta = context->is_backwards ? -1 : 1;
+
+  if (context->prefetch_pool != NULL) {
+    /* Frames requested on the previous step are the ones tracked to on this step. */
+    BLI_task_pool_work_and_wait(context->prefetch_pool);
+  }
+
+  for (int clip_index = 0; clip_index < context->num_clips; clip_index++) {
+    const AutoTrackClip *autotrack_clip = &context->autotrack_clips[clip_index];
+    const int next_frame = autotrack_clip->current_frame + frame_delta;
+
+    tracking_image_accessor_hold_frame(context->image_accessor, clip_index, next_frame);
+
+    if (context->prefetch_pool != NULL) {
+      AutoTrackPrefetchTaskData *task_data = MEM_mallocN(sizeof(AutoTrackPrefetchTaskData),
+                                                         __func__);
+      task_data->clip_index = clip_index;
+      task_data->frame = next_frame + frame_delta;
+      BLI_task_pool_push(
+          context->prefetch_pool, autotrack_prefetch_task_run, task_data, true, NULL);
+    }
+  }
+}
+
+static void autotrack_context_release_frames(AutoTrackContext *context)
+{
+  const int frame_delta = context->is_backwards ? -1 : 1;
+
+  for (int clip_index = 0; clip_index < context->num_clips; clip_index++) {
+    AutoTrackClip *autotrack_clip = &context->autotrack_clips[clip_index];
+
+    /* The frame tracked from is not used anymore, unless it's the keyframe of some track. */
+    bool is_keyframe = false;
+    for (int i = 0; i < context->num_autotrack_markers; i++) {
+      const libmv_Marker *libmv_marker = &context->autotrack_markers[i].libmv_marker;
+      const MovieTrackingTrack *track = context->all_autotrack_tracks[libmv_marker->track].track;
+      if (libmv_marker->clip == clip_index && track->pattern_match == TRACK_MATCH_KEYFRAME &&
+          libmv_marker->reference_frame == autotrack_clip->current_frame) {
+        is_keyframe = true;
+        break;
+      }
+    }
+    if (!is_keyframe) {
+      tracking_image_accessor_release_frame(
+          context->image_accessor, clip_index, autotrack_clip->current_frame);
+    }
+
+    autotrack_clip->current_frame += frame_delta;
+  }
+}
+
 static void autotrack_context_reduce(const void *__restrict UNUSED(userdata),
                                      void *__restrict chunk_join,
                                      void *__restrict chunk)
@@ -718,6 +801,8 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
   settings.userdata_chunk_size = sizeof(AutoTrackTLS);
   settings.func_reduce = autotrack_context_reduce;
 
+  autotrack_context_prefetch_frames(context);
+
   BLI_task_parallel_range(
       0, context->num_autotrack_markers, context, autotrack_context_step_cb, &settings);
 
@@ -738,6 +823,8 @@ bool BKE_autotrack_context_step(AutoTrackContext *context)
         autotrack_result->libmv_marker;
   }
 
+  autotrack_context_release_frames(context);
+
   BLI_spin_lock(&context->spin_lock);
   BLI_movelisttolist(&context->results_to_sync, &tls.results);
   BLI_spin_unlock(&context->spin_lock);
@@ -876,6 +963,11 @@ static void release_keyframed_image_buffers(AutoTrackContext *context)
 
 void BKE_autotrack_context_free(AutoTrackContext *context)
 {
+  if (context->prefetch_pool != NULL) {
+    BLI_task_pool_work_and_wait(context->prefetch_pool);
+    BLI_task_pool_free(context->prefetch_pool);
+  }
+
   if (context->autotrack != NULL) {
     libmv_autoTrackDestroy(context->autotrack);
   }
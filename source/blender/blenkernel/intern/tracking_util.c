@@ -619,17 +619,50 @@ MovieTrackingMarker *tracking_get_keyframed_marker(MovieTrackingTrack *track,
 /** \name Frame Accessor
  * \{ */
 
+typedef struct TrackingImageAccessorFrame {
+  struct TrackingImageAccessorFrame *next, *prev;
+
+  int clip_index;
+  int frame;
+  ImBuf *ibuf;
+} TrackingImageAccessorFrame;
+
+/* NOTE: Is to be called with the `cache_lock` held. */
+static TrackingImageAccessorFrame *accessor_find_held_frame(TrackingImageAccessor *accessor,
+                                                            int clip_index,
+                                                            int frame)
+{
+  LISTBASE_FOREACH (TrackingImageAccessorFrame *, held_frame, &accessor->held_frames) {
+    if (held_frame->clip_index == clip_index && held_frame->frame == frame) {
+      return held_frame;
+    }
+  }
+  return NULL;
+}
+
 static ImBuf *accessor_get_preprocessed_ibuf(TrackingImageAccessor *accessor,
                                              int clip_index,
                                              int frame)
 {
   MovieClip *clip;
   MovieClipUser user;
-  ImBuf *ibuf;
+  ImBuf *ibuf = NULL;
   int scene_frame;
 
   BLI_assert(clip_index < accessor->num_clips);
 
+  /* Held frames are accessed by all the tracks, avoid the global lock of the movie clip cache. */
+  BLI_spin_lock(&accessor->cache_lock);
+  TrackingImageAccessorFrame *held_frame = accessor_find_held_frame(accessor, clip_index, frame);
+  if (held_frame != NULL) {
+    ibuf = held_frame->ibuf;
+    IMB_refImBuf(ibuf);
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+  if (ibuf != NULL) {
+    return ibuf;
+  }
+
   clip = accessor->clips[clip_index];
   scene_frame = BKE_movieclip_remap_clip_to_scene_frame(clip, frame);
   BKE_movieclip_user_set_frame(&user, scene_frame);
@@ -935,10 +968,73 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
 
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor)
 {
+  LISTBASE_FOREACH_MUTABLE (TrackingImageAccessorFrame *, held_frame, &accessor->held_frames) {
+    IMB_freeImBuf(held_frame->ibuf);
+    MEM_freeN(held_frame);
+  }
   libmv_FrameAccessorDestroy(accessor->libmv_accessor);
   BLI_spin_end(&accessor->cache_lock);
   MEM_freeN(accessor->tracks);
   MEM_freeN(accessor);
 }
 
+void tracking_image_accessor_hold_frame(TrackingImageAccessor *accessor,
+                                        int clip_index,
+                                        int frame)
+{
+  BLI_assert(clip_index < accessor->num_clips);
+
+  BLI_spin_lock(&accessor->cache_lock);
+  const bool is_held = accessor_find_held_frame(accessor, clip_index, frame) != NULL;
+  BLI_spin_unlock(&accessor->cache_lock);
+  if (is_held) {
+    return;
+  }
+
+  /* Load the frame without holding the spin lock, decoding might take a while. */
+  MovieClip *clip = accessor->clips[clip_index];
+  MovieClipUser user;
+  BKE_movieclip_user_set_frame(&user, BKE_movieclip_remap_clip_to_scene_frame(clip, frame));
+  user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
+  user.render_flag = 0;
+  ImBuf *ibuf = BKE_movieclip_get_ibuf(clip, &user);
+  if (ibuf == NULL) {
+    return;
+  }
+
+  BLI_spin_lock(&accessor->cache_lock);
+  if (accessor_find_held_frame(accessor, clip_index, frame) == NULL) {
+    TrackingImageAccessorFrame *held_frame = MEM_mallocN(sizeof(TrackingImageAccessorFrame),
+                                                         "tracking held frame");
+    held_frame->clip_index = clip_index;
+    held_frame->frame = frame;
+    held_frame->ibuf = ibuf;
+    BLI_addtail(&accessor->held_frames, held_frame);
+    ibuf = NULL;
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  if (ibuf != NULL) {
+    /* Frame got held from another thread meanwhile. */
+    IMB_freeImBuf(ibuf);
+  }
+}
+
+void tracking_image_accessor_release_frame(TrackingImageAccessor *accessor,
+                                           int clip_index,
+                                           int frame)
+{
+  BLI_spin_lock(&accessor->cache_lock);
+  TrackingImageAccessorFrame *held_frame = accessor_find_held_frame(accessor, clip_index, frame);
+  if (held_frame != NULL) {
+    BLI_remlink(&accessor->held_frames, held_frame);
+  }
+  BLI_spin_unlock(&accessor->cache_lock);
+
+  if (held_frame != NULL) {
+    IMB_freeImBuf(held_frame->ibuf);
+    MEM_freeN(held_frame);
+  }
+}
+
 /** \} */
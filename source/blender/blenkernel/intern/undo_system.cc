@@ -491,6 +491,7 @@ eUndoPushReturn BKE_undosys_step_push_with_type(UndoStack *ustack,
   BLI_assert((ut->flags & UNDOTYPE_FLAG_NEED_CONTEXT_FOR_ENCODE) == 0 || C != nullptr);
 
   UNDO_NESTED_ASSERT(false);
+  MEM_TagScope mem_tag(MEM_TAG_UNDO);
   undosys_stack_validate(ustack, false);
   bool is_not_empty = ustack->step_active != nullptr;
   eUndoPushReturn retval = UNDO_PUSH_RET_FAILURE;
@@ -24,6 +24,7 @@
 
 #  include "BLI_endian_defines.h"
 #  include "BLI_math_base.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 
@@ -73,7 +74,6 @@ typedef struct FFMpegContext {
   AVCodecContext *audio_codec;
   AVStream *video_stream;
   AVStream *audio_stream;
-  AVFrame *current_frame; /* Image frame in output pixel format. */
   int video_time;
 
   /* Image frame in Blender's own pixel format, may need conversion to the output pixel format. */
@@ -90,6 +90,12 @@ typedef struct FFMpegContext {
 
   struct StampData *stamp_data;
 
+  /* Frames are encoded and written to the file in a background thread while the next frame is
+   * rendered, see #BKE_ffmpeg_append. */
+  TaskPool *encode_pool;
+  /* True if encoding or writing the frame of the last encode task failed. */
+  bool encode_failed;
+
 #  ifdef WITH_AUDASPACE
   AUD_Device *audio_mixdown_device;
 #  endif
@@ -108,18 +114,6 @@ static void ffmpeg_filepath_get(FFMpegContext *context,
                                 bool preview,
                                 const char *suffix);
 
-/* Delete a picture buffer */
-
-static void delete_picture(AVFrame *f)
-{
-  if (f) {
-    if (f->data[0]) {
-      MEM_freeN(f->data[0]);
-    }
-    av_free(f);
-  }
-}
-
 static int request_float_audio_buffer(int codec_id)
 {
   /* If any of these codecs, we prefer the float sample format (if supported) */
@@ -222,31 +216,24 @@ static int write_audio_frame(FFMpegContext *context)
 }
 #  endif /* #ifdef WITH_AUDASPACE */
 
-/* Allocate a temporary frame */
+/* Allocate a temporary frame. It is reference counted, so the encoder can keep a reference to it
+ * instead of copying it. */
 static AVFrame *alloc_picture(int pix_fmt, int width, int height)
 {
-  AVFrame *f;
-  uint8_t *buf;
-  int size;
-
-  /* allocate space for the struct */
-  f = av_frame_alloc();
+  AVFrame *f = av_frame_alloc();
   if (!f) {
     return NULL;
   }
-  size = av_image_get_buffer_size(pix_fmt, width, height, 1);
-  /* allocate the actual picture buffer */
-  buf = MEM_mallocN(size, "AVFrame buffer");
-  if (!buf) {
-    free(f);
-    return NULL;
-  }
 
-  av_image_fill_arrays(f->data, f->linesize, buf, pix_fmt, width, height, 1);
   f->format = pix_fmt;
   f->width = width;
   f->height = height;
 
+  if (av_frame_get_buffer(f, 0) < 0) {
+    av_frame_free(&f);
+    return NULL;
+  }
+
   return f;
 }
 
@@ -316,9 +303,10 @@ static const char **get_file_extensions(int format)
 }
 
 /* Write a frame to the output file */
-static int write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList *reports)
+static bool write_video_frame(FFMpegContext *context, AVFrame *frame)
 {
-  int ret, success = 1;
+  int ret;
+  bool success = true;
   AVPacket *packet = av_packet_alloc();
 
   AVCodecContext *c = context->video_codec;
@@ -330,7 +318,7 @@ static int write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   if (ret < 0) {
     /* Can't send frame to encoder. This shouldn't happen. */
     fprintf(stderr, "Can't send video frame: %s\n", av_err2str(ret));
-    success = -1;
+    success = false;
   }
 
   while (ret >= 0) {
@@ -352,13 +340,12 @@ static int write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
 #  endif
 
     if (av_interleaved_write_frame(context->outfile, packet) != 0) {
-      success = -1;
+      success = false;
       break;
     }
   }
 
   if (!success) {
-    BKE_report(reports, RPT_ERROR, "Error writing frame");
     PRINT("Error writing frame: %s\n", av_err2str(ret));
   }
 
@@ -367,34 +354,42 @@ static int write_video_frame(FFMpegContext *context, AVFrame *frame, ReportList
   return success;
 }
 
-/* read and encode a frame of video from the buffer */
+/* Read a frame of video from the buffer and convert it to the output pixel format. The returned
+ * frame is newly allocated, so it can be encoded while the next frame is generated. */
 static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixels)
 {
-  AVCodecParameters *codec = context->video_stream->codecpar;
-  int height = codec->height;
+  AVCodecContext *c = context->video_codec;
+  int height = c->height;
   AVFrame *rgb_frame;
 
+  AVFrame *output_frame = alloc_picture(c->pix_fmt, c->width, c->height);
+  if (output_frame == NULL) {
+    return NULL;
+  }
+
   if (context->img_convert_frame != NULL) {
     /* Pixel format conversion is needed. */
     rgb_frame = context->img_convert_frame;
   }
   else {
     /* The output pixel format is Blender's internal pixel format. */
-    rgb_frame = context->current_frame;
+    rgb_frame = output_frame;
   }
 
   /* Copy the Blender pixels into the FFmpeg datastructure, taking care of endianness and flipping
-   * the image vertically. */
+   * the image vertically. Rows of the frame may be padded, so they can be longer than the rows of
+   * the Blender pixels. */
+  int pixels_linesize = c->width * 4;
   int linesize = rgb_frame->linesize[0];
   for (int y = 0; y < height; y++) {
     uint8_t *target = rgb_frame->data[0] + linesize * (height - y - 1);
-    const uint8_t *src = pixels + linesize * y;
+    const uint8_t *src = pixels + pixels_linesize * y;
 
 #  if ENDIAN_ORDER == L_ENDIAN
-    memcpy(target, src, linesize);
+    memcpy(target, src, pixels_linesize);
 
 #  elif ENDIAN_ORDER == B_ENDIAN
-    const uint8_t *end = src + linesize;
+    const uint8_t *end = src + pixels_linesize;
     while (src != end) {
       target[3] = src[0];
       target[2] = src[1];
@@ -412,16 +407,49 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixe
   /* Convert to the output pixel format, if it's different that Blender's internal one. */
   if (context->img_convert_frame != NULL) {
     BLI_assert(context->img_convert_ctx != NULL);
+#  ifdef FFMPEG_SWSCALE_THREADING
+    /* Only the frame API converts slices of the image in parallel. */
+    sws_scale_frame(context->img_convert_ctx, output_frame, rgb_frame);
+#  else
     sws_scale(context->img_convert_ctx,
               (const uint8_t *const *)rgb_frame->data,
               rgb_frame->linesize,
               0,
-              codec->height,
-              context->current_frame->data,
-              context->current_frame->linesize);
+              height,
+              output_frame->data,
+              output_frame->linesize);
+#  endif
   }
 
-  return context->current_frame;
+  return output_frame;
+}
+
+/* Create a context converting frames from Blender's internal pixel format to the given one. */
+static struct SwsContext *img_convert_ctx_create(int width, int height, int pix_fmt)
+{
+#  ifdef FFMPEG_SWSCALE_THREADING
+  struct SwsContext *sws_ctx = sws_alloc_context();
+  if (sws_ctx == NULL) {
+    return NULL;
+  }
+  av_opt_set_int(sws_ctx, "srcw", width, 0);
+  av_opt_set_int(sws_ctx, "srch", height, 0);
+  av_opt_set_int(sws_ctx, "src_format", AV_PIX_FMT_RGBA, 0);
+  av_opt_set_int(sws_ctx, "dstw", width, 0);
+  av_opt_set_int(sws_ctx, "dsth", height, 0);
+  av_opt_set_int(sws_ctx, "dst_format", pix_fmt, 0);
+  av_opt_set_int(sws_ctx, "sws_flags", SWS_BICUBIC, 0);
+  av_opt_set_int(sws_ctx, "threads", BLI_system_thread_count(), 0);
+
+  if (sws_init_context(sws_ctx, NULL, NULL) < 0) {
+    sws_freeContext(sws_ctx);
+    return NULL;
+  }
+  return sws_ctx;
+#  else
+  return sws_getContext(
+      width, height, AV_PIX_FMT_RGBA, width, height, pix_fmt, SWS_BICUBIC, NULL, NULL, NULL);
+#  endif
 }
 
 static AVRational calc_time_base(uint den, double num, int codec_id)
@@ -889,9 +917,6 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   }
   av_dict_free(&opts);
 
-  /* FFmpeg expects its data in the output pixel format. */
-  context->current_frame = alloc_picture(c->pix_fmt, c->width, c->height);
-
   if (c->pix_fmt == AV_PIX_FMT_RGBA) {
     /* Output pixel format is the same we use internally, no conversion necessary. */
     context->img_convert_frame = NULL;
@@ -900,16 +925,7 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   else {
     /* Output pixel format is different, allocate frame for conversion. */
     context->img_convert_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
-    context->img_convert_ctx = sws_getContext(c->width,
-                                              c->height,
-                                              AV_PIX_FMT_RGBA,
-                                              c->width,
-                                              c->height,
-                                              c->pix_fmt,
-                                              SWS_BICUBIC,
-                                              NULL,
-                                              NULL,
-                                              NULL);
+    context->img_convert_ctx = img_convert_ctx_create(c->width, c->height, c->pix_fmt);
   }
 
   avcodec_parameters_from_context(st->codecpar, c);
@@ -1500,6 +1516,43 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+typedef struct FFMpegEncodeTask {
+  AVFrame *frame;
+  /* Audio is encoded up to this time after the frame. */
+  double audio_to_pts;
+} FFMpegEncodeTask;
+
+static void encode_frame_task(TaskPool *__restrict pool, void *taskdata)
+{
+  FFMpegContext *context = BLI_task_pool_user_data(pool);
+  FFMpegEncodeTask *task = taskdata;
+
+  context->encode_failed = !write_video_frame(context, task->frame);
+#  ifdef WITH_AUDASPACE
+  write_audio_frames(context, task->audio_to_pts);
+#  endif
+}
+
+static void encode_frame_task_free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  FFMpegEncodeTask *task = taskdata;
+  av_frame_free(&task->frame);
+  MEM_freeN(task);
+}
+
+/* Wait for the frame that is being encoded, returns false if encoding it failed. */
+static bool encode_wait(FFMpegContext *context)
+{
+  if (context->encode_pool == NULL) {
+    return true;
+  }
+
+  BLI_task_pool_work_and_wait(context->encode_pool);
+  const bool success = !context->encode_failed;
+  context->encode_failed = false;
+  return success;
+}
+
 int BKE_ffmpeg_append(void *context_v,
                       RenderData *rd,
                       int start_frame,
@@ -1517,24 +1570,42 @@ int BKE_ffmpeg_append(void *context_v,
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, rectx, recty);
 
   if (context->video_stream) {
-    avframe = generate_video_frame(context, (uchar *)pixels);
-    success = (avframe && write_video_frame(context, avframe, reports));
-#  ifdef WITH_AUDASPACE
-    /* Add +1 frame because we want to encode audio up until the next video frame. */
-    write_audio_frames(
-        context, (frame - start_frame + 1) / (((double)rd->frs_sec) / (double)rd->frs_sec_base));
-#  else
-    UNUSED_VARS(start_frame);
-#  endif
+    /* Encoding the previous frame overlaps with rendering this one, but only one frame is encoded
+     * at a time so frames don't pile up when encoding is slower than rendering. */
+    if (!encode_wait(context)) {
+      BKE_report(reports, RPT_ERROR, "Error writing frame");
+      success = 0;
+    }
 
+    /* The size of the file is known once the previous frame was written. */
     if (context->ffmpeg_autosplit) {
       if (avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
         end_ffmpeg_impl(context, true);
         context->ffmpeg_autosplit_count++;
 
         success &= start_ffmpeg_impl(context, rd, rectx, recty, suffix, reports);
+        if (!context->video_stream) {
+          return success;
+        }
       }
     }
+
+    avframe = generate_video_frame(context, (uchar *)pixels);
+    if (avframe == NULL) {
+      BKE_report(reports, RPT_ERROR, "Error writing frame");
+      return 0;
+    }
+
+    FFMpegEncodeTask *task = MEM_callocN(sizeof(FFMpegEncodeTask), "FFMpegEncodeTask");
+    task->frame = avframe;
+    /* Add +1 frame because we want to encode audio up until the next video frame. */
+    task->audio_to_pts = (frame - start_frame + 1) /
+                         (((double)rd->frs_sec) / (double)rd->frs_sec_base);
+
+    if (context->encode_pool == NULL) {
+      context->encode_pool = BLI_task_pool_create_background_serial(context, TASK_PRIORITY_HIGH);
+    }
+    BLI_task_pool_push(context->encode_pool, encode_frame_task, task, true, encode_frame_task_free);
   }
 
   return success;
@@ -1544,6 +1615,15 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing ffmpeg...\n");
 
+  /* The last frame may still be encoded, which also writes audio. */
+  if (!encode_wait(context)) {
+    fprintf(stderr, "Error writing frame\n");
+  }
+  if (is_autosplit == false && context->encode_pool) {
+    BLI_task_pool_free(context->encode_pool);
+    context->encode_pool = NULL;
+  }
+
 #  ifdef WITH_AUDASPACE
   if (is_autosplit == false) {
     if (context->audio_mixdown_device) {
@@ -1551,8 +1631,6 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
       context->audio_mixdown_device = NULL;
     }
   }
-#  else
-  UNUSED_VARS(is_autosplit);
 #  endif
 
   if (context->video_stream) {
@@ -1581,13 +1659,8 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
   }
 
   /* free the temp buffer */
-  if (context->current_frame != NULL) {
-    delete_picture(context->current_frame);
-    context->current_frame = NULL;
-  }
   if (context->img_convert_frame != NULL) {
-    delete_picture(context->img_convert_frame);
-    context->img_convert_frame = NULL;
+    av_frame_free(&context->img_convert_frame);
   }
 
   if (context->outfile != NULL && context->outfile->oformat) {
@@ -1820,6 +1893,9 @@ void BKE_ffmpeg_context_free(void *context_v)
   if (context == NULL) {
     return;
   }
+  if (context->encode_pool) {
+    BLI_task_pool_free(context->encode_pool);
+  }
   if (context->stamp_data) {
     MEM_freeN(context->stamp_data);
   }
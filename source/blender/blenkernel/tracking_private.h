@@ -173,6 +173,12 @@ typedef struct TrackingImageAccessor {
 
   struct libmv_FrameAccessor *libmv_accessor;
   SpinLock cache_lock;
+
+  /* Frames which are referenced by the accessor, so that image requests for them don't have to go
+   * through the movie clip cache and its global lock. Elements of `TrackingImageAccessorFrame`.
+   *
+   * NOTE: Is protected by `cache_lock`. */
+  ListBase held_frames;
 } TrackingImageAccessor;
 
 /**
@@ -188,6 +194,23 @@ TrackingImageAccessor *tracking_image_accessor_new(MovieClip *clips[MAX_ACCESSOR
                                                    int num_tracks);
 void tracking_image_accessor_destroy(TrackingImageAccessor *accessor);
 
+/**
+ * Load the frame of the clip and keep it referenced by the accessor until it is released, so that
+ * tracking does not have to wait for the global movie clip lock when accessing it. Frames which
+ * are already held are not loaded again.
+ *
+ * \note Is safe to be called from multiple threads, also while tracking.
+ */
+void tracking_image_accessor_hold_frame(TrackingImageAccessor *accessor,
+                                        int clip_index,
+                                        int frame);
+/**
+ * Stop referencing the frame of the clip. Does nothing if the frame is not held.
+ */
+void tracking_image_accessor_release_frame(TrackingImageAccessor *accessor,
+                                           int clip_index,
+                                           int frame);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,232 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::ConcurrentMap<Key, Value>` is a hash map that supports adding items from many
+ * threads at the same time without locking. It is the map counterpart of #ConcurrentSet and works
+ * the same way: open addressing with the probing strategies of #Map, and an atomic state per slot
+ * that is claimed with a compare-and-swap before the key and value are constructed.
+ *
+ * Some noteworthy information:
+ * - The capacity is fixed at construction, the map does not grow. The number of added items must
+ *   not exceed the `max_size` passed to the constructor.
+ * - Items cannot be removed. Values cannot be changed concurrently once added.
+ * - #add, #lookup_or_add and the lookup functions can be called from any thread concurrently.
+ *   Everything else, like iteration and #size, must only be used when no other thread modifies
+ *   the map.
+ */
+
+#include <atomic>
+#include <functional>
+
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_probing_strategies.hh"
+#include "BLI_task.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+template<
+    typename Key,
+    typename Value,
+    typename ProbingStrategy = DefaultProbingStrategy,
+    typename Hash = DefaultHash<Key>,
+    typename IsEqual = DefaultEquality<Key>,
+    typename Allocator = GuardedAllocator>
+class ConcurrentMap : NonCopyable, NonMovable {
+ private:
+  enum SlotState : uint8_t {
+    Empty = 0,
+    Writing = 1,
+    Occupied = 2,
+  };
+
+  struct Slot {
+    std::atomic<uint8_t> state{Empty};
+    TypedBuffer<Key> key;
+    TypedBuffer<Value> value;
+
+    Slot() = default;
+
+    ~Slot()
+    {
+      if (state.load(std::memory_order_relaxed) == Occupied) {
+        key.ref().~Key();
+        value.ref().~Value();
+      }
+    }
+  };
+
+  Array<Slot, 0, Allocator> slots_;
+  uint64_t slot_mask_;
+
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+  BLI_NO_UNIQUE_ADDRESS IsEqual is_equal_;
+
+#define CONCURRENT_MAP_SLOT_PROBING_BEGIN(HASH, R_SLOT) \
+  SLOT_PROBING_BEGIN (ProbingStrategy, HASH, slot_mask_, SLOT_INDEX) \
+    auto &R_SLOT = slots_[SLOT_INDEX];
+#define CONCURRENT_MAP_SLOT_PROBING_END() SLOT_PROBING_END()
+
+ public:
+  /**
+   * Create a map that can hold up to `max_size` items. The slot array is initialized in parallel.
+   */
+  ConcurrentMap(const int64_t max_size, Allocator allocator = {})
+      : slots_(ConcurrentMap::compute_total_slots(max_size), NoInitialization(), allocator)
+  {
+    slot_mask_ = uint64_t(slots_.size()) - 1;
+    threading::parallel_for(slots_.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        new (&slots_[i]) Slot();
+      }
+    });
+  }
+
+  /**
+   * Add an item to the map. Returns true when it was added and false when the key was in the map
+   * already, in which case the existing value is not changed.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    bool is_new = false;
+    this->lookup_or_add_as(key, value, &is_new);
+    return is_new;
+  }
+
+  /**
+   * Get the value of the key, adding the given value first when the key is not in the map yet.
+   * When multiple threads add the same key, the value of the first one is used by all of them.
+   */
+  const Value &lookup_or_add(const Key &key, const Value &value)
+  {
+    return this->lookup_or_add_as(key, value, nullptr);
+  }
+
+  template<typename ForwardKey, typename ForwardValue>
+  const Value &lookup_or_add_as(ForwardKey &&key, ForwardValue &&value, bool *r_is_new)
+  {
+    const uint64_t hash = hash_(key);
+    CONCURRENT_MAP_SLOT_PROBING_BEGIN (hash, slot) {
+      uint8_t state = slot.state.load(std::memory_order_acquire);
+      if (state == Empty) {
+        if (slot.state.compare_exchange_strong(
+                state, Writing, std::memory_order_acquire, std::memory_order_acquire)) {
+          new (slot.key.ptr()) Key(std::forward<ForwardKey>(key));
+          new (slot.value.ptr()) Value(std::forward<ForwardValue>(value));
+          slot.state.store(Occupied, std::memory_order_release);
+          if (r_is_new) {
+            *r_is_new = true;
+          }
+          return *slot.value;
+        }
+      }
+      /* Another thread claimed the slot, wait until its item is available. */
+      while (state == Writing) {
+        state = slot.state.load(std::memory_order_acquire);
+      }
+      if (is_equal_(key, *slot.key)) {
+        if (r_is_new) {
+          *r_is_new = false;
+        }
+        return *slot.value;
+      }
+    }
+    CONCURRENT_MAP_SLOT_PROBING_END();
+  }
+
+  /**
+   * Get a pointer to the value of the key, or null when it is not in the map. Items that are
+   * being added concurrently may or may not be found.
+   */
+  const Value *lookup_ptr(const Key &key) const
+  {
+    return this->lookup_ptr_as(key);
+  }
+  template<typename ForwardKey> const Value *lookup_ptr_as(const ForwardKey &key) const
+  {
+    const uint64_t hash = hash_(key);
+    CONCURRENT_MAP_SLOT_PROBING_BEGIN (hash, slot) {
+      uint8_t state = slot.state.load(std::memory_order_acquire);
+      if (state == Empty) {
+        return nullptr;
+      }
+      while (state == Writing) {
+        state = slot.state.load(std::memory_order_acquire);
+      }
+      if (is_equal_(key, *slot.key)) {
+        return slot.value.ptr();
+      }
+    }
+    CONCURRENT_MAP_SLOT_PROBING_END();
+  }
+
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    const Value *ptr = this->lookup_ptr(key);
+    return ptr ? *ptr : default_value;
+  }
+
+  bool contains(const Key &key) const
+  {
+    return this->lookup_ptr(key) != nullptr;
+  }
+
+  /**
+   * Call the function with every key and value in the map. Values can be modified. Must not be
+   * called while items are being added.
+   */
+  template<typename FuncT> void foreach_item(const FuncT &func)
+  {
+    for (Slot &slot : slots_) {
+      if (slot.state.load(std::memory_order_relaxed) == Occupied) {
+        func(const_cast<const Key &>(*slot.key), *slot.value);
+      }
+    }
+  }
+
+  /**
+   * Count the items in the map. This iterates over all slots, so it is not a constant time
+   * operation. Must not be called while items are being added.
+   */
+  int64_t size() const
+  {
+    return threading::parallel_reduce(
+        slots_.index_range(),
+        4096,
+        int64_t(0),
+        [&](const IndexRange range, int64_t count) {
+          for (const int64_t i : range) {
+            count += slots_[i].state.load(std::memory_order_relaxed) == Occupied;
+          }
+          return count;
+        },
+        std::plus<int64_t>());
+  }
+
+  /**
+   * Get the number of slots, which is at least twice the maximum size.
+   */
+  int64_t capacity() const
+  {
+    return slots_.size();
+  }
+
+ private:
+  static int64_t compute_total_slots(const int64_t max_size)
+  {
+    /* Keep the load factor low, since the map cannot grow and probe sequences get long when the
+     * map is almost full. */
+    return std::max<int64_t>(LoadFactor::compute_total_slots(max_size, 1, 2), 8);
+  }
+};
+
+#undef CONCURRENT_MAP_SLOT_PROBING_BEGIN
+#undef CONCURRENT_MAP_SLOT_PROBING_END
+
+}  // namespace blender
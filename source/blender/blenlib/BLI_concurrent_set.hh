@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::ConcurrentSet<Key>` is a hash set that supports adding keys from many threads at
+ * the same time without locking. It is meant for insert-heavy parallel builders, like
+ * deduplicating elements of a large mesh, where a #Set would have to be filled on a single
+ * thread or partitioned by hash manually.
+ *
+ * It uses open addressing with the same probing strategies as #Set. Every slot has an atomic
+ * state: empty, writing or occupied. A thread claims an empty slot with a compare-and-swap, then
+ * constructs the key and publishes the slot as occupied. Threads probing a slot that is being
+ * written wait until the key is published before comparing it.
+ *
+ * Some noteworthy information:
+ * - The capacity is fixed at construction, the set does not grow. The number of added keys must
+ *   not exceed the `max_size` passed to the constructor.
+ * - Keys cannot be removed.
+ * - #add and #contains can be called from any thread concurrently. Everything else, like
+ *   iteration and #size, must only be used when no other thread modifies the set.
+ * - #size is computed by counting occupied slots, to avoid contention on a shared counter.
+ */
+
+#include <atomic>
+#include <functional>
+
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_probing_strategies.hh"
+#include "BLI_task.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+template<
+    typename Key,
+    typename ProbingStrategy = DefaultProbingStrategy,
+    typename Hash = DefaultHash<Key>,
+    typename IsEqual = DefaultEquality<Key>,
+    typename Allocator = GuardedAllocator>
+class ConcurrentSet : NonCopyable, NonMovable {
+ private:
+  enum SlotState : uint8_t {
+    Empty = 0,
+    Writing = 1,
+    Occupied = 2,
+  };
+
+  struct Slot {
+    std::atomic<uint8_t> state{Empty};
+    TypedBuffer<Key> key;
+
+    Slot() = default;
+
+    ~Slot()
+    {
+      if (state.load(std::memory_order_relaxed) == Occupied) {
+        key.ref().~Key();
+      }
+    }
+  };
+
+  Array<Slot, 0, Allocator> slots_;
+  uint64_t slot_mask_;
+
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+  BLI_NO_UNIQUE_ADDRESS IsEqual is_equal_;
+
+#define CONCURRENT_SET_SLOT_PROBING_BEGIN(HASH, R_SLOT) \
+  SLOT_PROBING_BEGIN (ProbingStrategy, HASH, slot_mask_, SLOT_INDEX) \
+    auto &R_SLOT = slots_[SLOT_INDEX];
+#define CONCURRENT_SET_SLOT_PROBING_END() SLOT_PROBING_END()
+
+ public:
+  /**
+   * Create a set that can hold up to `max_size` keys. The slot array is initialized in parallel.
+   */
+  ConcurrentSet(const int64_t max_size, Allocator allocator = {})
+      : slots_(ConcurrentSet::compute_total_slots(max_size), NoInitialization(), allocator)
+  {
+    slot_mask_ = uint64_t(slots_.size()) - 1;
+    threading::parallel_for(slots_.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        new (&slots_[i]) Slot();
+      }
+    });
+  }
+
+  /**
+   * Add a key to the set. Returns true when the key was added and false when it was in the set
+   * already. This can be called from multiple threads at the same time.
+   */
+  bool add(const Key &key)
+  {
+    return this->add_as(key);
+  }
+  bool add(Key &&key)
+  {
+    return this->add_as(std::move(key));
+  }
+  template<typename ForwardKey> bool add_as(ForwardKey &&key)
+  {
+    const uint64_t hash = hash_(key);
+    CONCURRENT_SET_SLOT_PROBING_BEGIN (hash, slot) {
+      uint8_t state = slot.state.load(std::memory_order_acquire);
+      if (state == Empty) {
+        if (slot.state.compare_exchange_strong(
+                state, Writing, std::memory_order_acquire, std::memory_order_acquire)) {
+          new (slot.key.ptr()) Key(std::forward<ForwardKey>(key));
+          slot.state.store(Occupied, std::memory_order_release);
+          return true;
+        }
+      }
+      /* Another thread claimed the slot, wait until its key is available for comparison. */
+      while (state == Writing) {
+        state = slot.state.load(std::memory_order_acquire);
+      }
+      if (is_equal_(key, *slot.key)) {
+        return false;
+      }
+    }
+    CONCURRENT_SET_SLOT_PROBING_END();
+  }
+
+  /**
+   * Returns true when the key is in the set. Keys that are being added concurrently may or may
+   * not be found.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    const uint64_t hash = hash_(key);
+    CONCURRENT_SET_SLOT_PROBING_BEGIN (hash, slot) {
+      uint8_t state = slot.state.load(std::memory_order_acquire);
+      if (state == Empty) {
+        return false;
+      }
+      while (state == Writing) {
+        state = slot.state.load(std::memory_order_acquire);
+      }
+      if (is_equal_(key, *slot.key)) {
+        return true;
+      }
+    }
+    CONCURRENT_SET_SLOT_PROBING_END();
+  }
+
+  /**
+   * Call the function for every key in the set. Must not be called while keys are being added.
+   */
+  template<typename FuncT> void foreach_key(const FuncT &func) const
+  {
+    for (const Slot &slot : slots_) {
+      if (slot.state.load(std::memory_order_relaxed) == Occupied) {
+        func(*slot.key);
+      }
+    }
+  }
+
+  /**
+   * Count the keys in the set. This iterates over all slots, so it is not a constant time
+   * operation. Must not be called while keys are being added.
+   */
+  int64_t size() const
+  {
+    return threading::parallel_reduce(
+        slots_.index_range(),
+        4096,
+        int64_t(0),
+        [&](const IndexRange range, int64_t count) {
+          for (const int64_t i : range) {
+            count += slots_[i].state.load(std::memory_order_relaxed) == Occupied;
+          }
+          return count;
+        },
+        std::plus<int64_t>());
+  }
+
+  /**
+   * Get the number of slots, which is at least twice the maximum size.
+   */
+  int64_t capacity() const
+  {
+    return slots_.size();
+  }
+
+ private:
+  static int64_t compute_total_slots(const int64_t max_size)
+  {
+    /* Keep the load factor low, since the set cannot grow and probe sequences get long when the
+     * set is almost full. */
+    return std::max<int64_t>(LoadFactor::compute_total_slots(max_size, 1, 2), 8);
+  }
+};
+
+#undef CONCURRENT_SET_SLOT_PROBING_BEGIN
+#undef CONCURRENT_SET_SLOT_PROBING_END
+
+}  // namespace blender
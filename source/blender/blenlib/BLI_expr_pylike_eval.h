@@ -58,6 +58,22 @@ eExprPyLike_EvalStatus BLI_expr_pylike_eval(struct ExprPyLike_Parsed *expr,
                                             const double *param_values,
                                             int param_values_len,
                                             double *r_result);
+/**
+ * Evaluate the expression for `batch_size` sets of parameters at once, which is faster than
+ * calling #BLI_expr_pylike_eval for each of them, because expressions without conditional
+ * parts are evaluated one operation at a time over the whole batch.
+ *
+ * \param param_values: Parameters in "structure of arrays" layout: the values of parameter `j`
+ * are `param_values[j * batch_size .. (j + 1) * batch_size - 1]`.
+ * \param r_results: Array of `batch_size` results.
+ * \return The most severe status of all evaluations. Computation errors cannot be attributed to
+ * a single element, evaluate the elements separately if that is necessary.
+ */
+eExprPyLike_EvalStatus BLI_expr_pylike_eval_batch(struct ExprPyLike_Parsed *expr,
+                                                  const double *param_values,
+                                                  int param_values_len,
+                                                  int batch_size,
+                                                  double *r_results);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,94 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A virtual array that keeps its elements compressed in memory. It is meant for large arrays that
+ * are rarely accessed, like rest positions, UV maps that are not being edited or cached simulation
+ * frames, where keeping the data uncompressed in memory is wasteful.
+ *
+ * The elements are split into chunks that are compressed independently with zstd, so that random
+ * access only has to decompress a single chunk. Every thread keeps a few of the most recently
+ * decompressed chunks, so access with some locality does not decompress the same chunk over and
+ * over again. Materializing a range that covers a whole chunk decompresses directly into the
+ * destination.
+ *
+ * Only trivial types are supported, since the elements are compressed as raw bytes. The array is
+ * read-only; to change it, materialize it, modify the copy and compress it again.
+ */
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_generic_virtual_array.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+struct CompressedVArraySettings {
+  /** Number of elements per compressed chunk. */
+  int64_t chunk_size = 16384;
+  /** Zstd compression level, higher levels compress better but slower. */
+  int compression_level = 3;
+  /** Number of decompressed chunks that every thread keeps around. */
+  int cached_chunks_num = 2;
+};
+
+class GVArrayImpl_For_CompressedChunks final : public GVArrayImpl {
+ private:
+  struct CachedChunk {
+    int64_t chunk_index = -1;
+    /** Used to find the least recently used chunk. */
+    int64_t last_use = 0;
+    Array<std::byte> data;
+  };
+
+  struct ChunkCache {
+    Vector<CachedChunk> chunks;
+    int64_t use_counter = 0;
+  };
+
+  int64_t chunk_size_;
+  int cached_chunks_num_;
+  Array<Array<std::byte>> compressed_chunks_;
+  mutable threading::EnumerableThreadSpecific<ChunkCache> caches_;
+
+ public:
+  /**
+   * Compress the elements of the given virtual array. The chunks are compressed in parallel.
+   * The type of the array has to be trivial.
+   */
+  GVArrayImpl_For_CompressedChunks(const GVArray &varray,
+                                   const CompressedVArraySettings &settings = {});
+
+  /** Number of bytes used by the compressed chunks. */
+  int64_t compressed_size() const;
+
+  /**
+   * Free the decompressed chunks of all threads. Must not be called while the array is accessed.
+   */
+  void free_cache();
+
+ private:
+  void get(int64_t index, void *r_value) const override;
+  void get_to_uninitialized(int64_t index, void *r_value) const override;
+
+  void materialize(const IndexMask mask, void *dst) const override;
+  void materialize_to_uninitialized(const IndexMask mask, void *dst) const override;
+  void materialize_compressed(IndexMask mask, void *dst) const override;
+  void materialize_compressed_to_uninitialized(IndexMask mask, void *dst) const override;
+
+  IndexRange chunk_range(int64_t chunk_index) const;
+  void decompress_chunk(int64_t chunk_index, void *dst) const;
+  /** Get the decompressed chunk from the cache of the current thread, decompress it if needed. */
+  const std::byte *cached_chunk(int64_t chunk_index) const;
+  void materialize_impl(IndexMask mask, void *dst, bool compress_indices) const;
+};
+
+/**
+ * Compress the virtual array, see #GVArrayImpl_For_CompressedChunks. Types that are not trivial
+ * cannot be compressed, the array is returned unchanged in that case.
+ */
+GVArray compress_varray(const GVArray &varray, const CompressedVArraySettings &settings = {});
+
+}  // namespace blender
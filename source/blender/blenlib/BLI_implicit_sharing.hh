@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Implicit sharing allows multiple owners to use the same data without copying it. The data is
+ * only copied when one of the owners wants to modify it while it is still shared ("copy on
+ * write"). This makes copies of data structures with large buffers cheap, as long as the buffers
+ * are not modified afterwards.
+ */
+
+#include <atomic>
+
+#include "BLI_assert.h"
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+/**
+ * #ImplicitSharingInfo is the reference counted owner of some shared data. Every owner of the
+ * data is one user. Data with more than one user must be treated as immutable, an owner that
+ * wants to change it has to make a copy first, see #is_mutable.
+ *
+ * Like #bke::AnonymousAttributeID, it is intrinsically reference counted, so that pointers to it
+ * can be stored in DNA structs.
+ */
+class ImplicitSharingInfo : NonCopyable, NonMovable {
+ private:
+  mutable std::atomic<int> users_;
+
+ public:
+  ImplicitSharingInfo(const int initial_users = 1) : users_(initial_users)
+  {
+  }
+
+  virtual ~ImplicitSharingInfo()
+  {
+    BLI_assert(users_ == 0);
+  }
+
+  /** True when the caller is the only user, so it is allowed to modify the data. */
+  bool is_mutable() const
+  {
+    return users_.load(std::memory_order_acquire) == 1;
+  }
+
+  bool is_shared() const
+  {
+    return users_.load(std::memory_order_acquire) >= 2;
+  }
+
+  void add_user() const
+  {
+    users_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void remove_user_and_delete_if_last() const
+  {
+    const int old_user_count = users_.fetch_sub(1, std::memory_order_acq_rel);
+    BLI_assert(old_user_count >= 1);
+    if (old_user_count == 1) {
+      const_cast<ImplicitSharingInfo *>(this)->delete_self_with_data();
+    }
+  }
+
+ private:
+  /** Has to free the #ImplicitSharingInfo and the data it owns. */
+  virtual void delete_self_with_data() = 0;
+};
+
+}  // namespace blender
@@ -0,0 +1,185 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A #CompressedIndexMask owns a set of sorted unique indices, like the array referenced by an
+ * #IndexMask, but stores them in much less memory when the selection is large and sparse.
+ *
+ * The index space is split into blocks of #CompressedIndexMask::block_size indices. Every block
+ * that contains selected indices becomes one segment, which is either:
+ * - A contiguous range, which takes no memory besides the segment itself.
+ * - A span of 16 bit offsets relative to the start of the block.
+ *
+ * So a selection that is neither contiguous nor empty takes two bytes per index instead of eight.
+ *
+ * Iterating over the mask is done per segment with #foreach_segment, which calls the function
+ * either with an #IndexRange or with an #OffsetIndices16. The function is usually a generic
+ * lambda, so that it is compiled for both segment types and the inner loop is devirtualized, the
+ * same way #IndexMask::to_best_mask_type does it.
+ *
+ * Use #to_index_mask to pass the mask to code that only supports #IndexMask.
+ */
+
+#include "BLI_index_mask.hh"
+#include "BLI_index_range.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+class CompressedIndexMask {
+ public:
+  static constexpr int64_t block_size = int64_t(1) << 16;
+
+  /**
+   * Indices of a segment that is not contiguous: offsets relative to the start of its block.
+   * Iterating over it gives the absolute indices.
+   */
+  struct OffsetIndices16 {
+    int64_t offset;
+    Span<uint16_t> indices;
+
+    struct Iterator {
+      int64_t offset;
+      const uint16_t *ptr;
+
+      int64_t operator*() const
+      {
+        return offset + int64_t(*ptr);
+      }
+      Iterator &operator++()
+      {
+        ptr++;
+        return *this;
+      }
+      friend bool operator!=(const Iterator &a, const Iterator &b)
+      {
+        return a.ptr != b.ptr;
+      }
+    };
+
+    Iterator begin() const
+    {
+      return {offset, indices.begin()};
+    }
+    Iterator end() const
+    {
+      return {offset, indices.end()};
+    }
+    int64_t size() const
+    {
+      return indices.size();
+    }
+    int64_t operator[](const int64_t i) const
+    {
+      return offset + int64_t(indices[i]);
+    }
+  };
+
+ private:
+  struct Segment {
+    /** The first index in the segment. */
+    int64_t first;
+    int64_t size;
+    /** Start of the relative indices in #indices_, or -1 when the segment is a range. */
+    int64_t indices_start;
+  };
+
+  /** Sorted by their first index, at most one segment per block. */
+  Vector<Segment> segments_;
+  Vector<uint16_t> indices_;
+  int64_t size_ = 0;
+
+ public:
+  CompressedIndexMask() = default;
+
+  static CompressedIndexMask from_range(IndexRange range);
+  /** The indices have to be a valid #IndexMask: sorted and without duplicates. */
+  static CompressedIndexMask from_indices(Span<int64_t> indices);
+  static CompressedIndexMask from_index_mask(IndexMask mask);
+  /** Select the indices where the span is true. The blocks are built in parallel. */
+  static CompressedIndexMask from_bools(Span<bool> bools);
+
+  static CompressedIndexMask from_union(const CompressedIndexMask &a,
+                                        const CompressedIndexMask &b);
+  static CompressedIndexMask from_intersection(const CompressedIndexMask &a,
+                                               const CompressedIndexMask &b);
+  static CompressedIndexMask from_difference(const CompressedIndexMask &a,
+                                             const CompressedIndexMask &b);
+
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  int64_t segments_num() const
+  {
+    return segments_.size();
+  }
+
+  /** Number of bytes used by the index data, excluding the object itself. */
+  int64_t memory_usage() const
+  {
+    return segments_.size() * int64_t(sizeof(Segment)) +
+           indices_.size() * int64_t(sizeof(uint16_t));
+  }
+
+  bool contains(int64_t index) const;
+
+  /**
+   * Call the function with every segment, either as #IndexRange or as #OffsetIndices16.
+   */
+  template<typename Fn> void foreach_segment(const Fn &fn) const
+  {
+    for (const Segment &segment : segments_) {
+      if (segment.indices_start == -1) {
+        fn(IndexRange(segment.first, segment.size));
+      }
+      else {
+        fn(OffsetIndices16{segment.first & ~(block_size - 1),
+                           indices_.as_span().slice(segment.indices_start, segment.size)});
+      }
+    }
+  }
+
+  template<typename Fn> void foreach_index(const Fn &fn) const
+  {
+    this->foreach_segment([&](const auto &segment) {
+      for (const int64_t i : segment) {
+        fn(i);
+      }
+    });
+  }
+
+  /**
+   * Create an #IndexMask with the same indices. The indices are written to #r_indices unless the
+   * mask is a single range.
+   */
+  IndexMask to_index_mask(Vector<int64_t> &r_indices) const;
+
+ private:
+  /** Add a segment for a block, the offsets have to be sorted and unique. */
+  void append_block(int64_t block_offset, Span<uint16_t> offsets);
+  void append_range(IndexRange range);
+  void append_segment_from(const CompressedIndexMask &other, const Segment &segment);
+
+  /**
+   * Combine two masks block by block. #Fn gets whether an index is in #a and in #b and returns
+   * whether it is in the result. #KeepOnlyA and #KeepOnlyB tell whether blocks that are only
+   * used by one of the masks are copied to the result unchanged.
+   */
+  template<bool KeepOnlyA, bool KeepOnlyB, typename Fn>
+  static CompressedIndexMask combine(const CompressedIndexMask &a,
+                                     const CompressedIndexMask &b,
+                                     const Fn &fn);
+};
+
+}  // namespace blender
@@ -263,6 +263,25 @@ int BLI_bvhtree_ray_cast(const BVHTree *tree,
                          BVHTree_RayCastCallback callback,
                          void *userdata);
 
+/**
+ * Cast \a rays_num rays, with the same results as calling #BLI_bvhtree_ray_cast_ex for each of
+ * them. Rays are traversed in small packets, testing each node against all the rays of a packet
+ * at once (using SIMD when available), which is faster when consecutive rays are coherent
+ * (close origins and similar directions, e.g. projecting a grid of points).
+ *
+ * \param hits: Array of \a rays_num hits, initialized as for #BLI_bvhtree_ray_cast_ex
+ * (i.e. with `index = -1` and `dist` set to the maximum distance).
+ */
+void BLI_bvhtree_ray_cast_packet(const BVHTree *tree,
+                                 const float (*co)[3],
+                                 const float (*dir)[3],
+                                 int rays_num,
+                                 float radius,
+                                 BVHTreeRayHit *hits,
+                                 BVHTree_RayCastCallback callback,
+                                 void *userdata,
+                                 int flag);
+
 /**
  * Calls the callback for every ray intersection
  *
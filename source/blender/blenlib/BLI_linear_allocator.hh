@@ -238,4 +238,27 @@ template<typename Allocator = GuardedAllocator> class LinearAllocator : NonCopya
   }
 };
 
+/**
+ * An allocator that can be passed to containers like #Vector, so that their memory comes from a
+ * #LinearAllocator. Deallocating does nothing, the memory is freed together with the linear
+ * allocator, which has to outlive the container. Since a #LinearAllocator is not thread-safe,
+ * the container must only grow on the thread that owns the allocator.
+ */
+template<typename Allocator = GuardedAllocator> class LinearAllocatorRef {
+ private:
+  LinearAllocator<Allocator> *allocator_ = nullptr;
+
+ public:
+  LinearAllocatorRef() = default;
+  LinearAllocatorRef(LinearAllocator<Allocator> &allocator) : allocator_(&allocator) {}
+
+  void *allocate(const size_t size, const size_t alignment, const char * /*name*/)
+  {
+    BLI_assert(allocator_ != nullptr);
+    return allocator_->allocate(int64_t(size), int64_t(alignment));
+  }
+
+  void deallocate(void * /*ptr*/) {}
+};
+
 }  // namespace blender
@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * A set of #LinearAllocator, one for every thread that uses it. This allows many small
+ * allocations in parallel loops without contention on a global allocator: each thread bumps a
+ * pointer in its own buffers, and all memory is freed at once when the set is destructed.
+ *
+ * \code{.cc}
+ * threading::ThreadLocalLinearAllocator allocators;
+ * threading::parallel_for(range, 512, [&](const IndexRange range) {
+ *   LinearAllocator<> &allocator = allocators.local();
+ *   Vector<int, 0, LinearAllocatorRef<>> indices(allocator);
+ *   ...
+ * });
+ * \endcode
+ *
+ * Memory allocated on one thread may be used on any thread, but an allocator must only be used
+ * to allocate by the thread it belongs to. Keep containers using #LinearAllocatorRef local to
+ * the task that created them.
+ */
+
+#pragma once
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_linear_allocator.hh"
+
+namespace blender::threading {
+
+template<typename Allocator = GuardedAllocator>
+class ThreadLocalLinearAllocator : NonCopyable, NonMovable {
+ private:
+  EnumerableThreadSpecific<LinearAllocator<Allocator>> allocators_;
+
+ public:
+  /**
+   * The allocator of the calling thread, created on first use.
+   */
+  LinearAllocator<Allocator> &local()
+  {
+    return allocators_.local();
+  }
+};
+
+}  // namespace blender::threading
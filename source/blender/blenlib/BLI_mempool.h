@@ -50,6 +50,10 @@ void BLI_mempool_clear(BLI_mempool *pool) ATTR_NONNULL(1);
  */
 void BLI_mempool_destroy(BLI_mempool *pool) ATTR_NONNULL(1);
 int BLI_mempool_len(const BLI_mempool *pool) ATTR_NONNULL(1);
+/**
+ * The number of elements that fit into the allocated chunks, used and free ones.
+ */
+int BLI_mempool_capacity(const BLI_mempool *pool) ATTR_NONNULL(1);
 void *BLI_mempool_findelem(BLI_mempool *pool, unsigned int index) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL(1);
 
@@ -33,6 +33,12 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
 
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
+/* Hints that the given range won't be accessed again soon, so the pages backing it
+ * can be dropped from the process' resident memory (they remain in the OS file cache).
+ * Reading the range again is still valid, the data is then paged in from the file again.
+ * Only whole pages inside the range are released. */
+void BLI_mmap_release_range(BLI_mmap_file *file, size_t offset, size_t length) ATTR_NONNULL(1);
+
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
 
 #ifdef __cplusplus
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -103,6 +104,22 @@ float3 perlin_float3_fractal_distorted(float4 position,
                                        float roughness,
                                        float distortion);
 
+/* Batch versions of 3D perlin noise, evaluating many positions at once. The results are
+ * identical to calling the single position functions for every position, but faster since
+ * multiple positions are evaluated with SIMD instructions where available. */
+
+void perlin_signed(Span<float3> positions, MutableSpan<float> r_values);
+void perlin(Span<float3> positions, MutableSpan<float> r_values);
+void perlin_fractal(Span<float3> positions,
+                    float octaves,
+                    float roughness,
+                    MutableSpan<float> r_values);
+void perlin_fractal_distorted(Span<float3> positions,
+                              float octaves,
+                              float roughness,
+                              float distortion,
+                              MutableSpan<float> r_values);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -83,6 +83,7 @@ template<typename T> class OffsetIndices {
 
 /**
  * Turn an array of sizes into the offset at each index including all previous sizes.
+ * Large arrays are processed in parallel.
  */
 void accumulate_counts_to_offsets(MutableSpan<int> counts_to_offsets, int start_offset = 0);
 
@@ -12,6 +12,8 @@
 #  include <algorithm>
 #endif
 
+#include "BLI_span.hh"
+
 namespace blender {
 
 #ifdef WITH_TBB
@@ -29,4 +31,24 @@ void parallel_sort(RandomAccessIterator begin, RandomAccessIterator end, const C
 }
 #endif
 
+/**
+ * Sort the keys with a parallel least significant digit radix sort. This is usually faster than
+ * #parallel_sort for large arrays of 32 bit keys, at the cost of a temporary copy of the keys.
+ *
+ * Floats are ordered by their value with negative zero before positive zero, and NaN with a set
+ * sign bit first and NaN without sign bit last.
+ */
+void parallel_radix_sort(MutableSpan<int> keys);
+void parallel_radix_sort(MutableSpan<uint32_t> keys);
+void parallel_radix_sort(MutableSpan<float> keys);
+
+/**
+ * Sort the keys like #parallel_radix_sort and reorder the values in the same way. The sort is
+ * stable, values of equal keys keep their relative order. A typical use is to pass the indices
+ * of the keys as values, to group elements by a key.
+ */
+void parallel_radix_sort_by_key(MutableSpan<int> keys, MutableSpan<int> values);
+void parallel_radix_sort_by_key(MutableSpan<uint32_t> keys, MutableSpan<int> values);
+void parallel_radix_sort_by_key(MutableSpan<float> keys, MutableSpan<int> values);
+
 }  // namespace blender
@@ -387,16 +387,63 @@ struct TaskNode;
 typedef void (*TaskGraphNodeRunFunction)(void *__restrict task_data);
 typedef void (*TaskGraphNodeFreeFunction)(void *task_data);
 
+typedef struct TaskGraphNodeSettings {
+  /** High priority nodes are scheduled before other nodes that are ready to run. */
+  eTaskPriority priority;
+  /**
+   * Run the node isolated (see #BLI_task_isolate), so that a node waiting for its own nested
+   * parallel work does not pick up unrelated tasks, for example while holding a lock.
+   */
+  bool use_isolation;
+  /** Optional name used for profiling, must stay valid as long as the graph exists. */
+  const char *name;
+} TaskGraphNodeSettings;
+
+BLI_INLINE void BLI_task_graph_node_settings_defaults(TaskGraphNodeSettings *settings)
+{
+  memset(settings, 0, sizeof(*settings));
+  settings->priority = TASK_PRIORITY_LOW;
+}
+
 struct TaskGraph *BLI_task_graph_create(void);
+/**
+ * Wait until all scheduled work finished. Clears the cancelled state of the graph afterwards,
+ * so it can be reused.
+ */
 void BLI_task_graph_work_and_wait(struct TaskGraph *task_graph);
 void BLI_task_graph_free(struct TaskGraph *task_graph);
 struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
                                             TaskGraphNodeRunFunction run,
                                             void *user_data,
                                             TaskGraphNodeFreeFunction free_func);
+struct TaskNode *BLI_task_graph_node_create_ex(struct TaskGraph *task_graph,
+                                               TaskGraphNodeRunFunction run,
+                                               void *user_data,
+                                               TaskGraphNodeFreeFunction free_func,
+                                               const TaskGraphNodeSettings *settings);
 bool BLI_task_graph_node_push_work(struct TaskNode *task_node);
 void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_node);
 
+/**
+ * Cancel the scheduled work. Nodes that did not start yet are skipped, running nodes can poll
+ * #BLI_task_graph_is_cancelled to stop early.
+ */
+void BLI_task_graph_cancel(struct TaskGraph *task_graph);
+bool BLI_task_graph_is_cancelled(const struct TaskGraph *task_graph);
+
+/**
+ * Capture the start and end time and thread of every node execution. Events are kept until
+ * #BLI_task_graph_profiling_clear or until the graph is freed.
+ */
+void BLI_task_graph_profiling_enable(struct TaskGraph *task_graph, bool enable);
+void BLI_task_graph_profiling_clear(struct TaskGraph *task_graph);
+/**
+ * Write the captured events as Chrome trace JSON, viewable in `chrome://tracing` or Perfetto.
+ * \return false when the file could not be written.
+ */
+bool BLI_task_graph_profiling_write_chrome_trace(struct TaskGraph *task_graph,
+                                                 const char *filepath);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -28,6 +28,8 @@
 #include "BLI_heap_simple.h"
 #include "BLI_kdopbvh.h"
 #include "BLI_math.h"
+#include "BLI_math_bits.h"
+#include "BLI_simd.h"
 #include "BLI_stack.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
@@ -50,9 +52,13 @@
  */
 #ifdef DEBUG
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 0
+#  define KDOPBVH_REFIT_THREAD_LEAF_THRESHOLD 0
 #else
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
+#  define KDOPBVH_REFIT_THREAD_LEAF_THRESHOLD (1 << 15)
 #endif
+/** Number of leafs handled by each task of a threaded #refit_kdop_hull. */
+#define KDOPBVH_REFIT_CHUNK_LEAFS (1 << 13)
 
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
@@ -370,17 +376,14 @@ static void create_kdop_hull(
 }
 
 /**
- * \note depends on the fact that the BVH's for each face is already built
+ * Expand \a bv to contain the leafs in the `[start, end)` range of #BVHTree.nodes.
  */
-static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+static void refit_kdop_hull_range(const BVHTree *tree, float *__restrict bv, int start, int end)
 {
   float newmin, newmax;
-  float *__restrict bv = node->bv;
   int j;
   axis_t axis_iter;
 
-  node_minmax_init(tree, node);
-
   for (j = start; j < end; j++) {
     float *__restrict node_bv = tree->nodes[j]->bv;
 
@@ -399,6 +402,72 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  int start, end;
+  /** #BVHTree.axis values for each chunk of #KDOPBVH_REFIT_CHUNK_LEAFS leafs. */
+  float *chunks_bv;
+} BVHRefitData;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int chunk,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHRefitData *data = userdata;
+  const BVHTree *tree = data->tree;
+  float(*bv)[2] = (float(*)[2])(data->chunks_bv + (size_t)chunk * (size_t)tree->axis);
+
+  for (axis_t axis_iter = tree->start_axis; axis_iter != tree->stop_axis; axis_iter++) {
+    bv[axis_iter][0] = FLT_MAX;
+    bv[axis_iter][1] = -FLT_MAX;
+  }
+
+  const int start = data->start + chunk * KDOPBVH_REFIT_CHUNK_LEAFS;
+  const int end = min_ii(start + KDOPBVH_REFIT_CHUNK_LEAFS, data->end);
+  refit_kdop_hull_range(tree, (float *)bv, start, end);
+}
+
+/**
+ * \note depends on the fact that the BVH's for each face is already built
+ */
+static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  node_minmax_init(tree, node);
+
+  if (end - start <= KDOPBVH_REFIT_THREAD_LEAF_THRESHOLD) {
+    refit_kdop_hull_range(tree, node->bv, start, end);
+    return;
+  }
+
+  /* The top levels of the tree have too few branches to be built in parallel,
+   * refit their (large) range of leafs in parallel instead. */
+  const int chunks_num = (end - start + KDOPBVH_REFIT_CHUNK_LEAFS - 1) /
+                         KDOPBVH_REFIT_CHUNK_LEAFS;
+  BVHRefitData data = {
+      .tree = tree,
+      .start = start,
+      .end = end,
+      .chunks_bv = MEM_mallocN(sizeof(float) * (size_t)tree->axis * (size_t)chunks_num,
+                               __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, chunks_num, &data, refit_kdop_hull_task_cb, &settings);
+
+  float(*bv)[2] = (float(*)[2])node->bv;
+  for (int chunk = 0; chunk < chunks_num; chunk++) {
+    const float(*chunk_bv)[2] = (const float(*)[2])(data.chunks_bv +
+                                                     (size_t)chunk * (size_t)tree->axis);
+    for (axis_t axis_iter = tree->start_axis; axis_iter != tree->stop_axis; axis_iter++) {
+      bv[axis_iter][0] = min_ff(bv[axis_iter][0], chunk_bv[axis_iter][0]);
+      bv[axis_iter][1] = max_ff(bv[axis_iter][1], chunk_bv[axis_iter][1]);
+    }
+  }
+
+  MEM_freeN(data.chunks_bv);
+}
+
 /**
  * only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake */
@@ -2103,6 +2172,192 @@ void BLI_bvhtree_ray_cast_all(const BVHTree *tree,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name BLI_bvhtree_ray_cast_packet
+ *
+ * Casts groups of rays together, each node being tested against all the rays of the packet at
+ * once and visited when any of them hits it.
+ *
+ * \{ */
+
+#define BVH_RAYCAST_PACKET_SIZE 4
+
+typedef struct BVHRayCastPacketData {
+  BVHTree_RayCastCallback callback;
+  void *userdata;
+
+  BVHRayCastData rays[BVH_RAYCAST_PACKET_SIZE];
+
+  /* Per axis values of all the rays of the packet, for the bounding volume test. */
+  float origin[3][BVH_RAYCAST_PACKET_SIZE];
+  float idot_axis[3][BVH_RAYCAST_PACKET_SIZE];
+  /* Copy of the #BVHRayCastData.hit distances. */
+  float hit_dist[BVH_RAYCAST_PACKET_SIZE];
+} BVHRayCastPacketData;
+
+/**
+ * Packet version of #fast_ray_nearest_hit.
+ *
+ * \return The mask of the rays (within \a active_mask) hitting the bounding volume of the node,
+ * the distance to it being written in \a r_dist.
+ */
+static int ray_packet_nearest_hit(const BVHRayCastPacketData *data,
+                                  const BVHNode *node,
+                                  const int active_mask,
+                                  float r_dist[BVH_RAYCAST_PACKET_SIZE])
+{
+  const float *bv = node->bv;
+
+#ifdef BLI_HAVE_SSE2
+  __m128 t_near = _mm_set1_ps(-FLT_MAX);
+  __m128 t_far = _mm_set1_ps(FLT_MAX);
+  for (int axis = 0; axis < 3; axis++) {
+    const __m128 origin = _mm_loadu_ps(data->origin[axis]);
+    const __m128 idot = _mm_loadu_ps(data->idot_axis[axis]);
+    const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * axis]), origin), idot);
+    const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(bv[2 * axis + 1]), origin), idot);
+    t_near = _mm_max_ps(t_near, _mm_min_ps(t1, t2));
+    t_far = _mm_min_ps(t_far, _mm_max_ps(t1, t2));
+  }
+  const __m128 is_hit = _mm_and_ps(
+      _mm_and_ps(_mm_cmple_ps(t_near, t_far), _mm_cmpge_ps(t_far, _mm_setzero_ps())),
+      _mm_cmplt_ps(t_near, _mm_loadu_ps(data->hit_dist)));
+  _mm_storeu_ps(r_dist, t_near);
+  return _mm_movemask_ps(is_hit) & active_mask;
+#else
+  int mask = 0;
+  for (int i = 0; i < BVH_RAYCAST_PACKET_SIZE; i++) {
+    if ((active_mask & (1 << i)) == 0) {
+      continue;
+    }
+    float t_near = -FLT_MAX;
+    float t_far = FLT_MAX;
+    for (int axis = 0; axis < 3; axis++) {
+      const float t1 = (bv[2 * axis] - data->origin[axis][i]) * data->idot_axis[axis][i];
+      const float t2 = (bv[2 * axis + 1] - data->origin[axis][i]) * data->idot_axis[axis][i];
+      t_near = max_ff(t_near, min_ff(t1, t2));
+      t_far = min_ff(t_far, max_ff(t1, t2));
+    }
+    r_dist[i] = t_near;
+    if (t_near <= t_far && t_far >= 0.0f && t_near < data->hit_dist[i]) {
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+static void dfs_raycast_packet(BVHRayCastPacketData *data, const BVHNode *node, int active_mask)
+{
+  float dist[BVH_RAYCAST_PACKET_SIZE];
+  const int mask = ray_packet_nearest_hit(data, node, active_mask, dist);
+  if (mask == 0) {
+    return;
+  }
+
+  if (node->node_num == 0) {
+    for (int i = 0; i < BVH_RAYCAST_PACKET_SIZE; i++) {
+      if ((mask & (1 << i)) == 0) {
+        continue;
+      }
+      BVHRayCastData *ray_data = &data->rays[i];
+      if (data->callback) {
+        data->callback(data->userdata, node->index, &ray_data->ray, &ray_data->hit);
+      }
+      else {
+        ray_data->hit.index = node->index;
+        ray_data->hit.dist = dist[i];
+        madd_v3_v3v3fl(ray_data->hit.co, ray_data->ray.origin, ray_data->ray.direction, dist[i]);
+      }
+      data->hit_dist[i] = ray_data->hit.dist;
+    }
+  }
+  else {
+    /* Pick loop direction to dive into the tree, based on the first ray of the packet
+     * (rays are expected to be coherent). */
+    const int first_ray = bitscan_forward_i(mask);
+    if (data->rays[first_ray].ray_dot_axis[node->main_axis] > 0.0f) {
+      for (int i = 0; i != node->node_num; i++) {
+        dfs_raycast_packet(data, node->children[i], mask);
+      }
+    }
+    else {
+      for (int i = node->node_num - 1; i >= 0; i--) {
+        dfs_raycast_packet(data, node->children[i], mask);
+      }
+    }
+  }
+}
+
+void BLI_bvhtree_ray_cast_packet(const BVHTree *tree,
+                                 const float (*co)[3],
+                                 const float (*dir)[3],
+                                 const int rays_num,
+                                 float radius,
+                                 BVHTreeRayHit *hits,
+                                 BVHTree_RayCastCallback callback,
+                                 void *userdata,
+                                 int flag)
+{
+  BVHNode *root = tree->nodes[tree->leaf_num];
+  if (root == NULL) {
+    return;
+  }
+
+  if (radius != 0.0f) {
+    /* The packet bounding volume test doesn't support a radius (like #fast_ray_nearest_hit). */
+    for (int i = 0; i < rays_num; i++) {
+      BLI_bvhtree_ray_cast_ex(tree, co[i], dir[i], radius, &hits[i], callback, userdata, flag);
+    }
+    return;
+  }
+
+  BVHRayCastPacketData data;
+  data.callback = callback;
+  data.userdata = userdata;
+
+  for (int packet_start = 0; packet_start < rays_num; packet_start += BVH_RAYCAST_PACKET_SIZE) {
+    const int packet_len = min_ii(rays_num - packet_start, BVH_RAYCAST_PACKET_SIZE);
+    for (int i = 0; i < BVH_RAYCAST_PACKET_SIZE; i++) {
+      BVHRayCastData *ray_data = &data.rays[i];
+      if (i >= packet_len) {
+        /* Unused lanes, never part of the active mask. */
+        for (int axis = 0; axis < 3; axis++) {
+          data.origin[axis][i] = 0.0f;
+          data.idot_axis[axis][i] = 0.0f;
+        }
+        data.hit_dist[i] = 0.0f;
+        continue;
+      }
+      const int ray_index = packet_start + i;
+      BLI_ASSERT_UNIT_V3(dir[ray_index]);
+
+      ray_data->tree = tree;
+      ray_data->callback = callback;
+      ray_data->userdata = userdata;
+      copy_v3_v3(ray_data->ray.origin, co[ray_index]);
+      copy_v3_v3(ray_data->ray.direction, dir[ray_index]);
+      ray_data->ray.radius = 0.0f;
+      bvhtree_ray_cast_data_precalc(ray_data, flag);
+      ray_data->hit = hits[ray_index];
+
+      for (int axis = 0; axis < 3; axis++) {
+        data.origin[axis][i] = ray_data->ray.origin[axis];
+        data.idot_axis[axis][i] = ray_data->idot_axis[axis];
+      }
+      data.hit_dist[i] = ray_data->hit.dist;
+    }
+
+    dfs_raycast_packet(&data, root, (1 << packet_len) - 1);
+
+    for (int i = 0; i < packet_len; i++) {
+      hits[packet_start + i] = data.rays[i].hit;
+    }
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name BLI_bvhtree_range_query
  *
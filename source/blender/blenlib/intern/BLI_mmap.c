@@ -207,6 +207,28 @@ void *BLI_mmap_get_pointer(BLI_mmap_file *file)
   return file->memory;
 }
 
+void BLI_mmap_release_range(BLI_mmap_file *file, size_t offset, size_t length)
+{
+#ifndef WIN32
+  if (file->io_error || (offset + length > file->length)) {
+    return;
+  }
+
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  /* Only release pages which are entirely inside the range,
+   * neighboring data may still be needed. */
+  const size_t begin = ((size_t)file->memory + offset + page_size - 1) & ~(page_size - 1);
+  const size_t end = ((size_t)file->memory + offset + length) & ~(page_size - 1);
+  if (begin < end) {
+    /* The mapping is private and read-only, so this never discards modifications. */
+    madvise((void *)begin, end - begin, MADV_DONTNEED);
+  }
+#else
+  /* Windows trims the working set of file mappings on its own. */
+  UNUSED_VARS(file, offset, length);
+#endif
+}
+
 void BLI_mmap_free(BLI_mmap_file *file)
 {
 #ifndef WIN32
@@ -270,6 +270,187 @@ eExprPyLike_EvalStatus BLI_expr_pylike_eval(ExprPyLike_Parsed *expr,
   return EXPR_PYLIKE_SUCCESS;
 }
 
+static bool expr_has_jumps(const ExprPyLike_Parsed *expr)
+{
+  for (int i = 0; i < expr->ops_count; i++) {
+    switch (expr->ops[i].opcode) {
+      case OPCODE_JMP:
+      case OPCODE_JMP_ELSE:
+      case OPCODE_JMP_OR:
+      case OPCODE_JMP_AND:
+      case OPCODE_CMP_CHAIN:
+        return true;
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
+/* Evaluate a program without jumps one operation at a time over the whole batch, so that the
+ * dispatch of every operation is amortized over all the elements. Every stack slot is a column
+ * of `batch_size` values. */
+static eExprPyLike_EvalStatus expr_eval_batch_columns(ExprPyLike_Parsed *expr,
+                                                      const double *param_values,
+                                                      int param_values_len,
+                                                      int batch_size,
+                                                      double *r_results)
+{
+  double *stack = MEM_malloc_arrayN(
+      (size_t)expr->max_stack * (size_t)batch_size, sizeof(double), __func__);
+  ExprOp *ops = expr->ops;
+  int sp = 0;
+  eExprPyLike_EvalStatus status = EXPR_PYLIKE_SUCCESS;
+
+#define COLUMN(index) (stack + (size_t)(index) * (size_t)batch_size)
+#define FAIL_IF(condition) \
+  if (condition) { \
+    status = EXPR_PYLIKE_FATAL_ERROR; \
+    goto finally; \
+  } \
+  ((void)0)
+
+  feclearexcept(FE_ALL_EXCEPT);
+
+  for (int pc = 0; pc < expr->ops_count; pc++) {
+    switch (ops[pc].opcode) {
+      case OPCODE_CONST: {
+        FAIL_IF(sp >= expr->max_stack);
+        double *dst = COLUMN(sp++);
+        const double value = ops[pc].arg.dval;
+        for (int i = 0; i < batch_size; i++) {
+          dst[i] = value;
+        }
+        break;
+      }
+      case OPCODE_PARAMETER:
+        FAIL_IF(sp >= expr->max_stack || ops[pc].arg.ival >= param_values_len);
+        memcpy(COLUMN(sp++),
+               param_values + (size_t)ops[pc].arg.ival * (size_t)batch_size,
+               sizeof(double) * (size_t)batch_size);
+        break;
+      case OPCODE_FUNC1: {
+        FAIL_IF(sp < 1);
+        double *a = COLUMN(sp - 1);
+        const UnaryOpFunc func = ops[pc].arg.func1;
+        for (int i = 0; i < batch_size; i++) {
+          a[i] = func(a[i]);
+        }
+        break;
+      }
+      case OPCODE_FUNC2: {
+        FAIL_IF(sp < 2);
+        double *a = COLUMN(sp - 2);
+        const double *b = COLUMN(sp - 1);
+        const BinaryOpFunc func = ops[pc].arg.func2;
+        for (int i = 0; i < batch_size; i++) {
+          a[i] = func(a[i], b[i]);
+        }
+        sp--;
+        break;
+      }
+      case OPCODE_FUNC3: {
+        FAIL_IF(sp < 3);
+        double *a = COLUMN(sp - 3);
+        const double *b = COLUMN(sp - 2);
+        const double *c = COLUMN(sp - 1);
+        const TernaryOpFunc func = ops[pc].arg.func3;
+        for (int i = 0; i < batch_size; i++) {
+          a[i] = func(a[i], b[i], c[i]);
+        }
+        sp -= 2;
+        break;
+      }
+      case OPCODE_MIN:
+      case OPCODE_MAX: {
+        FAIL_IF(sp < ops[pc].arg.ival);
+        const bool is_min = ops[pc].opcode == OPCODE_MIN;
+        for (int j = 1; j < ops[pc].arg.ival; j++, sp--) {
+          double *a = COLUMN(sp - 2);
+          const double *b = COLUMN(sp - 1);
+          for (int i = 0; i < batch_size; i++) {
+            if (is_min) {
+              CLAMP_MAX(a[i], b[i]);
+            }
+            else {
+              CLAMP_MIN(a[i], b[i]);
+            }
+          }
+        }
+        break;
+      }
+      default:
+        FAIL_IF(true);
+    }
+  }
+
+  FAIL_IF(sp != 1);
+
+  memcpy(r_results, COLUMN(0), sizeof(double) * (size_t)batch_size);
+
+  /* Detect floating point evaluation errors. */
+  if (fetestexcept(FE_INVALID)) {
+    status = EXPR_PYLIKE_MATH_ERROR;
+  }
+  else if (fetestexcept(FE_DIVBYZERO)) {
+    status = EXPR_PYLIKE_DIV_BY_ZERO;
+  }
+
+#undef FAIL_IF
+#undef COLUMN
+
+finally:
+  MEM_freeN(stack);
+  return status;
+}
+
+eExprPyLike_EvalStatus BLI_expr_pylike_eval_batch(ExprPyLike_Parsed *expr,
+                                                  const double *param_values,
+                                                  int param_values_len,
+                                                  int batch_size,
+                                                  double *r_results)
+{
+  if (batch_size <= 0) {
+    return EXPR_PYLIKE_SUCCESS;
+  }
+
+  if (!BLI_expr_pylike_is_valid(expr)) {
+    memset(r_results, 0, sizeof(double) * (size_t)batch_size);
+    return EXPR_PYLIKE_INVALID;
+  }
+
+  if (expr->max_stack <= 0 || expr->max_stack > 1000) {
+    memset(r_results, 0, sizeof(double) * (size_t)batch_size);
+    return EXPR_PYLIKE_FATAL_ERROR;
+  }
+
+  if (!expr_has_jumps(expr)) {
+    eExprPyLike_EvalStatus status = expr_eval_batch_columns(
+        expr, param_values, param_values_len, batch_size, r_results);
+    if (status == EXPR_PYLIKE_FATAL_ERROR) {
+      memset(r_results, 0, sizeof(double) * (size_t)batch_size);
+    }
+    return status;
+  }
+
+  /* Control flow differs between the elements, evaluate them one by one. */
+  double *params = BLI_array_alloca(params, MAX2(param_values_len, 1));
+  eExprPyLike_EvalStatus status = EXPR_PYLIKE_SUCCESS;
+
+  for (int i = 0; i < batch_size; i++) {
+    for (int j = 0; j < param_values_len; j++) {
+      params[j] = param_values[(size_t)j * (size_t)batch_size + i];
+    }
+    eExprPyLike_EvalStatus elem_status = BLI_expr_pylike_eval(
+        expr, params, param_values_len, &r_results[i]);
+    if (elem_status > status) {
+      status = elem_status;
+    }
+  }
+
+  return status;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
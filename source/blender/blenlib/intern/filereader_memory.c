@@ -86,6 +86,11 @@ FileReader *BLI_filereader_new_memory(const void *data, size_t len)
  * This avoids system call overhead and can significantly speed up file loading.
  */
 
+/* Reads of at least this size drop the mapped pages once they have been copied,
+ * so large arrays (mesh layers, packed files, caches...) don't end up being resident twice:
+ * once in the mapping and once in the destination buffer. */
+#define MMAP_RELEASE_READ_SIZE_MIN (256 * 1024)
+
 static ssize_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
 {
   MemoryReader *mem = (MemoryReader *)reader;
@@ -97,6 +102,10 @@ static ssize_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
     return 0;
   }
 
+  if (readsize >= MMAP_RELEASE_READ_SIZE_MIN) {
+    BLI_mmap_release_range(mem->mmap, mem->reader.offset, readsize);
+  }
+
   mem->reader.offset += readsize;
 
   return readsize;
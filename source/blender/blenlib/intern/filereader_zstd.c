@@ -12,9 +12,13 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 
 #include "MEM_guardedalloc.h"
 
+/* Frames are written with a size of 1mb of uncompressed data, see `writefile.cc`. */
+#define ZSTD_READAHEAD_FRAMES_DEFAULT 16
+
 typedef struct {
   FileReader reader;
 
@@ -29,8 +33,13 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
+    /* Decompressed frames `[cached_frame, cached_frame + cached_frames_num)`,
+     * entries may be NULL when decompressing the frame failed. */
+    char **cached_content;
     int cached_frame;
+    int cached_frames_num;
+    /* Maximum number of frames decompressed at once when reading sequentially. */
+    int readahead_frames;
   } seek;
 } ZstdReader;
 
@@ -127,6 +136,7 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
 
   return true;
 }
@@ -154,41 +164,97 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+static void zstd_cache_free(ZstdReader *zstd)
+{
+  for (int i = 0; i < zstd->seek.cached_frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
+  }
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+}
+
+typedef struct ZstdDecompressFramesData {
+  ZstdReader *zstd;
+  const char *compressed_data;
+} ZstdDecompressFramesData;
+
+static void zstd_decompress_frame_task(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ZstdDecompressFramesData *data = userdata;
+  ZstdReader *zstd = data->zstd;
+  const int frame = zstd->seek.cached_frame + i;
+
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] -
+                                 zstd->seek.compressed_ofs[frame];
+  const size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                                   zstd->seek.uncompressed_ofs[frame];
+  const size_t compressed_ofs = zstd->seek.compressed_ofs[frame] -
+                                zstd->seek.compressed_ofs[zstd->seek.cached_frame];
+  const char *compressed_data = data->compressed_data + compressed_ofs;
+
+  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  /* The decompression context is not thread-safe, so only use it from the reading thread. */
+  const size_t res = (zstd->seek.cached_frames_num == 1) ?
+                         ZSTD_decompressDCtx(zstd->ctx,
+                                             uncompressed_data,
+                                             uncompressed_size,
+                                             compressed_data,
+                                             compressed_size) :
+                         ZSTD_decompress(
+                             uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    MEM_freeN(uncompressed_data);
+    uncompressed_data = NULL;
+  }
+  zstd->seek.cached_content[i] = uncompressed_data;
+}
+
+/* Ensure that the wanted frame is loaded.
+ *
+ * When reading sequentially (the wanted frame follows the cached ones), the next
+ * `readahead_frames` frames are read at once and decompressed in parallel. */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
+  if (frame >= zstd->seek.cached_frame &&
+      frame < zstd->seek.cached_frame + zstd->seek.cached_frames_num) {
     /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+    return zstd->seek.cached_content[frame - zstd->seek.cached_frame];
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  const bool is_sequential = (zstd->seek.cached_frame == -1) ||
+                             (frame == zstd->seek.cached_frame + zstd->seek.cached_frames_num);
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
+  zstd_cache_free(zstd);
+
+  const int frames_num = is_sequential ?
+                             min_ii(zstd->seek.readahead_frames, zstd->seek.frames_num - frame) :
+                             1;
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] -
+                                 zstd->seek.compressed_ofs[frame];
 
-  char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size) {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
     return NULL;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  zstd->seek.cached_frame = frame;
+  zstd->seek.cached_frames_num = frames_num;
+
+  ZstdDecompressFramesData data = {zstd, compressed_data};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = frames_num > 1;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_task, &settings);
+
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
-    return NULL;
-  }
 
-  zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  return zstd->seek.cached_content[0];
 }
 
 static ssize_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -281,10 +347,8 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be NULL, see: T99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
-    }
+    zstd_cache_free(zstd);
+    MEM_freeN(zstd->seek.cached_content);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -294,7 +358,7 @@ static void zstd_close(FileReader *reader)
   MEM_freeN(zstd);
 }
 
-FileReader *BLI_filereader_new_zstd(FileReader *base)
+FileReader *BLI_filereader_new_zstd_ex(FileReader *base, int readahead_frames)
 {
   ZstdReader *zstd = MEM_callocN(sizeof(ZstdReader), __func__);
 
@@ -304,6 +368,10 @@ FileReader *BLI_filereader_new_zstd(FileReader *base)
   if (zstd_read_seek_table(zstd)) {
     zstd->reader.read = zstd_read_seekable;
     zstd->reader.seek = zstd_seek;
+
+    zstd->seek.readahead_frames = max_ii(readahead_frames, 1);
+    zstd->seek.cached_content = MEM_calloc_arrayN(
+        zstd->seek.readahead_frames, sizeof(char *), __func__);
   }
   else {
     zstd->reader.read = zstd_read;
@@ -323,3 +391,8 @@ FileReader *BLI_filereader_new_zstd(FileReader *base)
 
   return (FileReader *)zstd;
 }
+
+FileReader *BLI_filereader_new_zstd(FileReader *base)
+{
+  return BLI_filereader_new_zstd_ex(base, ZSTD_READAHEAD_FRAMES_DEFAULT);
+}
@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <cstring>
+
+#include <zstd.h>
+
+#include "BLI_generic_virtual_array_compressed.hh"
+#include "BLI_task.hh"
+
+namespace blender {
+
+GVArrayImpl_For_CompressedChunks::GVArrayImpl_For_CompressedChunks(
+    const GVArray &varray, const CompressedVArraySettings &settings)
+    : GVArrayImpl(varray.type(), varray.size()),
+      chunk_size_(std::max<int64_t>(settings.chunk_size, 1)),
+      cached_chunks_num_(std::max(settings.cached_chunks_num, 1))
+{
+  BLI_assert(type_->is_trivial());
+  const int64_t chunks_num = (size_ + chunk_size_ - 1) / chunk_size_;
+  compressed_chunks_.reinitialize(chunks_num);
+
+  const int64_t element_size = type_->size();
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    Array<std::byte> uncompressed(chunk_size_ * element_size, NoInitialization());
+    Array<std::byte> compressed(int64_t(ZSTD_compressBound(size_t(uncompressed.size()))),
+                                NoInitialization());
+    for (const int64_t chunk_index : range) {
+      const IndexRange chunk = this->chunk_range(chunk_index);
+      varray.materialize_compressed_to_uninitialized(chunk, uncompressed.data());
+      const size_t compressed_size = ZSTD_compress(compressed.data(),
+                                                   size_t(compressed.size()),
+                                                   uncompressed.data(),
+                                                   size_t(chunk.size() * element_size),
+                                                   settings.compression_level);
+      BLI_assert(!ZSTD_isError(compressed_size));
+      compressed_chunks_[chunk_index] = compressed.as_span().take_front(int64_t(compressed_size));
+    }
+  });
+}
+
+int64_t GVArrayImpl_For_CompressedChunks::compressed_size() const
+{
+  int64_t size = 0;
+  for (const Array<std::byte> &chunk : compressed_chunks_) {
+    size += chunk.size();
+  }
+  return size;
+}
+
+void GVArrayImpl_For_CompressedChunks::free_cache()
+{
+  for (ChunkCache &cache : caches_) {
+    cache.chunks.clear_and_shrink();
+  }
+}
+
+IndexRange GVArrayImpl_For_CompressedChunks::chunk_range(const int64_t chunk_index) const
+{
+  const int64_t start = chunk_index * chunk_size_;
+  return IndexRange(start, std::min(chunk_size_, size_ - start));
+}
+
+void GVArrayImpl_For_CompressedChunks::decompress_chunk(const int64_t chunk_index,
+                                                        void *dst) const
+{
+  const Span<std::byte> compressed = compressed_chunks_[chunk_index];
+  const size_t decompressed_size = size_t(this->chunk_range(chunk_index).size() * type_->size());
+  const size_t result = ZSTD_decompress(
+      dst, decompressed_size, compressed.data(), size_t(compressed.size()));
+  BLI_assert(result == decompressed_size);
+  UNUSED_VARS_NDEBUG(result);
+}
+
+const std::byte *GVArrayImpl_For_CompressedChunks::cached_chunk(const int64_t chunk_index) const
+{
+  ChunkCache &cache = caches_.local();
+  cache.use_counter++;
+  for (CachedChunk &chunk : cache.chunks) {
+    if (chunk.chunk_index == chunk_index) {
+      chunk.last_use = cache.use_counter;
+      return chunk.data.data();
+    }
+  }
+
+  CachedChunk *chunk;
+  if (cache.chunks.size() < cached_chunks_num_) {
+    cache.chunks.append_as();
+    chunk = &cache.chunks.last();
+    chunk->data.reinitialize(chunk_size_ * type_->size());
+  }
+  else {
+    chunk = std::min_element(
+        cache.chunks.begin(), cache.chunks.end(), [](const CachedChunk &a, const CachedChunk &b) {
+          return a.last_use < b.last_use;
+        });
+  }
+  this->decompress_chunk(chunk_index, chunk->data.data());
+  chunk->chunk_index = chunk_index;
+  chunk->last_use = cache.use_counter;
+  return chunk->data.data();
+}
+
+void GVArrayImpl_For_CompressedChunks::get(const int64_t index, void *r_value) const
+{
+  this->get_to_uninitialized(index, r_value);
+}
+
+void GVArrayImpl_For_CompressedChunks::get_to_uninitialized(const int64_t index,
+                                                            void *r_value) const
+{
+  const int64_t element_size = type_->size();
+  const int64_t chunk_index = index / chunk_size_;
+  const std::byte *chunk = this->cached_chunk(chunk_index);
+  const int64_t index_in_chunk = index - chunk_index * chunk_size_;
+  memcpy(r_value, chunk + index_in_chunk * element_size, size_t(element_size));
+}
+
+void GVArrayImpl_For_CompressedChunks::materialize_impl(const IndexMask mask,
+                                                        void *dst,
+                                                        const bool compress_indices) const
+{
+  const int64_t element_size = type_->size();
+  std::byte *dst_bytes = static_cast<std::byte *>(dst);
+  int64_t mask_start = 0;
+  while (mask_start < mask.size()) {
+    const int64_t chunk_index = mask[mask_start] / chunk_size_;
+    const IndexRange chunk = this->chunk_range(chunk_index);
+    /* Find the part of the mask in the current chunk. */
+    const int64_t mask_end = std::lower_bound(mask.begin() + mask_start,
+                                              mask.end(),
+                                              chunk.one_after_last()) -
+                             mask.begin();
+    const IndexMask chunk_mask = mask.slice(mask_start, mask_end - mask_start);
+    std::byte *chunk_dst = dst_bytes +
+                           (compress_indices ? mask_start : chunk.start()) * element_size;
+
+    if (chunk_mask.size() == chunk.size()) {
+      /* The whole chunk is used, so there is no need to go through the cache. */
+      this->decompress_chunk(chunk_index, chunk_dst);
+    }
+    else {
+      const std::byte *chunk_data = this->cached_chunk(chunk_index);
+      for (const int64_t i : chunk_mask.index_range()) {
+        const int64_t index_in_chunk = chunk_mask[i] - chunk.start();
+        const int64_t dst_index = compress_indices ? i : index_in_chunk;
+        memcpy(chunk_dst + dst_index * element_size,
+               chunk_data + index_in_chunk * element_size,
+               size_t(element_size));
+      }
+    }
+    mask_start = mask_end;
+  }
+}
+
+void GVArrayImpl_For_CompressedChunks::materialize(const IndexMask mask, void *dst) const
+{
+  this->materialize_impl(mask, dst, false);
+}
+
+void GVArrayImpl_For_CompressedChunks::materialize_to_uninitialized(const IndexMask mask,
+                                                                    void *dst) const
+{
+  this->materialize_impl(mask, dst, false);
+}
+
+void GVArrayImpl_For_CompressedChunks::materialize_compressed(const IndexMask mask,
+                                                              void *dst) const
+{
+  this->materialize_impl(mask, dst, true);
+}
+
+void GVArrayImpl_For_CompressedChunks::materialize_compressed_to_uninitialized(
+    const IndexMask mask, void *dst) const
+{
+  this->materialize_impl(mask, dst, true);
+}
+
+GVArray compress_varray(const GVArray &varray, const CompressedVArraySettings &settings)
+{
+  if (!varray || !varray.type().is_trivial() || varray.is_single()) {
+    return varray;
+  }
+  return GVArray::For<GVArrayImpl_For_CompressedChunks>(varray, settings);
+}
+
+}  // namespace blender
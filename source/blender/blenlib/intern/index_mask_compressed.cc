@@ -0,0 +1,244 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+
+#include "BLI_array.hh"
+#include "BLI_index_mask_compressed.hh"
+#include "BLI_task.hh"
+
+namespace blender {
+
+static int64_t block_offset_of(const int64_t index)
+{
+  return index & ~(CompressedIndexMask::block_size - 1);
+}
+
+void CompressedIndexMask::append_range(const IndexRange range)
+{
+  int64_t first = range.first();
+  const int64_t end = first + range.size();
+  while (first < end) {
+    const int64_t block_end = block_offset_of(first) + block_size;
+    const int64_t size = std::min(end, block_end) - first;
+    segments_.append({first, size, -1});
+    size_ += size;
+    first += size;
+  }
+}
+
+void CompressedIndexMask::append_block(const int64_t block_offset, const Span<uint16_t> offsets)
+{
+  if (offsets.is_empty()) {
+    return;
+  }
+  BLI_assert(segments_.is_empty() || block_offset_of(segments_.last().first) < block_offset);
+  const int64_t size = offsets.size();
+  const int64_t first = block_offset + int64_t(offsets.first());
+  if (int64_t(offsets.last()) - int64_t(offsets.first()) + 1 == size) {
+    segments_.append({first, size, -1});
+  }
+  else {
+    segments_.append({first, size, indices_.size()});
+    indices_.extend(offsets);
+  }
+  size_ += size;
+}
+
+void CompressedIndexMask::append_segment_from(const CompressedIndexMask &other,
+                                              const Segment &segment)
+{
+  if (segment.indices_start == -1) {
+    segments_.append(segment);
+    size_ += segment.size;
+    return;
+  }
+  this->append_block(block_offset_of(segment.first),
+                     other.indices_.as_span().slice(segment.indices_start, segment.size));
+}
+
+CompressedIndexMask CompressedIndexMask::from_range(const IndexRange range)
+{
+  CompressedIndexMask mask;
+  mask.append_range(range);
+  return mask;
+}
+
+CompressedIndexMask CompressedIndexMask::from_indices(const Span<int64_t> indices)
+{
+  BLI_assert(IndexMask::indices_are_valid_index_mask(indices));
+  CompressedIndexMask mask;
+  Vector<uint16_t> offsets;
+  int64_t i = 0;
+  while (i < indices.size()) {
+    const int64_t block_offset = block_offset_of(indices[i]);
+    const int64_t block_end = block_offset + block_size;
+    offsets.clear();
+    for (; i < indices.size() && indices[i] < block_end; i++) {
+      offsets.append(uint16_t(indices[i] - block_offset));
+    }
+    mask.append_block(block_offset, offsets);
+  }
+  return mask;
+}
+
+CompressedIndexMask CompressedIndexMask::from_index_mask(const IndexMask mask)
+{
+  if (mask.is_range()) {
+    return CompressedIndexMask::from_range(mask.as_range());
+  }
+  return CompressedIndexMask::from_indices(mask.indices());
+}
+
+CompressedIndexMask CompressedIndexMask::from_bools(const Span<bool> bools)
+{
+  const int64_t blocks_num = (bools.size() + block_size - 1) / block_size;
+  Array<Vector<uint16_t>> block_offsets(blocks_num);
+  threading::parallel_for(IndexRange(blocks_num), 1, [&](const IndexRange range) {
+    for (const int64_t block : range) {
+      const IndexRange block_range = IndexRange(block * block_size, block_size)
+                                         .intersect(bools.index_range());
+      Vector<uint16_t> &offsets = block_offsets[block];
+      for (const int64_t i : block_range) {
+        if (bools[i]) {
+          offsets.append(uint16_t(i - block_range.first()));
+        }
+      }
+    }
+  });
+
+  CompressedIndexMask mask;
+  for (const int64_t block : IndexRange(blocks_num)) {
+    mask.append_block(block * block_size, block_offsets[block]);
+  }
+  return mask;
+}
+
+template<bool KeepOnlyA, bool KeepOnlyB, typename Fn>
+CompressedIndexMask CompressedIndexMask::combine(const CompressedIndexMask &a,
+                                                 const CompressedIndexMask &b,
+                                                 const Fn &fn)
+{
+  CompressedIndexMask result;
+  /* Membership flags of the current block, bit 1 for #a and bit 2 for #b. */
+  Array<uint8_t> flags(block_size);
+  Vector<uint16_t> offsets;
+
+  const auto fill_flags = [&](const CompressedIndexMask &mask,
+                              const Segment &segment,
+                              const uint8_t flag) {
+    const int64_t block_offset = block_offset_of(segment.first);
+    if (segment.indices_start == -1) {
+      for (const int64_t i : IndexRange(segment.first - block_offset, segment.size)) {
+        flags[i] |= flag;
+      }
+    }
+    else {
+      for (const uint16_t i : mask.indices_.as_span().slice(segment.indices_start, segment.size)) {
+        flags[i] |= flag;
+      }
+    }
+  };
+
+  int64_t a_i = 0;
+  int64_t b_i = 0;
+  while (a_i < a.segments_.size() || b_i < b.segments_.size()) {
+    const int64_t a_block = a_i < a.segments_.size() ? block_offset_of(a.segments_[a_i].first) :
+                                                       INT64_MAX;
+    const int64_t b_block = b_i < b.segments_.size() ? block_offset_of(b.segments_[b_i].first) :
+                                                       INT64_MAX;
+    if (a_block < b_block) {
+      if constexpr (KeepOnlyA) {
+        result.append_segment_from(a, a.segments_[a_i]);
+      }
+      a_i++;
+      continue;
+    }
+    if (b_block < a_block) {
+      if constexpr (KeepOnlyB) {
+        result.append_segment_from(b, b.segments_[b_i]);
+      }
+      b_i++;
+      continue;
+    }
+
+    flags.fill(0);
+    fill_flags(a, a.segments_[a_i], 1);
+    fill_flags(b, b.segments_[b_i], 2);
+    offsets.clear();
+    for (const int64_t i : flags.index_range()) {
+      if (fn(flags[i] & 1, flags[i] & 2)) {
+        offsets.append(uint16_t(i));
+      }
+    }
+    result.append_block(a_block, offsets);
+    a_i++;
+    b_i++;
+  }
+  return result;
+}
+
+CompressedIndexMask CompressedIndexMask::from_union(const CompressedIndexMask &a,
+                                                    const CompressedIndexMask &b)
+{
+  return combine<true, true>(a, b, [](const bool in_a, const bool in_b) { return in_a || in_b; });
+}
+
+CompressedIndexMask CompressedIndexMask::from_intersection(const CompressedIndexMask &a,
+                                                           const CompressedIndexMask &b)
+{
+  return combine<false, false>(
+      a, b, [](const bool in_a, const bool in_b) { return in_a && in_b; });
+}
+
+CompressedIndexMask CompressedIndexMask::from_difference(const CompressedIndexMask &a,
+                                                         const CompressedIndexMask &b)
+{
+  return combine<true, false>(
+      a, b, [](const bool in_a, const bool in_b) { return in_a && !in_b; });
+}
+
+bool CompressedIndexMask::contains(const int64_t index) const
+{
+  const Segment *segment = std::upper_bound(
+      segments_.begin(),
+      segments_.end(),
+      index,
+      [](const int64_t index, const Segment &segment) { return index < segment.first; });
+  if (segment == segments_.begin()) {
+    return false;
+  }
+  segment--;
+  if (segment->indices_start == -1) {
+    return index < segment->first + segment->size;
+  }
+  const int64_t block_offset = block_offset_of(segment->first);
+  if (index >= block_offset + block_size) {
+    return false;
+  }
+  const Span<uint16_t> offsets = indices_.as_span().slice(segment->indices_start, segment->size);
+  return std::binary_search(offsets.begin(), offsets.end(), uint16_t(index - block_offset));
+}
+
+IndexMask CompressedIndexMask::to_index_mask(Vector<int64_t> &r_indices) const
+{
+  if (segments_.is_empty()) {
+    return {};
+  }
+  const Segment &first = segments_.first();
+  const Segment &last = segments_.last();
+  if (last.indices_start == -1 && first.indices_start == -1 &&
+      last.first + last.size - first.first == size_)
+  {
+    return IndexRange(first.first, size_);
+  }
+  r_indices.clear();
+  r_indices.reserve(size_);
+  this->foreach_index([&](const int64_t i) { r_indices.append_unchecked(i); });
+  return r_indices.as_span();
+}
+
+}  // namespace blender
@@ -9,6 +9,8 @@
 #include "BLI_math_base_safe.h"
 #include "BLI_math_vector.hh"
 #include "BLI_noise.hh"
+#include "BLI_simd.h"
+#include "BLI_span.hh"
 #include "BLI_utildefines.h"
 
 namespace blender::noise {
@@ -712,6 +714,292 @@ float3 perlin_float3_fractal_distorted(float4 position,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batch Perlin Noise
+ *
+ * Evaluate 3D perlin noise for many positions at once. On x86 four positions are processed at a
+ * time with SSE2. Every operation matches the scalar code above, including the parts that are
+ * computed in double precision, so the results are bit-identical to the per-point functions.
+ * Other platforms, where the compiler may contract the scalar code into fused multiply-adds,
+ * use the scalar functions.
+ * \{ */
+
+#ifdef __SSE2__
+
+template<int k> BLI_INLINE __m128i hash_bit_rotate_sse(const __m128i x)
+{
+  return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+}
+
+BLI_INLINE __m128i hash_sse(const __m128i kx, const __m128i ky, const __m128i kz)
+{
+  __m128i a, b, c;
+  a = b = c = _mm_set1_epi32(int(0xdeadbeef + (3 << 2) + 13));
+
+  c = _mm_add_epi32(c, kz);
+  b = _mm_add_epi32(b, ky);
+  a = _mm_add_epi32(a, kx);
+
+  c = _mm_xor_si128(c, b);
+  c = _mm_sub_epi32(c, hash_bit_rotate_sse<14>(b));
+  a = _mm_xor_si128(a, c);
+  a = _mm_sub_epi32(a, hash_bit_rotate_sse<11>(c));
+  b = _mm_xor_si128(b, a);
+  b = _mm_sub_epi32(b, hash_bit_rotate_sse<25>(a));
+  c = _mm_xor_si128(c, b);
+  c = _mm_sub_epi32(c, hash_bit_rotate_sse<16>(b));
+  a = _mm_xor_si128(a, c);
+  a = _mm_sub_epi32(a, hash_bit_rotate_sse<4>(c));
+  b = _mm_xor_si128(b, a);
+  b = _mm_sub_epi32(b, hash_bit_rotate_sse<14>(a));
+  c = _mm_xor_si128(c, b);
+  c = _mm_sub_epi32(c, hash_bit_rotate_sse<24>(b));
+  return c;
+}
+
+BLI_INLINE __m128 select_sse(const __m128i mask, const __m128 a, const __m128 b)
+{
+  const __m128 mask_ps = _mm_castsi128_ps(mask);
+  return _mm_or_ps(_mm_and_ps(mask_ps, a), _mm_andnot_ps(mask_ps, b));
+}
+
+/** Flip the sign of the lanes where the given bit of the hash is set, like #negate_if. */
+BLI_INLINE __m128 negate_if_sse(const __m128 value, const __m128i h, const __m128i bit)
+{
+  const __m128i is_set = _mm_cmpeq_epi32(_mm_and_si128(h, bit), bit);
+  const __m128i sign = _mm_and_si128(is_set, _mm_set1_epi32(int(0x80000000)));
+  return _mm_xor_ps(value, _mm_castsi128_ps(sign));
+}
+
+BLI_INLINE __m128 noise_grad_sse(const __m128i hash,
+                                 const __m128 x,
+                                 const __m128 y,
+                                 const __m128 z)
+{
+  const __m128i h = _mm_and_si128(hash, _mm_set1_epi32(15));
+  const __m128 u = select_sse(_mm_cmplt_epi32(h, _mm_set1_epi32(8)), x, y);
+  const __m128i is_12_or_14 = _mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)),
+                                           _mm_cmpeq_epi32(h, _mm_set1_epi32(14)));
+  const __m128 vt = select_sse(is_12_or_14, x, z);
+  const __m128 v = select_sse(_mm_cmplt_epi32(h, _mm_set1_epi32(4)), y, vt);
+  return _mm_add_ps(negate_if_sse(u, h, _mm_set1_epi32(1)),
+                    negate_if_sse(v, h, _mm_set1_epi32(2)));
+}
+
+BLI_INLINE __m128 floor_fraction_sse(const __m128 x, __m128i &r_i)
+{
+  const __m128i is_negative = _mm_castps_si128(_mm_cmplt_ps(x, _mm_setzero_ps()));
+  r_i = _mm_add_epi32(_mm_cvttps_epi32(x), is_negative);
+  return _mm_sub_ps(x, _mm_cvtepi32_ps(r_i));
+}
+
+/** Apply a function to the four lanes converted to double precision, like implicit promotion
+ * in the scalar code. */
+template<typename Fn> BLI_INLINE __m128 compute_as_double_sse(const __m128 x, const Fn &fn)
+{
+  const __m128d low = fn(_mm_cvtps_pd(x));
+  const __m128d high = fn(_mm_cvtps_pd(_mm_movehl_ps(x, x)));
+  return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+}
+
+BLI_INLINE __m128 fade_sse(const __m128 t)
+{
+  const __m128 t3 = _mm_mul_ps(_mm_mul_ps(t, t), t);
+  const __m128d t3_low = _mm_cvtps_pd(t3);
+  const __m128d t3_high = _mm_cvtps_pd(_mm_movehl_ps(t3, t3));
+  const auto poly = [](const __m128d td) {
+    return _mm_add_pd(
+        _mm_mul_pd(td, _mm_sub_pd(_mm_mul_pd(td, _mm_set1_pd(6.0)), _mm_set1_pd(15.0))),
+        _mm_set1_pd(10.0));
+  };
+  const __m128d low = _mm_mul_pd(t3_low, poly(_mm_cvtps_pd(t)));
+  const __m128d high = _mm_mul_pd(t3_high, poly(_mm_cvtps_pd(_mm_movehl_ps(t, t))));
+  return _mm_movelh_ps(_mm_cvtpd_ps(low), _mm_cvtpd_ps(high));
+}
+
+BLI_INLINE __m128 one_minus_sse(const __m128 x)
+{
+  return compute_as_double_sse(
+      x, [](const __m128d xd) { return _mm_sub_pd(_mm_set1_pd(1.0), xd); });
+}
+
+/** Same as #perlin_noise for four positions given as separate components. */
+BLI_INLINE __m128 perlin_noise_sse(const __m128 px, const __m128 py, const __m128 pz)
+{
+  __m128i X, Y, Z;
+  const __m128 fx = floor_fraction_sse(px, X);
+  const __m128 fy = floor_fraction_sse(py, Y);
+  const __m128 fz = floor_fraction_sse(pz, Z);
+
+  const __m128 u = fade_sse(fx);
+  const __m128 v = fade_sse(fy);
+  const __m128 w = fade_sse(fz);
+
+  const __m128i one_i = _mm_set1_epi32(1);
+  const __m128i X1 = _mm_add_epi32(X, one_i);
+  const __m128i Y1 = _mm_add_epi32(Y, one_i);
+  const __m128i Z1 = _mm_add_epi32(Z, one_i);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 fx1 = _mm_sub_ps(fx, one);
+  const __m128 fy1 = _mm_sub_ps(fy, one);
+  const __m128 fz1 = _mm_sub_ps(fz, one);
+
+  const __m128 v0 = noise_grad_sse(hash_sse(X, Y, Z), fx, fy, fz);
+  const __m128 v1 = noise_grad_sse(hash_sse(X1, Y, Z), fx1, fy, fz);
+  const __m128 v2 = noise_grad_sse(hash_sse(X, Y1, Z), fx, fy1, fz);
+  const __m128 v3 = noise_grad_sse(hash_sse(X1, Y1, Z), fx1, fy1, fz);
+  const __m128 v4 = noise_grad_sse(hash_sse(X, Y, Z1), fx, fy, fz1);
+  const __m128 v5 = noise_grad_sse(hash_sse(X1, Y, Z1), fx1, fy, fz1);
+  const __m128 v6 = noise_grad_sse(hash_sse(X, Y1, Z1), fx, fy1, fz1);
+  const __m128 v7 = noise_grad_sse(hash_sse(X1, Y1, Z1), fx1, fy1, fz1);
+
+  /* Trilinear interpolation, in the same order as #mix. */
+  const __m128 x1 = one_minus_sse(u);
+  const __m128 y1 = one_minus_sse(v);
+  const __m128 z1 = one_minus_sse(w);
+  const auto lerp_x = [&](const __m128 a, const __m128 b) {
+    return _mm_add_ps(_mm_mul_ps(a, x1), _mm_mul_ps(b, u));
+  };
+  const __m128 bottom = _mm_add_ps(_mm_mul_ps(y1, lerp_x(v0, v1)), _mm_mul_ps(v, lerp_x(v2, v3)));
+  const __m128 top = _mm_add_ps(_mm_mul_ps(y1, lerp_x(v4, v5)), _mm_mul_ps(v, lerp_x(v6, v7)));
+  return _mm_add_ps(_mm_mul_ps(z1, bottom), _mm_mul_ps(w, top));
+}
+
+#endif /* __SSE2__ */
+
+/** Evaluate #perlin_signed for every position. */
+static void perlin_signed_batch(const Span<float3> positions, MutableSpan<float> r_values)
+{
+  BLI_assert(positions.size() == r_values.size());
+  int64_t i = 0;
+#ifdef __SSE2__
+  for (; i + 4 <= positions.size(); i += 4) {
+    const float3 *p = &positions[i];
+    const __m128 px = _mm_setr_ps(p[0].x, p[1].x, p[2].x, p[3].x);
+    const __m128 py = _mm_setr_ps(p[0].y, p[1].y, p[2].y, p[3].y);
+    const __m128 pz = _mm_setr_ps(p[0].z, p[1].z, p[2].z, p[3].z);
+    const __m128 r = _mm_mul_ps(perlin_noise_sse(px, py, pz), _mm_set1_ps(0.9820f));
+    _mm_storeu_ps(&r_values[i], r);
+  }
+#endif
+  for (; i < positions.size(); i++) {
+    r_values[i] = perlin_signed(positions[i]);
+  }
+}
+
+/* Batches are split into chunks that fit in temporary buffers on the stack. */
+static constexpr int64_t batch_chunk_size = 256;
+
+void perlin_signed(const Span<float3> positions, MutableSpan<float> r_values)
+{
+  perlin_signed_batch(positions, r_values);
+}
+
+void perlin(const Span<float3> positions, MutableSpan<float> r_values)
+{
+  perlin_signed_batch(positions, r_values);
+  for (float &value : r_values) {
+    value = value / 2.0f + 0.5f;
+  }
+}
+
+void perlin_fractal(const Span<float3> positions,
+                    float octaves,
+                    const float roughness,
+                    MutableSpan<float> r_values)
+{
+  BLI_assert(positions.size() == r_values.size());
+  octaves = CLAMPIS(octaves, 0.0f, 15.0f);
+  const int n = int(octaves);
+  const float rmd = octaves - std::floor(octaves);
+
+  float3 scaled_positions[batch_chunk_size];
+  float noise[batch_chunk_size];
+  float sums[batch_chunk_size];
+
+  for (int64_t start = 0; start < positions.size(); start += batch_chunk_size) {
+    const int64_t size = std::min(batch_chunk_size, positions.size() - start);
+    const Span<float3> chunk_positions = positions.slice(start, size);
+    MutableSpan<float3> chunk_scaled(scaled_positions, size);
+    MutableSpan<float> chunk_noise(noise, size);
+    MutableSpan<float> chunk_sums(sums, size);
+    chunk_sums.fill(0.0f);
+
+    /* Same accumulation as #perlin_fractal_template, one octave at a time for the chunk. */
+    float fscale = 1.0f;
+    float amp = 1.0f;
+    float maxamp = 0.0f;
+    for (int octave = 0; octave <= n; octave++) {
+      for (const int64_t i : chunk_positions.index_range()) {
+        chunk_scaled[i] = fscale * chunk_positions[i];
+      }
+      perlin(chunk_scaled, chunk_noise);
+      for (const int64_t i : chunk_positions.index_range()) {
+        chunk_sums[i] += chunk_noise[i] * amp;
+      }
+      maxamp += amp;
+      amp *= CLAMPIS(roughness, 0.0f, 1.0f);
+      fscale *= 2.0f;
+    }
+
+    MutableSpan<float> chunk_result = r_values.slice(start, size);
+    if (rmd == 0.0f) {
+      for (const int64_t i : chunk_positions.index_range()) {
+        chunk_result[i] = chunk_sums[i] / maxamp;
+      }
+      continue;
+    }
+
+    for (const int64_t i : chunk_positions.index_range()) {
+      chunk_scaled[i] = fscale * chunk_positions[i];
+    }
+    perlin(chunk_scaled, chunk_noise);
+    for (const int64_t i : chunk_positions.index_range()) {
+      const float sum = chunk_sums[i] / maxamp;
+      const float sum2 = (chunk_sums[i] + chunk_noise[i] * amp) / (maxamp + amp);
+      chunk_result[i] = (1.0f - rmd) * sum + rmd * sum2;
+    }
+  }
+}
+
+void perlin_fractal_distorted(const Span<float3> positions,
+                              const float octaves,
+                              const float roughness,
+                              const float distortion,
+                              MutableSpan<float> r_values)
+{
+  BLI_assert(positions.size() == r_values.size());
+  const float3 offsets[3] = {random_float3_offset(0.0f),
+                             random_float3_offset(1.0f),
+                             random_float3_offset(2.0f)};
+
+  float3 distorted_positions[batch_chunk_size];
+  float3 offset_positions[batch_chunk_size];
+  float distortions[3][batch_chunk_size];
+
+  for (int64_t start = 0; start < positions.size(); start += batch_chunk_size) {
+    const int64_t size = std::min(batch_chunk_size, positions.size() - start);
+    const Span<float3> chunk_positions = positions.slice(start, size);
+    MutableSpan<float3> chunk_offset(offset_positions, size);
+    /* Same as #perlin_distortion for each component. */
+    for (const int axis : IndexRange(3)) {
+      for (const int64_t i : chunk_positions.index_range()) {
+        chunk_offset[i] = chunk_positions[i] + offsets[axis];
+      }
+      perlin_signed_batch(chunk_offset, MutableSpan<float>(distortions[axis], size));
+    }
+    MutableSpan<float3> chunk_distorted(distorted_positions, size);
+    for (const int64_t i : chunk_positions.index_range()) {
+      chunk_distorted[i] = chunk_positions[i] + float3(distortions[0][i] * distortion,
+                                                       distortions[1][i] * distortion,
+                                                       distortions[2][i] * distortion);
+    }
+    perlin_fractal(chunk_distorted, octaves, roughness, r_values.slice(start, size));
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Musgrave Noise
  * \{ */
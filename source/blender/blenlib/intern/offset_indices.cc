@@ -1,10 +1,13 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array.hh"
 #include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
 
 namespace blender::offset_indices {
 
-void accumulate_counts_to_offsets(MutableSpan<int> counts_to_offsets, const int start_offset)
+static void accumulate_counts_to_offsets_serial(MutableSpan<int> counts_to_offsets,
+                                                const int start_offset)
 {
   int offset = start_offset;
   for (const int i : counts_to_offsets.index_range().drop_back(1)) {
@@ -16,4 +19,48 @@ void accumulate_counts_to_offsets(MutableSpan<int> counts_to_offsets, const int
   counts_to_offsets.last() = offset;
 }
 
+void accumulate_counts_to_offsets(MutableSpan<int> counts_to_offsets, const int start_offset)
+{
+  /* The scan is memory bound, so only split it up when there is enough work for every thread. */
+  const int64_t grain_size = 1 << 16;
+  const IndexRange counts_range = counts_to_offsets.index_range().drop_back(1);
+  if (counts_range.size() <= grain_size * 2) {
+    accumulate_counts_to_offsets_serial(counts_to_offsets, start_offset);
+    return;
+  }
+
+  /* Two passes: sum the counts of every block in parallel, accumulate these block sums to the
+   * start offset of each block, then compute the offsets within every block in parallel. */
+  const int64_t blocks_num = (counts_range.size() + grain_size - 1) / grain_size;
+  const auto block_range = [&](const int64_t block) {
+    const int64_t start = block * grain_size;
+    return counts_range.slice(start, std::min(grain_size, counts_range.size() - start));
+  };
+  Array<int> block_offsets(blocks_num + 1);
+  threading::parallel_for(IndexRange(blocks_num), 1, [&](const IndexRange range) {
+    for (const int64_t block : range) {
+      int sum = 0;
+      for (const int count : counts_to_offsets.slice(block_range(block))) {
+        sum += count;
+      }
+      block_offsets[block] = sum;
+    }
+  });
+  accumulate_counts_to_offsets_serial(block_offsets, start_offset);
+
+  threading::parallel_for(IndexRange(blocks_num), 1, [&](const IndexRange range) {
+    for (const int64_t block : range) {
+      MutableSpan<int> block_counts = counts_to_offsets.slice(block_range(block));
+      int offset = block_offsets[block];
+      for (int &count_to_offset : block_counts) {
+        const int count = count_to_offset;
+        BLI_assert(count >= 0);
+        count_to_offset = offset;
+        offset += count;
+      }
+    }
+  });
+  counts_to_offsets.last() = block_offsets.last();
+}
+
 }  // namespace blender::offset_indices
@@ -0,0 +1,192 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Parallel least significant digit radix sort for 32 bit keys.
+ *
+ * Every pass sorts by one byte of the key. The input is split into chunks and each chunk counts
+ * the occurrences of every digit in parallel. From these counts the output offset of each digit
+ * in every chunk is computed, so that the chunks can scatter their elements in parallel while
+ * keeping the sort stable.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "BLI_array.hh"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
+
+namespace blender {
+
+namespace radix_sort {
+
+static constexpr int digit_bits = 8;
+static constexpr int digits_num = 1 << digit_bits;
+static constexpr int64_t chunk_size = 1 << 16;
+/** Below this size the overhead of the passes is not worth it for sorting keys only. */
+static constexpr int64_t comparison_sort_threshold = 1024;
+
+/** Map keys to unsigned integers that have the same order. */
+static uint32_t to_radix(const uint32_t key)
+{
+  return key;
+}
+static uint32_t to_radix(const int key)
+{
+  return uint32_t(key) ^ 0x80000000u;
+}
+static uint32_t to_radix(const float key)
+{
+  uint32_t bits;
+  memcpy(&bits, &key, sizeof(bits));
+  /* Flip all bits of negative values, so that larger magnitudes come first, and only the sign bit
+   * of positive values, so that they come after the negative ones. */
+  return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+}
+
+static void from_radix(const uint32_t radix, uint32_t &r_key)
+{
+  r_key = radix;
+}
+static void from_radix(const uint32_t radix, int &r_key)
+{
+  r_key = int(radix ^ 0x80000000u);
+}
+static void from_radix(const uint32_t radix, float &r_key)
+{
+  const uint32_t bits = radix ^ ((radix >> 31) ? 0x80000000u : 0xFFFFFFFFu);
+  memcpy(&r_key, &bits, sizeof(bits));
+}
+
+using Histogram = std::array<int64_t, digits_num>;
+
+template<typename Key, bool UseValues>
+static void sort(MutableSpan<Key> keys, MutableSpan<int> values)
+{
+  BLI_assert(!UseValues || keys.size() == values.size());
+  const int64_t size = keys.size();
+  if (size < 2) {
+    return;
+  }
+  if constexpr (!UseValues) {
+    if (size < comparison_sort_threshold) {
+      std::sort(keys.begin(), keys.end(), [](const Key a, const Key b) {
+        return to_radix(a) < to_radix(b);
+      });
+      return;
+    }
+  }
+
+  const int64_t chunks_num = (size + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    const int64_t start = chunk * chunk_size;
+    return IndexRange(start, std::min(chunk_size, size - start));
+  };
+
+  Array<uint32_t> radix_a(size, NoInitialization());
+  Array<uint32_t> radix_b(size, NoInitialization());
+  Array<int> values_b(UseValues ? size : 0, NoInitialization());
+  Array<Histogram> histograms(chunks_num);
+
+  threading::parallel_for(IndexRange(size), chunk_size, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      radix_a[i] = to_radix(keys[i]);
+    }
+  });
+
+  MutableSpan<uint32_t> src = radix_a;
+  MutableSpan<uint32_t> dst = radix_b;
+  MutableSpan<int> values_src = values;
+  MutableSpan<int> values_dst = values_b;
+
+  for (int shift = 0; shift < 32; shift += digit_bits) {
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        Histogram &histogram = histograms[chunk];
+        histogram.fill(0);
+        for (const int64_t i : chunk_range(chunk)) {
+          histogram[(src[i] >> shift) & (digits_num - 1)]++;
+        }
+      }
+    });
+
+    /* Turn the counts into output offsets, ordered by digit first and by chunk second. */
+    int64_t offset = 0;
+    bool is_single_digit = false;
+    for (const int digit : IndexRange(digits_num)) {
+      const int64_t digit_start = offset;
+      for (Histogram &histogram : histograms) {
+        const int64_t count = histogram[digit];
+        histogram[digit] = offset;
+        offset += count;
+      }
+      if (offset - digit_start == size) {
+        is_single_digit = true;
+        break;
+      }
+    }
+    if (is_single_digit) {
+      /* All keys have the same digit, this pass would not change the order. */
+      continue;
+    }
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+      for (const int64_t chunk : range) {
+        Histogram &histogram = histograms[chunk];
+        for (const int64_t i : chunk_range(chunk)) {
+          const int64_t dst_index = histogram[(src[i] >> shift) & (digits_num - 1)]++;
+          dst[dst_index] = src[i];
+          if constexpr (UseValues) {
+            values_dst[dst_index] = values_src[i];
+          }
+        }
+      }
+    });
+    std::swap(src, dst);
+    std::swap(values_src, values_dst);
+  }
+
+  threading::parallel_for(IndexRange(size), chunk_size, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      from_radix(src[i], keys[i]);
+    }
+    if constexpr (UseValues) {
+      if (values_src.data() != values.data()) {
+        values.slice(range).copy_from(values_src.slice(range));
+      }
+    }
+  });
+}
+
+}  // namespace radix_sort
+
+void parallel_radix_sort(MutableSpan<int> keys)
+{
+  radix_sort::sort<int, false>(keys, {});
+}
+void parallel_radix_sort(MutableSpan<uint32_t> keys)
+{
+  radix_sort::sort<uint32_t, false>(keys, {});
+}
+void parallel_radix_sort(MutableSpan<float> keys)
+{
+  radix_sort::sort<float, false>(keys, {});
+}
+
+void parallel_radix_sort_by_key(MutableSpan<int> keys, MutableSpan<int> values)
+{
+  radix_sort::sort<int, true>(keys, values);
+}
+void parallel_radix_sort_by_key(MutableSpan<uint32_t> keys, MutableSpan<int> values)
+{
+  radix_sort::sort<uint32_t, true>(keys, values);
+}
+void parallel_radix_sort_by_key(MutableSpan<float> keys, MutableSpan<int> values)
+{
+  radix_sort::sort<float, true>(keys, values);
+}
+
+}  // namespace blender
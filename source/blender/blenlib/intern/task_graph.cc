@@ -8,15 +8,33 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_fileops.h"
 #include "BLI_task.h"
+#include "BLI_utildefines.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #ifdef WITH_TBB
 #  include <tbb/flow_graph.h>
+#  include <tbb/task_arena.h>
 #endif
 
+using ProfileClock = std::chrono::steady_clock;
+
+/* A single execution of a node, captured when profiling is enabled. */
+struct TaskGraphProfileEvent {
+  const char *name;
+  ProfileClock::time_point start;
+  ProfileClock::time_point end;
+  int thread_index;
+};
+
 /* Task Graph */
 struct TaskGraph {
 #ifdef WITH_TBB
@@ -24,11 +42,26 @@ struct TaskGraph {
 #endif
   std::vector<std::unique_ptr<TaskNode>> nodes;
 
+  /* Set by #BLI_task_graph_cancel, nodes that did not start yet are skipped. */
+  std::atomic<bool> is_cancelled = false;
+
+  bool use_profiling = false;
+  std::mutex profile_mutex;
+  std::vector<TaskGraphProfileEvent> profile_events;
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("task_graph:TaskGraph")
 #endif
 };
 
+#if defined(WITH_TBB) && TBB_INTERFACE_VERSION_MAJOR >= 12
+static tbb::flow::node_priority_t task_graph_tbb_priority(const eTaskPriority priority)
+{
+  /* Nodes without priority are scheduled after nodes with priority. */
+  return priority == TASK_PRIORITY_HIGH ? 1 : tbb::flow::no_priority;
+}
+#endif
+
 /* TaskNode - a node in the task graph. */
 struct TaskNode {
   /* TBB Node. */
@@ -38,6 +71,8 @@ struct TaskNode {
   /* Successors to execute after this task, for serial execution fallback. */
   std::vector<TaskNode *> successors;
 
+  TaskGraph *task_graph;
+
   /* User function to be executed with given task data. */
   TaskGraphNodeRunFunction run_func;
   void *task_data;
@@ -45,23 +80,32 @@ struct TaskNode {
    * is shared between nodes, only a single task node should free the data. */
   TaskGraphNodeFreeFunction free_func;
 
+  TaskGraphNodeSettings settings;
+
   TaskNode(TaskGraph *task_graph,
            TaskGraphNodeRunFunction run_func,
            void *task_data,
-           TaskGraphNodeFreeFunction free_func)
+           TaskGraphNodeFreeFunction free_func,
+           const TaskGraphNodeSettings &settings)
       :
 #ifdef WITH_TBB
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+        tbb_node(task_graph->tbb_graph,
+                 [&](const tbb::flow::continue_msg input) { return run(input); },
+                 task_graph_tbb_priority(settings.priority)),
+#  else
+        /* Node priorities are only a preview feature before TBB 2021. */
         tbb_node(task_graph->tbb_graph,
                  tbb::flow::unlimited,
-                 [&](const tbb::flow::continue_msg input) { run(input); }),
+                 [&](const tbb::flow::continue_msg input) { return run(input); }),
+#  endif
 #endif
+        task_graph(task_graph),
         run_func(run_func),
         task_data(task_data),
-        free_func(free_func)
+        free_func(free_func),
+        settings(settings)
   {
-#ifndef WITH_TBB
-    UNUSED_VARS(task_graph);
-#endif
   }
 
   TaskNode(const TaskNode &other) = delete;
@@ -74,17 +118,54 @@ struct TaskNode {
     }
   }
 
+  static void run_func_isolated(void *userdata)
+  {
+    TaskNode *task_node = static_cast<TaskNode *>(userdata);
+    task_node->run_func(task_node->task_data);
+  }
+
+  void execute()
+  {
+    if (task_graph->is_cancelled.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    const ProfileClock::time_point start = task_graph->use_profiling ?
+                                               ProfileClock::now() :
+                                               ProfileClock::time_point();
+    if (settings.use_isolation) {
+      BLI_task_isolate(run_func_isolated, this);
+    }
+    else {
+      run_func(task_data);
+    }
+
+    if (task_graph->use_profiling) {
+      TaskGraphProfileEvent event;
+      event.name = settings.name;
+      event.start = start;
+      event.end = ProfileClock::now();
+#ifdef WITH_TBB
+      event.thread_index = std::max(tbb::this_task_arena::current_thread_index(), 0);
+#else
+      event.thread_index = 0;
+#endif
+      std::lock_guard lock{task_graph->profile_mutex};
+      task_graph->profile_events.push_back(event);
+    }
+  }
+
 #ifdef WITH_TBB
   tbb::flow::continue_msg run(const tbb::flow::continue_msg /*input*/)
   {
-    run_func(task_data);
+    execute();
     return tbb::flow::continue_msg();
   }
 #endif
 
   void run_serial()
   {
-    run_func(task_data);
+    execute();
     for (TaskNode *successor : successors) {
       successor->run_serial();
     }
@@ -109,9 +190,19 @@ void BLI_task_graph_work_and_wait(TaskGraph *task_graph)
 {
 #ifdef WITH_TBB
   task_graph->tbb_graph.wait_for_all();
-#else
-  UNUSED_VARS(task_graph);
 #endif
+  /* All work has finished, so the graph can be reused. */
+  task_graph->is_cancelled = false;
+}
+
+void BLI_task_graph_cancel(TaskGraph *task_graph)
+{
+  task_graph->is_cancelled = true;
+}
+
+bool BLI_task_graph_is_cancelled(const TaskGraph *task_graph)
+{
+  return task_graph->is_cancelled.load(std::memory_order_relaxed);
 }
 
 struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
@@ -119,7 +210,18 @@ struct TaskNode *BLI_task_graph_node_create(struct TaskGraph *task_graph,
                                             void *user_data,
                                             TaskGraphNodeFreeFunction free_func)
 {
-  TaskNode *task_node = new TaskNode(task_graph, run, user_data, free_func);
+  TaskGraphNodeSettings settings;
+  BLI_task_graph_node_settings_defaults(&settings);
+  return BLI_task_graph_node_create_ex(task_graph, run, user_data, free_func, &settings);
+}
+
+struct TaskNode *BLI_task_graph_node_create_ex(struct TaskGraph *task_graph,
+                                               TaskGraphNodeRunFunction run,
+                                               void *user_data,
+                                               TaskGraphNodeFreeFunction free_func,
+                                               const TaskGraphNodeSettings *settings)
+{
+  TaskNode *task_node = new TaskNode(task_graph, run, user_data, free_func, *settings);
   task_graph->nodes.push_back(std::unique_ptr<TaskNode>(task_node));
   return task_node;
 }
@@ -145,5 +247,85 @@ void BLI_task_graph_edge_create(struct TaskNode *from_node, struct TaskNode *to_
   }
 #endif
 
-  from_node->successors.push_back(to_node);
+  /* Keep high priority successors first, so the serial fallback runs them first as well. */
+  std::vector<TaskNode *> &successors = from_node->successors;
+  if (to_node->settings.priority == TASK_PRIORITY_HIGH) {
+    auto first_low = std::find_if(successors.begin(), successors.end(), [](TaskNode *node) {
+      return node->settings.priority != TASK_PRIORITY_HIGH;
+    });
+    successors.insert(first_low, to_node);
+  }
+  else {
+    successors.push_back(to_node);
+  }
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Profiling
+ * \{ */
+
+void BLI_task_graph_profiling_enable(TaskGraph *task_graph, const bool enable)
+{
+  task_graph->use_profiling = enable;
+}
+
+void BLI_task_graph_profiling_clear(TaskGraph *task_graph)
+{
+  std::lock_guard lock{task_graph->profile_mutex};
+  task_graph->profile_events.clear();
 }
+
+static void task_graph_write_json_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fputc('\\', file);
+    }
+    if (uchar(*c) >= 0x20) {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+bool BLI_task_graph_profiling_write_chrome_trace(TaskGraph *task_graph, const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == nullptr) {
+    return false;
+  }
+
+  std::lock_guard lock{task_graph->profile_mutex};
+
+  /* Time stamps are relative to the steady clock epoch rather than to the first event, so traces
+   * of several graphs can be merged into one timeline. */
+  fputs("{\"traceEvents\":[\n", file);
+  bool is_first = true;
+  for (const TaskGraphProfileEvent &event : task_graph->profile_events) {
+    const long long start_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   event.start.time_since_epoch())
+                                   .count();
+    const long long duration_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                      event.end - event.start)
+                                      .count();
+    if (!is_first) {
+      fputs(",\n", file);
+    }
+    is_first = false;
+    fputs("{\"name\":", file);
+    task_graph_write_json_string(file, event.name ? event.name : "Task");
+    fprintf(file,
+            ",\"cat\":\"task_graph\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%lld,\"dur\":%lld}",
+            event.thread_index,
+            start_us,
+            duration_us);
+  }
+  fputs("\n]}\n", file);
+
+  const bool success = ferror(file) == 0;
+  fclose(file);
+  return success;
+}
+
+/** \} */
@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_strict_flags.h"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(concurrent_map, AddLookup)
+{
+  ConcurrentMap<int, float> map(10);
+  EXPECT_TRUE(map.add(2, 5.0f));
+  EXPECT_TRUE(map.add(3, 6.0f));
+  EXPECT_FALSE(map.add(2, 7.0f));
+  EXPECT_EQ(*map.lookup_ptr(2), 5.0f);
+  EXPECT_EQ(*map.lookup_ptr(3), 6.0f);
+  EXPECT_EQ(map.lookup_ptr(4), nullptr);
+  EXPECT_EQ(map.lookup_default(4, 1.0f), 1.0f);
+  EXPECT_TRUE(map.contains(3));
+  EXPECT_EQ(map.size(), 2);
+}
+
+TEST(concurrent_map, LookupOrAdd)
+{
+  ConcurrentMap<std::string, int> map(4);
+  EXPECT_EQ(map.lookup_or_add("a", 1), 1);
+  EXPECT_EQ(map.lookup_or_add("a", 2), 1);
+  EXPECT_EQ(map.lookup_or_add("b", 3), 3);
+
+  int sum = 0;
+  map.foreach_item([&](const std::string & /*key*/, int &value) {
+    sum += value;
+    value = 0;
+  });
+  EXPECT_EQ(sum, 4);
+  EXPECT_EQ(*map.lookup_ptr("a"), 0);
+}
+
+TEST(concurrent_map, LookupOrAddInParallel)
+{
+  const int64_t keys_num = 100000;
+  ConcurrentMap<int64_t, int64_t> map(keys_num);
+  Array<int64_t> values(keys_num * 2);
+  /* Every key is added by two indices, both have to see the value of the first. */
+  threading::parallel_for(values.index_range(), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      values[i] = map.lookup_or_add(i % keys_num, i);
+    }
+  });
+  EXPECT_EQ(map.size(), keys_num);
+  for (const int64_t i : IndexRange(keys_num)) {
+    EXPECT_EQ(values[i], values[i + keys_num]);
+    EXPECT_TRUE(ELEM(values[i], i, i + keys_num));
+    EXPECT_EQ(*map.lookup_ptr(i), values[i]);
+  }
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_concurrent_set.hh"
+#include "BLI_strict_flags.h"
+#include "BLI_vector.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(concurrent_set, AddContains)
+{
+  ConcurrentSet<int> set(10);
+  EXPECT_TRUE(set.add(5));
+  EXPECT_TRUE(set.add(3));
+  EXPECT_FALSE(set.add(5));
+  EXPECT_TRUE(set.contains(5));
+  EXPECT_TRUE(set.contains(3));
+  EXPECT_FALSE(set.contains(4));
+  EXPECT_EQ(set.size(), 2);
+  EXPECT_GE(set.capacity(), 20);
+}
+
+TEST(concurrent_set, NonTrivialKey)
+{
+  ConcurrentSet<std::string> set(4);
+  EXPECT_TRUE(set.add("hello"));
+  EXPECT_TRUE(set.add("world"));
+  EXPECT_FALSE(set.add("hello"));
+  Vector<std::string> keys;
+  set.foreach_key([&](const std::string &key) { keys.append(key); });
+  EXPECT_EQ(keys.size(), 2);
+  EXPECT_TRUE(keys.contains("hello"));
+  EXPECT_TRUE(keys.contains("world"));
+}
+
+TEST(concurrent_set, AddInParallel)
+{
+  const int64_t keys_num = 100000;
+  ConcurrentSet<int64_t> set(keys_num);
+  std::atomic<int64_t> added_num = 0;
+  /* Every key is added twice, only one of the threads should succeed. */
+  threading::parallel_for(IndexRange(keys_num * 2), 256, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      if (set.add(i % keys_num)) {
+        added_num++;
+      }
+    }
+  });
+  EXPECT_EQ(added_num, keys_num);
+  EXPECT_EQ(set.size(), keys_num);
+  for (const int64_t i : IndexRange(keys_num)) {
+    EXPECT_TRUE(set.contains(i));
+  }
+}
+
+}  // namespace blender::tests
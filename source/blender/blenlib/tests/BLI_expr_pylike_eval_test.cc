@@ -361,3 +361,55 @@ TEST(expr_pylike, Error_ArgumentCount)
 
   BLI_expr_pylike_free(expr);
 }
+
+static void expr_pylike_batch_test(const char *str)
+{
+  const char *names[2] = {"x", "y"};
+  ExprPyLike_Parsed *expr = BLI_expr_pylike_parse(str, names, ARRAY_SIZE(names));
+  EXPECT_TRUE(BLI_expr_pylike_is_valid(expr));
+
+  const int batch_size = 37;
+  double params[2 * batch_size];
+  for (int i = 0; i < batch_size; i++) {
+    params[i] = i * 0.25 - 3.0;
+    params[batch_size + i] = 5.0 - i * 0.5;
+  }
+
+  double results[batch_size];
+  EXPECT_EQ(BLI_expr_pylike_eval_batch(expr, params, 2, batch_size, results),
+            EXPR_PYLIKE_SUCCESS);
+
+  for (int i = 0; i < batch_size; i++) {
+    const double values[2] = {params[i], params[batch_size + i]};
+    double result;
+    EXPECT_EQ(BLI_expr_pylike_eval(expr, values, 2, &result), EXPR_PYLIKE_SUCCESS);
+    EXPECT_EQ(results[i], result);
+  }
+
+  BLI_expr_pylike_free(expr);
+}
+
+TEST(expr_pylike, Batch_Arithmetic)
+{
+  expr_pylike_batch_test("x * 2 - y / 4 + sin(x) * max(x, y, 1.5)");
+}
+
+TEST(expr_pylike, Batch_Conditional)
+{
+  expr_pylike_batch_test("x if x > y else -y if 0 < y < 3 or x == 0 else x and y");
+}
+
+TEST(expr_pylike, Batch_Error)
+{
+  ExprPyLike_Parsed *expr = parse_for_eval("sqrt(x)", false);
+  const double params[3] = {1.0, -1.0, 4.0};
+  double results[3];
+
+  EXPECT_EQ(BLI_expr_pylike_eval_batch(expr, params, 1, 3, results), EXPR_PYLIKE_MATH_ERROR);
+  EXPECT_EQ(results[0], 1.0);
+  EXPECT_EQ(results[2], 2.0);
+
+  EXPECT_EQ(BLI_expr_pylike_eval_batch(expr, nullptr, 0, 3, results), EXPR_PYLIKE_FATAL_ERROR);
+
+  BLI_expr_pylike_free(expr);
+}
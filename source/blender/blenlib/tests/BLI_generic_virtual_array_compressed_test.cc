@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_array.hh"
+#include "BLI_generic_virtual_array_compressed.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_rand.hh"
+#include "BLI_task.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+static Array<int> compressible_values(const int size)
+{
+  RandomNumberGenerator rng(size);
+  Array<int> values(size);
+  for (const int i : values.index_range()) {
+    values[i] = i / 10 + rng.get_int32(4);
+  }
+  return values;
+}
+
+TEST(compressed_varray, Get)
+{
+  const Array<int> values = compressible_values(10000);
+  CompressedVArraySettings settings;
+  settings.chunk_size = 1000;
+  const VArray<int> varray = compress_varray(GVArray::ForSpan(values.as_span()), settings)
+                                 .typed<int>();
+  EXPECT_FALSE(varray.is_span());
+  EXPECT_EQ(varray.size(), values.size());
+  for (const int i : values.index_range()) {
+    EXPECT_EQ(varray[i], values[i]);
+  }
+  /* Access in an order that does not fit in the cache. */
+  for (int i = values.size() - 1; i >= 0; i -= 997) {
+    EXPECT_EQ(varray[i], values[i]);
+  }
+}
+
+TEST(compressed_varray, CompressedSize)
+{
+  const Array<int> values = compressible_values(100000);
+  const GVArray varray = GVArray::For<GVArrayImpl_For_CompressedChunks>(
+      GVArray::ForSpan(values.as_span()));
+  const GVArrayImpl_For_CompressedChunks &impl =
+      dynamic_cast<const GVArrayImpl_For_CompressedChunks &>(*varray.get_implementation());
+  EXPECT_LT(impl.compressed_size(), values.as_span().size_in_bytes() / 2);
+}
+
+TEST(compressed_varray, Materialize)
+{
+  Array<float3> values(2500);
+  for (const int i : values.index_range()) {
+    values[i] = float3(float(i), 0.0f, float(i % 7));
+  }
+  CompressedVArraySettings settings;
+  settings.chunk_size = 256;
+  const VArray<float3> varray =
+      compress_varray(GVArray::ForSpan(values.as_span()), settings).typed<float3>();
+
+  Array<float3> all(values.size());
+  varray.materialize(all);
+  EXPECT_EQ_ARRAY(all.data(), values.data(), values.size());
+
+  Vector<int64_t> indices;
+  for (int64_t i = 3; i < values.size(); i += 3) {
+    indices.append(i);
+  }
+  /* Include full chunks that are decompressed directly. */
+  for (int64_t i = 1024; i < 1536; i++) {
+    if (i % 3 != 0) {
+      indices.append(i);
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  const IndexMask mask(indices);
+
+  Array<float3> compressed(mask.size());
+  varray.materialize_compressed(mask, compressed);
+  Array<float3> masked(values.size(), float3(-1.0f));
+  varray.materialize(mask, masked);
+  for (const int64_t i : mask.index_range()) {
+    EXPECT_EQ(compressed[i], values[mask[i]]);
+    EXPECT_EQ(masked[mask[i]], values[mask[i]]);
+  }
+  EXPECT_EQ(masked[1], float3(-1.0f));
+}
+
+TEST(compressed_varray, ParallelAccess)
+{
+  const Array<int> values = compressible_values(50000);
+  CompressedVArraySettings settings;
+  settings.chunk_size = 512;
+  const VArray<int> varray = compress_varray(GVArray::ForSpan(values.as_span()), settings)
+                                 .typed<int>();
+  Array<int> result(values.size());
+  threading::parallel_for(values.index_range(), 100, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      result[i] = varray[i];
+    }
+  });
+  EXPECT_EQ_ARRAY(result.data(), values.data(), values.size());
+}
+
+TEST(compressed_varray, SingleIsNotCompressed)
+{
+  const int value = 5;
+  const GVArray varray = compress_varray(GVArray::ForSingle(CPPType::get<int>(), 100, &value));
+  EXPECT_TRUE(varray.is_single());
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_implicit_sharing.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+class SharedVector : public ImplicitSharingInfo {
+ public:
+  Vector<int> data;
+  bool *r_deleted;
+
+  SharedVector(bool *r_deleted) : r_deleted(r_deleted)
+  {
+  }
+
+ private:
+  void delete_self_with_data() override
+  {
+    *r_deleted = true;
+    MEM_delete(this);
+  }
+};
+
+TEST(implicit_sharing, UserCount)
+{
+  bool deleted = false;
+  SharedVector *info = MEM_new<SharedVector>(__func__, &deleted);
+  EXPECT_TRUE(info->is_mutable());
+  EXPECT_FALSE(info->is_shared());
+
+  info->add_user();
+  EXPECT_FALSE(info->is_mutable());
+  EXPECT_TRUE(info->is_shared());
+
+  info->remove_user_and_delete_if_last();
+  EXPECT_FALSE(deleted);
+  EXPECT_TRUE(info->is_mutable());
+
+  info->remove_user_and_delete_if_last();
+  EXPECT_TRUE(deleted);
+}
+
+TEST(implicit_sharing, CopyOnWrite)
+{
+  bool deleted = false;
+  SharedVector *a = MEM_new<SharedVector>(__func__, &deleted);
+  a->data = {1, 2, 3};
+
+  /* Share the data with a second owner. */
+  const SharedVector *b = a;
+  b->add_user();
+
+  /* The first owner has to copy the data before modifying it. */
+  bool copy_deleted = false;
+  SharedVector *copy = MEM_new<SharedVector>(__func__, &copy_deleted);
+  if (a->is_shared()) {
+    copy->data = a->data;
+    a->remove_user_and_delete_if_last();
+    a = copy;
+  }
+  a->data[0] = 10;
+  EXPECT_EQ(a->data[0], 10);
+  EXPECT_EQ(b->data[0], 1);
+  EXPECT_TRUE(a->is_mutable());
+  EXPECT_TRUE(b->is_mutable());
+  EXPECT_FALSE(deleted);
+
+  a->remove_user_and_delete_if_last();
+  b->remove_user_and_delete_if_last();
+  EXPECT_TRUE(deleted);
+  EXPECT_TRUE(copy_deleted);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_array.hh"
+#include "BLI_index_mask_compressed.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+static Vector<int64_t> mask_to_vector(const CompressedIndexMask &mask)
+{
+  Vector<int64_t> indices;
+  mask.foreach_index([&](const int64_t i) { indices.append(i); });
+  return indices;
+}
+
+TEST(index_mask_compressed, Empty)
+{
+  CompressedIndexMask mask;
+  EXPECT_TRUE(mask.is_empty());
+  EXPECT_EQ(mask.size(), 0);
+  EXPECT_FALSE(mask.contains(0));
+  Vector<int64_t> indices;
+  EXPECT_TRUE(mask.to_index_mask(indices).is_empty());
+}
+
+TEST(index_mask_compressed, FromRange)
+{
+  const IndexRange range(10, CompressedIndexMask::block_size * 2);
+  CompressedIndexMask mask = CompressedIndexMask::from_range(range);
+  EXPECT_EQ(mask.size(), range.size());
+  EXPECT_EQ(mask.segments_num(), 3);
+  EXPECT_TRUE(mask.contains(10));
+  EXPECT_TRUE(mask.contains(range.last()));
+  EXPECT_FALSE(mask.contains(9));
+  EXPECT_FALSE(mask.contains(range.one_after_last()));
+  Vector<int64_t> indices;
+  const IndexMask index_mask = mask.to_index_mask(indices);
+  EXPECT_TRUE(index_mask.is_range());
+  EXPECT_EQ(index_mask.as_range(), range);
+  EXPECT_TRUE(indices.is_empty());
+}
+
+TEST(index_mask_compressed, FromIndices)
+{
+  const int64_t big = CompressedIndexMask::block_size * 3 + 7;
+  Vector<int64_t> src = {0, 2, 3, 100, big, big + 1, big + 2};
+  CompressedIndexMask mask = CompressedIndexMask::from_indices(src);
+  EXPECT_EQ(mask.size(), 7);
+  EXPECT_EQ(mask.segments_num(), 2);
+  EXPECT_EQ(mask_to_vector(mask), src);
+  EXPECT_TRUE(mask.contains(3));
+  EXPECT_FALSE(mask.contains(4));
+  EXPECT_TRUE(mask.contains(big + 2));
+  EXPECT_FALSE(mask.contains(big + 3));
+
+  Vector<int64_t> indices;
+  const IndexMask index_mask = mask.to_index_mask(indices);
+  EXPECT_EQ(index_mask.indices(), src.as_span());
+}
+
+TEST(index_mask_compressed, FromBools)
+{
+  Array<bool> bools(CompressedIndexMask::block_size * 2 + 100, false);
+  Vector<int64_t> expected;
+  for (const int64_t i : bools.index_range()) {
+    if (i % 3 == 0) {
+      bools[i] = true;
+      expected.append(i);
+    }
+  }
+  CompressedIndexMask mask = CompressedIndexMask::from_bools(bools);
+  EXPECT_EQ(mask.size(), expected.size());
+  EXPECT_EQ(mask_to_vector(mask), expected);
+  /* Two bytes per index. */
+  EXPECT_LT(mask.memory_usage(), expected.size() * 3);
+}
+
+TEST(index_mask_compressed, SegmentTypes)
+{
+  CompressedIndexMask mask = CompressedIndexMask::from_indices({1, 2, 3, 10, 12});
+  int ranges_num = 0;
+  int spans_num = 0;
+  mask.foreach_segment([&](const auto &segment) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(segment)>, IndexRange>) {
+      ranges_num++;
+    }
+    else {
+      spans_num++;
+      EXPECT_EQ(segment.size(), 5);
+      EXPECT_EQ(segment[3], 10);
+    }
+  });
+  EXPECT_EQ(ranges_num, 0);
+  EXPECT_EQ(spans_num, 1);
+}
+
+TEST(index_mask_compressed, SetOperations)
+{
+  const int64_t block = CompressedIndexMask::block_size;
+  CompressedIndexMask a = CompressedIndexMask::from_indices({1, 2, 5, block + 1, block * 4});
+  CompressedIndexMask b = CompressedIndexMask::from_indices({2, 3, 5, block * 2, block * 4});
+
+  EXPECT_EQ(mask_to_vector(CompressedIndexMask::from_union(a, b)),
+            Vector<int64_t>({1, 2, 3, 5, block + 1, block * 2, block * 4}));
+  EXPECT_EQ(mask_to_vector(CompressedIndexMask::from_intersection(a, b)),
+            Vector<int64_t>({2, 5, block * 4}));
+  EXPECT_EQ(mask_to_vector(CompressedIndexMask::from_difference(a, b)),
+            Vector<int64_t>({1, block + 1}));
+  EXPECT_EQ(CompressedIndexMask::from_difference(a, a).size(), 0);
+}
+
+}  // namespace blender::tests
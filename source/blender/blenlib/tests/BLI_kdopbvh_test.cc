@@ -10,6 +10,7 @@
 #include "BLI_kdopbvh.h"
 #include "BLI_math_vector.h"
 #include "BLI_rand.h"
+#include "BLI_timeit.hh"
 
 /* -------------------------------------------------------------------- */
 /* Helper Functions */
@@ -132,3 +133,126 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+/**
+ * Check that casting rays in packets gives the same hits as casting them one by one.
+ */
+static void ray_cast_packet_test(int points_len, int rays_len, bool coherent, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.01f, 4, 6);
+
+  for (int i = 0; i < points_len; i++) {
+    float co[3];
+    rng_v3_round(co, 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, co, 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  float(*ray_co)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  float(*ray_dir)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+  BVHTreeRayHit *hits = (BVHTreeRayHit *)MEM_mallocN(sizeof(BVHTreeRayHit) * rays_len, __func__);
+
+  for (int i = 0; i < rays_len; i++) {
+    if (coherent) {
+      /* A grid of nearly parallel rays above the points. */
+      ray_co[i][0] = float(i % 16) / 8.0f - 1.0f;
+      ray_co[i][1] = float(i / 16) / 8.0f - 1.0f;
+      ray_co[i][2] = 2.0f;
+      rng_v3_round(ray_dir[i], 3, rng, 1000, 0.1f);
+      ray_dir[i][2] = -1.0f;
+    }
+    else {
+      rng_v3_round(ray_co[i], 3, rng, 1000, 2.0f);
+      rng_v3_round(ray_dir[i], 3, rng, 1000, 1.0f);
+      if (is_zero_v3(ray_dir[i])) {
+        ray_dir[i][0] = 1.0f;
+      }
+    }
+    normalize_v3(ray_dir[i]);
+    hits[i].index = -1;
+    hits[i].dist = BVH_RAYCAST_DIST_MAX;
+  }
+
+  BLI_bvhtree_ray_cast_packet(
+      tree, ray_co, ray_dir, rays_len, 0.0f, hits, nullptr, nullptr, BVH_RAYCAST_DEFAULT);
+
+  for (int i = 0; i < rays_len; i++) {
+    BVHTreeRayHit hit;
+    hit.index = -1;
+    hit.dist = BVH_RAYCAST_DIST_MAX;
+    BLI_bvhtree_ray_cast(tree, ray_co[i], ray_dir[i], 0.0f, &hit, nullptr, nullptr);
+
+    EXPECT_EQ(hit.index, hits[i].index);
+    if (hit.index != -1) {
+      EXPECT_FLOAT_EQ(hit.dist, hits[i].dist);
+    }
+  }
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(ray_co);
+  MEM_freeN(ray_dir);
+  MEM_freeN(hits);
+}
+
+TEST(kdopbvh, RayCastPacketCoherent)
+{
+  ray_cast_packet_test(500, 16 * 16 + 3, true, 1234);
+}
+TEST(kdopbvh, RayCastPacketRandom)
+{
+  ray_cast_packet_test(500, 1001, false, 123);
+}
+
+/**
+ * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
+ */
+#if 0
+TEST(kdopbvh, Benchmark)
+{
+  const int points_len = 1000000;
+  const int queries_len = 1000000;
+  struct RNG *rng = BLI_rng_new(0);
+
+  float(*points)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+  rng_v3_round(&points[0][0], points_len * 3, rng, 1 << 20, 1.0f);
+  float(*queries)[3] = (float(*)[3])MEM_mallocN(sizeof(float[3]) * queries_len, __func__);
+  rng_v3_round(&queries[0][0], queries_len * 3, rng, 1 << 20, 1.0f);
+
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0f, 4, 8);
+  {
+    SCOPED_TIMER("kdopbvh Build");
+    for (int i = 0; i < points_len; i++) {
+      BLI_bvhtree_insert(tree, i, points[i], 1);
+    }
+    BLI_bvhtree_balance(tree);
+  }
+
+  int count = 0;
+  {
+    SCOPED_TIMER("kdopbvh Find Nearest");
+    for (int i = 0; i < queries_len; i++) {
+      count += BLI_bvhtree_find_nearest(tree, queries[i], nullptr, nullptr, nullptr) != -1;
+    }
+  }
+  {
+    SCOPED_TIMER("kdopbvh Ray Cast");
+    const float dir[3] = {0.0f, 0.0f, -1.0f};
+    for (int i = 0; i < queries_len; i++) {
+      BVHTreeRayHit hit;
+      hit.index = -1;
+      hit.dist = BVH_RAYCAST_DIST_MAX;
+      count += BLI_bvhtree_ray_cast(tree, queries[i], dir, 0.001f, &hit, nullptr, nullptr) != -1;
+    }
+  }
+
+  /* Print the value for simple error checking and to avoid some compiler optimizations. */
+  std::cout << "Count: " << count << "\n";
+
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+  MEM_freeN(points);
+  MEM_freeN(queries);
+}
+#endif /* Benchmark */
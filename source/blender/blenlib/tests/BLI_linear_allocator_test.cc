@@ -1,7 +1,10 @@
 /* SPDX-License-Identifier: Apache-2.0 */
 
+#include "BLI_array.hh"
 #include "BLI_linear_allocator.hh"
+#include "BLI_linear_allocator_thread_local.hh"
 #include "BLI_rand.hh"
+#include "BLI_task.hh"
 #include "BLI_strict_flags.h"
 #include "testing/testing.h"
 
@@ -156,4 +159,39 @@ TEST(linear_allocator, ConstructArray)
   }
 }
 
+TEST(linear_allocator, VectorWithLinearAllocatorRef)
+{
+  LinearAllocator<> allocator;
+  Vector<int64_t, 0, LinearAllocatorRef<>> values(allocator);
+  for (const int64_t i : IndexRange(1000)) {
+    values.append(i);
+  }
+  EXPECT_EQ(values.size(), 1000);
+  EXPECT_EQ(values[0], 0);
+  EXPECT_EQ(values[999], 999);
+}
+
+TEST(linear_allocator, ThreadLocal)
+{
+  threading::ThreadLocalLinearAllocator<> allocators;
+  Array<int64_t> sums(1000);
+  threading::parallel_for(IndexRange(1000), 1, [&](const IndexRange range) {
+    LinearAllocator<> &allocator = allocators.local();
+    for (const int64_t i : range) {
+      Vector<int64_t, 0, LinearAllocatorRef<>> values(allocator);
+      for (const int64_t j : IndexRange(i)) {
+        values.append(j);
+      }
+      int64_t sum = 0;
+      for (const int64_t value : values) {
+        sum += value;
+      }
+      sums[i] = sum;
+    }
+  });
+  for (const int64_t i : sums.index_range()) {
+    EXPECT_EQ(sums[i], i * (i - 1) / 2);
+  }
+}
+
 }  // namespace blender::tests
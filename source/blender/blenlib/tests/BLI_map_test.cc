@@ -795,6 +795,42 @@ TEST(map, Benchmark)
  * Count: 1889920
  */
 
+template<typename MapT>
+BLI_NOINLINE void benchmark_string_keys(StringRef name, int amount)
+{
+  Vector<std::string> keys;
+  for (int i = 0; i < amount; i++) {
+    keys.append("attribute_" + std::to_string(i));
+  }
+
+  MapT map;
+  {
+    SCOPED_TIMER(name + " Add");
+    for (const std::string &key : keys) {
+      map.add(key, int(key.size()));
+    }
+  }
+  int count = 0;
+  {
+    SCOPED_TIMER(name + " Lookup");
+    for (const std::string &key : keys) {
+      count += map.lookup(key);
+    }
+  }
+
+  /* Print the value for simple error checking and to avoid some compiler optimizations. */
+  std::cout << "Count: " << count << "\n";
+}
+
+TEST(map, BenchmarkStringKeys)
+{
+  for (int i = 0; i < 3; i++) {
+    benchmark_string_keys<blender::Map<std::string, int>>("blender::Map          ", 1000000);
+    benchmark_string_keys<blender::StdUnorderedMapWrapper<std::string, int>>(
+        "std::unordered_map", 1000000);
+  }
+}
+
 #endif /* Benchmark */
 
 }  // namespace blender::tests
@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+#include "BLI_rand.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+static Array<float3> random_positions(const int size, const float range)
+{
+  RandomNumberGenerator rng(size);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 2.0f * range -
+               float3(range);
+  }
+  return positions;
+}
+
+/* The batch functions must give exactly the same results as the single position functions. */
+
+TEST(noise, PerlinBatch)
+{
+  for (const int size : {0, 1, 3, 4, 7, 1000}) {
+    const Array<float3> positions = random_positions(size, 100.0f);
+    Array<float> signed_values(size);
+    Array<float> values(size);
+    noise::perlin_signed(positions, signed_values);
+    noise::perlin(positions, values);
+    for (const int i : positions.index_range()) {
+      EXPECT_EQ(signed_values[i], noise::perlin_signed(positions[i]));
+      EXPECT_EQ(values[i], noise::perlin(positions[i]));
+    }
+  }
+}
+
+TEST(noise, PerlinFractalBatch)
+{
+  const Array<float3> positions = random_positions(1001, 10.0f);
+  for (const float octaves : {0.0f, 2.0f, 4.5f}) {
+    Array<float> values(positions.size());
+    noise::perlin_fractal(positions, octaves, 0.5f, values);
+    for (const int i : positions.index_range()) {
+      EXPECT_EQ(values[i], noise::perlin_fractal(positions[i], octaves, 0.5f));
+    }
+  }
+}
+
+TEST(noise, PerlinFractalDistortedBatch)
+{
+  const Array<float3> positions = random_positions(1001, 10.0f);
+  Array<float> values(positions.size());
+  noise::perlin_fractal_distorted(positions, 3.5f, 0.6f, 0.8f, values);
+  for (const int i : positions.index_range()) {
+    EXPECT_EQ(values[i], noise::perlin_fractal_distorted(positions[i], 3.5f, 0.6f, 0.8f));
+  }
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,40 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "BLI_array.hh"
+#include "BLI_offset_indices.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(offset_indices, AccumulateCountsToOffsets)
+{
+  Array<int> data = {3, 0, 2, 5, -1};
+  offset_indices::accumulate_counts_to_offsets(data, 10);
+  EXPECT_EQ(data[0], 10);
+  EXPECT_EQ(data[1], 13);
+  EXPECT_EQ(data[2], 13);
+  EXPECT_EQ(data[3], 15);
+  EXPECT_EQ(data[4], 20);
+}
+
+TEST(offset_indices, AccumulateCountsToOffsetsLarge)
+{
+  /* Large enough to be computed in parallel. */
+  const int size = 1000000;
+  Array<int> data(size + 1);
+  for (const int i : IndexRange(size)) {
+    data[i] = i % 3;
+  }
+  offset_indices::accumulate_counts_to_offsets(data);
+  int expected = 0;
+  for (const int i : IndexRange(size)) {
+    EXPECT_EQ(data[i], expected);
+    expected += i % 3;
+  }
+  EXPECT_EQ(data.last(), expected);
+  const OffsetIndices<int> offsets(data);
+  EXPECT_EQ(offsets.ranges_num(), size);
+  EXPECT_EQ(offsets[size - 1].size(), (size - 1) % 3);
+}
+
+}  // namespace blender::tests
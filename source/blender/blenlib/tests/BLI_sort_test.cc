@@ -0,0 +1,95 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <algorithm>
+#include <cmath>
+
+#include "BLI_array.hh"
+#include "BLI_rand.hh"
+#include "BLI_sort.hh"
+#include "testing/testing.h"
+
+namespace blender::tests {
+
+TEST(sort, RadixSortInt)
+{
+  for (const int size : {0, 1, 10, 1000, 100000, 300000}) {
+    RandomNumberGenerator rng(size);
+    Array<int> keys(size);
+    for (int &key : keys) {
+      key = rng.get_int32() - (1 << 30);
+    }
+    Array<int> expected = keys;
+    std::sort(expected.begin(), expected.end());
+    parallel_radix_sort(keys);
+    EXPECT_EQ(keys.as_span(), expected.as_span());
+  }
+}
+
+TEST(sort, RadixSortUInt)
+{
+  RandomNumberGenerator rng;
+  Array<uint32_t> keys(200000);
+  for (uint32_t &key : keys) {
+    key = uint32_t(rng.get_int32()) * 7u;
+  }
+  Array<uint32_t> expected = keys;
+  std::sort(expected.begin(), expected.end());
+  parallel_radix_sort(keys);
+  EXPECT_EQ(keys.as_span(), expected.as_span());
+}
+
+TEST(sort, RadixSortFloat)
+{
+  RandomNumberGenerator rng;
+  Array<float> keys(200000);
+  for (float &key : keys) {
+    key = (rng.get_float() - 0.5f) * 1000.0f;
+  }
+  keys[0] = -INFINITY;
+  keys[1] = INFINITY;
+  keys[2] = 0.0f;
+  Array<float> expected = keys;
+  std::sort(expected.begin(), expected.end());
+  parallel_radix_sort(keys);
+  EXPECT_EQ(keys.as_span(), expected.as_span());
+}
+
+TEST(sort, RadixSortByKeyStable)
+{
+  const int size = 200000;
+  RandomNumberGenerator rng;
+  Array<int> keys(size);
+  Array<int> values(size);
+  for (const int i : keys.index_range()) {
+    /* Only few distinct keys, so there are many equal ones. */
+    keys[i] = rng.get_int32(16);
+    values[i] = i;
+  }
+  const Array<int> original_keys = keys;
+  parallel_radix_sort_by_key(keys, values);
+  for (const int i : keys.index_range()) {
+    EXPECT_EQ(keys[i], original_keys[values[i]]);
+    if (i > 0) {
+      EXPECT_LE(keys[i - 1], keys[i]);
+      if (keys[i - 1] == keys[i]) {
+        EXPECT_LT(values[i - 1], values[i]);
+      }
+    }
+  }
+}
+
+TEST(sort, RadixSortByKeySmall)
+{
+  /* Small inputs with values are sorted with the radix passes as well. */
+  Array<float> keys = {3.0f, 1.0f, 2.0f};
+  Array<int> values = {0, 1, 2};
+  parallel_radix_sort_by_key(keys, values);
+  EXPECT_EQ(keys[0], 1.0f);
+  EXPECT_EQ(keys[1], 2.0f);
+  EXPECT_EQ(keys[2], 3.0f);
+  EXPECT_EQ(values[0], 1);
+  EXPECT_EQ(values[1], 2);
+  EXPECT_EQ(values[2], 0);
+}
+
+}  // namespace blender::tests
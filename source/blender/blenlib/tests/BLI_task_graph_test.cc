@@ -188,3 +188,54 @@ TEST(task, GraphTaskData)
   EXPECT_EQ(1, data.value);
   EXPECT_EQ(0, data.store);
 }
+
+static void TaskData_cancel_graph(void *taskdata)
+{
+  TaskGraph *graph = (TaskGraph *)taskdata;
+  BLI_task_graph_cancel(graph);
+}
+
+TEST(task, GraphCancel)
+{
+  TaskData data = {1};
+  TaskGraph *graph = BLI_task_graph_create();
+  TaskNode *node_a = BLI_task_graph_node_create(graph, TaskData_increase_value, &data, nullptr);
+  TaskNode *node_b = BLI_task_graph_node_create(graph, TaskData_cancel_graph, graph, nullptr);
+  TaskNode *node_c = BLI_task_graph_node_create(graph, TaskData_increase_value, &data, nullptr);
+  BLI_task_graph_edge_create(node_a, node_b);
+  BLI_task_graph_edge_create(node_b, node_c);
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_a));
+  BLI_task_graph_work_and_wait(graph);
+  /* Node c is skipped as the graph was cancelled before it started. */
+  EXPECT_EQ(2, data.value);
+  EXPECT_FALSE(BLI_task_graph_is_cancelled(graph));
+
+  /* The graph can be reused after waiting. */
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_c));
+  BLI_task_graph_work_and_wait(graph);
+  EXPECT_EQ(3, data.value);
+  BLI_task_graph_free(graph);
+}
+
+TEST(task, GraphNodeSettings)
+{
+  TaskData data = {4};
+  TaskGraph *graph = BLI_task_graph_create();
+  BLI_task_graph_profiling_enable(graph, true);
+
+  TaskGraphNodeSettings settings;
+  BLI_task_graph_node_settings_defaults(&settings);
+  settings.priority = TASK_PRIORITY_HIGH;
+  settings.use_isolation = true;
+  settings.name = "Decrease";
+  TaskNode *node_a = BLI_task_graph_node_create_ex(
+      graph, TaskData_decrease_value, &data, nullptr, &settings);
+  settings.name = "Square";
+  TaskNode *node_b = BLI_task_graph_node_create_ex(
+      graph, TaskData_square_value, &data, nullptr, &settings);
+  BLI_task_graph_edge_create(node_a, node_b);
+  EXPECT_TRUE(BLI_task_graph_node_push_work(node_a));
+  BLI_task_graph_work_and_wait(graph);
+  EXPECT_EQ(9, data.value);
+  BLI_task_graph_free(graph);
+}
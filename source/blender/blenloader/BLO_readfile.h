@@ -80,12 +80,26 @@ typedef struct BlendFileReadReport {
   /* Timing information. */
   struct {
     double whole;
+    /* Reading (including decompression) and direct-linking of the main file data-blocks. */
+    double read_data;
+    double versioning;
+    /* Reading of linked libraries, including the lib-linking of all data below. */
     double libraries;
+    double lib_link;
+    double id_refcount_recompute;
     double lib_overrides;
     double lib_overrides_resync;
     double lib_overrides_recursive_resync;
   } duration;
 
+  /* Change of the allocated memory (in bytes) during some of the phases timed above. */
+  struct {
+    int64_t read_data;
+    int64_t versioning;
+    int64_t libraries;
+    int64_t lib_link;
+  } memory;
+
   /* Count information. */
   struct {
     /* Some numbers of IDs that ended up in a specific state, or required some specific process
@@ -20,6 +20,12 @@ typedef struct {
   size_t size;
   /** When true, this chunk doesn't own the memory, it's shared with a previous #MemFileChunk */
   bool is_identical;
+  /**
+   * When true, this chunk doesn't own the memory, it's shared with a chunk of the previous step
+   * with the same content but at a different position (de-duplication only). Unlike
+   * #is_identical this says nothing about the matching ID being unchanged.
+   */
+  bool is_shared;
   /** When true, this chunk is also identical to the one in the next step (used by undo code to
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
@@ -27,6 +33,8 @@ typedef struct {
   /** Session UUID of the ID being currently written (MAIN_ID_SESSION_UUID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uuid;
+  /** Hash of the content, only computed for chunks large enough to be de-duplicated. */
+  uint content_hash;
 } MemFileChunk;
 
 typedef struct MemFile {
@@ -43,6 +51,12 @@ typedef struct MemFileWriteData {
 
   /** Maps an ID session uuid to its first reference MemFileChunk, if existing. */
   struct GHash *id_session_uuid_mapping;
+  /**
+   * Set of the reference MemFileChunk's, hashed by content. Used to share the memory of chunks
+   * which are not matching the reference chunk at the same position (e.g. because data has been
+   * added before them). Lazily created when needed.
+   */
+  struct GSet *content_mapping;
 } MemFileWriteData;
 
 typedef struct MemFileUndoData {
@@ -92,6 +106,14 @@ extern void BLO_memfile_merge(MemFile *first, MemFile *second);
  */
 extern void BLO_memfile_clear_future(MemFile *memfile);
 
+/**
+ * Copy the data of `memfile` into a new #MemFile owning all of its memory,
+ * using a few large chunks. Undo steps share the buffers of unchanged chunks with each other,
+ * the copy can be used independently of the undo stack (e.g. written from another thread).
+ * Free with #BLO_memfile_free & #MEM_freeN.
+ */
+extern MemFile *BLO_memfile_copy_for_write(const MemFile *memfile);
+
 /* Utilities. */
 
 extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
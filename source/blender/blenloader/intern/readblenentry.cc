@@ -127,6 +127,28 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh,
   BHead *bhead;
   int tot = 0;
 
+  if (fd->file_index_entries != nullptr) {
+    /* Only read the ID blocks of the requested type, instead of scanning the whole file. */
+    for (uint64_t i = 0; i < fd->file_index_footer->entries_num; i++) {
+      const BlendFileIndexEntry *entry = &fd->file_index_entries[i];
+      if (entry->code != ofblocktype) {
+        continue;
+      }
+      bhead = blo_bhead_read_id_from_index(fd, entry);
+      if (bhead == nullptr) {
+        continue;
+      }
+      if (!use_assets_only || blo_bhead_id_asset_data_address(fd, bhead) != nullptr) {
+        BLI_linklist_prepend(&names, BLI_strdup(blo_bhead_id_name(fd, bhead) + 2));
+        tot++;
+      }
+      MEM_freeN(bhead);
+    }
+
+    *r_tot_names = tot;
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
@@ -358,19 +380,30 @@ LinkNode *BLO_blendhandle_get_linkable_groups(BlendHandle *bh)
   LinkNode *names = nullptr;
   BHead *bhead;
 
-  for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    if (bhead->code == ENDB) {
-      break;
-    }
-    if (BKE_idtype_idcode_is_valid(bhead->code)) {
-      if (BKE_idtype_idcode_is_linkable(bhead->code)) {
-        const char *str = BKE_idtype_idcode_to_name(bhead->code);
+  auto gather_code = [&](const int code) {
+    if (BKE_idtype_idcode_is_valid(code)) {
+      if (BKE_idtype_idcode_is_linkable(code)) {
+        const char *str = BKE_idtype_idcode_to_name(code);
 
         if (BLI_gset_add(gathered, (void *)str)) {
           BLI_linklist_prepend(&names, BLI_strdup(str));
         }
       }
     }
+  };
+
+  if (fd->file_index_entries != nullptr) {
+    for (uint64_t i = 0; i < fd->file_index_footer->entries_num; i++) {
+      gather_code(fd->file_index_entries[i].code);
+    }
+  }
+  else {
+    for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+      if (bhead->code == ENDB) {
+        break;
+      }
+      gather_code(bhead->code);
+    }
   }
 
   BLI_gset_free(gathered, nullptr);
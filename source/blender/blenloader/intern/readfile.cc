@@ -55,7 +55,9 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "PIL_time.h"
 
@@ -636,76 +638,81 @@ static void bh8_from_bh4(BHead *bhead, BHead4 *bhead4)
   }
 }
 
-static BHeadN *get_bhead(FileData *fd)
+/**
+ * Read the #BHead at the current position of the file, converting it from the endianness and
+ * pointer size of the file. Returns false when the end of the file is reached.
+ *
+ * As usual 'ENDB' (the last *partial* bhead of the file) needs some special handling.
+ * We don't want to EOF just yet.
+ */
+static bool read_bhead_header(FileData *fd, BHead *r_bhead)
 {
-  BHeadN *new_bhead = nullptr;
+  /* initializing to zero isn't strictly needed but shuts valgrind up
+   * since uninitialized memory gets compared */
+  BHead8 bhead8 = {0};
+  BHead4 bhead4 = {0};
   ssize_t readsize;
 
-  if (fd) {
-    if (!fd->is_eof) {
-      /* initializing to zero isn't strictly needed but shuts valgrind up
-       * since uninitialized memory gets compared */
-      BHead8 bhead8 = {0};
-      BHead4 bhead4 = {0};
-      BHead bhead = {0};
+  /* First read the bhead structure.
+   * Depending on the platform the file was written on this can
+   * be a big or little endian BHead4 or BHead8 structure. */
+  if (fd->flags & FD_FLAGS_FILE_POINTSIZE_IS_4) {
+    bhead4.code = DATA;
+    readsize = fd->file->read(fd->file, &bhead4, sizeof(bhead4));
 
-      /* First read the bhead structure.
-       * Depending on the platform the file was written on this can
-       * be a big or little endian BHead4 or BHead8 structure.
-       *
-       * As usual 'ENDB' (the last *partial* bhead of the file)
-       * needs some special handling. We don't want to EOF just yet.
-       */
-      if (fd->flags & FD_FLAGS_FILE_POINTSIZE_IS_4) {
-        bhead4.code = DATA;
-        readsize = fd->file->read(fd->file, &bhead4, sizeof(bhead4));
+    if (!(readsize == sizeof(bhead4) || bhead4.code == ENDB)) {
+      return false;
+    }
+    if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
+      switch_endian_bh4(&bhead4);
+    }
 
-        if (readsize == sizeof(bhead4) || bhead4.code == ENDB) {
-          if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
-            switch_endian_bh4(&bhead4);
-          }
+    if (fd->flags & FD_FLAGS_POINTSIZE_DIFFERS) {
+      bh8_from_bh4(r_bhead, &bhead4);
+    }
+    else {
+      /* MIN2 is only to quiet '-Warray-bounds' compiler warning. */
+      BLI_assert(sizeof(*r_bhead) == sizeof(bhead4));
+      memcpy(r_bhead, &bhead4, MIN2(sizeof(*r_bhead), sizeof(bhead4)));
+    }
+  }
+  else {
+    bhead8.code = DATA;
+    readsize = fd->file->read(fd->file, &bhead8, sizeof(bhead8));
 
-          if (fd->flags & FD_FLAGS_POINTSIZE_DIFFERS) {
-            bh8_from_bh4(&bhead, &bhead4);
-          }
-          else {
-            /* MIN2 is only to quiet '-Warray-bounds' compiler warning. */
-            BLI_assert(sizeof(bhead) == sizeof(bhead4));
-            memcpy(&bhead, &bhead4, MIN2(sizeof(bhead), sizeof(bhead4)));
-          }
-        }
-        else {
-          fd->is_eof = true;
-          bhead.len = 0;
-        }
-      }
-      else {
-        bhead8.code = DATA;
-        readsize = fd->file->read(fd->file, &bhead8, sizeof(bhead8));
+    if (!(readsize == sizeof(bhead8) || bhead8.code == ENDB)) {
+      return false;
+    }
+    if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
+      switch_endian_bh8(&bhead8);
+    }
 
-        if (readsize == sizeof(bhead8) || bhead8.code == ENDB) {
-          if (fd->flags & FD_FLAGS_SWITCH_ENDIAN) {
-            switch_endian_bh8(&bhead8);
-          }
+    if (fd->flags & FD_FLAGS_POINTSIZE_DIFFERS) {
+      bh4_from_bh8(r_bhead, &bhead8, (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0);
+    }
+    else {
+      /* MIN2 is only to quiet '-Warray-bounds' compiler warning. */
+      BLI_assert(sizeof(*r_bhead) == sizeof(bhead8));
+      memcpy(r_bhead, &bhead8, MIN2(sizeof(*r_bhead), sizeof(bhead8)));
+    }
+  }
 
-          if (fd->flags & FD_FLAGS_POINTSIZE_DIFFERS) {
-            bh4_from_bh8(&bhead, &bhead8, (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0);
-          }
-          else {
-            /* MIN2 is only to quiet '-Warray-bounds' compiler warning. */
-            BLI_assert(sizeof(bhead) == sizeof(bhead8));
-            memcpy(&bhead, &bhead8, MIN2(sizeof(bhead), sizeof(bhead8)));
-          }
-        }
-        else {
-          fd->is_eof = true;
-          bhead.len = 0;
-        }
-      }
+  /* make sure people are not trying to pass bad blend files */
+  return r_bhead->len >= 0;
+}
 
-      /* make sure people are not trying to pass bad blend files */
-      if (bhead.len < 0) {
+static BHeadN *get_bhead(FileData *fd)
+{
+  BHeadN *new_bhead = nullptr;
+  ssize_t readsize;
+
+  if (fd) {
+    if (!fd->is_eof) {
+      BHead bhead = {0};
+
+      if (!read_bhead_header(fd, &bhead)) {
         fd->is_eof = true;
+        bhead.len = 0;
       }
 
       /* bhead now contains the (converted) bhead structure. Now read
@@ -931,47 +938,194 @@ static void decode_blender_header(FileData *fd)
 /**
  * \return Success if the file is read correctly, else set \a r_error_message.
  */
+/**
+ * Read the file index (see #BlendFileIndexFooter), if the file has a valid one.
+ * The position in the file is left unchanged.
+ */
+static void read_file_index(FileData *fd)
+{
+  if ((fd->flags & FD_FLAGS_IS_MEMFILE) || fd->file->seek == nullptr) {
+    return;
+  }
+  const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
+  const off64_t offset_backup = fd->file->offset;
+
+  BlendFileIndexFooter *footer = static_cast<BlendFileIndexFooter *>(
+      MEM_mallocN(sizeof(*footer), __func__));
+  BlendFileIndexEntry *entries = nullptr;
+  bool is_valid = false;
+
+  const off64_t footer_offset = fd->file->seek(fd->file, -off64_t(sizeof(*footer)), SEEK_END);
+  if (footer_offset > SIZEOFBLENDERHEADER &&
+      fd->file->read(fd->file, footer, sizeof(*footer)) == sizeof(*footer) &&
+      memcmp(footer->magic, BLEND_FILE_INDEX_MAGIC, BLEND_FILE_INDEX_MAGIC_LEN) == 0)
+  {
+    if (do_endian_swap) {
+      BLI_endian_switch_uint64(&footer->glob_offset);
+      BLI_endian_switch_uint64(&footer->dna_offset);
+      BLI_endian_switch_uint64(&footer->entries_num);
+    }
+    const uint64_t data_end = uint64_t(footer_offset);
+    if (footer->glob_offset < data_end && footer->dna_offset < data_end &&
+        footer->entries_num <= (data_end - SIZEOFBLENDERHEADER) / sizeof(*entries))
+    {
+      const size_t entries_size = size_t(footer->entries_num) * sizeof(*entries);
+      entries = static_cast<BlendFileIndexEntry *>(MEM_mallocN(max_zz(entries_size, 1), __func__));
+      if (fd->file->seek(fd->file, footer_offset - off64_t(entries_size), SEEK_SET) != -1 &&
+          fd->file->read(fd->file, entries, entries_size) == ssize_t(entries_size))
+      {
+        is_valid = true;
+        for (uint64_t i = 0; i < footer->entries_num; i++) {
+          if (do_endian_swap) {
+            BLI_endian_switch_int32(&entries[i].code);
+            BLI_endian_switch_uint64(&entries[i].offset);
+          }
+          if (entries[i].offset >= data_end) {
+            is_valid = false;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if (fd->file->seek(fd->file, offset_backup, SEEK_SET) == -1) {
+    is_valid = false;
+  }
+
+  if (is_valid) {
+    fd->file_index_footer = footer;
+    fd->file_index_entries = entries;
+  }
+  else {
+    MEM_freeN(footer);
+    MEM_SAFE_FREE(entries);
+  }
+}
+
+/**
+ * Read the block at \a offset (pointing to its #BHead) from the file, without adding it to the
+ * #FileData.bhead_list. The position in the file is left unchanged.
+ *
+ * \param data_len_max: Don't read more than this amount of the block data.
+ * \return The block, to be freed with #MEM_freeN, nullptr on failure.
+ */
+static BHead *read_bhead_at_offset(FileData *fd, const uint64_t offset, const size_t data_len_max)
+{
+  const off64_t offset_backup = fd->file->offset;
+  BHead *bhead = nullptr;
+
+  BHead bhead_header = {0};
+  if (fd->file->seek(fd->file, off64_t(offset), SEEK_SET) != -1 &&
+      read_bhead_header(fd, &bhead_header))
+  {
+    const size_t data_len = MIN2(size_t(bhead_header.len), data_len_max);
+    bhead = static_cast<BHead *>(MEM_mallocN(sizeof(BHead) + data_len, __func__));
+    *bhead = bhead_header;
+    bhead->len = int(data_len);
+    if (fd->file->read(fd->file, bhead + 1, data_len) != ssize_t(data_len)) {
+      MEM_freeN(bhead);
+      bhead = nullptr;
+    }
+  }
+
+  if (fd->file->seek(fd->file, offset_backup, SEEK_SET) == -1) {
+    MEM_SAFE_FREE(bhead);
+  }
+  return bhead;
+}
+
+BHead *blo_bhead_read_id_from_index(FileData *fd, const BlendFileIndexEntry *entry)
+{
+  const size_t id_len = size_t(
+      max_ii(fd->id_name_offset + MAX_ID_NAME, fd->id_asset_data_offset + int(sizeof(void *))));
+  BHead *bhead = read_bhead_at_offset(fd, entry->offset, id_len);
+  if (bhead != nullptr && (bhead->code != entry->code || size_t(bhead->len) < id_len)) {
+    MEM_freeN(bhead);
+    return nullptr;
+  }
+  return bhead;
+}
+
+static int read_file_dna_subversion(const FileData *fd, const BHead *bhead_glob)
+{
+  /* Before this, the subversion didn't exist in 'FileGlobal' so the subversion
+   * value isn't accessible for the purpose of DNA versioning in this case. */
+  if (fd->fileversion <= 242 || bhead_glob->len < 4) {
+    return 0;
+  }
+  /* We can't use read_global because this needs 'DNA1' to be decoded,
+   * however the first 4 chars are _always_ the subversion. */
+  const FileGlobal *fg = reinterpret_cast<const FileGlobal *>(&bhead_glob[1]);
+  BLI_STATIC_ASSERT(offsetof(FileGlobal, subvstr) == 0, "Must be first: subvstr")
+  char num[5];
+  memcpy(num, fg->subvstr, 4);
+  num[4] = 0;
+  return atoi(num);
+}
+
+static bool read_file_dna_decode(FileData *fd,
+                                 const BHead *bhead_dna,
+                                 const int subversion,
+                                 const char **r_error_message)
+{
+  const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
+
+  fd->filesdna = DNA_sdna_from_data(
+      &bhead_dna[1], bhead_dna->len, do_endian_swap, true, r_error_message);
+  if (fd->filesdna) {
+    blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
+    fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
+    fd->reconstruct_info = DNA_reconstruct_info_create(fd->filesdna, fd->memsdna, fd->compflags);
+    /* used to retrieve ID names from (bhead+1) */
+    fd->id_name_offset = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
+    BLI_assert(fd->id_name_offset != -1);
+    fd->id_asset_data_offset = DNA_elem_offset(
+        fd->filesdna, "ID", "AssetMetaData", "*asset_data");
+
+    return true;
+  }
+
+  return false;
+}
+
+/** Read the DNA directly from the blocks referenced by the file index. */
+static bool read_file_dna_from_index(FileData *fd, const char **r_error_message)
+{
+  BHead *bhead_glob = read_bhead_at_offset(fd, fd->file_index_footer->glob_offset, 4);
+  BHead *bhead_dna = read_bhead_at_offset(fd, fd->file_index_footer->dna_offset, SIZE_MAX);
+
+  bool success = false;
+  if (bhead_glob && bhead_glob->code == GLOB && bhead_dna && bhead_dna->code == DNA1) {
+    success = read_file_dna_decode(
+        fd, bhead_dna, read_file_dna_subversion(fd, bhead_glob), r_error_message);
+  }
+
+  MEM_SAFE_FREE(bhead_glob);
+  MEM_SAFE_FREE(bhead_dna);
+  return success;
+}
+
 static bool read_file_dna(FileData *fd, const char **r_error_message)
 {
   BHead *bhead;
   int subversion = 0;
 
+  if (fd->file_index_footer != nullptr) {
+    if (read_file_dna_from_index(fd, r_error_message)) {
+      return true;
+    }
+    /* Invalid index, ignore it and scan the file. */
+    MEM_SAFE_FREE(fd->file_index_footer);
+    MEM_SAFE_FREE(fd->file_index_entries);
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == GLOB) {
-      /* Before this, the subversion didn't exist in 'FileGlobal' so the subversion
-       * value isn't accessible for the purpose of DNA versioning in this case. */
-      if (fd->fileversion <= 242) {
-        continue;
-      }
-      /* We can't use read_global because this needs 'DNA1' to be decoded,
-       * however the first 4 chars are _always_ the subversion. */
-      FileGlobal *fg = reinterpret_cast<FileGlobal *>(&bhead[1]);
-      BLI_STATIC_ASSERT(offsetof(FileGlobal, subvstr) == 0, "Must be first: subvstr")
-      char num[5];
-      memcpy(num, fg->subvstr, 4);
-      num[4] = 0;
-      subversion = atoi(num);
+      subversion = read_file_dna_subversion(fd, bhead);
     }
     else if (bhead->code == DNA1) {
-      const bool do_endian_swap = (fd->flags & FD_FLAGS_SWITCH_ENDIAN) != 0;
-
-      fd->filesdna = DNA_sdna_from_data(
-          &bhead[1], bhead->len, do_endian_swap, true, r_error_message);
-      if (fd->filesdna) {
-        blo_do_versions_dna(fd->filesdna, fd->fileversion, subversion);
-        fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
-        fd->reconstruct_info = DNA_reconstruct_info_create(
-            fd->filesdna, fd->memsdna, fd->compflags);
-        /* used to retrieve ID names from (bhead+1) */
-        fd->id_name_offset = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
-        BLI_assert(fd->id_name_offset != -1);
-        fd->id_asset_data_offset = DNA_elem_offset(
-            fd->filesdna, "ID", "AssetMetaData", "*asset_data");
-
-        return true;
-      }
-
-      return false;
+      return read_file_dna_decode(fd, bhead, subversion, r_error_message);
     }
     else if (bhead->code == ENDB) {
       break;
@@ -1051,6 +1205,7 @@ static FileData *blo_decode_and_check(FileData *fd, ReportList *reports)
 
   if (fd->flags & FD_FLAGS_FILE_OK) {
     const char *error_message = nullptr;
+    read_file_index(fd);
     if (read_file_dna(fd, &error_message) == false) {
       BKE_reportf(
           reports, RPT_ERROR, "Failed to read blend file '%s': %s", fd->relabase, error_message);
@@ -1279,6 +1434,11 @@ void blo_filedata_free(FileData *fd)
       BLI_ghash_free(fd->bhead_idname_hash, nullptr, nullptr);
     }
 #endif
+    if (fd->bhead_libmain_hash) {
+      BLI_ghash_free(fd->bhead_libmain_hash, nullptr, nullptr);
+    }
+    MEM_SAFE_FREE(fd->file_index_footer);
+    MEM_SAFE_FREE(fd->file_index_entries);
 
     MEM_freeN(fd);
   }
@@ -1757,6 +1917,44 @@ static void switch_endian_structs(const SDNA *filesdna, BHead *bhead)
   }
 }
 
+/**
+ * Whether reading this block requires converting its content (endian switching and/or
+ * reconstructing the struct for the current DNA), as opposed to a plain copy.
+ */
+static bool read_struct_needs_conversion(const FileData *fd, const BHead *bh)
+{
+  if (bh->len == 0 || fd->compflags[bh->SDNAnr] == SDNA_CMP_REMOVED) {
+    return false;
+  }
+  return (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) ||
+         (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL);
+}
+
+/**
+ * Convert the content of a block which is already in memory.
+ *
+ * \note Only reads the file-data (no file access, no flag changes),
+ * so this may run on multiple blocks of the same file from different threads.
+ */
+static void *read_struct_convert_in_memory(const FileData *fd, BHead *bh, const char *blockname)
+{
+  BLI_assert(read_struct_needs_conversion(fd, bh));
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  BLI_assert(BHEADN_FROM_BHEAD(bh)->has_data);
+#endif
+
+  if (bh->SDNAnr && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
+    switch_endian_structs(fd->filesdna, bh);
+  }
+  if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+    return DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+  }
+  /* SDNA_CMP_EQUAL */
+  void *temp = MEM_mallocN(bh->len, blockname);
+  memcpy(temp, (bh + 1), bh->len);
+  return temp;
+}
+
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
 {
   void *temp = nullptr;
@@ -3012,9 +3210,74 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+/**
+ * Blocks which need conversion are accumulated and converted in parallel,
+ * this limits the memory used by the (temporary) copies of blocks read on demand.
+ */
+#define DATAMAP_CONVERT_BATCH_SIZE_MAX (64 * 1024 * 1024)
+/** Below this size the overhead of threading isn't worth it. */
+#define DATAMAP_CONVERT_BATCH_SIZE_MIN (256 * 1024)
+
+struct DataMapConvertItem {
+  /** The block as stored in the #FileData.bhead_list. */
+  BHead *bhead;
+  /**
+   * The block holding the data to convert, may be a temporary copy of `bhead`.
+   * Null when `data` has been read already (no conversion needed).
+   */
+  BHead *bhead_data;
+  void *data;
+};
+
+/**
+ * Convert all pending blocks (in parallel when worthwhile) and add them to the datamap,
+ * in the same order as they are stored in the file (matters for duplicate old addresses).
+ */
+static void read_data_into_datamap_convert_batch(FileData *fd,
+                                                 blender::Vector<DataMapConvertItem> &batch,
+                                                 const size_t batch_size,
+                                                 const char *allocname)
+{
+  using namespace blender;
+  if (batch.is_empty()) {
+    return;
+  }
+
+  auto convert_fn = [&](const IndexRange range) {
+    for (DataMapConvertItem &item : batch.as_mutable_span().slice(range)) {
+      if (item.bhead_data) {
+        item.data = read_struct_convert_in_memory(fd, item.bhead_data, allocname);
+      }
+    }
+  };
+  if (batch_size < DATAMAP_CONVERT_BATCH_SIZE_MIN) {
+    convert_fn(batch.index_range());
+  }
+  else {
+    threading::parallel_for(batch.index_range(), 1, convert_fn);
+  }
+
+  for (DataMapConvertItem &item : batch) {
+    if (item.data) {
+      oldnewmap_insert(fd->datamap, item.bhead->old, item.data, 0);
+    }
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    if (item.bhead_data && item.bhead_data != item.bhead) {
+      MEM_freeN(BHEADN_FROM_BHEAD(item.bhead_data));
+    }
+#endif
+  }
+  batch.clear();
+}
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
+  /* Reading from the file is done sequentially,
+   * converting the data (endian switch, DNA reconstruction) is done in parallel. */
+  blender::Vector<DataMapConvertItem> batch;
+  size_t batch_size = 0;
+
   bhead = blo_bhead_next(fd, bhead);
 
   while (bhead && bhead->code == DATA) {
@@ -3038,14 +3301,34 @@ static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *all
     }
 #endif
 
-    void *data = read_struct(fd, bhead, allocname);
-    if (data) {
-      oldnewmap_insert(fd->datamap, bhead->old, data, 0);
+    if (read_struct_needs_conversion(fd, bhead)) {
+      BHead *bhead_data = bhead;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+      if (BHEADN_FROM_BHEAD(bhead)->has_data == false) {
+        bhead_data = blo_bhead_read_full(fd, bhead);
+        if (UNLIKELY(bhead_data == nullptr)) {
+          fd->flags &= ~FD_FLAGS_FILE_OK;
+        }
+      }
+#endif
+      if (bhead_data) {
+        batch.append({bhead, bhead_data, nullptr});
+        batch_size += size_t(bhead->len);
+        if (batch_size >= DATAMAP_CONVERT_BATCH_SIZE_MAX) {
+          read_data_into_datamap_convert_batch(fd, batch, batch_size, allocname);
+          batch_size = 0;
+        }
+      }
+    }
+    else {
+      batch.append({bhead, nullptr, read_struct(fd, bhead, allocname)});
     }
 
     bhead = blo_bhead_next(fd, bhead);
   }
 
+  read_data_into_datamap_convert_batch(fd, batch, batch_size, allocname);
+
   return bhead;
 }
 
@@ -3536,6 +3819,68 @@ static void do_versions_userdef(FileData * /*fd*/, BlendFileData *bfd)
   blo_do_versions_userdef(user);
 }
 
+/**
+ * A versioning pass, only ran for files older than the version from which it is known to not
+ * do anything anymore (all of its code being within `!MAIN_VERSION_ATLEAST` checks).
+ *
+ * A zero `skip_version` means the pass always runs,
+ * e.g. because it contains code not depending on the file version.
+ */
+struct VersioningPass {
+  const char *name;
+  void (*exec)(FileData *fd, Library *lib, Main *bmain);
+  int skip_version;
+  int skip_subversion;
+};
+
+struct VersioningAfterLinkingPass {
+  const char *name;
+  void (*exec)(Main *bmain, ReportList *reports);
+  int skip_version;
+  int skip_subversion;
+};
+
+static const VersioningPass versioning_passes[] = {
+    {"pre250", blo_do_versions_pre250, 250, 0},
+    {"250", blo_do_versions_250, 260, 0},
+    {"260", blo_do_versions_260, 270, 0},
+    {"270", blo_do_versions_270, 280, 0},
+    {"280", blo_do_versions_280, 0, 0},
+    {"290", blo_do_versions_290, 0, 0},
+    {"300", blo_do_versions_300, 0, 0},
+    {"400", blo_do_versions_400, 0, 0},
+    {"cycles", blo_do_versions_cycles, 0, 0},
+};
+
+static const VersioningAfterLinkingPass versioning_after_linking_passes[] = {
+    {"250",
+     [](Main *bmain, ReportList * /*reports*/) { do_versions_after_linking_250(bmain); },
+     260,
+     0},
+    {"260",
+     [](Main *bmain, ReportList * /*reports*/) { do_versions_after_linking_260(bmain); },
+     280,
+     60},
+    {"270",
+     [](Main *bmain, ReportList * /*reports*/) { do_versions_after_linking_270(bmain); },
+     280,
+     0},
+    {"280", do_versions_after_linking_280, 0, 0},
+    {"290", do_versions_after_linking_290, 0, 0},
+    {"300", do_versions_after_linking_300, 0, 0},
+    {"cycles",
+     [](Main *bmain, ReportList * /*reports*/) { do_versions_after_linking_cycles(bmain); },
+     0,
+     0},
+};
+
+static bool versioning_pass_is_needed(const Main *bmain,
+                                      const int skip_version,
+                                      const int skip_subversion)
+{
+  return skip_version == 0 || !MAIN_VERSION_ATLEAST(bmain, skip_version, skip_subversion);
+}
+
 static void do_versions(FileData *fd, Library *lib, Main *main)
 {
   /* WATCH IT!!!: pointers from libdata have not been converted */
@@ -3564,15 +3909,21 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
               main->build_hash);
   }
 
-  blo_do_versions_pre250(fd, lib, main);
-  blo_do_versions_250(fd, lib, main);
-  blo_do_versions_260(fd, lib, main);
-  blo_do_versions_270(fd, lib, main);
-  blo_do_versions_280(fd, lib, main);
-  blo_do_versions_290(fd, lib, main);
-  blo_do_versions_300(fd, lib, main);
-  blo_do_versions_400(fd, lib, main);
-  blo_do_versions_cycles(fd, lib, main);
+  const bool do_timing = CLOG_CHECK(&LOG, 2);
+  for (const VersioningPass &pass : versioning_passes) {
+    if (!versioning_pass_is_needed(main, pass.skip_version, pass.skip_subversion)) {
+      continue;
+    }
+    const double time_start = do_timing ? PIL_check_seconds_timer() : 0.0;
+    pass.exec(fd, lib, main);
+    if (do_timing) {
+      CLOG_INFO(&LOG,
+                2,
+                "Versioning %s: %.3f ms",
+                pass.name,
+                (PIL_check_seconds_timer() - time_start) * 1000.0);
+    }
+  }
 
   /* WATCH IT!!!: pointers from libdata have not been converted yet here! */
   /* WATCH IT 2!: Userdef struct init see do_versions_userdef() above! */
@@ -3595,13 +3946,21 @@ static void do_versions_after_linking(Main *main, ReportList *reports)
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
-  do_versions_after_linking_250(main);
-  do_versions_after_linking_260(main);
-  do_versions_after_linking_270(main);
-  do_versions_after_linking_280(main, reports);
-  do_versions_after_linking_290(main, reports);
-  do_versions_after_linking_300(main, reports);
-  do_versions_after_linking_cycles(main);
+  const bool do_timing = CLOG_CHECK(&LOG, 2);
+  for (const VersioningAfterLinkingPass &pass : versioning_after_linking_passes) {
+    if (!versioning_pass_is_needed(main, pass.skip_version, pass.skip_subversion)) {
+      continue;
+    }
+    const double time_start = do_timing ? PIL_check_seconds_timer() : 0.0;
+    pass.exec(main, reports);
+    if (do_timing) {
+      CLOG_INFO(&LOG,
+                2,
+                "Versioning after linking %s: %.3f ms",
+                pass.name,
+                (PIL_check_seconds_timer() - time_start) * 1000.0);
+    }
+  }
 
   main->is_locked_for_linking = false;
 }
@@ -3865,6 +4224,9 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  double time_start = PIL_check_seconds_timer();
+  int64_t memory_start = int64_t(MEM_get_memory_in_use());
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -3916,8 +4278,14 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  fd->reports->duration.read_data = PIL_check_seconds_timer() - time_start;
+  fd->reports->memory.read_data = int64_t(MEM_get_memory_in_use()) - memory_start;
+
   /* do before read_libraries, but skip undo case */
   if ((fd->flags & FD_FLAGS_IS_MEMFILE) == 0) {
+    time_start = PIL_check_seconds_timer();
+    memory_start = int64_t(MEM_get_memory_in_use());
+
     if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
       do_versions(fd, nullptr, bfd->main);
     }
@@ -3925,18 +4293,29 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     if ((fd->skip_flags & BLO_READ_SKIP_USERDEF) == 0) {
       do_versions_userdef(fd, bfd);
     }
+
+    fd->reports->duration.versioning = PIL_check_seconds_timer() - time_start;
+    fd->reports->memory.versioning = int64_t(MEM_get_memory_in_use()) - memory_start;
   }
 
   if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
     fd->reports->duration.libraries = PIL_check_seconds_timer();
+    memory_start = int64_t(MEM_get_memory_in_use());
     read_libraries(fd, &mainlist);
 
     blo_join_main(&mainlist);
 
+    time_start = PIL_check_seconds_timer();
+    const int64_t memory_lib_link_start = int64_t(MEM_get_memory_in_use());
+
     lib_link_all(fd, bfd->main);
     after_liblink_merged_bmain_process(bfd->main);
 
+    fd->reports->duration.lib_link = PIL_check_seconds_timer() - time_start;
+    fd->reports->memory.lib_link = int64_t(MEM_get_memory_in_use()) - memory_lib_link_start;
+
     fd->reports->duration.libraries = PIL_check_seconds_timer() - fd->reports->duration.libraries;
+    fd->reports->memory.libraries = int64_t(MEM_get_memory_in_use()) - memory_start;
 
     /* Skip in undo case. */
     if ((fd->flags & FD_FLAGS_IS_MEMFILE) == 0) {
@@ -3947,20 +4326,28 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
        * from groups to collections... We could optimize out that first call when we are reading a
        * current version file, but again this is really not a bottle neck currently.
        * So not worth it. */
+      time_start = PIL_check_seconds_timer();
       BKE_main_id_refcount_recompute(bfd->main, false);
+      fd->reports->duration.id_refcount_recompute = PIL_check_seconds_timer() - time_start;
 
       /* Yep, second splitting... but this is a very cheap operation, so no big deal. */
+      time_start = PIL_check_seconds_timer();
+      memory_start = int64_t(MEM_get_memory_in_use());
       blo_split_main(&mainlist, bfd->main);
       LISTBASE_FOREACH (Main *, mainvar, &mainlist) {
         BLI_assert(mainvar->versionfile != 0);
         do_versions_after_linking(mainvar, fd->reports->reports);
       }
       blo_join_main(&mainlist);
+      fd->reports->duration.versioning += PIL_check_seconds_timer() - time_start;
+      fd->reports->memory.versioning += int64_t(MEM_get_memory_in_use()) - memory_start;
 
       /* And we have to compute those user-reference-counts again, as `do_versions_after_linking()`
        * does not always properly handle user counts, and/or that function does not take into
        * account old, deprecated data. */
+      time_start = PIL_check_seconds_timer();
       BKE_main_id_refcount_recompute(bfd->main, false);
+      fd->reports->duration.id_refcount_recompute += PIL_check_seconds_timer() - time_start;
     }
 
     /* After all data has been read and versioned, uses LIB_TAG_NEW. Theoretically this should
@@ -4170,6 +4557,28 @@ static ID *is_yet_read(FileData *fd, Main *mainvar, BHead *bhead)
 /** \name Library Linking (expand pointers)
  * \{ */
 
+/**
+ * Find (or add) the #Main of the library stored in `bheadlib`.
+ *
+ * This is needed for every pointer to data from another library, reading the #Library and
+ * looking it up by its normalized path is expensive for files with many linked data-blocks,
+ * so results are cached in the #FileData.
+ */
+static Main *blo_find_main_from_bhead_lib(FileData *fd, BHead *bheadlib)
+{
+  if (fd->bhead_libmain_hash == nullptr) {
+    fd->bhead_libmain_hash = BLI_ghash_ptr_new(__func__);
+  }
+
+  void **libmain_p;
+  if (!BLI_ghash_ensure_p(fd->bhead_libmain_hash, bheadlib, &libmain_p)) {
+    Library *lib = static_cast<Library *>(read_struct(fd, bheadlib, "Library"));
+    *libmain_p = blo_find_main(fd, lib->filepath, fd->relabase);
+    MEM_freeN(lib);
+  }
+  return static_cast<Main *>(*libmain_p);
+}
+
 static void expand_doit_library(void *fdhandle, Main *mainvar, void *old)
 {
   FileData *fd = static_cast<FileData *>(fdhandle);
@@ -4186,8 +4595,7 @@ static void expand_doit_library(void *fdhandle, Main *mainvar, void *old)
       return;
     }
 
-    Library *lib = static_cast<Library *>(read_struct(fd, bheadlib, "Library"));
-    Main *libmain = blo_find_main(fd, lib->filepath, fd->relabase);
+    Main *libmain = blo_find_main_from_bhead_lib(fd, bheadlib);
 
     if (libmain->curlib == nullptr) {
       const char *idname = blo_bhead_id_name(fd, bhead);
@@ -4247,12 +4655,10 @@ static void expand_doit_library(void *fdhandle, Main *mainvar, void *old)
       /* Commented because this can print way too much. */
 #if 0
       if (G.debug & G_DEBUG) {
-        printf("expand_doit: already linked: %s lib: %s\n", id->name, lib->filepath);
+        printf("expand_doit: already linked: %s lib: %s\n", id->name, libmain->curlib->filepath);
       }
 #endif
     }
-
-    MEM_freeN(lib);
   }
   else {
     /* Data-block in same library. */
@@ -4917,6 +5323,12 @@ static void read_libraries(FileData *basefd, ListBase *mainlist)
     }
   }
 
+  /* Library mains are going to be joined by the caller, the cache would point to freed data. */
+  if (basefd->bhead_libmain_hash) {
+    BLI_ghash_free(basefd->bhead_libmain_hash, nullptr, nullptr);
+    basefd->bhead_libmain_hash = nullptr;
+  }
+
   for (Main *mainptr = mainl->next; mainptr; mainptr = mainptr->next) {
     /* Drop weak links for which no data-block was found.
      * Since this can remap pointers in `libmap` of all libraries, it needs to be performed in its
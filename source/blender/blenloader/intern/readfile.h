@@ -50,6 +50,34 @@ ENUM_OPERATORS(eFileDataFlag, FD_FLAGS_NOT_MY_LIBMAP)
 #  pragma GCC poison off_t
 #endif
 
+/**
+ * Optional index, written after the #ENDB block of regular (non-undo) files, so readers which do
+ * not know about it just ignore it. It allows to find the #GLOB and #DNA1 blocks and the local
+ * ID blocks without scanning (and decompressing) the whole file.
+ *
+ * Layout, in the endianness of the file:
+ * - An array of #BlendFileIndexEntry, one for each local ID block, in file order.
+ * - A #BlendFileIndexFooter, always the last bytes of the file.
+ *
+ * All offsets are from the start of the (uncompressed) file, pointing to the #BHead of a block.
+ */
+#define BLEND_FILE_INDEX_MAGIC "BLENDIDX"
+#define BLEND_FILE_INDEX_MAGIC_LEN 8
+
+typedef struct BlendFileIndexEntry {
+  /** The #BHead.code of the block. */
+  int code;
+  int _pad;
+  uint64_t offset;
+} BlendFileIndexEntry;
+
+typedef struct BlendFileIndexFooter {
+  uint64_t glob_offset;
+  uint64_t dna_offset;
+  uint64_t entries_num;
+  char magic[BLEND_FILE_INDEX_MAGIC_LEN];
+} BlendFileIndexFooter;
+
 typedef struct FileData {
   /** Linked list of BHeadN's. */
   ListBase bhead_list;
@@ -103,6 +131,18 @@ typedef struct FileData {
 
   /** See: #USE_GHASH_BHEAD. */
   struct GHash *bhead_idname_hash;
+  /**
+   * Library #BHead to the #Main of that library, caches #blo_find_main lookups while expanding
+   * linked data. Only valid until the mains are joined (cleared by #read_libraries).
+   */
+  struct GHash *bhead_libmain_hash;
+
+  /**
+   * Content of the file index, when present and valid (see #BlendFileIndexFooter),
+   * only read for light access to the file (#BlendHandle).
+   */
+  BlendFileIndexFooter *file_index_footer;
+  BlendFileIndexEntry *file_index_entries;
 
   ListBase *mainlist;
   /** Used for undo. */
@@ -170,6 +210,14 @@ const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead);
  * Warning! Caller's responsibility to ensure given bhead **is** an ID one!
  */
 struct AssetMetaData *blo_bhead_id_asset_data_address(const FileData *fd, const BHead *bhead);
+/**
+ * Read the ID block referenced by a file index entry, outside of the #FileData.bhead_list.
+ * Only the start of the ID struct is read, enough for #blo_bhead_id_name and
+ * #blo_bhead_id_asset_data_address.
+ *
+ * \return The block, to be freed with #MEM_freeN, nullptr on failure.
+ */
+BHead *blo_bhead_read_id_from_index(FileData *fd, const BlendFileIndexEntry *entry);
 
 /* do versions stuff */
 
@@ -25,6 +25,7 @@
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -43,7 +44,7 @@ void BLO_memfile_free(MemFile *memfile)
   MemFileChunk *chunk;
 
   while ((chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks)))) {
-    if (chunk->is_identical == false) {
+    if (chunk->is_identical == false && chunk->is_shared == false) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
@@ -58,11 +59,16 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
   GHash *buffer_to_second_memchunk = BLI_ghash_new(
       BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
 
-  /* First, detect all memchunks in second memfile that are not owned by it. */
+  /* First, detect all memchunks in second memfile that are not owned by it.
+   * Several chunks may share the same buffer (see #MemFileChunk.is_shared),
+   * transferring ownership to one of them is enough. */
   for (MemFileChunk *sc = static_cast<MemFileChunk *>(second->chunks.first); sc != nullptr;
        sc = static_cast<MemFileChunk *>(sc->next)) {
-    if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
+    if (sc->is_identical || sc->is_shared) {
+      void **entry;
+      if (!BLI_ghash_ensure_p(buffer_to_second_memchunk, (void *)sc->buf, &entry)) {
+        *entry = sc;
+      }
     }
   }
 
@@ -74,8 +80,9 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
       MemFileChunk *sc = static_cast<MemFileChunk *>(
           BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf));
       if (sc != nullptr) {
-        BLI_assert(sc->is_identical);
+        BLI_assert(sc->is_identical || sc->is_shared);
         sc->is_identical = false;
+        sc->is_shared = false;
         fc->is_identical = true;
       }
       /* Note that if the second memfile does not use that chunk, we assume that the first one
@@ -105,6 +112,7 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
   mem_data->reference_current_chunk = reference_memfile ? static_cast<MemFileChunk *>(
                                                               reference_memfile->chunks.first) :
                                                           nullptr;
+  mem_data->content_mapping = nullptr;
 
   /* If we have a reference memfile, we generate a mapping between the session_uuid's of the
    * IDs stored in that previous undo step, and its first matching memchunk. This will allow
@@ -137,6 +145,44 @@ void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
   if (mem_data->id_session_uuid_mapping != nullptr) {
     BLI_ghash_free(mem_data->id_session_uuid_mapping, nullptr, nullptr);
   }
+  if (mem_data->content_mapping != nullptr) {
+    BLI_gset_free(mem_data->content_mapping, nullptr);
+  }
+}
+
+/**
+ * Smaller chunks are not worth de-duplicating by content
+ * (they are also the ones most likely to be identical by accident).
+ */
+#define MEMFILE_CONTENT_DEDUP_SIZE_MIN 1024
+
+static uint memfile_chunk_content_hash(const void *key)
+{
+  return static_cast<const MemFileChunk *>(key)->content_hash;
+}
+
+static bool memfile_chunk_content_cmp(const void *a, const void *b)
+{
+  const MemFileChunk *chunk_a = static_cast<const MemFileChunk *>(a);
+  const MemFileChunk *chunk_b = static_cast<const MemFileChunk *>(b);
+  return (chunk_a->content_hash != chunk_b->content_hash) || (chunk_a->size != chunk_b->size) ||
+         (memcmp(chunk_a->buf, chunk_b->buf, chunk_a->size) != 0);
+}
+
+/** Find a chunk of the reference memfile with the same content as `chunk_key`. */
+static MemFileChunk *memfile_chunk_find_by_content(MemFileWriteData *mem_data,
+                                                   const MemFileChunk *chunk_key)
+{
+  if (mem_data->content_mapping == nullptr) {
+    mem_data->content_mapping = BLI_gset_new(
+        memfile_chunk_content_hash, memfile_chunk_content_cmp, __func__);
+    LISTBASE_FOREACH (MemFileChunk *, mem_chunk, &mem_data->reference_memfile->chunks) {
+      if (mem_chunk->size >= MEMFILE_CONTENT_DEDUP_SIZE_MIN) {
+        BLI_gset_add(mem_data->content_mapping, mem_chunk);
+      }
+    }
+  }
+  return static_cast<MemFileChunk *>(BLI_gset_lookup(mem_data->content_mapping, chunk_key));
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -149,6 +195,8 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->size = size;
   curchunk->buf = nullptr;
   curchunk->is_identical = false;
+  curchunk->is_shared = false;
+  curchunk->content_hash = 0;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -162,6 +210,7 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     if (compchunk->size == curchunk->size) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->content_hash = compchunk->content_hash;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
       }
@@ -169,6 +218,20 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     *compchunk_step = static_cast<MemFileChunk *>(compchunk->next);
   }
 
+  /* Not equal, but the same data may exist elsewhere in the previous step. */
+  if (curchunk->buf == nullptr && size >= MEMFILE_CONTENT_DEDUP_SIZE_MIN) {
+    curchunk->content_hash = BLI_hash_mm2(reinterpret_cast<const uchar *>(buf), size, 0);
+    if (mem_data->reference_memfile != nullptr) {
+      MemFileChunk chunk_key = *curchunk;
+      chunk_key.buf = buf;
+      MemFileChunk *compchunk = memfile_chunk_find_by_content(mem_data, &chunk_key);
+      if (compchunk != nullptr) {
+        curchunk->buf = compchunk->buf;
+        curchunk->is_shared = true;
+      }
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == nullptr) {
     char *buf_new = static_cast<char *>(MEM_mallocN(size, "Chunk buffer"));
@@ -178,6 +241,37 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+/** Maximum size of the chunks created by #BLO_memfile_copy_for_write. */
+#define MEMFILE_COPY_CHUNK_SIZE (1 << 24) /* 16mb */
+
+MemFile *BLO_memfile_copy_for_write(const MemFile *memfile)
+{
+  MemFile *memfile_copy = static_cast<MemFile *>(MEM_callocN(sizeof(MemFile), __func__));
+
+  MemFileChunk *chunk_copy = nullptr;
+  size_t chunk_copy_capacity = 0;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    const char *buf = chunk->buf;
+    size_t size = chunk->size;
+    while (size > 0) {
+      if (chunk_copy == nullptr || chunk_copy->size == chunk_copy_capacity) {
+        chunk_copy = static_cast<MemFileChunk *>(MEM_callocN(sizeof(MemFileChunk), __func__));
+        chunk_copy_capacity = MEMFILE_COPY_CHUNK_SIZE;
+        chunk_copy->buf = static_cast<char *>(MEM_mallocN(chunk_copy_capacity, __func__));
+        BLI_addtail(&memfile_copy->chunks, chunk_copy);
+      }
+      const size_t copy_size = MIN2(size, chunk_copy_capacity - chunk_copy->size);
+      memcpy((char *)chunk_copy->buf + chunk_copy->size, buf, copy_size);
+      chunk_copy->size += copy_size;
+      memfile_copy->size += copy_size;
+      buf += copy_size;
+      size -= copy_size;
+    }
+  }
+
+  return memfile_copy;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *bmain,
                                   struct Scene **r_scene)
@@ -199,6 +293,21 @@ struct Main *BLO_memfile_main_get(struct MemFile *memfile,
   return bmain_undo;
 }
 
+/** Size of the buffer used to coalesce small chunks when writing a #MemFile to disk. */
+#define MEMFILE_WRITE_BUFFER_SIZE (1 << 20) /* 1mb */
+
+static bool memfile_write_buffer(int file, const char *buf, size_t size)
+{
+  if (size == 0) {
+    return true;
+  }
+#ifdef _WIN32
+  return size_t(write(file, buf, uint(size))) == size;
+#else
+  return size_t(write(file, buf, size)) == size;
+#endif
+}
+
 bool BLO_memfile_write_file(struct MemFile *memfile, const char *filepath)
 {
   MemFileChunk *chunk;
@@ -230,18 +339,38 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filepath)
     return false;
   }
 
+  /* Chunks are often tiny (data is segmented per ID for de-duplication),
+   * so coalesce them to avoid a system call for each chunk. */
+  char *buffer = static_cast<char *>(MEM_mallocN(MEMFILE_WRITE_BUFFER_SIZE, __func__));
+  size_t buffer_used = 0;
+
   for (chunk = static_cast<MemFileChunk *>(memfile->chunks.first); chunk;
        chunk = static_cast<MemFileChunk *>(chunk->next)) {
-#ifdef _WIN32
-    if (size_t(write(file, chunk->buf, uint(chunk->size))) != chunk->size)
-#else
-    if (size_t(write(file, chunk->buf, chunk->size)) != chunk->size)
-#endif
-    {
-      break;
+    if (buffer_used + chunk->size > MEMFILE_WRITE_BUFFER_SIZE) {
+      if (!memfile_write_buffer(file, buffer, buffer_used)) {
+        break;
+      }
+      buffer_used = 0;
+    }
+
+    if (chunk->size >= MEMFILE_WRITE_BUFFER_SIZE) {
+      /* Large chunks are written directly. */
+      if (!memfile_write_buffer(file, chunk->buf, chunk->size)) {
+        break;
+      }
     }
+    else {
+      memcpy(buffer + buffer_used, chunk->buf, chunk->size);
+      buffer_used += chunk->size;
+    }
+  }
+
+  if ((chunk == nullptr) && !memfile_write_buffer(file, buffer, buffer_used)) {
+    /* Flag the last chunk as failing, for the error report below. */
+    chunk = static_cast<MemFileChunk *>(memfile->chunks.last);
   }
 
+  MEM_freeN(buffer);
   close(file);
 
   if (chunk) {
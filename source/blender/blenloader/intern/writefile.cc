@@ -92,6 +92,7 @@
 #include "BLI_math_base.h"
 #include "BLI_mempool.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
 #include "BKE_blender_version.h"
@@ -136,9 +137,6 @@
 
 static CLG_LogRef LOG = {"blo.writefile"};
 
-/** Use if we want to store how many bytes have been written to the file. */
-// #define USE_WRITE_DATA_LEN
-
 /* -------------------------------------------------------------------- */
 /** \name Internal Write Wrapper's (Abstracts Compression)
  * \{ */
@@ -409,10 +407,18 @@ struct WriteData {
     size_t chunk_size;
   } buffer;
 
-#ifdef USE_WRITE_DATA_LEN
-  /** Total number of bytes written. */
+  /** Total number of bytes written (before compression). */
   size_t write_len;
-#endif
+
+  /**
+   * Index of the blocks written in the file, stored at its end (see #BlendFileIndexFooter).
+   * Not used for undo.
+   */
+  struct {
+    blender::Vector<BlendFileIndexEntry> *entries;
+    uint64_t glob_offset;
+    uint64_t dna_offset;
+  } index;
 
   /** Set on unlikely case of an error (ignores further file writing). */
   bool error;
@@ -488,6 +494,7 @@ static void writedata_free(WriteData *wd)
   if (wd->buffer.buf) {
     MEM_freeN(wd->buffer.buf);
   }
+  MEM_delete(wd->index.entries);
   MEM_freeN(wd);
 }
 
@@ -525,9 +532,7 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
     return;
   }
 
-#ifdef USE_WRITE_DATA_LEN
   wd->write_len += len;
-#endif
 
   if (wd->buffer.buf == nullptr) {
     writedata_do_write(wd, adr, len);
@@ -578,6 +583,9 @@ static WriteData *mywrite_begin(WriteWrap *ww, MemFile *compare, MemFile *curren
     BLO_memfile_write_init(&wd->mem, current, compare);
     wd->use_memfile = true;
   }
+  else {
+    wd->index.entries = MEM_new<blender::Vector<BlendFileIndexEntry>>(__func__);
+  }
 
   return wd;
 }
@@ -1113,6 +1121,24 @@ static int write_id_direct_linked_data_process_cb(LibraryIDLinkCallbackData *cb_
 }
 
 /* if MemFile * there's filesave to memory */
+/** Write the file index after #ENDB, see #BlendFileIndexFooter. */
+static void write_file_index(WriteData *wd)
+{
+  if (wd->index.entries == nullptr) {
+    return;
+  }
+  if (!wd->index.entries->is_empty()) {
+    mywrite(wd, wd->index.entries->data(), wd->index.entries->as_span().size_in_bytes());
+  }
+
+  BlendFileIndexFooter footer = {0};
+  footer.glob_offset = wd->index.glob_offset;
+  footer.dna_offset = wd->index.dna_offset;
+  footer.entries_num = uint64_t(wd->index.entries->size());
+  memcpy(footer.magic, BLEND_FILE_INDEX_MAGIC, BLEND_FILE_INDEX_MAGIC_LEN);
+  mywrite(wd, &footer, sizeof(footer));
+}
+
 static bool write_file_handle(Main *mainvar,
                               WriteWrap *ww,
                               MemFile *compare,
@@ -1163,6 +1189,7 @@ static bool write_file_handle(Main *mainvar,
 
   write_renderinfo(wd, mainvar);
   write_thumb(wd, thumb);
+  wd->index.glob_offset = wd->write_len;
   write_global(wd, write_flags, mainvar);
 
   /* The window-manager and screen often change,
@@ -1322,6 +1349,7 @@ static bool write_file_handle(Main *mainvar,
    *
    * Note that we *borrow* the pointer to 'DNAstr',
    * so writing each time uses the same address and doesn't cause unnecessary undo overhead. */
+  wd->index.dna_offset = wd->write_len;
   writedata(wd, DNA1, size_t(wd->sdna->data_len), wd->sdna->data);
 
   /* end of file */
@@ -1329,6 +1357,8 @@ static bool write_file_handle(Main *mainvar,
   bhead.code = ENDB;
   mywrite(wd, &bhead, sizeof(BHead));
 
+  write_file_index(wd);
+
   blo_join_main(&mainlist);
 
   return mywrite_end(wd);
@@ -1630,7 +1660,14 @@ void BLO_write_struct_list_by_name(BlendWriter *writer, const char *struct_name,
 
 void blo_write_id_struct(BlendWriter *writer, int struct_id, const void *id_address, const ID *id)
 {
-  writestruct_at_address_nr(writer->wd, GS(id->name), struct_id, 1, id_address, id);
+  WriteData *wd = writer->wd;
+  if (wd->index.entries != nullptr) {
+    BlendFileIndexEntry entry = {0};
+    entry.code = GS(id->name);
+    entry.offset = wd->write_len;
+    wd->index.entries->append(entry);
+  }
+  writestruct_at_address_nr(wd, GS(id->name), struct_id, 1, id_address, id);
 }
 
 int BLO_get_struct_id_by_name(BlendWriter *writer, const char *struct_name)
@@ -1288,6 +1288,56 @@ void BM_mesh_rebuild(BMesh *bm,
   }
 }
 
+void BM_mesh_compact(BMesh *bm)
+{
+  /* Tool flags of running operators would be lost. */
+  BLI_assert(bm->toolflag_index == 0);
+
+  const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_BM(bm);
+
+  BLI_mempool *vpool_dst = nullptr;
+  BLI_mempool *epool_dst = nullptr;
+  BLI_mempool *lpool_dst = nullptr;
+  BLI_mempool *fpool_dst = nullptr;
+
+  bm_mempool_init_ex(
+      &allocsize, bm->use_toolflags, &vpool_dst, &epool_dst, &lpool_dst, &fpool_dst);
+
+  /* Without tool flag pools, the rebuild leaves the tool flags unset,
+   * they are allocated again by the next operator. */
+  BM_mesh_elem_toolflags_clear(bm);
+
+  struct BMeshCreateParams params = {};
+  params.use_toolflags = bm->use_toolflags;
+
+  BM_mesh_rebuild(bm, &params, vpool_dst, epool_dst, lpool_dst, fpool_dst);
+}
+
+/**
+ * A memory pool is considered fragmented when more than half of its elements are unused.
+ * Small pools are never packed, as all their elements are likely to fit into the cache anyway.
+ */
+static bool bm_mempool_is_fragmented(const BLI_mempool *pool)
+{
+  const int unused_min = 16384;
+  const int used = BLI_mempool_len(pool);
+  const int unused = BLI_mempool_capacity(pool) - used;
+  return (unused > unused_min) && (unused > used);
+}
+
+bool BM_mesh_compact_if_fragmented(BMesh *bm)
+{
+  if (bm->py_handle || bm->lnor_spacearr || bm->toolflag_index != 0) {
+    return false;
+  }
+  if (!(bm_mempool_is_fragmented(bm->vpool) || bm_mempool_is_fragmented(bm->epool) ||
+        bm_mempool_is_fragmented(bm->lpool) || bm_mempool_is_fragmented(bm->fpool))) {
+    return false;
+  }
+  BM_mesh_compact(bm);
+  return true;
+}
+
 void BM_mesh_toolflags_set(BMesh *bm, bool use_toolflags)
 {
   if (bm->use_toolflags == use_toolflags) {
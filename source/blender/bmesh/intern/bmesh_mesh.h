@@ -170,6 +170,27 @@ void BM_mesh_rebuild(BMesh *bm,
                      struct BLI_mempool *lpool,
                      struct BLI_mempool *fpool);
 
+/**
+ * Pack all elements into new memory pools, without the space left unused by removed elements.
+ * The loops of every face are stored next to each other, in the order of the faces.
+ * Iterating over the elements then reads contiguous memory.
+ *
+ * The order and the indices of the elements don't change, tool flags are cleared.
+ *
+ * \warning All element pointers change, they must not be kept outside of the mesh.
+ */
+void BM_mesh_compact(BMesh *bm);
+/**
+ * Call #BM_mesh_compact when a large part of the memory pools is unused,
+ * e.g. after an operator removed many elements.
+ *
+ * Meshes with element pointers stored outside of the mesh are skipped
+ * (Python references or custom normal spaces).
+ *
+ * \return True when the mesh was compacted.
+ */
+bool BM_mesh_compact_if_fragmented(BMesh *bm);
+
 typedef struct BMAllocTemplate {
   int totvert, totedge, totloop, totface;
 } BMAllocTemplate;
@@ -887,23 +887,6 @@ static void bm_to_mesh_shape(BMesh *bm,
 
 /** \} */
 
-template<typename T, typename GetFn>
-static void write_fn_to_attribute(blender::bke::MutableAttributeAccessor attributes,
-                                  const StringRef attribute_name,
-                                  const eAttrDomain domain,
-                                  const GetFn &get_fn)
-{
-  using namespace blender;
-  bke::SpanAttributeWriter<T> attribute = attributes.lookup_or_add_for_write_only_span<T>(
-      attribute_name, domain);
-  threading::parallel_for(attribute.span.index_range(), 4096, [&](IndexRange range) {
-    for (const int i : range) {
-      attribute.span[i] = get_fn(i);
-    }
-  });
-  attribute.finish();
-}
-
 static void assert_bmesh_has_no_mesh_only_attributes(const BMesh &bm)
 {
   (void)bm; /* Unused in the release builds. */
@@ -919,396 +902,6 @@ static void assert_bmesh_has_no_mesh_only_attributes(const BMesh &bm)
   BLI_assert(CustomData_get_layer_named(&bm.pdata, CD_PROP_BOOL, ".select_poly") == nullptr);
 }
 
-static void convert_bmesh_hide_flags_to_mesh_attributes(BMesh &bm,
-                                                        const bool need_hide_vert,
-                                                        const bool need_hide_edge,
-                                                        const bool need_hide_poly,
-                                                        Mesh &mesh)
-{
-  using namespace blender;
-  /* The "hide" attributes are stored as flags on #BMesh. */
-  assert_bmesh_has_no_mesh_only_attributes(bm);
-
-  if (!(need_hide_vert || need_hide_edge || need_hide_poly)) {
-    return;
-  }
-
-  bke::MutableAttributeAccessor attributes = mesh.attributes_for_write();
-  BM_mesh_elem_table_ensure(&bm, BM_VERT | BM_EDGE | BM_FACE);
-
-  if (need_hide_vert) {
-    write_fn_to_attribute<bool>(attributes, ".hide_vert", ATTR_DOMAIN_POINT, [&](const int i) {
-      return BM_elem_flag_test(BM_vert_at_index(&bm, i), BM_ELEM_HIDDEN);
-    });
-  }
-  if (need_hide_edge) {
-    write_fn_to_attribute<bool>(attributes, ".hide_edge", ATTR_DOMAIN_EDGE, [&](const int i) {
-      return BM_elem_flag_test(BM_edge_at_index(&bm, i), BM_ELEM_HIDDEN);
-    });
-  }
-  if (need_hide_poly) {
-    write_fn_to_attribute<bool>(attributes, ".hide_poly", ATTR_DOMAIN_FACE, [&](const int i) {
-      return BM_elem_flag_test(BM_face_at_index(&bm, i), BM_ELEM_HIDDEN);
-    });
-  }
-}
-
-static void convert_bmesh_selection_flags_to_mesh_attributes(BMesh &bm,
-                                                             const bool need_select_vert,
-                                                             const bool need_select_edge,
-                                                             const bool need_select_poly,
-                                                             Mesh &mesh)
-{
-  using namespace blender;
-  if (!(need_select_vert || need_select_edge || need_select_poly)) {
-    return;
-  }
-
-  bke::MutableAttributeAccessor attributes = mesh.attributes_for_write();
-  BM_mesh_elem_table_ensure(&bm, BM_VERT | BM_EDGE | BM_FACE);
-
-  if (need_select_vert) {
-    write_fn_to_attribute<bool>(attributes, ".select_vert", ATTR_DOMAIN_POINT, [&](const int i) {
-      return BM_elem_flag_test(BM_vert_at_index(&bm, i), BM_ELEM_SELECT);
-    });
-  }
-  if (need_select_edge) {
-    write_fn_to_attribute<bool>(attributes, ".select_edge", ATTR_DOMAIN_EDGE, [&](const int i) {
-      return BM_elem_flag_test(BM_edge_at_index(&bm, i), BM_ELEM_SELECT);
-    });
-  }
-  if (need_select_poly) {
-    write_fn_to_attribute<bool>(attributes, ".select_poly", ATTR_DOMAIN_FACE, [&](const int i) {
-      return BM_elem_flag_test(BM_face_at_index(&bm, i), BM_ELEM_SELECT);
-    });
-  }
-}
-
-void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
-{
-  using namespace blender;
-  BMVert *v, *eve;
-  BMEdge *e;
-  BMFace *f;
-  BMIter iter;
-  int i, j;
-
-  const int cd_shape_keyindex_offset = CustomData_get_offset(&bm->vdata, CD_SHAPE_KEYINDEX);
-
-  const int ototvert = me->totvert;
-
-  /* Free custom data. */
-  CustomData_free(&me->vdata, me->totvert);
-  CustomData_free(&me->edata, me->totedge);
-  CustomData_free(&me->fdata, me->totface);
-  CustomData_free(&me->ldata, me->totloop);
-  CustomData_free(&me->pdata, me->totpoly);
-
-  BKE_mesh_runtime_clear_geometry(me);
-
-  /* Add new custom data. */
-  me->totvert = bm->totvert;
-  me->totedge = bm->totedge;
-  me->totloop = bm->totloop;
-  me->totpoly = bm->totface;
-  /* Will be overwritten with a valid value if 'dotess' is set, otherwise we
-   * end up with 'me->totface' and `me->mface == nullptr` which can crash T28625. */
-  me->totface = 0;
-  me->act_face = -1;
-
-  /* Mark UV selection layers which are all false as 'nocopy'. */
-  for (const int layer_index :
-       IndexRange(CustomData_number_of_layers(&bm->ldata, CD_PROP_FLOAT2))) {
-    char const *layer_name = CustomData_get_layer_name(&bm->ldata, CD_PROP_FLOAT2, layer_index);
-    char sub_layer_name[MAX_CUSTOMDATA_LAYER_NAME];
-    int vertsel_layer_index = CustomData_get_named_layer_index(
-        &bm->ldata, CD_PROP_BOOL, BKE_uv_map_vert_select_name_get(layer_name, sub_layer_name));
-    int edgesel_layer_index = CustomData_get_named_layer_index(
-        &bm->ldata, CD_PROP_BOOL, BKE_uv_map_edge_select_name_get(layer_name, sub_layer_name));
-    int pin_layer_index = CustomData_get_named_layer_index(
-        &bm->ldata, CD_PROP_BOOL, BKE_uv_map_pin_name_get(layer_name, sub_layer_name));
-    int vertsel_offset = bm->ldata.layers[vertsel_layer_index].offset;
-    int edgesel_offset = bm->ldata.layers[edgesel_layer_index].offset;
-    int pin_offset = bm->ldata.layers[pin_layer_index].offset;
-    bool need_vertsel = false;
-    bool need_edgesel = false;
-    bool need_pin = false;
-
-    BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-      BMIter liter;
-      BMLoop *l;
-      BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
-        need_vertsel |= BM_ELEM_CD_GET_BOOL(l, vertsel_offset);
-        need_edgesel |= BM_ELEM_CD_GET_BOOL(l, edgesel_offset);
-        need_pin |= BM_ELEM_CD_GET_BOOL(l, pin_offset);
-      }
-    }
-
-    if (need_vertsel) {
-      bm->ldata.layers[vertsel_layer_index].flag &= ~CD_FLAG_NOCOPY;
-    }
-    else {
-      bm->ldata.layers[vertsel_layer_index].flag |= CD_FLAG_NOCOPY;
-    }
-    if (need_edgesel) {
-      bm->ldata.layers[edgesel_layer_index].flag &= ~CD_FLAG_NOCOPY;
-    }
-    else {
-      bm->ldata.layers[edgesel_layer_index].flag |= CD_FLAG_NOCOPY;
-    }
-    if (need_pin) {
-      bm->ldata.layers[pin_layer_index].flag &= ~CD_FLAG_NOCOPY;
-    }
-    else {
-      bm->ldata.layers[pin_layer_index].flag |= CD_FLAG_NOCOPY;
-    }
-  }
-
-  {
-    CustomData_MeshMasks mask = CD_MASK_MESH;
-    CustomData_MeshMasks_update(&mask, &params->cd_mask_extra);
-    CustomData_copy(&bm->vdata, &me->vdata, mask.vmask, CD_SET_DEFAULT, me->totvert);
-    CustomData_copy(&bm->edata, &me->edata, mask.emask, CD_SET_DEFAULT, me->totedge);
-    CustomData_copy(&bm->ldata, &me->ldata, mask.lmask, CD_SET_DEFAULT, me->totloop);
-    CustomData_copy(&bm->pdata, &me->pdata, mask.pmask, CD_SET_DEFAULT, me->totpoly);
-  }
-
-  CustomData_add_layer_named(
-      &me->vdata, CD_PROP_FLOAT3, CD_CONSTRUCT, nullptr, me->totvert, "position");
-  CustomData_add_layer(&me->edata, CD_MEDGE, CD_SET_DEFAULT, nullptr, me->totedge);
-  CustomData_add_layer(&me->ldata, CD_MLOOP, CD_SET_DEFAULT, nullptr, me->totloop);
-  CustomData_add_layer(&me->pdata, CD_MPOLY, CD_SET_DEFAULT, nullptr, me->totpoly);
-  MutableSpan<float3> positions = me->vert_positions_for_write();
-  MutableSpan<MEdge> medge = me->edges_for_write();
-  MutableSpan<MPoly> mpoly = me->polys_for_write();
-  MutableSpan<MLoop> mloop = me->loops_for_write();
-
-  bool need_select_vert = false;
-  bool need_select_edge = false;
-  bool need_select_poly = false;
-  bool need_hide_vert = false;
-  bool need_hide_edge = false;
-  bool need_hide_poly = false;
-  bool need_material_index = false;
-  bool need_sharp_edge = false;
-
-  i = 0;
-  BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-    copy_v3_v3(positions[i], v->co);
-
-    if (BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
-      need_hide_vert = true;
-    }
-    if (BM_elem_flag_test(v, BM_ELEM_SELECT)) {
-      need_select_vert = true;
-    }
-
-    BM_elem_index_set(v, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
-
-    i++;
-
-    BM_CHECK_ELEMENT(v);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
-
-  i = 0;
-  BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-    medge[i].v1 = BM_elem_index_get(e->v1);
-    medge[i].v2 = BM_elem_index_get(e->v2);
-
-    medge[i].flag = bm_edge_flag_to_mflag(e);
-    if (BM_elem_flag_test(e, BM_ELEM_HIDDEN)) {
-      need_hide_edge = true;
-    }
-    if (BM_elem_flag_test(e, BM_ELEM_SELECT)) {
-      need_select_edge = true;
-    }
-    if (!BM_elem_flag_test(e, BM_ELEM_SMOOTH)) {
-      need_sharp_edge = true;
-    }
-
-    BM_elem_index_set(e, i); /* set_inline */
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
-
-    i++;
-    BM_CHECK_ELEMENT(e);
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  i = 0;
-  j = 0;
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-    BMLoop *l_iter, *l_first;
-    mpoly[i].loopstart = j;
-    mpoly[i].totloop = f->len;
-    if (f->mat_nr != 0) {
-      need_material_index = true;
-    }
-    mpoly[i].flag = bm_face_flag_to_mflag(f);
-    if (BM_elem_flag_test(f, BM_ELEM_HIDDEN)) {
-      need_hide_poly = true;
-    }
-    if (BM_elem_flag_test(f, BM_ELEM_SELECT)) {
-      need_select_poly = true;
-    }
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      mloop[j].e = BM_elem_index_get(l_iter->e);
-      mloop[j].v = BM_elem_index_get(l_iter->v);
-
-      /* Copy over custom-data. */
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
-
-      j++;
-      BM_CHECK_ELEMENT(l_iter);
-      BM_CHECK_ELEMENT(l_iter->e);
-      BM_CHECK_ELEMENT(l_iter->v);
-    } while ((l_iter = l_iter->next) != l_first);
-
-    if (f == bm->act_face) {
-      me->act_face = i;
-    }
-
-    /* Copy over custom-data. */
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
-    i++;
-    BM_CHECK_ELEMENT(f);
-  }
-
-  if (need_material_index) {
-    BM_mesh_elem_table_ensure(bm, BM_FACE);
-    write_fn_to_attribute<int>(me->attributes_for_write(),
-                               "material_index",
-                               ATTR_DOMAIN_FACE,
-                               [&](const int i) { return int(BM_face_at_index(bm, i)->mat_nr); });
-  }
-  if (need_sharp_edge) {
-    BM_mesh_elem_table_ensure(bm, BM_EDGE);
-    write_fn_to_attribute<bool>(
-        me->attributes_for_write(), "sharp_edge", ATTR_DOMAIN_EDGE, [&](const int i) {
-          return !BM_elem_flag_test(BM_edge_at_index(bm, i), BM_ELEM_SMOOTH);
-        });
-  }
-
-  /* Patch hook indices and vertex parents. */
-  if (params->calc_object_remap && (ototvert > 0)) {
-    BLI_assert(bmain != nullptr);
-    BMVert **vertMap = nullptr;
-
-    LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
-      if ((ob->parent) && (ob->parent->data == me) && ELEM(ob->partype, PARVERT1, PARVERT3)) {
-
-        if (vertMap == nullptr) {
-          vertMap = bm_to_mesh_vertex_map(bm, ototvert);
-        }
-
-        if (ob->par1 < ototvert) {
-          eve = vertMap[ob->par1];
-          if (eve) {
-            ob->par1 = BM_elem_index_get(eve);
-          }
-        }
-        if (ob->par2 < ototvert) {
-          eve = vertMap[ob->par2];
-          if (eve) {
-            ob->par2 = BM_elem_index_get(eve);
-          }
-        }
-        if (ob->par3 < ototvert) {
-          eve = vertMap[ob->par3];
-          if (eve) {
-            ob->par3 = BM_elem_index_get(eve);
-          }
-        }
-      }
-      if (ob->data == me) {
-        LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
-          if (md->type == eModifierType_Hook) {
-            HookModifierData *hmd = (HookModifierData *)md;
-
-            if (vertMap == nullptr) {
-              vertMap = bm_to_mesh_vertex_map(bm, ototvert);
-            }
-
-            for (i = j = 0; i < hmd->indexar_num; i++) {
-              if (hmd->indexar[i] < ototvert) {
-                eve = vertMap[hmd->indexar[i]];
-
-                if (eve) {
-                  hmd->indexar[j++] = BM_elem_index_get(eve);
-                }
-              }
-              else {
-                j++;
-              }
-            }
-
-            hmd->indexar_num = j;
-          }
-        }
-      }
-    }
-
-    if (vertMap) {
-      MEM_freeN(vertMap);
-    }
-  }
-
-  convert_bmesh_hide_flags_to_mesh_attributes(
-      *bm, need_hide_vert, need_hide_edge, need_hide_poly, *me);
-  convert_bmesh_selection_flags_to_mesh_attributes(
-      *bm, need_select_vert, need_select_edge, need_select_poly, *me);
-
-  {
-    me->totselect = BLI_listbase_count(&(bm->selected));
-
-    MEM_SAFE_FREE(me->mselect);
-    if (me->totselect != 0) {
-      me->mselect = static_cast<MSelect *>(
-          MEM_mallocN(sizeof(MSelect) * me->totselect, "Mesh selection history"));
-    }
-
-    LISTBASE_FOREACH_INDEX (BMEditSelection *, selected, &bm->selected, i) {
-      if (selected->htype == BM_VERT) {
-        me->mselect[i].type = ME_VSEL;
-      }
-      else if (selected->htype == BM_EDGE) {
-        me->mselect[i].type = ME_ESEL;
-      }
-      else if (selected->htype == BM_FACE) {
-        me->mselect[i].type = ME_FSEL;
-      }
-
-      me->mselect[i].index = BM_elem_index_get(selected->ele);
-    }
-  }
-
-  if (me->key) {
-    bm_to_mesh_shape(bm, me->key, positions, params->active_shapekey_to_mvert);
-  }
-
-  /* Run this even when shape keys aren't used since it may be used for hooks or vertex parents. */
-  if (params->update_shapekey_indices) {
-    /* We have written a new shape key, if this mesh is _not_ going to be freed,
-     * update the shape key indices to match the newly updated. */
-    if (cd_shape_keyindex_offset != -1) {
-      BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, i) {
-        BM_ELEM_CD_SET_INT(eve, cd_shape_keyindex_offset, i);
-      }
-    }
-  }
-
-  /* Topology could be changed, ensure #CD_MDISPS are ok. */
-  multires_topology_changed(me);
-}
-
 namespace blender {
 
 static void bm_vert_table_build(BMesh &bm,
@@ -1336,6 +929,7 @@ static void bm_edge_table_build(BMesh &bm,
                                 bool &need_sharp_edge)
 {
   char hflag = 0;
+  char hflag_all = char(~0);
   BMIter iter;
   int i;
   BMEdge *edge;
@@ -1343,10 +937,11 @@ static void bm_edge_table_build(BMesh &bm,
     BM_elem_index_set(edge, i); /* set_inline */
     table[i] = edge;
     hflag |= edge->head.hflag;
+    hflag_all &= edge->head.hflag;
   }
   need_select_edge = (hflag & BM_ELEM_SELECT) != 0;
   need_hide_edge = (hflag & BM_ELEM_HIDDEN) != 0;
-  need_sharp_edge = (hflag & BM_ELEM_SMOOTH) != 0;
+  need_sharp_edge = (hflag_all & BM_ELEM_SMOOTH) == 0;
 }
 
 static void bm_face_loop_table_build(BMesh &bm,
@@ -1410,7 +1005,8 @@ static void bm_to_mesh_edges(const BMesh &bm,
                              Mesh &mesh,
                              MutableSpan<bool> select_edge,
                              MutableSpan<bool> hide_edge,
-                             MutableSpan<bool> sharp_edge)
+                             MutableSpan<bool> sharp_edge,
+                             const bool draw_boundary_edges)
 {
   MutableSpan<MEdge> dst_edges = mesh.edges_for_write();
   threading::parallel_for(dst_edges.index_range(), 512, [&](const IndexRange range) {
@@ -1423,7 +1019,7 @@ static void bm_to_mesh_edges(const BMesh &bm,
 
       /* Handle this differently to editmode switching; only enable draw for single user
        * edges rather than calculating angle. */
-      if ((dst_edge.flag & ME_EDGEDRAW) == 0) {
+      if (draw_boundary_edges && (dst_edge.flag & ME_EDGEDRAW) == 0) {
         if (src_edge.l && src_edge.l == src_edge.l->radial_next) {
           dst_edge.flag |= ME_EDGEDRAW;
         }
@@ -1485,61 +1081,25 @@ static void bm_to_mesh_faces(const BMesh &bm,
 }
 
 static void bm_to_mesh_loops(const BMesh &bm, const Span<const BMLoop *> bm_loops, Mesh &mesh)
-{
-  MutableSpan<MLoop> dst_loops = mesh.loops_for_write();
-  threading::parallel_for(dst_loops.index_range(), 1024, [&](const IndexRange range) {
-    for (const int loop_i : range) {
-      const BMLoop &src_loop = *bm_loops[loop_i];
-      MLoop &dst_loop = dst_loops[loop_i];
-      dst_loop.v = BM_elem_index_get(src_loop.v);
-      dst_loop.e = BM_elem_index_get(src_loop.e);
-      CustomData_from_bmesh_block(&bm.ldata, &mesh.ldata, src_loop.head.data, loop_i);
-    }
-  });
-}
-
-}  // namespace blender
-
-/* NOTE: The function is called from multiple threads with the same input BMesh and different
- * mesh objects. */
-void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *cd_mask_extra)
-{
-  using namespace blender;
-
-  /* Must be an empty mesh. */
-  BLI_assert(me->totvert == 0);
-  BLI_assert(cd_mask_extra == nullptr || (cd_mask_extra->vmask & CD_MASK_SHAPEKEY) == 0);
-  /* Just in case, clear the derived geometry caches from the input mesh. */
-  BKE_mesh_runtime_clear_geometry(me);
-
-  me->totvert = bm->totvert;
-  me->totedge = bm->totedge;
-  me->totface = 0;
-  me->totloop = bm->totloop;
-  me->totpoly = bm->totface;
-
-  if (!CustomData_get_layer_named(&me->vdata, CD_PROP_FLOAT3, "position")) {
-    CustomData_add_layer_named(
-        &me->vdata, CD_PROP_FLOAT3, CD_CONSTRUCT, nullptr, bm->totvert, "position");
-  }
-  CustomData_add_layer(&me->edata, CD_MEDGE, CD_CONSTRUCT, nullptr, bm->totedge);
-  CustomData_add_layer(&me->ldata, CD_MLOOP, CD_CONSTRUCT, nullptr, bm->totloop);
-  CustomData_add_layer(&me->pdata, CD_MPOLY, CD_CONSTRUCT, nullptr, bm->totface);
-
-  /* Don't process shape-keys, we only feed them through the modifier stack as needed,
-   * e.g. for applying modifiers or the like. */
-  CustomData_MeshMasks mask = CD_MASK_DERIVEDMESH;
-  if (cd_mask_extra != nullptr) {
-    CustomData_MeshMasks_update(&mask, cd_mask_extra);
-  }
-  mask.vmask &= ~CD_MASK_SHAPEKEY;
-  CustomData_merge(&bm->vdata, &me->vdata, mask.vmask, CD_CONSTRUCT, me->totvert);
-  CustomData_merge(&bm->edata, &me->edata, mask.emask, CD_CONSTRUCT, me->totedge);
-  CustomData_merge(&bm->ldata, &me->ldata, mask.lmask, CD_CONSTRUCT, me->totloop);
-  CustomData_merge(&bm->pdata, &me->pdata, mask.pmask, CD_CONSTRUCT, me->totpoly);
-
-  me->runtime->deformed_only = true;
+{
+  MutableSpan<MLoop> dst_loops = mesh.loops_for_write();
+  threading::parallel_for(dst_loops.index_range(), 1024, [&](const IndexRange range) {
+    for (const int loop_i : range) {
+      const BMLoop &src_loop = *bm_loops[loop_i];
+      MLoop &dst_loop = dst_loops[loop_i];
+      dst_loop.v = BM_elem_index_get(src_loop.v);
+      dst_loop.e = BM_elem_index_get(src_loop.e);
+      CustomData_from_bmesh_block(&bm.ldata, &mesh.ldata, src_loop.head.data, loop_i);
+    }
+  });
+}
 
+/**
+ * Copy all elements of \a bm to \a mesh, which must already have the topology arrays and the
+ * custom data layers allocated. The element indices of \a bm are updated to match \a mesh.
+ */
+static void bm_to_mesh_elements(BMesh &bm, Mesh &mesh, const bool draw_boundary_edges)
+{
   /* In a first pass, update indices of BMesh elements and build tables for easy iteration later.
    * Also check if some optional mesh attributes should be added in the next step. Since each
    * domain has no effect on others, process the independent domains on separate threads. */
@@ -1556,26 +1116,26 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
   Array<const BMFace *> face_table;
   Array<const BMLoop *> loop_table;
   threading::parallel_invoke(
-      me->totface > 1024,
+      mesh.totpoly > 1024,
       [&]() {
-        vert_table.reinitialize(bm->totvert);
-        bm_vert_table_build(*bm, vert_table, need_select_vert, need_hide_vert);
+        vert_table.reinitialize(bm.totvert);
+        bm_vert_table_build(bm, vert_table, need_select_vert, need_hide_vert);
       },
       [&]() {
-        edge_table.reinitialize(bm->totedge);
-        bm_edge_table_build(*bm, edge_table, need_select_edge, need_hide_edge, need_sharp_edge);
+        edge_table.reinitialize(bm.totedge);
+        bm_edge_table_build(bm, edge_table, need_select_edge, need_hide_edge, need_sharp_edge);
       },
       [&]() {
-        face_table.reinitialize(bm->totface);
-        loop_table.reinitialize(bm->totloop);
+        face_table.reinitialize(bm.totface);
+        loop_table.reinitialize(bm.totloop);
         bm_face_loop_table_build(
-            *bm, face_table, loop_table, need_select_poly, need_hide_poly, need_material_index);
+            bm, face_table, loop_table, need_select_poly, need_hide_poly, need_material_index);
       });
-  bm->elem_index_dirty &= ~(BM_VERT | BM_EDGE | BM_FACE | BM_LOOP);
+  bm.elem_index_dirty &= ~(BM_VERT | BM_EDGE | BM_FACE | BM_LOOP);
 
   /* Add optional mesh attributes before parallel iteration. */
-  assert_bmesh_has_no_mesh_only_attributes(*bm);
-  bke::MutableAttributeAccessor attrs = me->attributes_for_write();
+  assert_bmesh_has_no_mesh_only_attributes(bm);
+  bke::MutableAttributeAccessor attrs = mesh.attributes_for_write();
   bke::SpanAttributeWriter<bool> select_vert;
   bke::SpanAttributeWriter<bool> hide_vert;
   bke::SpanAttributeWriter<bool> select_edge;
@@ -1612,16 +1172,22 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
 
   /* Loop over all elements in parallel, copying attributes and building the Mesh topology. */
   threading::parallel_invoke(
-      me->totvert > 1024,
-      [&]() { bm_to_mesh_verts(*bm, vert_table, *me, select_vert.span, hide_vert.span); },
+      mesh.totvert > 1024,
+      [&]() { bm_to_mesh_verts(bm, vert_table, mesh, select_vert.span, hide_vert.span); },
       [&]() {
-        bm_to_mesh_edges(*bm, edge_table, *me, select_edge.span, hide_edge.span, sharp_edge.span);
+        bm_to_mesh_edges(bm,
+                         edge_table,
+                         mesh,
+                         select_edge.span,
+                         hide_edge.span,
+                         sharp_edge.span,
+                         draw_boundary_edges);
       },
       [&]() {
         bm_to_mesh_faces(
-            *bm, face_table, *me, select_poly.span, hide_poly.span, material_index.span);
+            bm, face_table, mesh, select_poly.span, hide_poly.span, material_index.span);
       },
-      [&]() { bm_to_mesh_loops(*bm, loop_table, *me); });
+      [&]() { bm_to_mesh_loops(bm, loop_table, mesh); });
 
   select_vert.finish();
   hide_vert.finish();
@@ -1632,3 +1198,274 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
   hide_poly.finish();
   material_index.finish();
 }
+
+/**
+ * \return True if the boolean loop attribute at \a cd_offset is true for any loop of \a bm.
+ */
+static bool bm_loop_attribute_bool_any(BMesh &bm, const int cd_offset)
+{
+  BM_mesh_elem_table_ensure(&bm, BM_FACE);
+  return threading::parallel_reduce(
+      IndexRange(bm.totface),
+      1024,
+      false,
+      [&](const IndexRange range, const bool init) {
+        if (init) {
+          return true;
+        }
+        for (const int face_i : range) {
+          const BMFace *face = BM_face_at_index(&bm, face_i);
+          const BMLoop *loop = BM_FACE_FIRST_LOOP(face);
+          for ([[maybe_unused]] const int i : IndexRange(face->len)) {
+            if (BM_ELEM_CD_GET_BOOL(loop, cd_offset)) {
+              return true;
+            }
+            loop = loop->next;
+          }
+        }
+        return false;
+      },
+      [](const bool a, const bool b) { return a || b; });
+}
+
+}  // namespace blender
+
+void BM_mesh_bm_to_me(Main *bmain, BMesh *bm, Mesh *me, const struct BMeshToMeshParams *params)
+{
+  using namespace blender;
+  BMVert *eve;
+  BMIter iter;
+  int i, j;
+
+  const int cd_shape_keyindex_offset = CustomData_get_offset(&bm->vdata, CD_SHAPE_KEYINDEX);
+
+  const int ototvert = me->totvert;
+
+  /* Free custom data. */
+  CustomData_free(&me->vdata, me->totvert);
+  CustomData_free(&me->edata, me->totedge);
+  CustomData_free(&me->fdata, me->totface);
+  CustomData_free(&me->ldata, me->totloop);
+  CustomData_free(&me->pdata, me->totpoly);
+
+  BKE_mesh_runtime_clear_geometry(me);
+
+  /* Add new custom data. */
+  me->totvert = bm->totvert;
+  me->totedge = bm->totedge;
+  me->totloop = bm->totloop;
+  me->totpoly = bm->totface;
+  /* Will be overwritten with a valid value if 'dotess' is set, otherwise we
+   * end up with 'me->totface' and `me->mface == nullptr` which can crash T28625. */
+  me->totface = 0;
+  me->act_face = -1;
+
+  /* Mark UV selection layers which are all false as 'nocopy'. */
+  for (const int layer_index :
+       IndexRange(CustomData_number_of_layers(&bm->ldata, CD_PROP_FLOAT2))) {
+    char const *layer_name = CustomData_get_layer_name(&bm->ldata, CD_PROP_FLOAT2, layer_index);
+    char sub_layer_name[MAX_CUSTOMDATA_LAYER_NAME];
+    int vertsel_layer_index = CustomData_get_named_layer_index(
+        &bm->ldata, CD_PROP_BOOL, BKE_uv_map_vert_select_name_get(layer_name, sub_layer_name));
+    int edgesel_layer_index = CustomData_get_named_layer_index(
+        &bm->ldata, CD_PROP_BOOL, BKE_uv_map_edge_select_name_get(layer_name, sub_layer_name));
+    int pin_layer_index = CustomData_get_named_layer_index(
+        &bm->ldata, CD_PROP_BOOL, BKE_uv_map_pin_name_get(layer_name, sub_layer_name));
+    const bool need_vertsel = bm_loop_attribute_bool_any(
+        *bm, bm->ldata.layers[vertsel_layer_index].offset);
+    const bool need_edgesel = bm_loop_attribute_bool_any(
+        *bm, bm->ldata.layers[edgesel_layer_index].offset);
+    const bool need_pin = bm_loop_attribute_bool_any(*bm,
+                                                     bm->ldata.layers[pin_layer_index].offset);
+
+    if (need_vertsel) {
+      bm->ldata.layers[vertsel_layer_index].flag &= ~CD_FLAG_NOCOPY;
+    }
+    else {
+      bm->ldata.layers[vertsel_layer_index].flag |= CD_FLAG_NOCOPY;
+    }
+    if (need_edgesel) {
+      bm->ldata.layers[edgesel_layer_index].flag &= ~CD_FLAG_NOCOPY;
+    }
+    else {
+      bm->ldata.layers[edgesel_layer_index].flag |= CD_FLAG_NOCOPY;
+    }
+    if (need_pin) {
+      bm->ldata.layers[pin_layer_index].flag &= ~CD_FLAG_NOCOPY;
+    }
+    else {
+      bm->ldata.layers[pin_layer_index].flag |= CD_FLAG_NOCOPY;
+    }
+  }
+
+  {
+    CustomData_MeshMasks mask = CD_MASK_MESH;
+    CustomData_MeshMasks_update(&mask, &params->cd_mask_extra);
+    CustomData_copy(&bm->vdata, &me->vdata, mask.vmask, CD_SET_DEFAULT, me->totvert);
+    CustomData_copy(&bm->edata, &me->edata, mask.emask, CD_SET_DEFAULT, me->totedge);
+    CustomData_copy(&bm->ldata, &me->ldata, mask.lmask, CD_SET_DEFAULT, me->totloop);
+    CustomData_copy(&bm->pdata, &me->pdata, mask.pmask, CD_SET_DEFAULT, me->totpoly);
+  }
+
+  CustomData_add_layer_named(
+      &me->vdata, CD_PROP_FLOAT3, CD_CONSTRUCT, nullptr, me->totvert, "position");
+  CustomData_add_layer(&me->edata, CD_MEDGE, CD_SET_DEFAULT, nullptr, me->totedge);
+  CustomData_add_layer(&me->ldata, CD_MLOOP, CD_SET_DEFAULT, nullptr, me->totloop);
+  CustomData_add_layer(&me->pdata, CD_MPOLY, CD_SET_DEFAULT, nullptr, me->totpoly);
+
+  bm_to_mesh_elements(*bm, *me, false);
+
+  if (bm->act_face) {
+    me->act_face = BM_elem_index_get(bm->act_face);
+  }
+
+  /* Patch hook indices and vertex parents. */
+  if (params->calc_object_remap && (ototvert > 0)) {
+    BLI_assert(bmain != nullptr);
+    BMVert **vertMap = nullptr;
+
+    LISTBASE_FOREACH (Object *, ob, &bmain->objects) {
+      if ((ob->parent) && (ob->parent->data == me) && ELEM(ob->partype, PARVERT1, PARVERT3)) {
+
+        if (vertMap == nullptr) {
+          vertMap = bm_to_mesh_vertex_map(bm, ototvert);
+        }
+
+        if (ob->par1 < ototvert) {
+          eve = vertMap[ob->par1];
+          if (eve) {
+            ob->par1 = BM_elem_index_get(eve);
+          }
+        }
+        if (ob->par2 < ototvert) {
+          eve = vertMap[ob->par2];
+          if (eve) {
+            ob->par2 = BM_elem_index_get(eve);
+          }
+        }
+        if (ob->par3 < ototvert) {
+          eve = vertMap[ob->par3];
+          if (eve) {
+            ob->par3 = BM_elem_index_get(eve);
+          }
+        }
+      }
+      if (ob->data == me) {
+        LISTBASE_FOREACH (ModifierData *, md, &ob->modifiers) {
+          if (md->type == eModifierType_Hook) {
+            HookModifierData *hmd = (HookModifierData *)md;
+
+            if (vertMap == nullptr) {
+              vertMap = bm_to_mesh_vertex_map(bm, ototvert);
+            }
+
+            for (i = j = 0; i < hmd->indexar_num; i++) {
+              if (hmd->indexar[i] < ototvert) {
+                eve = vertMap[hmd->indexar[i]];
+
+                if (eve) {
+                  hmd->indexar[j++] = BM_elem_index_get(eve);
+                }
+              }
+              else {
+                j++;
+              }
+            }
+
+            hmd->indexar_num = j;
+          }
+        }
+      }
+    }
+
+    if (vertMap) {
+      MEM_freeN(vertMap);
+    }
+  }
+
+  {
+    me->totselect = BLI_listbase_count(&(bm->selected));
+
+    MEM_SAFE_FREE(me->mselect);
+    if (me->totselect != 0) {
+      me->mselect = static_cast<MSelect *>(
+          MEM_mallocN(sizeof(MSelect) * me->totselect, "Mesh selection history"));
+    }
+
+    LISTBASE_FOREACH_INDEX (BMEditSelection *, selected, &bm->selected, i) {
+      if (selected->htype == BM_VERT) {
+        me->mselect[i].type = ME_VSEL;
+      }
+      else if (selected->htype == BM_EDGE) {
+        me->mselect[i].type = ME_ESEL;
+      }
+      else if (selected->htype == BM_FACE) {
+        me->mselect[i].type = ME_FSEL;
+      }
+
+      me->mselect[i].index = BM_elem_index_get(selected->ele);
+    }
+  }
+
+  if (me->key) {
+    bm_to_mesh_shape(
+        bm, me->key, me->vert_positions_for_write(), params->active_shapekey_to_mvert);
+  }
+
+  /* Run this even when shape keys aren't used since it may be used for hooks or vertex parents. */
+  if (params->update_shapekey_indices) {
+    /* We have written a new shape key, if this mesh is _not_ going to be freed,
+     * update the shape key indices to match the newly updated. */
+    if (cd_shape_keyindex_offset != -1) {
+      BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, i) {
+        BM_ELEM_CD_SET_INT(eve, cd_shape_keyindex_offset, i);
+      }
+    }
+  }
+
+  /* Topology could be changed, ensure #CD_MDISPS are ok. */
+  multires_topology_changed(me);
+}
+
+/* NOTE: The function is called from multiple threads with the same input BMesh and different
+ * mesh objects. */
+void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *cd_mask_extra)
+{
+  using namespace blender;
+
+  /* Must be an empty mesh. */
+  BLI_assert(me->totvert == 0);
+  BLI_assert(cd_mask_extra == nullptr || (cd_mask_extra->vmask & CD_MASK_SHAPEKEY) == 0);
+  /* Just in case, clear the derived geometry caches from the input mesh. */
+  BKE_mesh_runtime_clear_geometry(me);
+
+  me->totvert = bm->totvert;
+  me->totedge = bm->totedge;
+  me->totface = 0;
+  me->totloop = bm->totloop;
+  me->totpoly = bm->totface;
+
+  if (!CustomData_get_layer_named(&me->vdata, CD_PROP_FLOAT3, "position")) {
+    CustomData_add_layer_named(
+        &me->vdata, CD_PROP_FLOAT3, CD_CONSTRUCT, nullptr, bm->totvert, "position");
+  }
+  CustomData_add_layer(&me->edata, CD_MEDGE, CD_CONSTRUCT, nullptr, bm->totedge);
+  CustomData_add_layer(&me->ldata, CD_MLOOP, CD_CONSTRUCT, nullptr, bm->totloop);
+  CustomData_add_layer(&me->pdata, CD_MPOLY, CD_CONSTRUCT, nullptr, bm->totface);
+
+  /* Don't process shape-keys, we only feed them through the modifier stack as needed,
+   * e.g. for applying modifiers or the like. */
+  CustomData_MeshMasks mask = CD_MASK_DERIVEDMESH;
+  if (cd_mask_extra != nullptr) {
+    CustomData_MeshMasks_update(&mask, cd_mask_extra);
+  }
+  mask.vmask &= ~CD_MASK_SHAPEKEY;
+  CustomData_merge(&bm->vdata, &me->vdata, mask.vmask, CD_CONSTRUCT, me->totvert);
+  CustomData_merge(&bm->edata, &me->edata, mask.emask, CD_CONSTRUCT, me->totedge);
+  CustomData_merge(&bm->ldata, &me->ldata, mask.lmask, CD_CONSTRUCT, me->totloop);
+  CustomData_merge(&bm->pdata, &me->pdata, mask.pmask, CD_CONSTRUCT, me->totpoly);
+
+  me->runtime->deformed_only = true;
+
+  bm_to_mesh_elements(*bm, *me, true);
+}
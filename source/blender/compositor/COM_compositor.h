@@ -325,6 +325,12 @@ extern "C" {
  */
 /* clang-format off */
 
+/**
+ * Number of frames after the current one that are loaded ahead of time from animated inputs while
+ * rendering, see #blender::compositor::InputPrefetcher.
+ */
+#define COM_PREFETCH_FRAMES 4
+
 void COM_execute(RenderData *render_data,
                  Scene *scene,
                  bNodeTree *node_tree,
@@ -0,0 +1,195 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "BLI_hash_mm2a.h"
+#include "BLI_listbase.h"
+#include "BLI_rect.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_node.h"
+
+#include "DNA_node_types.h"
+
+#include "COM_CachedOperationBuffers.h"
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor {
+
+/**
+ * Size of the storage of the nodes that support caching. Their storage must not contain pointers,
+ * because it is hashed by its bytes.
+ */
+static size_t node_storage_size(const bNode &node)
+{
+  switch (node.type) {
+    case CMP_NODE_BLUR:
+    case CMP_NODE_VECBLUR:
+      return sizeof(NodeBlurData);
+    case CMP_NODE_DBLUR:
+      return sizeof(NodeDBlurData);
+    case CMP_NODE_BILATERALBLUR:
+      return sizeof(NodeBilateralBlurData);
+    case CMP_NODE_DILATEERODE:
+      return sizeof(NodeDilateErode);
+    case CMP_NODE_GLARE:
+      return sizeof(NodeGlare);
+    case CMP_NODE_SUNBEAMS:
+      return sizeof(NodeSunBeams);
+    case CMP_NODE_ANTIALIASING:
+      return sizeof(NodeAntiAliasingData);
+    case CMP_NODE_DENOISE:
+      return sizeof(NodeDenoise);
+    default:
+      return 0;
+  }
+}
+
+static uint64_t hash_bytes(const void *data, const size_t size)
+{
+  const uchar *bytes = static_cast<const uchar *>(data);
+  return (uint64_t(BLI_hash_mm2(bytes, size, 0)) << 32) | BLI_hash_mm2(bytes, size, 1);
+}
+
+bool CachedOperationBuffers::node_supports_caching(const bNode &node)
+{
+  if (node.id != nullptr) {
+    return false;
+  }
+  switch (node.type) {
+    case CMP_NODE_BLUR:
+    case CMP_NODE_VECBLUR:
+    case CMP_NODE_DBLUR:
+    case CMP_NODE_BILATERALBLUR:
+    case CMP_NODE_BOKEHBLUR:
+    case CMP_NODE_DILATEERODE:
+    case CMP_NODE_DOUBLEEDGEMASK:
+    case CMP_NODE_INPAINT:
+    case CMP_NODE_DESPECKLE:
+    case CMP_NODE_GLARE:
+    case CMP_NODE_SUNBEAMS:
+    case CMP_NODE_ANTIALIASING:
+    case CMP_NODE_DENOISE:
+      return node.storage != nullptr || node_storage_size(node) == 0;
+    default:
+      return false;
+  }
+}
+
+uint64_t CachedOperationBuffers::hash_node(const bNode &node)
+{
+  BLI_assert(node_supports_caching(node));
+
+  Vector<uint64_t> data;
+  data.append(uint64_t(node.type));
+  data.append(uint64_t(node.flag & NODE_MUTED));
+  data.append(uint64_t(uint16_t(node.custom1)) | (uint64_t(uint16_t(node.custom2)) << 16));
+  data.append(hash_bytes(&node.custom3, sizeof(node.custom3)));
+  data.append(hash_bytes(&node.custom4, sizeof(node.custom4)));
+  if (const size_t storage_size = node_storage_size(node)) {
+    data.append(hash_bytes(node.storage, storage_size));
+  }
+
+  /* Unlinked inputs are usually converted to constant operations, which are hashed by their
+   * content, but converters may also read the socket values directly. */
+  LISTBASE_FOREACH (const bNodeSocket *, socket, &node.inputs) {
+    const bool is_linked = socket->link != nullptr;
+    data.append(uint64_t(is_linked));
+    if (is_linked || socket->default_value == nullptr) {
+      continue;
+    }
+    switch (socket->type) {
+      case SOCK_FLOAT:
+        data.append(hash_bytes(socket->default_value, sizeof(bNodeSocketValueFloat)));
+        break;
+      case SOCK_INT:
+        data.append(hash_bytes(socket->default_value, sizeof(bNodeSocketValueInt)));
+        break;
+      case SOCK_BOOLEAN:
+        data.append(hash_bytes(socket->default_value, sizeof(bNodeSocketValueBoolean)));
+        break;
+      case SOCK_VECTOR:
+        data.append(hash_bytes(socket->default_value, sizeof(bNodeSocketValueVector)));
+        break;
+      case SOCK_RGBA:
+        data.append(hash_bytes(socket->default_value, sizeof(bNodeSocketValueRGBA)));
+        break;
+      default:
+        break;
+    }
+  }
+  return hash_key(data);
+}
+
+uint64_t CachedOperationBuffers::hash_key(Span<uint64_t> data)
+{
+  return hash_bytes(data.data(), data.size() * sizeof(uint64_t));
+}
+
+uint64_t CachedOperationBuffers::hash_buffer_areas(const MemoryBuffer &buffer, Span<rcti> areas)
+{
+  if (buffer.is_a_single_elem()) {
+    const rcti &rect = buffer.get_rect();
+    return hash_bytes(buffer.get_elem(rect.xmin, rect.ymin),
+                      buffer.get_num_channels() * sizeof(float));
+  }
+
+  /* Hash rows in parallel, the content of large buffers is hashed on every execution. */
+  Vector<uint64_t> data;
+  for (const rcti &area : areas) {
+    data.append(hash_bytes(&area, sizeof(area)));
+    if (BLI_rcti_is_empty(&area)) {
+      continue;
+    }
+    const int64_t start = data.size();
+    const int height = BLI_rcti_size_y(&area);
+    const size_t row_size = size_t(BLI_rcti_size_x(&area)) * buffer.elem_stride * sizeof(float);
+    data.resize(start + height);
+    threading::parallel_for(IndexRange(height), 16, [&](const IndexRange rows) {
+      for (const int64_t y : rows) {
+        const float *row = buffer.get_elem(area.xmin, area.ymin + int(y));
+        data[start + y] = hash_bytes(row, row_size);
+      }
+    });
+  }
+  return hash_key(data);
+}
+
+void CachedOperationBuffers::begin_execution()
+{
+  for (Entry &entry : entries_.values()) {
+    entry.is_used = false;
+  }
+}
+
+void CachedOperationBuffers::end_execution()
+{
+  entries_.remove_if([](const auto &item) { return !item.value.is_used; });
+}
+
+void CachedOperationBuffers::clear()
+{
+  entries_.clear();
+}
+
+const CachedOperationBuffers::Entry *CachedOperationBuffers::lookup(const uint64_t key)
+{
+  Entry *entry = entries_.lookup_ptr(key);
+  if (entry) {
+    entry->is_used = true;
+  }
+  return entry;
+}
+
+void CachedOperationBuffers::add(const uint64_t key,
+                                 const MemoryBuffer &buffer,
+                                 const uint64_t content_hash)
+{
+  Entry entry;
+  entry.buffer = std::make_unique<MemoryBuffer>(buffer);
+  entry.content_hash = content_hash;
+  entry.is_used = true;
+  entries_.add_overwrite(key, std::move(entry));
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+
+#include "DNA_vec_types.h"
+
+#include "COM_MemoryBuffer.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+struct bNode;
+
+namespace blender::compositor {
+
+/**
+ * Keeps rendered buffers of expensive operations across compositor executions, so that editing a
+ * node only re-executes the expensive operations that are affected by the change.
+ *
+ * An entry is identified by a key that combines the properties of the node the operation was
+ * created from with the content of the input buffers the operation read. Inputs are hashed by
+ * content rather than tracking changes of upstream nodes, so anything that modifies an input
+ * (editing an upstream node, a new render result, a reloaded image) results in a different key.
+ *
+ * Only nodes that are known to depend on nothing but their inputs and their properties are
+ * cached, see #CachedOperationBuffers::node_supports_caching.
+ */
+class CachedOperationBuffers {
+ public:
+  struct Entry {
+    std::unique_ptr<MemoryBuffer> buffer;
+    /** Hash of the buffer content, so it doesn't need to be hashed again when it is read. */
+    uint64_t content_hash;
+    bool is_used;
+  };
+
+ private:
+  Map<uint64_t, Entry> entries_;
+
+ public:
+  /**
+   * True for nodes whose outputs only depend on their inputs, their properties and the compositor
+   * context and that are usually expensive enough to make caching worth it.
+   */
+  static bool node_supports_caching(const bNode &node);
+  /**
+   * Hash of all node data that can affect the operations created from it: type, custom
+   * properties, storage and the values and links of its input sockets.
+   */
+  static uint64_t hash_node(const bNode &node);
+  /** Combines the given hashes into a cache key. */
+  static uint64_t hash_key(Span<uint64_t> data);
+  /**
+   * Hash of the content of the given buffer areas. Areas are in buffer coordinates.
+   */
+  static uint64_t hash_buffer_areas(const MemoryBuffer &buffer, Span<rcti> areas);
+
+  /** Has to be called before executing the node tree. */
+  void begin_execution();
+  /** Frees the entries that were not used since #begin_execution. */
+  void end_execution();
+  void clear();
+
+  /** Returns the entry with the given key and marks it as used, null if there is none. */
+  const Entry *lookup(uint64_t key);
+  /** Stores a copy of the given buffer. */
+  void add(uint64_t key, const MemoryBuffer &buffer, uint64_t content_hash);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:CachedOperationBuffers")
+#endif
+};
+
+}  // namespace blender::compositor
@@ -23,7 +23,8 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bNodeTree *editingtree,
                                  bool rendering,
                                  bool fastcalculation,
-                                 const char *view_name)
+                                 const char *view_name,
+                                 CachedOperationBuffers *cached_buffers)
 {
   num_work_threads_ = WorkScheduler::get_num_cpu_threads();
   context_.set_view_name(view_name);
@@ -57,7 +58,8 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
       execution_model_ = new TiledExecutionModel(context_, operations_, groups_);
       break;
     case eExecutionModel::FullFrame:
-      execution_model_ = new FullFrameExecutionModel(context_, active_buffers_, operations_);
+      execution_model_ = new FullFrameExecutionModel(
+          context_, active_buffers_, cached_buffers, operations_);
       break;
     default:
       BLI_assert_msg(0, "Non implemented execution model");
@@ -104,6 +104,7 @@ namespace blender::compositor {
  */
 
 /* Forward declarations. */
+class CachedOperationBuffers;
 class ExecutionGroup;
 class ExecutionModel;
 class NodeOperation;
@@ -154,13 +155,15 @@ class ExecutionSystem {
    *
    * \param editingtree: [bNodeTree *]
    * \param rendering: [true false]
+   * \param cached_buffers: Buffers kept across executions, null to disable caching.
    */
   ExecutionSystem(RenderData *rd,
                   Scene *scene,
                   bNodeTree *editingtree,
                   bool rendering,
                   bool fastcalculation,
-                  const char *view_name);
+                  const char *view_name,
+                  CachedOperationBuffers *cached_buffers = nullptr);
 
   /**
    * Destructor
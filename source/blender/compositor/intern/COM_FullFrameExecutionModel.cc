@@ -3,8 +3,16 @@
 
 #include "COM_FullFrameExecutionModel.h"
 
+#include <typeinfo>
+
+#include "BLI_hash.hh"
+#include "BLI_set.hh"
+
 #include "BLT_translation.h"
 
+#include "PIL_time.h"
+
+#include "COM_CachedOperationBuffers.h"
 #include "COM_Debug.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
@@ -15,13 +23,30 @@
 
 namespace blender::compositor {
 
+/**
+ * Operations that render faster than this are not cached, rendering them again is cheaper than
+ * keeping a copy of their buffer.
+ */
+static constexpr double CACHE_MIN_RENDER_TIME = 0.01;
+
 FullFrameExecutionModel::FullFrameExecutionModel(CompositorContext &context,
                                                  SharedOperationBuffers &shared_buffers,
+                                                 CachedOperationBuffers *cached_buffers,
                                                  Span<NodeOperation *> operations)
     : ExecutionModel(context, operations),
       active_buffers_(shared_buffers),
+      cached_buffers_(cached_buffers),
       num_operations_finished_(0)
 {
+  const Size2f render_size = context.get_render_size();
+  const char *view_name = context.get_view_name();
+  context_hash_ = CachedOperationBuffers::hash_key(
+      {uint64_t(context.get_quality()),
+       uint64_t(context.is_rendering()),
+       uint64_t(context.is_fast_calculation()),
+       get_default_hash_2(render_size.x, render_size.y),
+       view_name ? get_default_hash(StringRef(view_name)) : 0});
+
   priorities_.append(eCompositorPriority::High);
   if (!context.is_fast_calculation()) {
     priorities_.append(eCompositorPriority::Medium);
@@ -92,15 +117,65 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
 }
 
+std::optional<uint64_t> FullFrameExecutionModel::get_cache_key(NodeOperation *op)
+{
+  const std::optional<uint64_t> &params_hash = op->get_cache_params_hash();
+  if (cached_buffers_ == nullptr || !params_hash || op->get_number_of_output_sockets() == 0 ||
+      op->is_output_operation(context_.is_rendering())) {
+    return std::nullopt;
+  }
+
+  Vector<uint64_t> data;
+  data.append(*params_hash);
+  data.append(context_hash_);
+  data.append(typeid(*op).hash_code());
+  data.append(uint64_t(op->get_output_socket()->get_data_type()));
+  const rcti &canvas = op->get_canvas();
+  data.append(get_default_hash_4(canvas.xmin, canvas.xmax, canvas.ymin, canvas.ymax));
+  for (const rcti &area : active_buffers_.get_areas_to_render(op, -canvas.xmin, -canvas.ymin)) {
+    data.append(get_default_hash_4(area.xmin, area.xmax, area.ymin, area.ymax));
+  }
+  for (const int i : IndexRange(op->get_number_of_input_sockets())) {
+    NodeOperation *input = op->get_input_operation(i);
+    const rcti &input_canvas = input->get_canvas();
+    data.append(get_default_hash_4(
+        input_canvas.xmin, input_canvas.xmax, input_canvas.ymin, input_canvas.ymax));
+    data.append(get_content_hash(input));
+  }
+  return CachedOperationBuffers::hash_key(data);
+}
+
+uint64_t FullFrameExecutionModel::get_content_hash(NodeOperation *op)
+{
+  return content_hashes_.lookup_or_add_cb(op, [&]() {
+    const rcti &canvas = op->get_canvas();
+    return CachedOperationBuffers::hash_buffer_areas(
+        *active_buffers_.get_rendered_buffer(op),
+        active_buffers_.get_areas_to_render(op, -canvas.xmin, -canvas.ymin));
+  });
+}
+
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
   /* Output has no offset for easier image algorithms implementation on operations. */
   constexpr int output_x = 0;
   constexpr int output_y = 0;
 
+  const bool has_size = op->get_width() > 0 && op->get_height() > 0;
+  const std::optional<uint64_t> cache_key = has_size ? get_cache_key(op) : std::nullopt;
+  if (cache_key) {
+    if (const CachedOperationBuffers::Entry *entry = cached_buffers_->lookup(*cache_key)) {
+      content_hashes_.add(op, entry->content_hash);
+      active_buffers_.set_rendered_buffer(op, std::make_unique<MemoryBuffer>(*entry->buffer));
+      operation_finished(op);
+      return;
+    }
+  }
+
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
   MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
-  if (op->get_width() > 0 && op->get_height() > 0) {
+  if (has_size) {
+    const double start_time = PIL_check_seconds_timer();
     Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
     const int op_offset_x = output_x - op->get_canvas().xmin;
     const int op_offset_y = output_y - op->get_canvas().ymin;
@@ -111,6 +186,14 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
     for (MemoryBuffer *buf : input_bufs) {
       delete buf;
     }
+
+    /* Don't cache buffers of cancelled executions, they may be incomplete. */
+    const double render_time = PIL_check_seconds_timer() - start_time;
+    if (cache_key && render_time >= CACHE_MIN_RENDER_TIME && !op->is_braked()) {
+      const uint64_t content_hash = CachedOperationBuffers::hash_buffer_areas(*op_buf, areas);
+      content_hashes_.add(op, content_hash);
+      cached_buffers_->add(*cache_key, *op_buf, content_hash);
+    }
   }
   /* Even if operation has no resolution set the empty buffer. It will be clipped with a
    * TranslateOperation from convert resolutions if linked to an operation with resolution. */
@@ -141,37 +224,81 @@ void FullFrameExecutionModel::render_operations()
   WorkScheduler::stop();
 }
 
+/** Size in bytes of the buffer an operation renders into. */
+static int64_t get_operation_buffer_size(NodeOperation *op)
+{
+  if (op->get_number_of_output_sockets() == 0) {
+    return 0;
+  }
+  const int64_t elem_size = COM_data_type_bytes_len(op->get_output_socket()->get_data_type());
+  if (op->get_flags().is_constant_operation) {
+    return elem_size;
+  }
+  return int64_t(op->get_width()) * op->get_height() * elem_size;
+}
+
 /**
- * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
+ * Estimates the peak memory needed to render the operation with its dependencies when inputs
+ * are rendered in order of decreasing peak memory. Rendering the most demanding input first
+ * means its intermediate buffers are freed before the buffers of the other inputs are alive.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+static int64_t get_operation_peak_memory(NodeOperation *op, Map<NodeOperation *, int64_t> &peaks)
 {
-  /* Get dependencies from outputs to inputs. */
-  Vector<NodeOperation *> dependencies;
-  Vector<NodeOperation *> next_outputs;
-  next_outputs.append(operation);
-  while (next_outputs.size() > 0) {
-    Vector<NodeOperation *> outputs(next_outputs);
-    next_outputs.clear();
-    for (NodeOperation *output : outputs) {
-      for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
-        next_outputs.append(output->get_input_operation(i));
-      }
-    }
-    dependencies.extend(next_outputs);
+  if (const int64_t *peak = peaks.lookup_ptr(op)) {
+    return *peak;
   }
+  Vector<std::pair<int64_t, NodeOperation *>> inputs;
+  for (const int i : IndexRange(op->get_number_of_input_sockets())) {
+    NodeOperation *input = op->get_input_operation(i);
+    inputs.append({get_operation_peak_memory(input, peaks), input});
+  }
+  std::stable_sort(inputs.begin(), inputs.end(), [](const auto &a, const auto &b) {
+    return a.first > b.first;
+  });
+
+  int64_t peak = 0;
+  int64_t inputs_size = 0;
+  for (const std::pair<int64_t, NodeOperation *> &input : inputs) {
+    peak = std::max(peak, inputs_size + input.first);
+    inputs_size += get_operation_buffer_size(input.second);
+  }
+  peak = std::max(peak, inputs_size + get_operation_buffer_size(op));
+  peaks.add(op, peak);
+  return peak;
+}
 
-  /* Reverse to get dependencies from inputs to outputs. */
-  std::reverse(dependencies.begin(), dependencies.end());
-
-  return dependencies;
+/**
+ * Appends the dependencies of the operation in an order where inputs come before the operations
+ * reading them. Dependencies needing the most memory go first to reduce the number of buffers
+ * that are alive at the same time.
+ */
+static void append_operation_dependencies(NodeOperation *operation,
+                                          Map<NodeOperation *, int64_t> &peaks,
+                                          Set<NodeOperation *> &visited,
+                                          Vector<NodeOperation *> &r_dependencies)
+{
+  Vector<NodeOperation *> inputs;
+  for (const int i : IndexRange(operation->get_number_of_input_sockets())) {
+    inputs.append(operation->get_input_operation(i));
+  }
+  std::stable_sort(inputs.begin(), inputs.end(), [&](NodeOperation *a, NodeOperation *b) {
+    return get_operation_peak_memory(a, peaks) > get_operation_peak_memory(b, peaks);
+  });
+  for (NodeOperation *input : inputs) {
+    if (visited.add(input)) {
+      append_operation_dependencies(input, peaks, visited, r_dependencies);
+      r_dependencies.append(input);
+    }
+  }
 }
 
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  Map<NodeOperation *, int64_t> peaks;
+  Set<NodeOperation *> visited;
+  Vector<NodeOperation *> dependencies;
+  append_operation_dependencies(output_op, peaks, visited, dependencies);
   for (NodeOperation *op : dependencies) {
     if (!active_buffers_.is_operation_rendered(op)) {
       render_operation(op);
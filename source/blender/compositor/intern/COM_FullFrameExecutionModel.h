@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -15,6 +16,7 @@
 namespace blender::compositor {
 
 /* Forward declarations. */
+class CachedOperationBuffers;
 class CompositorContext;
 class ExecutionSystem;
 class MemoryBuffer;
@@ -32,6 +34,21 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   SharedOperationBuffers &active_buffers_;
 
+  /**
+   * Buffers kept from previous executions, null when caching is disabled.
+   */
+  CachedOperationBuffers *cached_buffers_;
+
+  /**
+   * Hashes of the content of rendered buffers that were read by operations supporting caching.
+   */
+  Map<NodeOperation *, uint64_t> content_hashes_;
+
+  /**
+   * Hash of the context settings that operations may copy while being created.
+   */
+  uint64_t context_hash_;
+
   /**
    * Number of operations finished.
    */
@@ -45,6 +62,7 @@ class FullFrameExecutionModel : public ExecutionModel {
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
+                          CachedOperationBuffers *cached_buffers,
                           Span<NodeOperation *> operations);
 
   void execute(ExecutionSystem &exec_system) override;
@@ -64,6 +82,14 @@ class FullFrameExecutionModel : public ExecutionModel {
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
 
+  /**
+   * Key of the operation output in the cached buffers, built from the operation parameters and
+   * the content of its inputs. Inputs must be rendered already. Returns `std::nullopt` when the
+   * operation doesn't support caching.
+   */
+  std::optional<uint64_t> get_cache_key(NodeOperation *op);
+  uint64_t get_content_hash(NodeOperation *op);
+
   void operation_finished(NodeOperation *operation);
 
   /**
@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+#include "BLI_task.h"
+
+#include "DNA_image_types.h"
+#include "DNA_movieclip_types.h"
+#include "DNA_node_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_image.h"
+#include "BKE_movieclip.h"
+#include "BKE_node.h"
+
+#include "IMB_imbuf.h"
+
+#include "COM_InputPrefetcher.h"
+#include "COM_compositor.h"
+
+namespace blender::compositor {
+
+struct ImagePrefetchTask {
+  Image *image;
+  ImageUser image_user;
+  int first_frame;
+  int last_frame;
+  std::atomic<int64_t> *used_memory;
+};
+
+struct MovieClipPrefetchTask {
+  MovieClip *movie_clip;
+  MovieClipUser movie_clip_user;
+  int first_frame;
+  int last_frame;
+  std::atomic<int64_t> *used_memory;
+};
+
+static void prefetch_image_frames(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  ImagePrefetchTask &task = *static_cast<ImagePrefetchTask *>(taskdata);
+  for (int frame = task.first_frame; frame <= task.last_frame; frame++) {
+    if (*task.used_memory >= InputPrefetcher::memory_budget) {
+      return;
+    }
+
+    /* Computes the frame the same way as the image node, so the loaded buffer is stored in the
+     * image cache under the key the next execution looks up. */
+    ImageUser image_user = task.image_user;
+    BKE_image_user_frame_calc(task.image, &image_user, frame);
+
+    ImBuf *ibuf = BKE_image_acquire_ibuf(task.image, &image_user, nullptr);
+    if (ibuf) {
+      *task.used_memory += IMB_get_size_in_memory(ibuf);
+    }
+    BKE_image_release_ibuf(task.image, ibuf, nullptr);
+  }
+}
+
+static void prefetch_movie_clip_frames(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  MovieClipPrefetchTask &task = *static_cast<MovieClipPrefetchTask *>(taskdata);
+  for (int frame = task.first_frame; frame <= task.last_frame; frame++) {
+    if (*task.used_memory >= InputPrefetcher::memory_budget) {
+      return;
+    }
+
+    /* The movie clip node doesn't store frames in the cache while rendering, but it does look
+     * them up there. */
+    MovieClipUser movie_clip_user = task.movie_clip_user;
+    BKE_movieclip_user_set_frame(&movie_clip_user, frame);
+
+    ImBuf *ibuf = BKE_movieclip_get_ibuf(task.movie_clip, &movie_clip_user);
+    if (ibuf) {
+      *task.used_memory += IMB_get_size_in_memory(ibuf);
+      IMB_freeImBuf(ibuf);
+    }
+  }
+}
+
+InputPrefetcher::~InputPrefetcher()
+{
+  wait();
+}
+
+void InputPrefetcher::start(const RenderData &render_data, const bNodeTree &node_tree)
+{
+  wait();
+
+  used_memory_ = 0;
+  task_pool_ = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+  add_node_tree_inputs(render_data, node_tree);
+}
+
+void InputPrefetcher::wait()
+{
+  if (task_pool_ == nullptr) {
+    return;
+  }
+
+  BLI_task_pool_work_and_wait(task_pool_);
+  BLI_task_pool_free(task_pool_);
+  task_pool_ = nullptr;
+}
+
+void InputPrefetcher::add_node_tree_inputs(const RenderData &render_data,
+                                           const bNodeTree &node_tree)
+{
+  const int first_frame = render_data.cfra + 1;
+  const int last_frame = std::min(render_data.cfra + COM_PREFETCH_FRAMES, render_data.efra);
+  if (first_frame > last_frame) {
+    return;
+  }
+
+  LISTBASE_FOREACH (const bNode *, node, &node_tree.nodes) {
+    if (node->flag & NODE_MUTED || node->id == nullptr) {
+      continue;
+    }
+
+    switch (node->type) {
+      case NODE_GROUP:
+      case NODE_CUSTOM_GROUP:
+        add_node_tree_inputs(render_data, *reinterpret_cast<const bNodeTree *>(node->id));
+        break;
+      case CMP_NODE_IMAGE: {
+        Image *image = reinterpret_cast<Image *>(node->id);
+        /* Multi-layer images only hold the layers of a single frame, and multi-view images are
+         * cached per view, so loading them ahead wouldn't help the next execution. */
+        if (!BKE_image_is_animated(image) || BKE_image_is_multilayer(image) ||
+            BKE_image_is_multiview(image))
+        {
+          break;
+        }
+        ImagePrefetchTask *task = MEM_cnew<ImagePrefetchTask>(__func__);
+        task->image = image;
+        task->image_user = *static_cast<const ImageUser *>(node->storage);
+        task->first_frame = first_frame;
+        task->last_frame = last_frame;
+        task->used_memory = &used_memory_;
+        BLI_task_pool_push(task_pool_, prefetch_image_frames, task, true, nullptr);
+        break;
+      }
+      case CMP_NODE_MOVIECLIP: {
+        MovieClipPrefetchTask *task = MEM_cnew<MovieClipPrefetchTask>(__func__);
+        task->movie_clip = reinterpret_cast<MovieClip *>(node->id);
+        task->movie_clip_user = *static_cast<const MovieClipUser *>(node->storage);
+        task->first_frame = first_frame;
+        task->last_frame = last_frame;
+        task->used_memory = &used_memory_;
+        BLI_task_pool_push(task_pool_, prefetch_movie_clip_frames, task, true, nullptr);
+        break;
+      }
+    }
+  }
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+struct RenderData;
+struct TaskPool;
+struct bNodeTree;
+
+namespace blender::compositor {
+
+/**
+ * Loads the frames that follow the current frame from the image sequences, movies and movie clips
+ * that are read by the node tree, on background threads while the current frame is composited.
+ * When rendering an animation, the next compositor executions then find their inputs in the image
+ * and movie clip caches instead of decoding them first.
+ *
+ * Each input is loaded by its own task, in frame order, since frames of the same image or clip
+ * can't be decoded concurrently. Loading stops once the loaded frames exceed
+ * #InputPrefetcher::memory_budget.
+ */
+class InputPrefetcher {
+ public:
+  /** Maximum size in bytes of the frames loaded by a single #InputPrefetcher::start. */
+  static constexpr int64_t memory_budget = int64_t(1024) * 1024 * 1024;
+
+ private:
+  TaskPool *task_pool_ = nullptr;
+  std::atomic<int64_t> used_memory_ = 0;
+
+ public:
+  ~InputPrefetcher();
+
+  /**
+   * Starts loading frames `cfra + 1` to `cfra + COM_PREFETCH_FRAMES` of the inputs of the node
+   * tree, including the inputs of nested node groups.
+   */
+  void start(const RenderData &render_data, const bNodeTree &node_tree);
+  /** Waits until all frames are loaded. Has to be called before the node tree can change. */
+  void wait();
+
+ private:
+  void add_node_tree_inputs(const RenderData &render_data, const bNodeTree &node_tree);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:InputPrefetcher")
+#endif
+};
+
+}  // namespace blender::compositor
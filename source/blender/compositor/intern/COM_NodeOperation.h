@@ -312,6 +312,13 @@ class NodeOperation {
   size_t params_hash_;
   bool is_hash_output_params_implemented_;
 
+  /**
+   * Hash of the node this operation was created from and the index of the operation within the
+   * node. Only set when the node supports caching its output across executions.
+   * \see CachedOperationBuffers
+   */
+  std::optional<uint64_t> cache_params_hash_;
+
   /**
    * \brief the index of the input socket that will be used to determine the canvas
    */
@@ -392,6 +399,16 @@ class NodeOperation {
    */
   std::optional<NodeOperationHash> generate_hash();
 
+  void set_cache_params_hash(const uint64_t hash)
+  {
+    cache_params_hash_ = hash;
+  }
+
+  const std::optional<uint64_t> &get_cache_params_hash() const
+  {
+    return cache_params_hash_;
+  }
+
   unsigned int get_number_of_input_sockets() const
   {
     return inputs_.size();
@@ -7,6 +7,7 @@
 
 #include "BKE_node_runtime.hh"
 
+#include "COM_CachedOperationBuffers.h"
 #include "COM_Converter.h"
 #include "COM_Debug.h"
 
@@ -27,7 +28,11 @@ namespace blender::compositor {
 NodeOperationBuilder::NodeOperationBuilder(const CompositorContext *context,
                                            bNodeTree *b_nodetree,
                                            ExecutionSystem *system)
-    : context_(context), exec_system_(system), current_node_(nullptr), active_viewer_(nullptr)
+    : context_(context),
+      exec_system_(system),
+      current_node_(nullptr),
+      current_node_operations_num_(0),
+      active_viewer_(nullptr)
 {
   graph_.from_bNodeTree(*context, b_nodetree);
 }
@@ -39,12 +44,19 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
 
   for (Node *node : graph_.nodes()) {
     current_node_ = node;
+    current_node_operations_num_ = 0;
+    current_node_cache_hash_.reset();
+    const bNode *b_node = node->get_bnode();
+    if (b_node && CachedOperationBuffers::node_supports_caching(*b_node)) {
+      current_node_cache_hash_ = CachedOperationBuffers::hash_node(*b_node);
+    }
 
     DebugInfo::node_to_operations(node);
     node->convert_to_operations(converter, *context_);
   }
 
   current_node_ = nullptr;
+  current_node_cache_hash_.reset();
 
   /* The input map constructed by nodes maps operation inputs to node inputs.
    * Inverting yields a map of node inputs to all connected operation inputs,
@@ -123,6 +135,11 @@ void NodeOperationBuilder::add_operation(NodeOperation *operation)
   operations_.append(operation);
   if (current_node_) {
     operation->set_name(current_node_->get_bnode()->name);
+    if (current_node_cache_hash_) {
+      operation->set_cache_params_hash(
+          get_default_hash_2(*current_node_cache_hash_, current_node_operations_num_));
+    }
+    current_node_operations_num_++;
   }
   operation->set_execution_model(context_->get_execution_model());
   operation->set_execution_system(exec_system_);
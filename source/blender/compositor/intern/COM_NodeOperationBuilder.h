@@ -64,6 +64,10 @@ class NodeOperationBuilder {
   Map<NodeOutput *, NodeOperationOutput *> output_map_;
 
   Node *current_node_;
+  /** Hash of the current node when it supports caching, see #CachedOperationBuffers. */
+  std::optional<uint64_t> current_node_cache_hash_;
+  /** Number of operations added for the current node. */
+  int current_node_operations_num_;
 
   /** Operation that will be writing to the viewer image
    *  Only one operation can occupy this place at a time,
@@ -9,13 +9,19 @@
 #include "BKE_node_runtime.hh"
 #include "BKE_scene.h"
 
+#include "COM_CachedOperationBuffers.h"
 #include "COM_ExecutionSystem.h"
+#include "COM_InputPrefetcher.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
+  /** Buffers of expensive operations kept across executions while editing. */
+  blender::compositor::CachedOperationBuffers cached_buffers;
+  /** Loads the next frames of animated inputs while rendering. */
+  blender::compositor::InputPrefetcher input_prefetcher;
 } g_compositor;
 
 /* Make sure node tree has previews.
@@ -72,27 +78,48 @@ void COM_execute(RenderData *render_data,
   compositor_init_node_previews(render_data, node_tree);
   compositor_reset_node_tree_status(node_tree);
 
+  /* Decode the next frames of animated inputs while this frame is composited. */
+  if (rendering) {
+    g_compositor.input_prefetcher.start(*render_data, *node_tree);
+  }
+
   /* Initialize workscheduler. */
   const bool use_opencl = (node_tree->flag & NTREE_COM_OPENCL) != 0;
   blender::compositor::WorkScheduler::initialize(use_opencl, BKE_render_num_threads(render_data));
 
+  /* Only cache while editing, where most executions only differ by a few node changes. */
+  blender::compositor::CachedOperationBuffers *cached_buffers = nullptr;
+  if (!rendering) {
+    cached_buffers = &g_compositor.cached_buffers;
+    cached_buffers->begin_execution();
+  }
+
   /* Execute. */
   const bool twopass = (node_tree->flag & NTREE_TWO_PASS) && !rendering;
   if (twopass) {
     blender::compositor::ExecutionSystem fast_pass(
-        render_data, scene, node_tree, rendering, true, view_name);
+        render_data, scene, node_tree, rendering, true, view_name, cached_buffers);
     fast_pass.execute();
 
     if (node_tree->runtime->test_break(node_tree->runtime->tbh)) {
+      g_compositor.input_prefetcher.wait();
       BLI_mutex_unlock(&g_compositor.mutex);
       return;
     }
   }
 
   blender::compositor::ExecutionSystem system(
-      render_data, scene, node_tree, rendering, false, view_name);
+      render_data, scene, node_tree, rendering, false, view_name, cached_buffers);
   system.execute();
 
+  /* The inputs may be freed or changed once the compositor is done. */
+  g_compositor.input_prefetcher.wait();
+
+  /* Keep the entries of cancelled executions, they are likely needed by the next one. */
+  if (cached_buffers && !node_tree->runtime->test_break(node_tree->runtime->tbh)) {
+    cached_buffers->end_execution();
+  }
+
   BLI_mutex_unlock(&g_compositor.mutex);
 }
 
@@ -101,6 +128,7 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    g_compositor.cached_buffers.clear();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
@@ -1,10 +1,24 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later
  * Copyright 2011 Blender Foundation. */
 
+#include "BLI_simd.h"
+
 #include "COM_MixOperation.h"
 
 namespace blender::compositor {
 
+#ifdef BLI_HAVE_SSE2
+/**
+ * Store mixed RGB channels together with the alpha of the first color, which is the output alpha
+ * of all mix operations.
+ */
+static inline void store_rgb_with_alpha_sse(float *out, const __m128 rgb, const __m128 color1)
+{
+  const __m128 rgb_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+  _mm_storeu_ps(out, _mm_or_ps(_mm_and_ps(rgb_mask, rgb), _mm_andnot_ps(rgb_mask, color1)));
+}
+#endif
+
 /* ******** Mix Base Operation ******** */
 
 MixBaseOperation::MixBaseOperation()
@@ -113,10 +127,18 @@ void MixBaseOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     const float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 rgb = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(value_m), color1),
+                                  _mm_mul_ps(_mm_set1_ps(value), color2));
+    store_rgb_with_alpha_sse(p.out, rgb, color1);
+#else
     p.out[0] = value_m * p.color1[0] + value * p.color2[0];
     p.out[1] = value_m * p.color1[1] + value * p.color2[1];
     p.out[2] = value_m * p.color1[2] + value * p.color2[2];
     p.out[3] = p.color1[3];
+#endif
     p.next();
   }
 }
@@ -155,10 +177,17 @@ void MixAddOperation::update_memory_buffer_row(PixelCursor &p)
     if (this->use_value_alpha_multiply()) {
       value *= p.color2[3];
     }
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 rgb = _mm_add_ps(color1, _mm_mul_ps(_mm_set1_ps(value), color2));
+    store_rgb_with_alpha_sse(p.out, rgb, color1);
+#else
     p.out[0] = p.color1[0] + value * p.color2[0];
     p.out[1] = p.color1[1] + value * p.color2[1];
     p.out[2] = p.color1[2] + value * p.color2[2];
     p.out[3] = p.color1[3];
+#endif
 
     clamp_if_needed(p.out);
     p.next();
@@ -202,10 +231,18 @@ void MixBlendOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 rgb = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(value_m), color1),
+                                  _mm_mul_ps(_mm_set1_ps(value), color2));
+    store_rgb_with_alpha_sse(p.out, rgb, color1);
+#else
     p.out[0] = value_m * p.color1[0] + value * p.color2[0];
     p.out[1] = value_m * p.color1[1] + value * p.color2[1];
     p.out[2] = value_m * p.color1[2] + value * p.color2[2];
     p.out[3] = p.color1[3];
+#endif
 
     clamp_if_needed(p.out);
     p.next();
@@ -1087,11 +1124,19 @@ void MixMultiplyOperation::update_memory_buffer_row(PixelCursor &p)
       value *= p.color2[3];
     }
     const float value_m = 1.0f - value;
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 rgb = _mm_mul_ps(
+        color1, _mm_add_ps(_mm_set1_ps(value_m), _mm_mul_ps(_mm_set1_ps(value), color2)));
+    store_rgb_with_alpha_sse(p.out, rgb, color1);
+#else
     p.out[0] = p.color1[0] * (value_m + value * p.color2[0]);
     p.out[1] = p.color1[1] * (value_m + value * p.color2[1]);
     p.out[2] = p.color1[2] * (value_m + value * p.color2[2]);
 
     p.out[3] = p.color1[3];
+#endif
 
     clamp_if_needed(p.out);
     p.next();
@@ -1395,10 +1440,17 @@ void MixSubtractOperation::update_memory_buffer_row(PixelCursor &p)
     if (this->use_value_alpha_multiply()) {
       value *= p.color2[3];
     }
+#ifdef BLI_HAVE_SSE2
+    const __m128 color1 = _mm_loadu_ps(p.color1);
+    const __m128 color2 = _mm_loadu_ps(p.color2);
+    const __m128 rgb = _mm_sub_ps(color1, _mm_mul_ps(_mm_set1_ps(value), color2));
+    store_rgb_with_alpha_sse(p.out, rgb, color1);
+#else
     p.out[0] = p.color1[0] - value * p.color2[0];
     p.out[1] = p.color1[1] - value * p.color2[1];
     p.out[2] = p.color1[2] - value * p.color2[2];
     p.out[3] = p.color1[3];
+#endif
 
     clamp_if_needed(p.out);
     p.next();
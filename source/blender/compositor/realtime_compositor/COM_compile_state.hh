@@ -8,6 +8,7 @@
 
 #include "COM_domain.hh"
 #include "COM_node_operation.hh"
+#include "COM_operation.hh"
 #include "COM_scheduler.hh"
 #include "COM_shader_operation.hh"
 
@@ -138,6 +139,9 @@ class CompileState {
    * given output's node was compiled to. */
   Result &get_result_from_output_socket(DOutputSocket output);
 
+  /* Returns a reference to the operation that the given output's node was compiled to. */
+  Operation &get_operation_from_output_socket(DOutputSocket output);
+
   /* Add the given node to the compile unit. And if the domain of the compile unit is not yet
    * determined or was determined to be an identity domain, update it to the computed domain for
    * the give node. */
@@ -3,7 +3,10 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
@@ -14,6 +17,7 @@
 #include "COM_context.hh"
 #include "COM_node_operation.hh"
 #include "COM_operation.hh"
+#include "COM_result.hh"
 #include "COM_shader_operation.hh"
 
 namespace blender::realtime_compositor {
@@ -97,7 +101,16 @@ using namespace nodes::derived_node_tree_types;
  * unit. Node 5 is then added to the now empty compile unit similar to node 3. Node 6 is not a
  * shader node, so the compile unit is considered complete and is compiled first, adding the first
  * shader operation to the operations stream and resetting the compile unit. Finally, node 6 is
- * compiled into a node operation similar to nodes 1 and 2 and added to the operations stream. */
+ * compiled into a node operation similar to nodes 1 and 2 and added to the operations stream.
+ *
+ * Operations whose results can only change when the node tree changes are said to be static, see
+ * the is_static_node function. This includes operations that process still images or constant
+ * inputs, but not operations that depend on render passes, the frame, or the view. After the
+ * first evaluation, the results of static operations that are used by non static operations are
+ * made persistent, such that they are kept in the texture pool across evaluations. After the
+ * second evaluation, which computes those persistent results, static operations that are not
+ * needed to compute the inputs of non static operations are no longer evaluated. So only the
+ * branches of the node tree that can change are evaluated again until the evaluator is reset. */
 class Evaluator {
  private:
   /* A reference to the compositor context. */
@@ -115,6 +128,19 @@ class Evaluator {
   /* True if the node tree is already compiled into an operations stream that can be evaluated
    * directly. False if the node tree is not compiled yet and needs to be compiled. */
   bool is_compiled_ = false;
+  /* The nodes of the node execution schedule that are static and whose inputs are only linked to
+   * static nodes. This is computed when the node tree is compiled. */
+  Set<DNode> static_nodes_;
+  /* The operations in the operations stream that are static, see the class description. */
+  Set<const Operation *> static_operations_;
+  /* The results mapped to the inputs of each operation in the operations stream, along with the
+   * operations that compute them. */
+  Map<const Operation *, Vector<std::pair<Operation *, Result *>>> operations_inputs_;
+  /* The static operations that are not evaluated because the results of non static operations can
+   * be computed from persistent results. */
+  Set<const Operation *> skipped_operations_;
+  /* True if the skipped operations were computed after the persistent results were computed. */
+  bool are_skipped_operations_computed_ = false;
 
  public:
   /* Construct an evaluator from a context. */
@@ -131,6 +157,11 @@ class Evaluator {
    * contents do not necessitate a reset. */
   void reset();
 
+  /* Evaluate static operations again in the next evaluation without recompiling the node tree.
+   * This should be called when the contents of resources used by static operations change, for
+   * instance, when a still image is modified or reloaded. */
+  void reset_static_operations();
+
  private:
   /* Check if the compositor node tree is valid by checking if it has:
    * - Cyclic links.
@@ -166,6 +197,14 @@ class Evaluator {
   /* Map each input of the shader operation to the result of the output linked to it. */
   void map_shader_operation_inputs_to_their_results(ShaderOperation *operation,
                                                     CompileState &compile_state);
+
+  /* Make the results of static operations that are mapped to inputs of non static operations
+   * persistent, such that they can be kept across evaluations. */
+  void make_static_results_persistent();
+
+  /* Compute the static operations that don't need to be evaluated anymore because all results
+   * they contribute to non static operations are persistent, see skipped_operations_. */
+  void compute_skipped_operations();
 };
 
 }  // namespace blender::realtime_compositor
@@ -99,6 +99,11 @@ class Result {
    * calling the pass_through method, which sets this result to be the master of a target result.
    * See that method for more information. */
   Result *master_ = nullptr;
+  /* If true, the texture of the result is a persistent texture of the texture pool, which is not
+   * released when the reference count reaches zero and is reused when the result is allocated
+   * again. This allows the evaluator to keep results across evaluations, see the
+   * make_persistent method. */
+  bool is_persistent_ = false;
 
  public:
   /* Construct a result of the given type with the given texture pool that will be used to allocate
@@ -211,9 +216,20 @@ class Result {
   /* Decrement the reference count of the result and release the its texture back into the texture
    * pool if the reference count reaches zero. This should be called when an operation that used
    * this result no longer needs it. If this result have a master result, the master result is
-   * released instead. */
+   * released instead. Persistent results keep their texture regardless of the reference count. */
   void release();
 
+  /* Allocate the texture of the result from the persistent textures of the texture pool from now
+   * on, such that the result remains valid after the evaluation and can be used by later
+   * evaluations without computing it again. If the persistent textures budget of the pool is
+   * exhausted when allocating, the result is allocated from the pool as usual and stops being
+   * persistent. This should be called between evaluations. */
+  void make_persistent();
+
+  /* Returns true if the texture of the result is persistent, see make_persistent. If this result
+   * have a master result, then whether the master result is persistent is returned instead. */
+  bool is_persistent() const;
+
   /* Returns true if this result should be computed and false otherwise. The result should be
    * computed if its reference count is not zero, that is, its result is used by at least one
    * operation. */
@@ -237,6 +253,15 @@ class Result {
 
   /* Returns a reference to the domain of the result. See the Domain class. */
   const Domain &domain() const;
+
+ private:
+  /* Returns the format of the textures that store results of the type of this result. */
+  eGPUTextureFormat get_texture_format() const;
+
+  /* If the result is persistent, set its texture to a persistent texture of the given size,
+   * reusing the texture from a previous evaluation if possible, and return true. Otherwise, or if
+   * the persistent textures budget is exhausted, return false. */
+  bool acquire_persistent_texture(int2 size);
 };
 
 }  // namespace blender::realtime_compositor
@@ -50,8 +50,18 @@ class TexturePool {
   /* The set of textures in the pool that are available to acquire for each distinct texture
    * specification. */
   Map<TexturePoolKey, Vector<GPUTexture *>> textures_;
+  /* The persistent textures that are currently allocated, see the acquire_persistent method. */
+  Vector<GPUTexture *> persistent_textures_;
+  /* The total memory in bytes used by the persistent textures. */
+  int64_t persistent_textures_memory_ = 0;
 
  public:
+  /* The maximum total memory in bytes that can be used by persistent textures. */
+  static constexpr int64_t persistent_textures_budget = 512 * 1024 * 1024;
+
+  /* Free the persistent textures. */
+  ~TexturePool();
+
   /* Check if there is an available texture with the given specification in the pool, if such
    * texture exists, return it, otherwise, return a newly allocated texture. Expect the texture to
    * be uncleared and possibly contains garbage data. */
@@ -76,6 +86,19 @@ class TexturePool {
    * called after the compositor is done evaluating. */
   void reset();
 
+  /* Returns a newly allocated texture with the given specification that is owned by the pool
+   * instead of the caller of the compositor evaluator. Persistent textures are never returned to
+   * the pool by the reset method, so they can hold results across evaluations. Returns nullptr if
+   * the texture would make the persistent textures exceed persistent_textures_budget. */
+  GPUTexture *acquire_persistent(int2 size, eGPUTextureFormat format);
+
+  /* Free a texture that was acquired using the acquire_persistent method. */
+  void release_persistent(GPUTexture *texture);
+
+  /* Free all textures that were acquired using the acquire_persistent method. This should be
+   * called when the results that use them are discarded. */
+  void free_persistent();
+
  private:
   /* Returns a newly allocated texture with the given specification. This method should be
    * implemented by the caller of the compositor evaluator. See the class description for more
@@ -12,6 +12,7 @@
 #include "COM_domain.hh"
 #include "COM_input_descriptor.hh"
 #include "COM_node_operation.hh"
+#include "COM_operation.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
 #include "COM_shader_operation.hh"
@@ -56,6 +57,15 @@ Result &CompileState::get_result_from_output_socket(DOutputSocket output)
   return operation->get_result(operation->get_output_identifier_from_output_socket(output));
 }
 
+Operation &CompileState::get_operation_from_output_socket(DOutputSocket output)
+{
+  if (node_operations_.contains(output.node())) {
+    return *node_operations_.lookup(output.node());
+  }
+
+  return *shader_operations_.lookup(output.node());
+}
+
 void CompileState::add_node_to_shader_compile_unit(DNode node)
 {
   shader_compile_unit_.add_new(node);
@@ -1,9 +1,19 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include <string>
+#include <utility>
 
+#include "BLI_map.hh"
+#include "BLI_set.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "DNA_image_types.h"
 #include "DNA_node_types.h"
 
+#include "BKE_image.h"
+#include "BKE_node.h"
+
 #include "NOD_derived_node_tree.hh"
 
 #include "COM_compile_state.hh"
@@ -33,11 +43,19 @@ void Evaluator::evaluate()
   if (!is_compiled_) {
     compile_and_evaluate();
     is_compiled_ = true;
+    make_static_results_persistent();
     return;
   }
 
   for (const std::unique_ptr<Operation> &operation : operations_stream_) {
-    operation->evaluate();
+    if (!skipped_operations_.contains(operation.get())) {
+      operation->evaluate();
+    }
+  }
+
+  if (!are_skipped_operations_computed_) {
+    compute_skipped_operations();
+    are_skipped_operations_computed_ = true;
   }
 }
 
@@ -45,10 +63,58 @@ void Evaluator::reset()
 {
   operations_stream_.clear();
   derived_node_tree_.reset();
+  static_nodes_.clear();
+  static_operations_.clear();
+  operations_inputs_.clear();
+  reset_static_operations();
+
+  /* The persistent textures are only used by the results of the discarded operations. */
+  context_.texture_pool().free_persistent();
 
   is_compiled_ = false;
 }
 
+void Evaluator::reset_static_operations()
+{
+  skipped_operations_.clear();
+  are_skipped_operations_computed_ = false;
+}
+
+/* Returns true if the outputs of the given node only depend on its inputs and its properties, which
+ * can only change along with the node tree, in which case the evaluator is reset. Nodes that read
+ * render passes, the frame, the view or the render settings, that write the compositor output, or
+ * that reference data-blocks that might change with the frame, like movie clips or masks, are not
+ * static. Still images are considered static, so the caller should call the
+ * reset_static_operations method of the evaluator when images change. */
+static bool is_static_node(DNode node)
+{
+  const bNode &bnode = *node;
+
+  /* Unsupported nodes set an info message every evaluation. */
+  if (bnode.typeinfo->realtime_compositor_unsupported_message) {
+    return false;
+  }
+
+  switch (bnode.type) {
+    case CMP_NODE_R_LAYERS:
+    case CMP_NODE_TIME:
+    case CMP_NODE_SCENE_TIME:
+    case CMP_NODE_SWITCH_VIEW:
+    case CMP_NODE_SCALE:
+    case CMP_NODE_COMPOSITE:
+    case CMP_NODE_VIEWER:
+    case CMP_NODE_SPLITVIEWER:
+      return false;
+    case CMP_NODE_IMAGE: {
+      const Image *image = reinterpret_cast<const Image *>(bnode.id);
+      return image && ELEM(image->source, IMA_SRC_FILE, IMA_SRC_GENERATED) &&
+             !BKE_image_is_multiview(image);
+    }
+  }
+
+  return bnode.id == nullptr;
+}
+
 bool Evaluator::validate_node_tree()
 {
   if (derived_node_tree_->has_link_cycles()) {
@@ -74,6 +140,27 @@ void Evaluator::compile_and_evaluate()
 
   const Schedule schedule = compute_schedule(*derived_node_tree_);
 
+  /* A node is static if all the nodes it depends on are static, and since the schedule is ordered
+   * such that nodes come after the nodes they depend on, they can be computed in order. */
+  for (const DNode &node : schedule) {
+    if (!is_static_node(node)) {
+      continue;
+    }
+
+    bool is_linked_to_non_static_node = false;
+    for (const bNodeSocket *input : node->input_sockets()) {
+      const DSocket origin = get_input_origin_socket(DInputSocket(node.context(), input));
+      if (origin->is_output() && !static_nodes_.contains(origin.node())) {
+        is_linked_to_non_static_node = true;
+        break;
+      }
+    }
+
+    if (!is_linked_to_non_static_node) {
+      static_nodes_.add_new(node);
+    }
+  }
+
   CompileState compile_state(schedule);
 
   for (const DNode &node : schedule) {
@@ -103,6 +190,10 @@ void Evaluator::compile_and_evaluate_node(DNode node, CompileState &compile_stat
    * is evaluated. */
   operations_stream_.append(std::unique_ptr<Operation>(operation));
 
+  if (static_nodes_.contains(node)) {
+    static_operations_.add_new(operation);
+  }
+
   operation->compute_results_reference_counts(compile_state.get_schedule());
 
   operation->evaluate();
@@ -122,6 +213,8 @@ void Evaluator::map_node_operation_inputs_to_their_results(DNode node,
     if (dorigin->is_output()) {
       Result &result = compile_state.get_result_from_output_socket(DOutputSocket(dorigin));
       operation->map_input_to_result(input->identifier, &result);
+      operations_inputs_.lookup_or_add_default(operation).append(
+          {&compile_state.get_operation_from_output_socket(DOutputSocket(dorigin)), &result});
       continue;
     }
 
@@ -131,9 +224,14 @@ void Evaluator::map_node_operation_inputs_to_their_results(DNode node,
      * result of a newly created Input Single Value Operation. */
     auto *input_operation = new InputSingleValueOperation(context_, DInputSocket(dorigin));
     operation->map_input_to_result(input->identifier, &input_operation->get_result());
+    operations_inputs_.lookup_or_add_default(operation).append(
+        {input_operation, &input_operation->get_result()});
 
     operations_stream_.append(std::unique_ptr<InputSingleValueOperation>(input_operation));
 
+    /* Unlinked inputs can only change along with the node tree. */
+    static_operations_.add_new(input_operation);
+
     input_operation->evaluate();
   }
 }
@@ -143,8 +241,14 @@ void Evaluator::compile_and_evaluate_shader_compile_unit(CompileState &compile_s
   ShaderCompileUnit &compile_unit = compile_state.get_shader_compile_unit();
   ShaderOperation *operation = new ShaderOperation(context_, compile_unit);
 
+  bool is_static = true;
   for (DNode node : compile_unit) {
     compile_state.map_node_to_shader_operation(node, operation);
+    is_static = is_static && static_nodes_.contains(node);
+  }
+
+  if (is_static) {
+    static_operations_.add_new(operation);
   }
 
   map_shader_operation_inputs_to_their_results(operation, compile_state);
@@ -164,6 +268,57 @@ void Evaluator::map_shader_operation_inputs_to_their_results(ShaderOperation *op
   for (const auto &item : operation->get_inputs_to_linked_outputs_map().items()) {
     Result &result = compile_state.get_result_from_output_socket(item.value);
     operation->map_input_to_result(item.key, &result);
+    operations_inputs_.lookup_or_add_default(operation).append(
+        {&compile_state.get_operation_from_output_socket(item.value), &result});
+  }
+}
+
+void Evaluator::make_static_results_persistent()
+{
+  for (const std::unique_ptr<Operation> &operation : operations_stream_) {
+    if (static_operations_.contains(operation.get())) {
+      continue;
+    }
+
+    const Vector<std::pair<Operation *, Result *>> *inputs = operations_inputs_.lookup_ptr(
+        operation.get());
+    if (!inputs) {
+      continue;
+    }
+
+    for (const std::pair<Operation *, Result *> &input : *inputs) {
+      if (static_operations_.contains(input.first)) {
+        input.second->make_persistent();
+      }
+    }
+  }
+}
+
+void Evaluator::compute_skipped_operations()
+{
+  skipped_operations_ = static_operations_;
+
+  /* Go over the operations in reverse order, such that all operations that use the results of an
+   * operation are considered before it. If an operation is evaluated and one of its inputs is not
+   * persistent, for instance, because the persistent textures budget was exhausted, the operation
+   * that computes it needs to be evaluated as well. */
+  for (int i = operations_stream_.size() - 1; i >= 0; i--) {
+    const Operation *operation = operations_stream_[i].get();
+    if (skipped_operations_.contains(operation)) {
+      continue;
+    }
+
+    const Vector<std::pair<Operation *, Result *>> *inputs = operations_inputs_.lookup_ptr(
+        operation);
+    if (!inputs) {
+      continue;
+    }
+
+    for (const std::pair<Operation *, Result *> &input : *inputs) {
+      if (!input.second->is_persistent()) {
+        skipped_operations_.remove(input.first);
+      }
+    }
   }
 }
 
@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_assert.h"
 #include "BLI_float3x3.hh"
 #include "BLI_math_vector_types.hh"
 
@@ -28,6 +29,11 @@ Result Result::Temporary(ResultType type, TexturePool &texture_pool)
 void Result::allocate_texture(Domain domain)
 {
   is_single_value_ = false;
+  domain_ = domain;
+  if (acquire_persistent_texture(domain.size)) {
+    return;
+  }
+
   switch (type_) {
     case ResultType::Float:
       texture_ = texture_pool_->acquire_float(domain.size);
@@ -39,14 +45,18 @@ void Result::allocate_texture(Domain domain)
       texture_ = texture_pool_->acquire_color(domain.size);
       break;
   }
-  domain_ = domain;
 }
 
 void Result::allocate_single_value()
 {
   is_single_value_ = true;
+  domain_ = Domain::identity();
   /* Single values are stored in 1x1 textures as well as the single value members. */
   const int2 texture_size{1, 1};
+  if (acquire_persistent_texture(texture_size)) {
+    return;
+  }
+
   switch (type_) {
     case ResultType::Float:
       texture_ = texture_pool_->acquire_float(texture_size);
@@ -58,7 +68,6 @@ void Result::allocate_single_value()
       texture_ = texture_pool_->acquire_color(texture_size);
       break;
   }
-  domain_ = Domain::identity();
 }
 
 void Result::allocate_invalid()
@@ -119,6 +128,8 @@ void Result::pass_through(Result &target)
   target = *this;
   target.initial_reference_count_ = initial_reference_count;
 
+  /* The target doesn't own the texture, whether it is persistent is a property of this result. */
+  target.is_persistent_ = false;
   target.master_ = this;
 }
 
@@ -222,11 +233,30 @@ void Result::release()
   /* Decrement the reference count, and if it reaches zero, release the texture back into the
    * texture pool. */
   reference_count_--;
-  if (reference_count_ == 0) {
+  if (reference_count_ == 0 && !is_persistent_) {
     texture_pool_->release(texture_);
   }
 }
 
+void Result::make_persistent()
+{
+  /* The texture was acquired from the texture pool in a previous evaluation and was already
+   * released, so it can't be reused as a persistent texture. */
+  if (!is_persistent_) {
+    texture_ = nullptr;
+  }
+  is_persistent_ = true;
+}
+
+bool Result::is_persistent() const
+{
+  /* If there is a master result, return its persistent status instead. */
+  if (master_) {
+    return master_->is_persistent();
+  }
+  return is_persistent_;
+}
+
 bool Result::should_compute()
 {
   return initial_reference_count_ != 0;
@@ -266,4 +296,42 @@ const Domain &Result::domain() const
   return domain_;
 }
 
+eGPUTextureFormat Result::get_texture_format() const
+{
+  switch (type_) {
+    case ResultType::Float:
+      return GPU_R16F;
+    case ResultType::Vector:
+    case ResultType::Color:
+      /* Vectors are 4D, and are thus stored in RGBA textures. */
+      return GPU_RGBA16F;
+  }
+
+  BLI_assert_unreachable();
+  return GPU_RGBA16F;
+}
+
+bool Result::acquire_persistent_texture(int2 size)
+{
+  if (!is_persistent_) {
+    return false;
+  }
+
+  /* Reuse the persistent texture of a previous evaluation if it has the needed size. */
+  if (texture_) {
+    if (GPU_texture_width(texture_) == size.x && GPU_texture_height(texture_) == size.y) {
+      return true;
+    }
+    texture_pool_->release_persistent(texture_);
+  }
+
+  texture_ = texture_pool_->acquire_persistent(size, get_texture_format());
+  if (!texture_) {
+    is_persistent_ = false;
+    return false;
+  }
+
+  return true;
+}
+
 }  // namespace blender::realtime_compositor
@@ -83,6 +83,49 @@ void TexturePool::reset()
   textures_.clear();
 }
 
+TexturePool::~TexturePool()
+{
+  free_persistent();
+}
+
+/* Returns the memory in bytes used by a texture of the given specification. Textures of the
+ * compositor store half floats. */
+static int64_t get_texture_memory(int2 size, eGPUTextureFormat format)
+{
+  return int64_t(size.x) * size.y * GPU_texture_component_len(format) * 2;
+}
+
+GPUTexture *TexturePool::acquire_persistent(int2 size, eGPUTextureFormat format)
+{
+  const int64_t memory = get_texture_memory(size, format);
+  if (persistent_textures_memory_ + memory > persistent_textures_budget) {
+    return nullptr;
+  }
+
+  GPUTexture *texture = GPU_texture_create_2d(
+      "compositor_persistent", size.x, size.y, 1, format, nullptr);
+  persistent_textures_.append(texture);
+  persistent_textures_memory_ += memory;
+  return texture;
+}
+
+void TexturePool::release_persistent(GPUTexture *texture)
+{
+  persistent_textures_.remove_first_occurrence_and_reorder(texture);
+  const TexturePoolKey key = TexturePoolKey(texture);
+  persistent_textures_memory_ -= get_texture_memory(key.size, key.format);
+  GPU_texture_free(texture);
+}
+
+void TexturePool::free_persistent()
+{
+  for (GPUTexture *texture : persistent_textures_) {
+    GPU_texture_free(texture);
+  }
+  persistent_textures_.clear();
+  persistent_textures_memory_ = 0;
+}
+
 /** \} */
 
 }  // namespace blender::realtime_compositor
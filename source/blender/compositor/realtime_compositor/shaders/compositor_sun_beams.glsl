@@ -0,0 +1,34 @@
+#pragma BLENDER_REQUIRE(gpu_shader_compositor_texture_utilities.glsl)
+
+void main()
+{
+  ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+  vec2 input_size = vec2(texture_size(input_tx));
+
+  /* The source and the ray length are in pixels. March from the texel towards the source in steps
+   * of one pixel along the major axis of the ray, like the CPU compositor does. */
+  vec2 vector_to_source = source - vec2(texel);
+  float distance_to_source = length(vector_to_source);
+  float major_axis_length = max(abs(vector_to_source.x), abs(vector_to_source.y));
+  if (major_axis_length < 1.0) {
+    imageStore(output_img, texel, texture_load(input_tx, texel));
+    return;
+  }
+
+  vec2 step_vector = vector_to_source / major_axis_length;
+  float step_length = distance_to_source / major_axis_length;
+  int steps = int(ceil(min(major_axis_length, max_ray_length / step_length)));
+
+  /* Samples get less weight as they get further away from the texel, reaching zero at the maximum
+   * ray length. Samples are also weighted by their alpha. */
+  float falloff_factor = step_length / max_ray_length;
+  vec4 accumulated_color = vec4(0.0);
+  for (int i = 0; i < steps; i++) {
+    vec2 coordinates = vec2(texel) + vec2(0.5) + step_vector * float(i);
+    vec4 color = texture(input_tx, coordinates / input_size);
+    float weight = 1.0 - float(i) * falloff_factor;
+    accumulated_color += color * color.a * weight * weight;
+  }
+
+  imageStore(output_img, texel, steps > 0 ? accumulated_color / float(steps) : vec4(0.0));
+}
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2023 Blender Foundation. */
+
+#include "testing/testing.h"
+
+#include "COM_CachedOperationBuffers.h"
+
+namespace blender::compositor::tests {
+
+static rcti create_rect(int xmin, int xmax, int ymin, int ymax)
+{
+  rcti rect;
+  BLI_rcti_init(&rect, xmin, xmax, ymin, ymax);
+  return rect;
+}
+
+TEST(CachedOperationBuffers, HashBufferAreas)
+{
+  MemoryBuffer buffer(DataType::Color, create_rect(0, 8, 0, 8));
+  const float color[4] = {0.5f, 0.5f, 0.5f, 1.0f};
+  buffer.fill(buffer.get_rect(), color);
+  const rcti area = create_rect(2, 6, 2, 6);
+  const uint64_t hash = CachedOperationBuffers::hash_buffer_areas(buffer, {area});
+
+  /* Changes outside of the area are ignored. */
+  buffer.get_elem(0, 0)[0] = 1.0f;
+  EXPECT_EQ(CachedOperationBuffers::hash_buffer_areas(buffer, {area}), hash);
+
+  buffer.get_elem(3, 4)[2] = 1.0f;
+  EXPECT_NE(CachedOperationBuffers::hash_buffer_areas(buffer, {area}), hash);
+}
+
+TEST(CachedOperationBuffers, EvictUnused)
+{
+  MemoryBuffer buffer(DataType::Value, create_rect(0, 4, 0, 4));
+  const float value = 1.0f;
+  buffer.fill(buffer.get_rect(), &value);
+
+  CachedOperationBuffers cache;
+  cache.begin_execution();
+  cache.add(1, buffer, 10);
+  cache.add(2, buffer, 20);
+  cache.end_execution();
+
+  cache.begin_execution();
+  const CachedOperationBuffers::Entry *entry = cache.lookup(1);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->content_hash, uint64_t(10));
+  EXPECT_EQ(entry->buffer->get_value(2, 2, 0), 1.0f);
+  cache.end_execution();
+
+  /* The entry not used in the last execution is freed. */
+  EXPECT_NE(cache.lookup(1), nullptr);
+  EXPECT_EQ(cache.lookup(2), nullptr);
+}
+
+}  // namespace blender::compositor::tests
@@ -70,6 +70,18 @@ void DEG_graph_relations_update(struct Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(struct Main *bmain);
 
+/**
+ * Tag relations for update only in the graphs that contain the given ID. Use this instead of
+ * #DEG_relations_tag_update when the change only affects the relations of this ID, like adding or
+ * removing a modifier. Graphs that do not evaluate the ID are not rebuilt, which avoids costly
+ * rebuilds of other scenes and view layers.
+ *
+ * 
+ote This is not enough for changes that make the ID part of graphs that did not contain it
+ * before, like linking an object to a collection.
+ */
+void DEG_id_tag_relations_update(struct Main *bmain, struct ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
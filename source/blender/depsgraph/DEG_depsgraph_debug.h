@@ -52,6 +52,18 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/**
+ * Start capturing the evaluation timeline of the graph, keeping the last \a frames_num
+ * evaluations. Passing zero stops the capture and frees the captured data.
+ */
+void DEG_debug_eval_timeline_capture(struct Depsgraph *depsgraph, int frames_num);
+
+/**
+ * Write the captured evaluation timeline in the Chrome trace event format, which can be opened
+ * in `chrome://tracing` or Perfetto. Returns false when nothing was captured.
+ */
+bool DEG_debug_eval_timeline_write(const struct Depsgraph *depsgraph, FILE *fp);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
@@ -20,6 +20,7 @@
 #include "BLI_utildefines.h"
 
 #include "BKE_action.h"
+#include "BKE_animsys.h"
 
 #include "RNA_prototypes.h"
 
@@ -163,6 +164,10 @@ void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
     ID *id_orig = id_node->id_orig;
     id_node->finalize_build(graph);
     int flag = 0;
+    /* Resolved animation paths might point to data which does not exist anymore. */
+    if (deg_copy_on_write_is_expanded(id_node->id_cow)) {
+      BKE_animsys_path_cache_clear(id_node->id_cow);
+    }
     /* Tag rebuild if special evaluation flags changed. */
     if (id_node->eval_flags != id_node->previous_eval_flags) {
       flag |= ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY;
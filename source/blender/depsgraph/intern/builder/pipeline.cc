@@ -3,6 +3,8 @@
 
 #include "pipeline.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BKE_global.h"
@@ -31,6 +33,8 @@ void AbstractBuilderPipeline::build()
     start_time = PIL_check_seconds_timer();
   }
 
+  MEM_TagScope mem_tag(MEM_TAG_DEPSGRAPH);
+
   build_step_sanity_check();
   build_step_nodes();
   build_step_relations();
@@ -31,6 +31,7 @@
 #include "intern/depsgraph_update.h"
 
 #include "intern/eval/deg_eval_copy_on_write.h"
+#include "intern/eval/deg_eval_stats.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -59,6 +60,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(nullptr),
       is_active(false),
       use_visibility_optimization(true),
+      eval_timeline(nullptr),
       is_evaluating(false),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false)
@@ -75,6 +77,7 @@ Depsgraph::~Depsgraph()
 {
   clear_id_nodes();
   delete time_source;
+  delete eval_timeline;
   BLI_spin_end(&lock);
 }
 
@@ -33,6 +33,8 @@ struct ViewLayer;
 
 namespace blender::deg {
 
+class EvalTimeline;
+
 struct IDNode;
 struct Node;
 struct OperationNode;
@@ -152,6 +154,9 @@ struct Depsgraph {
 
   DepsgraphDebug debug;
 
+  /* Capture of the evaluation timeline, only allocated while the capture is enabled. */
+  EvalTimeline *eval_timeline;
+
   bool is_evaluating;
 
   /* Is set to truth for dependency graph which are used for post-processing (compositor and
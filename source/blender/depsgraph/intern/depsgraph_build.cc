@@ -305,3 +305,15 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+void DEG_id_tag_relations_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    /* Relations of an ID which is not in the graph do not affect its evaluation. */
+    if (depsgraph->find_id_node(id) == nullptr) {
+      continue;
+    }
+    DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
+  }
+}
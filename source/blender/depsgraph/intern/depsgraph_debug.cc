@@ -22,6 +22,7 @@
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_type.h"
+#include "intern/eval/deg_eval_stats.h"
 #include "intern/node/deg_node_component.h"
 #include "intern/node/deg_node_id.h"
 #include "intern/node/deg_node_time.h"
@@ -52,6 +53,23 @@ const char *DEG_debug_name_get(struct Depsgraph *depsgraph)
   return deg_graph->debug.name.c_str();
 }
 
+void DEG_debug_eval_timeline_capture(Depsgraph *depsgraph, const int frames_num)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(depsgraph);
+  BLI_assert(!deg_graph->is_evaluating);
+  delete deg_graph->eval_timeline;
+  deg_graph->eval_timeline = (frames_num > 0) ? new deg::EvalTimeline(frames_num) : nullptr;
+}
+
+bool DEG_debug_eval_timeline_write(const Depsgraph *depsgraph, FILE *fp)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(depsgraph);
+  if (deg_graph->eval_timeline == nullptr) {
+    return false;
+  }
+  return deg_graph->eval_timeline->write_chrome_trace(fp);
+}
+
 bool DEG_debug_compare(const struct Depsgraph *graph1, const struct Depsgraph *graph2)
 {
   BLI_assert(graph1 != nullptr);
@@ -9,6 +9,11 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+#include <mutex>
+
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
@@ -16,6 +21,7 @@
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.h"
 
@@ -52,6 +58,7 @@ namespace {
 struct DepsgraphEvalState;
 
 void deg_task_run_func(TaskPool *pool, void *taskdata);
+void deg_task_run_prioritized_func(TaskPool *pool, void *taskdata);
 
 void schedule_children(DepsgraphEvalState *state,
                        OperationNode *node,
@@ -80,22 +87,50 @@ enum class EvaluationStage {
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Not null when the evaluation timeline is captured. */
+  EvalTimeline *timeline = nullptr;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
+
+  /* When true, operations which are ready for evaluation are collected in #ready_operations and
+   * the ones with the longest remaining path of dependent operations are evaluated first. */
+  bool use_critical_path_priority = false;
+  /* Max-heap of operations ordered by #OperationNode::critical_path_time. Every operation in the
+   * heap has one task in the pool, which evaluates the operation with the highest priority. */
+  Vector<OperationNode *> ready_operations;
+  std::mutex ready_operations_mutex;
 };
 
+/* Weight of the last evaluation time in the moving average of operation evaluation times. */
+constexpr float EVAL_TIME_ESTIMATE_FACTOR = 0.25f;
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
+  MEM_TagScope mem_tag(MEM_TAG_DEPSGRAPH);
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_stats || state->use_critical_path_priority || state->timeline) {
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    const double end_time = PIL_check_seconds_timer();
+    const double eval_time = end_time - start_time;
+    if (state->timeline) {
+      state->timeline->add_event(operation_node, start_time, end_time);
+    }
+    if (state->do_stats) {
+      operation_node->stats.current_time += eval_time;
+    }
+    if (state->use_critical_path_priority) {
+      /* Only the thread evaluating the operation writes to the estimate. */
+      float &estimate = operation_node->eval_time_estimate;
+      estimate = (estimate == 0.0f) ?
+                     float(eval_time) :
+                     estimate + (float(eval_time) - estimate) * EVAL_TIME_ESTIMATE_FACTOR;
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -123,6 +158,45 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   });
 }
 
+bool operation_priority_less(const OperationNode *a, const OperationNode *b)
+{
+  return a->critical_path_time < b->critical_path_time;
+}
+
+/* Add an operation which is ready for evaluation to the priority queue. */
+void push_ready_operation(DepsgraphEvalState *state, TaskPool *pool, OperationNode *node)
+{
+  {
+    std::lock_guard lock{state->ready_operations_mutex};
+    state->ready_operations.append(node);
+    std::push_heap(
+        state->ready_operations.begin(), state->ready_operations.end(), operation_priority_less);
+  }
+  BLI_task_pool_push(pool, deg_task_run_prioritized_func, nullptr, false, nullptr);
+}
+
+void deg_task_run_prioritized_func(TaskPool *pool, void * /*taskdata*/)
+{
+  void *userdata_v = BLI_task_pool_user_data(pool);
+  DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
+
+  /* The task does not evaluate the operation it was pushed for, but the ready operation with
+   * the highest priority. There is one task per ready operation, so all of them are evaluated. */
+  OperationNode *operation_node;
+  {
+    std::lock_guard lock{state->ready_operations_mutex};
+    BLI_assert(!state->ready_operations.is_empty());
+    std::pop_heap(
+        state->ready_operations.begin(), state->ready_operations.end(), operation_priority_less);
+    operation_node = state->ready_operations.pop_last();
+  }
+  evaluate_node(state, operation_node);
+
+  schedule_children(state, operation_node, [&](OperationNode *node) {
+    push_ready_operation(state, pool, node);
+  });
+}
+
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
 {
   const ComponentNode *comp_node = op_node->owner;
@@ -306,6 +380,72 @@ void schedule_children(DepsgraphEvalState *state,
   }
 }
 
+/* Operation is going to be evaluated in the current stage, assuming its dependencies are. */
+bool is_operation_pending_evaluation(const DepsgraphEvalState *state, OperationNode *node)
+{
+  return (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) && check_operation_node_visible(state, node);
+}
+
+enum {
+  CRITICAL_PATH_NOT_VISITED = 0,
+  CRITICAL_PATH_IN_PROGRESS = 1,
+  CRITICAL_PATH_DONE = 2,
+};
+
+/* Calculate #OperationNode::critical_path_time of all operations which need to be evaluated,
+ * based on the evaluation times measured in previous evaluations. */
+void calculate_critical_path_times(DepsgraphEvalState *state)
+{
+  for (OperationNode *node : state->graph->operations) {
+    node->custom_flags = CRITICAL_PATH_NOT_VISITED;
+  }
+
+  const auto is_dependency_pending = [&](const Relation *rel) {
+    return (rel->flag & RELATION_FLAG_CYCLIC) == 0 &&
+           is_operation_pending_evaluation(state, (OperationNode *)rel->to);
+  };
+
+  /* Depth-first traversal along the outgoing relations, which calculates the time of the
+   * children of an operation before the operation itself. An explicit stack is used since
+   * chains of operations can be very long. */
+  struct StackItem {
+    OperationNode *node;
+    int64_t next_link;
+  };
+  Vector<StackItem> stack;
+  for (OperationNode *root : state->graph->operations) {
+    if (root->custom_flags != CRITICAL_PATH_NOT_VISITED ||
+        !is_operation_pending_evaluation(state, root)) {
+      continue;
+    }
+    root->custom_flags = CRITICAL_PATH_IN_PROGRESS;
+    stack.append({root, 0});
+    while (!stack.is_empty()) {
+      StackItem &item = stack.last();
+      OperationNode *node = item.node;
+      if (item.next_link < node->outlinks.size()) {
+        const Relation *rel = node->outlinks[item.next_link++];
+        OperationNode *child = (OperationNode *)rel->to;
+        if (child->custom_flags == CRITICAL_PATH_NOT_VISITED && is_dependency_pending(rel)) {
+          child->custom_flags = CRITICAL_PATH_IN_PROGRESS;
+          stack.append({child, 0});
+        }
+        continue;
+      }
+      float max_child_time = 0.0f;
+      for (const Relation *rel : node->outlinks) {
+        const OperationNode *child = (const OperationNode *)rel->to;
+        if (child->custom_flags == CRITICAL_PATH_DONE && is_dependency_pending(rel)) {
+          max_child_time = std::max(max_child_time, child->critical_path_time);
+        }
+      }
+      node->critical_path_time = node->eval_time_estimate + max_child_time;
+      node->custom_flags = CRITICAL_PATH_DONE;
+      stack.remove_last();
+    }
+  }
+}
+
 /* Evaluate given stage of the dependency graph evaluation using multiple threads.
  *
  * NOTE: Will assign the `state->stage` to the given stage. */
@@ -317,10 +457,25 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
-    BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  /* Prioritizing is only worth it for the main evaluation stage, the other stages only contain
+   * few and cheap operations. */
+  state->use_critical_path_priority = stage == EvaluationStage::THREADED_EVALUATION &&
+                                      (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) == 0 &&
+                                      BLI_task_scheduler_num_threads() > 1;
+
+  if (state->use_critical_path_priority) {
+    calculate_critical_path_times(state);
+    schedule_graph(state,
+                   [&](OperationNode *node) { push_ready_operation(state, task_pool, node); });
+  }
+  else {
+    schedule_graph(state, [&](OperationNode *node) {
+      BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
+    });
+  }
   BLI_task_pool_work_and_wait(task_pool);
+
+  state->use_critical_path_priority = false;
 }
 
 /* Evaluate remaining operations of the dependency graph in a single threaded manner. */
@@ -399,6 +554,10 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  state.timeline = graph->eval_timeline;
+  if (state.timeline) {
+    state.timeline->begin_frame(graph->ctime);
+  }
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -453,6 +612,9 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.timeline) {
+    state.timeline->end_frame();
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
@@ -9,6 +9,8 @@
 
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #include "intern/depsgraph.h"
 
 #include "intern/node/deg_node.h"
@@ -38,4 +40,117 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+EvalTimeline::EvalTimeline(const int frames_max)
+    : frames_max_(max(frames_max, 1)), thread_events_([this]() {
+        return ThreadEvents{threads_num_.fetch_add(1, std::memory_order_relaxed), {}};
+      })
+{
+}
+
+void EvalTimeline::begin_frame(const float ctime)
+{
+  frame_begin_time_ = PIL_check_seconds_timer();
+  if (start_time_ < 0.0) {
+    start_time_ = frame_begin_time_;
+  }
+  frame_ctime_ = ctime;
+}
+
+void EvalTimeline::add_event(const OperationNode *operation_node,
+                             const double begin_time,
+                             const double end_time)
+{
+  thread_events_.local().events.append({operation_node, begin_time, end_time});
+}
+
+void EvalTimeline::end_frame()
+{
+  Frame frame;
+  frame.ctime = frame_ctime_;
+  frame.begin_time = frame_begin_time_ - start_time_;
+  frame.end_time = PIL_check_seconds_timer() - start_time_;
+  /* Resolve the names now, the operations might not exist anymore when the timeline is written. */
+  for (ThreadEvents &thread_events : thread_events_) {
+    for (const RawEvent &raw_event : thread_events.events) {
+      frame.events.append({raw_event.operation_node->full_identifier(),
+                           raw_event.begin_time - start_time_,
+                           raw_event.end_time - start_time_,
+                           thread_events.thread});
+    }
+    thread_events.events.clear();
+  }
+  std::sort(frame.events.begin(), frame.events.end(), [](const Event &a, const Event &b) {
+    return a.begin_time < b.begin_time;
+  });
+
+  if (frames_.size() < frames_max_) {
+    frames_.append(std::move(frame));
+  }
+  else {
+    frames_[next_frame_] = std::move(frame);
+  }
+  next_frame_ = (next_frame_ + 1) % frames_max_;
+}
+
+static void write_json_string(FILE *file, const StringRef str)
+{
+  fputc('"', file);
+  for (const char c : str) {
+    if (ELEM(c, '"', '\\')) {
+      fputc('\\', file);
+      fputc(c, file);
+    }
+    else if (uchar(c) < 0x20) {
+      fprintf(file, "\\u%04x", int(c));
+    }
+    else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+bool EvalTimeline::write_chrome_trace(FILE *file) const
+{
+  if (frames_.is_empty()) {
+    return false;
+  }
+  /* Time stamps are in microseconds. Thread 0 shows the evaluated frames, the threads evaluating
+   * operations start at 1. */
+  fprintf(file, "{\"traceEvents\":[\n");
+  fprintf(file,
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+          "\"args\":{\"name\":\"Evaluation\"}}");
+  for (const int thread : IndexRange(threads_num_.load(std::memory_order_relaxed))) {
+    fprintf(file,
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"Thread %d\"}}",
+            thread + 1,
+            thread);
+  }
+  /* Write the frames from oldest to newest. */
+  for (const int i : frames_.index_range()) {
+    const Frame &frame = frames_[(next_frame_ + i) % frames_.size()];
+    fprintf(file,
+            ",\n{\"name\":\"Frame %g\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+            "\"ts\":%.3f,\"dur\":%.3f}",
+            frame.ctime,
+            frame.begin_time * 1e6,
+            (frame.end_time - frame.begin_time) * 1e6);
+    for (const Event &event : frame.events) {
+      fprintf(file, ",\n{\"name\":");
+      write_json_string(file, event.name);
+      fprintf(file,
+              ",\"cat\":\"operation\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,"
+              "\"dur\":%.3f,\"args\":{\"frame\":%g}}",
+              event.thread + 1,
+              event.begin_time * 1e6,
+              (event.end_time - event.begin_time) * 1e6,
+              frame.ctime);
+    }
+  }
+  fprintf(file, "\n]}\n");
+  return true;
+}
+
 }  // namespace blender::deg
@@ -7,11 +7,81 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdio>
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_vector.hh"
+
+#include "intern/depsgraph_type.h"
+
 namespace blender::deg {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/**
+ * Capture of the evaluation timeline: which operation was evaluated when and on which thread.
+ * Only the last few evaluations are kept, so the capture can be enabled while interacting with the
+ * scene, and written to a file afterwards to inspect thread utilization and stalls.
+ */
+class EvalTimeline {
+ public:
+  struct Event {
+    string name;
+    /* Time in seconds, relative to the first captured evaluation. */
+    double begin_time;
+    double end_time;
+    int thread;
+  };
+
+  struct Frame {
+    float ctime;
+    double begin_time;
+    double end_time;
+    Vector<Event> events;
+  };
+
+  explicit EvalTimeline(int frames_max);
+
+  /* Called around every evaluation of the graph. */
+  void begin_frame(float ctime);
+  void end_frame();
+
+  /* Record the evaluation of an operation, can be called from any thread. */
+  void add_event(const OperationNode *operation_node, double begin_time, double end_time);
+
+  /**
+   * Write the captured frames in the Chrome trace event format, which is supported by
+   * `chrome://tracing` and Perfetto. Returns false when there is nothing to write.
+   */
+  bool write_chrome_trace(FILE *file) const;
+
+ private:
+  struct RawEvent {
+    const OperationNode *operation_node;
+    double begin_time;
+    double end_time;
+  };
+  struct ThreadEvents {
+    int thread;
+    Vector<RawEvent> events;
+  };
+
+  int frames_max_;
+  /* Ring buffer of the last #frames_max_ frames, #next_frame_ is the slot that is used next. */
+  Vector<Frame> frames_;
+  int next_frame_ = 0;
+
+  double start_time_ = -1.0;
+  double frame_begin_time_ = 0.0;
+  float frame_ctime_ = 0.0f;
+
+  std::atomic<int> threads_num_ = 0;
+  threading::EnumerableThreadSpecific<ThreadEvents> thread_events_;
+};
+
 }  // namespace blender::deg
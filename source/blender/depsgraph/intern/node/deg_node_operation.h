@@ -271,6 +271,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Moving average of the evaluation time of this operation in seconds, measured during threaded
+   * evaluation. */
+  float eval_time_estimate;
+  /* Estimated time in seconds from the start of this operation until the end of the longest chain
+   * of operations depending on it. Operations on the critical path are scheduled first. */
+  float critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
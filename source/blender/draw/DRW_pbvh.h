@@ -71,6 +71,9 @@ typedef struct PBVH_GPU_Args {
   /* BMesh. */
   struct GSet *bm_unique_vert, *bm_other_verts, *bm_faces;
   int cd_mask_layer;
+
+  /* Only fill the mask and color buffers again in #DRW_pbvh_node_update. */
+  bool update_only_mask_and_color;
 } PBVH_GPU_Args;
 
 typedef struct PBVHGPUFormat PBVHGPUFormat;
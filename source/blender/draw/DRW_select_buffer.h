@@ -66,6 +66,8 @@ typedef struct SELECTID_Context {
 
   /* To check for updates. */
   float persmat[4][4];
+  /** View settings the drawing depends on, see #select_engine_view_flag_get. */
+  short view_flag;
   bool is_dirty;
 } SELECTID_Context;
 
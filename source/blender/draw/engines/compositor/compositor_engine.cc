@@ -184,12 +184,16 @@ class Engine {
     evaluator_.reset();
   }
 
-  /* If the compositor node tree changed, reset the evaluator. */
+  /* If the compositor node tree changed, reset the evaluator. If images changed, only evaluate
+   * the static operations again, since they might read still images. */
   void update(const Depsgraph *depsgraph)
   {
     if (DEG_id_type_updated(depsgraph, ID_NT)) {
       evaluator_.reset();
     }
+    else if (DEG_id_type_updated(depsgraph, ID_IM)) {
+      evaluator_.reset_static_operations();
+    }
   }
 };
 
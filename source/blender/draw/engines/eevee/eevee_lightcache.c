@@ -60,6 +60,12 @@
   (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_X) * \
       (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_Y)
 
+/**
+ * Maximum number of probe samples rendered with the same scene synchronization. Bigger batches
+ * hold the draw manager for longer, which makes cancelling the bake less responsive.
+ */
+#define LIGHTBAKE_SAMPLE_BATCH_LEN 16
+
 /* TODO: should be replace by a more elegant alternative. */
 extern void DRW_opengl_context_enable(void);
 extern void DRW_opengl_context_disable(void);
@@ -112,10 +118,12 @@ typedef struct EEVEE_LightBake {
   int irr_size[3];
   /** Total for all grids */
   int total_irr_samples;
-  /** Nth sample of the current grid being rendered. */
+  /** First sample of the current grid being rendered. */
   int grid_sample;
   /** Total number of samples for the current grid. */
   int grid_sample_len;
+  /** Number of samples of the current grid rendered in the current batch. */
+  int grid_sample_batch_len;
   /** Nth grid in the cache being rendered. */
   int grid_curr;
   /** The current light bounce being evaluated. */
@@ -132,8 +140,10 @@ typedef struct EEVEE_LightBake {
   EEVEE_LightProbe *cube;
   /** Target cube-map at MIP 0. */
   int ref_cube_res;
-  /** Index of the current cube. */
+  /** Index of the first cube of the current batch. */
   int cube_offset;
+  /** Number of cubes rendered in the current batch. */
+  int cube_batch_len;
   /** Pointer to the owner_id of the probe object. */
   LightProbe **cube_prb;
 
@@ -1124,33 +1134,22 @@ static void grid_loc_to_world_loc(EEVEE_LightGrid *egrid, const int local_cell[3
   madd_v3_v3fl(r_pos, egrid->increment_z, local_cell[2]);
 }
 
-static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
+static void eevee_lightbake_render_grid_sample_single(EEVEE_ViewLayerData *sldata,
+                                                      EEVEE_Data *vedata,
+                                                      EEVEE_LightBake *lbake,
+                                                      LightCache *lcache,
+                                                      const int grid_sample)
 {
-  EEVEE_Data *vedata = (EEVEE_Data *)ved;
-  EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
   EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
-  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   EEVEE_LightGrid *egrid = lbake->grid;
   LightProbe *prb = *lbake->probe;
-  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
-  LightCache *lcache = scene_eval->eevee.light_cache_data;
   int grid_loc[3], sample_id, sample_offset, stride;
   float pos[3];
-  const bool is_last_bounce_sample = ((egrid->offset + lbake->grid_sample) ==
+  const bool is_last_bounce_sample = ((egrid->offset + grid_sample) ==
                                       (lbake->total_irr_samples - 1));
 
-  /* No bias for rendering the probe. */
-  egrid->level_bias = 1.0f;
-
-  /* Use the previous bounce for rendering this bounce. */
-  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
-
-  /* TODO: do this once for the whole bake when we have independent DRWManagers.
-   * WARNING: Some of the things above require this. */
-  eevee_lightbake_cache_create(vedata, lbake);
-
   /* Compute sample position */
-  compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
+  compute_cell_id(egrid, prb, grid_sample, &sample_id, grid_loc, &stride);
   sample_offset = egrid->offset + sample_id;
 
   grid_loc_to_world_loc(egrid, grid_loc, pos);
@@ -1167,6 +1166,9 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   }
   GPU_uniformbuf_update(sldata->common_ubo, &sldata->common_data);
 
+  /* Use the previous bounce for rendering this bounce. */
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
   EEVEE_lightbake_render_scene(sldata, vedata, lbake->rt_fb, pos, prb->clipsta, prb->clipend);
 
   /* Restore before filtering. */
@@ -1204,11 +1206,40 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
 
   /* If it is the last sample grid sample (and last bounce). */
   if ((lbake->bounce_curr == lbake->bounce_len - 1) && (lbake->grid_curr == lbake->grid_len - 1) &&
-      (lbake->grid_sample == lbake->grid_sample_len - 1)) {
+      (grid_sample == lbake->grid_sample_len - 1)) {
     lcache->flag &= ~LIGHTCACHE_UPDATE_GRID;
   }
 }
 
+static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
+{
+  EEVEE_Data *vedata = (EEVEE_Data *)ved;
+  EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
+  LightCache *lcache = scene_eval->eevee.light_cache_data;
+
+  /* No bias for rendering the probe. */
+  lbake->grid->level_bias = 1.0f;
+
+  /* Use the previous bounce for rendering this bounce. */
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  /* TODO: do this once for the whole bake when we have independent DRWManagers.
+   * WARNING: Some of the things above require this.
+   * The samples of a batch all belong to the same grid and bounce, so they can share the scene
+   * synchronization. The bias of the grid is only uploaded here, so it stays at 1.0 while the
+   * batch is rendered. */
+  eevee_lightbake_cache_create(vedata, lbake);
+
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  for (int i = 0; i < lbake->grid_sample_batch_len; i++) {
+    eevee_lightbake_render_grid_sample_single(
+        sldata, vedata, lbake, lcache, lbake->grid_sample + i);
+  }
+}
+
 static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
@@ -1217,41 +1248,68 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
   LightCache *lcache = scene_eval->eevee.light_cache_data;
-  EEVEE_LightProbe *eprobe = lbake->cube;
-  LightProbe *prb = *lbake->probe;
   float clamp = scene_eval->eevee.gi_glossy_clamp;
   float filter_quality = scene_eval->eevee.gi_filter_quality;
 
-  /* TODO: do this once for the whole bake when we have independent DRWManagers. */
+  /* TODO: do this once for the whole bake when we have independent DRWManagers.
+   * The probes of a batch share their visibility collection, so they can share the scene
+   * synchronization. */
   eevee_lightbake_cache_create(vedata, lbake);
 
-  /* Disable specular lighting when rendering probes to avoid feedback loops (looks bad). */
-  common_data->spec_toggle = false;
-  common_data->sss_toggle = false;
-  common_data->prb_num_planar = 0;
-  common_data->prb_num_render_cube = 0;
-  common_data->ray_type = EEVEE_RAY_GLOSSY;
-  common_data->ray_depth = 1;
-  GPU_uniformbuf_update(sldata->common_ubo, &sldata->common_data);
-
-  EEVEE_lightbake_render_scene(
-      sldata, vedata, lbake->rt_fb, eprobe->position, prb->clipsta, prb->clipend);
-  EEVEE_lightbake_filter_glossy(sldata,
-                                vedata,
-                                lbake->rt_color,
-                                lbake->store_fb,
-                                lbake->cube_offset,
-                                prb->intensity,
-                                lcache->mips_len,
-                                filter_quality,
-                                clamp);
-
-  lcache->cube_len += 1;
+  for (int i = 0; i < lbake->cube_batch_len; i++) {
+    EEVEE_LightProbe *eprobe = lbake->cube + i;
+    LightProbe *prb = lbake->probe[i];
+    const int cube_offset = lbake->cube_offset + i;
+
+    /* Disable specular lighting when rendering probes to avoid feedback loops (looks bad). */
+    common_data->spec_toggle = false;
+    common_data->sss_toggle = false;
+    common_data->prb_num_planar = 0;
+    common_data->prb_num_render_cube = 0;
+    common_data->ray_type = EEVEE_RAY_GLOSSY;
+    common_data->ray_depth = 1;
+    GPU_uniformbuf_update(sldata->common_ubo, &sldata->common_data);
+
+    EEVEE_lightbake_render_scene(
+        sldata, vedata, lbake->rt_fb, eprobe->position, prb->clipsta, prb->clipend);
+    EEVEE_lightbake_filter_glossy(sldata,
+                                  vedata,
+                                  lbake->rt_color,
+                                  lbake->store_fb,
+                                  cube_offset,
+                                  prb->intensity,
+                                  lcache->mips_len,
+                                  filter_quality,
+                                  clamp);
+
+    lcache->cube_len += 1;
+
+    /* If it's the last probe. */
+    if (cube_offset == lbake->cube_len - 1) {
+      lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
+    }
+  }
+}
 
-  /* If it's the last probe. */
-  if (lbake->cube_offset == lbake->cube_len - 1) {
-    lcache->flag &= ~LIGHTCACHE_UPDATE_CUBE;
+/**
+ * Number of reflection probes starting at the current one that can be rendered in one batch.
+ */
+static int eevee_lightbake_cube_batch_len(const EEVEE_LightBake *lbake)
+{
+  const LightProbe *prb_first = lbake->probe[0];
+  const int remaining = min_ii(LIGHTBAKE_SAMPLE_BATCH_LEN, lbake->cube_len - lbake->cube_offset);
+  int batch_len = 1;
+  while (batch_len < remaining) {
+    const LightProbe *prb = lbake->probe[batch_len];
+    /* The visibility collection is used when populating the scene. */
+    if (prb->visibility_grp != prb_first->visibility_grp ||
+        (prb->flag & LIGHTPROBE_FLAG_INVERT_GROUP) !=
+            (prb_first->flag & LIGHTPROBE_FLAG_INVERT_GROUP)) {
+      break;
+    }
+    batch_len++;
   }
+  return batch_len;
 }
 
 static float eevee_lightbake_grid_influence_volume(EEVEE_LightGrid *grid)
@@ -1368,7 +1426,8 @@ void EEVEE_lightbake_update(void *custom_data)
 }
 
 static bool lightbake_do_sample(EEVEE_LightBake *lbake,
-                                void (*render_callback)(void *ved, void *user_data))
+                                void (*render_callback)(void *ved, void *user_data),
+                                const int samples_len)
 {
   if (G.is_break == true || *lbake->stop) {
     return false;
@@ -1379,7 +1438,7 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instantiable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
+  lbake->done += samples_len;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = true;
   eevee_lightbake_context_disable(lbake);
@@ -1443,7 +1502,7 @@ void EEVEE_lightbake_job(void *custom_data, bool *stop, bool *do_update, float *
   /* Render world irradiance and reflection first */
   if (lcache->flag & LIGHTCACHE_UPDATE_WORLD) {
     lbake->probe = NULL;
-    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample);
+    lightbake_do_sample(lbake, eevee_lightbake_render_world_sample, 1);
   }
 
   /* Render irradiance grids */
@@ -1458,8 +1517,11 @@ void EEVEE_lightbake_job(void *custom_data, bool *stop, bool *do_update, float *
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
         for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+             lbake->grid_sample += lbake->grid_sample_batch_len) {
+          lbake->grid_sample_batch_len = min_ii(LIGHTBAKE_SAMPLE_BATCH_LEN,
+                                                lbake->grid_sample_len - lbake->grid_sample);
+          lightbake_do_sample(
+              lbake, eevee_lightbake_render_grid_sample, lbake->grid_sample_batch_len);
         }
       }
     }
@@ -1471,8 +1533,10 @@ void EEVEE_lightbake_job(void *custom_data, bool *stop, bool *do_update, float *
     lbake->probe = lbake->cube_prb + 1;
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
-         lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+         lbake->cube_offset += lbake->cube_batch_len, lbake->probe += lbake->cube_batch_len,
+         lbake->cube += lbake->cube_batch_len) {
+      lbake->cube_batch_len = eevee_lightbake_cube_batch_len(lbake);
+      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample, lbake->cube_batch_len);
     }
   }
 
@@ -11,6 +11,10 @@
 
 #include "UI_resources.h"
 
+#include "DEG_depsgraph_query.h"
+
+#include "ED_view3d.h"
+
 #include "DRW_engine.h"
 #include "DRW_select_buffer.h"
 
@@ -68,6 +72,24 @@ static void select_engine_framebuffer_setup(void)
   }
 }
 
+/**
+ * Settings of the view that change the drawn indices without changing #RegionView3D.persmat.
+ */
+static short select_engine_view_flag_get(const View3D *v3d, const RegionView3D *rv3d)
+{
+  enum {
+    SELECT_VIEW_XRAY = (1 << 0),
+    SELECT_VIEW_FACE_DOT = (1 << 1),
+    SELECT_VIEW_CLIPPING = (1 << 2),
+  };
+  short flag = 0;
+  SET_FLAG_FROM_TEST(flag, XRAY_FLAG_ENABLED(v3d), SELECT_VIEW_XRAY);
+  SET_FLAG_FROM_TEST(
+      flag, v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_FACE_DOT, SELECT_VIEW_FACE_DOT);
+  SET_FLAG_FROM_TEST(flag, RV3D_CLIPPING_ENABLED(v3d, rv3d), SELECT_VIEW_CLIPPING);
+  return flag;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -166,15 +188,17 @@ static void select_cache_init(void *vedata)
 
   /* Check if the viewport has changed. */
   float(*persmat)[4] = draw_ctx->rv3d->persmat;
-  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON);
+  const short view_flag = select_engine_view_flag_get(draw_ctx->v3d, draw_ctx->rv3d);
+  e_data.context.is_dirty = !compare_m4m4(e_data.context.persmat, persmat, FLT_EPSILON) ||
+                            e_data.context.view_flag != view_flag;
 
   if (!e_data.context.is_dirty) {
-    /* Check if any of the drawn objects have been transformed. */
+    /* Check if any of the drawn objects have been transformed or their geometry changed. */
     Object **ob = &e_data.context.objects_drawn[0];
     for (uint i = e_data.context.objects_drawn_len; i--; ob++) {
       DrawData *data = DRW_drawdata_get(&(*ob)->id, &draw_engine_select_type);
-      if (data && (data->recalc & ID_RECALC_TRANSFORM) != 0) {
-        data->recalc &= ~ID_RECALC_TRANSFORM;
+      if (data && (data->recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY)) != 0) {
+        data->recalc &= ~(ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY);
         e_data.context.is_dirty = true;
       }
     }
@@ -183,6 +207,7 @@ static void select_cache_init(void *vedata)
   if (e_data.context.is_dirty) {
     /* Remove all tags from drawn or culled objects. */
     copy_m4_m4(e_data.context.persmat, persmat);
+    e_data.context.view_flag = view_flag;
     e_data.context.objects_drawn_len = 0;
     e_data.context.index_drawn_len = 1;
     select_engine_framebuffer_setup();
@@ -260,7 +285,14 @@ static void select_cache_populate(void *vedata, Object *ob)
     e_data.context.objects_drawn_len++;
     e_data.runtime_new_objects++;
   }
-  else if (sel_data) {
+  else {
+    /* Keep the draw-data of culled objects too, its recalc flags tell whether they may have
+     * moved into the view, see #DRW_select_engine_buffer_is_valid. */
+    if (sel_data == NULL) {
+      sel_data = (SELECTID_ObjectData *)DRW_drawdata_ensure(
+          &ob->id, &draw_engine_select_type, sizeof(SELECTID_ObjectData), NULL, NULL);
+    }
+    sel_data->dd.recalc = 0;
     sel_data->is_drawn = false;
   }
 }
@@ -383,6 +415,32 @@ GPUTexture *DRW_engine_select_texture_get(void)
   return e_data.texture_u32;
 }
 
+bool DRW_select_engine_buffer_is_valid(struct Depsgraph *depsgraph,
+                                       const struct ARegion *region,
+                                       const struct View3D *v3d)
+{
+  const SELECTID_Context *select_ctx = &e_data.context;
+  const RegionView3D *rv3d = region->regiondata;
+  if (e_data.texture_u32 == NULL || select_ctx->select_mode == -1 ||
+      GPU_texture_width(e_data.texture_u32) != region->winx ||
+      GPU_texture_height(e_data.texture_u32) != region->winy ||
+      !compare_m4m4(select_ctx->persmat, rv3d->persmat, FLT_EPSILON) ||
+      select_ctx->view_flag != select_engine_view_flag_get(v3d, rv3d)) {
+    return false;
+  }
+
+  /* Objects outside of the view were culled but still tagged, so moving them into the view is
+   * detected as well. */
+  for (uint i = 0; i < select_ctx->objects_len; i++) {
+    Object *ob_eval = DEG_get_evaluated_object(depsgraph, select_ctx->objects[i]);
+    const DrawData *data = DRW_drawdata_get(&ob_eval->id, &draw_engine_select_type);
+    if (data == NULL || (data->recalc & (ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /** \} */
 
 #undef SELECT_ENGINE
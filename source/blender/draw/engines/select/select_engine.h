@@ -22,3 +22,10 @@ struct SELECTID_Context *DRW_select_engine_context_get(void);
 
 struct GPUFrameBuffer *DRW_engine_select_framebuffer_get(void);
 struct GPUTexture *DRW_engine_select_texture_get(void);
+/**
+ * Check whether the selection buffer drawn for the current context is still up to date, so it
+ * can be read without drawing it again.
+ */
+bool DRW_select_engine_buffer_is_valid(struct Depsgraph *depsgraph,
+                                       const struct ARegion *region,
+                                       const struct View3D *v3d);
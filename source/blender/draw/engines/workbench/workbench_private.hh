@@ -93,6 +93,11 @@ struct SceneState {
   bool reset_taa_next_sample = false;
   bool render_finished = false;
 
+  /** Time of the previous redraw while navigating, to measure the navigation frame time. */
+  double navigation_time_prev = 0.0;
+  /** Skip the costly effects while navigating, because the frames are too slow. */
+  bool navigation_reduce_quality = false;
+
   /* Used when material_type == eMaterialType::SINGLE */
   Material material_override = Material(float3(1.0f));
   /* When r == -1.0 the shader uses the vertex color */
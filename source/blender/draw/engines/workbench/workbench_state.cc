@@ -14,9 +14,17 @@
 #include "ED_paint.h"
 #include "ED_view3d.h"
 #include "GPU_capabilities.h"
+#include "PIL_time.h"
 
 namespace blender::workbench {
 
+/**
+ * Navigation frames slower than this (in seconds) make the following navigation frames skip the
+ * costly effects. They are only enabled again once the frames are twice as fast, so the quality
+ * doesn't toggle on every frame.
+ */
+static constexpr double navigation_frame_time_max = 1.0 / 20.0;
+
 void SceneState::init(Object *camera_ob /*= nullptr*/)
 {
   bool reset_taa = reset_taa_next_sample;
@@ -127,6 +135,25 @@ void SceneState::init(Object *camera_ob /*= nullptr*/)
     reset_taa_next_sample = true;
   }
 
+  if (is_navigating) {
+    const double time = PIL_check_seconds_timer();
+    if (navigation_time_prev != 0.0) {
+      const double frame_time = time - navigation_time_prev;
+      if (frame_time > navigation_frame_time_max) {
+        navigation_reduce_quality = true;
+      }
+      else if (frame_time < navigation_frame_time_max * 0.5) {
+        navigation_reduce_quality = false;
+      }
+    }
+    navigation_time_prev = time;
+  }
+  else {
+    /* Full quality resumes when the view stops, the TAA is restarted at that point anyway. */
+    navigation_time_prev = 0.0;
+    navigation_reduce_quality = false;
+  }
+
   int _samples_len = U.viewport_aa;
   if (v3d && ELEM(v3d->shading.type, OB_RENDER, OB_MATERIAL)) {
     _samples_len = scene->display.viewport_aa;
@@ -170,6 +197,15 @@ void SceneState::init(Object *camera_ob /*= nullptr*/)
   draw_dof = camera && camera->dof.flag & CAM_DOF_ENABLED &&
              shading.flag & V3D_SHADING_DEPTH_OF_FIELD;
 
+  if (navigation_reduce_quality) {
+    /* Shadows draw all casters a second time, cavity and depth of field are costly full screen
+     * passes. */
+    draw_cavity = false;
+    draw_curvature = false;
+    draw_shadows = false;
+    draw_dof = false;
+  }
+
   draw_transparent_depth = draw_outline || draw_dof;
   draw_object_id = draw_outline || draw_curvature;
 };
@@ -419,6 +419,7 @@ BLI_INLINE void extract_task_range_run_iter(const MeshRenderData *mr,
 
 static void extract_task_range_run(void *__restrict taskdata)
 {
+  MEM_TagScope mem_tag(MEM_TAG_DRAW);
   ExtractTaskData *data = (ExtractTaskData *)taskdata;
   const eMRIterType iter_type = data->iter_type;
   const bool is_mesh = data->mr->extract_type != MR_EXTRACT_BMESH;
@@ -514,6 +515,7 @@ static void mesh_render_data_update_task_data_free(void *data)
 
 static void mesh_extract_render_data_node_exec(void *__restrict task_data)
 {
+  MEM_TagScope mem_tag(MEM_TAG_DRAW);
   MeshRenderDataUpdateTaskData *update_task_data = static_cast<MeshRenderDataUpdateTaskData *>(
       task_data);
   MeshRenderData *mr = update_task_data->mr;
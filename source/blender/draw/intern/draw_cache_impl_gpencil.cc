@@ -25,6 +25,8 @@
 #include "BLI_hash.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_polyfill_2d.h"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
 
 #include "draw_cache.h"
 #include "draw_cache_impl.h"
@@ -39,6 +41,15 @@
 /** \name Internal Types
  * \{ */
 
+/** Layout of a visible stroke in the vertex buffer. */
+struct GpencilBatchCacheStroke {
+  const bGPDstroke *gps;
+  /** Number of vertices, including the adjacency points. */
+  int vert_len;
+  /** Number of fill triangles. */
+  int tri_len;
+};
+
 struct GpencilBatchCache {
   /** Instancing Data */
   GPUVertBuf *vbo;
@@ -61,6 +72,10 @@ struct GpencilBatchCache {
   GPUBatch *edit_curve_handles_batch;
   GPUBatch *edit_curve_points_batch;
 
+  /** Visible strokes in vertex buffer order, used to only update the strokes that changed. */
+  GpencilBatchCacheStroke *strokes;
+  int strokes_len;
+
   /** Cache is dirty */
   bool is_dirty;
   /** Last cache frame */
@@ -134,15 +149,24 @@ static void gpencil_batch_cache_clear(GpencilBatchCache *cache)
   GPU_BATCH_DISCARD_SAFE(cache->edit_curve_points_batch);
   GPU_VERTBUF_DISCARD_SAFE(cache->edit_curve_vbo);
 
+  MEM_SAFE_FREE(cache->strokes);
+  cache->strokes_len = 0;
+
   cache->is_dirty = true;
 }
 
+static bool gpencil_batch_cache_update_strokes(Object *ob, GpencilBatchCache *cache, int cfra);
+
 static GpencilBatchCache *gpencil_batch_cache_get(Object *ob, int cfra)
 {
   bGPdata *gpd = (bGPdata *)ob->data;
 
   GpencilBatchCache *cache = gpd->runtime.gpencil_cache;
   if (!gpencil_batch_cache_valid(cache, gpd, cfra)) {
+    if (cache && cfra == cache->cache_frame &&
+        gpencil_batch_cache_update_strokes(ob, cache, cfra)) {
+      return cache;
+    }
     gpencil_batch_cache_clear(cache);
     return gpencil_batch_cache_init(ob, cfra);
   }
@@ -258,6 +282,8 @@ struct gpIterData {
   int vert_len;
   int tri_len;
   int curve_len;
+  /** Optional, filled with the layout of the visible strokes when counting. */
+  blender::Vector<GpencilBatchCacheStroke> *strokes;
 };
 
 static GPUVertBuf *gpencil_dummy_buffer_get()
@@ -294,8 +320,7 @@ BLI_INLINE int32_t pack_rotation_aspect_hardness(float rot, float asp, float har
   return packed;
 }
 
-static void gpencil_buffer_add_point(GPUIndexBufBuilder *ibo,
-                                     gpStrokeVert *verts,
+static void gpencil_buffer_add_point(gpStrokeVert *verts,
                                      gpColorVert *cols,
                                      const bGPDstroke *gps,
                                      const bGPDspoint *pt,
@@ -329,18 +354,9 @@ static void gpencil_buffer_add_point(GPUIndexBufBuilder *ibo,
 
   vert->packed_asp_hard_rot = pack_rotation_aspect_hardness(
       pt->uv_rot, aspect_ratio, gps->hardeness);
-
-  if (!is_endpoint) {
-    /* Issue a Quad per point. */
-    /* The attribute loading uses a different shader and will undo this bit packing. */
-    int v_mat = (v << GP_VERTEX_ID_SHIFT) | GP_IS_STROKE_VERTEX_BIT;
-    GPU_indexbuf_add_tri_verts(ibo, v_mat + 0, v_mat + 1, v_mat + 2);
-    GPU_indexbuf_add_tri_verts(ibo, v_mat + 2, v_mat + 1, v_mat + 3);
-  }
 }
 
-static void gpencil_buffer_add_stroke(GPUIndexBufBuilder *ibo,
-                                      gpStrokeVert *verts,
+static void gpencil_buffer_add_stroke(gpStrokeVert *verts,
                                       gpColorVert *cols,
                                       const bGPDstroke *gps)
 {
@@ -351,14 +367,14 @@ static void gpencil_buffer_add_stroke(GPUIndexBufBuilder *ibo,
 
   /* First point for adjacency (not drawn). */
   int adj_idx = (is_cyclic) ? (pts_len - 1) : min_ii(pts_len - 1, 1);
-  gpencil_buffer_add_point(ibo, verts, cols, gps, &pts[adj_idx], v++, true);
+  gpencil_buffer_add_point(verts, cols, gps, &pts[adj_idx], v++, true);
 
   for (int i = 0; i < pts_len; i++) {
-    gpencil_buffer_add_point(ibo, verts, cols, gps, &pts[i], v++, false);
+    gpencil_buffer_add_point(verts, cols, gps, &pts[i], v++, false);
   }
   /* Draw line to first point to complete the loop for cyclic strokes. */
   if (is_cyclic) {
-    gpencil_buffer_add_point(ibo, verts, cols, gps, &pts[0], v, false);
+    gpencil_buffer_add_point(verts, cols, gps, &pts[0], v, false);
     /* UV factor needs to be adjusted for the last point to not be equal to the UV factor of the
      * first point. It should be the factor of the last point plus the distance from the last point
      * to the first.
@@ -369,7 +385,20 @@ static void gpencil_buffer_add_stroke(GPUIndexBufBuilder *ibo,
   }
   /* Last adjacency point (not drawn). */
   adj_idx = (is_cyclic) ? 1 : max_ii(0, pts_len - 2);
-  gpencil_buffer_add_point(ibo, verts, cols, gps, &pts[adj_idx], v++, true);
+  gpencil_buffer_add_point(verts, cols, gps, &pts[adj_idx], v++, true);
+}
+
+static void gpencil_buffer_add_stroke_indices(GPUIndexBufBuilder *ibo, const bGPDstroke *gps)
+{
+  /* Issue a Quad per point, the adjacency points at both ends are not drawn. */
+  int v = gps->runtime.vertex_start + 1;
+  int v_end = v + gps->totpoints + gpencil_stroke_is_cyclic(gps);
+  for (; v < v_end; v++) {
+    /* The attribute loading uses a different shader and will undo this bit packing. */
+    int v_mat = (v << GP_VERTEX_ID_SHIFT) | GP_IS_STROKE_VERTEX_BIT;
+    GPU_indexbuf_add_tri_verts(ibo, v_mat + 0, v_mat + 1, v_mat + 2);
+    GPU_indexbuf_add_tri_verts(ibo, v_mat + 2, v_mat + 1, v_mat + 3);
+  }
 }
 
 static void gpencil_buffer_add_fill(GPUIndexBufBuilder *ibo, const bGPDstroke *gps)
@@ -395,7 +424,9 @@ static void gpencil_stroke_iter_cb(bGPDlayer * /*gpl*/,
   if (gps->tot_triangles > 0) {
     gpencil_buffer_add_fill(&iter->ibo, gps);
   }
-  gpencil_buffer_add_stroke(&iter->ibo, iter->verts, iter->cols, gps);
+  gpencil_buffer_add_stroke_indices(&iter->ibo, gps);
+  gpencil_buffer_add_stroke(iter->verts, iter->cols, gps);
+  gps->runtime.is_updated = false;
 }
 
 static void gpencil_object_verts_count_cb(bGPDlayer * /*gpl*/,
@@ -413,6 +444,35 @@ static void gpencil_object_verts_count_cb(bGPDlayer * /*gpl*/,
   iter->tri_len += gps->tot_triangles;
   gps->runtime.stroke_start = iter->tri_len;
   iter->tri_len += stroke_vert_len * 2;
+
+  if (iter->strokes) {
+    iter->strokes->append({gps, 1 + stroke_vert_len + 1, gps->tot_triangles});
+  }
+}
+
+static void gpencil_batch_cache_vbos_create(GpencilBatchCache *cache, int vert_len)
+{
+  /* Keep the data on the host, so that the batch cache can be updated partially. */
+  GPUUsageType vbo_flag = GPU_USAGE_DYNAMIC | GPU_USAGE_FLAG_BUFFER_TEXTURE_ONLY;
+  GPUVertFormat *format = gpencil_stroke_format();
+  GPUVertFormat *format_col = gpencil_color_format();
+  cache->vbo = GPU_vertbuf_create_with_format_ex(format, vbo_flag);
+  cache->vbo_col = GPU_vertbuf_create_with_format_ex(format_col, vbo_flag);
+  /* Add extra space at the end of the buffer because of quad load. */
+  GPU_vertbuf_data_alloc(cache->vbo, vert_len + 2);
+  GPU_vertbuf_data_alloc(cache->vbo_col, vert_len + 2);
+}
+
+static void gpencil_batch_cache_strokes_set(GpencilBatchCache *cache,
+                                            blender::Span<GpencilBatchCacheStroke> strokes)
+{
+  MEM_SAFE_FREE(cache->strokes);
+  cache->strokes_len = int(strokes.size());
+  if (!strokes.is_empty()) {
+    cache->strokes = (GpencilBatchCacheStroke *)MEM_malloc_arrayN(
+        strokes.size(), sizeof(GpencilBatchCacheStroke), __func__);
+    memcpy(cache->strokes, strokes.data(), sizeof(GpencilBatchCacheStroke) * strokes.size());
+  }
 }
 
 static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfra)
@@ -431,6 +491,7 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     bool do_onion = true;
 
     /* First count how many vertices and triangles are needed for the whole object. */
+    blender::Vector<GpencilBatchCacheStroke> strokes;
     gpIterData iter = {};
     iter.gpd = gpd;
     iter.verts = nullptr;
@@ -438,18 +499,12 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     iter.vert_len = 0;
     iter.tri_len = 0;
     iter.curve_len = 0;
+    iter.strokes = &strokes;
     BKE_gpencil_visible_stroke_advanced_iter(
         nullptr, ob, nullptr, gpencil_object_verts_count_cb, &iter, do_onion, cfra);
 
-    GPUUsageType vbo_flag = GPU_USAGE_STATIC | GPU_USAGE_FLAG_BUFFER_TEXTURE_ONLY;
     /* Create VBOs. */
-    GPUVertFormat *format = gpencil_stroke_format();
-    GPUVertFormat *format_col = gpencil_color_format();
-    cache->vbo = GPU_vertbuf_create_with_format_ex(format, vbo_flag);
-    cache->vbo_col = GPU_vertbuf_create_with_format_ex(format_col, vbo_flag);
-    /* Add extra space at the end of the buffer because of quad load. */
-    GPU_vertbuf_data_alloc(cache->vbo, iter.vert_len + 2);
-    GPU_vertbuf_data_alloc(cache->vbo_col, iter.vert_len + 2);
+    gpencil_batch_cache_vbos_create(cache, iter.vert_len);
     iter.verts = (gpStrokeVert *)GPU_vertbuf_get_data(cache->vbo);
     iter.cols = (gpColorVert *)GPU_vertbuf_get_data(cache->vbo_col);
     /* Create IBO. */
@@ -474,11 +529,170 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     GPU_vertbuf_use(cache->vbo);
     GPU_vertbuf_use(cache->vbo_col);
 
+    gpencil_batch_cache_strokes_set(cache, strokes);
+    gpd->runtime.batch_cache_partial_update = true;
     gpd->flag &= ~GP_DATA_CACHE_IS_DIRTY;
     cache->is_dirty = false;
   }
 }
 
+/**
+ * Update the batch cache after update-on-write only changed the strokes tagged with
+ * `bGPDstroke_Runtime.is_updated`, instead of rebuilding it for all strokes. Only the vertices of
+ * the tagged strokes are written and uploaded again. Strokes that were added after the last
+ * visible stroke are appended, which requires new vertex buffers, but the vertices of the other
+ * strokes are copied from the previous ones.
+ *
+ * \return false if the visible strokes changed in any other way and the cache has to be rebuilt.
+ */
+static bool gpencil_batch_cache_update_strokes(Object *ob, GpencilBatchCache *cache, int cfra)
+{
+  using namespace blender;
+  bGPdata *gpd = (bGPdata *)ob->data;
+
+  if (!gpd->runtime.batch_cache_partial_update || cache->vbo == nullptr) {
+    return false;
+  }
+
+  /* IMPORTANT: Keep in sync with gpencil_batches_ensure() */
+  bool do_onion = true;
+
+  /* Count again, this also sets the runtime offsets of the strokes copied by update-on-write. */
+  Vector<GpencilBatchCacheStroke> strokes;
+  gpIterData iter = {};
+  iter.gpd = gpd;
+  iter.strokes = &strokes;
+  BKE_gpencil_visible_stroke_advanced_iter(
+      nullptr, ob, nullptr, gpencil_object_verts_count_cb, &iter, do_onion, cfra);
+
+  /* The previous strokes have to keep their place in the buffers. */
+  const Span<GpencilBatchCacheStroke> old_strokes(cache->strokes, cache->strokes_len);
+  if (strokes.size() < old_strokes.size()) {
+    return false;
+  }
+  for (const int i : old_strokes.index_range()) {
+    if (strokes[i].gps != old_strokes[i].gps || strokes[i].vert_len != old_strokes[i].vert_len ||
+        strokes[i].tri_len != old_strokes[i].tri_len) {
+      return false;
+    }
+  }
+
+  const bool has_new_strokes = strokes.size() > old_strokes.size();
+  /* The stroke indices only depend on the layout, but the fill triangles may have changed. */
+  bool update_indices = has_new_strokes;
+  for (const GpencilBatchCacheStroke &stroke : strokes.as_span().take_front(old_strokes.size())) {
+    if (stroke.gps->runtime.is_updated && stroke.tri_len > 0) {
+      update_indices = true;
+      break;
+    }
+  }
+
+  /* Selection and edit curves may have changed as well, the edit batches are created again when
+   * needed. The wire-frame batch uses the vertex buffer. */
+  GPU_BATCH_DISCARD_SAFE(cache->edit_lines_batch);
+  GPU_BATCH_DISCARD_SAFE(cache->edit_points_batch);
+  GPU_VERTBUF_DISCARD_SAFE(cache->edit_vbo);
+  GPU_BATCH_DISCARD_SAFE(cache->edit_curve_handles_batch);
+  GPU_BATCH_DISCARD_SAFE(cache->edit_curve_points_batch);
+  GPU_VERTBUF_DISCARD_SAFE(cache->edit_curve_vbo);
+  if (update_indices || has_new_strokes) {
+    GPU_BATCH_DISCARD_SAFE(cache->geom_batch);
+    GPU_BATCH_DISCARD_SAFE(cache->lines_batch);
+  }
+
+  if (has_new_strokes) {
+    GPUVertBuf *old_vbo = cache->vbo;
+    GPUVertBuf *old_vbo_col = cache->vbo_col;
+    const int old_vert_len = strokes[old_strokes.size()].gps->runtime.vertex_start;
+
+    gpencil_batch_cache_vbos_create(cache, iter.vert_len);
+    gpStrokeVert *verts = (gpStrokeVert *)GPU_vertbuf_get_data(cache->vbo);
+    gpColorVert *cols = (gpColorVert *)GPU_vertbuf_get_data(cache->vbo_col);
+    memcpy(verts, GPU_vertbuf_get_data(old_vbo), sizeof(*verts) * old_vert_len);
+    memcpy(cols, GPU_vertbuf_get_data(old_vbo_col), sizeof(*cols) * old_vert_len);
+    GPU_vertbuf_discard(old_vbo);
+    GPU_vertbuf_discard(old_vbo_col);
+
+    for (const int i : strokes.index_range()) {
+      bGPDstroke *gps = const_cast<bGPDstroke *>(strokes[i].gps);
+      if (i >= old_strokes.size() || gps->runtime.is_updated) {
+        gpencil_buffer_add_stroke(verts, cols, gps);
+        gps->runtime.is_updated = false;
+      }
+    }
+    /* Mark last 2 verts as invalid. */
+    for (int i = 0; i < 2; i++) {
+      verts[iter.vert_len + i].mat = -1;
+    }
+    GPU_vertbuf_use(cache->vbo);
+    GPU_vertbuf_use(cache->vbo_col);
+  }
+  else {
+    gpStrokeVert *verts = (gpStrokeVert *)GPU_vertbuf_get_data(cache->vbo);
+    gpColorVert *cols = (gpColorVert *)GPU_vertbuf_get_data(cache->vbo_col);
+    /* Upload the vertices of consecutive updated strokes at once. */
+    int range_start = 0;
+    int range_len = 0;
+    auto upload_range = [&]() {
+      if (range_len == 0) {
+        return;
+      }
+      /* Binds the buffer, which the partial upload is done to. */
+      GPU_vertbuf_use(cache->vbo);
+      GPU_vertbuf_update_sub(cache->vbo,
+                             uint(sizeof(*verts) * range_start),
+                             uint(sizeof(*verts) * range_len),
+                             &verts[range_start]);
+      GPU_vertbuf_use(cache->vbo_col);
+      GPU_vertbuf_update_sub(cache->vbo_col,
+                             uint(sizeof(*cols) * range_start),
+                             uint(sizeof(*cols) * range_len),
+                             &cols[range_start]);
+      range_len = 0;
+    };
+
+    for (const GpencilBatchCacheStroke &stroke : strokes) {
+      bGPDstroke *gps = const_cast<bGPDstroke *>(stroke.gps);
+      if (!gps->runtime.is_updated) {
+        continue;
+      }
+      gpencil_buffer_add_stroke(verts, cols, gps);
+      gps->runtime.is_updated = false;
+
+      const int vertex_start = gps->runtime.vertex_start;
+      if (range_len > 0 && range_start + range_len != vertex_start) {
+        upload_range();
+      }
+      if (range_len == 0) {
+        range_start = vertex_start;
+      }
+      range_len += stroke.vert_len;
+    }
+    upload_range();
+  }
+
+  if (update_indices) {
+    GPU_INDEXBUF_DISCARD_SAFE(cache->ibo);
+    GPUIndexBufBuilder ibo;
+    GPU_indexbuf_init(&ibo, GPU_PRIM_TRIS, iter.tri_len, 0xFFFFFFFFu);
+    for (const GpencilBatchCacheStroke &stroke : strokes) {
+      if (stroke.tri_len > 0) {
+        gpencil_buffer_add_fill(&ibo, stroke.gps);
+      }
+      gpencil_buffer_add_stroke_indices(&ibo, stroke.gps);
+    }
+    cache->ibo = GPU_indexbuf_build(&ibo);
+  }
+  if (cache->geom_batch == nullptr) {
+    cache->geom_batch = GPU_batch_create(GPU_PRIM_TRIS, cache->vbo, cache->ibo);
+  }
+
+  gpencil_batch_cache_strokes_set(cache, strokes);
+  gpd->flag &= ~GP_DATA_CACHE_IS_DIRTY;
+  cache->is_dirty = false;
+  return true;
+}
+
 GPUBatch *DRW_cache_gpencil_get(Object *ob, int cfra)
 {
   GpencilBatchCache *cache = gpencil_batch_cache_get(ob, cfra);
@@ -662,7 +876,8 @@ static void gpencil_sbuffer_stroke_ensure(bGPdata *gpd, bool do_fill)
     }
 
     /* Fill buffers with data. */
-    gpencil_buffer_add_stroke(&ibo_builder, verts, cols, gps);
+    gpencil_buffer_add_stroke_indices(&ibo_builder, gps);
+    gpencil_buffer_add_stroke(verts, cols, gps);
 
     GPUBatch *batch = GPU_batch_create_ex(GPU_PRIM_TRIS,
                                           gpencil_dummy_buffer_get(),
@@ -729,6 +729,44 @@ static void mesh_batch_cache_discard_uvedit_select(MeshBatchCache *cache)
   mesh_batch_cache_discard_batch(cache, batch_map);
 }
 
+/* Free the buffers that depend on vertex positions, the buffers that only depend on topology or
+ * on other attributes are kept. */
+static void mesh_batch_cache_discard_deform(MeshBatchCache *cache)
+{
+  if (cache->subdiv_cache) {
+    /* The GPU subdivision buffers are all derived from the positions. */
+    cache->is_dirty = true;
+    return;
+  }
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.skin_roots);
+  }
+  DRWBatchFlag batch_map = BATCH_MAP(vbo.pos_nor,
+                                     vbo.lnor,
+                                     vbo.edge_fac,
+                                     vbo.tan,
+                                     vbo.edituv_stretch_area,
+                                     vbo.edituv_stretch_angle,
+                                     vbo.mesh_analysis,
+                                     vbo.fdots_pos,
+                                     vbo.fdots_nor,
+                                     vbo.skin_roots);
+  mesh_batch_cache_discard_batch(cache, batch_map);
+
+  /* Computed again when extracting the stretch area. */
+  cache->tot_area = 0.0f;
+  cache->tot_uv_area = 0.0f;
+}
+
 void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
 {
   MeshBatchCache *cache = static_cast<MeshBatchCache *>(me->runtime->batch_cache);
@@ -762,6 +800,9 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
     case BKE_MESH_BATCH_DIRTY_ALL:
       cache->is_dirty = true;
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      mesh_batch_cache_discard_deform(cache);
+      break;
     case BKE_MESH_BATCH_DIRTY_SHADING:
       mesh_batch_cache_discard_shaded_tri(cache);
       mesh_batch_cache_discard_uvedit(cache);
@@ -1654,6 +1654,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   Scene *scene = DEG_get_evaluated_scene(depsgraph);
   ViewLayer *view_layer = DEG_get_evaluated_view_layer(depsgraph);
   RegionView3D *rv3d = region->regiondata;
+  const eMemTag prev_mem_tag = MEM_tag_set(MEM_TAG_DRAW);
 
   BKE_view_layer_synced_ensure(scene, view_layer);
   DST.draw_ctx.evil_C = evil_C;
@@ -1787,6 +1788,8 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   drw_engines_disable();
 
   drw_manager_exit(&DST);
+
+  MEM_tag_set(prev_mem_tag);
 }
 
 void DRW_draw_render_loop(struct Depsgraph *depsgraph,
@@ -1970,6 +1973,7 @@ void DRW_render_to_image(RenderEngine *engine, struct Depsgraph *depsgraph)
   RenderEngineType *engine_type = engine->type;
   DrawEngineType *draw_engine_type = engine_type->draw_engine;
   Render *render = engine->re;
+  const eMemTag prev_mem_tag = MEM_tag_set(MEM_TAG_DRAW);
 
   /* IMPORTANT: We don't support immediate mode in render mode!
    * This shall remain in effect until immediate mode supports
@@ -2049,6 +2053,8 @@ void DRW_render_to_image(RenderEngine *engine, struct Depsgraph *depsgraph)
 
   /* End GPU workload Boundary */
   GPU_render_end();
+
+  MEM_tag_set(prev_mem_tag);
 }
 
 void DRW_render_object_iter(
@@ -2734,6 +2740,7 @@ void DRW_draw_select_id(Depsgraph *depsgraph, ARegion *region, View3D *v3d, cons
     sel_ctx->is_dirty = true;
     sel_ctx->objects_drawn_len = 0;
     sel_ctx->index_drawn_len = 1;
+    zero_m4(sel_ctx->persmat);
     return;
   }
 
@@ -2763,8 +2770,11 @@ void DRW_draw_select_id(Depsgraph *depsgraph, ARegion *region, View3D *v3d, cons
   UI_SetTheme(SPACE_VIEW3D, RGN_TYPE_WINDOW);
   DRW_globals_update();
 
-  /* Init Select Engine */
-  sel_ctx->last_rect = *rect;
+  /* Init Select Engine.
+   * Draw the indices of all objects in the view instead of only the ones in `rect`, so following
+   * reads of other regions don't have to draw again, see #DRW_select_engine_buffer_is_valid. */
+  UNUSED_VARS(rect);
+  BLI_rcti_init(&sel_ctx->last_rect, 0, region->winx, 0, region->winy);
 
   use_drw_engine(&draw_engine_select_type);
   drw_engines_init();
@@ -90,6 +90,10 @@ void Manager::end_sync()
 {
   GPU_debug_group_begin("Manager.end_sync");
 
+  /* Unique across all managers, because views can be used with different managers. */
+  static uint64_t sync_counter = 0;
+  sync_id_ = ++sync_counter;
+
   sync_layer_attributes();
 
   matrix_buf.current().push_update();
@@ -170,6 +174,7 @@ void Manager::submit(PassMain &pass, View &view)
   bool freeze_culling = (U.experimental.use_viewport_debug && DST.draw_ctx.v3d &&
                          (DST.draw_ctx.v3d->debug_flag & V3D_DEBUG_FREEZE_CULLING) != 0);
 
+  view.manager_sync_id_ = sync_id_;
   view.compute_visibility(bounds_buf.current(), resource_len_, freeze_culling);
 
   command::RecordingState state;
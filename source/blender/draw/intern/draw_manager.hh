@@ -106,6 +106,8 @@ class Manager {
  private:
   /** Number of resource handle recorded. */
   uint resource_len_ = 0;
+  /** Changes every time the resources are synced, to detect when visibility can be reused. */
+  uint64_t sync_id_ = 0;
   /** Number of object attribute recorded. */
   uint attribute_len_ = 0;
 
@@ -22,6 +22,8 @@
 #include "BKE_volume.h"
 
 /* For debug cursor position. */
+#include "ED_view3d.h"
+
 #include "WM_api.h"
 #include "wm_window.h"
 
@@ -1192,6 +1194,7 @@ struct DRWSculptCallbackData {
   bool use_mask;
   bool use_fsets;
   bool fast_mode; /* Set by draw manager. Do not init. */
+  const RegionView3D *rv3d; /* Set by draw manager. Do not init. */
 
   int debug_node_nr;
   PBVHAttrReq *attrs;
@@ -1211,6 +1214,39 @@ static float sculpt_debug_colors[9][4] = {
     {0.7f, 0.2f, 1.0f, 1.0f},
 };
 
+/** Grids smaller than this on screen are drawn with the coarse multires level. */
+#define SCULPT_COARSE_GRID_MAX_PIXELS 2.0f
+
+/**
+ * True when the grids of the node are so small on screen that drawing them at full resolution
+ * does not add any visible detail.
+ */
+static bool sculpt_grids_node_use_coarse(const DRWSculptCallbackData *scd,
+                                         const PBVH_GPU_Args *pbvh_draw_args)
+{
+  if (scd->rv3d == nullptr || pbvh_draw_args->pbvh_type != PBVH_GRIDS ||
+      pbvh_draw_args->ccg_key.level == 0 || pbvh_draw_args->totprim == 0) {
+    return false;
+  }
+
+  float bb_min[3], bb_max[3], center[3];
+  BKE_pbvh_node_get_BB(pbvh_draw_args->node, bb_min, bb_max);
+  mid_v3_v3v3(center, bb_min, bb_max);
+  mul_m4_v3(scd->ob->object_to_world, center);
+
+  const float pixel_size = ED_view3d_pixel_size_no_ui_scale(scd->rv3d, center);
+  if (pixel_size <= 0.0f) {
+    return false;
+  }
+
+  /* Rough size of a single grid, assuming the grids of the node are spread evenly over its
+   * bounds. */
+  const float node_size = len_v3v3(bb_min, bb_max) * mat4_to_scale(scd->ob->object_to_world);
+  const float grid_size = node_size / sqrtf(float(pbvh_draw_args->totprim));
+
+  return grid_size / pixel_size < SCULPT_COARSE_GRID_MAX_PIXELS;
+}
+
 static void sculpt_draw_cb(DRWSculptCallbackData *scd,
                            PBVHBatches *batches,
                            PBVH_GPU_Args *pbvh_draw_args)
@@ -1222,13 +1258,16 @@ static void sculpt_draw_cb(DRWSculptCallbackData *scd,
   int primcount;
   GPUBatch *geom;
 
+  const bool do_coarse_grids = scd->fast_mode ||
+                               sculpt_grids_node_use_coarse(scd, pbvh_draw_args);
+
   if (!scd->use_wire) {
     geom = DRW_pbvh_tris_get(
-        batches, scd->attrs, scd->attrs_num, pbvh_draw_args, &primcount, scd->fast_mode);
+        batches, scd->attrs, scd->attrs_num, pbvh_draw_args, &primcount, do_coarse_grids);
   }
   else {
     geom = DRW_pbvh_lines_get(
-        batches, scd->attrs, scd->attrs_num, pbvh_draw_args, &primcount, scd->fast_mode);
+        batches, scd->attrs, scd->attrs_num, pbvh_draw_args, &primcount, do_coarse_grids);
   }
 
   short index = 0;
@@ -1339,6 +1378,8 @@ static void drw_sculpt_generate_calls(DRWSculptCallbackData *scd)
   draw_frustum.planes = draw_planes;
   draw_frustum.num_planes = 6;
 
+  scd->rv3d = rv3d;
+
   /* Fast mode to show low poly multires while navigating. */
   scd->fast_mode = false;
   if (p && (p->flags & PAINT_FAST_NAVIGATE)) {
@@ -748,6 +748,11 @@ struct PBVHBatches {
     check_index_buffers(args);
 
     for (PBVHVbo &vbo : vbos) {
+      if (args->update_only_mask_and_color &&
+          !ELEM(vbo.type, CD_PBVH_MASK_TYPE, CD_PROP_COLOR, CD_PROP_BYTE_COLOR)) {
+        /* Leave the other buffers untouched, so that they are not uploaded again either. */
+        continue;
+      }
       fill_vbo(vbo, args);
     }
   }
@@ -56,8 +56,10 @@ uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
     struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
     DRW_opengl_context_enable();
-    /* Update the drawing. */
-    DRW_draw_select_id(depsgraph, region, v3d, rect);
+    /* Update the drawing, unless the indices drawn by a previous read are still valid. */
+    if (!DRW_select_engine_buffer_is_valid(depsgraph, region, v3d)) {
+      DRW_draw_select_id(depsgraph, region, v3d, rect);
+    }
 
     if (select_ctx->index_drawn_len > 1) {
       BLI_assert(region->winx == GPU_texture_width(DRW_engine_select_texture_get()) &&
@@ -461,6 +463,12 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
 {
   struct SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
+  bool is_same_context = select_ctx->objects_len == bases_len &&
+                         select_ctx->select_mode == select_mode;
+  for (uint base_index = 0; is_same_context && base_index < bases_len; base_index++) {
+    is_same_context = select_ctx->objects[base_index] == bases[base_index]->object;
+  }
+
   select_ctx->objects = MEM_reallocN(select_ctx->objects,
                                      sizeof(*select_ctx->objects) * bases_len);
 
@@ -480,7 +488,11 @@ void DRW_select_buffer_context_create(Base **bases, const uint bases_len, short
 
   select_ctx->objects_len = bases_len;
   select_ctx->select_mode = select_mode;
-  memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+  if (!is_same_context) {
+    /* Tag the drawing as outdated. Otherwise the indices drawn for the same objects are reused
+     * until the view or the objects change. */
+    memset(select_ctx->persmat, 0, sizeof(select_ctx->persmat));
+  }
 }
 
 /** \} */
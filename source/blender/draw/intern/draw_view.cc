@@ -29,6 +29,7 @@ void View::sync(const float4x4 &view_mat, const float4x4 &win_mat, int view_id)
   frustum_culling_sphere_calc(view_id);
 
   dirty_ = true;
+  visibility_dirty_ = true;
 }
 
 void View::sync(const DRWView *view)
@@ -223,6 +224,7 @@ void View::disable(IndexRange range)
   for (auto view_id : range) {
     reinterpret_cast<BoundSphere *>(&culling_[view_id].bound_sphere)->radius = -1.0f;
   }
+  visibility_dirty_ = true;
 }
 
 void View::bind()
@@ -267,9 +269,17 @@ void View::compute_visibility(ObjectBoundsBuf &bounds, uint resource_len, bool d
 #endif
   frozen_ = debug_freeze;
 
-  GPU_debug_group_begin("View.compute_visibility");
+  /* Multiple passes are often submitted with the same view and resources. Procedural views have
+   * their culling data computed on the GPU, so there is no way to know if it changed. */
+  if (!visibility_dirty_ && !procedural_ && !debug_freeze && !frozen_ &&
+      visibility_sync_id_ == manager_sync_id_ && visibility_resource_len_ == resource_len) {
+    return;
+  }
+  visibility_dirty_ = false;
+  visibility_sync_id_ = manager_sync_id_;
+  visibility_resource_len_ = resource_len;
 
-  /* TODO(fclem): Early out if visibility hasn't changed. */
+  GPU_debug_group_begin("View.compute_visibility");
 
   uint word_per_draw = this->visibility_word_per_draw();
   /* Switch between tightly packed and set of whole word per instance. */
@@ -53,6 +53,13 @@ class View {
   bool frozen_ = false;
   bool procedural_ = false;
 
+  /** Identifies the resources of the manager, set by the manager before computing visibility. */
+  uint64_t manager_sync_id_ = 0;
+  /** State of the last visibility computation, used to skip it if nothing changed since. */
+  uint64_t visibility_sync_id_ = 0;
+  uint visibility_resource_len_ = 0;
+  bool visibility_dirty_ = true;
+
  public:
   View(const char *name, int view_len = 1, bool procedural = false)
       : visibility_buf_(name), debug_name_(name), view_len_(view_len), procedural_(procedural)
@@ -7,6 +7,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_task.hh"
+
 #include "extract_mesh.hh"
 
 #include "draw_subdivision.h"
@@ -58,9 +60,12 @@ static void extract_pos_nor_init(const MeshRenderData *mr,
     }
   }
   else {
-    for (int v = 0; v < mr->vert_len; v++) {
-      data->normals[v].low = GPU_normal_convert_i10_v3(mr->vert_normals[v]);
-    }
+    /* The extraction of this buffer is done in parallel, but the initialization isn't. */
+    threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+      for (const int v : range) {
+        data->normals[v].low = GPU_normal_convert_i10_v3(mr->vert_normals[v]);
+      }
+    });
   }
 }
 
@@ -50,6 +50,8 @@ using namespace blender::bke::idprop;
  * \code
  * {
  *   "version": <file version number>,
+ *   "file_size": <size of the asset file>,
+ *   "file_modification_time": <modification time of the asset file>,
  *   "entries": [{
  *     "name": "<asset name>",
  *     "catalog_id": "<catalog_id>",
@@ -64,11 +66,18 @@ using namespace blender::bke::idprop;
  *
  * NOTE: entries, author, description, tags and properties are optional attributes.
  *
+ * NOTE: file_size and file_modification_time are only stored together with entries. They are
+ * compared with the current state of the asset file, so that an index is refreshed when the asset
+ * file is replaced by a different version with an older time stamp (e.g. when reverting to an
+ * older revision in a version control system).
+ *
  * NOTE: File browser uses name and idcode separate. Inside the index they are joined together like
  * #ID.name.
  * NOTE: File browser group name isn't stored in the index as it is a translatable name.
  */
 constexpr StringRef ATTRIBUTE_VERSION("version");
+constexpr StringRef ATTRIBUTE_FILE_SIZE("file_size");
+constexpr StringRef ATTRIBUTE_FILE_MODIFICATION_TIME("file_modification_time");
 constexpr StringRef ATTRIBUTE_ENTRIES("entries");
 constexpr StringRef ATTRIBUTE_ENTRIES_NAME("name");
 constexpr StringRef ATTRIBUTE_ENTRIES_CATALOG_ID("catalog_id");
@@ -94,6 +103,11 @@ class AbstractFile {
   {
     return BLI_file_size(get_file_path());
   }
+
+  bool stat(BLI_stat_t &r_stat) const
+  {
+    return BLI_stat(get_file_path(), &r_stat) != -1;
+  }
 };
 
 /**
@@ -514,6 +528,10 @@ struct AssetLibraryIndex {
     BLI_filelist_free(dir_entries, dir_entries_num);
   }
 
+  /**
+   * The map isn't modified while files are read, and every index belongs to a single asset file,
+   * so this can be called from multiple threads reading different files.
+   */
   void mark_as_used(const std::string &filename)
   {
     PreexistingFileIndexInfo *preexisting = preexisting_file_indices.lookup_ptr(filename);
@@ -607,13 +625,22 @@ struct AssetIndex {
    * Constructor for when creating/updating an asset index file.
    * #AssetIndex.contents are filled from the given \p indexer_entries.
    */
-  AssetIndex(const FileIndexerEntries &indexer_entries)
+  AssetIndex(const FileIndexerEntries &indexer_entries, const BlendFile &asset_file)
   {
     std::unique_ptr<DictionaryValue> root = std::make_unique<DictionaryValue>();
     DictionaryValue::Items &root_attributes = root->elements();
     root_attributes.append_as(std::pair(ATTRIBUTE_VERSION, new IntValue(CURRENT_VERSION)));
     init_value_from_file_indexer_entries(*root, indexer_entries);
 
+    /* Don't make indices without entries bigger than #MIN_FILE_SIZE_WITH_ENTRIES. */
+    BLI_stat_t stat = {};
+    if (root_attributes.size() > 1 && asset_file.stat(stat)) {
+      root_attributes.append_as(
+          std::pair(ATTRIBUTE_FILE_SIZE, new IntValue(int64_t(stat.st_size))));
+      root_attributes.append_as(
+          std::pair(ATTRIBUTE_FILE_MODIFICATION_TIME, new IntValue(int64_t(stat.st_mtime))));
+    }
+
     contents = std::move(root);
   }
 
@@ -644,6 +671,27 @@ struct AssetIndex {
     return get_version() == CURRENT_VERSION;
   }
 
+  /**
+   * Check whether the index was created from the current state of the given asset file. Indices
+   * that don't store the state of the asset file are assumed to match.
+   */
+  bool matches_file(const BlendFile &asset_file) const
+  {
+    const DictionaryValue::Lookup attributes = contents->as_dictionary_value()->create_lookup();
+    const DictionaryValue::LookupValue *size_value = attributes.lookup_ptr(ATTRIBUTE_FILE_SIZE);
+    const DictionaryValue::LookupValue *time_value = attributes.lookup_ptr(
+        ATTRIBUTE_FILE_MODIFICATION_TIME);
+    if (size_value == nullptr || time_value == nullptr) {
+      return true;
+    }
+    BLI_stat_t stat = {};
+    if (!asset_file.stat(stat)) {
+      return false;
+    }
+    return (*size_value)->as_int_value()->value() == int64_t(stat.st_size) &&
+           (*time_value)->as_int_value()->value() == int64_t(stat.st_mtime);
+  }
+
   /**
    * Extract the contents of this index into the given \p indexer_entries.
    *
@@ -718,8 +766,10 @@ class AssetIndexFile : public AbstractFile {
   bool ensure_parent_path_exists() const
   {
     /* `BLI_make_existing_file` only ensures parent path, otherwise than expected from the name of
-     * the function. */
-    return BLI_make_existing_file(get_file_path());
+     * the function. Indices are written from multiple threads, so another thread may have created
+     * the directory in the meantime. */
+    return BLI_make_existing_file(get_file_path()) ||
+           BLI_is_dir(library_index.indices_base_path.c_str());
   }
 
   void write_contents(AssetIndex &content)
@@ -836,6 +886,15 @@ static eFileIndexerResult read_index(const char *filename,
     return FILE_INDEXER_NEEDS_UPDATE;
   }
 
+  if (!contents->matches_file(asset_file)) {
+    CLOG_INFO(&LOG,
+              3,
+              "Asset index file [%s] needs to be refreshed as the asset file [%s] has changed.",
+              asset_index_file.filename.c_str(),
+              filename);
+    return FILE_INDEXER_NEEDS_UPDATE;
+  }
+
   const int read_entries_len = contents->extract_into(*entries);
   CLOG_INFO(&LOG, 1, "Read %d entries from asset index for [%s].", read_entries_len, filename);
   *r_read_entries_len = read_entries_len;
@@ -854,7 +913,7 @@ static void update_index(const char *filename, FileIndexerEntries *entries, void
             asset_file.get_file_path(),
             asset_index_file.get_file_path());
 
-  AssetIndex content(*entries);
+  AssetIndex content(*entries, asset_file);
   asset_index_file.write_contents(content);
 }
 
@@ -20,6 +20,9 @@ extern "C" {
  *
  * To implement a custom indexer a `FileIndexerType` struct should be made and passed to the
  * `filelist_setindexer` function.
+ *
+ * Blend files are read in parallel, so `read_index` and `update_index` can be called from
+ * multiple threads at the same time (for different files).
  */
 
 struct LinkNode;
@@ -0,0 +1,110 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup editor/io
+ */
+
+#include "BKE_context.h"
+#include "BKE_geometry_cache.hh"
+#include "BKE_geometry_set_instances.hh"
+#include "BKE_report.h"
+
+#include "BLI_path_util.h"
+
+#include "DEG_depsgraph_query.h"
+
+#include "DNA_object_types.h"
+#include "DNA_space_types.h"
+
+#include "ED_fileselect.h"
+
+#include "GEO_realize_instances.hh"
+
+#include "RNA_access.h"
+#include "RNA_define.h"
+
+#include "WM_api.h"
+#include "WM_types.h"
+
+#include "io_geometry_cache.h"
+
+static bool wm_geometry_cache_export_poll(bContext *C)
+{
+  const Object *object = CTX_data_active_object(C);
+  return object != nullptr && ELEM(object->type, OB_MESH, OB_CURVES, OB_POINTCLOUD);
+}
+
+static int wm_geometry_cache_export_invoke(bContext *C,
+                                           wmOperator *op,
+                                           const wmEvent * /*event*/)
+{
+  ED_fileselect_ensure_default_filepath(C, op, GEOMETRY_CACHE_FILE_EXTENSION);
+
+  WM_event_add_fileselect(C, op);
+  return OPERATOR_RUNNING_MODAL;
+}
+
+static int wm_geometry_cache_export_exec(bContext *C, wmOperator *op)
+{
+  using namespace blender;
+  if (!RNA_struct_property_is_set_ex(op->ptr, "filepath", false)) {
+    BKE_report(op->reports, RPT_ERROR, "No filename given");
+    return OPERATOR_CANCELLED;
+  }
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  const Object *object_eval = DEG_get_evaluated_object(depsgraph, CTX_data_active_object(C));
+  GeometrySet geometry_set = bke::object_get_evaluated_geometry_set(*object_eval);
+  geometry_set = geometry::realize_instances(std::move(geometry_set), {});
+
+  std::string error;
+  if (!bke::geometry_cache_write(geometry_set, filepath, error)) {
+    BKE_reportf(op->reports, RPT_ERROR, "Cannot write '%s': %s", filepath, error.c_str());
+    return OPERATOR_CANCELLED;
+  }
+  return OPERATOR_FINISHED;
+}
+
+static bool wm_geometry_cache_export_check(bContext * /*C*/, wmOperator *op)
+{
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+
+  if (!BLI_path_extension_check(filepath, GEOMETRY_CACHE_FILE_EXTENSION)) {
+    BLI_path_extension_ensure(filepath, FILE_MAX, GEOMETRY_CACHE_FILE_EXTENSION);
+    RNA_string_set(op->ptr, "filepath", filepath);
+    return true;
+  }
+  return false;
+}
+
+void WM_OT_geometry_cache_export(wmOperatorType *ot)
+{
+  PropertyRNA *prop;
+
+  ot->name = "Export Geometry Cache";
+  ot->description =
+      "Save the evaluated geometry of the active object to a geometry cache file, which can be "
+      "read with the Read Cache geometry node";
+  ot->idname = "WM_OT_geometry_cache_export";
+
+  ot->invoke = wm_geometry_cache_export_invoke;
+  ot->exec = wm_geometry_cache_export_exec;
+  ot->poll = wm_geometry_cache_export_poll;
+  ot->check = wm_geometry_cache_export_check;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER,
+                                 FILE_BLENDER,
+                                 FILE_SAVE,
+                                 WM_FILESEL_FILEPATH | WM_FILESEL_SHOW_PROPS,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+
+  /* Only show geometry cache files by default. */
+  prop = RNA_def_string(
+      ot->srna, "filter_glob", "*" GEOMETRY_CACHE_FILE_EXTENSION, 0, "Extension Filter", "");
+  RNA_def_property_flag(prop, PROP_HIDDEN);
+}
@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup editor/io
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct wmOperatorType;
+
+void WM_OT_geometry_cache_export(struct wmOperatorType *ot);
+
+#ifdef __cplusplus
+}
+#endif
@@ -22,8 +22,10 @@
 #endif
 
 #include "io_cache.h"
+#include "io_geometry_cache.h"
 #include "io_gpencil.h"
 #include "io_obj.h"
+#include "io_ply_ops.h"
 #include "io_stl_ops.h"
 
 void ED_operatortypes_io(void)
@@ -59,11 +61,18 @@ void ED_operatortypes_io(void)
   WM_operatortype_append(CACHEFILE_OT_layer_remove);
   WM_operatortype_append(CACHEFILE_OT_layer_move);
 
+  WM_operatortype_append(WM_OT_geometry_cache_export);
+
 #ifdef WITH_IO_WAVEFRONT_OBJ
   WM_operatortype_append(WM_OT_obj_export);
   WM_operatortype_append(WM_OT_obj_import);
 #endif
 
+#ifdef WITH_IO_PLY
+  WM_operatortype_append(WM_OT_ply_export);
+  WM_operatortype_append(WM_OT_ply_import);
+#endif
+
 #ifdef WITH_IO_STL
   WM_operatortype_append(WM_OT_stl_import);
 #endif
@@ -1656,6 +1656,13 @@ void EDBM_update(Mesh *mesh, const struct EDBMUpdate_Params *params)
   DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY);
   WM_main_add_notifier(NC_GEOM | ND_DATA, &mesh->id);
 
+  if (params->is_destructive && params->calc_looptri) {
+    /* Pack the elements after operators that removed many of them, so drawing and later
+     * operators iterate over contiguous memory. This changes all element pointers,
+     * so it must run before the tessellation is calculated. */
+    BM_mesh_compact_if_fragmented(em->bm);
+  }
+
   if (params->calc_normals && params->calc_looptri) {
     /* Calculating both has some performance gains. */
     BKE_editmesh_looptri_and_normals_calc(em);
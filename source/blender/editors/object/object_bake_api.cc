@@ -1343,7 +1343,29 @@ static void bake_targets_free(BakeTargets *targets)
 
 /* Main Bake Logic */
 
+/**
+ * We build a depsgraph for the baking, so we don't need to change the original data to adjust
+ * visibility and modifiers. The depsgraph is shared by all baked objects, so that a render engine
+ * with persistent data only has to synchronize the scene once.
+ */
+static Depsgraph *bake_depsgraph_new(const BakeAPIRender *bkr)
+{
+  /* Don't reuse an engine that was kept for a different depsgraph. */
+  RE_bake_engine_free(bkr->render);
+
+  Depsgraph *depsgraph = DEG_graph_new(bkr->main, bkr->scene, bkr->view_layer, DAG_EVAL_RENDER);
+  DEG_graph_build_from_view_layer(depsgraph);
+  return depsgraph;
+}
+
+static void bake_depsgraph_free(const BakeAPIRender *bkr, Depsgraph *depsgraph)
+{
+  RE_bake_engine_free(bkr->render);
+  DEG_graph_free(depsgraph);
+}
+
 static int bake(const BakeAPIRender *bkr,
+                Depsgraph *depsgraph,
                 Object *ob_low,
                 const ListBase *selected_objects,
                 ReportList *reports)
@@ -1351,12 +1373,6 @@ static int bake(const BakeAPIRender *bkr,
   Render *re = bkr->render;
   Main *bmain = bkr->main;
   Scene *scene = bkr->scene;
-  ViewLayer *view_layer = bkr->view_layer;
-
-  /* We build a depsgraph for the baking,
-   * so we don't need to change the original data to adjust visibility and modifiers. */
-  Depsgraph *depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_graph_build_from_view_layer(depsgraph);
 
   int op_result = OPERATOR_CANCELLED;
   bool ok = false;
@@ -1439,6 +1455,8 @@ static int bake(const BakeAPIRender *bkr,
     if (mmd_low) {
       mmd_flags_low = mmd_low->flags;
       mmd_low->uv_smooth = SUBSURF_UV_SMOOTH_NONE;
+      /* The depsgraph may already be evaluated for a previously baked object. */
+      DEG_graph_id_tag_update(bmain, depsgraph, &ob_low->id, ID_RECALC_GEOMETRY);
     }
   }
 
@@ -1717,6 +1735,7 @@ cleanup:
 
   if (mmd_low) {
     mmd_low->flags = mmd_flags_low;
+    DEG_graph_id_tag_update(bmain, depsgraph, &ob_low->id, ID_RECALC_GEOMETRY);
   }
 
   if (pixel_array_low) {
@@ -1737,8 +1756,6 @@ cleanup:
     BKE_id_free(nullptr, &me_cage_eval->id);
   }
 
-  DEG_graph_free(depsgraph);
-
   return op_result;
 }
 
@@ -1851,17 +1868,23 @@ static int bake_exec(bContext *C, wmOperator *op)
 
   RE_SetReports(re, bkr.reports);
 
-  if (bkr.is_selected_to_active) {
-    result = bake(&bkr, bkr.ob, &bkr.selected_objects, bkr.reports);
-  }
-  else {
-    CollectionPointerLink *link;
-    bkr.is_clear = bkr.is_clear && BLI_listbase_is_single(&bkr.selected_objects);
-    for (link = static_cast<CollectionPointerLink *>(bkr.selected_objects.first); link;
-         link = link->next) {
-      Object *ob_iter = static_cast<Object *>(link->ptr.data);
-      result = bake(&bkr, ob_iter, nullptr, bkr.reports);
+  {
+    Depsgraph *depsgraph = bake_depsgraph_new(&bkr);
+
+    if (bkr.is_selected_to_active) {
+      result = bake(&bkr, depsgraph, bkr.ob, &bkr.selected_objects, bkr.reports);
+    }
+    else {
+      CollectionPointerLink *link;
+      bkr.is_clear = bkr.is_clear && BLI_listbase_is_single(&bkr.selected_objects);
+      for (link = static_cast<CollectionPointerLink *>(bkr.selected_objects.first); link;
+           link = link->next) {
+        Object *ob_iter = static_cast<Object *>(link->ptr.data);
+        result = bake(&bkr, depsgraph, ob_iter, nullptr, bkr.reports);
+      }
     }
+
+    bake_depsgraph_free(&bkr, depsgraph);
   }
 
   RE_SetReports(re, nullptr);
@@ -1905,8 +1928,10 @@ static void bake_startjob(void *bkv, bool * /*stop*/, bool *do_update, float *pr
     bake_targets_clear(bkr->main, is_tangent);
   }
 
+  Depsgraph *depsgraph = bake_depsgraph_new(bkr);
+
   if (bkr->is_selected_to_active) {
-    bkr->result = bake(bkr, bkr->ob, &bkr->selected_objects, bkr->reports);
+    bkr->result = bake(bkr, depsgraph, bkr->ob, &bkr->selected_objects, bkr->reports);
   }
   else {
     CollectionPointerLink *link;
@@ -1914,14 +1939,20 @@ static void bake_startjob(void *bkv, bool * /*stop*/, bool *do_update, float *pr
     for (link = static_cast<CollectionPointerLink *>(bkr->selected_objects.first); link;
          link = link->next) {
       Object *ob_iter = static_cast<Object *>(link->ptr.data);
-      bkr->result = bake(bkr, ob_iter, nullptr, bkr->reports);
+      bkr->result = bake(bkr, depsgraph, ob_iter, nullptr, bkr->reports);
 
       if (bkr->result == OPERATOR_CANCELLED) {
-        return;
+        break;
       }
     }
   }
 
+  bake_depsgraph_free(bkr, depsgraph);
+
+  if (bkr->result == OPERATOR_CANCELLED) {
+    return;
+  }
+
   RE_SetReports(bkr->render, nullptr);
 }
 
@@ -525,8 +525,6 @@ struct DensitySubtractOperationExecutor {
 
   CurvesSurfaceTransforms transforms_;
 
-  KDTree_3d *root_points_kdtree_;
-
   DensitySubtractOperationExecutor(const bContext &C) : ctx_(C)
   {
   }
@@ -584,14 +582,6 @@ struct DensitySubtractOperationExecutor {
       }
     }
 
-    root_points_kdtree_ = BLI_kdtree_3d_new(curve_selection_.size());
-    BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(root_points_kdtree_); });
-    for (const int curve_i : curve_selection_) {
-      const float3 &pos_cu = self_->deformed_root_positions_[curve_i];
-      BLI_kdtree_3d_insert(root_points_kdtree_, curve_i, pos_cu);
-    }
-    BLI_kdtree_3d_balance(root_points_kdtree_);
-
     /* Find all curves that should be deleted. */
     Array<bool> curves_to_delete(curves_->curves_num(), false);
     if (falloff_shape == PAINT_FALLOFF_SHAPE_TUBE) {
@@ -675,6 +665,9 @@ struct DensitySubtractOperationExecutor {
       }
     });
 
+    KDTree_3d *root_points_kdtree = this->removable_roots_kdtree_build(allow_remove_curve);
+    BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(root_points_kdtree); });
+
     /* Detect curves that are too close to other existing curves. */
     for (const int curve_i : curve_selection_) {
       if (curves_to_delete[curve_i]) {
@@ -692,7 +685,7 @@ struct DensitySubtractOperationExecutor {
         continue;
       }
       BLI_kdtree_3d_range_search_cb_cpp(
-          root_points_kdtree_,
+          root_points_kdtree,
           orig_pos_cu,
           minimum_distance_,
           [&](const int other_curve_i, const float * /*co*/, float /*dist_sq*/) {
@@ -762,6 +755,9 @@ struct DensitySubtractOperationExecutor {
       }
     });
 
+    KDTree_3d *root_points_kdtree = this->removable_roots_kdtree_build(allow_remove_curve);
+    BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(root_points_kdtree); });
+
     /* Detect curves that are too close to other existing curves. */
     for (const int curve_i : curve_selection_) {
       if (curves_to_delete[curve_i]) {
@@ -777,7 +773,7 @@ struct DensitySubtractOperationExecutor {
       }
 
       BLI_kdtree_3d_range_search_cb_cpp(
-          root_points_kdtree_,
+          root_points_kdtree,
           pos_cu,
           minimum_distance_,
           [&](const int other_curve_i, const float * /*co*/, float /*dist_sq*/) {
@@ -791,6 +787,28 @@ struct DensitySubtractOperationExecutor {
           });
     }
   }
+
+  /**
+   * Only curves that are allowed to be removed are affected by the search for curves that are
+   * too close to each other, so the other curves don't have to be inserted into the tree. This
+   * keeps the tree small, because usually only the curves in the brush can be removed.
+   */
+  KDTree_3d *removable_roots_kdtree_build(const Span<bool> allow_remove_curve) const
+  {
+    Vector<int64_t> indices;
+    const IndexMask removable_curves = index_mask_ops::find_indices_based_on_predicate(
+        curve_selection_, 4096, indices, [&](const int curve_i) {
+          return allow_remove_curve[curve_i];
+        });
+
+    KDTree_3d *kdtree = BLI_kdtree_3d_new(removable_curves.size());
+    for (const int curve_i : removable_curves) {
+      const float3 &pos_cu = self_->deformed_root_positions_[curve_i];
+      BLI_kdtree_3d_insert(kdtree, curve_i, pos_cu);
+    }
+    BLI_kdtree_3d_balance(kdtree);
+    return kdtree;
+  }
 };
 
 void DensitySubtractOperation::on_stroke_extended(const bContext &C,
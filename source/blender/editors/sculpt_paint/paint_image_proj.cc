@@ -18,6 +18,7 @@
 #  include "BLI_winstuff.h"
 #endif
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
@@ -25,8 +26,10 @@
 #include "BLI_math_color_blend.h"
 #include "BLI_memarena.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "atomic_ops.h"
 
@@ -2021,7 +2024,7 @@ static ProjPixel *project_paint_uvpixel_init(const ProjPaintState *ps,
       sub_v2_v2v2(co, projPixel->projCoSS, ps->cloneOffset);
 
       /* no need to initialize the bucket, we're only checking buckets faces and for this
-       * the faces are already initialized in project_paint_delayed_face_init(...) */
+       * the faces are already initialized in project_paint_delayed_faces_init(...) */
       if (ibuf->rect_float) {
         if (!project_paint_PickColor(
                 ps, co, ((ProjPixelClone *)projPixel)->clonepx.f, nullptr, true)) {
@@ -3570,7 +3573,7 @@ static void project_bucket_init(const ProjPaintState *ps,
  * will have its pixels calculated when it might not be needed later, (at the moment at least)
  * obviously it shouldn't have bugs though. */
 
-static bool project_bucket_face_isect(ProjPaintState *ps,
+static bool project_bucket_face_isect(const ProjPaintState *ps,
                                       int bucket_x,
                                       int bucket_y,
                                       const MLoopTri *lt)
@@ -3621,22 +3624,19 @@ static bool project_bucket_face_isect(ProjPaintState *ps,
   return false;
 }
 
-/* Add faces to the bucket but don't initialize its pixels
- * TODO: when painting occluded, sort the faces on their min-Z
- * and only add faces that faces that are not occluded */
-static void project_paint_delayed_face_init(ProjPaintState *ps,
+/* Find the buckets intersecting the face. */
+static void project_paint_face_buckets_find(const ProjPaintState *ps,
                                             const MLoopTri *lt,
-                                            const int tri_index)
+                                            blender::Vector<int> &r_bucket_indices)
 {
   const int lt_vtri[3] = {PS_LOOPTRI_AS_VERT_INDEX_3(ps, lt)};
-  float min[2], max[2], *vCoSS;
+  float min[2], max[2];
+  const float *vCoSS;
   /* for ps->bucketRect indexing */
   int bucketMin[2], bucketMax[2];
   int fidx, bucket_x, bucket_y;
   /* for early loop exit */
   int has_x_isect = -1, has_isect = 0;
-  /* just use the first thread arena since threading has not started yet */
-  MemArena *arena = ps->arena_mt[0];
 
   INIT_MINMAX2(min, max);
 
@@ -3652,11 +3652,7 @@ static void project_paint_delayed_face_init(ProjPaintState *ps,
     has_x_isect = 0;
     for (bucket_x = bucketMin[0]; bucket_x < bucketMax[0]; bucket_x++) {
       if (project_bucket_face_isect(ps, bucket_x, bucket_y, lt)) {
-        int bucket_index = bucket_x + (bucket_y * ps->buckets_x);
-        BLI_linklist_prepend_arena(&ps->bucketFaces[bucket_index],
-                                   /* cast to a pointer to shut up the compiler */
-                                   POINTER_FROM_INT(tri_index),
-                                   arena);
+        r_bucket_indices.append(bucket_x + (bucket_y * ps->buckets_x));
 
         has_x_isect = has_isect = 1;
       }
@@ -3672,15 +3668,70 @@ static void project_paint_delayed_face_init(ProjPaintState *ps,
       break;
     }
   }
+}
+
+/* Add faces to the buckets but don't initialize their pixels.
+ *
+ * Finding the buckets of the faces is done in parallel, the faces are added to the bucket lists
+ * afterwards in the same order as when adding them one by one.
+ *
+ * TODO: when painting occluded, sort the faces on their min-Z
+ * and only add faces that faces that are not occluded */
+static void project_paint_delayed_faces_init(ProjPaintState *ps,
+                                             const blender::Span<int> tri_indices)
+{
+  using namespace blender;
+
+  /* Faces are processed in chunks, so that the buckets of every chunk can be stored in order. */
+  const int64_t chunk_size = 256;
+  const int64_t chunks_num = (tri_indices.size() + chunk_size - 1) / chunk_size;
+  Array<Vector<int>> chunk_bucket_indices(chunks_num);
+  Array<Vector<int>> chunk_bucket_counts(chunks_num);
+
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      const IndexRange range = IndexRange(chunk * chunk_size, chunk_size)
+                                   .intersect(tri_indices.index_range());
+      Vector<int> &bucket_indices = chunk_bucket_indices[chunk];
+      Vector<int> &bucket_counts = chunk_bucket_counts[chunk];
+      for (const int tri_index : tri_indices.slice(range)) {
+        const int64_t size_before = bucket_indices.size();
+        project_paint_face_buckets_find(ps, &ps->mlooptri_eval[tri_index], bucket_indices);
+        bucket_counts.append(int(bucket_indices.size() - size_before));
+      }
+    }
+  });
+
+  /* just use the first thread arena since threading has not started yet */
+  MemArena *arena = ps->arena_mt[0];
+
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const IndexRange range = IndexRange(chunk * chunk_size, chunk_size)
+                                 .intersect(tri_indices.index_range());
+    const Span<int> bucket_indices = chunk_bucket_indices[chunk];
+    int bucket_offset = 0;
+    for (const int i : IndexRange(range.size())) {
+      const int tri_index = tri_indices[range[i]];
+      const int bucket_count = chunk_bucket_counts[chunk][i];
+      for (const int bucket_index : bucket_indices.slice(bucket_offset, bucket_count)) {
+        BLI_linklist_prepend_arena(&ps->bucketFaces[bucket_index],
+                                   /* cast to a pointer to shut up the compiler */
+                                   POINTER_FROM_INT(tri_index),
+                                   arena);
+      }
+      bucket_offset += bucket_count;
 
 #ifndef PROJ_DEBUG_NOSEAMBLEED
-  if (ps->seam_bleed_px > 0.0f) {
-    /* set as uninitialized */
-    ps->loopSeamData[lt->tri[0]].seam_uvs[0][0] = FLT_MAX;
-    ps->loopSeamData[lt->tri[1]].seam_uvs[0][0] = FLT_MAX;
-    ps->loopSeamData[lt->tri[2]].seam_uvs[0][0] = FLT_MAX;
-  }
+      if (ps->seam_bleed_px > 0.0f) {
+        const MLoopTri *lt = &ps->mlooptri_eval[tri_index];
+        /* set as uninitialized */
+        ps->loopSeamData[lt->tri[0]].seam_uvs[0][0] = FLT_MAX;
+        ps->loopSeamData[lt->tri[1]].seam_uvs[0][0] = FLT_MAX;
+        ps->loopSeamData[lt->tri[2]].seam_uvs[0][0] = FLT_MAX;
+      }
 #endif
+    }
+  }
 }
 
 static void proj_paint_state_viewport_init(ProjPaintState *ps, const char symmetry_flag)
@@ -4307,6 +4358,7 @@ static void project_paint_prepare_all_faces(ProjPaintState *ps,
   const MLoopTri *lt;
   int image_index = -1, tri_index;
   int prev_poly = -1;
+  blender::Vector<int> delayed_tri_indices;
 
   BLI_assert(ps->image_tot == 0);
 
@@ -4451,11 +4503,13 @@ static void project_paint_prepare_all_faces(ProjPaintState *ps,
       if (image_index != -1) {
         /* Initialize the faces screen pixels */
         /* Add this to a list to initialize later */
-        project_paint_delayed_face_init(ps, lt, tri_index);
+        delayed_tri_indices.append(tri_index);
       }
     }
   }
 
+  project_paint_delayed_faces_init(ps, delayed_tri_indices);
+
   /* Build an array of images we use. */
   if (ps->is_shared_user == false) {
     project_paint_build_proj_ima(ps, arena, &used_images);
@@ -2569,10 +2569,38 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
   const MTex *mtex = BKE_brush_mask_texture_get(br, OB_MODE_SCULPT);
-  float avg = 1.0f;
   float rgba[4];
   float point[3];
 
+  /* Hardness. */
+  float final_len = len;
+  const float hardness = cache->paint_brush.hardness;
+  float p = len / cache->radius;
+  if (p < hardness) {
+    final_len = 0.0f;
+  }
+  else if (hardness == 1.0f) {
+    final_len = cache->radius;
+  }
+  else {
+    p = (p - hardness) / (1.0f - hardness);
+    final_len = p * cache->radius;
+  }
+
+  /* Falloff curve. */
+  const float falloff = BKE_brush_curve_strength(br, final_len, cache->radius);
+  const float front_factor = frontface(br, cache->view_normal, vno, fno);
+
+  /* Paint mask. */
+  const float mask_factor = 1.0f - mask;
+
+  /* Texture sampling and auto-masking are much more expensive than the factors above, skip them
+   * for vertices that are not affected anyway, e.g. for fully masked or back-facing vertices. */
+  if (falloff == 0.0f || front_factor == 0.0f || mask_factor == 0.0f) {
+    return 0.0f;
+  }
+
+  float avg = 1.0f;
   sub_v3_v3v3(point, brush_point, cache->plane_offset);
 
   if (!mtex->tex) {
@@ -2625,27 +2653,9 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
-  const float hardness = cache->paint_brush.hardness;
-  float p = len / cache->radius;
-  if (p < hardness) {
-    final_len = 0.0f;
-  }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
-  }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
-  }
-
-  /* Falloff curve. */
-  avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
-  avg *= frontface(br, cache->view_normal, vno, fno);
-
-  /* Paint mask. */
-  avg *= 1.0f - mask;
+  avg *= falloff;
+  avg *= front_factor;
+  avg *= mask_factor;
 
   /* Auto-masking. */
   avg *= SCULPT_automasking_factor_get(cache->automasking, ss, vertex, automask_data);
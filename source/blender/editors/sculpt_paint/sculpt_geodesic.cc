@@ -10,9 +10,12 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_linklist_stack.h"
 #include "BLI_math.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_brush_types.h"
 #include "DNA_mesh_types.h"
@@ -40,9 +43,9 @@ static bool sculpt_geodesic_mesh_test_dist_add(const float (*vert_positions)[3],
                                                const int v1,
                                                const int v2,
                                                float *dists,
-                                               GSet *initial_verts)
+                                               const blender::Span<bool> is_initial_vert)
 {
-  if (BLI_gset_haskey(initial_verts, POINTER_FROM_INT(v0))) {
+  if (is_initial_vert[v0]) {
     return false;
   }
 
@@ -78,6 +81,7 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
                                           GSet *initial_verts,
                                           const float limit_radius)
 {
+  using namespace blender;
   SculptSession *ss = ob->sculpt;
   Mesh *mesh = BKE_object_get_original_mesh(ob);
 
@@ -115,45 +119,53 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
   BLI_LINKSTACK_INIT(queue);
   BLI_LINKSTACK_INIT(queue_next);
 
-  for (int i = 0; i < totvert; i++) {
-    if (BLI_gset_haskey(initial_verts, POINTER_FROM_INT(i))) {
-      dists[i] = 0.0f;
-    }
-    else {
-      dists[i] = FLT_MAX;
-    }
+  /* Lookups in the set are too slow for the propagation loop, use an array instead. */
+  Vector<int> initial_vert_indices;
+  Array<bool> is_initial_vert(totvert, false);
+  GSetIterator gs_iter;
+  GSET_ITER (gs_iter, initial_verts) {
+    const int v = POINTER_AS_INT(BLI_gsetIterator_getKey(&gs_iter));
+    initial_vert_indices.append(v);
+    is_initial_vert[v] = true;
   }
 
+  threading::parallel_for(IndexRange(totvert), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      dists[i] = is_initial_vert[i] ? 0.0f : FLT_MAX;
+    }
+  });
+
   /* Masks vertices that are further than limit radius from an initial vertex. As there is no need
    * to define a distance to them the algorithm can stop earlier by skipping them. */
-  BLI_bitmap *affected_vertex = BLI_BITMAP_NEW(totvert, "affected vertex");
-  GSetIterator gs_iter;
+  Array<bool> affected_vertex(totvert);
 
   if (limit_radius == FLT_MAX) {
     /* In this case, no need to loop through all initial vertices to check distances as they are
      * all going to be affected. */
-    BLI_bitmap_set_all(affected_vertex, true, totvert);
+    affected_vertex.fill(true);
   }
   else {
     /* This is an O(n^2) loop used to limit the geodesic distance calculation to a radius. When
      * this optimization is needed, it is expected for the tool to request the distance to a low
      * number of vertices (usually just 1 or 2). */
-    GSET_ITER (gs_iter, initial_verts) {
-      const int v = POINTER_AS_INT(BLI_gsetIterator_getKey(&gs_iter));
-      float *v_co = vert_positions[v];
-      for (int i = 0; i < totvert; i++) {
-        if (len_squared_v3v3(v_co, vert_positions[i]) <= limit_radius_sq) {
-          BLI_BITMAP_ENABLE(affected_vertex, i);
+    threading::parallel_for(IndexRange(totvert), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        affected_vertex[i] = false;
+        for (const int v : initial_vert_indices) {
+          if (len_squared_v3v3(vert_positions[v], vert_positions[i]) <= limit_radius_sq) {
+            affected_vertex[i] = true;
+            break;
+          }
         }
       }
-    }
+    });
   }
 
   /* Add edges adjacent to an initial vertex to the queue. */
   for (int i = 0; i < totedge; i++) {
     const int v1 = edges[i].v1;
     const int v2 = edges[i].v2;
-    if (!BLI_BITMAP_TEST(affected_vertex, v1) && !BLI_BITMAP_TEST(affected_vertex, v2)) {
+    if (!affected_vertex[v1] && !affected_vertex[v2]) {
       continue;
     }
     if (dists[v1] != FLT_MAX || dists[v2] != FLT_MAX) {
@@ -172,7 +184,7 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
           SWAP(int, v1, v2);
         }
         sculpt_geodesic_mesh_test_dist_add(
-            vert_positions, v2, v1, SCULPT_GEODESIC_VERTEX_NONE, dists, initial_verts);
+            vert_positions, v2, v1, SCULPT_GEODESIC_VERTEX_NONE, dists, is_initial_vert);
       }
 
       if (ss->epmap[e].count != 0) {
@@ -190,7 +202,7 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
               continue;
             }
             if (sculpt_geodesic_mesh_test_dist_add(
-                    vert_positions, v_other, v1, v2, dists, initial_verts)) {
+                    vert_positions, v_other, v1, v2, dists, is_initial_vert)) {
               for (int edge_map_index = 0; edge_map_index < ss->vemap[v_other].count;
                    edge_map_index++) {
                 const int e_other = ss->vemap[v_other].indices[edge_map_index];
@@ -204,8 +216,7 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
 
                 if (e_other != e && !BLI_BITMAP_TEST(edge_tag, e_other) &&
                     (ss->epmap[e_other].count == 0 || dists[ev_other] != FLT_MAX)) {
-                  if (BLI_BITMAP_TEST(affected_vertex, v_other) ||
-                      BLI_BITMAP_TEST(affected_vertex, ev_other)) {
+                  if (affected_vertex[v_other] || affected_vertex[ev_other]) {
                     BLI_BITMAP_ENABLE(edge_tag, e_other);
                     BLI_LINKSTACK_PUSH(queue_next, POINTER_FROM_INT(e_other));
                   }
@@ -229,7 +240,6 @@ static float *SCULPT_geodesic_mesh_create(Object *ob,
   BLI_LINKSTACK_FREE(queue);
   BLI_LINKSTACK_FREE(queue_next);
   MEM_SAFE_FREE(edge_tag);
-  MEM_SAFE_FREE(affected_vertex);
 
   return dists;
 }
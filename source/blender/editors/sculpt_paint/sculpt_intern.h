@@ -214,6 +214,9 @@ typedef struct SculptUndoNode {
   int faces_num;
 
   size_t undo_size;
+
+  /* Locked while the data of the node is copied, see #SCULPT_undo_push_node. */
+  ThreadMutex data_mutex;
 } SculptUndoNode;
 
 /* Factor of brush to have rake point following behind
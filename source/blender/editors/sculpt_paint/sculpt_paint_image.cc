@@ -10,6 +10,7 @@
 #include "ED_paint.h"
 
 #include "BLI_math.h"
+#include "BLI_math_vector.hh"
 #include "BLI_math_color_blend.h"
 #include "BLI_task.h"
 #ifdef DEBUG_PIXEL_NODES
@@ -161,14 +162,24 @@ template<typename ImageBuffer> class PaintingKernel {
              ImBuf *image_buffer,
              AutomaskingNodeData *automask_data)
   {
-    image_accessor.set_image_position(image_buffer, pixel_row.start_image_coordinate);
     const UVPrimitivePaintInput paint_input = uv_primitives.get_paint_input(
         pixel_row.uv_primitive_index);
     float3 pixel_pos = get_start_pixel_pos(geom_primitives, paint_input, pixel_row);
     const float3 delta_pixel_pos = get_delta_pixel_pos(
         geom_primitives, paint_input, pixel_row, pixel_pos);
+    const IndexRange brush_pixels = get_brush_pixel_range(
+        pixel_pos, delta_pixel_pos, pixel_row.num_pixels);
+    if (brush_pixels.is_empty()) {
+      return false;
+    }
+    pixel_pos += delta_pixel_pos * float(brush_pixels.start());
+    image_accessor.set_image_position(
+        image_buffer,
+        ushort2(pixel_row.start_image_coordinate.x + ushort(brush_pixels.start()),
+                pixel_row.start_image_coordinate.y));
+
     bool pixels_painted = false;
-    for (int x = 0; x < pixel_row.num_pixels; x++) {
+    for (int x = int(brush_pixels.start()); x < int(brush_pixels.one_after_last()); x++) {
       if (!brush_test_fn(&test, pixel_pos)) {
         pixel_pos += delta_pixel_pos;
         image_accessor.next_pixel();
@@ -247,6 +258,52 @@ template<typename ImageBuffer> class PaintingKernel {
     brush_test_fn = SCULPT_brush_test_init_with_falloff_shape(ss, &test, brush->falloff_shape);
   }
 
+  /**
+   * Range of the pixels in a row that can be inside the brush. Pixel positions along a row are
+   * linear, so this can be found by solving the brush distance test for the row as a whole
+   * instead of testing every pixel of the row. One extra pixel at both sides is included to
+   * account for precision, the pixels in the range still have to be tested.
+   */
+  IndexRange get_brush_pixel_range(const float3 &start_pixel_pos,
+                                   const float3 &delta_pixel_pos,
+                                   const int num_pixels) const
+  {
+    float3 start = start_pixel_pos - float3(test.location);
+    float3 delta = delta_pixel_pos;
+    if (brush_test_fn == SCULPT_brush_test_circle_sq) {
+      /* Only the distance in the view plane is tested. */
+      const float3 view_normal(test.plane_view);
+      start -= view_normal * math::dot(start, view_normal);
+      delta -= view_normal * math::dot(delta, view_normal);
+    }
+
+    /* Solve `|start + x * delta|^2 <= radius^2` for x. */
+    const float a = math::dot(delta, delta);
+    const float b = math::dot(start, delta);
+    const float c = math::dot(start, start) - test.radius_squared;
+    if (a == 0.0f) {
+      return c <= 0.0f ? IndexRange(num_pixels) : IndexRange();
+    }
+    const float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) {
+      return IndexRange();
+    }
+    const float discriminant_sqrt = sqrtf(discriminant);
+    const float x_min = (-b - discriminant_sqrt) / a;
+    const float x_max = (-b + discriminant_sqrt) / a;
+    if (x_max < -1.0f || x_min > float(num_pixels)) {
+      return IndexRange();
+    }
+    int first = int(floorf(max_ff(x_min, 0.0f))) - 1;
+    int last = int(ceilf(min_ff(x_max, float(num_pixels)))) + 1;
+    first = max_ii(first, 0);
+    last = min_ii(last, num_pixels - 1);
+    if (first > last) {
+      return IndexRange();
+    }
+    return IndexRange(first, last - first + 1);
+  }
+
   /**
    * Extract the starting pixel position from the given encoded_pixels belonging to the triangle.
    */
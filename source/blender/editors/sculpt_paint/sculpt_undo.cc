@@ -1170,6 +1170,7 @@ static void sculpt_undo_free_list(ListBase *lb)
       MEM_freeN(unode->face_sets);
     }
 
+    BLI_mutex_end(&unode->data_mutex);
     MEM_freeN(unode);
 
     unode = unode_next;
@@ -1260,6 +1261,7 @@ static SculptUndoNode *sculpt_undo_alloc_node_type(Object *object, SculptUndoTyp
   SculptUndoNode *unode = static_cast<SculptUndoNode *>(MEM_callocN(alloc_size, "SculptUndoNode"));
   BLI_strncpy(unode->idname, object->id.name, sizeof(unode->idname));
   unode->type = type;
+  BLI_mutex_init(&unode->data_mutex);
 
   UndoSculpt *usculpt = sculpt_undo_get_nodes();
   BLI_addtail(&usculpt->nodes, unode);
@@ -1552,6 +1554,7 @@ static SculptUndoNode *sculpt_undo_bmesh_push(Object *ob, PBVHNode *node, Sculpt
 
   if (unode == NULL) {
     unode = MEM_cnew<SculptUndoNode>(__func__);
+    BLI_mutex_init(&unode->data_mutex);
 
     BLI_strncpy(unode->idname, ob->id.name, sizeof(unode->idname));
     unode->type = type;
@@ -1644,15 +1647,19 @@ SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType
   }
   if ((unode = SCULPT_undo_get_node(node, type))) {
     BLI_thread_unlock(LOCK_CUSTOM1);
+    /* Wait until the thread that created the node has finished copying its data. */
+    BLI_mutex_lock(&unode->data_mutex);
+    BLI_mutex_unlock(&unode->data_mutex);
     return unode;
   }
 
   unode = sculpt_undo_alloc_node(ob, node, type);
 
-  /* NOTE: If this ever becomes a bottleneck, make a lock inside of the node.
-   * so we release global lock sooner, but keep data locked for until it is
-   * fully initialized.
-   */
+  /* Only the list of nodes and the undo size need the global lock. The data of the node itself is
+   * copied with only the node locked, so that threads pushing different nodes at the start of a
+   * stroke don't have to wait on each other. */
+  BLI_mutex_lock(&unode->data_mutex);
+  BLI_thread_unlock(LOCK_CUSTOM1);
 
   if (unode->grids) {
     int totgrid, *grids;
@@ -1717,7 +1724,7 @@ SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType
     unode->shapeName[0] = '\0';
   }
 
-  BLI_thread_unlock(LOCK_CUSTOM1);
+  BLI_mutex_unlock(&unode->data_mutex);
 
   return unode;
 }
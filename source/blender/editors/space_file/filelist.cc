@@ -29,6 +29,7 @@
 
 #include "BLF_api.h"
 
+#include "BLI_array.hh"
 #include "BLI_blenlib.h"
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
@@ -42,6 +43,7 @@
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #include "BLI_uuid.h"
+#include "BLI_vector.hh"
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -3187,69 +3189,135 @@ static int filelist_readjob_list_lib_populate_from_index(FileListReadJob *job_pa
   return read_from_index + navigate_to_parent_len;
 }
 
+/** A group of data-blocks in a library file, see #FileListLibReadData. */
+struct FileListLibGroup {
+  int idcode;
+  const char *name;
+  /** Data-block infos of the group, only read for #LIST_LIB_RECURSIVE or a group in the path. */
+  LinkNode *datablock_infos = nullptr;
+  int datablock_len = 0;
+};
+
 /**
- * \return The number of entries found if the \a root path points to a valid library file.
- *         Otherwise returns no value (#std::nullopt).
+ * The contents of a library file, read from its index or from the file itself. Reading doesn't
+ * touch the file list, so that multiple library files can be read in parallel. The file list
+ * entries are created from it afterwards.
  */
-static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
-                                                    const char *root,
-                                                    ListBase *entries,
-                                                    const ListLibOptions options,
-                                                    FileIndexer *indexer_runtime)
-{
-  BLI_assert(indexer_runtime);
+struct FileListLibReadData {
+  const char *root;
+  ListLibOptions options;
 
-  char dir[FILE_MAX_LIBEXTRA], *group;
+  char dir[FILE_MAX_LIBEXTRA];
+  /** Group part of the library path (points into #dir), or null. */
+  char *group = nullptr;
+  bool is_lib = false;
 
-  BlendHandle *libfiledata = nullptr;
+  /**
+   * Indexing returns all entries in a blend file. We should ignore the index when listing a group
+   * inside a blend file, so the `entries` isn't filled with undesired entries.
+   * This happens when linking or appending data-blocks, where you can navigate into a group (ie
+   * Materials/Objects) where you only want to work with partial indexes.
+   *
+   * Adding support for partial reading/updating indexes would increase the complexity.
+   */
+  bool use_indexer = false;
+  bool loaded_from_index = false;
+  int read_from_index = 0;
+  /** Entries read from the index, or the entries to update the index with. */
+  FileIndexerEntries indexer_entries = {nullptr};
+  /** Set once #indexer_entries contains the entries read from the file. */
+  bool update_index = false;
+
+  /** Names of the groups in the file, when listing the whole file. */
+  LinkNode *group_names = nullptr;
+  Vector<FileListLibGroup> groups;
+};
+
+/**
+ * Read the contents of the library file at \a data.root (if it is one). This part does the file
+ * access and can run in parallel for different files.
+ */
+static void filelist_readjob_list_lib_read(FileListLibReadData &data,
+                                           FileIndexer *indexer_runtime)
+{
+  BLI_assert(indexer_runtime);
 
   /* Check if the given root is actually a library. All folders are passed to
    * `filelist_readjob_list_lib` and based on the number of found entries `filelist_readjob_do`
    * will do a dir listing only when this function does not return any entries. */
   /* TODO(jbakker): We should consider introducing its own function to detect if it is a lib and
    * call it directly from `filelist_readjob_do` to increase readability. */
-  const bool is_lib = BLO_library_path_explode(root, dir, &group, nullptr);
-  if (!is_lib) {
-    return std::nullopt;
+  if (!BLO_library_path_explode(data.root, data.dir, &data.group, nullptr)) {
+    return;
   }
 
-  const bool group_came_from_path = group != nullptr;
-
   /* Try read from indexer_runtime. */
-  /* Indexing returns all entries in a blend file. We should ignore the index when listing a group
-   * inside a blend file, so the `entries` isn't filled with undesired entries.
-   * This happens when linking or appending data-blocks, where you can navigate into a group (ie
-   * Materials/Objects) where you only want to work with partial indexes.
-   *
-   * Adding support for partial reading/updating indexes would increase the complexity.
-   */
-  const bool use_indexer = !group_came_from_path;
-  FileIndexerEntries indexer_entries = {nullptr};
-  if (use_indexer) {
-    int read_from_index = 0;
+  data.use_indexer = data.group == nullptr;
+  if (data.use_indexer) {
     eFileIndexerResult indexer_result = indexer_runtime->callbacks->read_index(
-        dir, &indexer_entries, &read_from_index, indexer_runtime->user_data);
+        data.dir, &data.indexer_entries, &data.read_from_index, indexer_runtime->user_data);
     if (indexer_result == FILE_INDEXER_ENTRIES_LOADED) {
-      int entries_read = filelist_readjob_list_lib_populate_from_index(
-          job_params, entries, options, read_from_index, &indexer_entries);
-      ED_file_indexer_entries_clear(&indexer_entries);
-      return entries_read;
+      data.is_lib = true;
+      data.loaded_from_index = true;
+      return;
     }
   }
 
   /* Open the library file. */
   BlendFileReadReport bf_reports{};
-  libfiledata = BLO_blendhandle_from_file(dir, &bf_reports);
+  BlendHandle *libfiledata = BLO_blendhandle_from_file(data.dir, &bf_reports);
   if (libfiledata == nullptr) {
+    return;
+  }
+  data.is_lib = true;
+
+  const bool assets_only = data.options & LIST_LIB_ASSETS_ONLY;
+  if (data.group != nullptr) {
+    FileListLibGroup group{groupname_to_code(data.group), data.group};
+    group.datablock_infos = BLO_blendhandle_get_datablock_info(
+        libfiledata, group.idcode, assets_only, &group.datablock_len);
+    data.groups.append(group);
+  }
+  else {
+    data.group_names = BLO_blendhandle_get_linkable_groups(libfiledata);
+    for (LinkNode *ln = data.group_names; ln; ln = ln->next) {
+      const char *group_name = static_cast<char *>(ln->link);
+      FileListLibGroup group{groupname_to_code(group_name), group_name};
+      if (data.options & LIST_LIB_RECURSIVE) {
+        group.datablock_infos = BLO_blendhandle_get_datablock_info(
+            libfiledata, group.idcode, assets_only, &group.datablock_len);
+      }
+      data.groups.append(group);
+    }
+  }
+
+  BLO_blendhandle_close(libfiledata);
+}
+
+/**
+ * Create the file list entries for a library file read with #filelist_readjob_list_lib_read.
+ *
+ * \return The number of entries found if the read path points to a valid library file.
+ *         Otherwise returns no value (#std::nullopt).
+ */
+static std::optional<int> filelist_readjob_list_lib_add_entries(FileListReadJob *job_params,
+                                                                FileListLibReadData &data,
+                                                                ListBase *entries)
+{
+  if (!data.is_lib) {
     return std::nullopt;
   }
+  if (data.loaded_from_index) {
+    return filelist_readjob_list_lib_populate_from_index(
+        job_params, entries, data.options, data.read_from_index, &data.indexer_entries);
+  }
 
   /* Add current parent when requested. */
   /* Is the navigate to previous level added to the list of entries. When added the return value
    * should be increased to match the actual number of entries added. It is introduced to keep
    * the code clean and readable and not counting in a single variable. */
   int navigate_to_parent_len = 0;
-  if (options & LIST_LIB_ADD_PARENT) {
+  if (data.options & LIST_LIB_ADD_PARENT) {
     FileListInternEntry *entry = filelist_readjob_list_lib_navigate_to_parent_entry_create(
         job_params);
     BLI_addtail(entries, entry);
@@ -3258,56 +3326,57 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
 
   int group_len = 0;
   int datablock_len = 0;
-  if (group_came_from_path) {
-    const int idcode = groupname_to_code(group);
-    LinkNode *datablock_infos = BLO_blendhandle_get_datablock_info(
-        libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &datablock_len);
+  if (data.group != nullptr) {
+    const FileListLibGroup &group = data.groups.first();
     filelist_readjob_list_lib_add_datablocks(
-        job_params, entries, datablock_infos, false, idcode, group);
-    BLO_datablock_info_linklist_free(datablock_infos);
+        job_params, entries, group.datablock_infos, false, group.idcode, group.name);
+    datablock_len = group.datablock_len;
   }
   else {
-    LinkNode *groups = BLO_blendhandle_get_linkable_groups(libfiledata);
-    group_len = BLI_linklist_count(groups);
-
-    for (LinkNode *ln = groups; ln; ln = ln->next) {
-      const char *group_name = static_cast<char *>(ln->link);
-      const int idcode = groupname_to_code(group_name);
+    group_len = int(data.groups.size());
+    for (const FileListLibGroup &group : data.groups) {
       FileListInternEntry *group_entry = filelist_readjob_list_lib_group_create(
-          job_params, idcode, group_name);
+          job_params, group.idcode, group.name);
       BLI_addtail(entries, group_entry);
 
-      if (options & LIST_LIB_RECURSIVE) {
-        int group_datablock_len;
-        LinkNode *group_datablock_infos = BLO_blendhandle_get_datablock_info(
-            libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &group_datablock_len);
+      if (data.options & LIST_LIB_RECURSIVE) {
         filelist_readjob_list_lib_add_datablocks(
-            job_params, entries, group_datablock_infos, true, idcode, group_name);
-        if (use_indexer) {
+            job_params, entries, group.datablock_infos, true, group.idcode, group.name);
+        if (data.use_indexer) {
           ED_file_indexer_entries_extend_from_datablock_infos(
-              &indexer_entries, group_datablock_infos, idcode);
+              &data.indexer_entries, group.datablock_infos, group.idcode);
         }
-        BLO_datablock_info_linklist_free(group_datablock_infos);
-        datablock_len += group_datablock_len;
+        datablock_len += group.datablock_len;
       }
     }
-
-    BLI_linklist_freeN(groups);
-  }
-
-  BLO_blendhandle_close(libfiledata);
-
-  /* Update the index. */
-  if (use_indexer) {
-    indexer_runtime->callbacks->update_index(dir, &indexer_entries, indexer_runtime->user_data);
-    ED_file_indexer_entries_clear(&indexer_entries);
   }
+  data.update_index = data.use_indexer;
 
   /* Return the number of items added to entries. */
   int added_entries_len = group_len + datablock_len + navigate_to_parent_len;
   return added_entries_len;
 }
 
+/**
+ * Free the data of a library file read with #filelist_readjob_list_lib_read, after updating the
+ * index with the entries that were read from the file. Can run in parallel for different files.
+ */
+static void filelist_readjob_list_lib_free(FileListLibReadData &data,
+                                           FileIndexer *indexer_runtime)
+{
+  for (FileListLibGroup &group : data.groups) {
+    BLO_datablock_info_linklist_free(group.datablock_infos);
+  }
+  BLI_linklist_freeN(data.group_names);
+
+  /* Update the index. */
+  if (data.update_index) {
+    indexer_runtime->callbacks->update_index(
+        data.dir, &data.indexer_entries, indexer_runtime->user_data);
+  }
+  ED_file_indexer_entries_clear(&data.indexer_entries);
+}
+
 #if 0
 /* Kept for reference here, in case we want to add back that feature later.
  * We do not need it currently. */
@@ -3537,6 +3606,31 @@ static bool filelist_readjob_should_recurse_into_entry(const int max_recursion,
   return true;
 }
 
+struct FileListLibReadTaskData {
+  FileListLibReadData *lib_datas;
+  FileIndexer *indexer_runtime;
+  const bool *stop;
+};
+
+static void filelist_readjob_list_lib_read_cb(void *__restrict userdata,
+                                              const int index,
+                                              const TaskParallelTLS *__restrict /*tls*/)
+{
+  FileListLibReadTaskData *task_data = static_cast<FileListLibReadTaskData *>(userdata);
+  if (*task_data->stop) {
+    return;
+  }
+  filelist_readjob_list_lib_read(task_data->lib_datas[index], task_data->indexer_runtime);
+}
+
+static void filelist_readjob_list_lib_free_cb(void *__restrict userdata,
+                                              const int index,
+                                              const TaskParallelTLS *__restrict /*tls*/)
+{
+  FileListLibReadTaskData *task_data = static_cast<FileListLibReadTaskData *>(userdata);
+  filelist_readjob_list_lib_free(task_data->lib_datas[index], task_data->indexer_runtime);
+}
+
 static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
                                                      FileListReadJob *job_params,
                                                      const bool *stop,
@@ -3571,85 +3665,127 @@ static void filelist_readjob_recursive_dir_add_items(const bool do_lib,
   }
 
   while (!BLI_stack_is_empty(todo_dirs) && !(*stop)) {
-    int entries_num = 0;
-
-    char *subdir;
-    char rel_subdir[FILE_MAX_LIBEXTRA];
-    int recursion_level;
-    bool skip_currpar;
-
-    td_dir = static_cast<TodoDir *>(BLI_stack_peek(todo_dirs));
-    subdir = td_dir->dir;
-    recursion_level = td_dir->level;
-    skip_currpar = (recursion_level > 1);
-
-    BLI_stack_discard(todo_dirs);
-
-    /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
-     * entry->relpath itself (nor any path containing it), since it may actually be a datablock
-     * name inside .blend file, which can have slashes and backslashes! See T46827.
-     * Note that in the end, this means we 'cache' valid relative subdir once here,
-     * this is actually better. */
-    BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
-    BLI_path_normalize_dir(root, rel_subdir, sizeof(rel_subdir));
-    BLI_path_rel(rel_subdir, root);
-
-    /* Update the current relative base path within the filelist root. */
-    BLI_strncpy(job_params->cur_relbase, rel_subdir, sizeof(job_params->cur_relbase));
+    /* Take all directories that are known so far, so that the library files among them can be
+     * read in parallel. Reading .blend files (or their index) is what takes most time when
+     * listing big asset libraries. */
+    Vector<TodoDir> batch;
+    while (!BLI_stack_is_empty(todo_dirs)) {
+      batch.append(*static_cast<TodoDir *>(BLI_stack_peek(todo_dirs)));
+      BLI_stack_discard(todo_dirs);
+    }
 
-    bool is_lib = false;
-    if (do_lib) {
-      ListLibOptions list_lib_options = LIST_LIB_OPTION_NONE;
+    Array<FileListLibReadData> lib_datas(batch.size());
+    for (const int i : batch.index_range()) {
+      const int recursion_level = batch[i].level;
+      const bool skip_currpar = (recursion_level > 1);
+      FileListLibReadData &lib_data = lib_datas[i];
+      lib_data.root = batch[i].dir;
+      lib_data.options = LIST_LIB_OPTION_NONE;
       if (!skip_currpar) {
-        list_lib_options |= LIST_LIB_ADD_PARENT;
+        lib_data.options |= LIST_LIB_ADD_PARENT;
       }
 
       /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
        * still a recursion level over. */
       if (max_recursion > 0) {
-        list_lib_options |= LIST_LIB_RECURSIVE;
+        lib_data.options |= LIST_LIB_RECURSIVE;
       }
       /* Only load assets when browsing an asset library. For normal file browsing we return all
        * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user. */
       if (job_params->load_asset_library) {
-        list_lib_options |= LIST_LIB_ASSETS_ONLY;
-      }
-      std::optional<int> lib_entries_num = filelist_readjob_list_lib(
-          job_params, subdir, &entries, list_lib_options, &indexer_runtime);
-      if (lib_entries_num) {
-        is_lib = true;
-        entries_num += *lib_entries_num;
+        lib_data.options |= LIST_LIB_ASSETS_ONLY;
       }
     }
 
-    if (!is_lib && BLI_is_dir(subdir)) {
-      entries_num = filelist_readjob_list_dir(
-          job_params, subdir, &entries, filter_glob, do_lib, job_params->main_name, skip_currpar);
+    if (do_lib) {
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      FileListLibReadTaskData task_data{lib_datas.data(), &indexer_runtime, stop};
+      BLI_task_parallel_range(
+          0, int(lib_datas.size()), &task_data, filelist_readjob_list_lib_read_cb, &settings);
     }
 
-    LISTBASE_FOREACH (FileListInternEntry *, entry, &entries) {
-      entry->uid = filelist_uid_generate(filelist);
-      entry->name = fileentry_uiname(root, entry, dir);
-      entry->free_name = true;
-
-      if (filelist_readjob_should_recurse_into_entry(
-              max_recursion, is_lib, recursion_level, entry)) {
-        /* We have a directory we want to list, add it to todo list!
-         * Using #BLI_path_join works but isn't needed as `root` has a trailing slash. */
-        BLI_string_join(dir, sizeof(dir), root, entry->relpath);
-        BLI_path_normalize_dir(job_params->main_name, dir, sizeof(dir));
-        td_dir = static_cast<TodoDir *>(BLI_stack_push_r(todo_dirs));
-        td_dir->level = recursion_level + 1;
-        td_dir->dir = BLI_strdup(dir);
-        dirs_todo_count++;
+    for (const int i : batch.index_range()) {
+      if (*stop) {
+        break;
+      }
+      int entries_num = 0;
+
+      char *subdir = batch[i].dir;
+      char rel_subdir[FILE_MAX_LIBEXTRA];
+      const int recursion_level = batch[i].level;
+      const bool skip_currpar = (recursion_level > 1);
+
+      /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
+       * entry->relpath itself (nor any path containing it), since it may actually be a datablock
+       * name inside .blend file, which can have slashes and backslashes! See T46827.
+       * Note that in the end, this means we 'cache' valid relative subdir once here,
+       * this is actually better. */
+      BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
+      BLI_path_normalize_dir(root, rel_subdir, sizeof(rel_subdir));
+      BLI_path_rel(rel_subdir, root);
+
+      /* Update the current relative base path within the filelist root. */
+      BLI_strncpy(job_params->cur_relbase, rel_subdir, sizeof(job_params->cur_relbase));
+
+      bool is_lib = false;
+      if (do_lib) {
+        std::optional<int> lib_entries_num = filelist_readjob_list_lib_add_entries(
+            job_params, lib_datas[i], &entries);
+        if (lib_entries_num) {
+          is_lib = true;
+          entries_num += *lib_entries_num;
+        }
+      }
+
+      if (!is_lib && BLI_is_dir(subdir)) {
+        entries_num = filelist_readjob_list_dir(job_params,
+                                                subdir,
+                                                &entries,
+                                                filter_glob,
+                                                do_lib,
+                                                job_params->main_name,
+                                                skip_currpar);
       }
-    }
 
-    filelist_readjob_append_entries(job_params, &entries, entries_num, do_update);
+      LISTBASE_FOREACH (FileListInternEntry *, entry, &entries) {
+        entry->uid = filelist_uid_generate(filelist);
+        entry->name = fileentry_uiname(root, entry, dir);
+        entry->free_name = true;
+
+        if (filelist_readjob_should_recurse_into_entry(
+                max_recursion, is_lib, recursion_level, entry)) {
+          /* We have a directory we want to list, add it to todo list!
+           * Using #BLI_path_join works but isn't needed as `root` has a trailing slash. */
+          BLI_string_join(dir, sizeof(dir), root, entry->relpath);
+          BLI_path_normalize_dir(job_params->main_name, dir, sizeof(dir));
+          td_dir = static_cast<TodoDir *>(BLI_stack_push_r(todo_dirs));
+          td_dir->level = recursion_level + 1;
+          td_dir->dir = BLI_strdup(dir);
+          dirs_todo_count++;
+        }
+      }
 
-    dirs_done_count++;
-    *progress = float(dirs_done_count) / float(dirs_todo_count);
-    MEM_freeN(subdir);
+      filelist_readjob_append_entries(job_params, &entries, entries_num, do_update);
+
+      dirs_done_count++;
+      *progress = float(dirs_done_count) / float(dirs_todo_count);
+    }
+
+    /* Update the indices and free the read data, writing index files can be done in parallel as
+     * well. */
+    if (do_lib) {
+      TaskParallelSettings settings;
+      BLI_parallel_range_settings_defaults(&settings);
+      settings.min_iter_per_thread = 1;
+      FileListLibReadTaskData task_data{lib_datas.data(), &indexer_runtime, stop};
+      BLI_task_parallel_range(
+          0, int(lib_datas.size()), &task_data, filelist_readjob_list_lib_free_cb, &settings);
+    }
+    for (TodoDir &todo_dir : batch) {
+      MEM_freeN(todo_dir.dir);
+    }
   }
 
   /* Finalize and free indexer. */
@@ -622,6 +622,22 @@ static const char *info_statusbar_string(Main *bmain,
     uintptr_t mem_in_use = MEM_get_memory_in_use();
     BLI_str_format_byte_unit(formatted_mem, mem_in_use, false);
     ofs += BLI_snprintf_rlen(info + ofs, len, TIP_("Memory: %s"), formatted_mem);
+
+    /* Subsystem using the most memory, to give an idea of what is growing. */
+    eMemTag mem_tag_max = MEM_TAG_NONE;
+    size_t mem_tag_max_in_use = 0;
+    for (int tag = MEM_TAG_NONE + 1; tag < MEM_TAG_NUM; tag++) {
+      const size_t mem_tag_in_use = MEM_get_memory_in_use_by_tag(eMemTag(tag));
+      if (mem_tag_in_use > mem_tag_max_in_use) {
+        mem_tag_max = eMemTag(tag);
+        mem_tag_max_in_use = mem_tag_in_use;
+      }
+    }
+    if (mem_tag_max != MEM_TAG_NONE) {
+      BLI_str_format_byte_unit(formatted_mem, mem_tag_max_in_use, false);
+      ofs += BLI_snprintf_rlen(
+          info + ofs, len - ofs, " (%s %s)", MEM_tag_name(mem_tag_max), formatted_mem);
+    }
   }
 
   /* GPU VRAM status. */
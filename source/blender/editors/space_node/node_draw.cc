@@ -1821,8 +1821,20 @@ static std::string node_get_execution_time_label(TreeDrawContext &tree_draw_ctx,
   }
 
   std::stringstream stream;
-  stream << std::fixed << std::setprecision(precision) << (exec_time_us / 1000.0f);
-  return stream.str() + " ms";
+  stream << std::fixed << std::setprecision(precision) << (exec_time_us / 1000.0f) << " ms";
+
+  /* Show the share of the total time for nodes that take a large part of the evaluation, so that
+   * the nodes worth optimizing stand out without muting nodes one by one. */
+  if (node.type != NODE_GROUP_OUTPUT) {
+    const std::chrono::nanoseconds total_time = tree_draw_ctx.geo_tree_log->run_time_sum;
+    if (total_time.count() > 0) {
+      const double share = double(exec_time->count()) / double(total_time.count());
+      if (share >= 0.1) {
+        stream << " (" << std::setprecision(0) << share * 100.0 << "%)";
+      }
+    }
+  }
+  return stream.str();
 }
 
 struct NodeExtraInfoRow {
@@ -1959,7 +1971,8 @@ static Vector<NodeExtraInfoRow> node_get_extra_info(TreeDrawContext &tree_draw_c
     if (!row.text.empty()) {
       row.tooltip = TIP_(
           "The execution time from the node tree's latest evaluation. For frame and group nodes, "
-          "the time for all sub-nodes");
+          "the time for all sub-nodes. Nodes that take at least 10% of the total time show their "
+          "share in parentheses");
       row.icon = ICON_PREVIEW_RANGE;
       rows.append(std::move(row));
     }
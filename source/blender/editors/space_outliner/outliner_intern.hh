@@ -279,6 +279,7 @@ TreeElement *outliner_add_collection_recursive(SpaceOutliner *space_outliner,
 
 bool outliner_requires_rebuild_on_select_or_active_change(
     const struct SpaceOutliner *space_outliner);
+bool outliner_requires_rebuild_on_visibility_change(const struct SpaceOutliner *space_outliner);
 
 typedef struct IDsSelectedData {
   struct ListBase selected_array;
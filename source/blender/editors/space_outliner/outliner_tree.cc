@@ -217,6 +217,14 @@ bool outliner_requires_rebuild_on_select_or_active_change(const SpaceOutliner *s
   return exclude_flags & (SO_FILTER_OB_STATE_SELECTED | SO_FILTER_OB_STATE_ACTIVE);
 }
 
+bool outliner_requires_rebuild_on_visibility_change(const SpaceOutliner *space_outliner)
+{
+  int exclude_flags = outliner_exclude_filter_get(space_outliner);
+  /* Need to rebuild tree to re-apply filter if visibility changed while filtering based on
+   * visibility, which also affects selectability. */
+  return exclude_flags & (SO_FILTER_OB_STATE_VISIBLE | SO_FILTER_OB_STATE_SELECTABLE);
+}
+
 /* special handling of hierarchical non-lib data */
 static void outliner_add_bone(SpaceOutliner *space_outliner,
                               ListBase *lb,
@@ -274,6 +282,22 @@ static void outliner_add_object_contents(SpaceOutliner *space_outliner,
                                          TreeStoreElem *tselem,
                                          Object *ob)
 {
+  if (outliner_exclude_filter_get(space_outliner) & SO_FILTER_NO_OB_CONTENT) {
+    /* Would be removed by filtering anyway. Child objects are added by the tree-display. */
+    return;
+  }
+  if (space_outliner->runtime->tree_display->is_lazy_built() &&
+      !TSELEM_OPEN(tselem, space_outliner)) {
+    /* Only build the contents of expanded objects, see #TreeDisplayViewLayer::is_lazy_built(). */
+    if (ob->data || ob->adt || ob->instance_collection || ob->totcol ||
+        !BLI_listbase_is_empty(&ob->constraints) || !BLI_listbase_is_empty(&ob->modifiers) ||
+        !BLI_listbase_is_empty(&ob->greasepencil_modifiers) ||
+        !BLI_listbase_is_empty(&ob->shader_fx)) {
+      te->flag |= TE_PRETEND_HAS_CHILDREN;
+    }
+    return;
+  }
+
   if (outliner_animdata_test(ob->adt)) {
     outliner_add_element(space_outliner, &te->subtree, ob, te, TSE_ANIM_DATA, 0);
   }
@@ -124,6 +124,13 @@ static void outliner_main_region_listener(const wmRegionListenerParams *params)
           }
           break;
         case ND_OB_VISIBLE:
+          if (outliner_requires_rebuild_on_visibility_change(space_outliner)) {
+            ED_region_tag_redraw(region);
+          }
+          else {
+            ED_region_tag_redraw_no_rebuild(region);
+          }
+          break;
         case ND_OB_RENDER:
         case ND_MODE:
         case ND_KEYINGSET:
@@ -108,6 +108,7 @@ class TreeDisplayViewLayer final : public AbstractTreeDisplay {
   Scene *scene_ = nullptr;
   ViewLayer *view_layer_ = nullptr;
   bool show_objects_ = true;
+  bool is_lazy_built_ = false;
 
  public:
   TreeDisplayViewLayer(SpaceOutliner &space_outliner);
@@ -116,6 +117,12 @@ class TreeDisplayViewLayer final : public AbstractTreeDisplay {
 
   bool supportsModeColumn() const override;
 
+  /**
+   * View layers with a huge number of objects only build the contents (object data, modifiers,
+   * constraints, ...) of expanded objects. The objects themselves are always added.
+   */
+  bool is_lazy_built() const override;
+
  private:
   void add_view_layer(Scene &, ListBase &, TreeElement *);
   void add_layer_collections_recursive(ListBase &, ListBase &, TreeElement &);
@@ -28,6 +28,13 @@ namespace blender::ed::outliner {
 
 template<typename T> using List = ListBaseWrapper<T>;
 
+/**
+ * Number of objects in the view layer from which the tree is built lazily. Below this, building
+ * the contents of all objects is fast enough, and keeps the contents available for the merged
+ * icons of collapsed objects.
+ */
+static constexpr int lazy_build_objects_num_min = 10000;
+
 class ObjectsChildrenBuilder {
   using TreeChildren = Vector<TreeElement *>;
   using ObjectTreeElementsMap = Map<Object *, TreeChildren>;
@@ -60,6 +67,11 @@ bool TreeDisplayViewLayer::supportsModeColumn() const
   return true;
 }
 
+bool TreeDisplayViewLayer::is_lazy_built() const
+{
+  return is_lazy_built_;
+}
+
 ListBase TreeDisplayViewLayer::buildTree(const TreeSourceData &source_data)
 {
   ListBase tree = {nullptr};
@@ -67,6 +79,11 @@ ListBase TreeDisplayViewLayer::buildTree(const TreeSourceData &source_data)
   scene_ = scene;
   show_objects_ = !(space_outliner_.filter & SO_FILTER_NO_OBJECT);
 
+  BKE_view_layer_synced_ensure(scene, source_data.view_layer);
+  is_lazy_built_ = BLI_listbase_count_at_most(
+                       BKE_view_layer_object_bases_get(source_data.view_layer),
+                       lazy_build_objects_num_min) == lazy_build_objects_num_min;
+
   for (auto *view_layer : ListBaseWrapper<ViewLayer>(scene->view_layers)) {
     view_layer_ = view_layer;
 
@@ -1860,6 +1860,63 @@ static void sequencer_preview_get_rect(rctf *preview,
   }
 }
 
+void sequencer_display_texture_free(SpaceSeq *sseq)
+{
+  if (sseq->runtime.display_texture) {
+    GPU_texture_free(sseq->runtime.display_texture);
+    sseq->runtime.display_texture = NULL;
+  }
+  if (sseq->runtime.display_texture_ibuf) {
+    IMB_freeImBuf(sseq->runtime.display_texture_ibuf);
+    sseq->runtime.display_texture_ibuf = NULL;
+  }
+}
+
+/* Get the preview texture of the space filled with `display_buffer`. The texture is only
+ * reallocated when the size or format changes. When `reuse_upload` is true and `ibuf` is the
+ * image that was last uploaded, its contents are used as they are. The image is referenced while
+ * it is held, so its address can not be taken by another image in the meantime. */
+static GPUTexture *sequencer_display_texture_ensure(SpaceSeq *sseq,
+                                                   ImBuf *ibuf,
+                                                   const bool reuse_upload,
+                                                   const eGPUTextureFormat format,
+                                                   const eGPUDataFormat data,
+                                                   void *display_buffer)
+{
+  GPUTexture *texture = sseq->runtime.display_texture;
+
+  if (texture != NULL &&
+      (GPU_texture_width(texture) != ibuf->x || GPU_texture_height(texture) != ibuf->y ||
+       GPU_texture_format(texture) != format)) {
+    sequencer_display_texture_free(sseq);
+    texture = NULL;
+  }
+
+  if (texture == NULL) {
+    eGPUTextureUsage usage = GPU_TEXTURE_USAGE_SHADER_READ | GPU_TEXTURE_USAGE_ATTACHMENT;
+    texture = GPU_texture_create_2d_ex(
+        "seq_display_buf", ibuf->x, ibuf->y, 1, format, usage, NULL);
+    GPU_texture_filter_mode(texture, false);
+    sseq->runtime.display_texture = texture;
+  }
+  else if (reuse_upload && sseq->runtime.display_texture_ibuf == ibuf) {
+    return texture;
+  }
+
+  GPU_texture_update(texture, data, display_buffer);
+
+  if (sseq->runtime.display_texture_ibuf) {
+    IMB_freeImBuf(sseq->runtime.display_texture_ibuf);
+    sseq->runtime.display_texture_ibuf = NULL;
+  }
+  if (reuse_upload) {
+    IMB_refImBuf(ibuf);
+    sseq->runtime.display_texture_ibuf = ibuf;
+  }
+
+  return texture;
+}
+
 static void sequencer_draw_display_buffer(const bContext *C,
                                           Scene *scene,
                                           ARegion *region,
@@ -1908,11 +1965,11 @@ static void sequencer_draw_display_buffer(const bContext *C,
     GPU_matrix_push_projection();
     GPU_matrix_identity_projection_set();
   }
-  eGPUTextureUsage usage = GPU_TEXTURE_USAGE_SHADER_READ | GPU_TEXTURE_USAGE_ATTACHMENT;
-  GPUTexture *texture = GPU_texture_create_2d_ex(
-      "seq_display_buf", ibuf->x, ibuf->y, 1, format, usage, NULL);
-  GPU_texture_update(texture, data, display_buffer);
-  GPU_texture_filter_mode(texture, false);
+  /* With GLSL color management the texture holds the unmodified image buffer, so the upload can
+   * be skipped when the same buffer is drawn again, e.g. when redrawing for overlays or while
+   * navigating the view. Scopes and CPU transformed display buffers are always uploaded. */
+  GPUTexture *texture = sequencer_display_texture_ensure(
+      sseq, ibuf, glsl_used && scope == NULL, format, data, display_buffer);
 
   GPU_texture_bind(texture, 0);
 
@@ -1949,7 +2006,6 @@ static void sequencer_draw_display_buffer(const bContext *C,
   immEnd();
 
   GPU_texture_unbind(texture);
-  GPU_texture_free(texture);
 
   if (!glsl_used) {
     immUnbindProgram();
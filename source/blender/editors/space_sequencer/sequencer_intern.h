@@ -63,6 +63,8 @@ void sequencer_draw_preview(const struct bContext *C,
                             int offset,
                             bool draw_overlay,
                             bool draw_backdrop);
+/* Free the preview texture kept in the space runtime. */
+void sequencer_display_texture_free(struct SpaceSeq *sseq);
 void color3ubv_from_seq(const struct Scene *curscene,
                         const struct Sequence *seq,
                         bool show_strip_color_tag,
@@ -229,6 +229,8 @@ static void sequencer_free(SpaceLink *sl)
         sseq->runtime.last_displayed_thumbnails, NULL, last_displayed_thumbnails_list_free);
     sseq->runtime.last_displayed_thumbnails = NULL;
   }
+
+  sequencer_display_texture_free(sseq);
 }
 
 /* Space-type init callback. */
@@ -2,6 +2,7 @@
 
 #include <cstring>
 
+#include "BLI_index_mask_ops.hh"
 #include "BLI_listbase.h"
 
 #include "DNA_screen_types.h"
@@ -24,22 +25,23 @@
 namespace blender::ed::spreadsheet {
 
 template<typename T, typename OperationFn>
-static void apply_filter_operation(const VArray<T> &data,
-                                   OperationFn check_fn,
-                                   const IndexMask mask,
-                                   Vector<int64_t> &new_indices)
+static IndexMask apply_filter_operation(const VArray<T> &data,
+                                        OperationFn check_fn,
+                                        const IndexMask mask,
+                                        Vector<int64_t> &new_indices)
 {
-  for (const int64_t i : mask) {
-    if (check_fn(data[i])) {
-      new_indices.append(i);
-    }
-  }
+  IndexMask result;
+  devirtualize_varray(data, [&](const auto values) {
+    result = index_mask_ops::find_indices_based_on_predicate(
+        mask, 4096, new_indices, [&](const int64_t i) { return check_fn(values[i]); });
+  });
+  return result;
 }
 
-static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
-                             const Map<StringRef, const ColumnValues *> &columns,
-                             const IndexMask prev_mask,
-                             Vector<int64_t> &new_indices)
+static IndexMask apply_row_filter(const SpreadsheetRowFilter &row_filter,
+                                  const Map<StringRef, const ColumnValues *> &columns,
+                                  const IndexMask prev_mask,
+                                  Vector<int64_t> &new_indices)
 {
   const ColumnValues &column = *columns.lookup(row_filter.column_name);
   const GVArray &column_data = column.data();
@@ -48,34 +50,31 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
     switch (row_filter.operation) {
       case SPREADSHEET_ROW_FILTER_EQUAL: {
         const float threshold = row_filter.threshold;
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float>(),
             [&](const float cell) { return std::abs(cell - value) < threshold; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_GREATER: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float>(),
             [&](const float cell) { return cell > value; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_LESS: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float>(),
             [&](const float cell) { return cell < value; },
             prev_mask,
             new_indices);
-        break;
       }
     }
   }
   else if (column_data.type().is<bool>()) {
     const bool value = (row_filter.flag & SPREADSHEET_ROW_FILTER_BOOL_VALUE) != 0;
-    apply_filter_operation(
+    return apply_filter_operation(
         column_data.typed<bool>(),
         [&](const bool cell) { return cell == value; },
         prev_mask,
@@ -85,28 +84,25 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
     const int value = row_filter.value_int;
     switch (row_filter.operation) {
       case SPREADSHEET_ROW_FILTER_EQUAL: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<int8_t>(),
             [&](const int cell) { return cell == value; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_GREATER: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<int8_t>(),
             [value](const int cell) { return cell > value; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_LESS: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<int8_t>(),
             [&](const int cell) { return cell < value; },
             prev_mask,
             new_indices);
-        break;
       }
     }
   }
@@ -114,28 +110,25 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
     const int value = row_filter.value_int;
     switch (row_filter.operation) {
       case SPREADSHEET_ROW_FILTER_EQUAL: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<int>(),
             [&](const int cell) { return cell == value; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_GREATER: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<int>(),
             [value](const int cell) { return cell > value; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_LESS: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<int>(),
             [&](const int cell) { return cell < value; },
             prev_mask,
             new_indices);
-        break;
       }
     }
   }
@@ -144,28 +137,25 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
     switch (row_filter.operation) {
       case SPREADSHEET_ROW_FILTER_EQUAL: {
         const float threshold_sq = pow2f(row_filter.threshold);
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float2>(),
             [&](const float2 cell) { return math::distance_squared(cell, value) <= threshold_sq; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_GREATER: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float2>(),
             [&](const float2 cell) { return cell.x > value.x && cell.y > value.y; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_LESS: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float2>(),
             [&](const float2 cell) { return cell.x < value.x && cell.y < value.y; },
             prev_mask,
             new_indices);
-        break;
       }
     }
   }
@@ -174,32 +164,29 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
     switch (row_filter.operation) {
       case SPREADSHEET_ROW_FILTER_EQUAL: {
         const float threshold_sq = pow2f(row_filter.threshold);
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float3>(),
             [&](const float3 cell) { return math::distance_squared(cell, value) <= threshold_sq; },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_GREATER: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float3>(),
             [&](const float3 cell) {
               return cell.x > value.x && cell.y > value.y && cell.z > value.z;
             },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_LESS: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<float3>(),
             [&](const float3 cell) {
               return cell.x < value.x && cell.y < value.y && cell.z < value.z;
             },
             prev_mask,
             new_indices);
-        break;
       }
     }
   }
@@ -208,34 +195,31 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
     switch (row_filter.operation) {
       case SPREADSHEET_ROW_FILTER_EQUAL: {
         const float threshold_sq = pow2f(row_filter.threshold);
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<ColorGeometry4f>(),
             [&](const ColorGeometry4f cell) {
               return len_squared_v4v4(cell, value) <= threshold_sq;
             },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_GREATER: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<ColorGeometry4f>(),
             [&](const ColorGeometry4f cell) {
               return cell.r > value.r && cell.g > value.g && cell.b > value.b && cell.a > value.a;
             },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_LESS: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<ColorGeometry4f>(),
             [&](const ColorGeometry4f cell) {
               return cell.r < value.r && cell.g < value.g && cell.b < value.b && cell.a < value.a;
             },
             prev_mask,
             new_indices);
-        break;
       }
     }
   }
@@ -246,7 +230,7 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
         const float4 value_floats = {
             float(value.r), float(value.g), float(value.b), float(value.a)};
         const float threshold_sq = pow2f(row_filter.threshold);
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<ColorGeometry4b>(),
             [&](const ColorGeometry4b cell_bytes) {
               const ColorGeometry4f cell = cell_bytes.decode();
@@ -256,10 +240,9 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
             },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_GREATER: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<ColorGeometry4b>(),
             [&](const ColorGeometry4b cell_bytes) {
               const ColorGeometry4f cell = cell_bytes.decode();
@@ -267,10 +250,9 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
             },
             prev_mask,
             new_indices);
-        break;
       }
       case SPREADSHEET_ROW_FILTER_LESS: {
-        apply_filter_operation(
+        return apply_filter_operation(
             column_data.typed<ColorGeometry4b>(),
             [&](const ColorGeometry4b cell_bytes) {
               const ColorGeometry4f cell = cell_bytes.decode();
@@ -278,13 +260,12 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
             },
             prev_mask,
             new_indices);
-        break;
       }
     }
   }
   else if (column_data.type().is<bke::InstanceReference>()) {
     const StringRef value = row_filter.value_string;
-    apply_filter_operation(
+    return apply_filter_operation(
         column_data.typed<bke::InstanceReference>(),
         [&](const bke::InstanceReference cell) {
           switch (cell.type()) {
@@ -307,6 +288,8 @@ static void apply_row_filter(const SpreadsheetRowFilter &row_filter,
         prev_mask,
         new_indices);
   }
+  /* Unsupported column types and operations don't match any row. */
+  return {};
 }
 
 static bool use_row_filters(const SpaceSpreadsheet &sspreadsheet)
@@ -349,13 +332,10 @@ IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
 
   IndexMask mask(tot_rows);
 
-  Vector<int64_t> mask_indices;
-  mask_indices.reserve(tot_rows);
-
   if (use_selection) {
     const GeometryDataSource *geometry_data_source = dynamic_cast<const GeometryDataSource *>(
         &data_source);
-    mask = geometry_data_source->apply_selection_filter(mask_indices);
+    mask = geometry_data_source->apply_selection_filter(scope.construct<Vector<int64_t>>());
   }
 
   if (use_filters) {
@@ -369,21 +349,14 @@ IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
         if (!columns.contains(row_filter->column_name)) {
           continue;
         }
-        Vector<int64_t> new_indices;
-        new_indices.reserve(mask_indices.size());
-        apply_row_filter(*row_filter, columns, mask, new_indices);
-        std::swap(new_indices, mask_indices);
-        mask = IndexMask(mask_indices);
+        /* Every filter only checks the rows that passed the previous filters. The indices are
+         * owned by the scope, because the returned mask may reference them. */
+        mask = apply_row_filter(*row_filter, columns, mask, scope.construct<Vector<int64_t>>());
       }
     }
   }
 
-  if (mask_indices.is_empty()) {
-    BLI_assert(mask.is_empty() || mask.is_range());
-    return mask;
-  }
-
-  return IndexMask(scope.add_value(std::move(mask_indices)));
+  return mask;
 }
 
 SpreadsheetRowFilter *spreadsheet_row_filter_new()
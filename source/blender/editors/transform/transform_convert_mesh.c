@@ -15,6 +15,7 @@
 #include "BLI_linklist_stack.h"
 #include "BLI_math.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 
 #include "BKE_context.h"
 #include "BKE_crazyspace.h"
@@ -1461,10 +1462,113 @@ static void VertsToTransData(TransInfo *t,
   }
 }
 
+struct TransDataArgs_EditVerts {
+  TransInfo *t;
+  TransDataContainer *tc;
+  BMEditMesh *em;
+  float mtx[3][3];
+  float smtx[3][3];
+  int prop_mode;
+  /** Index in #TransDataContainer.data or #TransDataContainer.data_mirror, -1 when unused. */
+  const int *vert_td_index;
+  const int *dists_index;
+  const float *dists;
+  const struct TransIslandData *island_data;
+  struct TransMirrorData *mirror_data;
+  const struct TransMeshDataCrazySpace *crazyspace_data;
+};
+
+static void tc_mesh_transdata_vert_create_fn(void *__restrict iter_data_v,
+                                             const int a,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct TransDataArgs_EditVerts *data = iter_data_v;
+  const int td_index = data->vert_td_index[a];
+  if (td_index == -1) {
+    return;
+  }
+
+  TransInfo *t = data->t;
+  TransDataContainer *tc = data->tc;
+  BMesh *bm = data->em->bm;
+  BMVert *eve = BM_vert_at_index(bm, a);
+  const struct TransIslandData *island_data = data->island_data;
+  struct TransMirrorData *mirror_data = data->mirror_data;
+  const struct TransMeshDataCrazySpace *crazyspace_data = data->crazyspace_data;
+  const int prop_mode = data->prop_mode;
+
+  int island_index = -1;
+  if (island_data->island_vert_map) {
+    const int *dists_index = data->dists_index;
+    const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
+    island_index = island_data->island_vert_map[connected_index];
+  }
+
+  if (mirror_data->vert_map && mirror_data->vert_map[a].index != -1) {
+    TransDataMirror *td_mirror = &tc->data_mirror[td_index];
+    int elem_index = mirror_data->vert_map[a].index;
+    BMVert *v_src = BM_vert_at_index(bm, elem_index);
+
+    if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+      mirror_data->vert_map[a].flag |= TD_SELECTED;
+    }
+
+    td_mirror->extra = eve;
+    td_mirror->loc = eve->co;
+    copy_v3_v3(td_mirror->iloc, eve->co);
+    td_mirror->flag = mirror_data->vert_map[a].flag;
+    td_mirror->loc_src = v_src->co;
+    tc_mesh_transdata_center_copy(island_data, island_index, td_mirror->iloc, td_mirror->center);
+    return;
+  }
+
+  TransData *tob = &tc->data[td_index];
+  TransDataExtension *tx = tc->data_ext ? &tc->data_ext[td_index] : NULL;
+
+  /* Do not use the island center in case we are using islands
+   * only to get axis for snap/rotate to normal... */
+  VertsToTransData(t, tob, tx, data->em, eve, island_data, island_index);
+
+  /* selected */
+  if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
+    tob->flag |= TD_SELECTED;
+  }
+
+  if (prop_mode) {
+    if (prop_mode & T_PROP_CONNECTED) {
+      tob->dist = data->dists[a];
+    }
+    else {
+      tob->flag |= TD_NOTCONNECTED;
+      tob->dist = FLT_MAX;
+    }
+  }
+
+  /* CrazySpace */
+  transform_convert_mesh_crazyspace_transdata_set(
+      data->mtx,
+      data->smtx,
+      crazyspace_data->defmats ? crazyspace_data->defmats[a] : NULL,
+      crazyspace_data->quats && BM_elem_flag_test(eve, BM_ELEM_TAG) ? crazyspace_data->quats[a] :
+                                                                      NULL,
+      tob);
+
+  if (tc->use_mirror_axis_any) {
+    if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_X;
+    }
+    if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Y;
+    }
+    if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
+      tob->flag |= TD_MIRROR_EDGE_Z;
+    }
+  }
+}
+
 static void createTransEditVerts(bContext *UNUSED(C), TransInfo *t)
 {
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-    TransDataExtension *tx = NULL;
     BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
     Mesh *me = tc->obedit->data;
     BMesh *bm = em->bm;
@@ -1588,90 +1692,49 @@ static void createTransEditVerts(bContext *UNUSED(C), TransInfo *t)
        * but this stores loads of extra stuff, for TFM_SHRINKFATTEN its even more overkill
        * since we may not use the 'alt' transform mode to maintain shell thickness,
        * but with generic transform code its hard to lazy init vars */
-      tx = tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension),
-                                      "TransObData ext");
+      tc->data_ext = MEM_callocN(tc->data_len * sizeof(TransDataExtension), "TransObData ext");
     }
 
-    TransData *tob = tc->data;
-    TransDataMirror *td_mirror = tc->data_mirror;
+    /* Find the output index of every vertex first, so the #TransData can be filled in parallel. */
+    int *vert_td_index = MEM_mallocN(bm->totvert * sizeof(int), __func__);
+    int td_index = 0, td_mirror_index = 0;
     BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, a) {
+      vert_td_index[a] = -1;
       if (BM_elem_flag_test(eve, BM_ELEM_HIDDEN)) {
         continue;
       }
-
-      int island_index = -1;
-      if (island_data.island_vert_map) {
-        const int connected_index = (dists_index && dists_index[a] != -1) ? dists_index[a] : a;
-        island_index = island_data.island_vert_map[connected_index];
-      }
-
       if (mirror_data.vert_map && mirror_data.vert_map[a].index != -1) {
-        int elem_index = mirror_data.vert_map[a].index;
-        BMVert *v_src = BM_vert_at_index(bm, elem_index);
-
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          mirror_data.vert_map[a].flag |= TD_SELECTED;
-        }
-
-        td_mirror->extra = eve;
-        td_mirror->loc = eve->co;
-        copy_v3_v3(td_mirror->iloc, eve->co);
-        td_mirror->flag = mirror_data.vert_map[a].flag;
-        td_mirror->loc_src = v_src->co;
-        tc_mesh_transdata_center_copy(
-            &island_data, island_index, td_mirror->iloc, td_mirror->center);
-
-        td_mirror++;
+        vert_td_index[a] = td_mirror_index++;
       }
       else if (prop_mode || BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-        /* Do not use the island center in case we are using islands
-         * only to get axis for snap/rotate to normal... */
-        VertsToTransData(t, tob, tx, em, eve, &island_data, island_index);
-        if (tx) {
-          tx++;
-        }
-
-        /* selected */
-        if (BM_elem_flag_test(eve, BM_ELEM_SELECT)) {
-          tob->flag |= TD_SELECTED;
-        }
-
-        if (prop_mode) {
-          if (prop_mode & T_PROP_CONNECTED) {
-            tob->dist = dists[a];
-          }
-          else {
-            tob->flag |= TD_NOTCONNECTED;
-            tob->dist = FLT_MAX;
-          }
-        }
-
-        /* CrazySpace */
-        transform_convert_mesh_crazyspace_transdata_set(
-            mtx,
-            smtx,
-            crazyspace_data.defmats ? crazyspace_data.defmats[a] : NULL,
-            crazyspace_data.quats && BM_elem_flag_test(eve, BM_ELEM_TAG) ?
-                crazyspace_data.quats[a] :
-                NULL,
-            tob);
-
-        if (tc->use_mirror_axis_any) {
-          if (tc->use_mirror_axis_x && fabsf(tob->loc[0]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_X;
-          }
-          if (tc->use_mirror_axis_y && fabsf(tob->loc[1]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Y;
-          }
-          if (tc->use_mirror_axis_z && fabsf(tob->loc[2]) < TRANSFORM_MAXDIST_MIRROR) {
-            tob->flag |= TD_MIRROR_EDGE_Z;
-          }
-        }
-
-        tob++;
-      }
-    }
-
+        vert_td_index[a] = td_index++;
+      }
+    }
+    BLI_assert(td_index == tc->data_len);
+    BLI_assert(td_mirror_index == tc->data_mirror_len);
+
+    BM_mesh_elem_table_ensure(bm, BM_VERT);
+
+    struct TransDataArgs_EditVerts data = {
+        .t = t,
+        .tc = tc,
+        .em = em,
+        .prop_mode = prop_mode,
+        .vert_td_index = vert_td_index,
+        .dists_index = dists_index,
+        .dists = dists,
+        .island_data = &island_data,
+        .mirror_data = &mirror_data,
+        .crazyspace_data = &crazyspace_data,
+    };
+    copy_m3_m3(data.mtx, mtx);
+    copy_m3_m3(data.smtx, smtx);
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (bm->totvert >= TRANSDATA_THREAD_LIMIT);
+    BLI_task_parallel_range(0, bm->totvert, &data, tc_mesh_transdata_vert_create_fn, &settings);
+
+    MEM_freeN(vert_td_index);
     transform_convert_mesh_islanddata_free(&island_data);
     transform_convert_mesh_mirrordata_free(&mirror_data);
     transform_convert_mesh_crazyspace_free(&crazyspace_data);
@@ -2002,41 +2065,58 @@ static void tc_mesh_partial_update(TransInfo *t,
 /** \name Recalc Mesh Data
  * \{ */
 
-static void tc_mesh_transdata_mirror_apply(TransDataContainer *tc)
+static void tc_mesh_transdata_mirror_edge_apply_fn(void *__restrict iter_data_v,
+                                                   const int iter,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  if (tc->use_mirror_axis_any) {
-    int i;
-    TransData *td;
-    for (i = 0, td = tc->data; i < tc->data_len; i++, td++) {
-      if (td->flag & (TD_MIRROR_EDGE_X | TD_MIRROR_EDGE_Y | TD_MIRROR_EDGE_Z)) {
-        if (td->flag & TD_MIRROR_EDGE_X) {
-          td->loc[0] = 0.0f;
-        }
-        if (td->flag & TD_MIRROR_EDGE_Y) {
-          td->loc[1] = 0.0f;
-        }
-        if (td->flag & TD_MIRROR_EDGE_Z) {
-          td->loc[2] = 0.0f;
-        }
-      }
+  TransDataContainer *tc = iter_data_v;
+  TransData *td = &tc->data[iter];
+  if (td->flag & (TD_MIRROR_EDGE_X | TD_MIRROR_EDGE_Y | TD_MIRROR_EDGE_Z)) {
+    if (td->flag & TD_MIRROR_EDGE_X) {
+      td->loc[0] = 0.0f;
     }
-
-    TransDataMirror *td_mirror = tc->data_mirror;
-    for (i = 0; i < tc->data_mirror_len; i++, td_mirror++) {
-      copy_v3_v3(td_mirror->loc, td_mirror->loc_src);
-      if (td_mirror->flag & TD_MIRROR_X) {
-        td_mirror->loc[0] *= -1;
-      }
-      if (td_mirror->flag & TD_MIRROR_Y) {
-        td_mirror->loc[1] *= -1;
-      }
-      if (td_mirror->flag & TD_MIRROR_Z) {
-        td_mirror->loc[2] *= -1;
-      }
+    if (td->flag & TD_MIRROR_EDGE_Y) {
+      td->loc[1] = 0.0f;
+    }
+    if (td->flag & TD_MIRROR_EDGE_Z) {
+      td->loc[2] = 0.0f;
     }
   }
 }
 
+static void tc_mesh_transdata_mirror_elem_apply_fn(void *__restrict iter_data_v,
+                                                   const int iter,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  TransDataContainer *tc = iter_data_v;
+  TransDataMirror *td_mirror = &tc->data_mirror[iter];
+  copy_v3_v3(td_mirror->loc, td_mirror->loc_src);
+  if (td_mirror->flag & TD_MIRROR_X) {
+    td_mirror->loc[0] *= -1;
+  }
+  if (td_mirror->flag & TD_MIRROR_Y) {
+    td_mirror->loc[1] *= -1;
+  }
+  if (td_mirror->flag & TD_MIRROR_Z) {
+    td_mirror->loc[2] *= -1;
+  }
+}
+
+static void tc_mesh_transdata_mirror_apply(TransDataContainer *tc)
+{
+  if (tc->use_mirror_axis_any) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (tc->data_len >= TRANSDATA_THREAD_LIMIT);
+    BLI_task_parallel_range(
+        0, tc->data_len, tc, tc_mesh_transdata_mirror_edge_apply_fn, &settings);
+
+    settings.use_threading = (tc->data_mirror_len >= TRANSDATA_THREAD_LIMIT);
+    BLI_task_parallel_range(
+        0, tc->data_mirror_len, tc, tc_mesh_transdata_mirror_elem_apply_fn, &settings);
+  }
+}
+
 static void recalcData_mesh(TransInfo *t)
 {
   bool is_canceling = t->state == TRANS_CANCEL;
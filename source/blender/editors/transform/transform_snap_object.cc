@@ -15,7 +15,9 @@
 #include "BLI_map.hh"
 #include "BLI_math.h"
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector_set.hh"
 
 #include "DNA_armature_types.h"
 #include "DNA_curve_types.h"
@@ -50,6 +52,7 @@ using blender::float3;
 using blender::float4x4;
 using blender::Map;
 using blender::Span;
+using blender::VectorSet;
 
 /* -------------------------------------------------------------------- */
 /** \name Internal Data Types
@@ -126,6 +129,8 @@ struct SnapObjectContext {
     short clip_plane_len;
     eSnapMode snap_to_flag;
     bool has_occlusion_plane; /* Ignore plane of occlusion in curves. */
+    /** The BVH-trees of all snappable meshes were built, see #snap_object_mesh_trees_ensure. */
+    bool mesh_trees_ensured;
   } runtime;
 
   /* Output. */
@@ -518,6 +523,80 @@ static eSnapMode iter_snap_objects(SnapObjectContext *sctx,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh BVH-Tree Pre-Building
+ * \{ */
+
+/** Evaluated meshes to snap to, with the `use_hide` option of their looptris tree. */
+using SnapMeshSet = VectorSet<std::pair<const Mesh *, bool>>;
+
+static eSnapMode snap_mesh_collect_fn(SnapObjectContext * /*sctx*/,
+                                      const SnapObjectParams * /*params*/,
+                                      Object *ob_eval,
+                                      ID *ob_data,
+                                      const float /*obmat*/[4][4],
+                                      bool /*is_object_active*/,
+                                      bool use_hide,
+                                      void *data)
+{
+  if (ob_data == nullptr || ob_eval->type != OB_MESH || ob_eval->dt == OB_BOUNDBOX ||
+      GS(ob_data->name) != ID_ME) {
+    return SCE_SNAP_MODE_NONE;
+  }
+  const Mesh *me_eval = reinterpret_cast<const Mesh *>(ob_data);
+  if (me_eval->totvert == 0) {
+    return SCE_SNAP_MODE_NONE;
+  }
+  static_cast<SnapMeshSet *>(data)->add({me_eval, use_hide});
+  return SCE_SNAP_MODE_NONE;
+}
+
+/**
+ * Build the BVH-trees that snapping needs for all snappable meshes in parallel, instead of one
+ * after the other when the objects are first tested.
+ *
+ * The trees are stored in the #bke::MeshRuntime.bvh_cache of the evaluated meshes, so they are
+ * shared by all snap contexts and stay valid until the depsgraph re-evaluates the mesh.
+ * Meshes in edit-mode use #SnapData_EditMesh instead and are skipped.
+ */
+static void snap_object_mesh_trees_ensure(SnapObjectContext *sctx,
+                                          const SnapObjectParams *params,
+                                          const eSnapMode snap_to_flag)
+{
+  if (sctx->runtime.mesh_trees_ensured) {
+    return;
+  }
+  sctx->runtime.mesh_trees_ensured = true;
+
+  SnapMeshSet meshes;
+  iter_snap_objects(sctx, params, snap_mesh_collect_fn, &meshes);
+
+  const bool use_loose_edges = snap_to_flag & (SCE_SNAP_MODE_EDGE | SCE_SNAP_MODE_EDGE_MIDPOINT |
+                                               SCE_SNAP_MODE_EDGE_PERPENDICULAR);
+  const bool use_loose_verts = snap_to_flag & SCE_SNAP_MODE_VERTEX;
+
+  blender::threading::parallel_for(meshes.index_range(), 1, [&](const blender::IndexRange range) {
+    for (const int i : range) {
+      const Mesh *me_eval = meshes[i].first;
+      const bool use_hide = meshes[i].second;
+      BVHTreeFromMesh treedata;
+      BKE_bvhtree_from_mesh_get(
+          &treedata, me_eval, use_hide ? BVHTREE_FROM_LOOPTRI_NO_HIDDEN : BVHTREE_FROM_LOOPTRI, 4);
+      free_bvhtree_from_mesh(&treedata);
+      if (use_loose_edges || use_loose_verts) {
+        BKE_bvhtree_from_mesh_get(&treedata, me_eval, BVHTREE_FROM_LOOSEEDGES, 2);
+        free_bvhtree_from_mesh(&treedata);
+      }
+      if (use_loose_verts) {
+        BKE_bvhtree_from_mesh_get(&treedata, me_eval, BVHTREE_FROM_LOOSEVERTS, 2);
+        free_bvhtree_from_mesh(&treedata);
+      }
+    }
+  });
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Ray Cast Functions
  * \{ */
@@ -3229,6 +3308,8 @@ static eSnapMode transform_snap_context_project_view3d_mixed_impl(SnapObjectCont
 
   BLI_assert((snap_to_flag & SCE_SNAP_MODE_GEOM) != 0);
 
+  snap_object_mesh_trees_ensure(sctx, params, snap_to_flag);
+
   eSnapMode retval = SCE_SNAP_MODE_NONE;
 
   bool has_hit = false;
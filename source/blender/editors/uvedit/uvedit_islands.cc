@@ -11,6 +11,8 @@
  * This API uses #BMesh data structures and doesn't have limitations for manifold meshes.
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_meshdata_types.h"
@@ -21,7 +23,10 @@
 #include "BLI_convexhull_2d.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_rect.h"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_editmesh.h"
@@ -103,6 +108,8 @@ static void bm_face_array_calc_bounds(BMFace **faces,
 /**
  * Return an array of un-ordered UV coordinates,
  * without duplicating coordinates for loops that share a vertex.
+ *
+ * \note Only the loops of `faces` are accessed, so this can run for multiple islands in parallel.
  */
 static float (*bm_face_array_calc_unique_uv_coords(
     BMFace **faces, int faces_len, const int cd_loop_uv_offset, int *r_coords_len))[2]
@@ -110,13 +117,7 @@ static float (*bm_face_array_calc_unique_uv_coords(
   BLI_assert(cd_loop_uv_offset >= 0);
   int coords_len_alloc = 0;
   for (int i = 0; i < faces_len; i++) {
-    BMFace *f = faces[i];
-    BMLoop *l_iter, *l_first;
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      BM_elem_flag_enable(l_iter, BM_ELEM_TAG);
-    } while ((l_iter = l_iter->next) != l_first);
-    coords_len_alloc += f->len;
+    coords_len_alloc += faces[i]->len;
   }
 
   float(*coords)[2] = static_cast<float(*)[2]>(
@@ -128,39 +129,20 @@ static float (*bm_face_array_calc_unique_uv_coords(
     BMLoop *l_iter, *l_first;
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
-      if (!BM_elem_flag_test(l_iter, BM_ELEM_TAG)) {
-        /* Already walked over, continue. */
-        continue;
-      }
-
-      BM_elem_flag_disable(l_iter, BM_ELEM_TAG);
       const float *luv = BM_ELEM_CD_GET_FLOAT_P(l_iter, cd_loop_uv_offset);
       copy_v2_v2(coords[coords_len++], luv);
-
-      /* Un tag all connected so we don't add them twice.
-       * Note that we will tag other loops not part of `faces` but this is harmless,
-       * since we're only turning off a tag. */
-      BMVert *v_pivot = l_iter->v;
-      BMEdge *e_first = v_pivot->e;
-      const BMEdge *e = e_first;
-      do {
-        if (e->l != nullptr) {
-          const BMLoop *l_radial = e->l;
-          do {
-            if (l_radial->v == l_iter->v) {
-              if (BM_elem_flag_test(l_radial, BM_ELEM_TAG)) {
-                const float *luv_radial = BM_ELEM_CD_GET_FLOAT_P(l_radial, cd_loop_uv_offset);
-                if (equals_v2v2(luv, luv_radial)) {
-                  /* Don't add this UV when met in another face in `faces`. */
-                  BM_elem_flag_disable(l_iter, BM_ELEM_TAG);
-                }
-              }
-            }
-          } while ((l_radial = l_radial->radial_next) != e->l);
-        }
-      } while ((e = BM_DISK_EDGE_NEXT(e, v_pivot)) != e_first);
     } while ((l_iter = l_iter->next) != l_first);
   }
+
+  /* Loops that share a vertex in the same island usually share the UV too, sort to remove the
+   * duplicates without having to walk over the loops around each vertex. */
+  using blender::float2;
+  blender::MutableSpan<float2> coords_span(reinterpret_cast<float2 *>(coords), coords_len);
+  std::sort(coords_span.begin(), coords_span.end(), [](const float2 &a, const float2 &b) {
+    return (a.x < b.x) || (a.x == b.x && a.y < b.y);
+  });
+  coords_len = int(std::unique(coords_span.begin(), coords_span.end()) - coords_span.begin());
+
   *r_coords_len = coords_len;
   return coords;
 }
@@ -725,23 +707,29 @@ void ED_uvedit_pack_islands_multi(const Scene *scene,
   float selection_min_co[2], selection_max_co[2];
   INIT_MINMAX2(selection_min_co, selection_max_co);
 
-  for (int index = 0; index < island_vector.size(); index++) {
-    FaceIsland *island = island_vector[index];
-    if (closest_udim) {
-      /* Only calculate selection bounding box if using closest_udim. */
+  if (closest_udim) {
+    /* Only calculate selection bounding box if using closest_udim. */
+    for (FaceIsland *island : island_vector) {
       for (int i = 0; i < island->faces_len; i++) {
         BMFace *f = island->faces[i];
         BM_face_uv_minmax(f, selection_min_co, selection_max_co, island->offsets.uv);
       }
     }
+  }
 
-    if (params->rotate) {
-      face_island_uv_rotate_fit_aabb(island);
-    }
+  /* Islands don't share any faces, so they can be rotated and measured independently. */
+  blender::threading::parallel_for(
+      island_vector.index_range(), 16, [&](const blender::IndexRange range) {
+        for (const int index : range) {
+          FaceIsland *island = island_vector[index];
+          if (params->rotate) {
+            face_island_uv_rotate_fit_aabb(island);
+          }
 
-    bm_face_array_calc_bounds(
-        island->faces, island->faces_len, island->offsets.uv, &island->bounds_rect);
-  }
+          bm_face_array_calc_bounds(
+              island->faces, island->faces_len, island->offsets.uv, &island->bounds_rect);
+        }
+      });
 
   /* Center of bounding box containing all selected UVs. */
   float selection_center[2];
@@ -789,23 +777,28 @@ void ED_uvedit_pack_islands_multi(const Scene *scene,
 
   float matrix[2][2];
   float matrix_inverse[2][2];
-  float pre_translate[2];
-  for (int i = 0; i < island_vector.size(); i++) {
-    FaceIsland *island = island_vector[box_array[i].index];
-    matrix[0][0] = scale[0];
-    matrix[0][1] = 0.0f;
-    matrix[1][0] = 0.0f;
-    matrix[1][1] = scale[1];
-    invert_m2_m2(matrix_inverse, matrix);
-
-    /* Add base_offset, post transform. */
-    mul_v2_m2v2(pre_translate, matrix_inverse, base_offset);
-
-    /* Translate to box_array from bounds_rect. */
-    pre_translate[0] += box_array[i].x - island->bounds_rect.xmin;
-    pre_translate[1] += box_array[i].y - island->bounds_rect.ymin;
-    island_uv_transform(island, matrix, pre_translate);
-  }
+  matrix[0][0] = scale[0];
+  matrix[0][1] = 0.0f;
+  matrix[1][0] = 0.0f;
+  matrix[1][1] = scale[1];
+  invert_m2_m2(matrix_inverse, matrix);
+
+  /* Add base_offset, post transform. */
+  float base_translate[2];
+  mul_v2_m2v2(base_translate, matrix_inverse, base_offset);
+
+  blender::threading::parallel_for(
+      island_vector.index_range(), 64, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          FaceIsland *island = island_vector[box_array[i].index];
+
+          /* Translate to box_array from bounds_rect. */
+          float pre_translate[2];
+          pre_translate[0] = base_translate[0] + box_array[i].x - island->bounds_rect.xmin;
+          pre_translate[1] = base_translate[1] + box_array[i].y - island->bounds_rect.ymin;
+          island_uv_transform(island, matrix, pre_translate);
+        }
+      });
 
   for (uint ob_index = 0; ob_index < objects_len; ob_index++) {
     Object *obedit = objects[ob_index];
@@ -5,6 +5,7 @@
  * \brief Detects/flags/builds extended features edges on the WXEdge structure
  */
 
+#include <atomic>
 #include <cfloat>
 
 #include "FEdgeXDetector.h"
@@ -13,11 +14,25 @@
 #include "../geometry/normal_cycle.h"
 
 #include "BLI_sys_types.h"
+#include "BLI_task.hh"
 
 #include "BKE_global.h"
 
 namespace Freestyle {
 
+/* Call `fn` for every face or edge of a shape in parallel. The per-element passes only modify the
+ * element they are called for and read its neighbors, so they don't need synchronization. */
+template<typename T, typename Fn>
+static void parallel_for_each_element(vector<T *> &elements, const Fn &fn)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(elements.size()), 1024, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          fn(elements[i]);
+        }
+      });
+}
+
 void FEdgeXDetector::processShapes(WingedEdge &we)
 {
   bool progressBarDisplay = false;
@@ -118,12 +133,9 @@ void FEdgeXDetector::preProcessShape(WXShape *iWShape)
   _meanEdgeSize = iWShape->ComputeMeanEdgeSize();
 #endif
 
-  vector<WFace *> &wfaces = iWShape->GetFaceList();
-  vector<WFace *>::iterator f, fend;
   // view dependent stuff
-  for (f = wfaces.begin(), fend = wfaces.end(); f != fend; ++f) {
-    preProcessFace((WXFace *)(*f));
-  }
+  parallel_for_each_element(iWShape->GetFaceList(),
+                            [&](WFace *face) { preProcessFace((WXFace *)face); });
 
   if (_computeRidgesAndValleys || _computeSuggestiveContours) {
     vector<WVertex *> &wvertices = iWShape->getVertexList();
@@ -253,18 +265,12 @@ void FEdgeXDetector::computeCurvatures(WXVertex *vertex)
 void FEdgeXDetector::processSilhouetteShape(WXShape *iWShape)
 {
   // Make a first pass on every polygons in order to compute all their silhouette relative values:
-  vector<WFace *> &wfaces = iWShape->GetFaceList();
-  vector<WFace *>::iterator f, fend;
-  for (f = wfaces.begin(), fend = wfaces.end(); f != fend; ++f) {
-    ProcessSilhouetteFace((WXFace *)(*f));
-  }
+  parallel_for_each_element(iWShape->GetFaceList(),
+                            [&](WFace *face) { ProcessSilhouetteFace((WXFace *)face); });
 
   // Make a pass on the edges to detect the silhouette edges that are not smooth
-  vector<WEdge *>::iterator we, weend;
-  vector<WEdge *> &wedges = iWShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessSilhouetteEdge((WXEdge *)(*we));
-  }
+  parallel_for_each_element(iWShape->getEdgeList(),
+                            [&](WEdge *edge) { ProcessSilhouetteEdge((WXEdge *)edge); });
 }
 
 void FEdgeXDetector::ProcessSilhouetteFace(WXFace *iFace)
@@ -347,11 +353,8 @@ void FEdgeXDetector::processBorderShape(WXShape *iWShape)
     return;
   }
   // Make a pass on the edges to detect the BORDER
-  vector<WEdge *>::iterator we, weend;
-  vector<WEdge *> &wedges = iWShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessBorderEdge((WXEdge *)(*we));
-  }
+  parallel_for_each_element(iWShape->getEdgeList(),
+                            [&](WEdge *edge) { ProcessBorderEdge((WXEdge *)edge); });
 }
 
 void FEdgeXDetector::ProcessBorderEdge(WXEdge *iEdge)
@@ -373,11 +376,8 @@ void FEdgeXDetector::processCreaseShape(WXShape *iWShape)
   }
 
   // Make a pass on the edges to detect the CREASE
-  vector<WEdge *>::iterator we, weend;
-  vector<WEdge *> &wedges = iWShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessCreaseEdge((WXEdge *)(*we));
-  }
+  parallel_for_each_element(iWShape->getEdgeList(),
+                            [&](WEdge *edge) { ProcessCreaseEdge((WXEdge *)edge); });
 }
 
 void FEdgeXDetector::ProcessCreaseEdge(WXEdge *iEdge)
@@ -716,11 +716,8 @@ void FEdgeXDetector::processMaterialBoundaryShape(WXShape *iWShape)
     return;
   }
   // Make a pass on the edges to detect material boundaries
-  vector<WEdge *>::iterator we, weend;
-  vector<WEdge *> &wedges = iWShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessMaterialBoundaryEdge((WXEdge *)(*we));
-  }
+  parallel_for_each_element(iWShape->getEdgeList(),
+                            [&](WEdge *edge) { ProcessMaterialBoundaryEdge((WXEdge *)edge); });
 }
 
 void FEdgeXDetector::ProcessMaterialBoundaryEdge(WXEdge *iEdge)
@@ -737,12 +734,9 @@ void FEdgeXDetector::ProcessMaterialBoundaryEdge(WXEdge *iEdge)
 /////////////
 void FEdgeXDetector::processEdgeMarksShape(WXShape *iShape)
 {
-  // Make a pass on the edges to detect material boundaries
-  vector<WEdge *>::iterator we, weend;
-  vector<WEdge *> &wedges = iShape->getEdgeList();
-  for (we = wedges.begin(), weend = wedges.end(); we != weend; ++we) {
-    ProcessEdgeMarks((WXEdge *)(*we));
-  }
+  // Make a pass on the edges to detect edge marks
+  parallel_for_each_element(iShape->getEdgeList(),
+                            [&](WEdge *edge) { ProcessEdgeMarks((WXEdge *)edge); });
 }
 
 void FEdgeXDetector::ProcessEdgeMarks(WXEdge *iEdge)
@@ -756,21 +750,20 @@ void FEdgeXDetector::ProcessEdgeMarks(WXEdge *iEdge)
 /////////////////////
 void FEdgeXDetector::buildSmoothEdges(WXShape *iShape)
 {
-  bool hasSmoothEdges = false;
+  std::atomic<bool> hasSmoothEdges = false;
 
   // Make a last pass to build smooth edges from the previous stored values:
   //--------------------------------------------------------------------------
-  vector<WFace *> &wfaces = iShape->GetFaceList();
-  for (vector<WFace *>::iterator f = wfaces.begin(), fend = wfaces.end(); f != fend; ++f) {
-    vector<WXFaceLayer *> &faceLayers = ((WXFace *)(*f))->getSmoothLayers();
+  parallel_for_each_element(iShape->GetFaceList(), [&](WFace *face) {
+    vector<WXFaceLayer *> &faceLayers = ((WXFace *)face)->getSmoothLayers();
     for (vector<WXFaceLayer *>::iterator wxfl = faceLayers.begin(), wxflend = faceLayers.end();
          wxfl != wxflend;
          ++wxfl) {
       if ((*wxfl)->BuildSmoothEdge()) {
-        hasSmoothEdges = true;
+        hasSmoothEdges.store(true, std::memory_order_relaxed);
       }
     }
-  }
+  });
 
   if (hasSmoothEdges && !_computeRidgesAndValleys && !_computeSuggestiveContours) {
     vector<WVertex *> &wvertices = iShape->getVertexList();
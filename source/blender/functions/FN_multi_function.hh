@@ -138,6 +138,17 @@ class MultiFunction {
   virtual ExecutionHints get_execution_hints() const;
 };
 
+/**
+ * Add all parameters of #full_params to #r_sliced_params, restricted to the given range of
+ * indices. This allows calling a function on a part of the full mask with indices that start at
+ * zero, so that it doesn't have to allocate arrays for the indices before the slice. Only single
+ * value parameters are supported.
+ */
+void add_sliced_parameters(const Signature &signature,
+                           Params &full_params,
+                           IndexRange slice_range,
+                           ParamsBuilder &r_sliced_params);
+
 inline ParamsBuilder::ParamsBuilder(const MultiFunction &fn, int64_t mask_size)
     : ParamsBuilder(fn.signature(), IndexMask(mask_size))
 {
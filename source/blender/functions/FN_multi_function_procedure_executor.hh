@@ -10,13 +10,28 @@
 
 namespace blender::fn::multi_function {
 
-/** A multi-function that executes a procedure internally. */
+/**
+ * A multi-function that executes a procedure internally.
+ *
+ * Every instruction is executed for all indices at once, storing its results in a temporary
+ * buffer for the following instructions. To keep these buffers in the CPU cache, large masks are
+ * split into tiles of #tile_size indices that run through the whole procedure one after another.
+ * The tiles reuse the same temporary buffers, so the memory used by one call is bounded by the
+ * tile size and the number of variables that are alive at the same time.
+ */
 class ProcedureExecutor : public MultiFunction {
  private:
   Signature signature_;
   const Procedure &procedure_;
 
  public:
+  /**
+   * Number of indices that are processed by the procedure at once. Small enough for the
+   * intermediate buffers of typical procedures to fit into the L2 cache, large enough for the
+   * per-instruction overhead not to matter.
+   */
+  static constexpr int64_t tile_size = 4096;
+
   ProcedureExecutor(const Procedure &procedure);
 
   void call(IndexMask mask, Params params, Context context) const override;
@@ -62,10 +62,10 @@ static int64_t compute_alignment(const int64_t grain_size)
   return 32;
 }
 
-static void add_sliced_parameters(const Signature &signature,
-                                  Params &full_params,
-                                  const IndexRange slice_range,
-                                  ParamsBuilder &r_sliced_params)
+void add_sliced_parameters(const Signature &signature,
+                           Params &full_params,
+                           const IndexRange slice_range,
+                           ParamsBuilder &r_sliced_params)
 {
   for (const int param_index : signature.params.index_range()) {
     const ParamType &param_type = signature.params[param_index].type;
@@ -133,6 +133,12 @@ class ValueAllocator : NonCopyable, NonMovable {
   /** All buffers in the free-lists below have been allocated with this allocator. */
   LinearAllocator<> &linear_allocator_;
 
+  /**
+   * Number of elements that every span buffer has room for. Using the same size for all buffers
+   * allows reusing them for every variable and for all tiles of a tiled execution.
+   */
+  int64_t span_buffer_size_;
+
   /**
    * Use stacks so that the most recently used buffers are reused first. This improves cache
    * efficiency.
@@ -153,7 +159,8 @@ class ValueAllocator : NonCopyable, NonMovable {
   Map<const CPPType *, Stack<void *>> single_value_free_lists_;
 
  public:
-  ValueAllocator(LinearAllocator<> &linear_allocator) : linear_allocator_(linear_allocator)
+  ValueAllocator(LinearAllocator<> &linear_allocator, const int64_t span_buffer_size)
+      : linear_allocator_(linear_allocator), span_buffer_size_(span_buffer_size)
   {
   }
 
@@ -174,6 +181,8 @@ class ValueAllocator : NonCopyable, NonMovable {
 
   VariableValue_Span *obtain_Span(const CPPType &type, int size)
   {
+    BLI_assert(size <= span_buffer_size_);
+    size = span_buffer_size_;
     void *buffer = nullptr;
 
     const int64_t element_size = type.size();
@@ -821,17 +830,17 @@ class VariableState : NonCopyable, NonMovable {
 /** Keeps track of the states of all variables during evaluation. */
 class VariableStates {
  private:
-  ValueAllocator value_allocator_;
+  ValueAllocator &value_allocator_;
   const Procedure &procedure_;
   /** The state of every variable, indexed by #Variable::index_in_procedure(). */
   Array<VariableState> variable_states_;
   IndexMask full_mask_;
 
  public:
-  VariableStates(LinearAllocator<> &linear_allocator,
+  VariableStates(ValueAllocator &value_allocator,
                  const Procedure &procedure,
                  IndexMask full_mask)
-      : value_allocator_(linear_allocator),
+      : value_allocator_(value_allocator),
         procedure_(procedure),
         variable_states_(procedure.variables().size()),
         full_mask_(full_mask)
@@ -1169,6 +1178,24 @@ class InstructionScheduler {
   }
 };
 
+static bool supports_tiled_execution(const ProcedureExecutor &fn)
+{
+  /* Vector parameters can't be sliced. */
+  for (const int param_index : fn.param_indices()) {
+    if (fn.param_type(param_index).data_type().is_vector()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void execute_procedure(const ProcedureExecutor &fn,
+                              const Procedure &procedure,
+                              IndexMask full_mask,
+                              Params params,
+                              Context context,
+                              ValueAllocator &value_allocator);
+
 void ProcedureExecutor::call(IndexMask full_mask, Params params, Context context) const
 {
   BLI_assert(procedure_.validate());
@@ -1177,11 +1204,55 @@ void ProcedureExecutor::call(IndexMask full_mask, Params params, Context context
   LinearAllocator<> linear_allocator;
   linear_allocator.provide_buffer(local_buffer);
 
-  VariableStates variable_states{linear_allocator, procedure_, full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
+  if (full_mask.size() <= tile_size || !supports_tiled_execution(*this)) {
+    ValueAllocator value_allocator{linear_allocator, full_mask.min_array_size()};
+    execute_procedure(*this, procedure_, full_mask, params, context, value_allocator);
+    return;
+  }
+
+  const int64_t tiles_num = (full_mask.size() + tile_size - 1) / tile_size;
+  auto tile_range = [&](const int64_t tile_index) {
+    const int64_t start = tile_index * tile_size;
+    return IndexRange(start, std::min(tile_size, full_mask.size() - start));
+  };
+
+  /* All tiles share the same temporary buffers, so they have to be large enough for the tile
+   * with the largest range of indices. */
+  int64_t max_tile_array_size = 0;
+  for (const int64_t tile_index : IndexRange(tiles_num)) {
+    const IndexMask tile_mask = full_mask.slice(tile_range(tile_index));
+    max_tile_array_size = std::max(max_tile_array_size, tile_mask.last() - tile_mask[0] + 1);
+  }
+  ValueAllocator value_allocator{linear_allocator, max_tile_array_size};
+
+  for (const int64_t tile_index : IndexRange(tiles_num)) {
+    const IndexRange range = tile_range(tile_index);
+    const IndexMask tile_mask = full_mask.slice(range);
+
+    /* Offset the indices of every tile to start at zero, so that the temporary buffers only have
+     * to be as large as the tile. */
+    const IndexRange input_slice_range{tile_mask[0], tile_mask.last() - tile_mask[0] + 1};
+    Vector<int64_t> offset_mask_indices;
+    const IndexMask offset_mask = full_mask.slice_and_offset(range, offset_mask_indices);
+
+    ParamsBuilder tile_params{*this, offset_mask.min_array_size()};
+    add_sliced_parameters(signature_, params, input_slice_range, tile_params);
+    execute_procedure(*this, procedure_, offset_mask, tile_params, context, value_allocator);
+  }
+}
+
+static void execute_procedure(const ProcedureExecutor &fn,
+                              const Procedure &procedure,
+                              IndexMask full_mask,
+                              Params params,
+                              Context context,
+                              ValueAllocator &value_allocator)
+{
+  VariableStates variable_states{value_allocator, procedure, full_mask};
+  variable_states.add_initial_variable_states(fn, procedure, params);
 
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), full_mask);
 
   /* Loop until all indices got to a return instruction. */
   while (!scheduler.is_done()) {
@@ -1230,9 +1301,9 @@ void ProcedureExecutor::call(IndexMask full_mask, Params params, Context context
     }
   }
 
-  for (const int param_index : this->param_indices()) {
-    const ParamType param_type = this->param_type(param_index);
-    const Variable *variable = procedure_.params()[param_index].variable;
+  for (const int param_index : fn.param_indices()) {
+    const ParamType param_type = fn.param_type(param_index);
+    const Variable *variable = procedure.params()[param_index].variable;
     VariableState &variable_state = variable_states.get_variable_state(*variable);
     switch (param_type.interface_type()) {
       case ParamType::Input: {
@@ -3,6 +3,7 @@
 #include "testing/testing.h"
 
 #include "BLI_cpp_type.hh"
+#include "BLI_timeit.hh"
 #include "FN_field.hh"
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_test_common.hh"
@@ -123,6 +124,30 @@ TEST(field, InputAndFunction)
   EXPECT_EQ(result[8], 16);
 }
 
+TEST(field, LargeDomain)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  auto add_fn = mf::build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  auto mul_fn = mf::build::SI2_SO<int, int, int>("mul", [](int a, int b) { return a * b; });
+  GField sum_field{
+      std::make_shared<FieldOperation>(FieldOperation(add_fn, {index_field, index_field})), 0};
+  GField output_field{
+      std::make_shared<FieldOperation>(FieldOperation(mul_fn, {sum_field, index_field})), 0};
+
+  /* Large enough to be split into multiple threads and tiles. */
+  const int size = 30000;
+  Array<int> result(size);
+
+  FieldContext context;
+  FieldEvaluator evaluator{context, size};
+  evaluator.add_with_destination(output_field, result.as_mutable_span());
+  evaluator.evaluate();
+  for (const int i : result.index_range()) {
+    EXPECT_EQ(result[i], (i + i) * i);
+  }
+}
+
 TEST(field, TwoFunctions)
 {
   GField index_field{std::make_shared<IndexFieldInput>()};
@@ -280,4 +305,49 @@ TEST(field, IgnoredOutput)
   EXPECT_EQ(results.get(3), 5);
 }
 
+/**
+ * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
+ */
+#if 0
+TEST(field, Benchmark)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  auto add_fn = mf::build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  auto mul_fn = mf::build::SI2_SO<int, int, int>("mul", [](int a, int b) { return a * b; });
+  GField sum_field{
+      std::make_shared<FieldOperation>(FieldOperation(add_fn, {index_field, index_field})), 0};
+  GField output_field{
+      std::make_shared<FieldOperation>(FieldOperation(mul_fn, {sum_field, index_field})), 0};
+
+  const int size = 10000000;
+  Array<int> result(size);
+  /* Every other index, to measure evaluation on a non-contiguous mask. */
+  Array<int64_t> indices(size / 2);
+  for (const int i : indices.index_range()) {
+    indices[i] = i * 2;
+  }
+  const IndexMask mask{indices};
+  for (int i = 0; i < 3; i++) {
+    {
+      SCOPED_TIMER("Field Evaluate Full");
+      FieldContext context;
+      FieldEvaluator evaluator{context, size};
+      evaluator.add_with_destination(output_field, result.as_mutable_span());
+      evaluator.evaluate();
+    }
+    {
+      SCOPED_TIMER("Field Evaluate Mask");
+      FieldContext context;
+      FieldEvaluator evaluator{context, &mask};
+      evaluator.add_with_destination(output_field, result.as_mutable_span());
+      evaluator.evaluate();
+    }
+  }
+
+  /* Print the value for simple error checking and to avoid some compiler optimizations. */
+  std::cout << "Value: " << result[size - 1] << "\n";
+}
+#endif /* Benchmark */
+
 }  // namespace blender::fn::tests
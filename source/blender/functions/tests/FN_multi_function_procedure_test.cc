@@ -408,4 +408,62 @@ TEST(multi_function_procedure, OutputBufferReplaced)
   EXPECT_EQ(output[2], output_value);
 }
 
+TEST(multi_function_procedure, LargeSparseMask)
+{
+  /**
+   * procedure(int var1, int var2, int *var4) {
+   *   int var3 = var1 * var2;
+   *   var4 = var3 + var1;
+   * }
+   */
+
+  auto add_fn = mf::build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+  auto mul_fn = mf::build::SI2_SO<int, int, int>("mul", [](int a, int b) { return a * b; });
+
+  Procedure procedure;
+  ProcedureBuilder builder{procedure};
+
+  Variable *var1 = &builder.add_single_input_parameter<int>();
+  Variable *var2 = &builder.add_single_input_parameter<int>();
+  auto [var3] = builder.add_call<1>(mul_fn, {var1, var2});
+  auto [var4] = builder.add_call<1>(add_fn, {var3, var1});
+  builder.add_destruct({var1, var2, var3});
+  builder.add_return();
+  builder.add_output_parameter(*var4);
+
+  EXPECT_TRUE(procedure.validate());
+
+  ProcedureExecutor executor{procedure};
+
+  /* Use enough indices for the procedure to be executed in multiple tiles. */
+  const int size = ProcedureExecutor::tile_size * 5 + 7;
+  Array<int> input(size);
+  for (const int i : input.index_range()) {
+    input[i] = i;
+  }
+  Vector<int64_t> indices;
+  for (int64_t i = 3; i < size; i += 2) {
+    indices.append(i);
+  }
+
+  ParamsBuilder params{executor, size};
+  ContextBuilder context;
+
+  Array<int> output(size, -1);
+  params.add_readonly_single_input(input.as_span());
+  params.add_readonly_single_input_value(3);
+  params.add_uninitialized_single_output(output.as_mutable_span());
+
+  executor.call(indices.as_span(), params, context);
+
+  for (const int i : output.index_range()) {
+    if (i >= 3 && i % 2 == 1) {
+      EXPECT_EQ(output[i], i * 4);
+    }
+    else {
+      EXPECT_EQ(output[i], -1);
+    }
+  }
+}
+
 }  // namespace blender::fn::multi_function::tests
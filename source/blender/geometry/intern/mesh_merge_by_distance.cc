@@ -7,6 +7,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "DNA_mesh_types.h"
@@ -1489,6 +1490,38 @@ static void customdata_weld(
 /** \name Mesh Vertex Merging
  * \{ */
 
+/** Number of source elements that are copied to the result by one task. */
+static constexpr int64_t copy_chunk_size = 4096;
+
+static IndexRange copy_chunk_range(const int64_t chunk, const int64_t src_size)
+{
+  const int64_t start = chunk * copy_chunk_size;
+  return IndexRange(start, std::min(copy_chunk_size, src_size - start));
+}
+
+/**
+ * Compute the index of the first result element of every chunk of source elements, so that the
+ * chunks can be written to the result in parallel. \a dst_size_fn returns the number of result
+ * elements created for a source element.
+ */
+template<typename Fn>
+static Array<int> calc_copy_chunk_offsets(const int64_t src_size, const Fn &dst_size_fn)
+{
+  const int64_t chunks_num = (src_size + copy_chunk_size - 1) / copy_chunk_size;
+  Array<int> offsets(chunks_num + 1);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    for (const int64_t chunk : chunks) {
+      int dst_size = 0;
+      for (const int64_t i : copy_chunk_range(chunk, src_size)) {
+        dst_size += dst_size_fn(int(i));
+      }
+      offsets[chunk] = dst_size;
+    }
+  });
+  offset_indices::accumulate_counts_to_offsets(offsets);
+  return offsets;
+}
+
 static Mesh *create_merged_mesh(const Mesh &mesh,
                                 MutableSpan<int> vert_dest_map,
                                 const int removed_vertex_count)
@@ -1522,35 +1555,45 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
    * This map will be used to adjust edges and loops to point to new vertex indices. */
   MutableSpan<int> vert_final_map = vert_group_map;
 
-  int dest_index = 0;
-  for (int i = 0; i < totvert; i++) {
-    int source_index = i;
-    int count = 0;
-    while (i < totvert && vert_group_map[i] == OUT_OF_CONTEXT) {
-      vert_final_map[i] = dest_index + count;
-      count++;
-      i++;
-    }
-    if (count) {
-      CustomData_copy_data(&mesh.vdata, &result->vdata, source_index, dest_index, count);
-      dest_index += count;
-    }
-    if (i == totvert) {
-      break;
-    }
-    if (vert_group_map[i] != ELEM_MERGED) {
-      const int *wgroup = &weld_mesh.vert_groups_offs[vert_group_map[i]];
-      customdata_weld(&mesh.vdata,
-                      &result->vdata,
-                      &weld_mesh.vert_groups_buffer[*wgroup],
-                      *(wgroup + 1) - *wgroup,
-                      dest_index);
-      vert_final_map[i] = dest_index;
-      dest_index++;
-    }
-  }
+  const Array<int> vert_chunk_offsets = calc_copy_chunk_offsets(
+      totvert, [&](const int i) { return int(vert_group_map[i] != ELEM_MERGED); });
+  threading::parallel_for(
+      vert_chunk_offsets.index_range().drop_back(1), 1, [&](const IndexRange chunks) {
+        for (const int64_t chunk : chunks) {
+          const IndexRange chunk_range = copy_chunk_range(chunk, totvert);
+          const int chunk_end = int(chunk_range.one_after_last());
+          int dest_index = vert_chunk_offsets[chunk];
+          for (int i = int(chunk_range.start()); i < chunk_end; i++) {
+            int source_index = i;
+            int count = 0;
+            while (i < chunk_end && vert_group_map[i] == OUT_OF_CONTEXT) {
+              vert_final_map[i] = dest_index + count;
+              count++;
+              i++;
+            }
+            if (count) {
+              CustomData_copy_data(&mesh.vdata, &result->vdata, source_index, dest_index, count);
+              dest_index += count;
+            }
+            if (i == chunk_end) {
+              break;
+            }
+            if (vert_group_map[i] != ELEM_MERGED) {
+              const int *wgroup = &weld_mesh.vert_groups_offs[vert_group_map[i]];
+              customdata_weld(&mesh.vdata,
+                              &result->vdata,
+                              &weld_mesh.vert_groups_buffer[*wgroup],
+                              *(wgroup + 1) - *wgroup,
+                              dest_index);
+              vert_final_map[i] = dest_index;
+              dest_index++;
+            }
+          }
+          BLI_assert(dest_index == vert_chunk_offsets[chunk + 1]);
+        }
+      });
 
-  BLI_assert(dest_index == result_nverts);
+  BLI_assert(vert_chunk_offsets.last() == result_nverts);
 
   /* Edges. */
 
@@ -1558,97 +1601,142 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
    * This map will be used to adjust edges and loops to point to new edge indices. */
   MutableSpan<int> edge_final_map = weld_mesh.edge_groups_map;
 
-  dest_index = 0;
-  for (int i = 0; i < totedge; i++) {
-    const int source_index = i;
-    int count = 0;
-    while (i < totedge && weld_mesh.edge_groups_map[i] == OUT_OF_CONTEXT) {
-      edge_final_map[i] = dest_index + count;
-      count++;
-      i++;
-    }
-    if (count) {
-      CustomData_copy_data(&mesh.edata, &result->edata, source_index, dest_index, count);
-      MEdge *me = &dst_edges[dest_index];
-      dest_index += count;
-      for (; count--; me++) {
-        me->v1 = vert_final_map[me->v1];
-        me->v2 = vert_final_map[me->v2];
-      }
-    }
-    if (i == totedge) {
-      break;
-    }
-    if (weld_mesh.edge_groups_map[i] != ELEM_MERGED) {
-      const int wegpr_index = weld_mesh.edge_groups_map[i];
-      const int wegrp_offs = weld_mesh.edge_groups_offs[wegpr_index];
-      const int wegrp_len = weld_mesh.edge_groups_offs[wegpr_index + 1] - wegrp_offs;
-      int2 &wegrp_verts = weld_mesh.edge_groups_verts[wegpr_index];
-      customdata_weld(&mesh.edata,
-                      &result->edata,
-                      &weld_mesh.edge_groups_buffer[wegrp_offs],
-                      wegrp_len,
-                      dest_index);
-      MEdge *me = &dst_edges[dest_index];
-      me->v1 = vert_final_map[wegrp_verts[0]];
-      me->v2 = vert_final_map[wegrp_verts[1]];
-
-      edge_final_map[i] = dest_index;
-      dest_index++;
-    }
-  }
+  const Array<int> edge_chunk_offsets = calc_copy_chunk_offsets(
+      totedge, [&](const int i) { return int(weld_mesh.edge_groups_map[i] != ELEM_MERGED); });
+  threading::parallel_for(
+      edge_chunk_offsets.index_range().drop_back(1), 1, [&](const IndexRange chunks) {
+        for (const int64_t chunk : chunks) {
+          const IndexRange chunk_range = copy_chunk_range(chunk, totedge);
+          const int chunk_end = int(chunk_range.one_after_last());
+          int dest_index = edge_chunk_offsets[chunk];
+          for (int i = int(chunk_range.start()); i < chunk_end; i++) {
+            const int source_index = i;
+            int count = 0;
+            while (i < chunk_end && weld_mesh.edge_groups_map[i] == OUT_OF_CONTEXT) {
+              edge_final_map[i] = dest_index + count;
+              count++;
+              i++;
+            }
+            if (count) {
+              CustomData_copy_data(&mesh.edata, &result->edata, source_index, dest_index, count);
+              MEdge *me = dst_edges.data() + dest_index;
+              dest_index += count;
+              for (; count--; me++) {
+                me->v1 = vert_final_map[me->v1];
+                me->v2 = vert_final_map[me->v2];
+              }
+            }
+            if (i == chunk_end) {
+              break;
+            }
+            if (weld_mesh.edge_groups_map[i] != ELEM_MERGED) {
+              const int wegpr_index = weld_mesh.edge_groups_map[i];
+              const int wegrp_offs = weld_mesh.edge_groups_offs[wegpr_index];
+              const int wegrp_len = weld_mesh.edge_groups_offs[wegpr_index + 1] - wegrp_offs;
+              int2 &wegrp_verts = weld_mesh.edge_groups_verts[wegpr_index];
+              customdata_weld(&mesh.edata,
+                              &result->edata,
+                              &weld_mesh.edge_groups_buffer[wegrp_offs],
+                              wegrp_len,
+                              dest_index);
+              MEdge *me = &dst_edges[dest_index];
+              me->v1 = vert_final_map[wegrp_verts[0]];
+              me->v2 = vert_final_map[wegrp_verts[1]];
+
+              edge_final_map[i] = dest_index;
+              dest_index++;
+            }
+          }
+          BLI_assert(dest_index == edge_chunk_offsets[chunk + 1]);
+        }
+      });
 
-  BLI_assert(dest_index == result_nedges);
+  BLI_assert(edge_chunk_offsets.last() == result_nedges);
 
   /* Polys/Loops. */
 
-  MPoly *r_mp = dst_polys.data();
-  MLoop *r_ml = dst_loops.data();
-  int r_i = 0;
-  int loop_cur = 0;
-  Array<int, 64> group_buffer(weld_mesh.max_poly_len);
-  for (const int i : src_polys.index_range()) {
-    const MPoly &mp = src_polys[i];
-    const int loop_start = loop_cur;
+  /* Polygons that are not collapsed keep their place, welded polygons have #WeldPoly::loop_len
+   * corners. */
+  const auto poly_is_kept = [&](const int i) {
     const int poly_ctx = weld_mesh.poly_map[i];
-    if (poly_ctx == OUT_OF_CONTEXT) {
-      int mp_loop_len = mp.totloop;
-      CustomData_copy_data(&mesh.ldata, &result->ldata, mp.loopstart, loop_cur, mp_loop_len);
-      loop_cur += mp_loop_len;
-      for (; mp_loop_len--; r_ml++) {
-        r_ml->v = vert_final_map[r_ml->v];
-        r_ml->e = edge_final_map[r_ml->e];
-      }
-    }
-    else {
-      const WeldPoly &wp = weld_mesh.wpoly[poly_ctx];
-      WeldLoopOfPolyIter iter;
-      if (!weld_iter_loop_of_poly_begin(
-              iter, wp, weld_mesh.wloop, src_loops, weld_mesh.loop_map, group_buffer.data())) {
-        continue;
-      }
+    return poly_ctx == OUT_OF_CONTEXT || weld_mesh.wpoly[poly_ctx].poly_dst == OUT_OF_CONTEXT;
+  };
+  const Array<int> poly_chunk_offsets = calc_copy_chunk_offsets(
+      src_polys.size(), [&](const int i) { return int(poly_is_kept(i)); });
+  const Array<int> loop_chunk_offsets = calc_copy_chunk_offsets(
+      src_polys.size(), [&](const int i) {
+        if (!poly_is_kept(i)) {
+          return 0;
+        }
+        const int poly_ctx = weld_mesh.poly_map[i];
+        return poly_ctx == OUT_OF_CONTEXT ? src_polys[i].totloop :
+                                            weld_mesh.wpoly[poly_ctx].loop_len;
+      });
+  threading::parallel_for(
+      poly_chunk_offsets.index_range().drop_back(1), 1, [&](const IndexRange chunks) {
+        Array<int, 64> group_buffer(weld_mesh.max_poly_len);
+        for (const int64_t chunk : chunks) {
+          MPoly *r_mp = dst_polys.data() + poly_chunk_offsets[chunk];
+          int loop_cur = loop_chunk_offsets[chunk];
+          MLoop *r_ml = dst_loops.data() + loop_cur;
+          int r_i = poly_chunk_offsets[chunk];
+          for (const int i : copy_chunk_range(chunk, src_polys.size())) {
+            const MPoly &mp = src_polys[i];
+            const int loop_start = loop_cur;
+            const int poly_ctx = weld_mesh.poly_map[i];
+            if (poly_ctx == OUT_OF_CONTEXT) {
+              int mp_loop_len = mp.totloop;
+              CustomData_copy_data(
+                  &mesh.ldata, &result->ldata, mp.loopstart, loop_cur, mp_loop_len);
+              loop_cur += mp_loop_len;
+              for (; mp_loop_len--; r_ml++) {
+                r_ml->v = vert_final_map[r_ml->v];
+                r_ml->e = edge_final_map[r_ml->e];
+              }
+            }
+            else {
+              const WeldPoly &wp = weld_mesh.wpoly[poly_ctx];
+              WeldLoopOfPolyIter iter;
+              if (!weld_iter_loop_of_poly_begin(iter,
+                                                wp,
+                                                weld_mesh.wloop,
+                                                src_loops,
+                                                weld_mesh.loop_map,
+                                                group_buffer.data())) {
+                continue;
+              }
 
-      if (wp.poly_dst != OUT_OF_CONTEXT) {
-        continue;
-      }
-      while (weld_iter_loop_of_poly_next(iter)) {
-        customdata_weld(
-            &mesh.ldata, &result->ldata, group_buffer.data(), iter.group_len, loop_cur);
-        int v = vert_final_map[iter.v];
-        int e = edge_final_map[iter.e];
-        r_ml->v = v;
-        r_ml->e = e;
-        r_ml++;
-        loop_cur++;
-      }
-    }
+              if (wp.poly_dst != OUT_OF_CONTEXT) {
+                continue;
+              }
+              while (weld_iter_loop_of_poly_next(iter)) {
+                customdata_weld(
+                    &mesh.ldata, &result->ldata, group_buffer.data(), iter.group_len, loop_cur);
+                int v = vert_final_map[iter.v];
+                int e = edge_final_map[iter.e];
+                r_ml->v = v;
+                r_ml->e = e;
+                r_ml++;
+                loop_cur++;
+              }
+            }
 
-    CustomData_copy_data(&mesh.pdata, &result->pdata, i, r_i, 1);
-    r_mp->loopstart = loop_start;
-    r_mp->totloop = loop_cur - loop_start;
-    r_mp++;
-    r_i++;
-  }
+            CustomData_copy_data(&mesh.pdata, &result->pdata, i, r_i, 1);
+            r_mp->loopstart = loop_start;
+            r_mp->totloop = loop_cur - loop_start;
+            r_mp++;
+            r_i++;
+          }
+          BLI_assert(r_i == poly_chunk_offsets[chunk + 1]);
+          BLI_assert(loop_cur == loop_chunk_offsets[chunk + 1]);
+        }
+      });
+
+  MPoly *r_mp = dst_polys.data() + poly_chunk_offsets.last();
+  MLoop *r_ml = dst_loops.data() + loop_chunk_offsets.last();
+  int r_i = poly_chunk_offsets.last();
+  int loop_cur = loop_chunk_offsets.last();
+  Array<int, 64> group_buffer(weld_mesh.max_poly_len);
 
   /* New Polygons. */
   for (const int i : weld_mesh.wpoly.index_range().take_back(weld_mesh.wpoly_new_len)) {
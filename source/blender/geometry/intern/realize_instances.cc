@@ -14,6 +14,7 @@
 
 #include "BKE_collection.h"
 #include "BKE_curves.hh"
+#include "BKE_customdata.h"
 #include "BKE_deform.h"
 #include "BKE_geometry_set_instances.hh"
 #include "BKE_instances.hh"
@@ -1047,6 +1048,129 @@ static void execute_realize_mesh_task(const RealizeInstancesOptions &options,
       dst_attribute_writers);
 }
 
+/**
+ * Check if the only realized mesh ends up unchanged in the result, apart from its transform. Then
+ * the result can share the attribute arrays of that mesh instead of copying them.
+ */
+static bool can_realize_single_mesh_by_sharing(const AllMeshesInfo &all_meshes_info,
+                                               const RealizeMeshTask &task,
+                                               const OrderedAttributes &ordered_attributes)
+{
+  const MeshRealizeInfo &mesh_info = *task.mesh_info;
+  const Mesh &mesh = *mesh_info.mesh;
+  if (all_meshes_info.create_id_attribute) {
+    return false;
+  }
+  /* Vertex groups are turned into generic attributes otherwise. */
+  if (!BLI_listbase_is_empty(&mesh.vertex_group_names) || !mesh.deform_verts().is_empty()) {
+    return false;
+  }
+  for (const int attribute_index : ordered_attributes.index_range()) {
+    /* The attribute must exist on the mesh with the same type, it does not come from an instance
+     * or from another mesh. */
+    if (!mesh_info.attributes[attribute_index].has_value()) {
+      return false;
+    }
+    const std::optional<AttributeMetaData> meta_data = mesh.attributes().lookup_meta_data(
+        ordered_attributes.ids[attribute_index]);
+    const AttributeKind &kind = ordered_attributes.kinds[attribute_index];
+    if (!meta_data || meta_data->domain != kind.domain || meta_data->data_type != kind.data_type) {
+      return false;
+    }
+  }
+
+  /* Material indices must stay the same. */
+  for (const int i : mesh_info.material_index_map.index_range()) {
+    if (mesh_info.material_index_map[i] != i) {
+      return false;
+    }
+  }
+  if (all_meshes_info.create_material_index_attribute) {
+    if (!mesh.attributes().contains("material_index")) {
+      return false;
+    }
+    const IndexRange valid_indices(std::max<int>(mesh.totcol, 1));
+    const VArraySpan<int> material_indices(mesh_info.material_indices);
+    for (const int index : material_indices) {
+      if (!valid_indices.contains(index)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Create the result mesh from a single mesh. The attribute arrays are shared with the source mesh
+ * (see #CD_SHARE), only the positions are copied when they are transformed.
+ */
+static void realize_single_mesh_by_sharing(const RealizeMeshTask &task,
+                                           const OrderedAttributes &ordered_attributes,
+                                           const VectorSet<Material *> &ordered_materials,
+                                           GeometrySet &r_realized_geometry)
+{
+  const Mesh &src_mesh = *task.mesh_info->mesh;
+  Mesh *dst_mesh = BKE_mesh_new_nomain(0, 0, 0, 0, 0);
+  CustomData_free(&dst_mesh->vdata, 0);
+  CustomData_free(&dst_mesh->edata, 0);
+  CustomData_free(&dst_mesh->pdata, 0);
+  CustomData_free(&dst_mesh->ldata, 0);
+  dst_mesh->totvert = src_mesh.totvert;
+  dst_mesh->totedge = src_mesh.totedge;
+  dst_mesh->totpoly = src_mesh.totpoly;
+  dst_mesh->totloop = src_mesh.totloop;
+  /* Only copy generic attributes and topology like the general code path. */
+  const eCustomDataMask mask = CD_MASK_PROP_ALL | CD_MASK_MEDGE | CD_MASK_MPOLY | CD_MASK_MLOOP;
+  CustomData_copy(&src_mesh.vdata, &dst_mesh->vdata, mask, CD_SHARE, dst_mesh->totvert);
+  CustomData_copy(&src_mesh.edata, &dst_mesh->edata, mask, CD_SHARE, dst_mesh->totedge);
+  CustomData_copy(&src_mesh.pdata, &dst_mesh->pdata, mask, CD_SHARE, dst_mesh->totpoly);
+  CustomData_copy(&src_mesh.ldata, &dst_mesh->ldata, mask, CD_SHARE, dst_mesh->totloop);
+  MeshComponent &dst_component = r_realized_geometry.get_component_for_write<MeshComponent>();
+  dst_component.replace(dst_mesh);
+
+  BKE_mesh_copy_parameters_for_eval(dst_mesh, &src_mesh);
+  for (const int i : IndexRange(ordered_materials.size())) {
+    BKE_id_material_eval_assign(&dst_mesh->id, i + 1, ordered_materials[i]);
+  }
+
+  /* Remove the attributes that are not propagated, e.g. anonymous attributes that are not used
+   * anymore. Removing a shared attribute does not free its data. */
+  bke::MutableAttributeAccessor dst_attributes = dst_mesh->attributes_for_write();
+  while (true) {
+    std::optional<std::string> name_to_remove;
+    const bke::AnonymousAttributeID *anonymous_id_to_remove = nullptr;
+    dst_attributes.for_all(
+        [&](const AttributeIDRef &attribute_id, const AttributeMetaData & /*meta_data*/) {
+          if (ordered_attributes.ids.contains(attribute_id) ||
+              ELEM(attribute_id.name(), "position", "material_index")) {
+            return true;
+          }
+          if (attribute_id.is_anonymous()) {
+            anonymous_id_to_remove = &attribute_id.anonymous_id();
+          }
+          else {
+            name_to_remove = attribute_id.name();
+          }
+          return false;
+        });
+    if (anonymous_id_to_remove != nullptr) {
+      dst_attributes.remove(*anonymous_id_to_remove);
+    }
+    else if (name_to_remove.has_value()) {
+      dst_attributes.remove(*name_to_remove);
+    }
+    else {
+      break;
+    }
+  }
+
+  if (task.transform != float4x4::identity()) {
+    MutableSpan<float3> positions = dst_mesh->vert_positions_for_write();
+    copy_transformed_positions(positions, task.transform, positions);
+    BKE_mesh_tag_coords_changed(dst_mesh);
+  }
+}
+
 static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
                                        const AllMeshesInfo &all_meshes_info,
                                        const Span<RealizeMeshTask> tasks,
@@ -1058,6 +1182,14 @@ static void execute_realize_mesh_tasks(const RealizeInstancesOptions &options,
     return;
   }
 
+  if (tasks.size() == 1 &&
+      can_realize_single_mesh_by_sharing(all_meshes_info, tasks.first(), ordered_attributes))
+  {
+    realize_single_mesh_by_sharing(
+        tasks.first(), ordered_attributes, ordered_materials, r_realized_geometry);
+    return;
+  }
+
   const RealizeMeshTask &last_task = tasks.last();
   const Mesh &last_mesh = *last_task.mesh_info->mesh;
   const int tot_vertices = last_task.start_indices.vertex + last_mesh.totvert;
@@ -4,6 +4,8 @@
  * \ingroup eduv
  */
 
+#include <atomic>
+
 #include "GEO_uv_parametrizer.h"
 
 #include "MEM_guardedalloc.h"
@@ -17,6 +19,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_rand.h"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "eigen_capi.h"
@@ -4015,47 +4018,62 @@ void GEO_uv_parametrizer_lscm_begin(ParamHandle *phandle, bool live, bool abf)
   param_assert(phandle->state == PHANDLE_STATE_CONSTRUCTED);
   phandle->state = PHANDLE_STATE_LSCM;
 
-  for (int i = 0; i < phandle->ncharts; i++) {
-    for (PFace *f = phandle->charts[i]->faces; f; f = f->nextlink) {
-      p_face_backup_uvs(f);
-    }
-    p_chart_lscm_begin(phandle->charts[i], live, abf);
-  }
+  /* Charts don't share any elements, so they can be prepared independently. ABF is the most
+   * expensive part and its cost varies a lot between charts, so use the smallest grain size. */
+  blender::threading::parallel_for(
+      blender::IndexRange(phandle->ncharts), 1, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          for (PFace *f = phandle->charts[i]->faces; f; f = f->nextlink) {
+            p_face_backup_uvs(f);
+          }
+          p_chart_lscm_begin(phandle->charts[i], live, abf);
+        }
+      });
 }
 
 void GEO_uv_parametrizer_lscm_solve(ParamHandle *phandle, int *count_changed, int *count_failed)
 {
   param_assert(phandle->state == PHANDLE_STATE_LSCM);
 
-  for (int i = 0; i < phandle->ncharts; i++) {
-    PChart *chart = phandle->charts[i];
-
-    if (chart->u.lscm.context) {
-      const bool result = p_chart_lscm_solve(phandle, chart);
-
-      if (result && !chart->has_pins) {
-        p_chart_rotate_minimum_area(chart);
-      }
-      else if (result && chart->u.lscm.single_pin) {
-        p_chart_rotate_fit_aabb(chart);
-        p_chart_lscm_transform_single_pin(chart);
-      }
-
-      if (!result || !chart->has_pins) {
-        p_chart_lscm_end(chart);
-      }
-
-      if (result) {
-        if (count_changed != nullptr) {
-          *count_changed += 1;
-        }
-      }
-      else {
-        if (count_failed != nullptr) {
-          *count_failed += 1;
+  std::atomic<int> changed_num = 0;
+  std::atomic<int> failed_num = 0;
+
+  /* Every chart has its own linear system, so they are solved in parallel. */
+  blender::threading::parallel_for(
+      blender::IndexRange(phandle->ncharts), 1, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          PChart *chart = phandle->charts[i];
+
+          if (chart->u.lscm.context) {
+            const bool result = p_chart_lscm_solve(phandle, chart);
+
+            if (result && !chart->has_pins) {
+              p_chart_rotate_minimum_area(chart);
+            }
+            else if (result && chart->u.lscm.single_pin) {
+              p_chart_rotate_fit_aabb(chart);
+              p_chart_lscm_transform_single_pin(chart);
+            }
+
+            if (!result || !chart->has_pins) {
+              p_chart_lscm_end(chart);
+            }
+
+            if (result) {
+              changed_num.fetch_add(1, std::memory_order_relaxed);
+            }
+            else {
+              failed_num.fetch_add(1, std::memory_order_relaxed);
+            }
+          }
         }
-      }
-    }
+      });
+
+  if (count_changed != nullptr) {
+    *count_changed += changed_num;
+  }
+  if (count_failed != nullptr) {
+    *count_failed += failed_num;
   }
 }
 
@@ -2381,21 +2381,12 @@ static void lineart_geometry_load_assign_thread(LineartObjectLoadTaskInfo *olti_
 static bool lineart_geometry_check_visible(double model_view_proj[4][4],
                                            double shift_x,
                                            double shift_y,
-                                           Mesh *use_mesh)
+                                           const BoundBox *bb)
 {
-  if (!use_mesh) {
-    return false;
-  }
-  float mesh_min[3], mesh_max[3];
-  INIT_MINMAX(mesh_min, mesh_max);
-  BKE_mesh_minmax(use_mesh, mesh_min, mesh_max);
-  BoundBox bb;
-  BKE_boundbox_init_from_minmax(&bb, mesh_min, mesh_max);
-
   double co[8][4];
   double tmp[3];
   for (int i = 0; i < 8; i++) {
-    copy_v3db_v3fl(co[i], bb.vec[i]);
+    copy_v3db_v3fl(co[i], bb->vec[i]);
     copy_v3_v3_db(tmp, co[i]);
     mul_v4_m4v3_db(co[i], model_view_proj, tmp);
     co[i][0] -= shift_x * 2 * co[i][3];
@@ -2463,6 +2454,14 @@ static void lineart_object_load_single_instance(LineartData *ld,
     }
   }
   else {
+    /* Converting to a mesh can be expensive, check the bounding box of the object first so
+     * that objects outside of the view are skipped before that. */
+    const BoundBox *ob_bb = BKE_object_boundbox_get(ob);
+    if (ob_bb &&
+        !lineart_geometry_check_visible(
+            obi->model_view_proj, ld->conf.shift_x, ld->conf.shift_y, ob_bb)) {
+      return;
+    }
     use_mesh = BKE_mesh_new_from_object(depsgraph, ob, true, true);
   }
 
@@ -2471,8 +2470,17 @@ static void lineart_object_load_single_instance(LineartData *ld,
     return;
   }
 
+  float mesh_min[3], mesh_max[3];
+  INIT_MINMAX(mesh_min, mesh_max);
+  BKE_mesh_minmax(use_mesh, mesh_min, mesh_max);
+  BoundBox bb;
+  BKE_boundbox_init_from_minmax(&bb, mesh_min, mesh_max);
   if (!lineart_geometry_check_visible(
-          obi->model_view_proj, ld->conf.shift_x, ld->conf.shift_y, use_mesh)) {
+          obi->model_view_proj, ld->conf.shift_x, ld->conf.shift_y, &bb)) {
+    if (ob->type != OB_MESH) {
+      /* The converted mesh isn't owned by anything else. */
+      BKE_id_free(nullptr, use_mesh);
+    }
     return;
   }
 
@@ -222,6 +222,10 @@ typedef enum eGPUTextureUsage {
 ENUM_OPERATORS(eGPUTextureUsage, GPU_TEXTURE_USAGE_GENERAL);
 
 unsigned int GPU_texture_memory_usage_get(void);
+/**
+ * Estimated amount of graphics memory used by the texture in bytes, including its mip levels.
+ */
+size_t GPU_texture_memory_size(const GPUTexture *tex);
 
 /**
  * \note \a data is expected to be float. If the \a format is not compatible with float data or if
@@ -237,6 +237,19 @@ uint GPU_texture_memory_usage_get()
   return 0;
 }
 
+size_t GPU_texture_memory_size(const GPUTexture *tex_)
+{
+  const Texture *tex = reinterpret_cast<const Texture *>(tex_);
+  /* Height and depth are also used for the layers of array and cube textures. */
+  size_t size = size_t(tex->width_get()) * size_t(max_ii(1, tex->height_get())) *
+                size_t(max_ii(1, tex->depth_get())) * to_bytesize(tex->format_get());
+  if (tex->mip_count() > 1) {
+    /* The mip chain of a 2D texture adds about a third of the base level. */
+    size += size / 3;
+  }
+  return size;
+}
+
 /* ------ Creation ------ */
 
 static inline GPUTexture *gpu_texture_create(const char *name,
@@ -238,8 +238,10 @@ static void detect_workarounds()
     GLContext::geometry_shader_invocations = false;
     GLContext::layered_rendering_support = false;
     GLContext::native_barycentric_support = false;
+    GLContext::parallel_shader_compile_support = false;
     GLContext::multi_bind_support = false;
     GLContext::multi_draw_indirect_support = false;
+    GLContext::program_binary_support = false;
     GLContext::shader_draw_parameters_support = false;
     GLContext::texture_cube_map_array_support = false;
     GLContext::texture_filter_anisotropic_support = false;
@@ -459,8 +461,10 @@ bool GLContext::geometry_shader_invocations = false;
 bool GLContext::fixed_restart_index_support = false;
 bool GLContext::layered_rendering_support = false;
 bool GLContext::native_barycentric_support = false;
+bool GLContext::parallel_shader_compile_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_draw_indirect_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::shader_draw_parameters_support = false;
 bool GLContext::stencil_texturing_support = false;
 bool GLContext::texture_cube_map_array_support = false;
@@ -561,8 +565,15 @@ void GLBackend::capabilities_init()
   GLContext::layered_rendering_support = epoxy_has_gl_extension("GL_AMD_vertex_shader_layer");
   GLContext::native_barycentric_support = epoxy_has_gl_extension(
       "GL_AMD_shader_explicit_vertex_parameter");
+  GLContext::parallel_shader_compile_support = epoxy_has_gl_extension(
+      "GL_KHR_parallel_shader_compile");
   GLContext::multi_bind_support = epoxy_has_gl_extension("GL_ARB_multi_bind");
   GLContext::multi_draw_indirect_support = epoxy_has_gl_extension("GL_ARB_multi_draw_indirect");
+  if (epoxy_gl_version() >= 41 || epoxy_has_gl_extension("GL_ARB_get_program_binary")) {
+    GLint binary_formats_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats_len);
+    GLContext::program_binary_support = binary_formats_len > 0;
+  }
   GLContext::shader_draw_parameters_support = epoxy_has_gl_extension(
       "GL_ARB_shader_draw_parameters");
   GLContext::stencil_texturing_support = epoxy_gl_version() >= 43;
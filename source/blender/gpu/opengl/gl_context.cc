@@ -45,6 +45,11 @@ GLContext::GLContext(void *ghost_window, GLSharedOrphanLists &shared_orphan_list
   glBufferData(GL_ARRAY_BUFFER, sizeof(data), data, GL_STATIC_DRAW);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 
+  if (parallel_shader_compile_support) {
+    /* Let the driver choose how many threads are used to compile shaders. */
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+  }
+
   state_manager = new GLStateManager();
   imm = new GLImmediate();
   ghost_window_ = ghost_window;
@@ -57,8 +57,10 @@ class GLContext : public Context {
   static bool fixed_restart_index_support;
   static bool layered_rendering_support;
   static bool native_barycentric_support;
+  static bool parallel_shader_compile_support;
   static bool multi_bind_support;
   static bool multi_draw_indirect_support;
+  static bool program_binary_support;
   static bool shader_draw_parameters_support;
   static bool stencil_texturing_support;
   static bool texture_cube_map_array_support;
@@ -5,8 +5,13 @@
  * \ingroup gpu
  */
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
@@ -907,15 +912,19 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   GLuint shader = glCreateShader(gl_stage);
   if (shader == 0) {
     fprintf(stderr, "GLShader: Error: Could not create shader object.\n");
+    compilation_failed_ = true;
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get(gl_stage);
-
   glShaderSource(shader, sources.size(), sources.data(), nullptr);
   glCompileShader(shader);
+  return shader;
+}
 
+bool GLShader::check_shader_stage(GLuint shader,
+                                  GLenum gl_stage,
+                                  MutableSpan<const char *> sources)
+{
   GLint status;
   glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
   if (!status || (G.debug & G_DEBUG_GPU)) {
@@ -942,33 +951,84 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   if (!status) {
     glDeleteShader(shader);
     compilation_failed_ = true;
-    return 0;
+    return false;
   }
 
   debug::object_label(gl_stage, shader, name);
 
   glAttachShader(shader_program_, shader);
-  return shader;
+  return true;
+}
+
+void GLShader::add_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Patch the shader code using the first source slot. */
+  sources[0] = glsl_patch_get(gl_stage);
+
+  StageSources stage;
+  stage.gl_stage = gl_stage;
+  for (const char *source : sources) {
+    stage.sources.append(source);
+  }
+  stage_sources_.append(std::move(stage));
+}
+
+bool GLShader::compile_shader_stages()
+{
+  /* Start compiling all stages before querying the result of any of them. This allows drivers
+   * that support parallel shader compilation to compile the stages at the same time. */
+  Array<Vector<const char *>> stages_sources(stage_sources_.size());
+  Array<GLuint> shaders(stage_sources_.size());
+  for (const int i : stage_sources_.index_range()) {
+    for (const std::string &source : stage_sources_[i].sources) {
+      stages_sources[i].append(source.c_str());
+    }
+    shaders[i] = this->create_shader_stage(stage_sources_[i].gl_stage, stages_sources[i]);
+  }
+
+  for (const int i : stage_sources_.index_range()) {
+    const GLenum gl_stage = stage_sources_[i].gl_stage;
+    GLuint shader = shaders[i];
+    if (shader == 0 || !this->check_shader_stage(shader, gl_stage, stages_sources[i])) {
+      shader = 0;
+    }
+    switch (gl_stage) {
+      case GL_VERTEX_SHADER:
+        vert_shader_ = shader;
+        break;
+      case GL_GEOMETRY_SHADER:
+        geom_shader_ = shader;
+        break;
+      case GL_FRAGMENT_SHADER:
+        frag_shader_ = shader;
+        break;
+      case GL_COMPUTE_SHADER:
+        compute_shader_ = shader;
+        break;
+    }
+  }
+  return !compilation_failed_;
 }
 
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  this->add_shader_stage(GL_VERTEX_SHADER, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  this->add_shader_stage(GL_GEOMETRY_SHADER, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  this->add_shader_stage(GL_FRAGMENT_SHADER, sources);
 }
 
 void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+  is_compute_ = true;
+  this->add_shader_stage(GL_COMPUTE_SHADER, sources);
 }
 
 bool GLShader::finalize(const shader::ShaderCreateInfo *info)
@@ -985,18 +1045,33 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     geometry_shader_from_glsl(sources);
   }
 
-  glLinkProgram(shader_program_);
+  const std::string cache_key = this->program_cache_key();
+  if (cache_key.empty() || !this->program_cache_load(cache_key)) {
+    if (!this->compile_shader_stages()) {
+      return false;
+    }
 
-  GLint status;
-  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
-  if (!status) {
-    char log[5000];
-    glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
-    Span<const char *> sources;
-    GLLogParser parser;
-    this->print_log(sources, log, "Linking", true, &parser);
-    return false;
+    if (!cache_key.empty()) {
+      glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glLinkProgram(shader_program_);
+
+    GLint status;
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    if (!status) {
+      char log[5000];
+      glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
+      Span<const char *> sources;
+      GLLogParser parser;
+      this->print_log(sources, log, "Linking", true, &parser);
+      return false;
+    }
+
+    if (!cache_key.empty()) {
+      this->program_cache_save(cache_key);
+    }
   }
+  stage_sources_.clear_and_shrink();
 
   if (info != nullptr && info->legacy_resource_location_ == false) {
     interface = new GLShaderInterface(shader_program_, *info);
@@ -1010,6 +1085,145 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ *
+ * Linked programs are stored in the user cache folder, so that the shaders don't have to be
+ * compiled again in the next session. Drivers reject binaries they can't load (e.g. after a
+ * driver update), in which case the program is compiled and stored again.
+ * \{ */
+
+struct ProgramCacheHeader {
+  uint32_t magic;
+  GLenum binary_format;
+};
+
+/* "GLPB" */
+static constexpr uint32_t program_cache_magic = 0x42504C47;
+
+static const std::string &program_cache_dir_get()
+{
+  static const std::string cache_dir = []() {
+    char dir[FILE_MAX];
+    if (!BKE_appdir_folder_caches(dir, sizeof(dir))) {
+      return std::string();
+    }
+    BLI_path_append(dir, sizeof(dir), "gpu-shaders");
+    if (!BLI_dir_create_recursive(dir)) {
+      return std::string();
+    }
+    return std::string(dir);
+  }();
+  return cache_dir;
+}
+
+static std::string program_cache_file_path(const std::string &key)
+{
+  char filepath[FILE_MAX];
+  BLI_path_join(
+      filepath, sizeof(filepath), program_cache_dir_get().c_str(), (key + ".bin").c_str());
+  return filepath;
+}
+
+std::string GLShader::program_cache_key() const
+{
+  /* Compile errors and warnings are only reported when the shaders are actually compiled. */
+  if (!GLContext::program_binary_support || (G.debug & G_DEBUG_GPU)) {
+    return "";
+  }
+  /* The transform feedback varyings are part of the program state and not of the sources. */
+  if (transform_feedback_type_ != GPU_SHADER_TFB_NONE) {
+    return "";
+  }
+  if (program_cache_dir_get().empty()) {
+    return "";
+  }
+
+  std::string data;
+  for (const GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    const char *str = reinterpret_cast<const char *>(glGetString(name));
+    if (str == nullptr) {
+      return "";
+    }
+    data += str;
+    data += '\0';
+  }
+  for (const StageSources &stage : stage_sources_) {
+    data += std::to_string(stage.gl_stage);
+    data += '\0';
+    for (const std::string &source : stage.sources) {
+      data += source;
+      data += '\0';
+    }
+  }
+
+  uchar digest[16];
+  BLI_hash_md5_buffer(data.data(), data.size(), digest);
+  char hex_digest[33];
+  BLI_hash_md5_to_hexdigest(digest, hex_digest);
+  return hex_digest;
+}
+
+bool GLShader::program_cache_load(const std::string &key)
+{
+  size_t size = 0;
+  void *data = BLI_file_read_binary_as_mem(program_cache_file_path(key).c_str(), 0, &size);
+  if (data == nullptr) {
+    return false;
+  }
+
+  GLint status = GL_FALSE;
+  ProgramCacheHeader header;
+  if (size > sizeof(header)) {
+    memcpy(&header, data, sizeof(header));
+    if (header.magic == program_cache_magic) {
+      glProgramBinary(shader_program_,
+                      header.binary_format,
+                      static_cast<const char *>(data) + sizeof(header),
+                      GLsizei(size - sizeof(header)));
+      glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    }
+  }
+  MEM_freeN(data);
+  return status == GL_TRUE;
+}
+
+void GLShader::program_cache_save(const std::string &key)
+{
+  GLint length = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  ProgramCacheHeader header;
+  header.magic = program_cache_magic;
+  Vector<char> data(sizeof(header) + size_t(length));
+  GLsizei written = 0;
+  glGetProgramBinary(
+      shader_program_, length, &written, &header.binary_format, data.data() + sizeof(header));
+  if (written <= 0) {
+    return;
+  }
+  memcpy(data.data(), &header, sizeof(header));
+
+  /* Write to a temporary file first, so that a partially written file is never loaded. */
+  const std::string filepath = program_cache_file_path(key);
+  const std::string filepath_tmp = filepath + "." + std::to_string(uintptr_t(this)) + ".tmp";
+  FILE *file = BLI_fopen(filepath_tmp.c_str(), "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const size_t data_size = sizeof(header) + size_t(written);
+  const bool success = fwrite(data.data(), 1, data_size, file) == data_size;
+  fclose(file);
+  if (!success || BLI_rename(filepath_tmp.c_str(), filepath.c_str()) != 0) {
+    BLI_delete(filepath_tmp.c_str(), false, false);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
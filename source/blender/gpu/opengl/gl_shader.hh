@@ -11,6 +11,10 @@
 
 #include <epoxy/gl.h>
 
+#include <string>
+
+#include "BLI_vector.hh"
+
 #include "gpu_shader_create_info.hh"
 #include "gpu_shader_private.hh"
 
@@ -34,6 +38,17 @@ class GLShader : public Shader {
   GLuint compute_shader_ = 0;
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
+  bool is_compute_ = false;
+
+  /**
+   * Sources of the shader stages. The stages are only compiled when linking, so that compiling
+   * can be skipped when the program binary is found in the cache.
+   */
+  struct StageSources {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<StageSources> stage_sources_;
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
@@ -72,14 +87,31 @@ class GLShader : public Shader {
 
   bool is_compute() const
   {
-    return compute_shader_ != 0;
+    return is_compute_;
   }
 
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
-  /** Create, compile and attach the shader stage to the shader program. */
+  /** Store the patched sources of the shader stage, to compile them when linking. */
+  void add_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  /** Create the shader stage and start compiling it. */
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  /**
+   * Wait for the compilation of the stage to finish and attach it to the shader program.
+   * Deletes the stage and returns false if it failed to compile.
+   */
+  bool check_shader_stage(GLuint shader, GLenum gl_stage, MutableSpan<const char *> sources);
+  /** Compile all stored shader stages. Returns false if any of them failed to compile. */
+  bool compile_shader_stages();
+
+  /**
+   * Program binary cache. The key is a hash of the driver identification and of the sources of
+   * all stages. An empty key means the program can't be cached.
+   */
+  std::string program_cache_key() const;
+  bool program_cache_load(const std::string &key);
+  void program_cache_save(const std::string &key);
 
   /**
    * \brief features available on newer implementation such as native barycentric coordinates
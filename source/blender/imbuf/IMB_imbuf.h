@@ -413,6 +413,18 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
                                 IMB_Timecode_Type tc /* = 1 = IMB_TC_RECORD_RUN */,
                                 IMB_Proxy_Size preview_size /* = 0 = IMB_PROXY_NONE */);
 
+/**
+ * Same as #IMB_anim_absolute, but decoded frames are shared between all users of the same movie
+ * file through a global cache. The returned buffer may be referenced by other users, so it must
+ * not be modified in place, use #IMB_makeSingleUser first.
+ *
+ * \attention Defined in anim_movie.c
+ */
+struct ImBuf *IMB_anim_absolute_shared(struct anim *anim,
+                                       int position,
+                                       IMB_Timecode_Type tc,
+                                       IMB_Proxy_Size preview_size);
+
 /**
  * \attention Defined in anim_movie.c
  * fetches a define preview-frame, usually half way into the movie.
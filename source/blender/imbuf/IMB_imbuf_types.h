@@ -156,6 +156,8 @@ typedef enum eImBufFlags {
   IB_thumbnail = 1 << 16,
   IB_multiview = 1 << 17,
   IB_halffloat = 1 << 18,
+  /** Together with #IB_multilayer, only read the combined pass of multilayer files. */
+  IB_multilayer_combined = 1 << 19,
 } eImBufFlags;
 
 /** \} */
@@ -119,6 +119,13 @@ struct anim {
   AVFrame *pFrame_backup;
   bool pFrame_backup_complete;
 
+  /* Pixel format of frames decoded by hardware, AV_PIX_FMT_NONE if decoding in software. */
+  enum AVPixelFormat hw_pix_fmt;
+  /* Hardware decoded frame transferred to system memory. */
+  AVFrame *pFrame_sw;
+  /* Pixel format that img_convert_ctx converts from. */
+  enum AVPixelFormat img_convert_pix_fmt;
+
   struct ImBuf *cur_frame_final;
   int64_t cur_pts;
   int64_t cur_key_frame_pts;
@@ -140,3 +147,9 @@ struct anim {
 
   struct IDProperty *metadata;
 };
+
+/**
+ * Free the frames shared between movies opened with the same settings,
+ * see #IMB_anim_absolute_shared.
+ */
+void imb_anim_shared_cache_exit(void);
@@ -125,6 +125,12 @@ struct ImBuf *imb_load_jp2(const unsigned char *mem,
 struct ImBuf *imb_load_jp2_filepath(const char *filepath,
                                     int flags,
                                     char colorspace[IM_MAX_SPACE]);
+struct ImBuf *imb_thumbnail_jp2(const char *filepath,
+                                int flags,
+                                size_t max_thumb_size,
+                                char colorspace[IM_MAX_SPACE],
+                                size_t *r_width,
+                                size_t *r_height);
 bool imb_save_jp2(struct ImBuf *ibuf, const char *filepath, int flags);
 
 /** \} */
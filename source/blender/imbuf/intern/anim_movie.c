@@ -37,12 +37,14 @@
 #  include <io.h>
 #endif
 
+#include "BLI_ghash.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -59,12 +61,14 @@
 #include "IMB_anim.h"
 #include "IMB_indexer.h"
 #include "IMB_metadata.h"
+#include "IMB_moviecache.h"
 
 #ifdef WITH_FFMPEG
 #  include "BKE_global.h" /* ENDIAN_ORDER */
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -487,6 +491,132 @@ static ImBuf *avi_fetchibuf(struct anim *anim, int position)
 
 #ifdef WITH_FFMPEG
 
+/* Create a context converting frames of the given pixel format to RGBA frames of the size of the
+ * movie, returns NULL on failure. */
+static struct SwsContext *ffmpeg_sws_context_create(struct anim *anim,
+                                                    enum AVPixelFormat src_pix_fmt)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  struct SwsContext *sws_ctx = sws_getContext(anim->x,
+                                              anim->y,
+                                              src_pix_fmt,
+                                              anim->x,
+                                              anim->y,
+                                              AV_PIX_FMT_RGBA,
+                                              SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
+                                              NULL,
+                                              NULL,
+                                              NULL);
+
+  if (!sws_ctx) {
+    return NULL;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(sws_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(sws_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return sws_ctx;
+}
+
+#  ifdef FFMPEG_HAVE_HW_DECODE
+static enum AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *pCodecCtx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  struct anim *anim = pCodecCtx->opaque;
+
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+
+  /* The device can't decode this stream, fall back to software decoding. */
+  av_log(anim->pFormatCtx, AV_LOG_INFO, "Hardware decoding not supported, using software.\n");
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  return avcodec_default_get_format(pCodecCtx, pix_fmts);
+}
+#  endif
+
+/* Set up the codec context to decode on the first hardware device supported by the codec if
+ * hardware decoding is enabled in the preferences. Decoded frames are transferred back to system
+ * memory in #ffmpeg_postprocess. */
+static void ffmpeg_hw_decode_init(struct anim *anim,
+                                  const AVCodec *pCodec,
+                                  AVCodecContext *pCodecCtx)
+{
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+
+#  ifdef FFMPEG_HAVE_HW_DECODE
+  if ((U.video_flag & USER_VIDEO_HW_DECODE) == 0) {
+    return;
+  }
+
+  /* The deinterlace buffer is allocated for the pixel format of the codec, which doesn't have to
+   * match the format of the transferred frames. */
+  if (anim->ib_flags & IB_animdeinterlace) {
+    return;
+  }
+
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(pCodec, i);
+    if (config == NULL) {
+      break;
+    }
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0) {
+      continue;
+    }
+
+    AVBufferRef *hw_device_ctx = NULL;
+    if (av_hwdevice_ctx_create(&hw_device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    /* The codec context takes ownership of the device context. */
+    pCodecCtx->hw_device_ctx = hw_device_ctx;
+    pCodecCtx->opaque = anim;
+    pCodecCtx->get_format = ffmpeg_hw_get_format;
+    anim->hw_pix_fmt = config->pix_fmt;
+
+    av_log(NULL,
+           AV_LOG_INFO,
+           "Using %s hardware decoding for %s\n",
+           av_hwdevice_get_type_name(config->device_type),
+           anim->name);
+    return;
+  }
+#  else
+  UNUSED_VARS(pCodec, pCodecCtx);
+#  endif
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -500,11 +630,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -568,6 +693,8 @@ static int startffmpeg(struct anim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  ffmpeg_hw_decode_init(anim, pCodec, pCodecCtx);
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
     avformat_close_input(&pFormatCtx);
     return -1;
@@ -685,6 +812,7 @@ static int startffmpeg(struct anim *anim)
   anim->pFrame_backup = av_frame_alloc();
   anim->pFrame_backup_complete = false;
   anim->pFrame_complete = false;
+  anim->pFrame_sw = av_frame_alloc();
   anim->pFrameDeinterlaced = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
   anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
@@ -700,6 +828,7 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_sw);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -713,6 +842,7 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_sw);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -731,16 +861,8 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
+  anim->img_convert_ctx = ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt);
+  anim->img_convert_pix_fmt = anim->pCodecCtx->pix_fmt;
 
   if (!anim->img_convert_ctx) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
@@ -751,37 +873,11 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_sw);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -867,6 +963,28 @@ static void ffmpeg_postprocess(struct anim *anim, AVFrame *input)
          input->data[2],
          input->data[3]);
 
+  if (anim->hw_pix_fmt != AV_PIX_FMT_NONE && input->format == anim->hw_pix_fmt) {
+    av_frame_unref(anim->pFrame_sw);
+    if (av_hwframe_transfer_data(anim->pFrame_sw, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg_fetchibuf: could not transfer hardware decoded frame\n");
+      return;
+    }
+    input = anim->pFrame_sw;
+  }
+
+  /* Frames transferred from the hardware device can have a different pixel format than the one
+   * reported by the codec. */
+  if (input->format != anim->img_convert_pix_fmt) {
+    struct SwsContext *img_convert_ctx = ffmpeg_sws_context_create(anim, input->format);
+    if (!img_convert_ctx) {
+      fprintf(stderr, "ffmpeg_fetchibuf: can't convert pixel format %d\n", input->format);
+      return;
+    }
+    sws_freeContext(anim->img_convert_ctx);
+    anim->img_convert_ctx = img_convert_ctx;
+    anim->img_convert_pix_fmt = input->format;
+  }
+
   if (anim->ib_flags & IB_animdeinterlace) {
     if (av_image_deinterlace(anim->pFrameDeinterlaced,
                              anim->pFrame,
@@ -1485,6 +1603,7 @@ static void free_anim_ffmpeg(struct anim *anim)
 
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
+    av_frame_free(&anim->pFrame_sw);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
 
@@ -1571,10 +1690,126 @@ struct ImBuf *IMB_anim_previewframe(struct anim *anim)
   return ibuf;
 }
 
-struct ImBuf *IMB_anim_absolute(struct anim *anim,
-                                int position,
-                                IMB_Timecode_Type tc,
-                                IMB_Proxy_Size preview_size)
+/* -------------------------------------------------------------------- */
+/** \name Shared Frame Cache
+ *
+ * Decoded movie frames shared by all #anim opened for the same file with the same settings, so
+ * that a movie used both as a clip and as a sequencer strip is decoded only once. Memory is
+ * managed by the global limiter of the movie caches.
+ * \{ */
+
+typedef struct AnimSharedCacheKey {
+  /* Interned description of the file and the settings it is decoded with. */
+  const char *source;
+  int position;
+  int tc;
+} AnimSharedCacheKey;
+
+static struct MovieCache *anim_shared_cache = NULL;
+/* Interned sources, the strings are both the keys and the values. */
+static GHash *anim_shared_cache_sources = NULL;
+static ThreadMutex anim_shared_cache_lock = BLI_MUTEX_INITIALIZER;
+
+static uint anim_shared_cache_hash(const void *key_v)
+{
+  const AnimSharedCacheKey *key = key_v;
+  uint hash = BLI_ghashutil_ptrhash(key->source);
+  hash = hash * 37 + BLI_ghashutil_inthash(key->position);
+  return hash * 37 + key->tc;
+}
+
+static bool anim_shared_cache_cmp(const void *a_v, const void *b_v)
+{
+  const AnimSharedCacheKey *a = a_v;
+  const AnimSharedCacheKey *b = b_v;
+  return (a->source != b->source) || (a->position != b->position) || (a->tc != b->tc);
+}
+
+/* Must be called with the cache locked. */
+static const char *anim_shared_cache_source(const struct anim *anim)
+{
+  char source[sizeof(anim->name) + sizeof(anim->index_dir) + sizeof(anim->colorspace) + 32];
+  BLI_snprintf(source,
+               sizeof(source),
+               "%s|%s|%s|%d|%d",
+               anim->name,
+               anim->index_dir,
+               anim->colorspace,
+               anim->streamindex,
+               anim->ib_flags);
+
+  char *source_interned = BLI_ghash_lookup(anim_shared_cache_sources, source);
+  if (source_interned == NULL) {
+    source_interned = BLI_strdup(source);
+    BLI_ghash_insert(anim_shared_cache_sources, source_interned, source_interned);
+  }
+  return source_interned;
+}
+
+static void anim_shared_cache_key_init(const struct anim *anim,
+                                       int position,
+                                       IMB_Timecode_Type tc,
+                                       AnimSharedCacheKey *r_key)
+{
+  if (anim_shared_cache == NULL) {
+    anim_shared_cache = IMB_moviecache_create("anim shared frames",
+                                              sizeof(AnimSharedCacheKey),
+                                              anim_shared_cache_hash,
+                                              anim_shared_cache_cmp);
+    anim_shared_cache_sources = BLI_ghash_str_new(__func__);
+  }
+
+  r_key->source = anim_shared_cache_source(anim);
+  r_key->position = position;
+  r_key->tc = tc;
+}
+
+static struct ImBuf *anim_shared_cache_get(const struct anim *anim,
+                                           int position,
+                                           IMB_Timecode_Type tc)
+{
+  AnimSharedCacheKey key;
+
+  BLI_mutex_lock(&anim_shared_cache_lock);
+  anim_shared_cache_key_init(anim, position, tc, &key);
+  struct ImBuf *ibuf = IMB_moviecache_get(anim_shared_cache, &key, NULL);
+  BLI_mutex_unlock(&anim_shared_cache_lock);
+
+  return ibuf;
+}
+
+static void anim_shared_cache_put(const struct anim *anim,
+                                  int position,
+                                  IMB_Timecode_Type tc,
+                                  struct ImBuf *ibuf)
+{
+  AnimSharedCacheKey key;
+
+  BLI_mutex_lock(&anim_shared_cache_lock);
+  anim_shared_cache_key_init(anim, position, tc, &key);
+  IMB_moviecache_put(anim_shared_cache, &key, ibuf);
+  BLI_mutex_unlock(&anim_shared_cache_lock);
+}
+
+void imb_anim_shared_cache_exit(void)
+{
+  if (anim_shared_cache) {
+    IMB_moviecache_free(anim_shared_cache);
+    anim_shared_cache = NULL;
+  }
+  if (anim_shared_cache_sources) {
+    BLI_ghash_free(anim_shared_cache_sources, MEM_freeN, NULL);
+    anim_shared_cache_sources = NULL;
+  }
+}
+
+/** \} */
+
+static struct ImBuf *anim_absolute(struct anim *anim,
+                                   int position,
+                                   IMB_Timecode_Type tc,
+                                   IMB_Proxy_Size preview_size,
+                                   const bool use_shared_cache)
 {
   struct ImBuf *ibuf = NULL;
   char head[256], tail[256];
@@ -1607,7 +1842,16 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
     if (proxy) {
       position = IMB_anim_index_get_frame_index(anim, tc, position);
 
-      return IMB_anim_absolute(proxy, position, IMB_TC_NONE, IMB_PROXY_NONE);
+      return anim_absolute(proxy, position, IMB_TC_NONE, IMB_PROXY_NONE, use_shared_cache);
+    }
+  }
+
+  /* Image sequences are not decoded, so there is little to gain from sharing their frames. */
+  const bool use_cache = use_shared_cache && anim->curtype != ANIM_SEQUENCE;
+  if (use_cache) {
+    ibuf = anim_shared_cache_get(anim, position, tc);
+    if (ibuf) {
+      return ibuf;
     }
   }
 
@@ -1652,10 +1896,30 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim,
       IMB_filtery(ibuf);
     }
     BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, anim->cur_position + 1);
+
+    if (use_cache) {
+      anim_shared_cache_put(anim, position, tc, ibuf);
+    }
   }
   return ibuf;
 }
 
+struct ImBuf *IMB_anim_absolute(struct anim *anim,
+                                int position,
+                                IMB_Timecode_Type tc,
+                                IMB_Proxy_Size preview_size)
+{
+  return anim_absolute(anim, position, tc, preview_size, false);
+}
+
+struct ImBuf *IMB_anim_absolute_shared(struct anim *anim,
+                                       int position,
+                                       IMB_Timecode_Type tc,
+                                       IMB_Proxy_Size preview_size)
+{
+  return anim_absolute(anim, position, tc, preview_size, true);
+}
+
 /***/
 
 int IMB_anim_get_duration(struct anim *anim, IMB_Timecode_Type tc)
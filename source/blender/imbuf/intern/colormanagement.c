@@ -88,10 +88,34 @@ float imbuf_aces_to_scene_linear[3][3] = {{0.0f}};
  */
 static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 
+/* Display processors of the most recently used view settings are cached, since creating one
+ * costs more than applying it to a preview sized image. */
+#define DISPLAY_PROCESSOR_CACHE_SIZE 8
+
+typedef struct DisplayProcessorCacheItem {
+  char look[MAX_COLORSPACE_NAME];
+  char view_transform[MAX_COLORSPACE_NAME];
+  char display[MAX_COLORSPACE_NAME];
+  float exposure;
+  float gamma;
+  OCIO_ConstCPUProcessorRcPtr *cpu_processor;
+  /* Number of color management processors using the item. Items in use are never replaced. */
+  int users;
+  /* Value of the cache clock when the item was last acquired. */
+  uint last_used;
+} DisplayProcessorCacheItem;
+
+static struct global_display_processor_cache {
+  DisplayProcessorCacheItem items[DISPLAY_PROCESSOR_CACHE_SIZE];
+  uint clock;
+} global_display_processor_cache = {{{{0}}}};
+
 typedef struct ColormanageProcessor {
   OCIO_ConstCPUProcessorRcPtr *cpu_processor;
   CurveMapping *curve_mapping;
   bool is_data_result;
+  /* Set when cpu_processor is owned by the display processor cache. */
+  DisplayProcessorCacheItem *cache_item;
 } ColormanageProcessor;
 
 static struct global_gpu_state {
@@ -587,6 +611,21 @@ static void colormanage_load_config(OCIO_ConstConfigRcPtr *config)
   invert_m3_m3(imbuf_scene_linear_to_aces, imbuf_aces_to_scene_linear);
 }
 
+static void display_processor_cache_free(void)
+{
+  struct global_display_processor_cache *cache = &global_display_processor_cache;
+
+  for (int i = 0; i < DISPLAY_PROCESSOR_CACHE_SIZE; i++) {
+    DisplayProcessorCacheItem *item = &cache->items[i];
+    BLI_assert(item->users == 0);
+    if (item->cpu_processor) {
+      OCIO_cpuProcessorRelease(item->cpu_processor);
+    }
+  }
+
+  memset(cache, 0, sizeof(*cache));
+}
+
 static void colormanage_free_config(void)
 {
   ColorSpace *colorspace;
@@ -644,6 +683,8 @@ static void colormanage_free_config(void)
   BLI_freelistN(&global_looks);
   global_tot_looks = 0;
 
+  display_processor_cache_free();
+
   OCIO_exit();
 }
 
@@ -974,6 +1015,104 @@ static OCIO_ConstCPUProcessorRcPtr *display_to_scene_linear_processor(ColorManag
   return (OCIO_ConstCPUProcessorRcPtr *)display->to_scene_linear;
 }
 
+/* Get a cached display processor for the given settings, creating it if needed. Returns NULL when
+ * the processor can't be created or all cache items are in use. */
+static DisplayProcessorCacheItem *display_processor_cache_acquire(
+    const ColorManagedViewSettings *view_settings,
+    const ColorManagedDisplaySettings *display_settings)
+{
+  struct global_display_processor_cache *cache = &global_display_processor_cache;
+  DisplayProcessorCacheItem *found = NULL;
+  DisplayProcessorCacheItem *unused = NULL;
+
+  BLI_mutex_lock(&processor_lock);
+
+  cache->clock++;
+
+  for (int i = 0; i < DISPLAY_PROCESSOR_CACHE_SIZE; i++) {
+    DisplayProcessorCacheItem *item = &cache->items[i];
+
+    if (item->cpu_processor && STREQ(item->look, view_settings->look) &&
+        STREQ(item->view_transform, view_settings->view_transform) &&
+        STREQ(item->display, display_settings->display_device) &&
+        item->exposure == view_settings->exposure && item->gamma == view_settings->gamma) {
+      found = item;
+      break;
+    }
+
+    if (item->users == 0 && (unused == NULL || item->last_used < unused->last_used)) {
+      unused = item;
+    }
+  }
+
+  if (found == NULL && unused != NULL) {
+    OCIO_ConstCPUProcessorRcPtr *cpu_processor = create_display_buffer_processor(
+        view_settings->look,
+        view_settings->view_transform,
+        display_settings->display_device,
+        view_settings->exposure,
+        view_settings->gamma,
+        global_role_scene_linear);
+
+    if (cpu_processor) {
+      if (unused->cpu_processor) {
+        OCIO_cpuProcessorRelease(unused->cpu_processor);
+      }
+
+      STRNCPY(unused->look, view_settings->look);
+      STRNCPY(unused->view_transform, view_settings->view_transform);
+      STRNCPY(unused->display, display_settings->display_device);
+      unused->exposure = view_settings->exposure;
+      unused->gamma = view_settings->gamma;
+      unused->cpu_processor = cpu_processor;
+      found = unused;
+    }
+  }
+
+  if (found) {
+    found->users++;
+    found->last_used = cache->clock;
+  }
+
+  BLI_mutex_unlock(&processor_lock);
+
+  return found;
+}
+
+static void display_processor_cache_release(DisplayProcessorCacheItem *item)
+{
+  BLI_mutex_lock(&processor_lock);
+  BLI_assert(item->users > 0);
+  item->users--;
+  BLI_mutex_unlock(&processor_lock);
+}
+
+static void cpu_processor_apply_buffer(OCIO_ConstCPUProcessorRcPtr *cpu_processor,
+                                       float *buffer,
+                                       int width,
+                                       int height,
+                                       int channels,
+                                       bool predivide)
+{
+  OCIO_PackedImageDesc *img = OCIO_createOCIO_PackedImageDesc(
+      buffer,
+      width,
+      height,
+      channels,
+      sizeof(float),
+      (size_t)channels * sizeof(float),
+      (size_t)channels * sizeof(float) * width);
+
+  if (predivide) {
+    OCIO_cpuProcessorApply_predivide(cpu_processor, img);
+  }
+  else {
+    OCIO_cpuProcessorApply(cpu_processor, img);
+  }
+
+  OCIO_PackedImageDescRelease(img);
+}
+
 void IMB_colormanagement_init_default_view_settings(
     ColorManagedViewSettings *view_settings, const ColorManagedDisplaySettings *display_settings)
 {
@@ -1429,6 +1568,8 @@ const float *IMB_colormanagement_get_xyz_to_scene_linear()
 
 typedef struct DisplayBufferThread {
   ColormanageProcessor *cm_processor;
+  /* Cached transform from the color space of the buffer to scene linear. */
+  OCIO_ConstCPUProcessorRcPtr *to_scene_linear;
 
   const float *buffer;
   uchar *byte_buffer;
@@ -1452,6 +1593,7 @@ typedef struct DisplayBufferThread {
 typedef struct DisplayBufferInitData {
   ImBuf *ibuf;
   ColormanageProcessor *cm_processor;
+  OCIO_ConstCPUProcessorRcPtr *to_scene_linear;
   const float *buffer;
   uchar *byte_buffer;
 
@@ -1483,6 +1625,7 @@ static void display_buffer_init_handle(void *handle_v,
   memset(handle, 0, sizeof(DisplayBufferThread));
 
   handle->cm_processor = init_data->cm_processor;
+  handle->to_scene_linear = init_data->to_scene_linear;
 
   if (init_data->buffer) {
     handle->buffer = init_data->buffer + offset;
@@ -1531,9 +1674,6 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
   if (!handle->buffer) {
     uchar *byte_buffer = handle->byte_buffer;
 
-    const char *from_colorspace = handle->byte_colorspace;
-    const char *to_colorspace = global_role_scene_linear;
-
     float *fp;
     uchar *cp;
     const size_t i_last = ((size_t)width) * height;
@@ -1553,10 +1693,10 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
       }
     }
 
-    if (!is_data && !is_data_display) {
+    if (!is_data && !is_data_display && handle->to_scene_linear) {
       /* convert float buffer to scene linear space */
-      IMB_colormanagement_transform(
-          linear_buffer, width, height, channels, from_colorspace, to_colorspace, false);
+      cpu_processor_apply_buffer(
+          handle->to_scene_linear, linear_buffer, width, height, channels, false);
     }
 
     *is_straight_alpha = true;
@@ -1568,14 +1708,11 @@ static void display_buffer_apply_get_linear_buffer(DisplayBufferThread *handle,
      * Need to convert float buffer to linear space before applying display transform
      */
 
-    const char *from_colorspace = handle->float_colorspace;
-    const char *to_colorspace = global_role_scene_linear;
-
     memcpy(linear_buffer, handle->buffer, buffer_size * sizeof(float));
 
-    if (!is_data && !is_data_display) {
-      IMB_colormanagement_transform(
-          linear_buffer, width, height, channels, from_colorspace, to_colorspace, predivide);
+    if (!is_data && !is_data_display && handle->to_scene_linear) {
+      cpu_processor_apply_buffer(
+          handle->to_scene_linear, linear_buffer, width, height, channels, predivide);
     }
 
     *is_straight_alpha = false;
@@ -1720,6 +1857,17 @@ static void display_buffer_apply_threaded(ImBuf *ibuf,
     init_data.float_colorspace = NULL;
   }
 
+  /* Look up the transform to scene linear once instead of creating it for every chunk. */
+  const char *from_colorspace = (buffer) ? init_data.float_colorspace : init_data.byte_colorspace;
+  init_data.to_scene_linear = NULL;
+  if (cm_processor && from_colorspace && from_colorspace[0] != '\0' &&
+      !STREQ(from_colorspace, global_role_scene_linear)) {
+    ColorSpace *colorspace = colormanage_colorspace_get_named(from_colorspace);
+    if (colorspace) {
+      init_data.to_scene_linear = colorspace_to_scene_linear_cpu_processor(colorspace);
+    }
+  }
+
   IMB_processor_apply_threaded(ibuf->y,
                                sizeof(DisplayBufferThread),
                                &init_data,
@@ -2195,6 +2343,40 @@ void IMB_colormanagement_colorspace_to_scene_linear(float *buffer,
   }
 }
 
+typedef struct ImbufByteToByteData {
+  int width;
+  int offset, stride;
+  const uchar *in_buffer;
+  uchar *out_buffer;
+  bool use_premultiply;
+} ImbufByteToByteData;
+
+static void imbuf_byte_to_byte_cb(void *__restrict userdata,
+                                  const int y,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ImbufByteToByteData *data = userdata;
+
+  const size_t in_offset = data->offset + y * data->stride;
+  const size_t out_offset = y * data->width;
+  const uchar *in = data->in_buffer + in_offset * 4;
+  uchar *out = data->out_buffer + out_offset * 4;
+
+  if (data->use_premultiply) {
+    /* Premultiply only. */
+    for (int x = 0; x < data->width; x++, in += 4, out += 4) {
+      out[0] = (in[0] * in[3]) >> 8;
+      out[1] = (in[1] * in[3]) >> 8;
+      out[2] = (in[2] * in[3]) >> 8;
+      out[3] = in[3];
+    }
+  }
+  else {
+    /* Copy only. */
+    memcpy(out, in, sizeof(uchar[4]) * data->width);
+  }
+}
+
 void IMB_colormanagement_imbuf_to_byte_texture(uchar *out_buffer,
                                                const int offset_x,
                                                const int offset_y,
@@ -2210,32 +2392,69 @@ void IMB_colormanagement_imbuf_to_byte_texture(uchar *out_buffer,
              IMB_colormanagement_space_is_scene_linear(ibuf->rect_colorspace) ||
              IMB_colormanagement_space_is_data(ibuf->rect_colorspace));
 
-  const uchar *in_buffer = (uchar *)ibuf->rect;
-  const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
+  ImbufByteToByteData data = {
+      .width = width,
+      .offset = offset_y * ibuf->x + offset_x,
+      .stride = ibuf->x,
+      .in_buffer = (uchar *)ibuf->rect,
+      .out_buffer = out_buffer,
+      .use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied,
+  };
 
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const uchar *in = in_buffer + in_offset * 4;
-    uchar *out = out_buffer + out_offset * 4;
-
-    if (use_premultiply) {
-      /* Premultiply only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = (in[0] * in[3]) >> 8;
-        out[1] = (in[1] * in[3]) >> 8;
-        out[2] = (in[2] * in[3]) >> 8;
-        out[3] = in[3];
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (height > 128);
+  BLI_task_parallel_range(0, height, &data, imbuf_byte_to_byte_cb, &settings);
+}
+
+typedef struct ImbufFloatToFloatData {
+  int width;
+  int offset, stride;
+  int in_channels;
+  const float *in_buffer;
+  float *out_buffer;
+  bool use_unpremultiply;
+} ImbufFloatToFloatData;
+
+static void imbuf_float_to_float_cb(void *__restrict userdata,
+                                    const int y,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ImbufFloatToFloatData *data = userdata;
+
+  const int in_channels = data->in_channels;
+  const size_t in_offset = data->offset + y * data->stride;
+  const size_t out_offset = y * data->width;
+  const float *in = data->in_buffer + in_offset * in_channels;
+  float *out = data->out_buffer + out_offset * 4;
+
+  if (in_channels == 1) {
+    /* Copy single channel. */
+    for (int x = 0; x < data->width; x++, in += 1, out += 4) {
+      out[0] = in[0];
+      out[1] = in[0];
+      out[2] = in[0];
+      out[3] = in[0];
+    }
+  }
+  else if (in_channels == 3) {
+    /* Copy RGB. */
+    for (int x = 0; x < data->width; x++, in += 3, out += 4) {
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+      out[3] = 1.0f;
+    }
+  }
+  else if (in_channels == 4) {
+    /* Copy or convert RGBA. */
+    if (data->use_unpremultiply) {
+      for (int x = 0; x < data->width; x++, in += 4, out += 4) {
+        premul_to_straight_v4_v4(out, in);
       }
     }
     else {
-      /* Copy only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = in[3];
-      }
+      memcpy(out, in, sizeof(float[4]) * data->width);
     }
   }
 }
@@ -2289,46 +2508,20 @@ void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
    * alpha depending on the image alpha mode. */
   if (ibuf->rect_float) {
     /* Float source buffer. */
-    const float *in_buffer = ibuf->rect_float;
-    const int in_channels = ibuf->channels;
-    const bool use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied;
-
-    for (int y = 0; y < height; y++) {
-      const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-      const size_t out_offset = y * width;
-      const float *in = in_buffer + in_offset * in_channels;
-      float *out = out_buffer + out_offset * 4;
-
-      if (in_channels == 1) {
-        /* Copy single channel. */
-        for (int x = 0; x < width; x++, in += 1, out += 4) {
-          out[0] = in[0];
-          out[1] = in[0];
-          out[2] = in[0];
-          out[3] = in[0];
-        }
-      }
-      else if (in_channels == 3) {
-        /* Copy RGB. */
-        for (int x = 0; x < width; x++, in += 3, out += 4) {
-          out[0] = in[0];
-          out[1] = in[1];
-          out[2] = in[2];
-          out[3] = 1.0f;
-        }
-      }
-      else if (in_channels == 4) {
-        /* Copy or convert RGBA. */
-        if (use_unpremultiply) {
-          for (int x = 0; x < width; x++, in += 4, out += 4) {
-            premul_to_straight_v4_v4(out, in);
-          }
-        }
-        else {
-          memcpy(out, in, sizeof(float[4]) * width);
-        }
-      }
-    }
+    ImbufFloatToFloatData data = {
+        .width = width,
+        .offset = offset_y * ibuf->x + offset_x,
+        .stride = ibuf->x,
+        .in_channels = ibuf->channels,
+        .in_buffer = ibuf->rect_float,
+        .out_buffer = out_buffer,
+        .use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (height > 128);
+    BLI_task_parallel_range(0, height, &data, imbuf_float_to_float_cb, &settings);
   }
   else {
     /* Byte source buffer. */
@@ -3805,13 +3998,20 @@ ColormanageProcessor *IMB_colormanagement_display_processor_new(
     cm_processor->is_data_result = display_space->is_data;
   }
 
-  cm_processor->cpu_processor = create_display_buffer_processor(
-      applied_view_settings->look,
-      applied_view_settings->view_transform,
-      display_settings->display_device,
-      applied_view_settings->exposure,
-      applied_view_settings->gamma,
-      global_role_scene_linear);
+  cm_processor->cache_item = display_processor_cache_acquire(applied_view_settings,
+                                                             display_settings);
+  if (cm_processor->cache_item) {
+    cm_processor->cpu_processor = cm_processor->cache_item->cpu_processor;
+  }
+  else {
+    cm_processor->cpu_processor = create_display_buffer_processor(
+        applied_view_settings->look,
+        applied_view_settings->view_transform,
+        display_settings->display_device,
+        applied_view_settings->exposure,
+        applied_view_settings->gamma,
+        global_role_scene_linear);
+  }
 
   if (applied_view_settings->flag & COLORMANAGE_VIEW_USE_CURVES) {
     cm_processor->curve_mapping = BKE_curvemapping_copy(applied_view_settings->curve_mapping);
@@ -3918,25 +4118,9 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor,
   }
 
   if (cm_processor->cpu_processor && channels >= 3) {
-    OCIO_PackedImageDesc *img;
-
     /* apply OCIO processor */
-    img = OCIO_createOCIO_PackedImageDesc(buffer,
-                                          width,
-                                          height,
-                                          channels,
-                                          sizeof(float),
-                                          (size_t)channels * sizeof(float),
-                                          (size_t)channels * sizeof(float) * width);
-
-    if (predivide) {
-      OCIO_cpuProcessorApply_predivide(cm_processor->cpu_processor, img);
-    }
-    else {
-      OCIO_cpuProcessorApply(cm_processor->cpu_processor, img);
-    }
-
-    OCIO_PackedImageDescRelease(img);
+    cpu_processor_apply_buffer(
+        cm_processor->cpu_processor, buffer, width, height, channels, predivide);
   }
 }
 
@@ -3963,7 +4147,10 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
   if (cm_processor->curve_mapping) {
     BKE_curvemapping_free(cm_processor->curve_mapping);
   }
-  if (cm_processor->cpu_processor) {
+  if (cm_processor->cache_item) {
+    display_processor_cache_release(cm_processor->cache_item);
+  }
+  else if (cm_processor->cpu_processor) {
     OCIO_cpuProcessorRelease(cm_processor->cpu_processor);
   }
 
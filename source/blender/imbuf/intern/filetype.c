@@ -162,7 +162,7 @@ const ImFileType IMB_FILE_TYPES[] = {
         .is_a = imb_is_a_jp2,
         .load = imb_load_jp2,
         .load_filepath = NULL,
-        .load_filepath_thumbnail = NULL,
+        .load_filepath_thumbnail = imb_thumbnail_jp2,
         .save = imb_save_jp2,
         .flag = IM_FTYPE_FLOAT,
         .filetype = IMB_FTYPE_JP2,
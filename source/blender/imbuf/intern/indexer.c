@@ -16,6 +16,7 @@
 #include "BLI_math.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #ifdef _WIN32
@@ -955,6 +956,38 @@ static void index_rebuild_ffmpeg_finish(FFmpegIndexBuilderContext *context, cons
   MEM_freeN(context);
 }
 
+typedef struct ProxyOutputParallelData {
+  FFmpegIndexBuilderContext *context;
+  AVFrame *in_frame;
+} ProxyOutputParallelData;
+
+static void add_to_proxy_outputs_fn(void *__restrict userdata,
+                                    const int i,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ProxyOutputParallelData *data = userdata;
+  add_to_proxy_output_ffmpeg(data->context->proxy_ctx[i], data->in_frame);
+}
+
+/* Scale and encode the decoded frame into every proxy size. Each size has its own scaler, encoder
+ * and output file, so they are fed in parallel and the source is only decoded once. */
+static void add_to_proxy_outputs_ffmpeg(FFmpegIndexBuilderContext *context, AVFrame *in_frame)
+{
+  int num_outputs = 0;
+  for (int i = 0; i < context->num_proxy_sizes; i++) {
+    if (context->proxy_ctx[i]) {
+      num_outputs++;
+    }
+  }
+
+  ProxyOutputParallelData data = {context, in_frame};
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = num_outputs > 1;
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, context->num_proxy_sizes, &data, add_to_proxy_outputs_fn, &settings);
+}
+
 static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *context,
                                                     AVPacket *curr_packet,
                                                     AVFrame *in_frame)
@@ -965,9 +998,7 @@ static void index_rebuild_ffmpeg_proc_decoded_frame(FFmpegIndexBuilderContext *c
   uint64_t s_dts = context->seek_pos_dts;
   uint64_t pts = av_get_pts_from_frame(in_frame);
 
-  for (i = 0; i < context->num_proxy_sizes; i++) {
-    add_to_proxy_output_ffmpeg(context->proxy_ctx[i], in_frame);
-  }
+  add_to_proxy_outputs_ffmpeg(context, in_frame);
 
   if (!context->start_pts_set) {
     context->start_pts = pts;
@@ -297,7 +297,10 @@ static opj_stream_t *opj_stream_create_from_file(const char *filepath,
 static ImBuf *imb_load_jp2_stream(opj_stream_t *stream,
                                   OPJ_CODEC_FORMAT p_format,
                                   int flags,
-                                  char colorspace[IM_MAX_SPACE]);
+                                  size_t max_size,
+                                  char colorspace[IM_MAX_SPACE],
+                                  size_t *r_width,
+                                  size_t *r_height);
 
 ImBuf *imb_load_jp2(const uchar *mem, size_t size, int flags, char colorspace[IM_MAX_SPACE])
 {
@@ -310,22 +313,27 @@ ImBuf *imb_load_jp2(const uchar *mem, size_t size, int flags, char colorspace[IM
   };
   opj_stream_t *stream = opj_stream_create_from_buffer(
       &buf_wrapper, OPJ_J2K_STREAM_CHUNK_SIZE, true);
-  ImBuf *ibuf = imb_load_jp2_stream(stream, format, flags, colorspace);
+  ImBuf *ibuf = imb_load_jp2_stream(stream, format, flags, 0, colorspace, NULL, NULL);
   opj_stream_destroy(stream);
   return ibuf;
 }
 
-ImBuf *imb_load_jp2_filepath(const char *filepath, int flags, char colorspace[IM_MAX_SPACE])
+static ImBuf *imb_load_jp2_file(const char *filepath,
+                                int flags,
+                                size_t max_size,
+                                char colorspace[IM_MAX_SPACE],
+                                size_t *r_width,
+                                size_t *r_height)
 {
   FILE *p_file = NULL;
   uchar mem[JP2_FILEHEADER_SIZE];
   opj_stream_t *stream = opj_stream_create_from_file(
       filepath, OPJ_J2K_STREAM_CHUNK_SIZE, true, &p_file);
-  if (stream) {
+  if (stream == NULL) {
     return NULL;
   }
 
-  if (fread(mem, sizeof(mem), 1, p_file) != sizeof(mem)) {
+  if (fread(mem, sizeof(mem), 1, p_file) != 1) {
     opj_stream_destroy(stream);
     return NULL;
   }
@@ -333,15 +341,61 @@ ImBuf *imb_load_jp2_filepath(const char *filepath, int flags, char colorspace[IM
   fseek(p_file, 0, SEEK_SET);
 
   const OPJ_CODEC_FORMAT format = format_from_header(mem, sizeof(mem));
-  ImBuf *ibuf = imb_load_jp2_stream(stream, format, flags, colorspace);
+  ImBuf *ibuf = imb_load_jp2_stream(
+      stream, format, flags, max_size, colorspace, r_width, r_height);
   opj_stream_destroy(stream);
   return ibuf;
 }
 
+ImBuf *imb_load_jp2_filepath(const char *filepath, int flags, char colorspace[IM_MAX_SPACE])
+{
+  return imb_load_jp2_file(filepath, flags, 0, colorspace, NULL, NULL);
+}
+
+ImBuf *imb_thumbnail_jp2(const char *filepath,
+                         const int flags,
+                         const size_t max_thumb_size,
+                         char colorspace[IM_MAX_SPACE],
+                         size_t *r_width,
+                         size_t *r_height)
+{
+  return imb_load_jp2_file(filepath, flags, max_thumb_size, colorspace, r_width, r_height);
+}
+
+/**
+ * Number of resolution levels that can be discarded while decoding,
+ * keeping the image at least `max_size` pixels in its largest dimension.
+ */
+static OPJ_UINT32 imb_jp2_reduce_factor(opj_codec_t *codec,
+                                        const opj_image_t *image,
+                                        const size_t max_size)
+{
+  opj_codestream_info_v2_t *info = opj_get_cstr_info(codec);
+  if (info == NULL) {
+    return 0;
+  }
+
+  OPJ_UINT32 reduce_max = 0;
+  if (info->m_default_tile_info.tccp_info) {
+    reduce_max = info->m_default_tile_info.tccp_info[0].numresolutions - 1;
+  }
+  opj_destroy_cstr_info(&info);
+
+  const size_t size = max_ii(image->x1 - image->x0, image->y1 - image->y0);
+  OPJ_UINT32 reduce = 0;
+  while (reduce < reduce_max && (size >> (reduce + 1)) >= max_size) {
+    reduce++;
+  }
+  return reduce;
+}
+
 static ImBuf *imb_load_jp2_stream(opj_stream_t *stream,
                                   const OPJ_CODEC_FORMAT format,
                                   int flags,
-                                  char colorspace[IM_MAX_SPACE])
+                                  const size_t max_size,
+                                  char colorspace[IM_MAX_SPACE],
+                                  size_t *r_width,
+                                  size_t *r_height)
 {
   if (format == OPJ_CODEC_UNKNOWN) {
     return NULL;
@@ -391,6 +445,19 @@ static ImBuf *imb_load_jp2_stream(opj_stream_t *stream,
     goto finally;
   }
 
+  if (r_width) {
+    *r_width = image->x1 - image->x0;
+    *r_height = image->y1 - image->y0;
+  }
+
+  /* Skip the wavelet levels of the code-stream that would be lost when scaling down anyway. */
+  if (max_size > 0) {
+    const OPJ_UINT32 reduce = imb_jp2_reduce_factor(codec, image, max_size);
+    if (reduce > 0 && !opj_set_decoded_resolution_factor(codec, reduce)) {
+      goto finally;
+    }
+  }
+
   /* decode the stream and fill the image structure */
   if (opj_decode(codec, stream, image) == false) {
     fprintf(stderr, "ERROR -> j2k_to_image: failed to decode image!\n");
@@ -9,6 +9,7 @@
 #include "BLI_utildefines.h"
 
 #include "IMB_allocimbuf.h"
+#include "IMB_anim.h"
 #include "IMB_colormanagement_intern.h"
 #include "IMB_filetype.h"
 #include "IMB_imbuf.h"
@@ -23,6 +24,7 @@ void IMB_init(void)
 
 void IMB_exit(void)
 {
+  imb_anim_shared_cache_exit();
   imb_filetypes_exit();
   colormanagement_exit();
   imb_mmap_lock_exit();
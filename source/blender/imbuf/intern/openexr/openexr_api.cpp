@@ -1293,6 +1293,7 @@ void IMB_exr_read_channels(void *handle)
     /* Insert all matching channel into frame-buffer. */
     FrameBuffer frameBuffer;
     ExrChannel *echan;
+    int num_read_channels = 0;
 
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       if (echan->m->part_number != i) {
@@ -1324,12 +1325,18 @@ void IMB_exr_read_channels(void *handle)
 
         frameBuffer.insert(echan->m->internal_name,
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
+        num_read_channels++;
       }
       else {
-        printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
+        exr_printf("channel with no rect set %s, skipping\n", echan->m->internal_name.c_str());
       }
     }
 
+    /* Don't decode parts of which no channel is needed. */
+    if (num_read_channels == 0) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -1379,6 +1386,10 @@ void IMB_exr_multilayer_convert(void *handle,
     void *laybase = addlayer(base, lay->name);
     if (laybase) {
       for (pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+        if (pass->rect == nullptr) {
+          /* Pass was skipped when reading. */
+          continue;
+        }
         addpass(base,
                 laybase,
                 pass->internal_name,
@@ -1703,6 +1714,46 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
   return true;
 }
 
+static bool imb_exr_is_combined_pass(const ExrPass *pass)
+{
+  return STREQ(pass->internal_name, "Combined") || STR_ELEM(pass->chan_id, "RGBA", "RGB");
+}
+
+/* Free the memory of all passes but the first combined one, so that reading the channels only
+ * decodes that pass. Nothing is skipped when there is no combined pass. */
+static void imb_exr_multilayer_skip_non_combined_passes(ExrHandle *data)
+{
+  ExrPass *combined_pass = nullptr;
+
+  for (ExrLayer *lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
+    for (ExrPass *pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+      if (pass->rect && imb_exr_is_combined_pass(pass)) {
+        combined_pass = pass;
+        break;
+      }
+    }
+    if (combined_pass) {
+      break;
+    }
+  }
+
+  if (combined_pass == nullptr) {
+    return;
+  }
+
+  for (ExrLayer *lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
+    for (ExrPass *pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+      if (pass == combined_pass) {
+        continue;
+      }
+      MEM_SAFE_FREE(pass->rect);
+      for (int a = 0; a < pass->totchan; a++) {
+        pass->chan[a]->rect = nullptr;
+      }
+    }
+  }
+}
+
 /* creates channels, makes a hierarchy and assigns memory to channels */
 static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
                                          MultiPartInputFile &file,
@@ -2036,6 +2087,9 @@ struct ImBuf *imb_load_openexr(const uchar *mem,
           /* constructs channels for reading, allocates memory in channels */
           ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height);
           if (handle) {
+            if (flags & IB_multilayer_combined) {
+              imb_exr_multilayer_skip_non_combined_passes(handle);
+            }
             IMB_exr_read_channels(handle);
             ibuf->userdata = handle; /* potential danger, the caller has to check for this! */
           }
@@ -9,6 +9,7 @@
 
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -875,284 +876,328 @@ static bool q_scale_linear_interpolation(struct ImBuf *ibuf, int newx, int newy)
   return true;
 }
 
-static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+/* -------------------------------------------------------------------- */
+/** \name Line Based Scaling
+ *
+ * Scaling along one axis is done line by line, where a line is a row when scaling along X and a
+ * column when scaling along Y. Lines don't depend on each other, so they are scaled in parallel.
+ * \{ */
+
+typedef struct ScaleLinesData {
+  const uchar *rect;
+  const float *rectf;
+  uchar *newrect;
+  float *newrectf;
+  /* Offset between the first pixels of two neighboring lines in the source and the result. */
+  size_t src_line_offset, dst_line_offset;
+  /* Offset between two neighboring pixels of a line, the same in the source and the result. */
+  size_t step;
+  /* Number of pixels of a line in the source and the result. */
+  int len, newlen;
+  float add;
+} ScaleLinesData;
+
+static void scaledown_line_byte(const uchar *rect, uchar *newrect, const ScaleLinesData *data)
 {
-  const bool do_rect = (ibuf->rect != NULL);
-  const bool do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
+  const uchar *rect_start = rect;
+  const size_t step = data->step;
+  const float add = data->add;
+  float sample = 0.0f;
+  float val[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  float nval[4];
+
+  for (int x = data->newlen; x > 0; x--) {
+    nval[0] = -val[0] * sample;
+    nval[1] = -val[1] * sample;
+    nval[2] = -val[2] * sample;
+    nval[3] = -val[3] * sample;
+
+    sample += add;
+
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y;
+      nval[0] += rect[0];
+      nval[1] += rect[1];
+      nval[2] += rect[2];
+      nval[3] += rect[3];
+      rect += step;
+    }
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+    val[0] = rect[0];
+    val[1] = rect[1];
+    val[2] = rect[2];
+    val[3] = rect[3];
+    rect += step;
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
+    newrect[0] = roundf((nval[0] + sample * val[0]) / add);
+    newrect[1] = roundf((nval[1] + sample * val[1]) / add);
+    newrect[2] = roundf((nval[2] + sample * val[2]) / add);
+    newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+    newrect += step;
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newx * ibuf->y, "scaledownx");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
+    sample -= 1.0f;
   }
-  if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaledownxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
+
+  BLI_assert(rect - rect_start == data->len * step); /* see bug T26502. */
+  UNUSED_VARS_NDEBUG(rect_start);
+}
+
+static void scaledown_line_float(const float *rectf, float *newrectf, const ScaleLinesData *data)
+{
+  const float *rectf_start = rectf;
+  const size_t step = data->step;
+  const float add = data->add;
+  float sample = 0.0f;
+  float valf[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  float nvalf[4];
+
+  for (int x = data->newlen; x > 0; x--) {
+    nvalf[0] = -valf[0] * sample;
+    nvalf[1] = -valf[1] * sample;
+    nvalf[2] = -valf[2] * sample;
+    nvalf[3] = -valf[3] * sample;
+
+    sample += add;
+
+    while (sample >= 1.0f) {
+      sample -= 1.0f;
+
+      nvalf[0] += rectf[0];
+      nvalf[1] += rectf[1];
+      nvalf[2] += rectf[2];
+      nvalf[3] += rectf[3];
+      rectf += step;
     }
+
+    valf[0] = rectf[0];
+    valf[1] = rectf[1];
+    valf[2] = rectf[2];
+    valf[3] = rectf[3];
+    rectf += step;
+
+    newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
+    newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
+    newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
+    newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+    newrectf += step;
+
+    sample -= 1.0f;
   }
 
-  add = (ibuf->x - 0.01) / newx;
+  BLI_assert(rectf - rectf_start == data->len * step); /* see bug T26502. */
+  UNUSED_VARS_NDEBUG(rectf_start);
+}
 
-  if (do_rect) {
-    rect = (uchar *)ibuf->rect;
-    newrect = _newrect;
+static void scaledown_lines_fn(void *__restrict userdata,
+                               const int line,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleLinesData *data = userdata;
+
+  if (data->rect) {
+    scaledown_line_byte(data->rect + line * data->src_line_offset,
+                        data->newrect + line * data->dst_line_offset,
+                        data);
   }
-  if (do_float) {
-    rectf = ibuf->rect_float;
-    newrectf = _newrectf;
+  if (data->rectf) {
+    scaledown_line_float(data->rectf + line * data->src_line_offset,
+                         data->newrectf + line * data->dst_line_offset,
+                         data);
   }
+}
 
-  for (y = ibuf->y; y > 0; y--) {
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (x = newx; x > 0; x--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+static void scaleup_line_byte(const uchar *rect, uchar *newrect, const ScaleLinesData *data)
+{
+  const size_t step = data->step;
+  const float add = data->add;
+  float sample = 0;
+  float val[4], nval[4], diff[4];
 
-      sample += add;
+  for (int c = 0; c < 4; c++) {
+    val[c] = rect[c];
+    nval[c] = rect[step + c];
+    diff[c] = nval[c] - val[c];
+    val[c] += 0.5f;
+  }
+  rect += 2 * step;
 
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+  for (int x = data->newlen; x > 0; x--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
 
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += 4;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += 4;
-        }
+      for (int c = 0; c < 4; c++) {
+        val[c] = nval[c];
+        nval[c] = rect[c];
+        diff[c] = nval[c] - val[c];
+        val[c] += 0.5f;
       }
+      rect += step;
+    }
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += 4;
+    newrect[0] = val[0] + sample * diff[0];
+    newrect[1] = val[1] + sample * diff[1];
+    newrect[2] = val[2] + sample * diff[2];
+    newrect[3] = val[3] + sample * diff[3];
+    newrect += step;
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+    sample += add;
+  }
+}
 
-        newrect += 4;
-      }
-      if (do_float) {
+static void scaleup_line_float(const float *rectf, float *newrectf, const ScaleLinesData *data)
+{
+  const size_t step = data->step;
+  const float add = data->add;
+  float sample = 0;
+  float valf[4], nvalf[4], difff[4];
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += 4;
+  for (int c = 0; c < 4; c++) {
+    valf[c] = rectf[c];
+    nvalf[c] = rectf[step + c];
+    difff[c] = nvalf[c] - valf[c];
+  }
+  rectf += 2 * step;
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+  for (int x = data->newlen; x > 0; x--) {
+    if (sample >= 1.0f) {
+      sample -= 1.0f;
 
-        newrectf += 4;
+      for (int c = 0; c < 4; c++) {
+        valf[c] = nvalf[c];
+        nvalf[c] = rectf[c];
+        difff[c] = nvalf[c] - valf[c];
       }
-
-      sample -= 1.0f;
+      rectf += step;
     }
-  }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = _newrectf;
-  }
-  (void)rect_size; /* UNUSED in release builds */
+    newrectf[0] = valf[0] + sample * difff[0];
+    newrectf[1] = valf[1] + sample * difff[1];
+    newrectf[2] = valf[2] + sample * difff[2];
+    newrectf[3] = valf[3] + sample * difff[3];
+    newrectf += step;
 
-  ibuf->x = newx;
-  return ibuf;
+    sample += add;
+  }
 }
 
-static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+static void scaleup_lines_fn(void *__restrict userdata,
+                             const int line,
+                             const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  const bool do_rect = (ibuf->rect != NULL);
-  const bool do_float = (ibuf->rect_float != NULL);
-  const size_t rect_size = IMB_get_rect_len(ibuf) * 4;
+  const ScaleLinesData *data = userdata;
 
-  uchar *rect, *_newrect, *newrect;
-  float *rectf, *_newrectf, *newrectf;
-  float sample, add, val[4], nval[4], valf[4], nvalf[4];
-  int x, y, skipx;
+  if (data->rect) {
+    scaleup_line_byte(data->rect + line * data->src_line_offset,
+                      data->newrect + line * data->dst_line_offset,
+                      data);
+  }
+  if (data->rectf) {
+    scaleup_line_float(data->rectf + line * data->src_line_offset,
+                       data->newrectf + line * data->dst_line_offset,
+                       data);
+  }
+}
 
-  rectf = _newrectf = newrectf = NULL;
-  rect = _newrect = newrect = NULL;
-  nval[0] = nval[1] = nval[2] = nval[3] = 0.0f;
-  nvalf[0] = nvalf[1] = nvalf[2] = nvalf[3] = 0.0f;
+static void scale_lines(ScaleLinesData *data, const int lines_num, TaskParallelRangeFunc func)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  /* Small images, like most thumbnails, are not worth the threading overhead. */
+  settings.use_threading = ((size_t)lines_num * data->newlen) > 256 * 256;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, lines_num, data, func, &settings);
+}
 
-  if (!do_rect && !do_float) {
-    return ibuf;
-  }
+/* Allocate the buffers of the scaled image, returns false when out of memory. */
+static bool scale_lines_alloc(ImBuf *ibuf, ScaleLinesData *data, int newx, int newy)
+{
+  data->rect = (const uchar *)ibuf->rect;
+  data->rectf = ibuf->rect_float;
+  data->newrect = NULL;
+  data->newrectf = NULL;
 
-  if (do_rect) {
-    _newrect = MEM_mallocN(sizeof(uchar[4]) * newy * ibuf->x, "scaledowny");
-    if (_newrect == NULL) {
-      return ibuf;
+  if (ibuf->rect) {
+    data->newrect = MEM_mallocN(sizeof(uchar[4]) * newx * newy, "scale lines");
+    if (data->newrect == NULL) {
+      return false;
     }
   }
-  if (do_float) {
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newy * ibuf->x, "scaledownyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
+  if (ibuf->rect_float) {
+    data->newrectf = MEM_mallocN(sizeof(float[4]) * newx * newy, "scale lines float");
+    if (data->newrectf == NULL) {
+      MEM_SAFE_FREE(data->newrect);
+      return false;
     }
   }
 
-  add = (ibuf->y - 0.01) / newy;
-  skipx = 4 * ibuf->x;
-
-  for (x = skipx - 4; x >= 0; x -= 4) {
-    if (do_rect) {
-      rect = ((uchar *)ibuf->rect) + x;
-      newrect = _newrect + x;
-    }
-    if (do_float) {
-      rectf = ibuf->rect_float + x;
-      newrectf = _newrectf + x;
-    }
-
-    sample = 0.0f;
-    val[0] = val[1] = val[2] = val[3] = 0.0f;
-    valf[0] = valf[1] = valf[2] = valf[3] = 0.0f;
-
-    for (y = newy; y > 0; y--) {
-      if (do_rect) {
-        nval[0] = -val[0] * sample;
-        nval[1] = -val[1] * sample;
-        nval[2] = -val[2] * sample;
-        nval[3] = -val[3] * sample;
-      }
-      if (do_float) {
-        nvalf[0] = -valf[0] * sample;
-        nvalf[1] = -valf[1] * sample;
-        nvalf[2] = -valf[2] * sample;
-        nvalf[3] = -valf[3] * sample;
-      }
+  return true;
+}
 
-      sample += add;
+/* Replace the buffers of the image by the scaled ones. */
+static void scale_lines_assign(ImBuf *ibuf, ScaleLinesData *data)
+{
+  if (data->newrect) {
+    imb_freerectImBuf(ibuf);
+    ibuf->mall |= IB_rect;
+    ibuf->rect = (uint *)data->newrect;
+  }
+  if (data->newrectf) {
+    imb_freerectfloatImBuf(ibuf);
+    ibuf->mall |= IB_rectfloat;
+    ibuf->rect_float = data->newrectf;
+  }
+}
 
-      while (sample >= 1.0f) {
-        sample -= 1.0f;
+/** \} */
 
-        if (do_rect) {
-          nval[0] += rect[0];
-          nval[1] += rect[1];
-          nval[2] += rect[2];
-          nval[3] += rect[3];
-          rect += skipx;
-        }
-        if (do_float) {
-          nvalf[0] += rectf[0];
-          nvalf[1] += rectf[1];
-          nvalf[2] += rectf[2];
-          nvalf[3] += rectf[3];
-          rectf += skipx;
-        }
-      }
+static ImBuf *scaledownx(struct ImBuf *ibuf, int newx)
+{
+  ScaleLinesData data;
 
-      if (do_rect) {
-        val[0] = rect[0];
-        val[1] = rect[1];
-        val[2] = rect[2];
-        val[3] = rect[3];
-        rect += skipx;
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+    return ibuf;
+  }
 
-        newrect[0] = roundf((nval[0] + sample * val[0]) / add);
-        newrect[1] = roundf((nval[1] + sample * val[1]) / add);
-        newrect[2] = roundf((nval[2] + sample * val[2]) / add);
-        newrect[3] = roundf((nval[3] + sample * val[3]) / add);
+  if (!scale_lines_alloc(ibuf, &data, newx, ibuf->y)) {
+    return ibuf;
+  }
 
-        newrect += skipx;
-      }
-      if (do_float) {
+  data.src_line_offset = 4 * (size_t)ibuf->x;
+  data.dst_line_offset = 4 * (size_t)newx;
+  data.step = 4;
+  data.len = ibuf->x;
+  data.newlen = newx;
+  data.add = (ibuf->x - 0.01) / newx;
 
-        valf[0] = rectf[0];
-        valf[1] = rectf[1];
-        valf[2] = rectf[2];
-        valf[3] = rectf[3];
-        rectf += skipx;
+  scale_lines(&data, ibuf->y, scaledown_lines_fn);
+  scale_lines_assign(ibuf, &data);
 
-        newrectf[0] = ((nvalf[0] + sample * valf[0]) / add);
-        newrectf[1] = ((nvalf[1] + sample * valf[1]) / add);
-        newrectf[2] = ((nvalf[2] + sample * valf[2]) / add);
-        newrectf[3] = ((nvalf[3] + sample * valf[3]) / add);
+  ibuf->x = newx;
+  return ibuf;
+}
 
-        newrectf += skipx;
-      }
+static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
+{
+  ScaleLinesData data;
 
-      sample -= 1.0f;
-    }
+  if (ibuf->rect == NULL && ibuf->rect_float == NULL) {
+    return ibuf;
   }
 
-  if (do_rect) {
-    // printf("%ld %ld\n", (uchar *)rect - ((uchar *)ibuf->rect), rect_size);
-    BLI_assert((uchar *)rect - ((uchar *)ibuf->rect) == rect_size); /* see bug T26502. */
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
-  }
-  if (do_float) {
-    // printf("%ld %ld\n", rectf - ibuf->rect_float, rect_size);
-    BLI_assert((rectf - ibuf->rect_float) == rect_size); /* see bug T26502. */
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
+  if (!scale_lines_alloc(ibuf, &data, ibuf->x, newy)) {
+    return ibuf;
   }
-  (void)rect_size; /* UNUSED in release builds */
+
+  data.src_line_offset = 4;
+  data.dst_line_offset = 4;
+  data.step = 4 * (size_t)ibuf->x;
+  data.len = ibuf->y;
+  data.newlen = newy;
+  data.add = (ibuf->y - 0.01) / newy;
+
+  scale_lines(&data, ibuf->x, scaledown_lines_fn);
+  scale_lines_assign(ibuf, &data);
 
   ibuf->y = newy;
   return ibuf;
@@ -1160,10 +1205,8 @@ static ImBuf *scaledowny(struct ImBuf *ibuf, int newy)
 
 static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
+  ScaleLinesData data;
   int x, y;
-  bool do_rect = false, do_float = false;
 
   if (ibuf == NULL) {
     return NULL;
@@ -1172,33 +1215,16 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
     return ibuf;
   }
 
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(newx * ibuf->y * sizeof(int), "scaleupx");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(sizeof(float[4]) * newx * ibuf->y, "scaleupxf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
+  if (!scale_lines_alloc(ibuf, &data, newx, ibuf->y)) {
+    return ibuf;
   }
 
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
   /* Special case, copy all columns, needed since the scaling logic assumes there is at least
    * two rows to interpolate between causing out of bounds read for 1px images, see T70356. */
   if (UNLIKELY(ibuf->x == 1)) {
-    if (do_rect) {
+    if (data.newrect) {
+      const uchar *rect = data.rect;
+      uchar *newrect = data.newrect;
       for (y = ibuf->y; y > 0; y--) {
         for (x = newx; x > 0; x--) {
           memcpy(newrect, rect, sizeof(char[4]));
@@ -1207,7 +1233,9 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
         rect += 4;
       }
     }
-    if (do_float) {
+    if (data.newrectf) {
+      const float *rectf = data.rectf;
+      float *newrectf = data.newrectf;
       for (y = ibuf->y; y > 0; y--) {
         for (x = newx; x > 0; x--) {
           memcpy(newrectf, rectf, sizeof(float[4]));
@@ -1218,143 +1246,17 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
     }
   }
   else {
-    const float add = (ibuf->x - 1.001) / (newx - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (y = ibuf->y; y > 0; y--) {
-
-      sample = 0;
-
-      if (do_rect) {
-        val_a = rect[0];
-        nval_a = rect[4];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[5];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[6];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[7];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 8;
-      }
-      if (do_float) {
-        val_af = rectf[0];
-        nval_af = rectf[4];
-        diff_af = nval_af - val_af;
-
-        val_bf = rectf[1];
-        nval_bf = rectf[5];
-        diff_bf = nval_bf - val_bf;
-
-        val_gf = rectf[2];
-        nval_gf = rectf[6];
-        diff_gf = nval_gf - val_gf;
-
-        val_rf = rectf[3];
-        nval_rf = rectf[7];
-        diff_rf = nval_rf - val_rf;
+    data.src_line_offset = 4 * (size_t)ibuf->x;
+    data.dst_line_offset = 4 * (size_t)newx;
+    data.step = 4;
+    data.len = ibuf->x;
+    data.newlen = newx;
+    data.add = (ibuf->x - 1.001) / (newx - 1.0);
 
-        rectf += 8;
-      }
-      for (x = newx; x > 0; x--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += 4;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += 4;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += 4;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += 4;
-        }
-        sample += add;
-      }
-    }
+    scale_lines(&data, ibuf->y, scaleup_lines_fn);
   }
 
-  if (do_rect) {
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
-  }
-  if (do_float) {
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
-  }
+  scale_lines_assign(ibuf, &data);
 
   ibuf->x = newx;
   return ibuf;
@@ -1362,10 +1264,8 @@ static ImBuf *scaleupx(struct ImBuf *ibuf, int newx)
 
 static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
 {
-  uchar *rect, *_newrect = NULL, *newrect;
-  float *rectf, *_newrectf = NULL, *newrectf;
-  int x, y, skipx;
-  bool do_rect = false, do_float = false;
+  ScaleLinesData data;
+  int y;
 
   if (ibuf == NULL) {
     return NULL;
@@ -1374,190 +1274,42 @@ static ImBuf *scaleupy(struct ImBuf *ibuf, int newy)
     return ibuf;
   }
 
-  if (ibuf->rect) {
-    do_rect = true;
-    _newrect = MEM_mallocN(ibuf->x * newy * sizeof(int), "scaleupy");
-    if (_newrect == NULL) {
-      return ibuf;
-    }
-  }
-  if (ibuf->rect_float) {
-    do_float = true;
-    _newrectf = MEM_mallocN(sizeof(float[4]) * ibuf->x * newy, "scaleupyf");
-    if (_newrectf == NULL) {
-      if (_newrect) {
-        MEM_freeN(_newrect);
-      }
-      return ibuf;
-    }
+  if (!scale_lines_alloc(ibuf, &data, ibuf->x, newy)) {
+    return ibuf;
   }
 
-  rect = (uchar *)ibuf->rect;
-  rectf = (float *)ibuf->rect_float;
-  newrect = _newrect;
-  newrectf = _newrectf;
-
-  skipx = 4 * ibuf->x;
+  const size_t skipx = 4 * (size_t)ibuf->x;
 
   /* Special case, copy all rows, needed since the scaling logic assumes there is at least
    * two rows to interpolate between causing out of bounds read for 1px images, see T70356. */
   if (UNLIKELY(ibuf->y == 1)) {
-    if (do_rect) {
+    if (data.newrect) {
+      uchar *newrect = data.newrect;
       for (y = newy; y > 0; y--) {
-        memcpy(newrect, rect, sizeof(char) * skipx);
+        memcpy(newrect, data.rect, sizeof(char) * skipx);
         newrect += skipx;
       }
     }
-    if (do_float) {
+    if (data.newrectf) {
+      float *newrectf = data.newrectf;
       for (y = newy; y > 0; y--) {
-        memcpy(newrectf, rectf, sizeof(float) * skipx);
+        memcpy(newrectf, data.rectf, sizeof(float) * skipx);
         newrectf += skipx;
       }
     }
   }
   else {
-    const float add = (ibuf->y - 1.001) / (newy - 1.0);
-    float sample;
-
-    float val_a, nval_a, diff_a;
-    float val_b, nval_b, diff_b;
-    float val_g, nval_g, diff_g;
-    float val_r, nval_r, diff_r;
-    float val_af, nval_af, diff_af;
-    float val_bf, nval_bf, diff_bf;
-    float val_gf, nval_gf, diff_gf;
-    float val_rf, nval_rf, diff_rf;
-
-    val_a = nval_a = diff_a = val_b = nval_b = diff_b = 0;
-    val_g = nval_g = diff_g = val_r = nval_r = diff_r = 0;
-    val_af = nval_af = diff_af = val_bf = nval_bf = diff_bf = 0;
-    val_gf = nval_gf = diff_gf = val_rf = nval_rf = diff_rf = 0;
-
-    for (x = ibuf->x; x > 0; x--) {
-      sample = 0;
-      if (do_rect) {
-        rect = ((uchar *)ibuf->rect) + 4 * (x - 1);
-        newrect = _newrect + 4 * (x - 1);
-
-        val_a = rect[0];
-        nval_a = rect[skipx];
-        diff_a = nval_a - val_a;
-        val_a += 0.5f;
-
-        val_b = rect[1];
-        nval_b = rect[skipx + 1];
-        diff_b = nval_b - val_b;
-        val_b += 0.5f;
-
-        val_g = rect[2];
-        nval_g = rect[skipx + 2];
-        diff_g = nval_g - val_g;
-        val_g += 0.5f;
-
-        val_r = rect[3];
-        nval_r = rect[skipx + 3];
-        diff_r = nval_r - val_r;
-        val_r += 0.5f;
-
-        rect += 2 * skipx;
-      }
-      if (do_float) {
-        rectf = ibuf->rect_float + 4 * (x - 1);
-        newrectf = _newrectf + 4 * (x - 1);
+    data.src_line_offset = 4;
+    data.dst_line_offset = 4;
+    data.step = skipx;
+    data.len = ibuf->y;
+    data.newlen = newy;
+    data.add = (ibuf->y - 1.001) / (newy - 1.0);
 
-        val_af = rectf[0];
-        nval_af = rectf[skipx];
-        diff_af = nval_af - val_af;
-
-        val_bf = rectf[1];
-        nval_bf = rectf[skipx + 1];
-        diff_bf = nval_bf - val_bf;
-
-        val_gf = rectf[2];
-        nval_gf = rectf[skipx + 2];
-        diff_gf = nval_gf - val_gf;
-
-        val_rf = rectf[3];
-        nval_rf = rectf[skipx + 3];
-        diff_rf = nval_rf - val_rf;
-
-        rectf += 2 * skipx;
-      }
-
-      for (y = newy; y > 0; y--) {
-        if (sample >= 1.0f) {
-          sample -= 1.0f;
-
-          if (do_rect) {
-            val_a = nval_a;
-            nval_a = rect[0];
-            diff_a = nval_a - val_a;
-            val_a += 0.5f;
-
-            val_b = nval_b;
-            nval_b = rect[1];
-            diff_b = nval_b - val_b;
-            val_b += 0.5f;
-
-            val_g = nval_g;
-            nval_g = rect[2];
-            diff_g = nval_g - val_g;
-            val_g += 0.5f;
-
-            val_r = nval_r;
-            nval_r = rect[3];
-            diff_r = nval_r - val_r;
-            val_r += 0.5f;
-            rect += skipx;
-          }
-          if (do_float) {
-            val_af = nval_af;
-            nval_af = rectf[0];
-            diff_af = nval_af - val_af;
-
-            val_bf = nval_bf;
-            nval_bf = rectf[1];
-            diff_bf = nval_bf - val_bf;
-
-            val_gf = nval_gf;
-            nval_gf = rectf[2];
-            diff_gf = nval_gf - val_gf;
-
-            val_rf = nval_rf;
-            nval_rf = rectf[3];
-            diff_rf = nval_rf - val_rf;
-            rectf += skipx;
-          }
-        }
-        if (do_rect) {
-          newrect[0] = val_a + sample * diff_a;
-          newrect[1] = val_b + sample * diff_b;
-          newrect[2] = val_g + sample * diff_g;
-          newrect[3] = val_r + sample * diff_r;
-          newrect += skipx;
-        }
-        if (do_float) {
-          newrectf[0] = val_af + sample * diff_af;
-          newrectf[1] = val_bf + sample * diff_bf;
-          newrectf[2] = val_gf + sample * diff_gf;
-          newrectf[3] = val_rf + sample * diff_rf;
-          newrectf += skipx;
-        }
-        sample += add;
-      }
-    }
+    scale_lines(&data, ibuf->x, scaleup_lines_fn);
   }
 
-  if (do_rect) {
-    imb_freerectImBuf(ibuf);
-    ibuf->mall |= IB_rect;
-    ibuf->rect = (uint *)_newrect;
-  }
-  if (do_float) {
-    imb_freerectfloatImBuf(ibuf);
-    ibuf->mall |= IB_rectfloat;
-    ibuf->rect_float = (float *)_newrectf;
-  }
+  scale_lines_assign(ibuf, &data);
 
   ibuf->y = newy;
   return ibuf;
@@ -13,11 +13,13 @@
 
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #ifdef WIN32
 #  include "utfconv.h"
 #endif
 
+#include <algorithm>
 #include <fstream>
 
 using Alembic::Abc::ErrorHandler;
@@ -27,6 +29,9 @@ using Alembic::Abc::kWrapExisting;
 
 namespace blender::io::alembic {
 
+/** Maximum number of file streams opened for one archive. */
+static constexpr int max_streams_num = 4;
+
 static IArchive open_archive(const std::string &filename,
                              const std::vector<std::istream *> &input_streams)
 {
@@ -108,16 +113,32 @@ ArchiveReader::ArchiveReader(struct Main *bmain, const char *filename)
   BLI_strncpy(abs_filename, filename, FILE_MAX);
   BLI_path_abs(abs_filename, BKE_main_blendfile_path(bmain));
 
+  /* Samples of different objects are decoded in parallel (e.g. when prefetching mesh samples),
+   * give each thread its own file stream. The number of streams is capped to not run out of file
+   * handles when many archives are open. */
+  const int streams_num = std::min(BLI_system_thread_count(), max_streams_num);
+
 #ifdef WIN32
   UTF16_ENCODE(abs_filename);
   std::wstring wstr(abs_filename_16);
-  m_infile.open(wstr.c_str(), std::ios::in | std::ios::binary);
-  UTF16_UN_ENCODE(abs_filename);
+#endif
+  for (int i = 0; i < streams_num; i++) {
+    std::unique_ptr<std::ifstream> infile = std::make_unique<std::ifstream>();
+#ifdef WIN32
+    infile->open(wstr.c_str(), std::ios::in | std::ios::binary);
 #else
-  m_infile.open(abs_filename, std::ios::in | std::ios::binary);
+    infile->open(abs_filename, std::ios::in | std::ios::binary);
+#endif
+    if (i > 0 && !infile->is_open()) {
+      /* Errors opening the first stream are reported when opening the archive. */
+      break;
+    }
+    m_streams.push_back(infile.get());
+    m_infiles.push_back(std::move(infile));
+  }
+#ifdef WIN32
+  UTF16_UN_ENCODE(abs_filename);
 #endif
-
-  m_streams.push_back(&m_infile);
 
   m_archive = open_archive(abs_filename, m_streams);
 }
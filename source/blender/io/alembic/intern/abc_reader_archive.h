@@ -10,6 +10,7 @@
 #include <Alembic/AbcCoreOgawa/All.h>
 
 #include <fstream>
+#include <memory>
 
 struct Main;
 
@@ -22,7 +23,9 @@ namespace blender::io::alembic {
 
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
-  std::ifstream m_infile;
+  /* One stream per thread that can read from the archive at the same time, Ogawa locks a
+   * stream while reading from it. */
+  std::vector<std::unique_ptr<std::ifstream>> m_infiles;
   std::vector<std::istream *> m_streams;
 
   std::vector<ArchiveReader *> m_readers;
@@ -19,11 +19,13 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_array_utils.hh"
 #include "BLI_compiler_compat.h"
 #include "BLI_edgehash.h"
 #include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_lib_id.h"
@@ -35,6 +37,7 @@
 
 using Alembic::Abc::FloatArraySamplePtr;
 using Alembic::Abc::Int32ArraySamplePtr;
+using Alembic::Abc::IP3fArrayProperty;
 using Alembic::Abc::IV3fArrayProperty;
 using Alembic::Abc::P3fArraySamplePtr;
 using Alembic::Abc::PropertyHeader;
@@ -173,6 +176,28 @@ void read_mverts(Mesh &mesh, const P3fArraySamplePtr positions, const N3fArraySa
   }
 }
 
+/** Like #read_mverts, for positions that are already in Blender's coordinate system. */
+static void read_mverts(CDStreamConfig &config,
+                        const Span<float3> positions,
+                        const Span<float3> ceil_positions)
+{
+  MutableSpan<float3> vert_positions(config.positions, config.totvert);
+
+  if (config.use_vertex_interpolation && config.weight != 0.0f &&
+      ceil_positions.size() == positions.size()) {
+    const float weight = float(config.weight);
+    threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        interp_v3_v3v3(vert_positions[i], positions[i], ceil_positions[i], weight);
+      }
+    });
+  }
+  else {
+    array_utils::copy(positions, vert_positions);
+  }
+  BKE_mesh_tag_coords_changed(config.mesh);
+}
+
 static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
 {
   MPoly *mpolys = config.mpoly;
@@ -337,6 +362,32 @@ static void process_normals(CDStreamConfig &config,
   }
 }
 
+static std::string get_uv_map_name(const IV2fGeomParam &uv)
+{
+  std::string name = Alembic::Abc::GetSourceName(uv.getMetaData());
+
+  /* According to the convention, primary UVs should have had their name
+   * set using Alembic::Abc::SetSourceName, but you can't expect everyone
+   * to follow it! :) */
+  if (name.empty()) {
+    name = uv.getName();
+  }
+  return name;
+}
+
+/** Whether the UV map has to be read again, because it is animated or not in the mesh yet. */
+static bool uvs_need_update(const IV2fGeomParam &uv, const Mesh &mesh)
+{
+  if (!uv.valid()) {
+    return false;
+  }
+  if (!uv.isConstant()) {
+    return true;
+  }
+  const std::string name = get_uv_map_name(uv);
+  return CustomData_get_named_layer_index(&mesh.ldata, CD_PROP_FLOAT2, name.c_str()) == -1;
+}
+
 BLI_INLINE void read_uvs_params(CDStreamConfig &config,
                                 AbcMeshData &abc_data,
                                 const IV2fGeomParam &uv,
@@ -361,15 +412,7 @@ BLI_INLINE void read_uvs_params(CDStreamConfig &config,
   abc_data.uvs = uvsamp.getVals();
   abc_data.uvs_indices = uvs_indices;
 
-  std::string name = Alembic::Abc::GetSourceName(uv.getMetaData());
-
-  /* According to the convention, primary UVs should have had their name
-   * set using Alembic::Abc::SetSourceName, but you can't expect everyone
-   * to follow it! :) */
-  if (name.empty()) {
-    name = uv.getName();
-  }
-
+  const std::string name = get_uv_map_name(uv);
   void *cd_ptr = config.add_customdata_cb(config.mesh, name.c_str(), CD_PROP_FLOAT2);
   config.mloopuv = static_cast<float2 *>(cd_ptr);
 }
@@ -466,53 +509,6 @@ static void read_velocity(const V3fArraySamplePtr &velocities,
   }
 }
 
-static void read_mesh_sample(const std::string &iobject_full_name,
-                             ImportSettings *settings,
-                             const IPolyMeshSchema &schema,
-                             const ISampleSelector &selector,
-                             CDStreamConfig &config)
-{
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
-  AbcMeshData abc_mesh_data;
-  abc_mesh_data.face_counts = sample.getFaceCounts();
-  abc_mesh_data.face_indices = sample.getFaceIndices();
-  abc_mesh_data.positions = sample.getPositions();
-
-  get_weight_and_index(config, schema.getTimeSampling(), schema.getNumSamples());
-
-  if (config.weight != 0.0f) {
-    Alembic::AbcGeom::IPolyMeshSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(config.ceil_index));
-    abc_mesh_data.ceil_positions = ceil_sample.getPositions();
-  }
-
-  if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0) {
-    read_uvs_params(config, abc_mesh_data, schema.getUVsParam(), selector);
-  }
-
-  if ((settings->read_flag & MOD_MESHSEQ_READ_VERT) != 0) {
-    read_mverts(config, abc_mesh_data);
-    read_generated_coordinates(schema.getArbGeomParams(), config, selector);
-  }
-
-  if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
-    read_mpolys(config, abc_mesh_data);
-    process_normals(config, schema.getNormalsParam(), selector);
-  }
-
-  if ((settings->read_flag & (MOD_MESHSEQ_READ_UV | MOD_MESHSEQ_READ_COLOR)) != 0) {
-    read_custom_data(iobject_full_name, schema.getArbGeomParams(), config, selector);
-  }
-
-  if (!settings->velocity_name.empty() && settings->velocity_scale != 0.0f) {
-    V3fArraySamplePtr velocities = get_velocity_prop(schema, selector, settings->velocity_name);
-    if (velocities) {
-      read_velocity(velocities, config, settings->velocity_scale);
-    }
-  }
-}
-
 CDStreamConfig get_config(Mesh *mesh, const bool use_vertex_interpolation)
 {
   CDStreamConfig config;
@@ -543,6 +539,15 @@ AbcMeshReader::AbcMeshReader(const IObject &object, ImportSettings &settings)
   get_min_max_time(m_iobject, m_schema, m_min_time, m_max_time);
 }
 
+AbcMeshReader::~AbcMeshReader()
+{
+  if (m_prefetch_pool) {
+    BLI_task_pool_work_and_wait(m_prefetch_pool);
+    BLI_task_pool_free(m_prefetch_pool);
+  }
+  PositionsCache::get().remove_owner(this);
+}
+
 bool AbcMeshReader::valid() const
 {
   return m_schema.valid();
@@ -649,11 +654,30 @@ bool AbcMeshReader::accepts_object_type(
   return true;
 }
 
+/**
+ * Read the number of vertices, faces and loops of a sample. Only the sizes of the arrays are read,
+ * which is much cheaper than decoding the whole sample.
+ */
+static void read_sample_sizes(const IPolyMeshSchema &schema,
+                              const ISampleSelector &sample_sel,
+                              size_t &r_verts_num,
+                              size_t &r_polys_num,
+                              size_t &r_loops_num)
+{
+  Alembic::Util::Dimensions dimensions;
+  schema.getPositionsProperty().getDimensions(dimensions, sample_sel);
+  r_verts_num = dimensions.numPoints();
+  schema.getFaceCountsProperty().getDimensions(dimensions, sample_sel);
+  r_polys_num = dimensions.numPoints();
+  schema.getFaceIndicesProperty().getDimensions(dimensions, sample_sel);
+  r_loops_num = dimensions.numPoints();
+}
+
 bool AbcMeshReader::topology_changed(const Mesh *existing_mesh, const ISampleSelector &sample_sel)
 {
-  IPolyMeshSchema::Sample sample;
+  size_t verts_num, polys_num, loops_num;
   try {
-    sample = m_schema.getValue(sample_sel);
+    read_sample_sizes(m_schema, sample_sel, verts_num, polys_num, loops_num);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -665,13 +689,8 @@ bool AbcMeshReader::topology_changed(const Mesh *existing_mesh, const ISampleSel
     return false;
   }
 
-  const P3fArraySamplePtr &positions = sample.getPositions();
-  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
-  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
-
-  return positions->size() != existing_mesh->totvert ||
-         face_counts->size() != existing_mesh->totpoly ||
-         face_indices->size() != existing_mesh->totloop;
+  return verts_num != existing_mesh->totvert || polys_num != existing_mesh->totpoly ||
+         loops_num != existing_mesh->totloop;
 }
 
 Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
@@ -681,9 +700,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
                                const float velocity_scale,
                                const char **err_str)
 {
-  IPolyMeshSchema::Sample sample;
+  size_t verts_num, polys_num, loops_num;
   try {
-    sample = m_schema.getValue(sample_sel);
+    read_sample_sizes(m_schema, sample_sel, verts_num, polys_num, loops_num);
   }
   catch (Alembic::Util::Exception &ex) {
     if (err_str != nullptr) {
@@ -697,13 +716,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
     return existing_mesh;
   }
 
-  const P3fArraySamplePtr &positions = sample.getPositions();
-  const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
-  const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
-
   /* Do some very minimal mesh validation. */
-  const int poly_count = face_counts->size();
-  const int loop_count = face_indices->size();
+  const int poly_count = int(polys_num);
+  const int loop_count = int(loops_num);
   /* This is the same test as in poly_to_tri_count(). */
   if (poly_count > 0 && loop_count < poly_count * 2) {
     if (err_str != nullptr) {
@@ -724,9 +739,10 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   settings.velocity_name = velocity_name;
   settings.velocity_scale = velocity_scale;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  if (verts_num != existing_mesh->totvert || polys_num != existing_mesh->totpoly ||
+      loops_num != existing_mesh->totloop) {
     new_mesh = BKE_mesh_new_nomain_from_template(
-        existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
+        existing_mesh, verts_num, 0, 0, loops_num, polys_num);
 
     settings.read_flag |= MOD_MESHSEQ_READ_ALL;
   }
@@ -734,8 +750,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
     /* If the face count changed (e.g. by triangulation), only read points.
      * This prevents crash from T49813.
      * TODO(kevin): perhaps find a better way to do this? */
-    if (face_counts->size() != existing_mesh->totpoly ||
-        face_indices->size() != existing_mesh->totloop) {
+    if (polys_num != existing_mesh->totpoly || loops_num != existing_mesh->totloop) {
       settings.read_flag = MOD_MESHSEQ_READ_VERT;
 
       if (err_str) {
@@ -752,7 +767,15 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  /* When the topology does not vary over time, the faces of the existing mesh are the same as
+   * the faces of the sample, so only the data that changes has to be read. */
+  const bool reuse_topology = new_mesh == nullptr &&
+                              m_schema.getTopologyVariance() !=
+                                  Alembic::AbcGeom::kHeterogenousTopology &&
+                              ((settings.read_flag & MOD_MESHSEQ_READ_UV) == 0 ||
+                               !uvs_need_update(m_schema.getUVsParam(), *existing_mesh));
+
+  read_mesh_sample(&settings, sample_sel, config, reuse_topology);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -830,6 +853,122 @@ void AbcMeshReader::readFaceSetsSample(Main *bmain, Mesh *mesh, const ISampleSel
   utils::assign_materials(bmain, m_object, mat_map);
 }
 
+void AbcMeshReader::read_mesh_sample(ImportSettings *settings,
+                                     const ISampleSelector &selector,
+                                     CDStreamConfig &config,
+                                     const bool reuse_topology)
+{
+  AbcMeshData abc_mesh_data;
+
+  get_weight_and_index(config, m_schema.getTimeSampling(), m_schema.getNumSamples());
+
+  if ((settings->read_flag & MOD_MESHSEQ_READ_UV) != 0 && !reuse_topology) {
+    read_uvs_params(config, abc_mesh_data, m_schema.getUVsParam(), selector);
+  }
+
+  if ((settings->read_flag & MOD_MESHSEQ_READ_VERT) != 0) {
+    const int64_t sample_index = selector.getIndex(m_schema.getTimeSampling(),
+                                                   m_schema.getNumSamples());
+    const PositionsCache::PositionsPtr positions = this->read_positions(sample_index);
+    PositionsCache::PositionsPtr ceil_positions;
+    if (config.use_vertex_interpolation && config.weight != 0.0f) {
+      ceil_positions = this->read_positions(config.ceil_index);
+    }
+    read_mverts(config, *positions, ceil_positions ? ceil_positions->as_span() : Span<float3>());
+    read_generated_coordinates(m_schema.getArbGeomParams(), config, selector);
+
+    /* Frames read in increasing order means playback or rendering, decode the next sample while
+     * the rest of the scene is evaluated. */
+    if (m_last_sample_index != -1 && sample_index > m_last_sample_index) {
+      const int64_t last_read_index = ceil_positions ? int64_t(config.ceil_index) : sample_index;
+      this->prefetch_positions(last_read_index + 1);
+    }
+    m_last_sample_index = sample_index;
+  }
+
+  if ((settings->read_flag & MOD_MESHSEQ_READ_POLY) != 0) {
+    if (!reuse_topology) {
+      abc_mesh_data.face_counts = m_schema.getFaceCountsProperty().getValue(selector);
+      abc_mesh_data.face_indices = m_schema.getFaceIndicesProperty().getValue(selector);
+      read_mpolys(config, abc_mesh_data);
+    }
+    process_normals(config, m_schema.getNormalsParam(), selector);
+  }
+
+  if ((settings->read_flag & (MOD_MESHSEQ_READ_UV | MOD_MESHSEQ_READ_COLOR)) != 0) {
+    read_custom_data(m_iobject.getFullName(), m_schema.getArbGeomParams(), config, selector);
+  }
+
+  if (!settings->velocity_name.empty() && settings->velocity_scale != 0.0f) {
+    V3fArraySamplePtr velocities = get_velocity_prop(m_schema, selector, settings->velocity_name);
+    if (velocities) {
+      read_velocity(velocities, config, settings->velocity_scale);
+    }
+  }
+}
+
+PositionsCache::PositionsPtr AbcMeshReader::read_positions(const int64_t sample_index)
+{
+  IP3fArrayProperty positions_prop = m_schema.getPositionsProperty();
+  /* Only animated positions are cached, static meshes are read once. */
+  const bool use_cache = !positions_prop.isConstant();
+  if (use_cache) {
+    if (PositionsCache::PositionsPtr positions = PositionsCache::get().lookup(this,
+                                                                              sample_index)) {
+      return positions;
+    }
+  }
+
+  const P3fArraySamplePtr sample = positions_prop.getValue(ISampleSelector(sample_index));
+  std::shared_ptr<Array<float3>> positions = std::make_shared<Array<float3>>(sample->size());
+  MutableSpan<float3> dst = *positions;
+  threading::parallel_for(dst.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      copy_zup_from_yup(dst[i], (*sample)[i].getValue());
+    }
+  });
+
+  if (use_cache) {
+    PositionsCache::get().add(this, sample_index, positions);
+  }
+  return positions;
+}
+
+void AbcMeshReader::prefetch_positions(const int64_t sample_index)
+{
+  if (sample_index >= int64_t(m_schema.getPositionsProperty().getNumSamples())) {
+    return;
+  }
+  /* Don't queue up samples when decoding is slower than playback. */
+  if (m_prefetch_pending) {
+    return;
+  }
+  if (PositionsCache::get().contains(this, sample_index)) {
+    return;
+  }
+
+  if (m_prefetch_pool == nullptr) {
+    m_prefetch_pool = BLI_task_pool_create_background(this, TASK_PRIORITY_LOW);
+  }
+  m_prefetch_pending = true;
+  m_prefetch_index = sample_index;
+  BLI_task_pool_push(
+      m_prefetch_pool,
+      [](TaskPool *__restrict pool, void * /*taskdata*/) {
+        AbcMeshReader *reader = static_cast<AbcMeshReader *>(BLI_task_pool_user_data(pool));
+        try {
+          reader->read_positions(reader->m_prefetch_index);
+        }
+        catch (Alembic::Util::Exception & /*ex*/) {
+          /* Errors are reported when the sample is read for the evaluated mesh. */
+        }
+        reader->m_prefetch_pending = false;
+      },
+      nullptr,
+      false,
+      nullptr);
+}
+
 /* ************************************************************************** */
 
 static void read_subd_sample(const std::string &iobject_full_name,
@@ -5,10 +5,14 @@
  * \ingroup balembic
  */
 
+#include <atomic>
+
 #include "BLI_span.hh"
+#include "BLI_task.h"
 
 #include "abc_customdata.h"
 #include "abc_reader_object.h"
+#include "abc_sample_cache.h"
 
 struct Mesh;
 
@@ -17,8 +21,16 @@ namespace blender::io::alembic {
 class AbcMeshReader final : public AbcObjectReader {
   Alembic::AbcGeom::IPolyMeshSchema m_schema;
 
+  /** Sample index of the previously read positions, to detect playback. */
+  int64_t m_last_sample_index = -1;
+  /** Decodes the positions of the next sample in the background during playback. */
+  TaskPool *m_prefetch_pool = nullptr;
+  std::atomic<bool> m_prefetch_pending = false;
+  std::atomic<int64_t> m_prefetch_index = 0;
+
  public:
   AbcMeshReader(const Alembic::Abc::IObject &object, ImportSettings &settings);
+  ~AbcMeshReader() override;
 
   bool valid() const override;
   bool accepts_object_type(const Alembic::AbcCoreAbstract::ObjectHeader &alembic_header,
@@ -43,6 +55,20 @@ class AbcMeshReader final : public AbcObjectReader {
   void assign_facesets_to_material_indices(const Alembic::Abc::ISampleSelector &sample_sel,
                                            MutableSpan<int> material_indices,
                                            std::map<std::string, int> &r_mat_map);
+
+  /**
+   * Read the sample into the mesh of `config`. With `reuse_topology`, the faces, loops and edges
+   * of the mesh are known to match the sample and are not read again.
+   */
+  void read_mesh_sample(ImportSettings *settings,
+                        const Alembic::Abc::ISampleSelector &selector,
+                        CDStreamConfig &config,
+                        bool reuse_topology);
+
+  /** The positions of a sample in Blender's coordinate system, from the cache when possible. */
+  PositionsCache::PositionsPtr read_positions(int64_t sample_index);
+  /** Start decoding the positions of a sample in the background, so that they are cached. */
+  void prefetch_positions(int64_t sample_index);
 };
 
 class AbcSubDReader final : public AbcObjectReader {
@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup balembic
+ */
+
+#include "abc_sample_cache.h"
+
+namespace blender::io::alembic {
+
+/** Enough for the animated positions of a few hundred characters over several frames. */
+static constexpr int64_t default_capacity_in_bytes = int64_t(512) * 1024 * 1024;
+
+static int64_t positions_size_in_bytes(const Array<float3> &positions)
+{
+  return positions.as_span().size_in_bytes();
+}
+
+PositionsCache::PositionsCache(const int64_t capacity_in_bytes)
+    : capacity_in_bytes_(capacity_in_bytes)
+{
+}
+
+PositionsCache &PositionsCache::get()
+{
+  static PositionsCache cache(default_capacity_in_bytes);
+  return cache;
+}
+
+PositionsCache::PositionsPtr PositionsCache::lookup(const void *owner, const int64_t sample_index)
+{
+  std::lock_guard lock{mutex_};
+  Entry *entry = entries_.lookup_ptr({owner, sample_index});
+  if (entry == nullptr) {
+    return {};
+  }
+  lru_.splice(lru_.begin(), lru_, entry->lru_position);
+  return entry->positions;
+}
+
+bool PositionsCache::contains(const void *owner, const int64_t sample_index)
+{
+  std::lock_guard lock{mutex_};
+  return entries_.contains({owner, sample_index});
+}
+
+void PositionsCache::add(const void *owner, const int64_t sample_index, PositionsPtr positions)
+{
+  const int64_t size = positions_size_in_bytes(*positions);
+  if (size > capacity_in_bytes_) {
+    return;
+  }
+
+  std::lock_guard lock{mutex_};
+  const Key key{owner, sample_index};
+  if (entries_.contains(key)) {
+    /* Another thread decoded the same sample in the meantime. */
+    return;
+  }
+  lru_.push_front(key);
+  entries_.add_new(key, {std::move(positions), lru_.begin()});
+  size_in_bytes_ += size;
+
+  while (size_in_bytes_ > capacity_in_bytes_) {
+    const Entry removed_entry = entries_.pop(lru_.back());
+    size_in_bytes_ -= positions_size_in_bytes(*removed_entry.positions);
+    lru_.pop_back();
+  }
+}
+
+void PositionsCache::remove_owner(const void *owner)
+{
+  std::lock_guard lock{mutex_};
+  for (auto it = lru_.begin(); it != lru_.end();) {
+    if (it->first != owner) {
+      ++it;
+      continue;
+    }
+    const Entry removed_entry = entries_.pop(*it);
+    size_in_bytes_ -= positions_size_in_bytes(*removed_entry.positions);
+    it = lru_.erase(it);
+  }
+}
+
+int64_t PositionsCache::size_in_bytes()
+{
+  std::lock_guard lock{mutex_};
+  return size_in_bytes_;
+}
+
+}  // namespace blender::io::alembic
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+/** \file
+ * \ingroup balembic
+ */
+
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+#include "BLI_math_vector_types.hh"
+
+namespace blender::io::alembic {
+
+/**
+ * Memory-bounded cache of decoded vertex positions of animated meshes, shared by all readers.
+ * When the cache grows beyond its capacity, the least recently used samples are removed.
+ *
+ * Positions are stored in Blender's coordinate system, so that they can be copied into a mesh
+ * directly. All functions can be called from multiple threads.
+ */
+class PositionsCache {
+ public:
+  using PositionsPtr = std::shared_ptr<const Array<float3>>;
+
+ private:
+  /** The reader that decoded the positions, and the index of their sample. */
+  using Key = std::pair<const void *, int64_t>;
+
+  struct Entry {
+    PositionsPtr positions;
+    std::list<Key>::iterator lru_position;
+  };
+
+  std::mutex mutex_;
+  Map<Key, Entry> entries_;
+  /** Keys of all entries, the most recently used first. */
+  std::list<Key> lru_;
+  int64_t size_in_bytes_ = 0;
+  int64_t capacity_in_bytes_;
+
+ public:
+  PositionsCache(int64_t capacity_in_bytes);
+
+  /** The cache used by all Alembic mesh readers. */
+  static PositionsCache &get();
+
+  /** Return the positions of a sample decoded by `owner`, or null when they are not cached. */
+  PositionsPtr lookup(const void *owner, int64_t sample_index);
+  bool contains(const void *owner, int64_t sample_index);
+  void add(const void *owner, int64_t sample_index, PositionsPtr positions);
+  /** Remove all samples of `owner`. Must be called before the owner is freed. */
+  void remove_owner(const void *owner);
+
+  int64_t size_in_bytes();
+};
+
+}  // namespace blender::io::alembic
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "intern/abc_sample_cache.h"
+
+namespace blender::io::alembic {
+
+static PositionsCache::PositionsPtr make_positions(const int64_t size, const float value)
+{
+  return std::make_shared<const Array<float3>>(size, float3(value));
+}
+
+TEST(abc_sample_cache, lookup)
+{
+  PositionsCache cache(1024);
+  const int owner_a = 0;
+  const int owner_b = 0;
+  cache.add(&owner_a, 3, make_positions(4, 1.0f));
+
+  EXPECT_TRUE(cache.contains(&owner_a, 3));
+  EXPECT_FALSE(cache.contains(&owner_a, 4));
+  EXPECT_FALSE(cache.contains(&owner_b, 3));
+  EXPECT_EQ(cache.lookup(&owner_b, 3), nullptr);
+
+  PositionsCache::PositionsPtr positions = cache.lookup(&owner_a, 3);
+  ASSERT_NE(positions, nullptr);
+  EXPECT_EQ(positions->size(), 4);
+  EXPECT_EQ((*positions)[2], float3(1.0f));
+  EXPECT_EQ(cache.size_in_bytes(), 4 * int64_t(sizeof(float3)));
+}
+
+TEST(abc_sample_cache, evict_least_recently_used)
+{
+  /* Room for three samples of ten positions. */
+  PositionsCache cache(30 * sizeof(float3));
+  const int owner = 0;
+  cache.add(&owner, 0, make_positions(10, 0.0f));
+  cache.add(&owner, 1, make_positions(10, 1.0f));
+  cache.add(&owner, 2, make_positions(10, 2.0f));
+
+  /* Using the first sample makes the second one the least recently used. */
+  EXPECT_NE(cache.lookup(&owner, 0), nullptr);
+  cache.add(&owner, 3, make_positions(10, 3.0f));
+
+  EXPECT_TRUE(cache.contains(&owner, 0));
+  EXPECT_FALSE(cache.contains(&owner, 1));
+  EXPECT_TRUE(cache.contains(&owner, 2));
+  EXPECT_TRUE(cache.contains(&owner, 3));
+  EXPECT_EQ(cache.size_in_bytes(), 30 * int64_t(sizeof(float3)));
+
+  /* Samples larger than the whole cache are not stored. */
+  cache.add(&owner, 4, make_positions(40, 4.0f));
+  EXPECT_FALSE(cache.contains(&owner, 4));
+  EXPECT_TRUE(cache.contains(&owner, 0));
+}
+
+TEST(abc_sample_cache, remove_owner)
+{
+  PositionsCache cache(1024);
+  const int owner_a = 0;
+  const int owner_b = 0;
+  cache.add(&owner_a, 0, make_positions(2, 0.0f));
+  cache.add(&owner_b, 0, make_positions(3, 0.0f));
+  cache.add(&owner_a, 1, make_positions(2, 1.0f));
+
+  PositionsCache::PositionsPtr kept_positions = cache.lookup(&owner_a, 1);
+  cache.remove_owner(&owner_a);
+
+  EXPECT_FALSE(cache.contains(&owner_a, 0));
+  EXPECT_FALSE(cache.contains(&owner_a, 1));
+  EXPECT_TRUE(cache.contains(&owner_b, 0));
+  EXPECT_EQ(cache.size_in_bytes(), 3 * int64_t(sizeof(float3)));
+  /* Positions in use stay valid after they are removed from the cache. */
+  EXPECT_EQ((*kept_positions)[0], float3(1.0f));
+}
+
+}  // namespace blender::io::alembic
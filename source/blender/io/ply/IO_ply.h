@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "BKE_context.h"
+#include "BLI_path_util.h"
+#include "IO_orientation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct PLYImportParams {
+  /** Full path to the source PLY file to import. */
+  char filepath[FILE_MAX];
+  eIOAxis forward_axis;
+  eIOAxis up_axis;
+  bool use_scene_unit;
+  float global_scale;
+  bool use_mesh_validate;
+  /** Import files without faces and edges as point cloud objects instead of meshes. */
+  bool use_point_cloud;
+};
+
+struct PLYExportParams {
+  /** Full path to the destination PLY file. */
+  char filepath[FILE_MAX];
+  /** Whether to write binary or ASCII data. */
+  bool ascii_format;
+
+  /* Geometry Transform options. */
+  eIOAxis forward_axis;
+  eIOAxis up_axis;
+  float global_scale;
+
+  /* File Write Options. */
+  bool export_selected_objects;
+  bool apply_modifiers;
+  bool export_uv;
+  bool export_normals;
+  bool export_colors;
+};
+
+/**
+ * C-interface for the importer.
+ */
+void PLY_import(bContext *C, const struct PLYImportParams *import_params);
+
+/**
+ * C-interface for the exporter.
+ */
+void PLY_export(bContext *C, const struct PLYExportParams *export_params);
+
+#ifdef __cplusplus
+}
+#endif
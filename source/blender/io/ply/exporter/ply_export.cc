@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "BKE_blender_version.h"
+
+#include "BLI_fileops.h"
+
+#include "DEG_depsgraph.h"
+
+#include "ply_data.hh"
+#include "ply_export.hh"
+#include "ply_export_data.hh"
+#include "ply_export_load_plydata.hh"
+
+namespace blender::io::ply {
+
+void exporter_main(bContext *C, const PLYExportParams &export_params)
+{
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+  export_to_ply_file(depsgraph, export_params);
+}
+
+void export_to_ply_file(Depsgraph *depsgraph, const PLYExportParams &export_params)
+{
+  PlyData data;
+  load_plydata(data, depsgraph, export_params);
+
+  FILE *file = BLI_fopen(export_params.filepath, "wb");
+  if (file == nullptr) {
+    fprintf(stderr, "PLY Exporter: failed to open file '%s'.\n", export_params.filepath);
+    return;
+  }
+  bool write_failed = false;
+  const std::string comment = std::string("Created in Blender version ") +
+                              BKE_blender_version_string();
+  write_ply_data(data, export_params.ascii_format, comment, [&](const Span<char> buffer) {
+    if (!write_failed && fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+      write_failed = true;
+    }
+  });
+  if (fclose(file) != 0 || write_failed) {
+    fprintf(stderr, "PLY Exporter: failed to write file '%s'.\n", export_params.filepath);
+  }
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,22 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "IO_ply.h"
+
+struct Depsgraph;
+
+namespace blender::io::ply {
+
+/* Main export function used from within Blender. */
+void exporter_main(bContext *C, const PLYExportParams &export_params);
+
+/* Export the objects of an evaluated depsgraph, used from tests where full bContext does not
+ * exist. */
+void export_to_ply_file(Depsgraph *depsgraph, const PLYExportParams &export_params);
+
+}  // namespace blender::io::ply
@@ -0,0 +1,215 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <cstdio>
+#include <string>
+
+#include "BLI_endian_defines.h"
+#include "BLI_task.hh"
+
+#include "ply_export_data.hh"
+
+namespace blender::io::ply {
+
+/** Number of vertices or faces formatted by one task. */
+static constexpr int64_t block_size = 16 * 1024;
+/** Number of blocks formatted in parallel before they are written, to bound memory usage. */
+static constexpr int64_t blocks_per_batch = 64;
+
+/**
+ * Format `items_num` items with `fill_block(items, buffer)` in parallel blocks, and pass the
+ * buffers to `write_fn` in order.
+ */
+template<typename FillBlockFn>
+static void write_in_blocks(const int64_t items_num,
+                            const FunctionRef<void(Span<char>)> write_fn,
+                            const FillBlockFn &fill_block)
+{
+  const int64_t blocks_num = (items_num + block_size - 1) / block_size;
+  Array<Vector<char>> buffers(std::min(blocks_num, blocks_per_batch));
+  for (int64_t batch_start = 0; batch_start < blocks_num; batch_start += blocks_per_batch) {
+    const IndexRange batch(batch_start, std::min(blocks_per_batch, blocks_num - batch_start));
+    threading::parallel_for(IndexRange(batch.size()), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        const int64_t start = (batch.start() + i) * block_size;
+        buffers[i].clear();
+        fill_block(IndexRange(start, std::min(block_size, items_num - start)), buffers[i]);
+      }
+    });
+    for (const int64_t i : IndexRange(batch.size())) {
+      write_fn(buffers[i]);
+    }
+  }
+}
+
+template<typename T> static void append_binary(Vector<char> &buffer, const T &value)
+{
+  buffer.extend(Span<char>(reinterpret_cast<const char *>(&value), sizeof(T)));
+}
+
+/* ASCII values are followed by a space, which is replaced by the line ending after the last. */
+
+static void append_ascii(Vector<char> &buffer, const float value)
+{
+  char str[64];
+  const int len = std::snprintf(str, sizeof(str), "%.6f ", value);
+  buffer.extend(Span<char>(str, len));
+}
+
+static void append_ascii(Vector<char> &buffer, const int value)
+{
+  char str[16];
+  const int len = std::snprintf(str, sizeof(str), "%d ", value);
+  buffer.extend(Span<char>(str, len));
+}
+
+static void end_ascii_line(Vector<char> &buffer)
+{
+  buffer.last() = '\n';
+}
+
+static std::string ply_header(const PlyData &data,
+                              const bool ascii_format,
+                              const StringRef comment,
+                              const bool use_uint_face_size)
+{
+  std::string header = "ply\n";
+  if (ascii_format) {
+    header += "format ascii 1.0\n";
+  }
+  else if (ENDIAN_ORDER == L_ENDIAN) {
+    header += "format binary_little_endian 1.0\n";
+  }
+  else {
+    header += "format binary_big_endian 1.0\n";
+  }
+  if (!comment.is_empty()) {
+    header += "comment " + std::string(comment) + "\n";
+  }
+
+  header += "element vertex " + std::to_string(data.vertices.size()) + "\n";
+  header += "property float x\nproperty float y\nproperty float z\n";
+  if (!data.vertex_normals.is_empty()) {
+    header += "property float nx\nproperty float ny\nproperty float nz\n";
+  }
+  if (!data.uv_coordinates.is_empty()) {
+    header += "property float s\nproperty float t\n";
+  }
+  if (!data.vertex_colors.is_empty()) {
+    header +=
+        "property uchar red\nproperty uchar green\nproperty uchar blue\nproperty uchar alpha\n";
+  }
+
+  header += "element face " + std::to_string(data.faces_num()) + "\n";
+  header += use_uint_face_size ? "property list uint uint vertex_indices\n" :
+                                 "property list uchar uint vertex_indices\n";
+  header += "end_header\n";
+  return header;
+}
+
+static void write_vertex_block(const PlyData &data,
+                               const bool ascii_format,
+                               const IndexRange verts,
+                               Vector<char> &buffer)
+{
+  for (const int64_t i : verts) {
+    if (ascii_format) {
+      append_ascii(buffer, data.vertices[i].x);
+      append_ascii(buffer, data.vertices[i].y);
+      append_ascii(buffer, data.vertices[i].z);
+      if (!data.vertex_normals.is_empty()) {
+        append_ascii(buffer, data.vertex_normals[i].x);
+        append_ascii(buffer, data.vertex_normals[i].y);
+        append_ascii(buffer, data.vertex_normals[i].z);
+      }
+      if (!data.uv_coordinates.is_empty()) {
+        append_ascii(buffer, data.uv_coordinates[i].x);
+        append_ascii(buffer, data.uv_coordinates[i].y);
+      }
+      if (!data.vertex_colors.is_empty()) {
+        const ColorGeometry4b &color = data.vertex_colors[i];
+        append_ascii(buffer, int(color.r));
+        append_ascii(buffer, int(color.g));
+        append_ascii(buffer, int(color.b));
+        append_ascii(buffer, int(color.a));
+      }
+      end_ascii_line(buffer);
+      continue;
+    }
+
+    append_binary(buffer, data.vertices[i]);
+    if (!data.vertex_normals.is_empty()) {
+      append_binary(buffer, data.vertex_normals[i]);
+    }
+    if (!data.uv_coordinates.is_empty()) {
+      append_binary(buffer, data.uv_coordinates[i]);
+    }
+    if (!data.vertex_colors.is_empty()) {
+      append_binary(buffer, data.vertex_colors[i]);
+    }
+  }
+}
+
+static void write_face_block(const PlyData &data,
+                             const bool ascii_format,
+                             const bool use_uint_face_size,
+                             const IndexRange faces,
+                             Vector<char> &buffer)
+{
+  for (const int64_t face : faces) {
+    const Span<int> face_verts = data.face_vertices.as_span().slice(
+        data.face_offsets[face], data.face_offsets[face + 1] - data.face_offsets[face]);
+    if (ascii_format) {
+      append_ascii(buffer, int(face_verts.size()));
+      for (const int vert : face_verts) {
+        append_ascii(buffer, vert);
+      }
+      end_ascii_line(buffer);
+      continue;
+    }
+
+    if (use_uint_face_size) {
+      append_binary(buffer, uint32_t(face_verts.size()));
+    }
+    else {
+      append_binary(buffer, uint8_t(face_verts.size()));
+    }
+    buffer.extend(face_verts.cast<char>());
+  }
+}
+
+void write_ply_data(const PlyData &data,
+                    const bool ascii_format,
+                    const StringRef comment,
+                    const FunctionRef<void(Span<char>)> write_fn)
+{
+  const int faces_num = data.faces_num();
+  const int max_face_size = threading::parallel_reduce(
+      IndexRange(faces_num),
+      4096,
+      0,
+      [&](const IndexRange range, int max_size) {
+        for (const int face : range) {
+          max_size = std::max(max_size, data.face_offsets[face + 1] - data.face_offsets[face]);
+        }
+        return max_size;
+      },
+      [](const int a, const int b) { return std::max(a, b); });
+  const bool use_uint_face_size = max_face_size > UINT8_MAX;
+
+  const std::string header = ply_header(data, ascii_format, comment, use_uint_face_size);
+  write_fn(Span<char>(header.data(), int64_t(header.size())));
+
+  write_in_blocks(
+      data.vertices.size(), write_fn, [&](const IndexRange verts, Vector<char> &buffer) {
+        write_vertex_block(data, ascii_format, verts, buffer);
+      });
+  write_in_blocks(faces_num, write_fn, [&](const IndexRange faces, Vector<char> &buffer) {
+    write_face_block(data, ascii_format, use_uint_face_size, faces, buffer);
+  });
+}
+
+}  // namespace blender::io::ply
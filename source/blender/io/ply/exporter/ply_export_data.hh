@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "BLI_function_ref.hh"
+#include "BLI_span.hh"
+
+#include "ply_data.hh"
+
+namespace blender::io::ply {
+
+/**
+ * Write the header and the vertex and face elements of `data`. Optional vertex properties are
+ * written when their arrays are not empty.
+ *
+ * The elements are formatted in blocks that are processed in parallel, `write_fn` receives the
+ * consecutive pieces of the file in order.
+ */
+void write_ply_data(const PlyData &data,
+                    bool ascii_format,
+                    StringRef comment,
+                    FunctionRef<void(Span<char>)> write_fn);
+
+}  // namespace blender::io::ply
@@ -0,0 +1,238 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include "BKE_attribute.hh"
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_map.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.hh"
+
+#include "DEG_depsgraph_query.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "ply_export_load_plydata.hh"
+
+namespace blender::io::ply {
+
+/** An evaluated mesh and where its elements go in the exported data. */
+struct ExportMesh {
+  const Mesh *mesh;
+  float transform[4][4];
+  float normal_transform[3][3];
+  VArraySpan<float2> uv_map;
+  VArraySpan<ColorGeometry4f> colors;
+
+  /**
+   * When vertices are split by UV, the PLY vertex of every face corner and the mesh vertex and UV
+   * of every PLY vertex. Empty when every mesh vertex is one PLY vertex.
+   */
+  Array<int> corner_verts;
+  Vector<int> vert_mesh_verts;
+  Vector<float2> vert_uvs;
+
+  int verts_num;
+  int vert_offset;
+  int face_offset;
+  int corner_offset;
+};
+
+static void set_world_axes_transform(ExportMesh &export_mesh,
+                                     const Object &object,
+                                     const PLYExportParams &export_params)
+{
+  float axes_transform[3][3];
+  unit_m3(axes_transform);
+  /* +Y-forward and +Z-up are the default Blender axis settings. */
+  mat3_from_axis_conversion(
+      export_params.forward_axis, export_params.up_axis, IO_AXIS_Y, IO_AXIS_Z, axes_transform);
+  mul_m4_m3m4(export_mesh.transform, axes_transform, object.object_to_world);
+  /* #mul_m4_m3m4 does not transform the location. */
+  mul_v3_m3v3(export_mesh.transform[3], axes_transform, object.object_to_world[3]);
+  export_mesh.transform[3][3] = object.object_to_world[3][3];
+
+  float normal_matrix[3][3];
+  copy_m3_m4(normal_matrix, export_mesh.transform);
+  invert_m3_m3(export_mesh.normal_transform, normal_matrix);
+  transpose_m3(export_mesh.normal_transform);
+
+  rescale_m4(export_mesh.transform, float3(export_params.global_scale));
+  export_mesh.transform[3][0] *= export_params.global_scale;
+  export_mesh.transform[3][1] *= export_params.global_scale;
+  export_mesh.transform[3][2] *= export_params.global_scale;
+}
+
+/**
+ * PLY only has per-vertex UVs, so vertices are split when their face corners have different
+ * UVs. Loose vertices are kept after the vertices used by faces.
+ */
+static void split_vertices_by_uv(ExportMesh &export_mesh)
+{
+  const Mesh &mesh = *export_mesh.mesh;
+  const Span<MLoop> loops = mesh.loops();
+  Map<std::pair<int, float2>, int> vert_by_uv;
+  Array<bool> vert_used(mesh.totvert, false);
+  export_mesh.corner_verts.reinitialize(loops.size());
+  for (const int corner : loops.index_range()) {
+    const int vert = int(loops[corner].v);
+    const float2 uv = export_mesh.uv_map[corner];
+    export_mesh.corner_verts[corner] = vert_by_uv.lookup_or_add_cb({vert, uv}, [&]() {
+      export_mesh.vert_mesh_verts.append(vert);
+      export_mesh.vert_uvs.append(uv);
+      return int(export_mesh.vert_mesh_verts.size() - 1);
+    });
+    vert_used[vert] = true;
+  }
+  for (const int vert : vert_used.index_range()) {
+    if (!vert_used[vert]) {
+      export_mesh.vert_mesh_verts.append(vert);
+      export_mesh.vert_uvs.append(float2(0.0f));
+    }
+  }
+  export_mesh.verts_num = int(export_mesh.vert_mesh_verts.size());
+}
+
+static Vector<std::unique_ptr<ExportMesh>> gather_export_meshes(
+    Depsgraph *depsgraph, const PLYExportParams &export_params)
+{
+  Vector<std::unique_ptr<ExportMesh>> export_meshes;
+  DEGObjectIterSettings deg_iter_settings{};
+  deg_iter_settings.depsgraph = depsgraph;
+  deg_iter_settings.flags = DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                            DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET | DEG_ITER_OBJECT_FLAG_VISIBLE |
+                            DEG_ITER_OBJECT_FLAG_DUPLI;
+  DEG_OBJECT_ITER_BEGIN (&deg_iter_settings, object) {
+    if (object->type != OB_MESH) {
+      continue;
+    }
+    if (export_params.export_selected_objects && !(object->base_flag & BASE_SELECTED)) {
+      continue;
+    }
+    Object *obj_eval = DEG_get_evaluated_object(depsgraph, object);
+    const Mesh *mesh = export_params.apply_modifiers ? BKE_object_get_evaluated_mesh(obj_eval) :
+                                                       BKE_object_get_pre_modified_mesh(obj_eval);
+    if (mesh == nullptr) {
+      continue;
+    }
+    std::unique_ptr<ExportMesh> export_mesh = std::make_unique<ExportMesh>();
+    export_mesh->mesh = mesh;
+    export_mesh->verts_num = mesh->totvert;
+    set_world_axes_transform(*export_mesh, *obj_eval, export_params);
+
+    const bke::AttributeAccessor attributes = mesh->attributes();
+    if (export_params.export_uv) {
+      const StringRef uv_name = CustomData_get_active_layer_name(&mesh->ldata, CD_PROP_FLOAT2);
+      if (!uv_name.is_empty()) {
+        export_mesh->uv_map = attributes.lookup<float2>(uv_name, ATTR_DOMAIN_CORNER);
+      }
+    }
+    if (export_params.export_colors && mesh->active_color_attribute != nullptr) {
+      export_mesh->colors = attributes.lookup<ColorGeometry4f>(mesh->active_color_attribute,
+                                                              ATTR_DOMAIN_POINT);
+    }
+    if (!export_mesh->uv_map.is_empty()) {
+      split_vertices_by_uv(*export_mesh);
+    }
+    export_meshes.append(std::move(export_mesh));
+  }
+  DEG_OBJECT_ITER_END;
+  return export_meshes;
+}
+
+void load_plydata(PlyData &r_data, Depsgraph *depsgraph, const PLYExportParams &export_params)
+{
+  r_data = {};
+  Vector<std::unique_ptr<ExportMesh>> export_meshes = gather_export_meshes(depsgraph,
+                                                                           export_params);
+
+  int verts_num = 0;
+  int faces_num = 0;
+  int corners_num = 0;
+  bool has_uv = false;
+  bool has_colors = false;
+  for (std::unique_ptr<ExportMesh> &export_mesh : export_meshes) {
+    export_mesh->vert_offset = verts_num;
+    export_mesh->face_offset = faces_num;
+    export_mesh->corner_offset = corners_num;
+    verts_num += export_mesh->verts_num;
+    faces_num += export_mesh->mesh->totpoly;
+    corners_num += export_mesh->mesh->totloop;
+    has_uv |= !export_mesh->uv_map.is_empty();
+    has_colors |= !export_mesh->colors.is_empty();
+  }
+
+  r_data.vertices.reinitialize(verts_num);
+  if (export_params.export_normals) {
+    r_data.vertex_normals.reinitialize(verts_num);
+  }
+  if (has_uv) {
+    r_data.uv_coordinates.reinitialize(verts_num);
+  }
+  if (has_colors) {
+    r_data.vertex_colors.reinitialize(verts_num);
+  }
+  r_data.face_offsets.reinitialize(faces_num + 1);
+  r_data.face_vertices.reinitialize(corners_num);
+  r_data.face_offsets.last() = corners_num;
+
+  for (const std::unique_ptr<ExportMesh> &export_mesh_ptr : export_meshes) {
+    const ExportMesh &export_mesh = *export_mesh_ptr;
+    const Mesh &mesh = *export_mesh.mesh;
+    const Span<float3> positions = mesh.vert_positions();
+    const Span<MPoly> polys = mesh.polys();
+    const Span<MLoop> loops = mesh.loops();
+    const bool is_split = !export_mesh.corner_verts.is_empty();
+    const float(*vert_normals)[3] = export_params.export_normals ?
+                                        BKE_mesh_vertex_normals_ensure(&mesh) :
+                                        nullptr;
+
+    const IndexRange verts_range(export_mesh.vert_offset, export_mesh.verts_num);
+    threading::parallel_for(IndexRange(export_mesh.verts_num), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const int vert = is_split ? export_mesh.vert_mesh_verts[i] : i;
+        const int ply_vert = verts_range[i];
+        mul_v3_m4v3(r_data.vertices[ply_vert], export_mesh.transform, positions[vert]);
+        if (vert_normals) {
+          float3 normal;
+          mul_v3_m3v3(normal, export_mesh.normal_transform, vert_normals[vert]);
+          normalize_v3(normal);
+          r_data.vertex_normals[ply_vert] = normal;
+        }
+        if (has_uv) {
+          r_data.uv_coordinates[ply_vert] = is_split ? export_mesh.vert_uvs[i] : float2(0.0f);
+        }
+        if (has_colors) {
+          r_data.vertex_colors[ply_vert] = export_mesh.colors.is_empty() ?
+                                               ColorGeometry4b(255, 255, 255, 255) :
+                                               export_mesh.colors[vert].encode();
+        }
+      }
+    });
+
+    threading::parallel_for(polys.index_range(), 2048, [&](const IndexRange range) {
+      for (const int poly_i : range) {
+        const MPoly &poly = polys[poly_i];
+        const int corner_start = export_mesh.corner_offset + poly.loopstart;
+        r_data.face_offsets[export_mesh.face_offset + poly_i] = corner_start;
+        for (const int corner : IndexRange(poly.loopstart, poly.totloop)) {
+          const int vert = is_split ? export_mesh.corner_verts[corner] : int(loops[corner].v);
+          r_data.face_vertices[export_mesh.corner_offset + corner] = export_mesh.vert_offset +
+                                                                     vert;
+        }
+      }
+    });
+  }
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,23 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "IO_ply.h"
+
+#include "ply_data.hh"
+
+struct Depsgraph;
+
+namespace blender::io::ply {
+
+/**
+ * Gather the evaluated meshes of all exported objects into one set of PLY elements, in world
+ * space with the axis conversion and scale of the export settings applied.
+ */
+void load_plydata(PlyData &r_data, Depsgraph *depsgraph, const PLYExportParams &export_params);
+
+}  // namespace blender::io::ply
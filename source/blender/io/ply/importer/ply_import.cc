@@ -0,0 +1,167 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <cstdio>
+#include <fcntl.h>
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "BKE_collection.h"
+#include "BKE_layer.h"
+#include "BKE_lib_id.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+#include "BKE_pointcloud.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
+#include "DNA_scene_types.h"
+
+#include "BLI_fileops.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_mmap.h"
+#include "BLI_string.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "ply_import.hh"
+#include "ply_import_data.hh"
+#include "ply_import_mesh.hh"
+
+namespace blender::io::ply {
+
+/**
+ * Read the file into `r_data`. The file is memory mapped so that binary data is decoded without
+ * copying it first, with a fallback to reading it into memory when mapping is not possible.
+ */
+static bool read_ply_file(const char *filepath, PlyData &r_data, std::string &r_error)
+{
+  const int file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    r_error = "Failed to open file";
+    return false;
+  }
+  size_t buffer_size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  close(file);
+
+  const char *buffer = nullptr;
+  void *file_mem = nullptr;
+  if (mmap_file) {
+    buffer = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+  }
+  else {
+    file_mem = BLI_file_read_binary_as_mem(filepath, 0, &buffer_size);
+    buffer = static_cast<const char *>(file_mem);
+  }
+
+  bool success = false;
+  if (buffer == nullptr) {
+    r_error = "Failed to read file";
+  }
+  else {
+    const Span<char> span(buffer, int64_t(buffer_size));
+    PlyHeader header;
+    success = parse_ply_header(span, header, r_error) &&
+              import_ply_data(span, header, r_data, r_error);
+  }
+
+  if (mmap_file) {
+    BLI_mmap_free(mmap_file);
+  }
+  MEM_SAFE_FREE(file_mem);
+  return success;
+}
+
+void importer_main(bContext *C, const PLYImportParams &import_params)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+  importer_main(bmain, scene, view_layer, import_params);
+}
+
+void importer_main(Main *bmain,
+                   Scene *scene,
+                   ViewLayer *view_layer,
+                   const PLYImportParams &import_params)
+{
+  PlyData data;
+  std::string error;
+  if (!read_ply_file(import_params.filepath, data, error)) {
+    fprintf(stderr,
+            "PLY Importer: failed to import '%s': %s.\n",
+            import_params.filepath,
+            error.c_str());
+    return;
+  }
+
+  /* Name used for both the data and the object. */
+  char ob_name[FILE_MAX];
+  BLI_strncpy(ob_name, BLI_path_basename(import_params.filepath), FILE_MAX);
+  BLI_path_extension_replace(ob_name, FILE_MAX, "");
+
+  Object *obj = nullptr;
+  if (import_params.use_point_cloud && data.faces_num() == 0 && data.edges.is_empty()) {
+    PointCloud *pointcloud = convert_ply_to_point_cloud(data);
+    obj = BKE_object_add_only_object(bmain, OB_POINTCLOUD, ob_name);
+    obj->data = BKE_pointcloud_add(bmain, ob_name);
+    BKE_pointcloud_nomain_to_pointcloud(pointcloud, static_cast<PointCloud *>(obj->data), true);
+  }
+  else {
+    Mesh *mesh = convert_ply_to_mesh(data);
+    if (import_params.use_mesh_validate) {
+      bool verbose_validate = false;
+#ifdef DEBUG
+      verbose_validate = true;
+#endif
+      BKE_mesh_validate(mesh, verbose_validate, false);
+    }
+    obj = BKE_object_add_only_object(bmain, OB_MESH, ob_name);
+    obj->data = BKE_object_obdata_add_from_type(bmain, OB_MESH, ob_name);
+    BKE_mesh_nomain_to_mesh(mesh, static_cast<Mesh *>(obj->data), obj);
+  }
+
+  BKE_view_layer_base_deselect_all(scene, view_layer);
+  LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+  BKE_collection_object_add(bmain, lc->collection, obj);
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  Base *base = BKE_view_layer_base_find(view_layer, obj);
+  BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+  float global_scale = import_params.global_scale;
+  if ((scene->unit.system != USER_UNIT_NONE) && import_params.use_scene_unit) {
+    global_scale *= scene->unit.scale_length;
+  }
+  float scale_vec[3] = {global_scale, global_scale, global_scale};
+  float obmat3x3[3][3];
+  unit_m3(obmat3x3);
+  float obmat4x4[4][4];
+  unit_m4(obmat4x4);
+  /* +Y-forward and +Z-up are the Blender's default axis settings. */
+  mat3_from_axis_conversion(
+      IO_AXIS_Y, IO_AXIS_Z, import_params.forward_axis, import_params.up_axis, obmat3x3);
+  copy_m4_m3(obmat4x4, obmat3x3);
+  rescale_m4(obmat4x4, scale_vec);
+  BKE_object_apply_mat4(obj, obmat4x4, true, false);
+
+  DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+  int flags = ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION |
+              ID_RECALC_BASE_FLAGS;
+  DEG_id_tag_update_ex(bmain, &obj->id, flags);
+  DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+  DEG_relations_tag_update(bmain);
+}
+
+}  // namespace blender::io::ply
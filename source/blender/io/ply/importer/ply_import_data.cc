@@ -0,0 +1,883 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <climits>
+#include <cstring>
+
+#include "BLI_endian_defines.h"
+#include "BLI_math_base.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_set.hh"
+#include "BLI_task.hh"
+#include "BLI_utildefines.h"
+
+/* NOTE: `std::from_chars` for floats is not available in all supported standard libraries yet,
+ * see the STL importer. */
+#include "fast_float.h"
+
+#include "ply_import_data.hh"
+
+namespace blender::io::ply {
+
+/* -------------------------------------------------------------------- */
+/** \name Header
+ * \{ */
+
+/** Return the line starting at `pos` without line endings and move `pos` to the next line. */
+static StringRef next_line(const Span<char> buffer, int64_t &pos)
+{
+  const char *begin = buffer.data() + pos;
+  const char *end = buffer.data() + buffer.size();
+  const char *line_end = static_cast<const char *>(memchr(begin, '\n', size_t(end - begin)));
+  if (line_end == nullptr) {
+    pos = buffer.size();
+    return StringRef(begin, end).trim();
+  }
+  pos += line_end - begin + 1;
+  return StringRef(begin, line_end).trim();
+}
+
+static Vector<StringRef> split_words(const StringRef line)
+{
+  Vector<StringRef> words;
+  int64_t pos = 0;
+  while (pos < line.size()) {
+    while (pos < line.size() && line[pos] <= ' ') {
+      pos++;
+    }
+    const int64_t word_start = pos;
+    while (pos < line.size() && line[pos] > ' ') {
+      pos++;
+    }
+    if (pos > word_start) {
+      words.append(line.substr(word_start, pos - word_start));
+    }
+  }
+  return words;
+}
+
+bool parse_ply_header(const Span<char> buffer, PlyHeader &r_header, std::string &r_error)
+{
+  r_header = {};
+  int64_t pos = 0;
+  if (next_line(buffer, pos) != "ply") {
+    r_error = "Not a PLY file";
+    return false;
+  }
+
+  bool has_format = false;
+  while (true) {
+    if (pos >= buffer.size()) {
+      r_error = "Unexpected end of header";
+      return false;
+    }
+    const Vector<StringRef> words = split_words(next_line(buffer, pos));
+    if (words.is_empty() || ELEM(words[0], "comment", "obj_info")) {
+      continue;
+    }
+    const StringRef keyword = words[0];
+    if (keyword == "end_header") {
+      break;
+    }
+    if (keyword == "format") {
+      if (words.size() < 2) {
+        r_error = "Invalid format declaration";
+        return false;
+      }
+      if (words[1] == "ascii") {
+        r_header.type = PLY_ASCII;
+      }
+      else if (words[1] == "binary_little_endian") {
+        r_header.type = PLY_BINARY_LE;
+      }
+      else if (words[1] == "binary_big_endian") {
+        r_header.type = PLY_BINARY_BE;
+      }
+      else {
+        r_error = "Unsupported format \"" + std::string(words[1]) + "\"";
+        return false;
+      }
+      has_format = true;
+    }
+    else if (keyword == "element") {
+      PlyElementHeader element;
+      if (words.size() != 3 ||
+          std::from_chars(words[2].begin(), words[2].end(), element.count).ec != std::errc() ||
+          element.count < 0) {
+        r_error = "Invalid element declaration";
+        return false;
+      }
+      element.name = words[1];
+      r_header.elements.append(std::move(element));
+    }
+    else if (keyword == "property") {
+      if (r_header.elements.is_empty()) {
+        r_error = "Property declared before any element";
+        return false;
+      }
+      PlyProperty property;
+      if (words.size() == 5 && words[1] == "list") {
+        property.count_type = ply_data_type_from_string(words[2]);
+        property.type = ply_data_type_from_string(words[3]);
+        property.name = words[4];
+        if (property.count_type == PLY_NONE || ply_data_type_is_float(property.count_type)) {
+          r_error = "Invalid list count type of property \"" + property.name + "\"";
+          return false;
+        }
+      }
+      else if (words.size() == 3) {
+        property.type = ply_data_type_from_string(words[1]);
+        property.name = words[2];
+      }
+      else {
+        r_error = "Invalid property declaration";
+        return false;
+      }
+      if (property.type == PLY_NONE) {
+        r_error = "Unknown type of property \"" + property.name + "\"";
+        return false;
+      }
+      r_header.elements.last().properties.append(std::move(property));
+    }
+    /* Unknown keywords are ignored, like most other PLY readers do. */
+  }
+
+  if (!has_format) {
+    r_error = "Missing format declaration";
+    return false;
+  }
+  r_header.header_size = pos;
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Element Readers
+ *
+ * Every element of the file gets a reader that knows where the value of each property goes.
+ * Values are decoded as doubles, which represent all PLY types exactly.
+ * \{ */
+
+enum class PropertyTarget : int8_t {
+  Skip,
+  PositionX,
+  PositionY,
+  PositionZ,
+  NormalX,
+  NormalY,
+  NormalZ,
+  ColorR,
+  ColorG,
+  ColorB,
+  ColorA,
+  UvU,
+  UvV,
+  EdgeV1,
+  EdgeV2,
+  FaceVertices,
+  Custom,
+};
+
+struct PropertyReader {
+  const PlyProperty *property;
+  PropertyTarget target;
+  int custom_index = -1;
+};
+
+struct ElementReader {
+  const PlyElementHeader *header = nullptr;
+  Vector<PropertyReader> properties;
+
+  MutableSpan<float3> positions;
+  MutableSpan<float3> normals;
+  MutableSpan<ColorGeometry4b> colors;
+  MutableSpan<float2> uvs;
+  MutableSpan<int2> edges;
+  Vector<MutableSpan<float>> custom_attributes;
+  bool has_face_vertices = false;
+};
+
+static PropertyTarget vertex_property_target(const StringRef name)
+{
+  if (name == "x") {
+    return PropertyTarget::PositionX;
+  }
+  if (name == "y") {
+    return PropertyTarget::PositionY;
+  }
+  if (name == "z") {
+    return PropertyTarget::PositionZ;
+  }
+  if (name == "nx") {
+    return PropertyTarget::NormalX;
+  }
+  if (name == "ny") {
+    return PropertyTarget::NormalY;
+  }
+  if (name == "nz") {
+    return PropertyTarget::NormalZ;
+  }
+  if (ELEM(name, "red", "diffuse_red")) {
+    return PropertyTarget::ColorR;
+  }
+  if (ELEM(name, "green", "diffuse_green")) {
+    return PropertyTarget::ColorG;
+  }
+  if (ELEM(name, "blue", "diffuse_blue")) {
+    return PropertyTarget::ColorB;
+  }
+  if (ELEM(name, "alpha", "diffuse_alpha")) {
+    return PropertyTarget::ColorA;
+  }
+  if (ELEM(name, "s", "u", "texture_s", "texture_u")) {
+    return PropertyTarget::UvU;
+  }
+  if (ELEM(name, "t", "v", "texture_t", "texture_v")) {
+    return PropertyTarget::UvV;
+  }
+  return PropertyTarget::Custom;
+}
+
+static bool has_target(const ElementReader &reader, const PropertyTarget first, const int num)
+{
+  for (const PropertyReader &property : reader.properties) {
+    if (property.target >= first && int(property.target) < int(first) + num) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Create the reader of an element and allocate the arrays in `r_data` it writes to.
+ * Only the first vertex, face and edge elements are read, all others are skipped.
+ */
+static ElementReader create_element_reader(const PlyElementHeader &element,
+                                           const bool is_first_of_name,
+                                           PlyData &r_data)
+{
+  ElementReader reader;
+  reader.header = &element;
+  const bool is_vertex = is_first_of_name && element.name == "vertex";
+  const bool is_face = is_first_of_name && element.name == "face";
+  const bool is_edge = is_first_of_name && element.name == "edge";
+  Vector<PlyCustomAttribute> *custom_attributes = is_vertex ? &r_data.vertex_custom_attributes :
+                                                  is_face   ? &r_data.face_custom_attributes :
+                                                              nullptr;
+
+  for (const PlyProperty &property : element.properties) {
+    PropertyReader property_reader{&property, PropertyTarget::Skip};
+    const bool is_list = property.count_type != PLY_NONE;
+    if (is_vertex && !is_list) {
+      property_reader.target = vertex_property_target(property.name);
+    }
+    else if (is_face && is_list && ELEM(property.name, "vertex_indices", "vertex_index") &&
+             !reader.has_face_vertices) {
+      property_reader.target = PropertyTarget::FaceVertices;
+      reader.has_face_vertices = true;
+    }
+    else if (is_face && !is_list) {
+      property_reader.target = PropertyTarget::Custom;
+    }
+    else if (is_edge && property.name == "vertex1" && !is_list) {
+      property_reader.target = PropertyTarget::EdgeV1;
+    }
+    else if (is_edge && property.name == "vertex2" && !is_list) {
+      property_reader.target = PropertyTarget::EdgeV2;
+    }
+
+    if (property_reader.target == PropertyTarget::Custom) {
+      property_reader.custom_index = int(custom_attributes->size());
+      custom_attributes->append({property.name, Array<float>(element.count)});
+    }
+    reader.properties.append(property_reader);
+  }
+
+  if (custom_attributes) {
+    for (PlyCustomAttribute &attribute : *custom_attributes) {
+      reader.custom_attributes.append(attribute.data);
+    }
+  }
+  if (is_vertex) {
+    r_data.vertices.reinitialize(element.count);
+    reader.positions = r_data.vertices;
+    if (has_target(reader, PropertyTarget::NormalX, 3)) {
+      r_data.vertex_normals.reinitialize(element.count);
+      reader.normals = r_data.vertex_normals;
+    }
+    if (has_target(reader, PropertyTarget::ColorR, 4)) {
+      r_data.vertex_colors.reinitialize(element.count);
+      reader.colors = r_data.vertex_colors;
+    }
+    if (has_target(reader, PropertyTarget::UvU, 2)) {
+      r_data.uv_coordinates.reinitialize(element.count);
+      reader.uvs = r_data.uv_coordinates;
+    }
+  }
+  if (is_face && reader.has_face_vertices) {
+    /* Filled with the face sizes first, then turned into offsets. */
+    r_data.face_offsets.reinitialize(element.count + 1);
+  }
+  if (is_edge && has_target(reader, PropertyTarget::EdgeV1, 2)) {
+    r_data.edges.reinitialize(element.count);
+    reader.edges = r_data.edges;
+  }
+  return reader;
+}
+
+/** Out of range indices become -1, so that they are caught by the validation after reading. */
+static int vertex_index_from_value(const double value)
+{
+  return (value >= 0.0 && value <= double(INT_MAX)) ? int(value) : -1;
+}
+
+static uchar color_value_to_uchar(const double value, const PlyDataTypes type)
+{
+  if (ply_data_type_is_float(type)) {
+    return unit_float_to_uchar_clamp(float(value));
+  }
+  return uchar(std::clamp(value, 0.0, 255.0));
+}
+
+/**
+ * Decode the item with index `item` of the reader's element from `source`. For the face vertex
+ * list, `begin_face(item, size)` returns where to write its indices.
+ */
+template<typename Source, typename BeginFaceFn>
+static void read_item(Source &source,
+                      const ElementReader &reader,
+                      const int64_t item,
+                      const BeginFaceFn &begin_face)
+{
+  if (!reader.positions.is_empty()) {
+    reader.positions[item] = float3(0.0f);
+  }
+  if (!reader.normals.is_empty()) {
+    reader.normals[item] = float3(0.0f);
+  }
+  if (!reader.colors.is_empty()) {
+    reader.colors[item] = ColorGeometry4b(0, 0, 0, 255);
+  }
+  if (!reader.uvs.is_empty()) {
+    reader.uvs[item] = float2(0.0f);
+  }
+  if (!reader.edges.is_empty()) {
+    reader.edges[item] = int2(0);
+  }
+
+  for (const PropertyReader &property_reader : reader.properties) {
+    const PlyProperty &property = *property_reader.property;
+    if (property.count_type != PLY_NONE) {
+      const double count = source.read(property.count_type);
+      if (count < 0.0 || count > double(INT_MAX)) {
+        source.failed = true;
+        return;
+      }
+      const int size = int(count);
+      if (property_reader.target == PropertyTarget::FaceVertices) {
+        int *face_vertices = begin_face(item, size);
+        for (int i = 0; i < size; i++) {
+          face_vertices[i] = vertex_index_from_value(source.read(property.type));
+        }
+      }
+      else {
+        for (int i = 0; i < size; i++) {
+          source.read(property.type);
+        }
+      }
+      continue;
+    }
+
+    const double value = source.read(property.type);
+    switch (property_reader.target) {
+      case PropertyTarget::Skip:
+      case PropertyTarget::FaceVertices:
+        break;
+      case PropertyTarget::PositionX:
+      case PropertyTarget::PositionY:
+      case PropertyTarget::PositionZ:
+        reader.positions[item][int(property_reader.target) - int(PropertyTarget::PositionX)] =
+            float(value);
+        break;
+      case PropertyTarget::NormalX:
+      case PropertyTarget::NormalY:
+      case PropertyTarget::NormalZ:
+        reader.normals[item][int(property_reader.target) - int(PropertyTarget::NormalX)] = float(
+            value);
+        break;
+      case PropertyTarget::ColorR:
+        reader.colors[item].r = color_value_to_uchar(value, property.type);
+        break;
+      case PropertyTarget::ColorG:
+        reader.colors[item].g = color_value_to_uchar(value, property.type);
+        break;
+      case PropertyTarget::ColorB:
+        reader.colors[item].b = color_value_to_uchar(value, property.type);
+        break;
+      case PropertyTarget::ColorA:
+        reader.colors[item].a = color_value_to_uchar(value, property.type);
+        break;
+      case PropertyTarget::UvU:
+        reader.uvs[item].x = float(value);
+        break;
+      case PropertyTarget::UvV:
+        reader.uvs[item].y = float(value);
+        break;
+      case PropertyTarget::EdgeV1:
+        reader.edges[item][0] = vertex_index_from_value(value);
+        break;
+      case PropertyTarget::EdgeV2:
+        reader.edges[item][1] = vertex_index_from_value(value);
+        break;
+      case PropertyTarget::Custom:
+        reader.custom_attributes[property_reader.custom_index][item] = float(value);
+        break;
+    }
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Binary Data
+ * \{ */
+
+template<typename T> static T load_unaligned(const char *ptr)
+{
+  T value;
+  memcpy(&value, ptr, sizeof(T));
+  return value;
+}
+
+static double decode_binary_value(const char *ptr, const PlyDataTypes type, const bool swap)
+{
+  char swapped[8];
+  if (swap) {
+    const int size = ply_data_type_size(type);
+    for (int i = 0; i < size; i++) {
+      swapped[i] = ptr[size - 1 - i];
+    }
+    ptr = swapped;
+  }
+  switch (type) {
+    case PLY_CHAR:
+      return load_unaligned<int8_t>(ptr);
+    case PLY_UCHAR:
+      return load_unaligned<uint8_t>(ptr);
+    case PLY_SHORT:
+      return load_unaligned<int16_t>(ptr);
+    case PLY_USHORT:
+      return load_unaligned<uint16_t>(ptr);
+    case PLY_INT:
+      return load_unaligned<int32_t>(ptr);
+    case PLY_UINT:
+      return load_unaligned<uint32_t>(ptr);
+    case PLY_FLOAT:
+      return load_unaligned<float>(ptr);
+    case PLY_DOUBLE:
+      return load_unaligned<double>(ptr);
+    case PLY_NONE:
+      break;
+  }
+  return 0.0;
+}
+
+struct BinaryValueSource {
+  const char *ptr;
+  const char *end;
+  bool swap;
+  bool failed = false;
+
+  double read(const PlyDataTypes type)
+  {
+    const int size = ply_data_type_size(type);
+    if (end - ptr < size) {
+      failed = true;
+      return 0.0;
+    }
+    const double value = decode_binary_value(ptr, type, swap);
+    ptr += size;
+    return value;
+  }
+};
+
+/** Number of items decoded by one task for elements with list properties. */
+static constexpr int64_t binary_block_size = 4096;
+
+/**
+ * Read the items of one element starting at `pos`, and move `pos` past them.
+ *
+ * Items without list properties have a fixed size and are decoded in parallel right away. With
+ * lists, one serial pass only reads the list sizes to find the start of every block of items
+ * and the face offsets, then the blocks are decoded in parallel.
+ */
+static bool read_binary_element(const Span<char> buffer,
+                                const bool swap,
+                                const ElementReader &reader,
+                                int64_t &pos,
+                                PlyData &r_data,
+                                std::string &r_error)
+{
+  const PlyElementHeader &element = *reader.header;
+  const char *end = buffer.data() + buffer.size();
+  std::atomic<bool> failed = false;
+
+  const int64_t stride = element.binary_stride();
+  if (stride >= 0) {
+    if ((buffer.size() - pos) / std::max<int64_t>(stride, 1) < element.count) {
+      r_error = "Unexpected end of file in element \"" + element.name + "\"";
+      return false;
+    }
+    const char *data = buffer.data() + pos;
+    threading::parallel_for(IndexRange(element.count), 8192, [&](const IndexRange range) {
+      for (const int64_t item : range) {
+        BinaryValueSource source{data + item * stride, end, swap};
+        read_item(source, reader, item, [](int64_t /*item*/, int /*size*/) -> int * {
+          BLI_assert_unreachable();
+          return nullptr;
+        });
+      }
+    });
+    pos += element.count * stride;
+    return true;
+  }
+
+  MutableSpan<int> face_offsets = r_data.face_offsets;
+  Vector<int64_t> block_starts;
+  int64_t corners_num = 0;
+  for (const int64_t item : IndexRange(element.count)) {
+    if (item % binary_block_size == 0) {
+      block_starts.append(pos);
+    }
+    for (const PropertyReader &property_reader : reader.properties) {
+      const PlyProperty &property = *property_reader.property;
+      int64_t size = ply_data_type_size(property.type);
+      if (property.count_type != PLY_NONE) {
+        const int count_size = ply_data_type_size(property.count_type);
+        if (end - (buffer.data() + pos) < count_size) {
+          r_error = "Unexpected end of file in element \"" + element.name + "\"";
+          return false;
+        }
+        const double count = decode_binary_value(buffer.data() + pos, property.count_type, swap);
+        if (count < 0.0 || count > double(INT_MAX)) {
+          r_error = "Invalid list size in element \"" + element.name + "\"";
+          return false;
+        }
+        if (property_reader.target == PropertyTarget::FaceVertices) {
+          face_offsets[item] = int(count);
+          corners_num += int64_t(count);
+        }
+        size = count_size + size * int64_t(count);
+      }
+      if (buffer.size() - pos < size) {
+        r_error = "Unexpected end of file in element \"" + element.name + "\"";
+        return false;
+      }
+      pos += size;
+    }
+  }
+
+  if (reader.has_face_vertices) {
+    if (corners_num > INT_MAX) {
+      r_error = "Too many face corners";
+      return false;
+    }
+    offset_indices::accumulate_counts_to_offsets(face_offsets);
+    r_data.face_vertices.reinitialize(corners_num);
+  }
+  MutableSpan<int> face_vertices = r_data.face_vertices;
+
+  threading::parallel_for(block_starts.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t block : range) {
+      BinaryValueSource source{buffer.data() + block_starts[block], end, swap};
+      const IndexRange items = IndexRange(element.count)
+                                   .slice(block * binary_block_size,
+                                          std::min(binary_block_size,
+                                                   element.count - block * binary_block_size));
+      for (const int64_t item : items) {
+        read_item(source, reader, item, [&](const int64_t item, const int /*size*/) {
+          return face_vertices.data() + face_offsets[item];
+        });
+      }
+      if (source.failed) {
+        failed = true;
+      }
+    }
+  });
+  if (failed) {
+    r_error = "Invalid data in element \"" + element.name + "\"";
+    return false;
+  }
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name ASCII Data
+ * \{ */
+
+struct AsciiValueSource {
+  const char *ptr;
+  const char *end;
+  bool failed = false;
+
+  double read(const PlyDataTypes /*type*/)
+  {
+    while (ptr < end && ELEM(*ptr, ' ', '\t', '\r')) {
+      ptr++;
+    }
+    /* Skip '+', which is not handled by the float parser. */
+    if (ptr < end && *ptr == '+') {
+      ptr++;
+    }
+    double value = 0.0;
+    const fast_float::from_chars_result result = fast_float::from_chars(ptr, end, value);
+    if (result.ec != std::errc()) {
+      failed = true;
+      return 0.0;
+    }
+    ptr = result.ptr;
+    return value;
+  }
+};
+
+/** Lines are split into chunks of this many bytes, which are parsed in parallel. */
+static constexpr int64_t ascii_chunk_size = 256 * 1024;
+
+struct AsciiChunk {
+  const char *begin;
+  const char *end;
+  int64_t lines_num = 0;
+  int64_t first_line = 0;
+  /** Index of the first face item in this chunk and the vertices of its faces. */
+  int64_t first_face = -1;
+  Vector<int> face_vertices;
+  bool failed = false;
+};
+
+static bool is_blank_line(const char *begin, const char *end)
+{
+  for (const char *ptr = begin; ptr < end; ptr++) {
+    if (*ptr > ' ') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Call `fn(line_begin, line_end)` for every non-blank line that starts within the chunk, lines
+ * may end after the end of the chunk. Stops early when `fn` returns false.
+ */
+template<typename Fn>
+static void foreach_chunk_line(const Span<char> buffer, const AsciiChunk &chunk, const Fn &fn)
+{
+  const char *buffer_end = buffer.data() + buffer.size();
+  const char *ptr = chunk.begin;
+  if (ptr != buffer.data() && ptr[-1] != '\n') {
+    ptr = static_cast<const char *>(memchr(ptr, '\n', size_t(buffer_end - ptr)));
+    if (ptr == nullptr) {
+      return;
+    }
+    ptr++;
+  }
+  while (ptr < chunk.end) {
+    const char *line_end = static_cast<const char *>(
+        memchr(ptr, '\n', size_t(buffer_end - ptr)));
+    if (line_end == nullptr) {
+      line_end = buffer_end;
+    }
+    if (!is_blank_line(ptr, line_end)) {
+      if (!fn(ptr, line_end)) {
+        return;
+      }
+    }
+    ptr = line_end + 1;
+  }
+}
+
+/**
+ * Read all elements, with one item per line. The lines of every chunk are counted in parallel
+ * to know which items the chunk contains, then the chunks are parsed in parallel. Face vertices
+ * are gathered per chunk and copied into place once the face offsets are known.
+ */
+static bool read_ascii_elements(const Span<char> data,
+                                const Span<ElementReader> readers,
+                                PlyData &r_data,
+                                std::string &r_error)
+{
+  Array<int64_t> element_first_lines(readers.size() + 1);
+  element_first_lines[0] = 0;
+  for (const int i : readers.index_range()) {
+    element_first_lines[i + 1] = element_first_lines[i] + readers[i].header->count;
+  }
+  const int64_t total_lines = element_first_lines.last();
+
+  const int64_t chunks_num = std::max<int64_t>(
+      (data.size() + ascii_chunk_size - 1) / ascii_chunk_size, 1);
+  Array<AsciiChunk> chunks(chunks_num);
+  threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      AsciiChunk &chunk = chunks[i];
+      const int64_t begin = std::min(i * ascii_chunk_size, data.size());
+      chunk.begin = data.data() + begin;
+      chunk.end = data.data() + std::min(begin + ascii_chunk_size, data.size());
+      foreach_chunk_line(data, chunk, [&](const char * /*begin*/, const char * /*end*/) {
+        chunk.lines_num++;
+        return true;
+      });
+    }
+  });
+  int64_t lines_num = 0;
+  for (AsciiChunk &chunk : chunks) {
+    chunk.first_line = lines_num;
+    lines_num += chunk.lines_num;
+  }
+  if (lines_num < total_lines) {
+    r_error = "Unexpected end of file";
+    return false;
+  }
+
+  MutableSpan<int> face_offsets = r_data.face_offsets;
+  threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      AsciiChunk &chunk = chunks[i];
+      if (chunk.first_line >= total_lines) {
+        continue;
+      }
+      int64_t line = chunk.first_line;
+      int element = 0;
+      foreach_chunk_line(data, chunk, [&](const char *begin, const char *end) {
+        if (line >= total_lines) {
+          return false;
+        }
+        while (line >= element_first_lines[element + 1]) {
+          element++;
+        }
+        const ElementReader &reader = readers[element];
+        const int64_t item = line - element_first_lines[element];
+        AsciiValueSource source{begin, end};
+        read_item(source, reader, item, [&](const int64_t item, const int size) {
+          if (chunk.first_face == -1) {
+            chunk.first_face = item;
+          }
+          face_offsets[item] = size;
+          const int64_t start = chunk.face_vertices.size();
+          chunk.face_vertices.resize(start + size);
+          return chunk.face_vertices.data() + start;
+        });
+        chunk.failed |= source.failed;
+        line++;
+        return true;
+      });
+    }
+  });
+
+  int64_t corners_num = 0;
+  for (const AsciiChunk &chunk : chunks) {
+    if (chunk.failed) {
+      r_error = "Invalid value in ASCII data";
+      return false;
+    }
+    corners_num += chunk.face_vertices.size();
+  }
+  if (face_offsets.is_empty()) {
+    return true;
+  }
+  if (corners_num > INT_MAX) {
+    r_error = "Too many face corners";
+    return false;
+  }
+  offset_indices::accumulate_counts_to_offsets(face_offsets);
+  r_data.face_vertices.reinitialize(corners_num);
+  MutableSpan<int> face_vertices = r_data.face_vertices;
+  threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const AsciiChunk &chunk = chunks[i];
+      if (chunk.first_face != -1) {
+        face_vertices.slice(face_offsets[chunk.first_face], chunk.face_vertices.size())
+            .copy_from(chunk.face_vertices);
+      }
+    }
+  });
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Data
+ * \{ */
+
+static bool vertex_indices_are_valid(const Span<int> indices, const int verts_num)
+{
+  return threading::parallel_reduce(
+      indices.index_range(),
+      8192,
+      true,
+      [&](const IndexRange range, const bool valid) {
+        if (!valid) {
+          return false;
+        }
+        for (const int index : indices.slice(range)) {
+          if (index < 0 || index >= verts_num) {
+            return false;
+          }
+        }
+        return true;
+      },
+      [](const bool a, const bool b) { return a && b; });
+}
+
+bool import_ply_data(const Span<char> buffer,
+                     const PlyHeader &header,
+                     PlyData &r_data,
+                     std::string &r_error)
+{
+  r_data = {};
+  Vector<ElementReader> readers;
+  Set<StringRef> element_names;
+  for (const PlyElementHeader &element : header.elements) {
+    if (ELEM(element.name, "vertex", "face", "edge") && element.count > INT_MAX) {
+      r_error = "Too many items in element \"" + element.name + "\"";
+      return false;
+    }
+    readers.append(create_element_reader(element, element_names.add(element.name), r_data));
+  }
+
+  const Span<char> data = buffer.drop_front(std::min(header.header_size, buffer.size()));
+  if (header.type == PLY_ASCII) {
+    if (!read_ascii_elements(data, readers, r_data, r_error)) {
+      return false;
+    }
+  }
+  else {
+    const bool swap = (header.type == PLY_BINARY_BE) != (ENDIAN_ORDER == B_ENDIAN);
+    int64_t pos = 0;
+    for (const ElementReader &reader : readers) {
+      if (!read_binary_element(data, swap, reader, pos, r_data, r_error)) {
+        return false;
+      }
+    }
+  }
+
+  const int verts_num = int(r_data.vertices.size());
+  if (!vertex_indices_are_valid(r_data.face_vertices, verts_num) ||
+      !vertex_indices_are_valid(r_data.edges.as_span().cast<int>(), verts_num)) {
+    r_error = "Vertex index out of range";
+    return false;
+  }
+  return true;
+}
+
+/** \} */
+
+}  // namespace blender::io::ply
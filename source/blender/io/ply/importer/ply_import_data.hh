@@ -0,0 +1,36 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include <string>
+
+#include "BLI_span.hh"
+
+#include "ply_data.hh"
+
+namespace blender::io::ply {
+
+/**
+ * Parse the header at the start of `buffer`.
+ * \return False when the buffer does not start with a valid PLY header, with a message in
+ * `r_error`.
+ */
+bool parse_ply_header(Span<char> buffer, PlyHeader &r_header, std::string &r_error);
+
+/**
+ * Read the elements following the header into `r_data`. Vertex, face and edge elements are
+ * recognized, other elements are skipped. Binary data is decoded straight from `buffer`, which is
+ * usually the memory-mapped file, and ASCII data is split into chunks of lines that are parsed in
+ * parallel.
+ * \return False when the data is truncated or invalid, with a message in `r_error`.
+ */
+bool import_ply_data(Span<char> buffer,
+                     const PlyHeader &header,
+                     PlyData &r_data,
+                     std::string &r_error);
+
+}  // namespace blender::io::ply
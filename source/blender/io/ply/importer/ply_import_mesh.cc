@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include "BKE_attribute.h"
+#include "BKE_attribute.hh"
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+#include "BKE_pointcloud.h"
+
+#include "BLI_array_utils.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "ply_import_mesh.hh"
+
+namespace blender::io::ply {
+
+/** Name of the color attribute, the same as used by the Python add-on. */
+static const char *color_attribute_name = "Col";
+
+/**
+ * Add float attributes for properties without a built-in meaning. When `indices` is not empty,
+ * only the items at these indices are used, otherwise the attribute has the size of the data.
+ */
+static void add_custom_attributes(bke::MutableAttributeAccessor attributes,
+                                  const Span<PlyCustomAttribute> custom_attributes,
+                                  const eAttrDomain domain,
+                                  const Span<int> indices)
+{
+  for (const PlyCustomAttribute &custom_attribute : custom_attributes) {
+    if (attributes.contains(custom_attribute.name)) {
+      continue;
+    }
+    bke::SpanAttributeWriter<float> attribute =
+        attributes.lookup_or_add_for_write_only_span<float>(custom_attribute.name, domain);
+    if (!attribute) {
+      continue;
+    }
+    if (indices.is_empty()) {
+      attribute.span.copy_from(custom_attribute.data);
+    }
+    else {
+      array_utils::gather(custom_attribute.data.as_span(), indices, attribute.span);
+    }
+    attribute.finish();
+  }
+}
+
+static void add_vertex_colors(ID &id,
+                              bke::MutableAttributeAccessor attributes,
+                              const PlyData &data)
+{
+  if (data.vertex_colors.is_empty()) {
+    return;
+  }
+  bke::SpanAttributeWriter<ColorGeometry4b> colors =
+      attributes.lookup_or_add_for_write_only_span<ColorGeometry4b>(color_attribute_name,
+                                                                    ATTR_DOMAIN_POINT);
+  colors.span.copy_from(data.vertex_colors);
+  colors.finish();
+  BKE_id_attributes_active_color_set(&id, color_attribute_name);
+  BKE_id_attributes_default_color_set(&id, color_attribute_name);
+}
+
+Mesh *convert_ply_to_mesh(const PlyData &data)
+{
+  const int verts_num = int(data.vertices.size());
+  const Span<int> face_offsets = data.face_offsets;
+  const int faces_num = data.faces_num();
+
+  /* Faces with less than three vertices can't be represented, keep the indices of the others. */
+  Vector<int> valid_faces;
+  bool all_faces_valid = true;
+  for (const int face : IndexRange(faces_num)) {
+    if (face_offsets[face + 1] - face_offsets[face] < 3) {
+      all_faces_valid = false;
+      break;
+    }
+  }
+  if (!all_faces_valid) {
+    for (const int face : IndexRange(faces_num)) {
+      if (face_offsets[face + 1] - face_offsets[face] >= 3) {
+        valid_faces.append(face);
+      }
+    }
+  }
+  const int polys_num = all_faces_valid ? faces_num : int(valid_faces.size());
+
+  Array<int> poly_offsets(polys_num + 1);
+  for (const int poly : IndexRange(polys_num)) {
+    const int face = all_faces_valid ? poly : valid_faces[poly];
+    poly_offsets[poly] = face_offsets[face + 1] - face_offsets[face];
+  }
+  offset_indices::accumulate_counts_to_offsets(poly_offsets);
+  const int loops_num = poly_offsets.last();
+
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, int(data.edges.size()), 0, loops_num, polys_num);
+  mesh->vert_positions_for_write().copy_from(data.vertices);
+
+  MutableSpan<MEdge> edges = mesh->edges_for_write();
+  threading::parallel_for(edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      edges[i].v1 = data.edges[i][0];
+      edges[i].v2 = data.edges[i][1];
+    }
+  });
+
+  MutableSpan<MPoly> polys = mesh->polys_for_write();
+  MutableSpan<MLoop> loops = mesh->loops_for_write();
+  threading::parallel_for(polys.index_range(), 2048, [&](const IndexRange range) {
+    for (const int poly : range) {
+      const int face = all_faces_valid ? poly : valid_faces[poly];
+      const IndexRange face_range(face_offsets[face], face_offsets[face + 1] - face_offsets[face]);
+      polys[poly].loopstart = poly_offsets[poly];
+      polys[poly].totloop = int(face_range.size());
+      for (const int i : IndexRange(face_range.size())) {
+        loops[poly_offsets[poly] + i].v = data.face_vertices[face_range[i]];
+      }
+    }
+  });
+
+  /* Explicit edges of the file are kept, face edges are added and merged with them. */
+  BKE_mesh_calc_edges(mesh, !edges.is_empty(), false);
+
+  bke::MutableAttributeAccessor attributes = mesh->attributes_for_write();
+  if (!data.uv_coordinates.is_empty() && loops_num > 0) {
+    bke::SpanAttributeWriter<float2> uv_map =
+        attributes.lookup_or_add_for_write_only_span<float2>("UVMap", ATTR_DOMAIN_CORNER);
+    threading::parallel_for(loops.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        uv_map.span[i] = data.uv_coordinates[loops[i].v];
+      }
+    });
+    uv_map.finish();
+  }
+  add_vertex_colors(mesh->id, attributes, data);
+  add_custom_attributes(attributes, data.vertex_custom_attributes, ATTR_DOMAIN_POINT, {});
+  if (polys_num > 0) {
+    add_custom_attributes(attributes, data.face_custom_attributes, ATTR_DOMAIN_FACE, valid_faces);
+  }
+
+  /* NOTE: edges must be calculated first before setting custom normals. */
+  if (!data.vertex_normals.is_empty() && polys_num > 0) {
+    Array<float3> normals = data.vertex_normals;
+    BKE_mesh_set_custom_normals_from_verts(mesh, reinterpret_cast<float(*)[3]>(normals.data()));
+    mesh->flag |= ME_AUTOSMOOTH;
+  }
+
+  return mesh;
+}
+
+PointCloud *convert_ply_to_point_cloud(const PlyData &data)
+{
+  PointCloud *pointcloud = BKE_pointcloud_new_nomain(int(data.vertices.size()));
+  bke::MutableAttributeAccessor attributes = pointcloud->attributes_for_write();
+
+  bke::SpanAttributeWriter<float3> positions =
+      attributes.lookup_or_add_for_write_only_span<float3>("position", ATTR_DOMAIN_POINT);
+  positions.span.copy_from(data.vertices);
+  positions.finish();
+
+  if (!data.vertex_normals.is_empty()) {
+    bke::SpanAttributeWriter<float3> normals =
+        attributes.lookup_or_add_for_write_only_span<float3>("normal", ATTR_DOMAIN_POINT);
+    normals.span.copy_from(data.vertex_normals);
+    normals.finish();
+  }
+  add_vertex_colors(pointcloud->id, attributes, data);
+  add_custom_attributes(attributes, data.vertex_custom_attributes, ATTR_DOMAIN_POINT, {});
+
+  return pointcloud;
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include "ply_data.hh"
+
+struct Mesh;
+struct PointCloud;
+
+namespace blender::io::ply {
+
+/**
+ * Create a nomain mesh from the data read from a file. Faces with less than three vertices are
+ * skipped, vertex normals are used as custom normals when there are faces.
+ */
+Mesh *convert_ply_to_mesh(const PlyData &data);
+
+/**
+ * Create a nomain point cloud from the vertices read from a file, normals are stored as the
+ * `normal` attribute.
+ */
+PointCloud *convert_ply_to_point_cloud(const PlyData &data);
+
+}  // namespace blender::io::ply
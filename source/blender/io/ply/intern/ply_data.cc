@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#include "ply_data.hh"
+
+namespace blender::io::ply {
+
+PlyDataTypes ply_data_type_from_string(const StringRef str)
+{
+  if (ELEM(str, "char", "int8")) {
+    return PLY_CHAR;
+  }
+  if (ELEM(str, "uchar", "uint8")) {
+    return PLY_UCHAR;
+  }
+  if (ELEM(str, "short", "int16")) {
+    return PLY_SHORT;
+  }
+  if (ELEM(str, "ushort", "uint16")) {
+    return PLY_USHORT;
+  }
+  if (ELEM(str, "int", "int32")) {
+    return PLY_INT;
+  }
+  if (ELEM(str, "uint", "uint32")) {
+    return PLY_UINT;
+  }
+  if (ELEM(str, "float", "float32")) {
+    return PLY_FLOAT;
+  }
+  if (ELEM(str, "double", "float64")) {
+    return PLY_DOUBLE;
+  }
+  return PLY_NONE;
+}
+
+int64_t PlyElementHeader::binary_stride() const
+{
+  int64_t stride = 0;
+  for (const PlyProperty &property : properties) {
+    if (property.count_type != PLY_NONE) {
+      return -1;
+    }
+    stride += ply_data_type_size(property.type);
+  }
+  return stride;
+}
+
+}  // namespace blender::io::ply
@@ -0,0 +1,103 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup ply
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "BLI_array.hh"
+#include "BLI_color.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
+
+namespace blender::io::ply {
+
+enum PlyDataTypes {
+  PLY_NONE,
+  PLY_CHAR,
+  PLY_UCHAR,
+  PLY_SHORT,
+  PLY_USHORT,
+  PLY_INT,
+  PLY_UINT,
+  PLY_FLOAT,
+  PLY_DOUBLE,
+};
+
+enum PlyFormatType { PLY_ASCII, PLY_BINARY_LE, PLY_BINARY_BE };
+
+/** Size in bytes of a value of the given type in binary files. */
+inline int ply_data_type_size(const PlyDataTypes type)
+{
+  static const int sizes[] = {0, 1, 1, 2, 2, 4, 4, 4, 8};
+  return sizes[type];
+}
+
+inline bool ply_data_type_is_float(const PlyDataTypes type)
+{
+  return type == PLY_FLOAT || type == PLY_DOUBLE;
+}
+
+/**
+ * Parse a type name of a property declaration, both the original names (`float`, `uchar`)
+ * and the sized ones (`float32`, `uint8`) are supported. Returns #PLY_NONE for unknown names.
+ */
+PlyDataTypes ply_data_type_from_string(StringRef str);
+
+struct PlyProperty {
+  std::string name;
+  PlyDataTypes type = PLY_NONE;
+  /** Type of the item count for list properties, #PLY_NONE for scalar properties. */
+  PlyDataTypes count_type = PLY_NONE;
+};
+
+struct PlyElementHeader {
+  std::string name;
+  int64_t count = 0;
+  Vector<PlyProperty> properties;
+
+  /** Size in bytes of each item in binary files, or -1 when the items have list properties. */
+  int64_t binary_stride() const;
+};
+
+struct PlyHeader {
+  PlyFormatType type = PLY_ASCII;
+  Vector<PlyElementHeader> elements;
+  /** Offset of the element data from the start of the file, right after `end_header`. */
+  int64_t header_size = 0;
+};
+
+/** Per-element scalar property without a built-in meaning, imported as a float attribute. */
+struct PlyCustomAttribute {
+  std::string name;
+  Array<float> data;
+};
+
+/** Geometry read from or written to a PLY file. Optional arrays are empty when unused. */
+struct PlyData {
+  Array<float3> vertices;
+  Array<float3> vertex_normals;
+  Array<ColorGeometry4b> vertex_colors;
+  Array<float2> uv_coordinates;
+  Vector<PlyCustomAttribute> vertex_custom_attributes;
+
+  /** Vertex pairs of explicit edges. */
+  Array<int2> edges;
+
+  /** Start of each face in #face_vertices, with the total corner count as last element. */
+  Array<int> face_offsets;
+  Array<int> face_vertices;
+  Vector<PlyCustomAttribute> face_custom_attributes;
+
+  int faces_num() const
+  {
+    return face_offsets.is_empty() ? 0 : int(face_offsets.size()) - 1;
+  }
+};
+
+}  // namespace blender::io::ply
@@ -0,0 +1,271 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include <cstring>
+
+#include "testing/testing.h"
+
+#include "ply_export_data.hh"
+#include "ply_import_data.hh"
+
+namespace blender::io::ply {
+
+static bool read_ply(const std::string &str, PlyData &r_data, std::string &r_error)
+{
+  const Span<char> buffer(str.data(), int64_t(str.size()));
+  PlyHeader header;
+  return parse_ply_header(buffer, header, r_error) &&
+         import_ply_data(buffer, header, r_data, r_error);
+}
+
+template<typename T> static void append_binary(std::string &str, const T value)
+{
+  str.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template<typename T> static void append_binary_swapped(std::string &str, const T value)
+{
+  char bytes[sizeof(T)];
+  memcpy(bytes, &value, sizeof(T));
+  for (int i = int(sizeof(T)) - 1; i >= 0; i--) {
+    str.push_back(bytes[i]);
+  }
+}
+
+TEST(ply_import_data, header)
+{
+  const std::string str =
+      "ply\r\n"
+      "format binary_little_endian 1.0\r\n"
+      "comment made by hand\r\n"
+      "element vertex 8\r\n"
+      "property float x\r\n"
+      "property uint8 red\r\n"
+      "element face 6\r\n"
+      "property list uchar int vertex_indices\r\n"
+      "end_header\r\n";
+  PlyHeader header;
+  std::string error;
+  ASSERT_TRUE(parse_ply_header(Span<char>(str.data(), int64_t(str.size())), header, error));
+  EXPECT_EQ(header.type, PLY_BINARY_LE);
+  EXPECT_EQ(header.header_size, int64_t(str.size()));
+  ASSERT_EQ(header.elements.size(), 2);
+  EXPECT_EQ(header.elements[0].name, "vertex");
+  EXPECT_EQ(header.elements[0].count, 8);
+  ASSERT_EQ(header.elements[0].properties.size(), 2);
+  EXPECT_EQ(header.elements[0].properties[1].type, PLY_UCHAR);
+  EXPECT_EQ(header.elements[0].binary_stride(), 5);
+  EXPECT_EQ(header.elements[1].properties[0].count_type, PLY_UCHAR);
+  EXPECT_EQ(header.elements[1].properties[0].type, PLY_INT);
+  EXPECT_EQ(header.elements[1].binary_stride(), -1);
+}
+
+TEST(ply_import_data, header_invalid)
+{
+  PlyHeader header;
+  std::string error;
+  const std::string not_ply = "obj\nformat ascii 1.0\nend_header\n";
+  EXPECT_FALSE(
+      parse_ply_header(Span<char>(not_ply.data(), int64_t(not_ply.size())), header, error));
+  const std::string no_end = "ply\nformat ascii 1.0\nelement vertex 1\n";
+  EXPECT_FALSE(parse_ply_header(Span<char>(no_end.data(), int64_t(no_end.size())), header, error));
+  const std::string bad_type = "ply\nformat ascii 1.0\nelement vertex 1\nproperty half x\n"
+                               "end_header\n";
+  EXPECT_FALSE(
+      parse_ply_header(Span<char>(bad_type.data(), int64_t(bad_type.size())), header, error));
+}
+
+TEST(ply_import_data, ascii)
+{
+  const std::string str =
+      "ply\n"
+      "format ascii 1.0\n"
+      "element vertex 4\n"
+      "property float x\n"
+      "property float y\n"
+      "property float z\n"
+      "property uchar red\n"
+      "property uchar green\n"
+      "property uchar blue\n"
+      "property float quality\n"
+      "element face 2\n"
+      "property list uchar int vertex_indices\n"
+      "property int label\n"
+      "element material 1\n"
+      "property float shine\n"
+      "end_header\n"
+      "0 0 0 255 0 0 0.5\n"
+      "1 0 0 0 255 0 1.5\n"
+      "\n"
+      "1 1 0 0 0 255 2.5\r\n"
+      "0 1 +1e1 10 20 30 -3\n"
+      "3 0 1 2 7\n"
+      "4 0 1 2 3 8\n"
+      "0.25\n";
+  PlyData data;
+  std::string error;
+  ASSERT_TRUE(read_ply(str, data, error)) << error;
+  ASSERT_EQ(data.vertices.size(), 4);
+  EXPECT_EQ(data.vertices[2], float3(1.0f, 1.0f, 0.0f));
+  EXPECT_EQ(data.vertices[3], float3(0.0f, 1.0f, 10.0f));
+  ASSERT_EQ(data.vertex_colors.size(), 4);
+  EXPECT_EQ(data.vertex_colors[1].g, 255);
+  EXPECT_EQ(data.vertex_colors[3].b, 30);
+  EXPECT_EQ(data.vertex_colors[3].a, 255);
+  EXPECT_TRUE(data.vertex_normals.is_empty());
+  EXPECT_TRUE(data.uv_coordinates.is_empty());
+  ASSERT_EQ(data.vertex_custom_attributes.size(), 1);
+  EXPECT_EQ(data.vertex_custom_attributes[0].name, "quality");
+  EXPECT_EQ(data.vertex_custom_attributes[0].data[3], -3.0f);
+
+  ASSERT_EQ(data.faces_num(), 2);
+  EXPECT_EQ(data.face_offsets[1], 3);
+  EXPECT_EQ(data.face_offsets[2], 7);
+  EXPECT_EQ(data.face_vertices[3], 0);
+  EXPECT_EQ(data.face_vertices[6], 3);
+  ASSERT_EQ(data.face_custom_attributes.size(), 1);
+  EXPECT_EQ(data.face_custom_attributes[0].data[1], 8.0f);
+}
+
+TEST(ply_import_data, ascii_truncated)
+{
+  const std::string str =
+      "ply\n"
+      "format ascii 1.0\n"
+      "element vertex 3\n"
+      "property float x\n"
+      "end_header\n"
+      "1\n"
+      "2\n";
+  PlyData data;
+  std::string error;
+  EXPECT_FALSE(read_ply(str, data, error));
+}
+
+TEST(ply_import_data, binary_big_endian)
+{
+  std::string str =
+      "ply\n"
+      "format binary_big_endian 1.0\n"
+      "element vertex 3\n"
+      "property double x\n"
+      "property double y\n"
+      "property double z\n"
+      "property float nx\n"
+      "element edge 1\n"
+      "property int vertex1\n"
+      "property int vertex2\n"
+      "element face 1\n"
+      "property list ushort uint vertex_indices\n"
+      "end_header\n";
+  for (const int i : IndexRange(3)) {
+    append_binary_swapped(str, double(i));
+    append_binary_swapped(str, double(i) * 2.0);
+    append_binary_swapped(str, -1.0);
+    append_binary_swapped(str, 0.5f);
+  }
+  append_binary_swapped(str, int32_t(0));
+  append_binary_swapped(str, int32_t(2));
+  append_binary_swapped(str, uint16_t(3));
+  append_binary_swapped(str, uint32_t(2));
+  append_binary_swapped(str, uint32_t(1));
+  append_binary_swapped(str, uint32_t(0));
+
+  PlyData data;
+  std::string error;
+  ASSERT_TRUE(read_ply(str, data, error)) << error;
+  ASSERT_EQ(data.vertices.size(), 3);
+  EXPECT_EQ(data.vertices[2], float3(2.0f, 4.0f, -1.0f));
+  ASSERT_EQ(data.vertex_normals.size(), 3);
+  EXPECT_EQ(data.vertex_normals[1], float3(0.5f, 0.0f, 0.0f));
+  ASSERT_EQ(data.edges.size(), 1);
+  EXPECT_EQ(data.edges[0], int2(0, 2));
+  ASSERT_EQ(data.faces_num(), 1);
+  EXPECT_EQ(data.face_vertices[0], 2);
+  EXPECT_EQ(data.face_vertices[2], 0);
+}
+
+TEST(ply_import_data, binary_invalid_index)
+{
+  std::string str =
+      "ply\n"
+      "format binary_little_endian 1.0\n"
+      "element vertex 1\n"
+      "property float x\n"
+      "element face 1\n"
+      "property list uchar int vertex_indices\n"
+      "end_header\n";
+  append_binary(str, 1.0f);
+  append_binary(str, uint8_t(3));
+  append_binary(str, int32_t(0));
+  append_binary(str, int32_t(0));
+  append_binary(str, int32_t(1));
+
+  PlyData data;
+  std::string error;
+  EXPECT_FALSE(read_ply(str, data, error));
+}
+
+static PlyData make_test_data()
+{
+  PlyData data;
+  const int verts_num = 40000;
+  data.vertices.reinitialize(verts_num);
+  data.vertex_normals.reinitialize(verts_num);
+  data.uv_coordinates.reinitialize(verts_num);
+  data.vertex_colors.reinitialize(verts_num);
+  for (const int i : IndexRange(verts_num)) {
+    data.vertices[i] = float3(float(i), float(i) * 0.5f, -0.25f);
+    data.vertex_normals[i] = float3(0.0f, 0.0f, 1.0f);
+    data.uv_coordinates[i] = float2(0.125f, float(i % 7));
+    data.vertex_colors[i] = ColorGeometry4b(uint8_t(i % 256), 1, 2, 255);
+  }
+  const int faces_num = verts_num - 2;
+  data.face_offsets.reinitialize(faces_num + 1);
+  data.face_vertices.reinitialize(faces_num * 3);
+  for (const int i : IndexRange(faces_num)) {
+    data.face_offsets[i] = i * 3;
+    data.face_vertices[i * 3] = i;
+    data.face_vertices[i * 3 + 1] = i + 1;
+    data.face_vertices[i * 3 + 2] = i + 2;
+  }
+  data.face_offsets.last() = faces_num * 3;
+  return data;
+}
+
+static void test_round_trip(const bool ascii_format)
+{
+  const PlyData data = make_test_data();
+  std::string str;
+  write_ply_data(data, ascii_format, "test", [&](const Span<char> buffer) {
+    str.append(buffer.data(), size_t(buffer.size()));
+  });
+
+  PlyData result;
+  std::string error;
+  ASSERT_TRUE(read_ply(str, result, error)) << error;
+  EXPECT_EQ_ARRAY(data.vertices.data(), result.vertices.data(), data.vertices.size());
+  EXPECT_EQ_ARRAY(
+      data.vertex_normals.data(), result.vertex_normals.data(), data.vertex_normals.size());
+  EXPECT_EQ_ARRAY(
+      data.uv_coordinates.data(), result.uv_coordinates.data(), data.uv_coordinates.size());
+  EXPECT_EQ_ARRAY(data.face_offsets.data(), result.face_offsets.data(), data.face_offsets.size());
+  EXPECT_EQ_ARRAY(
+      data.face_vertices.data(), result.face_vertices.data(), data.face_vertices.size());
+  ASSERT_EQ(result.vertex_colors.size(), data.vertex_colors.size());
+  for (const int i : data.vertex_colors.index_range()) {
+    EXPECT_EQ(result.vertex_colors[i].r, data.vertex_colors[i].r);
+    EXPECT_EQ(result.vertex_colors[i].a, data.vertex_colors[i].a);
+  }
+}
+
+TEST(ply_import_data, round_trip_binary)
+{
+  test_round_trip(false);
+}
+
+TEST(ply_import_data, round_trip_ascii)
+{
+  test_round_trip(true);
+}
+
+}  // namespace blender::io::ply
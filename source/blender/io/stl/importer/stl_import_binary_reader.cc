@@ -12,6 +12,7 @@
 
 #include "BLI_array.hh"
 #include "BLI_memory_utils.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -31,7 +32,6 @@ struct STLBinaryTriangle {
 
 Mesh *read_stl_binary(FILE *file, Main *bmain, char *mesh_name, bool use_custom_normals)
 {
-  const int chunk_size = 1024;
   uint32_t num_tris = 0;
   fseek(file, BINARY_HEADER_SIZE, SEEK_SET);
   if (fread(&num_tris, sizeof(uint32_t), 1, file) != 1) {
@@ -43,21 +43,29 @@ Mesh *read_stl_binary(FILE *file, Main *bmain, char *mesh_name, bool use_custom_
     return BKE_mesh_add(bmain, mesh_name);
   }
 
-  Array<STLBinaryTriangle> tris_buf(chunk_size);
-  STLMeshHelper stl_mesh(num_tris, use_custom_normals);
-  size_t num_read_tris;
-  while ((num_read_tris = fread(tris_buf.data(), sizeof(STLBinaryTriangle), chunk_size, file))) {
-    for (size_t i = 0; i < num_read_tris; i++) {
+  /* The file size was checked against the triangle count when detecting binary files, so all
+   * triangles can be read at once and converted in parallel. */
+  Array<STLBinaryTriangle> tris_buf(num_tris);
+  const size_t num_read_tris = fread(tris_buf.data(), sizeof(STLBinaryTriangle), num_tris, file);
+  const int tris_num = int(num_read_tris);
+
+  Array<float3> corner_positions(tris_num * 3);
+  Array<float3> triangle_normals(use_custom_normals ? tris_num : 0);
+  threading::parallel_for(IndexRange(tris_num), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const STLBinaryTriangle &tri = tris_buf[i];
+      corner_positions[3 * i] = tri.v1;
+      corner_positions[3 * i + 1] = tri.v2;
+      corner_positions[3 * i + 2] = tri.v3;
       if (use_custom_normals) {
-        stl_mesh.add_triangle(tris_buf[i].v1, tris_buf[i].v2, tris_buf[i].v3, tris_buf[i].normal);
-      }
-      else {
-        stl_mesh.add_triangle(tris_buf[i].v1, tris_buf[i].v2, tris_buf[i].v3);
+        triangle_normals[i] = tri.normal;
       }
     }
-  }
+  });
+  tris_buf = {};
 
-  return stl_mesh.to_mesh(bmain, mesh_name);
+  return stl_mesh_from_triangles(
+      bmain, mesh_name, corner_positions, triangle_normals, use_custom_normals);
 }
 
 }  // namespace blender::io::stl
@@ -4,14 +4,20 @@
  * \ingroup stl
  */
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_mesh.h"
 
 #include "BLI_array.hh"
+#include "BLI_concurrent_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
+#include "BLI_offset_indices.hh"
 #include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
@@ -60,14 +66,21 @@ void STLMeshHelper::add_triangle(const float3 &a,
   }
 }
 
-Mesh *STLMeshHelper::to_mesh(Main *bmain, char *mesh_name)
+static Mesh *create_mesh(Main *bmain,
+                         char *mesh_name,
+                         const Span<float3> verts,
+                         const Span<Triangle> tris,
+                         const Span<float3> loop_normals,
+                         const bool use_custom_normals,
+                         const int degenerate_tris_num,
+                         const int duplicate_tris_num)
 {
-  if (degenerate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << degenerate_tris_num_ << " degenerate triangles were removed"
+  if (degenerate_tris_num > 0) {
+    std::cout << "STL Importer: " << degenerate_tris_num << " degenerate triangles were removed"
               << std::endl;
   }
-  if (duplicate_tris_num_ > 0) {
-    std::cout << "STL Importer: " << duplicate_tris_num_ << " duplicate triangles were removed"
+  if (duplicate_tris_num > 0) {
+    std::cout << "STL Importer: " << duplicate_tris_num << " duplicate triangles were removed"
               << std::endl;
   }
 
@@ -75,37 +88,178 @@ Mesh *STLMeshHelper::to_mesh(Main *bmain, char *mesh_name)
   /* User count is already 1 here, but will be set later in #BKE_mesh_assign_object. */
   id_us_min(&mesh->id);
 
-  mesh->totvert = verts_.size();
+  mesh->totvert = verts.size();
   CustomData_add_layer_named(
       &mesh->vdata, CD_PROP_FLOAT3, CD_CONSTRUCT, nullptr, mesh->totvert, "position");
-  mesh->vert_positions_for_write().copy_from(verts_);
+  mesh->vert_positions_for_write().copy_from(verts);
 
-  mesh->totpoly = tris_.size();
-  mesh->totloop = tris_.size() * 3;
+  mesh->totpoly = tris.size();
+  mesh->totloop = tris.size() * 3;
   CustomData_add_layer(&mesh->pdata, CD_MPOLY, CD_SET_DEFAULT, nullptr, mesh->totpoly);
   CustomData_add_layer(&mesh->ldata, CD_MLOOP, CD_SET_DEFAULT, nullptr, mesh->totloop);
   MutableSpan<MPoly> polys = mesh->polys_for_write();
   MutableSpan<MLoop> loops = mesh->loops_for_write();
-  threading::parallel_for(tris_.index_range(), 2048, [&](IndexRange tris_range) {
+  threading::parallel_for(tris.index_range(), 2048, [&](IndexRange tris_range) {
     for (const int i : tris_range) {
       polys[i].loopstart = 3 * i;
       polys[i].totloop = 3;
 
-      loops[3 * i].v = tris_[i].v1;
-      loops[3 * i + 1].v = tris_[i].v2;
-      loops[3 * i + 2].v = tris_[i].v3;
+      loops[3 * i].v = tris[i].v1;
+      loops[3 * i + 1].v = tris[i].v2;
+      loops[3 * i + 2].v = tris[i].v3;
     }
   });
 
   /* NOTE: edges must be calculated first before setting custom normals. */
   BKE_mesh_calc_edges(mesh, false, false);
 
-  if (use_custom_normals_ && loop_normals_.size() == mesh->totloop) {
-    BKE_mesh_set_custom_normals(mesh, reinterpret_cast<float(*)[3]>(loop_normals_.data()));
+  if (use_custom_normals && loop_normals.size() == mesh->totloop) {
+    BKE_mesh_set_custom_normals(mesh,
+                                reinterpret_cast<float(*)[3]>(
+                                    const_cast<float3 *>(loop_normals.data())));
     mesh->flag |= ME_AUTOSMOOTH;
   }
 
   return mesh;
 }
 
+Mesh *STLMeshHelper::to_mesh(Main *bmain, char *mesh_name)
+{
+  return create_mesh(bmain,
+                     mesh_name,
+                     verts_.as_span(),
+                     tris_.as_span(),
+                     loop_normals_,
+                     use_custom_normals_,
+                     degenerate_tris_num_,
+                     duplicate_tris_num_);
+}
+
+/**
+ * For every item that is not skipped, find the index of the first item that is equal to it. Items
+ * are added to a concurrent map that gives an arbitrary representative for each group of equal
+ * items, then the smallest index of each group is found with an atomic minimum.
+ */
+template<typename T>
+static Array<int> find_first_equal_indices(const Span<T> items, const Span<bool> skip)
+{
+  const IndexRange range = items.index_range();
+  Array<int> first_indices(items.size());
+  Array<std::atomic<int>> min_indices(items.size());
+  threading::parallel_for(range, 4096, [&](const IndexRange sub_range) {
+    for (const int i : sub_range) {
+      min_indices[i].store(INT_MAX, std::memory_order_relaxed);
+    }
+  });
+
+  ConcurrentMap<T, int> representatives(items.size());
+  threading::parallel_for(range, 4096, [&](const IndexRange sub_range) {
+    for (const int i : sub_range) {
+      if (!skip.is_empty() && skip[i]) {
+        first_indices[i] = -1;
+        continue;
+      }
+      const int representative = representatives.lookup_or_add(items[i], i);
+      first_indices[i] = representative;
+      std::atomic<int> &min_index = min_indices[representative];
+      int current = min_index.load(std::memory_order_relaxed);
+      while (i < current &&
+             !min_index.compare_exchange_weak(current, i, std::memory_order_relaxed)) {
+      }
+    }
+  });
+
+  threading::parallel_for(range, 4096, [&](const IndexRange sub_range) {
+    for (const int i : sub_range) {
+      if (first_indices[i] != -1) {
+        first_indices[i] = min_indices[first_indices[i]].load(std::memory_order_relaxed);
+      }
+    }
+  });
+  return first_indices;
+}
+
+/**
+ * Give consecutive new indices to the items that are their own first equal item, in order.
+ * Returns the number of such items.
+ */
+static int compute_new_indices(const Span<int> first_indices, MutableSpan<int> r_new_indices)
+{
+  BLI_assert(r_new_indices.size() == first_indices.size() + 1);
+  threading::parallel_for(first_indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      r_new_indices[i] = first_indices[i] == i;
+    }
+  });
+  r_new_indices.last() = 0;
+  offset_indices::accumulate_counts_to_offsets(r_new_indices);
+  return r_new_indices.last();
+}
+
+Mesh *stl_mesh_from_triangles(Main *bmain,
+                              char *mesh_name,
+                              const Span<float3> corner_positions,
+                              const Span<float3> triangle_normals,
+                              const bool use_custom_normals)
+{
+  const int corners_num = int(corner_positions.size());
+  const int tris_num = corners_num / 3;
+
+  /* Merge vertices, the first corner at each position creates the vertex. */
+  const Array<int> first_corners = find_first_equal_indices(corner_positions, {});
+  Array<int> new_vert_indices(corners_num + 1);
+  const int verts_num = compute_new_indices(first_corners, new_vert_indices);
+
+  Array<float3> verts(verts_num);
+  Array<Triangle> corner_tris(tris_num);
+  Array<bool> degenerate(tris_num);
+  threading::parallel_for(IndexRange(tris_num), 2048, [&](const IndexRange range) {
+    for (const int tri : range) {
+      int corner_verts[3];
+      for (const int i : IndexRange(3)) {
+        const int corner = tri * 3 + i;
+        corner_verts[i] = new_vert_indices[first_corners[corner]];
+        if (first_corners[corner] == corner) {
+          verts[corner_verts[i]] = corner_positions[corner];
+        }
+      }
+      corner_tris[tri] = {corner_verts[0], corner_verts[1], corner_verts[2]};
+      degenerate[tri] = corner_verts[0] == corner_verts[1] ||
+                        corner_verts[0] == corner_verts[2] || corner_verts[1] == corner_verts[2];
+    }
+  });
+
+  /* Merge triangles using the same vertices, the first one is kept. */
+  const Array<int> first_tris = find_first_equal_indices(corner_tris.as_span(),
+                                                         degenerate.as_span());
+  Array<int> new_tri_indices(tris_num + 1);
+  const int new_tris_num = compute_new_indices(first_tris, new_tri_indices);
+
+  Array<Triangle> tris(new_tris_num);
+  Array<float3> loop_normals(use_custom_normals ? new_tris_num * 3 : 0);
+  threading::parallel_for(IndexRange(tris_num), 2048, [&](const IndexRange range) {
+    for (const int tri : range) {
+      if (first_tris[tri] != tri) {
+        continue;
+      }
+      const int new_tri = new_tri_indices[tri];
+      tris[new_tri] = corner_tris[tri];
+      if (use_custom_normals) {
+        loop_normals.as_mutable_span().slice(new_tri * 3, 3).fill(triangle_normals[tri]);
+      }
+    }
+  });
+
+  const int degenerate_tris_num = int(
+      std::count(degenerate.begin(), degenerate.end(), true));
+  return create_mesh(bmain,
+                     mesh_name,
+                     verts,
+                     tris,
+                     loop_normals,
+                     use_custom_normals,
+                     degenerate_tris_num,
+                     tris_num - degenerate_tris_num - new_tris_num);
+}
+
 }  // namespace blender::io::stl
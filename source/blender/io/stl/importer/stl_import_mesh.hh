@@ -68,4 +68,16 @@ class STLMeshHelper {
   Mesh *to_mesh(Main *bmain, char *mesh_name);
 };
 
+/**
+ * Create a mesh from triangles given by three corner positions each. Duplicate vertices and
+ * triangles are merged with the same result as adding the triangles to #STLMeshHelper in order,
+ * but the merging is done in parallel. `triangle_normals` contains one normal per triangle and is
+ * only used for custom normals.
+ */
+Mesh *stl_mesh_from_triangles(Main *bmain,
+                              char *mesh_name,
+                              Span<float3> corner_positions,
+                              Span<float3> triangle_normals,
+                              bool use_custom_normals);
+
 }  // namespace blender::io::stl
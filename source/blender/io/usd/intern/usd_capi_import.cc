@@ -30,6 +30,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "DEG_depsgraph.h"
@@ -257,6 +258,22 @@ static void import_startjob(void *customdata, bool *stop, bool *do_update, float
     }
   }
 
+  /* Read the geometry of all prims in parallel. Adding data to the main database happens
+   * in the serial loop below. */
+  const std::vector<USDPrimReader *> &readers = archive->readers();
+  threading::parallel_for(IndexRange(readers.size()), 1, [&](const IndexRange range) {
+    for (const int64_t reader_i : range) {
+      if (readers[reader_i]) {
+        readers[reader_i]->prepare_object_data(0.0);
+      }
+    }
+  });
+
+  if (G.is_break) {
+    data->was_canceled = true;
+    return;
+  }
+
   /* Setup parenthood and read actual object data. */
   i = 0;
   for (USDPrimReader *reader : archive->readers()) {
@@ -19,6 +19,7 @@
 #include "BKE_duplilist.h"
 
 #include "BLI_assert.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DEG_depsgraph_query.h"
@@ -37,6 +38,43 @@ USDHierarchyIterator::USDHierarchyIterator(Main *bmain,
 {
 }
 
+void USDHierarchyIterator::iterate_and_write()
+{
+  try {
+    AbstractHierarchyIterator::iterate_and_write();
+    write_staged_meshes();
+  }
+  catch (...) {
+    for (USDGenericMeshWriter *writer : staged_mesh_writers_) {
+      writer->discard_staged_data();
+    }
+    staged_mesh_writers_.clear();
+    throw;
+  }
+}
+
+void USDHierarchyIterator::stage_mesh_writer(USDGenericMeshWriter *writer)
+{
+  staged_mesh_writers_.append(writer);
+}
+
+void USDHierarchyIterator::write_staged_meshes()
+{
+  /* Extracting the data only reads the evaluated meshes, so all meshes are handled in parallel.
+   * Only threading within each mesh isn't enough, as scenes often consist of many small meshes. */
+  threading::parallel_for(staged_mesh_writers_.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      staged_mesh_writers_[i]->extract_staged_data();
+    }
+  });
+
+  /* The USD stage can only be modified from one thread at a time. */
+  for (USDGenericMeshWriter *writer : staged_mesh_writers_) {
+    writer->write_staged_data();
+  }
+  staged_mesh_writers_.clear();
+}
+
 bool USDHierarchyIterator::mark_as_weak_export(const Object *object) const
 {
   if (params_.selected_objects_only && (object->base_flag & BASE_SELECTED) == 0) {
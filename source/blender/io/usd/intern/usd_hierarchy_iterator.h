@@ -8,6 +8,8 @@
 
 #include <string>
 
+#include "BLI_vector.hh"
+
 #include <pxr/usd/usd/common.h>
 #include <pxr/usd/usd/timeCode.h>
 
@@ -21,18 +23,31 @@ using blender::io::AbstractHierarchyIterator;
 using blender::io::AbstractHierarchyWriter;
 using blender::io::HierarchyContext;
 
+class USDGenericMeshWriter;
+
 class USDHierarchyIterator : public AbstractHierarchyIterator {
  private:
   const pxr::UsdStageRefPtr stage_;
   pxr::UsdTimeCode export_time_;
   const USDExportParams &params_;
 
+  /* Mesh writers that staged their data during the current #iterate_and_write(). */
+  Vector<USDGenericMeshWriter *> staged_mesh_writers_;
+
  public:
   USDHierarchyIterator(Main *bmain,
                        Depsgraph *depsgraph,
                        pxr::UsdStageRefPtr stage,
                        const USDExportParams &params);
 
+  virtual void iterate_and_write() override;
+
+  /**
+   * Write the mesh of `writer` after all writers of the current frame ran. Mesh data of all staged
+   * writers is extracted in parallel, then written to the stage in the order of staging.
+   */
+  void stage_mesh_writer(USDGenericMeshWriter *writer);
+
   void set_export_frame(float frame_nr);
   std::string get_export_file_path() const;
   const pxr::UsdTimeCode &get_export_time_code() const;
@@ -53,6 +68,7 @@ class USDHierarchyIterator : public AbstractHierarchyIterator {
 
  private:
   USDExporterContext create_usd_export_context(const HierarchyContext *context);
+  void write_staged_meshes();
 };
 
 }  // namespace blender::io::usd
@@ -8,6 +8,7 @@
 
 #include "BKE_attribute.hh"
 #include "BKE_customdata.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -181,28 +182,88 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
 {
 }
 
-void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime */)
+USDMeshReader::~USDMeshReader()
+{
+  if (prepared_mesh_ != nullptr) {
+    BKE_id_free(nullptr, prepared_mesh_);
+  }
+}
+
+void USDMeshReader::share_mesh_of(USDMeshReader *source)
 {
-  Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
+  BLI_assert(source->mesh_source_ == nullptr);
+  mesh_source_ = source;
+  source->mesh_users_.push_back(this);
+}
 
+void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime */)
+{
   object_ = BKE_object_add_only_object(bmain, OB_MESH, name_.c_str());
-  object_->data = mesh;
+  if (mesh_source_ == nullptr) {
+    /* Objects sharing a mesh get it when the source reads its object data. */
+    object_->data = BKE_mesh_add(bmain, name_.c_str());
+  }
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+void USDMeshReader::prepare_object_data(const double motionSampleTime)
 {
+  is_prepared_ = true;
+  if (mesh_source_ != nullptr) {
+    return;
+  }
+
   Mesh *mesh = (Mesh *)object_->data;
 
+  /* Reading the mesh only creates data outside of the main database, except for an empty mesh,
+   * which is read into the object data directly. */
   is_initial_load_ = true;
   Mesh *read_mesh = this->read_mesh(
       mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
-
   is_initial_load_ = false;
+
   if (read_mesh != mesh) {
-    BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
+    prepared_mesh_ = read_mesh;
   }
+}
 
-  readFaceSetsSample(bmain, mesh, motionSampleTime);
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  if (!is_prepared_) {
+    prepare_object_data(motionSampleTime);
+  }
+  is_prepared_ = false;
+
+  if (mesh_source_ != nullptr) {
+    is_time_varying_ |= mesh_source_->is_time_varying_;
+    mesh_source_ = nullptr;
+  }
+  else {
+    Mesh *mesh = (Mesh *)object_->data;
+
+    if (prepared_mesh_ != nullptr) {
+      BKE_mesh_nomain_to_mesh(prepared_mesh_, mesh, object_);
+      prepared_mesh_ = nullptr;
+    }
+
+    readFaceSetsSample(bmain, mesh, motionSampleTime);
+
+    for (USDMeshReader *user : mesh_users_) {
+      if (Object *user_ob = user->object()) {
+        user_ob->data = mesh;
+        id_us_plus(&mesh->id);
+        BKE_object_materials_test(bmain, user_ob, &mesh->id);
+        if (user_ob->totcol > 0) {
+          user_ob->actcol = 1;
+        }
+      }
+    }
+    mesh_users_.clear();
+
+    face_indices_ = {};
+    face_counts_ = {};
+    positions_ = {};
+    normals_ = {};
+  }
 
   if (mesh_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
     is_time_varying_ = true;
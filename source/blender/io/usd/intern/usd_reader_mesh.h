@@ -10,6 +10,8 @@
 
 #include "pxr/usd/usdGeom/mesh.h"
 
+#include <vector>
+
 namespace blender::io::usd {
 
 class USDMeshReader : public USDGeomReader {
@@ -19,9 +21,8 @@ class USDMeshReader : public USDGeomReader {
   std::unordered_map<std::string, pxr::TfToken> uv_token_map_;
   std::map<const pxr::TfToken, bool> primvar_varying_map_;
 
-  /* TODO(makowalski): Is it the best strategy to cache the
-   * mesh geometry in the following members? It appears these
-   * arrays are never cleared, so this might bloat memory. */
+  /* Mesh geometry cached by #topology_changed. These arrays are cleared once the object data has
+   * been read, as every later call to #read_mesh reads them again. */
   pxr::VtIntArray face_indices_;
   pxr::VtIntArray face_counts_;
   pxr::VtVec3fArray positions_;
@@ -38,16 +39,34 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_;
 
+  /* The mesh read by #prepare_object_data, when it isn't the object data itself. */
+  Mesh *prepared_mesh_ = nullptr;
+  bool is_prepared_ = false;
+
+  /* Another instance of the same prototype, whose mesh data is used by this object instead of
+   * reading the same geometry again. */
+  USDMeshReader *mesh_source_ = nullptr;
+  /* The readers that use the mesh data of this reader. */
+  std::vector<USDMeshReader *> mesh_users_;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
                 const ImportSettings &settings);
+  ~USDMeshReader() override;
 
   bool valid() const override;
 
   void create_object(Main *bmain, double motionSampleTime) override;
+  void prepare_object_data(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
+  /**
+   * Use the mesh data of `source` instead of reading the geometry of this prim, which has to be
+   * identical. Must be called before #create_object.
+   */
+  void share_mesh_of(USDMeshReader *source);
+
   struct Mesh *read_mesh(struct Mesh *existing_mesh,
                          double motionSampleTime,
                          int read_flag,
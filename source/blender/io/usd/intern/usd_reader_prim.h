@@ -95,6 +95,11 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
+  /**
+   * Read the data of the prim that doesn't have to be added to the main database yet. This is
+   * called for all readers in parallel, after #create_object and before #read_object_data.
+   */
+  virtual void prepare_object_data(double /* motionSampleTime */){};
   virtual void read_object_data(Main * /* bmain */, double /* motionSampleTime */){};
 
   Object *object() const;
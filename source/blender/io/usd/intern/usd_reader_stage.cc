@@ -308,6 +308,33 @@ void USDStageReader::collect_readers(Main *bmain)
 
   stage_->SetInterpolationType(pxr::UsdInterpolationType::UsdInterpolationTypeHeld);
   collect_readers(bmain, root);
+
+  if (params_.import_instance_proxies) {
+    share_instanced_meshes();
+  }
+}
+
+void USDStageReader::share_instanced_meshes()
+{
+  std::map<pxr::SdfPath, USDMeshReader *> prototype_readers;
+
+  for (USDPrimReader *reader : readers_) {
+    USDMeshReader *mesh_reader = dynamic_cast<USDMeshReader *>(reader);
+    if (!mesh_reader || !mesh_reader->prim().IsInstanceProxy()) {
+      continue;
+    }
+
+#if PXR_VERSION >= 2011
+    const pxr::SdfPath prototype_path = mesh_reader->prim().GetPrimInPrototype().GetPath();
+#else
+    const pxr::SdfPath prototype_path = mesh_reader->prim().GetPrimInMaster().GetPath();
+#endif
+
+    const auto [it, is_first_instance] = prototype_readers.emplace(prototype_path, mesh_reader);
+    if (!is_first_instance) {
+      mesh_reader->share_mesh_of(it->second);
+    }
+  }
 }
 
 void USDStageReader::import_all_materials(Main *bmain)
@@ -83,6 +83,12 @@ class USDStageReader {
  private:
   USDPrimReader *collect_readers(Main *bmain, const pxr::UsdPrim &prim);
 
+  /**
+   * Let mesh readers of instance proxies with the same prototype share one mesh, instead of
+   * reading and storing a copy of the geometry for every instance.
+   */
+  void share_instanced_meshes();
+
   /**
    * Returns true if the given prim should be included in the
    * traversal based on the import options and the prim's visibility
@@ -11,6 +11,8 @@
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_attribute.hh"
@@ -32,6 +34,8 @@
 #include "DNA_particle_types.h"
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 namespace blender::io::usd {
 
@@ -57,19 +61,15 @@ void USDGenericMeshWriter::do_write(HierarchyContext &context)
     return;
   }
 
-  try {
-    write_mesh(context, mesh);
+  /* Define the prim right away, so that the order of the prims does not depend on staging. */
+  pxr::UsdGeomMesh::Define(usd_export_context_.stage, usd_export_context_.usd_path);
 
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-  }
-  catch (...) {
-    if (needsfree) {
-      free_export_mesh(mesh);
-    }
-    throw;
-  }
+  BLI_assert(staged_mesh_ == nullptr);
+  staged_context_ = context;
+  staged_mesh_ = mesh;
+  staged_mesh_needs_free_ = needsfree;
+  staged_first_frame_ = !frame_has_been_written_;
+  usd_export_context_.hierarchy_iterator->stage_mesh_writer(this);
 }
 
 void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
@@ -104,14 +104,58 @@ struct USDMeshData {
   pxr::VtIntArray corner_indices;
   /* The per-vertex sharpnesses. The lengths of this array must match that of `corner_indices`. */
   pxr::VtFloatArray corner_sharpnesses;
+
+  /* Face corner normals, empty when normals are not exported. */
+  pxr::VtVec3fArray normals;
+  /* The UV maps with their primvar names, empty when UV maps are not exported. */
+  std::vector<std::pair<pxr::TfToken, pxr::VtVec2fArray>> uv_maps;
+  /* Per-vertex velocities, empty when the mesh has no velocity attribute. */
+  pxr::VtVec3fArray velocities;
 };
 
-void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+/**
+ * Replace arrays that are equal to the ones of the previous frame with those. They share their
+ * buffer then, so that #pxr::UsdUtilsSparseValueWriter detects unchanged time samples without
+ * comparing every element, and only one copy is kept in memory.
+ */
+template<typename T>
+static void share_if_unchanged(pxr::VtArray<T> &array, const pxr::VtArray<T> &prev_array)
 {
-  pxr::UsdTimeCode timecode = get_export_time_code();
+  if (array == prev_array) {
+    array = prev_array;
+  }
+}
 
-  pxr::UsdGeomPrimvarsAPI primvarsAPI(usd_mesh.GetPrim());
+static void share_unchanged_arrays(USDMeshData &usd_mesh_data, const USDMeshData &prev_data)
+{
+  share_if_unchanged(usd_mesh_data.points, prev_data.points);
+  share_if_unchanged(usd_mesh_data.face_vertex_counts, prev_data.face_vertex_counts);
+  share_if_unchanged(usd_mesh_data.face_indices, prev_data.face_indices);
+  share_if_unchanged(usd_mesh_data.crease_lengths, prev_data.crease_lengths);
+  share_if_unchanged(usd_mesh_data.crease_vertex_indices, prev_data.crease_vertex_indices);
+  share_if_unchanged(usd_mesh_data.crease_sharpnesses, prev_data.crease_sharpnesses);
+  share_if_unchanged(usd_mesh_data.corner_indices, prev_data.corner_indices);
+  share_if_unchanged(usd_mesh_data.corner_sharpnesses, prev_data.corner_sharpnesses);
+  share_if_unchanged(usd_mesh_data.normals, prev_data.normals);
+  share_if_unchanged(usd_mesh_data.velocities, prev_data.velocities);
+  if (usd_mesh_data.uv_maps.size() == prev_data.uv_maps.size()) {
+    for (const int i : IndexRange(usd_mesh_data.uv_maps.size())) {
+      if (usd_mesh_data.uv_maps[i].first == prev_data.uv_maps[i].first) {
+        share_if_unchanged(usd_mesh_data.uv_maps[i].second, prev_data.uv_maps[i].second);
+      }
+    }
+  }
+}
+
+/** Resize `array` and return its elements, for filling them from multiple threads. */
+template<typename T> static MutableSpan<T> resize_usd_array(pxr::VtArray<T> &array, const int size)
+{
+  array.resize(size);
+  return MutableSpan<T>(array.data(), size);
+}
 
+static void get_uv_maps(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
   const CustomData *ldata = &mesh->ldata;
   for (int layer_idx = 0; layer_idx < ldata->totlayer; layer_idx++) {
     const CustomDataLayer *layer = &ldata->layers[layer_idx];
@@ -124,15 +168,30 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
      * for texture coordinates by naming the UV Map as such, without having to guess which UV Map
      * is the "standard" one. */
     pxr::TfToken primvar_name(pxr::TfMakeValidIdentifier(layer->name));
+    usd_mesh_data.uv_maps.emplace_back(primvar_name, pxr::VtVec2fArray());
+
+    const Span<float2> mloopuv(static_cast<const float2 *>(layer->data), mesh->totloop);
+    MutableSpan<pxr::GfVec2f> uv_coords = resize_usd_array(usd_mesh_data.uv_maps.back().second,
+                                                          mesh->totloop);
+    threading::parallel_for(mloopuv.index_range(), 4096, [&](const IndexRange range) {
+      for (const int loop_idx : range) {
+        uv_coords[loop_idx] = pxr::GfVec2f(mloopuv[loop_idx].x, mloopuv[loop_idx].y);
+      }
+    });
+  }
+}
+
+void USDGenericMeshWriter::write_uv_maps(const USDMeshData &usd_mesh_data,
+                                         pxr::UsdGeomMesh usd_mesh)
+{
+  pxr::UsdTimeCode timecode = get_export_time_code();
+
+  pxr::UsdGeomPrimvarsAPI primvarsAPI(usd_mesh.GetPrim());
+
+  for (const auto &[primvar_name, uv_coords] : usd_mesh_data.uv_maps) {
     pxr::UsdGeomPrimvar uv_coords_primvar = primvarsAPI.CreatePrimvar(
         primvar_name, pxr::SdfValueTypeNames->TexCoord2fArray, pxr::UsdGeomTokens->faceVarying);
 
-    const float2 *mloopuv = static_cast<const float2 *>(layer->data);
-    pxr::VtArray<pxr::GfVec2f> uv_coords;
-    for (int loop_idx = 0; loop_idx < mesh->totloop; loop_idx++) {
-      uv_coords.push_back(pxr::GfVec2f(mloopuv[loop_idx].x, mloopuv[loop_idx].y));
-    }
-
     if (!uv_coords_primvar.HasValue()) {
       uv_coords_primvar.Set(uv_coords, pxr::UsdTimeCode::Default());
     }
@@ -141,7 +200,8 @@ void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_
   }
 }
 
-void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
+void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
+                                      const USDMeshData &usd_mesh_data)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
   pxr::UsdTimeCode defaultTime = pxr::UsdTimeCode::Default();
@@ -151,11 +211,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
   write_visibility(context, timecode, usd_mesh);
 
-  USDMeshData usd_mesh_data;
-  /* Ensure data exists if currently in edit mode. */
-  BKE_mesh_wrapper_ensure_mdata(mesh);
-  get_geometry_data(mesh, usd_mesh_data);
-
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
       return;
@@ -229,16 +284,14 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
         attr_corner_sharpnesses, pxr::VtValue(usd_mesh_data.crease_sharpnesses), timecode);
   }
 
-  if (usd_export_context_.export_params.export_uvmaps) {
-    write_uv_maps(mesh, usd_mesh);
-  }
+  write_uv_maps(usd_mesh_data, usd_mesh);
   if (usd_export_context_.export_params.export_normals) {
-    write_normals(mesh, usd_mesh);
+    write_normals(usd_mesh_data, usd_mesh);
   }
-  write_surface_velocity(mesh, usd_mesh);
+  write_surface_velocity(usd_mesh_data, usd_mesh);
 
   /* TODO(Sybren): figure out what happens when the face groups change. */
-  if (frame_has_been_written_) {
+  if (!staged_first_frame_) {
     return;
   }
 
@@ -251,13 +304,14 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
 
 static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  usd_mesh_data.points.reserve(mesh->totvert);
-
   const Span<float3> positions = mesh->vert_positions();
-  for (const int i : positions.index_range()) {
-    const float3 &position = positions[i];
-    usd_mesh_data.points.push_back(pxr::GfVec3f(position.x, position.y, position.z));
-  }
+  MutableSpan<pxr::GfVec3f> points = resize_usd_array(usd_mesh_data.points, mesh->totvert);
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float3 &position = positions[i];
+      points[i] = pxr::GfVec3f(position.x, position.y, position.z);
+    }
+  });
 }
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -274,19 +328,21 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
     }
   }
 
-  usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
-  usd_mesh_data.face_indices.reserve(mesh->totloop);
-
   const Span<MPoly> polys = mesh->polys();
   const Span<MLoop> loops = mesh->loops();
 
-  for (const int i : polys.index_range()) {
-    const MPoly &poly = polys[i];
-    usd_mesh_data.face_vertex_counts.push_back(poly.totloop);
-    for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-      usd_mesh_data.face_indices.push_back(loop.v);
+  MutableSpan<int> face_vertex_counts = resize_usd_array(usd_mesh_data.face_vertex_counts,
+                                                         mesh->totpoly);
+  MutableSpan<int> face_indices = resize_usd_array(usd_mesh_data.face_indices, mesh->totloop);
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      face_vertex_counts[i] = poly.totloop;
+      for (const int loop_idx : IndexRange(poly.loopstart, poly.totloop)) {
+        face_indices[loop_idx] = loops[loop_idx].v;
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
@@ -330,12 +386,84 @@ static void get_vert_creases(const Mesh *mesh, USDMeshData &usd_mesh_data)
   }
 }
 
-void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_mesh_data)
+static void get_normals(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  const float(*lnors)[3] = static_cast<const float(*)[3]>(
+      CustomData_get_layer(&mesh->ldata, CD_NORMAL));
+  const Span<MPoly> polys = mesh->polys();
+  const Span<MLoop> loops = mesh->loops();
+
+  MutableSpan<pxr::GfVec3f> loop_normals = resize_usd_array(usd_mesh_data.normals,
+                                                            mesh->totloop);
+
+  if (lnors != nullptr) {
+    /* Export custom loop normals. */
+    threading::parallel_for(loop_normals.index_range(), 4096, [&](const IndexRange range) {
+      for (const int loop_idx : range) {
+        loop_normals[loop_idx] = pxr::GfVec3f(lnors[loop_idx]);
+      }
+    });
+    return;
+  }
+
+  /* Compute the loop normals based on the 'smooth' flag. */
+  const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
+  const float(*face_normals)[3] = BKE_mesh_poly_normals_ensure(mesh);
+  threading::parallel_for(polys.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = polys[i];
+      const IndexRange poly_loops(poly.loopstart, poly.totloop);
+
+      if ((poly.flag & ME_SMOOTH) == 0) {
+        /* Flat shaded, use common normal for all verts. */
+        loop_normals.slice(poly_loops).fill(pxr::GfVec3f(face_normals[i]));
+      }
+      else {
+        /* Smooth shaded, use individual vert normals. */
+        for (const int loop_idx : poly_loops) {
+          loop_normals[loop_idx] = pxr::GfVec3f(vert_normals[loops[loop_idx].v]);
+        }
+      }
+    }
+  });
+}
+
+static void get_surface_velocity(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  /* Export velocity attribute output by fluid sim, sequence cache modifier
+   * and geometry nodes. */
+  CustomDataLayer *velocity_layer = BKE_id_attribute_find(
+      &mesh->id, "velocity", CD_PROP_FLOAT3, ATTR_DOMAIN_POINT);
+
+  if (velocity_layer == nullptr) {
+    return;
+  }
+
+  const float(*velocities)[3] = reinterpret_cast<float(*)[3]>(velocity_layer->data);
+
+  /* Export per-vertex velocity vectors. */
+  MutableSpan<pxr::GfVec3f> usd_velocities = resize_usd_array(usd_mesh_data.velocities,
+                                                              mesh->totvert);
+  threading::parallel_for(usd_velocities.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vertex_idx : range) {
+      usd_velocities[vertex_idx] = pxr::GfVec3f(velocities[vertex_idx]);
+    }
+  });
+}
+
+void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_mesh_data) const
 {
   get_vertices(mesh, usd_mesh_data);
   get_loops_polys(mesh, usd_mesh_data);
   get_edge_creases(mesh, usd_mesh_data);
   get_vert_creases(mesh, usd_mesh_data);
+  if (usd_export_context_.export_params.export_uvmaps) {
+    get_uv_maps(mesh, usd_mesh_data);
+  }
+  if (usd_export_context_.export_params.export_normals) {
+    get_normals(mesh, usd_mesh_data);
+  }
+  get_surface_velocity(mesh, usd_mesh_data);
 }
 
 void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
@@ -411,77 +539,63 @@ void USDGenericMeshWriter::assign_materials(const HierarchyContext &context,
   }
 }
 
-void USDGenericMeshWriter::write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+void USDGenericMeshWriter::write_normals(const USDMeshData &usd_mesh_data,
+                                         pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
-  const float(*lnors)[3] = static_cast<const float(*)[3]>(
-      CustomData_get_layer(&mesh->ldata, CD_NORMAL));
-  const Span<MPoly> polys = mesh->polys();
-  const Span<MLoop> loops = mesh->loops();
-
-  pxr::VtVec3fArray loop_normals;
-  loop_normals.reserve(mesh->totloop);
-
-  if (lnors != nullptr) {
-    /* Export custom loop normals. */
-    for (int loop_idx = 0, totloop = mesh->totloop; loop_idx < totloop; ++loop_idx) {
-      loop_normals.push_back(pxr::GfVec3f(lnors[loop_idx]));
-    }
-  }
-  else {
-    /* Compute the loop normals based on the 'smooth' flag. */
-    const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(mesh);
-    const float(*face_normals)[3] = BKE_mesh_poly_normals_ensure(mesh);
-    for (const int i : polys.index_range()) {
-      const MPoly &poly = polys[i];
-
-      if ((poly.flag & ME_SMOOTH) == 0) {
-        /* Flat shaded, use common normal for all verts. */
-        pxr::GfVec3f pxr_normal(face_normals[i]);
-        for (int loop_idx = 0; loop_idx < poly.totloop; ++loop_idx) {
-          loop_normals.push_back(pxr_normal);
-        }
-      }
-      else {
-        /* Smooth shaded, use individual vert normals. */
-        for (const MLoop &loop : loops.slice(poly.loopstart, poly.totloop)) {
-          loop_normals.push_back(pxr::GfVec3f(vert_normals[loop.v]));
-        }
-      }
-    }
-  }
 
   pxr::UsdAttribute attr_normals = usd_mesh.CreateNormalsAttr(pxr::VtValue(), true);
   if (!attr_normals.HasValue()) {
-    attr_normals.Set(loop_normals, pxr::UsdTimeCode::Default());
+    attr_normals.Set(usd_mesh_data.normals, pxr::UsdTimeCode::Default());
   }
-  usd_value_writer_.SetAttribute(attr_normals, pxr::VtValue(loop_normals), timecode);
+  usd_value_writer_.SetAttribute(attr_normals, pxr::VtValue(usd_mesh_data.normals), timecode);
   usd_mesh.SetNormalsInterpolation(pxr::UsdGeomTokens->faceVarying);
 }
 
-void USDGenericMeshWriter::write_surface_velocity(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
+void USDGenericMeshWriter::write_surface_velocity(const USDMeshData &usd_mesh_data,
+                                                  pxr::UsdGeomMesh usd_mesh)
 {
-  /* Export velocity attribute output by fluid sim, sequence cache modifier
-   * and geometry nodes. */
-  CustomDataLayer *velocity_layer = BKE_id_attribute_find(
-      &mesh->id, "velocity", CD_PROP_FLOAT3, ATTR_DOMAIN_POINT);
-
-  if (velocity_layer == nullptr) {
+  if (usd_mesh_data.velocities.empty()) {
     return;
   }
 
-  const float(*velocities)[3] = reinterpret_cast<float(*)[3]>(velocity_layer->data);
+  pxr::UsdTimeCode timecode = get_export_time_code();
+  usd_value_writer_.SetAttribute(
+      usd_mesh.CreateVelocitiesAttr(), pxr::VtValue(usd_mesh_data.velocities), timecode);
+}
 
-  /* Export per-vertex velocity vectors. */
-  pxr::VtVec3fArray usd_velocities;
-  usd_velocities.reserve(mesh->totvert);
+USDGenericMeshWriter::~USDGenericMeshWriter() = default;
+
+void USDGenericMeshWriter::extract_staged_data()
+{
+  BLI_assert(staged_mesh_ != nullptr);
+  staged_data_ = std::make_unique<USDMeshData>();
+  /* Ensure data exists if currently in edit mode. */
+  BKE_mesh_wrapper_ensure_mdata(staged_mesh_);
+  get_geometry_data(staged_mesh_, *staged_data_);
+  if (prev_data_) {
+    share_unchanged_arrays(*staged_data_, *prev_data_);
+  }
+}
 
-  for (int vertex_idx = 0, totvert = mesh->totvert; vertex_idx < totvert; ++vertex_idx) {
-    usd_velocities.push_back(pxr::GfVec3f(velocities[vertex_idx]));
+void USDGenericMeshWriter::write_staged_data()
+{
+  BLI_assert(staged_data_);
+  write_mesh(*staged_context_, *staged_data_);
+  if (is_animated_) {
+    prev_data_ = std::move(staged_data_);
   }
+  discard_staged_data();
+}
 
-  pxr::UsdTimeCode timecode = get_export_time_code();
-  usd_mesh.CreateVelocitiesAttr().Set(usd_velocities, timecode);
+void USDGenericMeshWriter::discard_staged_data()
+{
+  if (staged_mesh_ != nullptr && staged_mesh_needs_free_) {
+    free_export_mesh(staged_mesh_);
+  }
+  staged_mesh_ = nullptr;
+  staged_context_.reset();
+  staged_data_.reset();
 }
 
 USDMeshWriter::USDMeshWriter(const USDExporterContext &ctx) : USDGenericMeshWriter(ctx)
@@ -4,16 +4,45 @@
 
 #include "usd_writer_abstract.h"
 
+#include <memory>
+#include <optional>
+
 #include <pxr/usd/usdGeom/mesh.h>
 
 namespace blender::io::usd {
 
 struct USDMeshData;
 
-/* Writer for USD geometry. Does not assume the object is a mesh object. */
+/**
+ * Writer for USD geometry. Does not assume the object is a mesh object.
+ *
+ * Writing is staged: #do_write only defines the prim and registers the writer with the hierarchy
+ * iterator. After all writers of a frame ran, the iterator calls #extract_staged_data for all
+ * staged mesh writers in parallel, and then #write_staged_data for each of them in order, as the
+ * USD stage cannot be modified from multiple threads.
+ */
 class USDGenericMeshWriter : public USDAbstractWriter {
+ private:
+  /* State of the current frame between #do_write and #write_staged_data. */
+  std::optional<HierarchyContext> staged_context_;
+  Mesh *staged_mesh_ = nullptr;
+  bool staged_mesh_needs_free_ = false;
+  bool staged_first_frame_ = false;
+  std::unique_ptr<USDMeshData> staged_data_;
+  /* Data written for the previous frame of an animated export. Arrays that did not change are
+   * shared with it, which makes the comparisons of the sparse value writer trivial. */
+  std::unique_ptr<USDMeshData> prev_data_;
+
  public:
   USDGenericMeshWriter(const USDExporterContext &ctx);
+  ~USDGenericMeshWriter();
+
+  /** Gather the USD data of the staged mesh. Does not access the USD stage. */
+  void extract_staged_data();
+  /** Write the extracted data to the USD stage. */
+  void write_staged_data();
+  /** Release the staged mesh without writing it. */
+  void discard_staged_data();
 
  protected:
   virtual bool is_supported(const HierarchyContext *context) const override;
@@ -26,14 +55,15 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   /* Mapping from material slot number to array of face indices with that material. */
   typedef std::map<short, pxr::VtIntArray> MaterialFaceGroups;
 
-  void write_mesh(HierarchyContext &context, Mesh *mesh);
-  void get_geometry_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data);
+  void write_mesh(HierarchyContext &context, const struct USDMeshData &usd_mesh_data);
+  void get_geometry_data(const Mesh *mesh, struct USDMeshData &usd_mesh_data) const;
   void assign_materials(const HierarchyContext &context,
                         pxr::UsdGeomMesh usd_mesh,
                         const MaterialFaceGroups &usd_face_groups);
-  void write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
-  void write_normals(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
-  void write_surface_velocity(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh);
+  void write_uv_maps(const struct USDMeshData &usd_mesh_data, pxr::UsdGeomMesh usd_mesh);
+  void write_normals(const struct USDMeshData &usd_mesh_data, pxr::UsdGeomMesh usd_mesh);
+  void write_surface_velocity(const struct USDMeshData &usd_mesh_data,
+                              pxr::UsdGeomMesh usd_mesh);
 };
 
 class USDMeshWriter : public USDGenericMeshWriter {
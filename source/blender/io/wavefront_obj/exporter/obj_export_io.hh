@@ -6,11 +6,14 @@
 
 #pragma once
 
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <string>
 #include <type_traits>
 #include <vector>
 
+#include "BLI_assert.h"
 #include "BLI_compiler_attrs.h"
 #include "BLI_fileops.h"
 #include "BLI_string_ref.hh"
@@ -71,19 +74,45 @@ class FormatHandler : NonCopyable, NonMovable {
 
   void write_obj_vertex(float x, float y, float z)
   {
-    write_impl("v {:.6f} {:.6f} {:.6f}\n", x, y, z);
+    char *p = begin_direct_write(2 + 3 * max_fixed_float_size + 1);
+    p = write_chars(p, "v");
+    p = write_fixed_float(p, x, 6);
+    p = write_fixed_float(p, y, 6);
+    p = write_fixed_float(p, z, 6);
+    *p++ = '\n';
+    end_direct_write(p);
   }
   void write_obj_vertex_color(float x, float y, float z, float r, float g, float b)
   {
-    write_impl("v {:.6f} {:.6f} {:.6f} {:.4f} {:.4f} {:.4f}\n", x, y, z, r, g, b);
+    char *p = begin_direct_write(2 + 6 * max_fixed_float_size + 1);
+    p = write_chars(p, "v");
+    p = write_fixed_float(p, x, 6);
+    p = write_fixed_float(p, y, 6);
+    p = write_fixed_float(p, z, 6);
+    p = write_fixed_float(p, r, 4);
+    p = write_fixed_float(p, g, 4);
+    p = write_fixed_float(p, b, 4);
+    *p++ = '\n';
+    end_direct_write(p);
   }
   void write_obj_uv(float x, float y)
   {
-    write_impl("vt {:.6f} {:.6f}\n", x, y);
+    char *p = begin_direct_write(2 + 2 * max_fixed_float_size + 1);
+    p = write_chars(p, "vt");
+    p = write_fixed_float(p, x, 6);
+    p = write_fixed_float(p, y, 6);
+    *p++ = '\n';
+    end_direct_write(p);
   }
   void write_obj_normal(float x, float y, float z)
   {
-    write_impl("vn {:.4f} {:.4f} {:.4f}\n", x, y, z);
+    char *p = begin_direct_write(2 + 3 * max_fixed_float_size + 1);
+    p = write_chars(p, "vn");
+    p = write_fixed_float(p, x, 4);
+    p = write_fixed_float(p, y, 4);
+    p = write_fixed_float(p, z, 4);
+    *p++ = '\n';
+    end_direct_write(p);
   }
   void write_obj_poly_begin()
   {
@@ -198,6 +227,81 @@ class FormatHandler : NonCopyable, NonMovable {
   }
 
  private:
+  /* Largest number of characters written by #write_fixed_float, including the leading space. The
+   * longest number is a negative float close to FLT_MAX, with 39 integer digits and 6 decimals. */
+  static constexpr size_t max_fixed_float_size = 48;
+
+  /* Reserve `size` characters at the end of the last block and return where to write them. */
+  char *begin_direct_write(size_t size)
+  {
+    ensure_space(size);
+    VectorChar &bb = blocks_.back();
+    const size_t old_size = bb.size();
+    bb.resize(old_size + size);
+    return bb.data() + old_size;
+  }
+
+  /* Shrink the last block to end at `end`, which is in the range from #begin_direct_write. */
+  void end_direct_write(const char *end)
+  {
+    VectorChar &bb = blocks_.back();
+    bb.resize(end - bb.data());
+  }
+
+  static char *write_chars(char *dst, const char *str)
+  {
+    while (*str) {
+      *dst++ = *str++;
+    }
+    return dst;
+  }
+
+  /**
+   * Write a space followed by `value` with `precision` decimals, giving the same text as
+   * formatting with `{:.6f}` or `{:.4f}` but much faster, which matters for large meshes.
+   *
+   * The product of a float and 10^precision is exact in double precision for precisions up to 6,
+   * so rounding it to an integer (half to even, like fmt and printf) gives the correctly rounded
+   * decimal digits. Values too large for that, infinity and NaN go through fmt.
+   */
+  static char *write_fixed_float(char *dst, const float value, const int precision)
+  {
+    static const double scales[7] = {1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+    BLI_assert(precision >= 0 && precision <= 6);
+
+    const double scaled = std::fabs(double(value)) * scales[precision];
+    if (!(scaled < 1e18)) {
+      fmt::format_to_n_result<char *> result = fmt::format_to_n(
+          dst, max_fixed_float_size, " {:.{}f}", value, precision);
+      return result.out;
+    }
+
+    *dst++ = ' ';
+    if (std::signbit(value)) {
+      *dst++ = '-';
+    }
+
+    uint64_t digits = uint64_t(std::nearbyint(scaled));
+    /* Write the digits backwards into a temporary buffer, decimals first. */
+    char tmp[24];
+    char *t = tmp + sizeof(tmp);
+    for (int i = 0; i < precision; i++) {
+      *--t = char('0' + digits % 10);
+      digits /= 10;
+    }
+    if (precision > 0) {
+      *--t = '.';
+    }
+    do {
+      *--t = char('0' + digits % 10);
+      digits /= 10;
+    } while (digits != 0);
+
+    const size_t len = size_t(tmp + sizeof(tmp) - t);
+    memcpy(dst, t, len);
+    return dst + len;
+  }
+
   /* Ensure the last block contains at least this amount of free space.
    * If not, add a new block with max of block size & the amount of space needed. */
   void ensure_space(size_t at_least)
@@ -31,10 +31,20 @@ class MeshFromGeometry : NonMovable, NonCopyable {
   {
   }
 
-  Object *create_mesh(Main *bmain,
-                      Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
-                      Map<std::string, Material *> &created_materials,
-                      const OBJImportParams &import_params);
+  /**
+   * Create the mesh data of the geometry without adding anything to #Main, so meshes of
+   * different geometries can be created in parallel. Returns null for an empty geometry.
+   */
+  Mesh *create_mesh(const OBJImportParams &import_params);
+  /**
+   * Add an object using a mesh from #create_mesh to #Main, along with its materials and vertex
+   * groups. The mesh is freed.
+   */
+  Object *create_mesh_object(Main *bmain,
+                             Mesh *mesh,
+                             Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
+                             Map<std::string, Material *> &created_materials,
+                             const OBJImportParams &import_params);
 
  private:
   /**
@@ -6,11 +6,13 @@
 
 #include <string>
 
+#include "BLI_array.hh"
 #include "BLI_map.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_set.hh"
 #include "BLI_sort.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "BKE_layer.h"
 #include "BKE_scene.h"
@@ -51,17 +53,31 @@ static void geometry_to_blender_objects(Main *bmain,
         return BLI_strcasecmp(na, nb) < 0;
       });
 
+  /* Create the mesh data in parallel, it doesn't depend on #Main. */
+  Array<Mesh *> meshes(all_geometries.size(), nullptr);
+  threading::parallel_for(all_geometries.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      Geometry &geometry = *all_geometries[i];
+      if (geometry.geom_type_ == GEOM_MESH) {
+        MeshFromGeometry mesh_ob_from_geometry{geometry, global_vertices};
+        meshes[i] = mesh_ob_from_geometry.create_mesh(import_params);
+      }
+    }
+  });
+
   /* Create all the objects. */
   Vector<Object *> objects;
   objects.reserve(all_geometries.size());
-  for (const std::unique_ptr<Geometry> &geometry : all_geometries) {
+  for (const int64_t i : all_geometries.index_range()) {
+    Geometry &geometry = *all_geometries[i];
     Object *obj = nullptr;
-    if (geometry->geom_type_ == GEOM_MESH) {
-      MeshFromGeometry mesh_ob_from_geometry{*geometry, global_vertices};
-      obj = mesh_ob_from_geometry.create_mesh(bmain, materials, created_materials, import_params);
+    if (meshes[i] != nullptr) {
+      MeshFromGeometry mesh_ob_from_geometry{geometry, global_vertices};
+      obj = mesh_ob_from_geometry.create_mesh_object(
+          bmain, meshes[i], materials, created_materials, import_params);
     }
-    else if (geometry->geom_type_ == GEOM_CURVE) {
-      CurveFromGeometry curve_ob_from_geometry(*geometry, global_vertices);
+    else if (geometry.geom_type_ == GEOM_CURVE) {
+      CurveFromGeometry curve_ob_from_geometry(geometry, global_vertices);
       obj = curve_ob_from_geometry.create_curve(bmain, import_params);
     }
     if (obj != nullptr) {
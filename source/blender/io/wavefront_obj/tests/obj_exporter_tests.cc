@@ -182,6 +182,27 @@ TEST(obj_exporter_writer, mtllib)
   BLI_delete(out_file_path.c_str(), false, false);
 }
 
+TEST(obj_exporter_writer, format_handler_fixed_floats)
+{
+  FormatHandler h;
+  h.write_obj_vertex(0.0f, -0.0f, 1.0f);
+  h.write_obj_vertex(-1.5f, 0.0078125f, 0.0234375f);
+  h.write_obj_vertex(123456.789f, -1e-9f, 1e20f);
+  h.write_obj_uv(0.33333334f, 0.66666669f);
+  h.write_obj_normal(0.00005f, -0.99995f, 0.5f);
+  h.write_obj_vertex_color(1.0f, 2.0f, 3.0f, 0.12345f, 1.0f, 0.0f);
+
+  const std::string got_string = h.get_as_string();
+  const char *expected = R"(v 0.000000 -0.000000 1.000000
+v -1.500000 0.007812 0.023438
+v 123456.789062 -0.000000 100000002004087734272.000000
+vt 0.333333 0.666667
+vn 0.0000 -0.9999 0.5000
+v 1.000000 2.000000 3.000000 0.1235 1.0000 0.0000
+)";
+  ASSERT_EQ(got_string, expected);
+}
+
 TEST(obj_exporter_writer, format_handler_buffer_chunking)
 {
   /* Use a tiny buffer chunk size, so that the test below ends up creating several blocks. */
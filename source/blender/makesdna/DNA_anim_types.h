@@ -627,6 +627,14 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Index of the keyframe at the end of the segment used by the last evaluation. Only a hint to
+   * avoid searching the keyframes from scratch during playback, it is validated before use.
+   * Run-time only, may be written by multiple threads.
+   */
+  int segment_hint;
+  char _pad2[4];
 } FCurve;
 
 /* user-editable flags/settings */
@@ -1101,6 +1109,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime cache of resolved RNA paths of F-Curves, only used by evaluated copies. */
+  struct AnimDataPathCache *path_cache;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
@@ -61,6 +61,12 @@ typedef struct Collection_Runtime {
   /** List of collections that are a parent of this data-block. */
   ListBase parents;
 
+  /**
+   * Lookup of #CollectionObject items of #Collection.gobject by their object, created on demand
+   * when objects are added or removed, so that linking many objects isn't quadratic.
+   */
+  struct GHash *gobject_hash;
+
   uint8_t tag;
 
   char _pad0[7];
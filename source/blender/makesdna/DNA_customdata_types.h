@@ -17,12 +17,17 @@ extern "C" {
 
 /** Workaround to forward-declare C++ type in C header. */
 #ifdef __cplusplus
-namespace blender::bke {
+namespace blender {
+class ImplicitSharingInfo;
+namespace bke {
 class AnonymousAttributeID;
-}  // namespace blender::bke
+}  // namespace bke
+}  // namespace blender
 using AnonymousAttributeIDHandle = blender::bke::AnonymousAttributeID;
+using ImplicitSharingInfoHandle = blender::ImplicitSharingInfo;
 #else
 typedef struct AnonymousAttributeIDHandle AnonymousAttributeIDHandle;
+typedef struct ImplicitSharingInfoHandle ImplicitSharingInfoHandle;
 #endif
 
 /** Descriptor and storage for a custom data layer. */
@@ -53,6 +58,12 @@ typedef struct CustomDataLayer {
    * attribute was created.
    */
   const AnonymousAttributeIDHandle *anonymous_id;
+  /**
+   * Run-time owner of #data when it is shared with other layers, see #CD_SHARE. Shared data must
+   * not be modified, use the `_for_write` accessors or #CustomData_ensure_layer_is_mutable to get
+   * a copy that is owned by this layer only. Null when the layer owns #data exclusively.
+   */
+  const ImplicitSharingInfoHandle *sharing_info;
 } CustomDataLayer;
 
 #define MAX_CUSTOMDATA_LAYER_NAME 68
@@ -251,7 +251,9 @@ typedef struct bGPDstroke_Runtime {
   int vertex_start;
   /** Curve Handles offset in the IBO where this handle starts. */
   int curve_start;
-  int _pad0;
+  /** Stroke was changed by update-on-write since the batch cache was last updated. */
+  char is_updated;
+  char _pad0[3];
 
   /** Original stroke (used to dereference evaluated data) */
   struct bGPDstroke *gps_orig;
@@ -634,7 +636,13 @@ typedef struct bGPdata_Runtime {
    */
   /** Flags for stroke that cache represents. */
   short sbuffer_sflag;
-  char _pad1[2];
+  /**
+   * Set when the batch cache is built, cleared when the evaluated strokes change in other ways
+   * than the ones tagged with `bGPDstroke_Runtime.is_updated`. While set, the batch cache only
+   * needs to update the tagged strokes.
+   */
+  char batch_cache_partial_update;
+  char _pad1[1];
   /** Number of elements currently used in cache. */
   int sbuffer_used;
   /** Number of total elements available in cache. */
@@ -103,6 +103,9 @@ typedef struct Key {
    * current free UID for key-blocks.
    */
   int uidgen;
+
+  /** Runtime offsets of relative shape keys for sparse evaluation, see `key.cc`. */
+  struct KeySparseDeltas *sparse_deltas;
 } Key;
 
 /* **************** KEY ********************* */
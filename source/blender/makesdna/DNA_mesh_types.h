@@ -333,7 +333,8 @@ enum {
 
 /** #Mesh.flag */
 enum {
-  ME_FLAG_UNUSED_0 = 1 << 0,     /* cleared */
+  /** Keep the triangulation when only vertex positions change, see #Mesh::looptris(). */
+  ME_STABLE_TRIANGULATION = 1 << 0,
   ME_FLAG_UNUSED_1 = 1 << 1,     /* cleared */
   ME_FLAG_DEPRECATED_2 = 1 << 2, /* deprecated */
   ME_FLAG_UNUSED_3 = 1 << 3,     /* cleared */
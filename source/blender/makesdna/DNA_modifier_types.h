@@ -2139,6 +2139,7 @@ enum {
   MOD_DATATRANSFER_OBSRC_TRANSFORM = 1 << 0,
   MOD_DATATRANSFER_MAP_MAXDIST = 1 << 1,
   MOD_DATATRANSFER_INVERT_VGROUP = 1 << 2,
+  MOD_DATATRANSFER_USE_CACHED_MAPPING = 1 << 3,
 
   /* Only for UI really. */
   MOD_DATATRANSFER_USE_VERT = 1 << 28,
@@ -620,6 +620,9 @@ typedef struct SpaceSeqRuntime {
   struct rctf last_thumbnail_area;
   /** Stores lists of most recently displayed thumbnails. */
   struct GHash *last_displayed_thumbnails;
+  /** Preview texture kept across redraws, with the image it was last uploaded from. */
+  struct GPUTexture *display_texture;
+  struct ImBuf *display_texture_ibuf;
   int rename_channel_index;
   float timeline_clamp_custom_range;
 } SpaceSeqRuntime;
@@ -4483,6 +4483,17 @@ static int rna_raw_access(ReportList *reports,
 
         size = RNA_raw_type_sizeof(out.type) * arraylen;
 
+        if (out.stride == size) {
+          /* The items are tightly packed, copy everything at once. */
+          if (set) {
+            memcpy(outp, inp, (size_t)size * out.len);
+          }
+          else {
+            memcpy(inp, outp, (size_t)size * out.len);
+          }
+          return 1;
+        }
+
         for (a = 0; a < out.len; a++) {
           if (set) {
             memcpy(outp, inp, size);
@@ -4498,8 +4509,29 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      /* Non-matching raw types, convert between the arrays directly
+       * instead of going through the item properties. */
+      if (ELEM(itemtype, PROP_BOOLEAN, PROP_INT, PROP_FLOAT)) {
+        RawArray item = out;
+        int a, j, i = 0;
+        double value;
+
+        for (a = 0; a < out.len; a++) {
+          item.array = (char *)out.array + (size_t)a * out.stride;
+          for (j = 0; j < arraylen; j++, i++) {
+            if (set) {
+              RAW_GET(double, value, in, i);
+              RAW_SET(double, item, j, value);
+            }
+            else {
+              RAW_GET(double, value, item, j);
+              RAW_SET(double, in, i, value);
+            }
+          }
+        }
+
+        return 1;
+      }
     }
   }
 
@@ -296,6 +296,8 @@ static void rna_Attribute_data_begin(CollectionPropertyIterator *iter, PointerRN
       break;
   }
 
+  /* The data is accessed for writing as well, make sure it is not shared with other layers. */
+  CustomData_ensure_layer_is_mutable(layer, length);
   rna_iterator_array_begin(iter, layer->data, struct_size, length, 0, NULL);
 }
 
@@ -266,6 +266,26 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_timeline_capture(Depsgraph *depsgraph, int frames)
+{
+  DEG_debug_eval_timeline_capture(depsgraph, frames);
+}
+
+static void rna_Depsgraph_debug_timeline_write(Depsgraph *depsgraph,
+                                               ReportList *reports,
+                                               const char *filename)
+{
+  FILE *f = fopen(filename, "w");
+  if (f == NULL) {
+    BKE_reportf(reports, RPT_ERROR, "Cannot open file '%s' for writing", filename);
+    return;
+  }
+  if (!DEG_debug_eval_timeline_write(depsgraph, f)) {
+    BKE_report(reports, RPT_WARNING, "No evaluation timeline has been captured");
+  }
+  fclose(f);
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -708,6 +728,30 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  func = RNA_def_function(
+      srna, "debug_timeline_capture", "rna_Depsgraph_debug_timeline_capture");
+  RNA_def_function_ui_description(
+      func,
+      "Capture which operation is evaluated when and on which thread, for the last evaluations of "
+      "the dependency graph");
+  RNA_def_int(func,
+              "frames",
+              16,
+              0,
+              INT_MAX,
+              "Frames",
+              "Number of evaluations to keep, zero stops the capture",
+              0,
+              1024);
+
+  func = RNA_def_function(srna, "debug_timeline_write", "rna_Depsgraph_debug_timeline_write");
+  RNA_def_function_ui_description(
+      func, "Write the captured evaluation timeline as Chrome trace (chrome://tracing, Perfetto)");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(
+      func, "filename", NULL, FILE_MAX, "File Name", "Output path for the trace file");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
@@ -4460,6 +4460,16 @@ static void rna_def_mesh(BlenderRNA *brna)
       "or use custom split normals data if available");
   RNA_def_property_update(prop, 0, "rna_Mesh_update_geom_and_params");
 
+  prop = RNA_def_property(srna, "use_stable_triangulation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", ME_STABLE_TRIANGULATION);
+  RNA_def_property_ui_text(
+      prop,
+      "Stable Triangulation",
+      "Keep the triangulation of quads and n-gons when the mesh is only deformed, instead of "
+      "triangulating it again for the new positions. Faster for deforming meshes, but strongly "
+      "deformed faces may use a worse triangulation");
+  RNA_def_property_update(prop, 0, "rna_Mesh_update_geom_and_params");
+
   prop = RNA_def_property(srna, "auto_smooth_angle", PROP_FLOAT, PROP_ANGLE);
   RNA_def_property_float_sdna(prop, NULL, "smoothresh");
   RNA_def_property_range(prop, 0.0f, DEG2RADF(180.0f));
@@ -182,9 +182,11 @@ static void rna_Mesh_split_faces(Mesh *mesh, bool UNUSED(free_loop_normals))
   ED_mesh_split_faces(mesh);
 }
 
-static void rna_Mesh_update_gpu_tag(Mesh *mesh)
+static void rna_Mesh_update_gpu_tag(Mesh *mesh, bool deform_only)
 {
-  BKE_mesh_batch_cache_dirty_tag(mesh, BKE_MESH_BATCH_DIRTY_ALL);
+  BKE_mesh_batch_cache_dirty_tag(mesh,
+                                 deform_only ? BKE_MESH_BATCH_DIRTY_DEFORM :
+                                               BKE_MESH_BATCH_DIRTY_ALL);
 }
 
 static void rna_Mesh_count_selected_items(Mesh *mesh, int r_count[3])
@@ -305,7 +307,12 @@ void RNA_api_mesh(StructRNA *srna)
                   "Calculate the loose state of each edge");
   RNA_def_function_flag(func, FUNC_USE_CONTEXT);
 
-  RNA_def_function(srna, "update_gpu_tag", "rna_Mesh_update_gpu_tag");
+  func = RNA_def_function(srna, "update_gpu_tag", "rna_Mesh_update_gpu_tag");
+  RNA_def_boolean(func,
+                  "deform_only",
+                  false,
+                  "Deform Only",
+                  "Only vertex positions changed, keep the GPU buffers that don't depend on them");
 
   func = RNA_def_function(srna, "unit_test_compare", "rna_Mesh_unit_test_compare");
   RNA_def_pointer(func, "mesh", "Mesh", "", "Mesh to compare to");
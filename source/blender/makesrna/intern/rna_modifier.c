@@ -19,6 +19,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_path_util.h"
 
 #include "BLT_translation.h"
 
@@ -748,7 +749,7 @@ static void rna_Modifier_update(Main *UNUSED(bmain), Scene *UNUSED(scene), Point
 static void rna_Modifier_dependency_update(Main *bmain, Scene *scene, PointerRNA *ptr)
 {
   rna_Modifier_update(bmain, scene, ptr);
-  DEG_relations_tag_update(bmain);
+  DEG_id_tag_relations_update(bmain, ptr->owner_id);
 }
 
 static void rna_Modifier_is_active_set(PointerRNA *ptr, bool value)
@@ -1679,6 +1680,21 @@ static void rna_NodesModifier_node_group_update(Main *bmain, Scene *scene, Point
   MOD_nodes_update_interface(object, nmd);
 }
 
+static void rna_NodesModifier_debug_timing_trace_write(NodesModifierData *nmd,
+                                                       ReportList *reports,
+                                                       const char *filepath)
+{
+  FILE *f = fopen(filepath, "w");
+  if (f == NULL) {
+    BKE_reportf(reports, RPT_ERROR, "Cannot open file '%s' for writing", filepath);
+    return;
+  }
+  if (!MOD_nodes_write_timing_trace(nmd, f)) {
+    BKE_report(reports, RPT_WARNING, "No node execution times have been logged");
+  }
+  fclose(f);
+}
+
 static IDProperty **rna_NodesModifier_properties(PointerRNA *ptr)
 {
   NodesModifierData *nmd = ptr->data;
@@ -6591,6 +6607,16 @@ static void rna_def_modifier_datatransfer(BlenderRNA *brna)
   RNA_def_property_subtype(prop, PROP_DISTANCE);
   RNA_def_property_update(prop, 0, "rna_Modifier_update");
 
+  prop = RNA_def_boolean(srna,
+                         "use_cached_mapping",
+                         false,
+                         "Keep Mapping",
+                         "Compute the mapping between source and destination elements once and "
+                         "reuse it as long as the element counts and mapping settings do not "
+                         "change, even when the meshes are deformed or moved");
+  RNA_def_property_boolean_sdna(prop, NULL, "flags", MOD_DATATRANSFER_USE_CACHED_MAPPING);
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_float(
       srna,
       "islands_precision",
@@ -7018,6 +7044,8 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
 {
   StructRNA *srna;
   PropertyRNA *prop;
+  FunctionRNA *func;
+  PropertyRNA *parm;
 
   srna = RNA_def_struct(brna, "NodesModifier", "Modifier");
   RNA_def_struct_ui_text(srna, "Nodes Modifier", "");
@@ -7034,6 +7062,16 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   RNA_def_property_update(prop, 0, "rna_NodesModifier_node_group_update");
 
   RNA_define_lib_overridable(false);
+
+  func = RNA_def_function(
+      srna, "debug_timing_trace_write", "rna_NodesModifier_debug_timing_trace_write");
+  RNA_def_function_ui_description(func,
+                                  "Write the execution time of every node from the latest "
+                                  "evaluation in the Chrome trace event format");
+  RNA_def_function_flag(func, FUNC_USE_REPORTS);
+  parm = RNA_def_string_file_path(
+      func, "filepath", NULL, FILE_MAX, "File Path", "File to write the trace to");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 }
 
 static void rna_def_modifier_mesh_to_volume(BlenderRNA *brna)
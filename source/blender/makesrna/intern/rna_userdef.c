@@ -5501,6 +5501,13 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, NULL, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  prop = RNA_def_property(srna, "use_video_hardware_decode", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "video_flag", USER_VIDEO_HW_DECODE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movies on the GPU when supported by the codec and the system, "
+                           "applies to movies opened afterwards");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -5604,6 +5611,16 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "Texture Collection Rate",
       "Number of seconds between each run of the GL texture garbage collector");
 
+  prop = RNA_def_property(srna, "texture_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "texture_memory_limit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_ui_text(
+      prop,
+      "Texture Memory Limit",
+      "Graphics memory in megabytes that image textures may use before the least recently used "
+      "ones are freed (set to 0 to disable)");
+
   prop = RNA_def_property(srna, "vbo_time_out", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "vbotimeout");
   RNA_def_property_range(prop, 0, 3600);
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include <stdio.h>
+
 struct NodesModifierData;
 struct Object;
 
@@ -16,6 +18,13 @@ extern "C" {
  */
 void MOD_nodes_update_interface(struct Object *object, struct NodesModifierData *nmd);
 
+/**
+ * Write the node execution times of the latest evaluation of the modifier in the Chrome trace
+ * event format. Returns false when there is no logged evaluation, e.g. when the modifier has not
+ * been evaluated in the active depsgraph yet.
+ */
+bool MOD_nodes_write_timing_trace(const struct NodesModifierData *nmd, FILE *fp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -149,6 +149,17 @@ static bool isDisabled(const struct Scene * /*scene*/, ModifierData *md, bool /*
   (DT_TYPE_BWEIGHT_VERT | DT_TYPE_BWEIGHT_EDGE | DT_TYPE_CREASE | DT_TYPE_SHARP_EDGE | \
    DT_TYPE_LNOR | DT_TYPE_SHARP_FACE)
 
+static void freeRuntimeData(void *runtime_data)
+{
+  BKE_data_transfer_remap_cache_free(static_cast<DataTransferRemapCache *>(runtime_data));
+}
+
+static void freeData(ModifierData *md)
+{
+  freeRuntimeData(md->runtime);
+  md->runtime = nullptr;
+}
+
 static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *me_mod)
 {
   DataTransferModifierData *dtmd = (DataTransferModifierData *)md;
@@ -187,6 +198,18 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
     result = (Mesh *)BKE_id_copy_ex(nullptr, &me_mod->id, nullptr, LIB_ID_COPY_LOCALIZE);
   }
 
+  DataTransferRemapCache *remap_cache = nullptr;
+  if (dtmd->flags & MOD_DATATRANSFER_USE_CACHED_MAPPING) {
+    if (md->runtime == nullptr) {
+      md->runtime = BKE_data_transfer_remap_cache_new();
+    }
+    remap_cache = static_cast<DataTransferRemapCache *>(md->runtime);
+  }
+  else if (md->runtime) {
+    BKE_data_transfer_remap_cache_free(static_cast<DataTransferRemapCache *>(md->runtime));
+    md->runtime = nullptr;
+  }
+
   BKE_reports_init(&reports, RPT_STORE);
 
   /* NOTE: no islands precision for now here. */
@@ -212,6 +235,7 @@ static Mesh *modifyMesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh *
                                   dtmd->mix_factor,
                                   dtmd->defgrp_name,
                                   invert_vgroup,
+                                  remap_cache,
                                   &reports)) {
     result->runtime->is_original_bmesh = false;
   }
@@ -435,6 +459,7 @@ static void advanced_panel_draw(const bContext * /*C*/, Panel *panel)
   uiItemR(sub, ptr, "max_distance", 0, "", ICON_NONE);
 
   uiItemR(layout, ptr, "ray_radius", 0, nullptr, ICON_NONE);
+  uiItemR(layout, ptr, "use_cached_mapping", 0, nullptr, ICON_NONE);
 }
 
 static void panelRegister(ARegionType *region_type)
@@ -500,14 +525,14 @@ ModifierTypeInfo modifierType_DataTransfer = {
 
     /*initData*/ initData,
     /*requiredDataMask*/ requiredDataMask,
-    /*freeData*/ nullptr,
+    /*freeData*/ freeData,
     /*isDisabled*/ isDisabled,
     /*updateDepsgraph*/ updateDepsgraph,
     /*dependsOnTime*/ nullptr,
     /*dependsOnNormals*/ dependsOnNormals,
     /*foreachIDLink*/ foreachIDLink,
     /*foreachTexLink*/ nullptr,
-    /*freeRuntimeData*/ nullptr,
+    /*freeRuntimeData*/ freeRuntimeData,
     /*panelRegister*/ panelRegister,
     /*blendWrite*/ nullptr,
     /*blendRead*/ nullptr,
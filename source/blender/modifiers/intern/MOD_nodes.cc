@@ -84,6 +84,7 @@
 #include "ED_viewer_path.hh"
 
 #include "NOD_geometry.h"
+#include "NOD_geometry_nodes_eval_cache.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_node_declaration.hh"
 
@@ -1169,6 +1170,16 @@ static GeometrySet compute_geometry(
   blender::bke::ModifierComputeContext modifier_compute_context{nullptr, nmd->modifier.name};
   user_data.compute_context = &modifier_compute_context;
 
+  /* The cache lives in the runtime data of the evaluated modifier, so that it is kept across
+   * frames and copy-on-write updates. */
+  if (nmd->modifier.runtime == nullptr) {
+    nmd->modifier.runtime = new blender::nodes::GeoNodesEvalCache();
+  }
+  blender::nodes::GeoNodesEvalCache &eval_cache = *static_cast<blender::nodes::GeoNodesEvalCache *>(
+      nmd->modifier.runtime);
+  geo_nodes_modifier_data.eval_cache = &eval_cache;
+  eval_cache.begin_evaluation();
+
   blender::LinearAllocator<> allocator;
   Vector<GMutablePointer> inputs_to_destruct;
 
@@ -1220,6 +1231,7 @@ static GeometrySet compute_geometry(
                             param_set_outputs};
   graph_executor.execute(lf_params, lf_context);
   graph_executor.destruct_storage(lf_context.storage);
+  eval_cache.end_evaluation();
 
   for (GMutablePointer &ptr : inputs_to_destruct) {
     ptr.destruct();
@@ -1934,6 +1946,20 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   }
 }
 
+bool MOD_nodes_write_timing_trace(const NodesModifierData *nmd, FILE *fp)
+{
+  if (nmd->runtime_eval_log == nullptr || nmd->node_group == nullptr) {
+    return false;
+  }
+  GeoModifierLog &modifier_log = *static_cast<GeoModifierLog *>(nmd->runtime_eval_log);
+  return modifier_log.write_chrome_trace(fp, *nmd->node_group, nmd->modifier.name);
+}
+
+static void freeRuntimeData(void *runtime_data)
+{
+  delete static_cast<blender::nodes::GeoNodesEvalCache *>(runtime_data);
+}
+
 static void freeData(ModifierData *md)
 {
   NodesModifierData *nmd = reinterpret_cast<NodesModifierData *>(md);
@@ -1943,6 +1969,8 @@ static void freeData(ModifierData *md)
   }
 
   clear_runtime_data(nmd);
+  freeRuntimeData(md->runtime);
+  md->runtime = nullptr;
 }
 
 static void requiredDataMask(ModifierData * /*md*/, CustomData_MeshMasks *r_cddata_masks)
@@ -1984,7 +2012,7 @@ ModifierTypeInfo modifierType_Nodes = {
     /*dependsOnNormals*/ nullptr,
     /*foreachIDLink*/ foreachIDLink,
     /*foreachTexLink*/ foreachTexLink,
-    /*freeRuntimeData*/ nullptr,
+    /*freeRuntimeData*/ freeRuntimeData,
     /*panelRegister*/ panelRegister,
     /*blendWrite*/ blendWrite,
     /*blendRead*/ blendRead,
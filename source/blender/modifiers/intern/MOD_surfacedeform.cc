@@ -1276,6 +1276,7 @@ static bool surfacedeformBind(Object *ob,
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (verts_num > 10000);
+  settings.min_iter_per_thread = 64;
   BLI_task_parallel_range(0, verts_num, &data, bindVert, &settings);
 
   MEM_freeN(data.targetCos);
@@ -1354,48 +1355,53 @@ static void deformVert(void *__restrict userdata,
 
   zero_v3(offset);
 
-  int max_verts = 0;
-  for (int j = 0; j < sdbind_num; j++) {
-    max_verts = MAX2(max_verts, sdbind[j].verts_num);
-  }
-
-  /* Allocate a `coords_buffer` that fits all the temp-data. */
-  blender::Array<blender::float3, 256> coords_buffer(max_verts);
+  const float(*target_cos)[3] = data->targetCos;
 
   for (int j = 0; j < sdbind_num; j++, sdbind++) {
-    for (int k = 0; k < sdbind->verts_num; k++) {
-      copy_v3_v3(coords_buffer[k], data->targetCos[sdbind->vert_inds[k]]);
+    const uint *vert_inds = sdbind->vert_inds;
+    const uint verts_num = sdbind->verts_num;
+
+    /* Same as #normal_poly_v3, but read the target coordinates directly instead of gathering
+     * them into a temporary array first. */
+    zero_v3(norm);
+    const float *v_prev = target_cos[vert_inds[verts_num - 1]];
+    for (uint k = 0; k < verts_num; k++) {
+      const float *v_curr = target_cos[vert_inds[k]];
+      add_newell_cross_v3_v3v3(norm, v_prev, v_curr);
+      v_prev = v_curr;
     }
-
-    normal_poly_v3(
-        norm, reinterpret_cast<const float(*)[3]>(coords_buffer.data()), sdbind->verts_num);
+    normalize_v3(norm);
     zero_v3(temp);
 
     switch (sdbind->mode) {
       /* ---------- looptri mode ---------- */
       case MOD_SDEF_MODE_LOOPTRI: {
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[0]], sdbind->vert_weights[0]);
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[1]], sdbind->vert_weights[1]);
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[2]], sdbind->vert_weights[2]);
+        madd_v3_v3fl(temp, target_cos[vert_inds[0]], sdbind->vert_weights[0]);
+        madd_v3_v3fl(temp, target_cos[vert_inds[1]], sdbind->vert_weights[1]);
+        madd_v3_v3fl(temp, target_cos[vert_inds[2]], sdbind->vert_weights[2]);
         break;
       }
 
       /* ---------- ngon mode ---------- */
       case MOD_SDEF_MODE_NGON: {
-        for (int k = 0; k < sdbind->verts_num; k++) {
-          madd_v3_v3fl(temp, coords_buffer[k], sdbind->vert_weights[k]);
+        for (uint k = 0; k < verts_num; k++) {
+          madd_v3_v3fl(temp, target_cos[vert_inds[k]], sdbind->vert_weights[k]);
         }
         break;
       }
 
       /* ---------- centroid mode ---------- */
       case MOD_SDEF_MODE_CENTROID: {
+        /* Same as #mid_v3_v3_array. */
         float cent[3];
-        mid_v3_v3_array(
-            cent, reinterpret_cast<const float(*)[3]>(coords_buffer.data()), sdbind->verts_num);
+        const float factor = 1.0f / float(verts_num);
+        zero_v3(cent);
+        for (uint k = 0; k < verts_num; k++) {
+          madd_v3_v3fl(cent, target_cos[vert_inds[k]], factor);
+        }
 
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[0]], sdbind->vert_weights[0]);
-        madd_v3_v3fl(temp, data->targetCos[sdbind->vert_inds[1]], sdbind->vert_weights[1]);
+        madd_v3_v3fl(temp, target_cos[vert_inds[0]], sdbind->vert_weights[0]);
+        madd_v3_v3fl(temp, target_cos[vert_inds[1]], sdbind->vert_weights[1]);
         madd_v3_v3fl(temp, cent, sdbind->vert_weights[2]);
         break;
       }
@@ -1550,6 +1556,8 @@ static void surfacedeformModifier_do(ModifierData *md,
     TaskParallelSettings settings;
     BLI_parallel_range_settings_defaults(&settings);
     settings.use_threading = (smd->bind_verts_num > 10000);
+    /* Deforming a single vertex is cheap, avoid scheduling every vertex as a separate task. */
+    settings.min_iter_per_thread = 1024;
     BLI_task_parallel_range(0, smd->bind_verts_num, &data, deformVert, &settings);
 
     MEM_freeN(data.targetCos);
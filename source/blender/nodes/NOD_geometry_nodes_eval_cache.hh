@@ -0,0 +1,135 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/**
+ * The evaluation cache remembers the outputs of some nodes across evaluations of the same
+ * geometry nodes modifier. When such a node is evaluated again with the same inputs and the same
+ * node properties, its outputs are reused instead of running the node again. This way e.g. an
+ * expensive scatter does not have to run again when only a node further down the tree changed or
+ * when the frame changed without affecting the inputs of the scatter.
+ *
+ * Only nodes that are known to depend on nothing but their inputs and their properties are
+ * cached, see #GeoNodesEvalCache::node_supports_caching. Inputs are compared by value, except for
+ * geometries and fields, which are compared by identity. A cached input keeps its geometry
+ * components alive, so a component that is still the same pointer is known to be unchanged.
+ *
+ * The cache is owned by the evaluated modifier and survives copy-on-write updates of the node
+ * tree, because the nodes are identified by their compute context and their identifier and not
+ * by pointer.
+ */
+
+#include <mutex>
+
+#include "BLI_compute_context.hh"
+#include "BLI_generic_pointer.hh"
+#include "BLI_linear_allocator.hh"
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "FN_lazy_function.hh"
+
+struct bNode;
+
+namespace blender::nodes {
+
+namespace lf = fn::lazy_function;
+
+class GeoNodesEvalCache : NonCopyable, NonMovable {
+ public:
+  struct NodeKey {
+    ComputeContextHash context_hash;
+    int32_t node_identifier;
+
+    uint64_t hash() const
+    {
+      return get_default_hash_2(context_hash.hash(), node_identifier);
+    }
+
+    friend bool operator==(const NodeKey &a, const NodeKey &b)
+    {
+      return a.context_hash == b.context_hash && a.node_identifier == b.node_identifier;
+    }
+  };
+
+  /**
+   * Copies of the inputs and outputs of one node evaluation. Outputs that were not computed are
+   * null.
+   */
+  struct Entry {
+    LinearAllocator<> allocator;
+    /** Raw copy of the node type, its custom properties and its storage. */
+    Vector<std::byte> node_properties;
+    Vector<GMutablePointer> inputs;
+    Vector<GMutablePointer> outputs;
+    /** Value of #GeoNodesEvalCache::evaluation_counter_ when the entry was used last. */
+    int64_t last_used = 0;
+
+    ~Entry();
+  };
+
+ private:
+  std::mutex mutex_;
+  Map<NodeKey, std::unique_ptr<Entry>> entries_;
+  int64_t evaluation_counter_ = 0;
+
+ public:
+  /**
+   * True for nodes whose outputs only depend on their inputs and properties and that are usually
+   * expensive enough to make caching worth it.
+   */
+  static bool node_supports_caching(const bNode &node);
+
+  /** Has to be called before the modifier evaluates the node tree. */
+  void begin_evaluation();
+  /** Frees the entries of nodes that were not evaluated since #begin_evaluation. */
+  void end_evaluation();
+
+  /**
+   * Set all outputs of the node from the cache if it was evaluated with the same inputs before.
+   * Returns false if the node has to be executed.
+   */
+  bool try_reuse_outputs(const NodeKey &key,
+                         const bNode &node,
+                         const lf::LazyFunction &fn,
+                         lf::Params &params);
+
+  /**
+   * Copy the inputs of the node before it is executed, so that they can be compared in the next
+   * evaluation. Returns null when the inputs cannot be compared reliably.
+   */
+  std::unique_ptr<Entry> create_entry(const bNode &node,
+                                      const lf::LazyFunction &fn,
+                                      const lf::Params &params) const;
+
+  /** Add the entry after the outputs have been copied into it. */
+  void add_entry(const NodeKey &key, std::unique_ptr<Entry> entry);
+};
+
+/**
+ * Forwards all accesses to the wrapped params, but also copies every output into the cache entry
+ * before it is passed on.
+ */
+class GeoNodesEvalCacheParams : public lf::Params {
+ private:
+  lf::Params &params_;
+  GeoNodesEvalCache::Entry &entry_;
+
+ public:
+  GeoNodesEvalCacheParams(const lf::LazyFunction &fn,
+                          lf::Params &params,
+                          GeoNodesEvalCache::Entry &entry);
+
+ private:
+  void *try_get_input_data_ptr_impl(int index) const override;
+  void *try_get_input_data_ptr_or_request_impl(int index) override;
+  void *get_output_data_ptr_impl(int index) override;
+  void output_set_impl(int index) override;
+  bool output_was_set_impl(int index) const override;
+  lf::ValueUsage get_output_usage_impl(int index) const override;
+  void set_input_unused_impl(int index) override;
+  bool try_enable_multi_threading_impl() override;
+};
+
+}  // namespace blender::nodes
@@ -34,6 +34,8 @@ namespace blender::nodes {
 using lf::LazyFunction;
 using mf::MultiFunction;
 
+class GeoNodesEvalCache;
+
 /**
  * Data that is passed into geometry nodes evaluation from the modifier.
  */
@@ -57,6 +59,8 @@ struct GeoNodesModifierData {
    * If this is null, all socket values will be logged.
    */
   const Set<ComputeContextHash> *socket_log_contexts = nullptr;
+  /** Optional cache for the outputs of expensive nodes from previous evaluations. */
+  GeoNodesEvalCache *eval_cache = nullptr;
 };
 
 /**
@@ -25,6 +25,7 @@
  */
 
 #include <chrono>
+#include <cstdio>
 
 #include "BLI_compute_context.hh"
 #include "BLI_enumerable_thread_specific.hh"
@@ -328,6 +329,14 @@ class GeoModifierLog {
    */
   GeoTreeLog &get_tree_log(const ComputeContextHash &compute_context_hash);
 
+  /**
+   * Write the execution time of every node in the Chrome trace event format, which can be opened
+   * in `chrome://tracing` or Perfetto. Every thread that executed nodes becomes a separate track.
+   * The sizes of output geometries are added when their socket values were logged. The tree is
+   * used to find the names of the nodes. Returns false when no node execution was logged.
+   */
+  bool write_chrome_trace(FILE *file, const bNodeTree &tree, StringRefNull modifier_name);
+
   /**
    * Utility accessor to logged data.
    */
@@ -5,17 +5,26 @@
  * \ingroup cmpnodes
  */
 
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_math_vector_types.hh"
+
 #include "BLT_translation.h"
 
 #include "UI_interface.h"
 #include "UI_resources.h"
 
+#include "GPU_shader.h"
+
 #include "COM_node_operation.hh"
+#include "COM_utilities.hh"
 
 #include "node_composite_util.hh"
 
 namespace blender::nodes::node_composite_sunbeams_cc {
 
+NODE_STORAGE_FUNCS(NodeSunBeams)
+
 static void cmp_node_sunbeams_declare(NodeDeclarationBuilder &b)
 {
   b.add_input<decl::Color>(N_("Image")).default_value({1.0f, 1.0f, 1.0f, 1.0f});
@@ -50,8 +59,38 @@ class SunBeamsOperation : public NodeOperation {
 
   void execute() override
   {
-    get_input("Image").pass_through(get_result("Image"));
-    context().set_info_message("Viewport compositor setup not fully supported");
+    /* Single value inputs can't have beams and are returned as is. */
+    if (get_input("Image").is_single_value()) {
+      get_input("Image").pass_through(get_result("Image"));
+      return;
+    }
+
+    GPUShader *shader = shader_manager().get("compositor_sun_beams");
+    GPU_shader_bind(shader);
+
+    /* The source and the ray length are relative to the image size, convert them to pixels. */
+    const Result &input_image = get_input("Image");
+    const float2 input_size = float2(input_image.domain().size);
+    const float2 source = float2(node_storage(bnode()).source);
+    const float max_ray_length = node_storage(bnode()).ray_length *
+                                 math::max(input_size.x, input_size.y);
+    GPU_shader_uniform_2fv(shader, "source", source * input_size);
+    GPU_shader_uniform_1f(shader, "max_ray_length", max_ray_length);
+
+    input_image.bind_as_texture(shader, "input_tx");
+    GPU_texture_filter_mode(input_image.texture(), false);
+    GPU_texture_wrap_mode(input_image.texture(), false, false);
+
+    const Domain domain = compute_domain();
+    Result &output_image = get_result("Image");
+    output_image.allocate_texture(domain);
+    output_image.bind_as_image(shader, "output_img");
+
+    compute_dispatch_threads_at_least(shader, domain.size);
+
+    GPU_shader_unbind();
+    output_image.unbind_as_image();
+    input_image.unbind_as_texture();
   }
 };
 
@@ -75,8 +114,6 @@ void register_node_type_cmp_sunbeams()
   node_type_storage(
       &ntype, "NodeSunBeams", node_free_standard_storage, node_copy_standard_storage);
   ntype.get_compositor_operation = file_ns::get_compositor_operation;
-  ntype.realtime_compositor_unsupported_message = N_(
-      "Node not supported in the Viewport compositor");
 
   nodeRegisterType(&ntype);
 }
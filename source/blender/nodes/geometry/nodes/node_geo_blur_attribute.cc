@@ -147,12 +147,10 @@ static Array<Vector<int>> build_vert_to_vert_by_edge_map(const Span<MEdge> edges
 }
 
 static Array<Vector<int>> build_edge_to_edge_by_vert_map(const Span<MEdge> edges,
-                                                         const int verts_num,
+                                                         const Span<Vector<int>> vert_to_edge_map,
                                                          const IndexMask edge_mask)
 {
   Array<Vector<int>> map(edges.size());
-  Array<Vector<int>> vert_to_edge_map = bke::mesh_topology::build_vert_to_edge_map(edges,
-                                                                                   verts_num);
 
   threading::parallel_for(edge_mask.index_range(), 1024, [&](IndexRange range) {
     for (const int edge_i : edge_mask.slice(range)) {
@@ -230,8 +228,8 @@ static Array<Vector<int>> create_mesh_map(const Mesh &mesh,
     }
     case ATTR_DOMAIN_EDGE: {
       const Span<MEdge> edges = mesh.edges();
-      const int verts_num = mesh.totvert;
-      return build_edge_to_edge_by_vert_map(edges, verts_num, mask);
+      const Span<Vector<int>> vert_to_edge_map = bke::mesh_topology::vert_to_edge_map(mesh);
+      return build_edge_to_edge_by_vert_map(edges, vert_to_edge_map, mask);
     }
     case ATTR_DOMAIN_FACE: {
       const Span<MPoly> polys = mesh.polys();
@@ -4,8 +4,11 @@
 #  include <openvdb/openvdb.h>
 #  include <openvdb/tools/Interpolation.h>
 #  include <openvdb/tools/PointScatter.h>
+#  include <openvdb/tree/LeafManager.h>
 #endif
 
+#include "BLI_task.hh"
+
 #include "DNA_node_types.h"
 #include "DNA_pointcloud_types.h"
 
@@ -144,21 +147,17 @@ static void point_scatter_density_grid(const openvdb::FloatGrid &grid,
     return;
   }
 
-  /* Iterate through tiles and voxels on the grid. */
-  for (openvdb::FloatGrid::ValueOnCIter cell = grid.cbeginValueOn(); cell; ++cell) {
-    /* Check if the cell's value meets the minimum threshold. */
-    if (cell.getValue() < threshold) {
-      continue;
-    }
+  const double abs_spacing_x = std::abs(voxel_spacing.x());
+  const double abs_spacing_y = std::abs(voxel_spacing.y());
+  const double abs_spacing_z = std::abs(voxel_spacing.z());
+
+  const auto add_points_in_cell = [&](const openvdb::CoordBBox &bbox,
+                                      Vector<float3> &r_cell_positions) {
     /* Compute the bounding box of each tile/voxel. */
-    const openvdb::CoordBBox bbox = cell.getBoundingBox();
     const openvdb::Vec3d box_min = bbox.min().asVec3d() - half_voxel;
     const openvdb::Vec3d box_max = bbox.max().asVec3d() + half_voxel;
 
     /* Pick a starting point rounded up to the nearest possible point. */
-    double abs_spacing_x = std::abs(voxel_spacing.x());
-    double abs_spacing_y = std::abs(voxel_spacing.y());
-    double abs_spacing_z = std::abs(voxel_spacing.z());
     const openvdb::Vec3d start(ceil(box_min.x() / abs_spacing_x) * abs_spacing_x,
                                ceil(box_min.y() / abs_spacing_y) * abs_spacing_y,
                                ceil(box_min.z() / abs_spacing_z) * abs_spacing_z);
@@ -170,10 +169,53 @@ static void point_scatter_density_grid(const openvdb::FloatGrid &grid,
           /* Transform with grid matrix and add point. */
           const openvdb::Vec3d idx_pos(x, y, z);
           const openvdb::Vec3d local_pos = grid.indexToWorld(idx_pos + half_voxel);
-          r_positions.append({float(local_pos.x()), float(local_pos.y()), float(local_pos.z())});
+          r_cell_positions.append(
+              {float(local_pos.x()), float(local_pos.y()), float(local_pos.z())});
         }
       }
     }
+  };
+
+  /* Only the active cells are visited, each leaf node of the tree is processed in parallel. Every
+   * leaf gets its own list of points, so that the order of the points is deterministic. */
+  openvdb::tree::LeafManager<const openvdb::FloatTree> leaf_manager(grid.tree());
+  Array<Vector<float3>> leaf_positions(int64_t(leaf_manager.leafCount()));
+  threading::parallel_for(leaf_positions.index_range(), 8, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const openvdb::FloatTree::LeafNodeType &leaf = leaf_manager.leaf(size_t(i));
+      for (openvdb::FloatTree::LeafNodeType::ValueOnCIter voxel = leaf.cbeginValueOn(); voxel;
+           ++voxel) {
+        /* Check if the voxel's value meets the minimum threshold. */
+        if (voxel.getValue() < threshold) {
+          continue;
+        }
+        const openvdb::Coord coord = voxel.getCoord();
+        add_points_in_cell(openvdb::CoordBBox(coord, coord), leaf_positions[i]);
+      }
+    }
+  });
+
+  /* Active tiles above the leaf level can cover many points, process them in parallel too. */
+  Vector<openvdb::CoordBBox> tile_bboxes;
+  openvdb::FloatGrid::ValueOnCIter tile = grid.cbeginValueOn();
+  tile.setMaxDepth(openvdb::FloatGrid::ValueOnCIter::LEAF_DEPTH - 1);
+  for (; tile; ++tile) {
+    if (tile.getValue() >= threshold) {
+      tile_bboxes.append(tile.getBoundingBox());
+    }
+  }
+  Array<Vector<float3>> tile_positions(tile_bboxes.size());
+  threading::parallel_for(tile_bboxes.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      add_points_in_cell(tile_bboxes[i], tile_positions[i]);
+    }
+  });
+
+  for (const Vector<float3> &positions : leaf_positions) {
+    r_positions.extend(positions);
+  }
+  for (const Vector<float3> &positions : tile_positions) {
+    r_positions.extend(positions);
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include "BLI_kdtree.h"
 #include "BLI_noise.hh"
+#include "BLI_offset_indices.hh"
 #include "BLI_rand.hh"
 #include "BLI_task.hh"
 #include "BLI_timeit.hh"
@@ -109,17 +110,17 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<MLoop> loops = mesh.loops();
   const Span<MLoopTri> looptris = mesh.looptris();
 
-  for (const int looptri_index : looptris.index_range()) {
+  /* Every triangle uses its own random number generator, so the points can be generated in
+   * parallel. The triangles are processed twice: first to count the points per triangle and then
+   * to fill them in, which keeps the order of the points independent of the scheduling. */
+  auto sample_looptri = [&](const int looptri_index, RandomNumberGenerator &rng) {
     const MLoopTri &looptri = looptris[looptri_index];
     const int v0_loop = looptri.tri[0];
     const int v1_loop = looptri.tri[1];
     const int v2_loop = looptri.tri[2];
-    const int v0_index = loops[v0_loop].v;
-    const int v1_index = loops[v1_loop].v;
-    const int v2_index = loops[v2_loop].v;
-    const float3 v0_pos = positions[v0_index];
-    const float3 v1_pos = positions[v1_index];
-    const float3 v2_pos = positions[v2_index];
+    const float3 &v0_pos = positions[loops[v0_loop].v];
+    const float3 &v1_pos = positions[loops[v1_loop].v];
+    const float3 &v2_pos = positions[loops[v2_loop].v];
 
     float looptri_density_factor = 1.0f;
     if (!density_factors.is_empty()) {
@@ -131,20 +132,51 @@ static void sample_mesh_surface(const Mesh &mesh,
     const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
 
     const int looptri_seed = noise::hash(looptri_index, seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
-
-    const int point_amount = looptri_rng.round_probabilistic(area * base_density *
-                                                             looptri_density_factor);
-
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+    rng.seed(looptri_seed);
+    return rng.round_probabilistic(area * base_density * looptri_density_factor);
+  };
+
+  Array<int> offsets(looptris.size() + 1);
+  threading::parallel_for(looptris.index_range(), 2048, [&](const IndexRange range) {
+    RandomNumberGenerator rng;
+    for (const int looptri_index : range) {
+      offsets[looptri_index] = sample_looptri(looptri_index, rng);
     }
-  }
+  });
+  offset_indices::accumulate_counts_to_offsets(offsets);
+  const OffsetIndices<int> points_by_looptri(offsets);
+
+  const int64_t old_size = r_positions.size();
+  const int64_t new_size = old_size + points_by_looptri.total_size();
+  r_positions.resize(new_size);
+  r_bary_coords.resize(new_size);
+  r_looptri_indices.resize(new_size);
+  MutableSpan<float3> new_positions = r_positions.as_mutable_span().drop_front(old_size);
+  MutableSpan<float3> new_bary_coords = r_bary_coords.as_mutable_span().drop_front(old_size);
+  MutableSpan<int> new_looptri_indices = r_looptri_indices.as_mutable_span().drop_front(old_size);
+
+  threading::parallel_for(looptris.index_range(), 2048, [&](const IndexRange range) {
+    RandomNumberGenerator rng;
+    for (const int looptri_index : range) {
+      const IndexRange points = points_by_looptri[looptri_index];
+      if (points.is_empty()) {
+        continue;
+      }
+      /* Advance the generator to the same state as in the first pass. */
+      sample_looptri(looptri_index, rng);
+
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 &v0_pos = positions[loops[looptri.tri[0]].v];
+      const float3 &v1_pos = positions[loops[looptri.tri[1]].v];
+      const float3 &v2_pos = positions[loops[looptri.tri[2]].v];
+      for (const int i : points) {
+        const float3 bary_coord = rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(new_positions[i], v0_pos, v1_pos, v2_pos, bary_coord);
+        new_bary_coords[i] = bary_coord;
+        new_looptri_indices[i] = looptri_index;
+      }
+    }
+  });
 }
 
 BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
@@ -204,30 +236,33 @@ BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
     const MutableSpan<bool> elimination_mask)
 {
   const Span<MLoopTri> looptris = mesh.looptris();
-  for (const int i : bary_coords.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
-    }
+  threading::parallel_for(bary_coords.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
 
-    const MLoopTri &looptri = looptris[looptri_indices[i]];
-    const float3 bary_coord = bary_coords[i];
+      const MLoopTri &looptri = looptris[looptri_indices[i]];
+      const float3 bary_coord = bary_coords[i];
 
-    const int v0_loop = looptri.tri[0];
-    const int v1_loop = looptri.tri[1];
-    const int v2_loop = looptri.tri[2];
+      const int v0_loop = looptri.tri[0];
+      const int v1_loop = looptri.tri[1];
+      const int v2_loop = looptri.tri[2];
 
-    const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
-    const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
-    const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
+      const float v0_density_factor = std::max(0.0f, density_factors[v0_loop]);
+      const float v1_density_factor = std::max(0.0f, density_factors[v1_loop]);
+      const float v2_density_factor = std::max(0.0f, density_factors[v2_loop]);
 
-    const float probability = v0_density_factor * bary_coord.x + v1_density_factor * bary_coord.y +
-                              v2_density_factor * bary_coord.z;
+      const float probability = v0_density_factor * bary_coord.x +
+                                v1_density_factor * bary_coord.y +
+                                v2_density_factor * bary_coord.z;
 
-    const float hash = noise::hash_float_to_float(bary_coord);
-    if (hash > probability) {
-      elimination_mask[i] = true;
+      const float hash = noise::hash_float_to_float(bary_coord);
+      if (hash > probability) {
+        elimination_mask[i] = true;
+      }
     }
-  }
+  });
 }
 
 BLI_NOINLINE static void eliminate_points_based_on_mask(const Span<bool> elimination_mask,
@@ -352,31 +387,33 @@ BLI_NOINLINE static void compute_attribute_outputs(const Mesh &mesh,
   const Span<MLoop> loops = mesh.loops();
   const Span<MLoopTri> looptris = mesh.looptris();
 
-  for (const int i : bary_coords.index_range()) {
-    const int looptri_index = looptri_indices[i];
-    const MLoopTri &looptri = looptris[looptri_index];
-    const float3 &bary_coord = bary_coords[i];
-
-    const int v0_index = loops[looptri.tri[0]].v;
-    const int v1_index = loops[looptri.tri[1]].v;
-    const int v2_index = loops[looptri.tri[2]].v;
-    const float3 v0_pos = positions[v0_index];
-    const float3 v1_pos = positions[v1_index];
-    const float3 v2_pos = positions[v2_index];
-
-    ids.span[i] = noise::hash(noise::hash_float(bary_coord), looptri_index);
-
-    float3 normal;
-    if (!normals.span.is_empty() || !rotations.span.is_empty()) {
-      normal_tri_v3(normal, v0_pos, v1_pos, v2_pos);
-    }
-    if (!normals.span.is_empty()) {
-      normals.span[i] = normal;
+  threading::parallel_for(bary_coords.index_range(), 2048, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int looptri_index = looptri_indices[i];
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 &bary_coord = bary_coords[i];
+
+      const int v0_index = loops[looptri.tri[0]].v;
+      const int v1_index = loops[looptri.tri[1]].v;
+      const int v2_index = loops[looptri.tri[2]].v;
+      const float3 v0_pos = positions[v0_index];
+      const float3 v1_pos = positions[v1_index];
+      const float3 v2_pos = positions[v2_index];
+
+      ids.span[i] = noise::hash(noise::hash_float(bary_coord), looptri_index);
+
+      float3 normal;
+      if (!normals.span.is_empty() || !rotations.span.is_empty()) {
+        normal_tri_v3(normal, v0_pos, v1_pos, v2_pos);
+      }
+      if (!normals.span.is_empty()) {
+        normals.span[i] = normal;
+      }
+      if (!rotations.span.is_empty()) {
+        rotations.span[i] = normal_to_euler_rotation(normal);
+      }
     }
-    if (!rotations.span.is_empty()) {
-      rotations.span[i] = normal_to_euler_rotation(normal);
-    }
-  }
+  });
 
   ids.finish();
   normals.finish();
@@ -61,8 +61,7 @@ class CornersOfVertInput final : public bke::MeshFieldInput {
   {
     const IndexRange vert_range(mesh.totvert);
     const Span<MLoop> loops = mesh.loops();
-    Array<Vector<int>> vert_to_loop_map = bke::mesh_topology::build_vert_to_loop_map(loops,
-                                                                                     mesh.totvert);
+    const Span<Vector<int>> vert_to_loop_map = bke::mesh_topology::vert_to_loop_map(mesh);
 
     const bke::MeshFieldContext context{mesh, domain};
     fn::FieldEvaluator evaluator{context, &mask};
@@ -82,10 +82,9 @@ class CornerPreviousEdgeFieldInput final : public bke::MeshFieldInput {
     }
     const Span<MPoly> polys = mesh.polys();
     const Span<MLoop> loops = mesh.loops();
-    Array<int> loop_to_poly_map = bke::mesh_topology::build_loop_to_poly_map(polys, mesh.totloop);
+    const Span<int> loop_to_poly_map = bke::mesh_topology::loop_to_poly_map(mesh);
     return VArray<int>::ForFunc(
-        mesh.totloop,
-        [polys, loops, loop_to_poly_map = std::move(loop_to_poly_map)](const int corner_i) {
+        mesh.totloop, [polys, loops, loop_to_poly_map](const int corner_i) {
           const int poly_i = loop_to_poly_map[corner_i];
           const MPoly &poly = polys[poly_i];
           const int corner_i_prev = bke::mesh_topology::poly_loop_prev(poly, corner_i);
@@ -35,8 +35,7 @@ class CornerFaceIndexInput final : public bke::MeshFieldInput {
     if (domain != ATTR_DOMAIN_CORNER) {
       return {};
     }
-    return VArray<int>::ForContainer(
-        bke::mesh_topology::build_loop_to_poly_map(mesh.polys(), mesh.totloop));
+    return VArray<int>::ForSpan(bke::mesh_topology::loop_to_poly_map(mesh));
   }
 
   uint64_t hash() const final
@@ -65,9 +64,9 @@ class CornerIndexInFaceInput final : public bke::MeshFieldInput {
       return {};
     }
     const Span<MPoly> polys = mesh.polys();
-    Array<int> loop_to_poly_map = bke::mesh_topology::build_loop_to_poly_map(polys, mesh.totloop);
+    const Span<int> loop_to_poly_map = bke::mesh_topology::loop_to_poly_map(mesh);
     return VArray<int>::ForFunc(
-        mesh.totloop, [polys, loop_to_poly_map = std::move(loop_to_poly_map)](const int corner_i) {
+        mesh.totloop, [polys, loop_to_poly_map](const int corner_i) {
           const int poly_i = loop_to_poly_map[corner_i];
           return corner_i - polys[poly_i].loopstart;
         });
@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "BKE_geometry_cache.hh"
+#include "BKE_main.h"
+
+#include "DEG_depsgraph_query.h"
+
+#include "node_geometry_util.hh"
+
+namespace blender::nodes::node_geo_read_cache_cc {
+
+static void node_declare(NodeDeclarationBuilder &b)
+{
+  b.add_input<decl::String>(N_("Path")).description(
+      N_("Path of the geometry cache file. Relative paths start at the blend file directory"));
+  b.add_input<decl::Int>(N_("Frame")).description(
+      N_("Frame number that replaces the \"#\" characters in the file name"));
+
+  b.add_output<decl::Geometry>(N_("Geometry"));
+}
+
+static void node_geo_exec(GeoNodeExecParams params)
+{
+  const std::string path = params.extract_input<std::string>("Path");
+  const int frame = params.extract_input<int>("Frame");
+  if (path.empty()) {
+    params.set_default_remaining_outputs();
+    return;
+  }
+
+  char filepath[FILE_MAX];
+  STRNCPY(filepath, path.c_str());
+  const Main *bmain = DEG_get_bmain(params.depsgraph());
+  BLI_path_abs(filepath, BKE_main_blendfile_path(bmain));
+  BLI_path_frame(filepath, frame, 0);
+
+  GeometrySet geometry_set;
+  std::string error;
+  if (!bke::geometry_cache_read(filepath, geometry_set, error)) {
+    params.error_message_add(NodeWarningType::Error, error);
+    params.set_default_remaining_outputs();
+    return;
+  }
+  params.set_output("Geometry", std::move(geometry_set));
+}
+
+}  // namespace blender::nodes::node_geo_read_cache_cc
+
+void register_node_type_geo_read_cache()
+{
+  namespace file_ns = blender::nodes::node_geo_read_cache_cc;
+
+  static bNodeType ntype;
+
+  geo_node_type_base(&ntype, GEO_NODE_READ_CACHE, "Read Cache", NODE_CLASS_INPUT);
+  ntype.geometry_node_execute = file_ns::node_geo_exec;
+  ntype.declare = file_ns::node_declare;
+  nodeRegisterType(&ntype);
+}
@@ -8,6 +8,8 @@
 
 #include "node_geometry_util.hh"
 
+#include "BLI_task.hh"
+
 #include "BKE_lib_id.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -101,9 +103,11 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
                                            const bke::VolumeToMeshResolution &resolution)
 {
   Array<bke::OpenVDBMeshData> mesh_data(grids.size());
-  for (const int i : grids.index_range()) {
-    mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      mesh_data[i] = bke::volume_to_mesh_data(*grids[i], resolution, threshold, adaptivity);
+    }
+  });
 
   int vert_offset = 0;
   int poly_offset = 0;
@@ -127,18 +131,20 @@ static Mesh *create_mesh_from_volume_grids(Span<openvdb::GridBase::ConstPtr> gri
   MutableSpan<MPoly> polys = mesh->polys_for_write();
   MutableSpan<MLoop> loops = mesh->loops_for_write();
 
-  for (const int i : grids.index_range()) {
-    const bke::OpenVDBMeshData &data = mesh_data[i];
-    bke::fill_mesh_from_openvdb_data(data.verts,
-                                     data.tris,
-                                     data.quads,
-                                     vert_offsets[i],
-                                     poly_offsets[i],
-                                     loop_offsets[i],
-                                     positions,
-                                     polys,
-                                     loops);
-  }
+  threading::parallel_for(grids.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const bke::OpenVDBMeshData &data = mesh_data[i];
+      bke::fill_mesh_from_openvdb_data(data.verts,
+                                       data.tris,
+                                       data.quads,
+                                       vert_offsets[i],
+                                       poly_offsets[i],
+                                       loop_offsets[i],
+                                       positions,
+                                       polys,
+                                       loops);
+    }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
 
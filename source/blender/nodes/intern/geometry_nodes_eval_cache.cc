@@ -0,0 +1,349 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "NOD_geometry_nodes_eval_cache.hh"
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_node_types.h"
+
+#include "BKE_anonymous_attribute_id.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_node.h"
+
+#include "FN_field_cpp_type.hh"
+
+struct Collection;
+struct Image;
+struct Material;
+struct Object;
+struct Tex;
+
+namespace blender::nodes {
+
+using fn::ValueOrFieldCPPType;
+
+bool GeoNodesEvalCache::node_supports_caching(const bNode &node)
+{
+  /* Nodes that access the depsgraph, the evaluated object, IDs or the current time must not be
+   * added here, their result can change without any change of their inputs. */
+  switch (node.type) {
+    case GEO_NODE_CONVEX_HULL:
+    case GEO_NODE_CURVE_PRIMITIVE_ARC:
+    case GEO_NODE_CURVE_PRIMITIVE_BEZIER_SEGMENT:
+    case GEO_NODE_CURVE_PRIMITIVE_CIRCLE:
+    case GEO_NODE_CURVE_PRIMITIVE_LINE:
+    case GEO_NODE_CURVE_PRIMITIVE_QUADRATIC_BEZIER:
+    case GEO_NODE_CURVE_PRIMITIVE_QUADRILATERAL:
+    case GEO_NODE_CURVE_PRIMITIVE_SPIRAL:
+    case GEO_NODE_CURVE_PRIMITIVE_STAR:
+    case GEO_NODE_CURVE_TO_MESH:
+    case GEO_NODE_DISTRIBUTE_POINTS_ON_FACES:
+    case GEO_NODE_DUAL_MESH:
+    case GEO_NODE_FILL_CURVE:
+    case GEO_NODE_MERGE_BY_DISTANCE:
+    case GEO_NODE_MESH_BOOLEAN:
+    case GEO_NODE_MESH_PRIMITIVE_CIRCLE:
+    case GEO_NODE_MESH_PRIMITIVE_CONE:
+    case GEO_NODE_MESH_PRIMITIVE_CUBE:
+    case GEO_NODE_MESH_PRIMITIVE_CYLINDER:
+    case GEO_NODE_MESH_PRIMITIVE_GRID:
+    case GEO_NODE_MESH_PRIMITIVE_ICO_SPHERE:
+    case GEO_NODE_MESH_PRIMITIVE_LINE:
+    case GEO_NODE_MESH_PRIMITIVE_UV_SPHERE:
+    case GEO_NODE_REALIZE_INSTANCES:
+    case GEO_NODE_RESAMPLE_CURVE:
+    case GEO_NODE_SUBDIVIDE_MESH:
+    case GEO_NODE_SUBDIVISION_SURFACE:
+    case GEO_NODE_TRIANGULATE:
+      break;
+    default:
+      return false;
+  }
+  /* Data-block pointers of the node itself are not compared. */
+  return node.id == nullptr;
+}
+
+static Vector<std::byte> node_properties_get(const bNode &node)
+{
+  Vector<std::byte> properties;
+  const auto append = [&](const void *data, const size_t size) {
+    properties.extend(Span<std::byte>(static_cast<const std::byte *>(data), int64_t(size)));
+  };
+  append(&node.type, sizeof(node.type));
+  append(&node.custom1, sizeof(node.custom1));
+  append(&node.custom2, sizeof(node.custom2));
+  append(&node.custom3, sizeof(node.custom3));
+  append(&node.custom4, sizeof(node.custom4));
+  if (node.storage != nullptr) {
+    /* The storage of the supported nodes does not contain pointers, so it can be compared as raw
+     * bytes. */
+    append(node.storage, MEM_allocN_len(node.storage));
+  }
+  return properties;
+}
+
+static bool is_id_pointer_type(const CPPType &type)
+{
+  return type.is<Object *>() || type.is<Collection *>() || type.is<Tex *>() ||
+         type.is<Image *>() || type.is<Material *>();
+}
+
+/**
+ * Geometries can only be compared by the identity of their components when the cache can keep
+ * them alive. Components that don't own their data (like the mesh passed into the modifier) may be
+ * freed or changed in place after the evaluation.
+ */
+static bool value_is_comparable(const CPPType &type, const void *value)
+{
+  if (type.is<GeometrySet>()) {
+    return static_cast<const GeometrySet *>(value)->owns_direct_data();
+  }
+  if (type.is<Vector<GeometrySet>>()) {
+    for (const GeometrySet &geometry : *static_cast<const Vector<GeometrySet> *>(value)) {
+      if (!geometry.owns_direct_data()) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (type.is<bke::AnonymousAttributeSet>()) {
+    return true;
+  }
+  if (const ValueOrFieldCPPType *value_or_field_type = ValueOrFieldCPPType::get_from_self(type)) {
+    return value_or_field_type->value.is_equality_comparable();
+  }
+  return type.is_equality_comparable() && !is_id_pointer_type(type);
+}
+
+static bool geometries_equal(const GeometrySet &a, const GeometrySet &b)
+{
+  for (const int i : IndexRange(GEO_COMPONENT_TYPE_ENUM_SIZE)) {
+    const GeometryComponentType component_type = GeometryComponentType(i);
+    if (a.get_component_for_read(component_type) != b.get_component_for_read(component_type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool attribute_sets_equal(const bke::AnonymousAttributeSet &a,
+                                 const bke::AnonymousAttributeSet &b)
+{
+  const int64_t a_size = a.names ? a.names->size() : 0;
+  const int64_t b_size = b.names ? b.names->size() : 0;
+  if (a_size != b_size) {
+    return false;
+  }
+  if (a_size == 0) {
+    return true;
+  }
+  for (const std::string &name : *a.names) {
+    if (!b.names->contains(name)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool values_equal(const CPPType &type, const void *a, const void *b)
+{
+  if (type.is<GeometrySet>()) {
+    return geometries_equal(*static_cast<const GeometrySet *>(a),
+                            *static_cast<const GeometrySet *>(b));
+  }
+  if (type.is<Vector<GeometrySet>>()) {
+    const Vector<GeometrySet> &a_geometries = *static_cast<const Vector<GeometrySet> *>(a);
+    const Vector<GeometrySet> &b_geometries = *static_cast<const Vector<GeometrySet> *>(b);
+    if (a_geometries.size() != b_geometries.size()) {
+      return false;
+    }
+    for (const int i : a_geometries.index_range()) {
+      if (!geometries_equal(a_geometries[i], b_geometries[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (type.is<bke::AnonymousAttributeSet>()) {
+    return attribute_sets_equal(*static_cast<const bke::AnonymousAttributeSet *>(a),
+                                *static_cast<const bke::AnonymousAttributeSet *>(b));
+  }
+  if (const ValueOrFieldCPPType *value_or_field_type = ValueOrFieldCPPType::get_from_self(type)) {
+    const bool a_is_field = value_or_field_type->is_field(a);
+    const bool b_is_field = value_or_field_type->is_field(b);
+    if (a_is_field != b_is_field) {
+      return false;
+    }
+    if (a_is_field) {
+      /* Fields are compared by identity unless their nodes implement a more precise comparison.
+       * The cache keeps the field alive, so the pointer cannot be reused in the meantime. */
+      return *value_or_field_type->get_field_ptr(a) == *value_or_field_type->get_field_ptr(b);
+    }
+    return value_or_field_type->value.is_equal(value_or_field_type->get_value_ptr(a),
+                                               value_or_field_type->get_value_ptr(b));
+  }
+  return type.is_equal(a, b);
+}
+
+GeoNodesEvalCache::Entry::~Entry()
+{
+  for (GMutablePointer &value : inputs) {
+    value.destruct();
+  }
+  for (GMutablePointer &value : outputs) {
+    if (value.get() != nullptr) {
+      value.destruct();
+    }
+  }
+}
+
+void GeoNodesEvalCache::begin_evaluation()
+{
+  std::lock_guard lock{mutex_};
+  evaluation_counter_++;
+}
+
+void GeoNodesEvalCache::end_evaluation()
+{
+  std::lock_guard lock{mutex_};
+  entries_.remove_if([&](const auto item) { return item.value->last_used < evaluation_counter_; });
+}
+
+bool GeoNodesEvalCache::try_reuse_outputs(const NodeKey &key,
+                                          const bNode &node,
+                                          const lf::LazyFunction &fn,
+                                          lf::Params &params)
+{
+  std::lock_guard lock{mutex_};
+  const std::unique_ptr<Entry> *entry_ptr = entries_.lookup_ptr(key);
+  if (entry_ptr == nullptr) {
+    return false;
+  }
+  Entry &entry = **entry_ptr;
+  if (entry.node_properties.as_span() != node_properties_get(node).as_span()) {
+    return false;
+  }
+  if (entry.inputs.size() != fn.inputs().size() || entry.outputs.size() != fn.outputs().size()) {
+    return false;
+  }
+  for (const int i : fn.inputs().index_range()) {
+    const void *value = params.try_get_input_data_ptr(i);
+    if (value == nullptr) {
+      return false;
+    }
+    const CPPType &type = *fn.inputs()[i].type;
+    if (entry.inputs[i].type() != &type || !values_equal(type, entry.inputs[i].get(), value)) {
+      return false;
+    }
+  }
+  for (const int i : fn.outputs().index_range()) {
+    if (entry.outputs[i].get() == nullptr && !params.output_was_set(i) &&
+        params.get_output_usage(i) != lf::ValueUsage::Unused)
+    {
+      /* The output was not computed in the previous evaluation but is needed now. */
+      return false;
+    }
+  }
+
+  for (const int i : fn.outputs().index_range()) {
+    const GMutablePointer value = entry.outputs[i];
+    if (value.get() == nullptr || params.output_was_set(i)) {
+      continue;
+    }
+    value.type()->copy_construct(value.get(), params.get_output_data_ptr(i));
+    params.output_set(i);
+  }
+  entry.last_used = evaluation_counter_;
+  return true;
+}
+
+std::unique_ptr<GeoNodesEvalCache::Entry> GeoNodesEvalCache::create_entry(
+    const bNode &node, const lf::LazyFunction &fn, const lf::Params &params) const
+{
+  for (const int i : fn.inputs().index_range()) {
+    const void *value = params.try_get_input_data_ptr(i);
+    if (value == nullptr || !value_is_comparable(*fn.inputs()[i].type, value)) {
+      return {};
+    }
+  }
+
+  auto entry = std::make_unique<Entry>();
+  entry->node_properties = node_properties_get(node);
+  for (const int i : fn.inputs().index_range()) {
+    const CPPType &type = *fn.inputs()[i].type;
+    void *buffer = entry->allocator.allocate(type.size(), type.alignment());
+    type.copy_construct(params.try_get_input_data_ptr(i), buffer);
+    entry->inputs.append({type, buffer});
+  }
+  for (const int i : fn.outputs().index_range()) {
+    entry->outputs.append({fn.outputs()[i].type, nullptr});
+  }
+  return entry;
+}
+
+void GeoNodesEvalCache::add_entry(const NodeKey &key, std::unique_ptr<Entry> entry)
+{
+  for (const GMutablePointer &value : entry->outputs) {
+    if (value.get() != nullptr && !value_is_comparable(*value.type(), value.get())) {
+      /* Outputs that reference data owned by something else cannot be kept around. */
+      return;
+    }
+  }
+  std::lock_guard lock{mutex_};
+  entry->last_used = evaluation_counter_;
+  entries_.add_overwrite(key, std::move(entry));
+}
+
+GeoNodesEvalCacheParams::GeoNodesEvalCacheParams(const lf::LazyFunction &fn,
+                                                 lf::Params &params,
+                                                 GeoNodesEvalCache::Entry &entry)
+    : lf::Params(fn, false), params_(params), entry_(entry)
+{
+}
+
+void *GeoNodesEvalCacheParams::try_get_input_data_ptr_impl(const int index) const
+{
+  return params_.try_get_input_data_ptr(index);
+}
+
+void *GeoNodesEvalCacheParams::try_get_input_data_ptr_or_request_impl(const int index)
+{
+  return params_.try_get_input_data_ptr_or_request(index);
+}
+
+void *GeoNodesEvalCacheParams::get_output_data_ptr_impl(const int index)
+{
+  return params_.get_output_data_ptr(index);
+}
+
+void GeoNodesEvalCacheParams::output_set_impl(const int index)
+{
+  /* Copy the value before it is passed on, because it may be moved away immediately. */
+  const CPPType &type = *fn_.outputs()[index].type;
+  void *buffer = entry_.allocator.allocate(type.size(), type.alignment());
+  type.copy_construct(params_.get_output_data_ptr(index), buffer);
+  entry_.outputs[index] = {type, buffer};
+  params_.output_set(index);
+}
+
+bool GeoNodesEvalCacheParams::output_was_set_impl(const int index) const
+{
+  return params_.output_was_set(index);
+}
+
+lf::ValueUsage GeoNodesEvalCacheParams::get_output_usage_impl(const int index) const
+{
+  return params_.get_output_usage(index);
+}
+
+void GeoNodesEvalCacheParams::set_input_unused_impl(const int index)
+{
+  params_.set_input_unused(index);
+}
+
+bool GeoNodesEvalCacheParams::try_enable_multi_threading_impl()
+{
+  return params_.try_enable_multi_threading();
+}
+
+}  // namespace blender::nodes
@@ -12,6 +12,7 @@
  */
 
 #include "NOD_geometry_exec.hh"
+#include "NOD_geometry_nodes_eval_cache.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
@@ -163,6 +164,30 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     GeoNodesLFUserData *user_data = dynamic_cast<GeoNodesLFUserData *>(context.user_data);
     BLI_assert(user_data != nullptr);
 
+    GeoNodesEvalCache *eval_cache = user_data->modifier_data->eval_cache;
+    if (eval_cache == nullptr || !GeoNodesEvalCache::node_supports_caching(node_)) {
+      this->execute_node(params, context, *user_data);
+      return;
+    }
+    const GeoNodesEvalCache::NodeKey key{user_data->compute_context->hash(), node_.identifier};
+    if (eval_cache->try_reuse_outputs(key, node_, *this, params)) {
+      return;
+    }
+    std::unique_ptr<GeoNodesEvalCache::Entry> entry = eval_cache->create_entry(
+        node_, *this, params);
+    if (!entry) {
+      this->execute_node(params, context, *user_data);
+      return;
+    }
+    GeoNodesEvalCacheParams cache_params{*this, params, *entry};
+    this->execute_node(cache_params, context, *user_data);
+    eval_cache->add_entry(key, std::move(entry));
+  }
+
+  void execute_node(lf::Params &params,
+                    const lf::Context &context,
+                    GeoNodesLFUserData &user_data) const
+  {
     GeoNodeExecParams geo_params{node_,
                                  params,
                                  context,
@@ -173,9 +198,9 @@ class LazyFunctionForGeometryNode : public LazyFunction {
     node_.typeinfo->geometry_node_execute(geo_params);
     geo_eval_log::TimePoint end_time = geo_eval_log::Clock::now();
 
-    if (geo_eval_log::GeoModifierLog *modifier_log = user_data->modifier_data->eval_log) {
+    if (geo_eval_log::GeoModifierLog *modifier_log = user_data.modifier_data->eval_log) {
       geo_eval_log::GeoTreeLogger &tree_logger = modifier_log->get_local_tree_logger(
-          *user_data->compute_context);
+          *user_data.compute_context);
       tree_logger.node_execution_times.append({node_.identifier, start_time, end_time});
     }
   }
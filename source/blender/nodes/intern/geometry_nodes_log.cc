@@ -468,6 +468,146 @@ GeoTreeLog &GeoModifierLog::get_tree_log(const ComputeContextHash &compute_conte
   return reduced_tree_log;
 }
 
+static void gather_trees_by_context(const bNodeTree &tree,
+                                    ComputeContextBuilder &compute_context_builder,
+                                    Map<ComputeContextHash, const bNodeTree *> &r_trees)
+{
+  r_trees.add(compute_context_builder.hash(), &tree);
+  tree.ensure_topology_cache();
+  for (const bNode *group_node : tree.group_nodes()) {
+    if (group_node->id == nullptr) {
+      continue;
+    }
+    compute_context_builder.push<bke::NodeGroupComputeContext>(*group_node);
+    gather_trees_by_context(
+        *reinterpret_cast<const bNodeTree *>(group_node->id), compute_context_builder, r_trees);
+    compute_context_builder.pop();
+  }
+}
+
+static void write_json_string(FILE *file, const StringRef str)
+{
+  fputc('"', file);
+  for (const char c : str) {
+    if (ELEM(c, '"', '\\')) {
+      fputc('\\', file);
+      fputc(c, file);
+    }
+    else if (uchar(c) < 0x20) {
+      fprintf(file, "\\u%04x", int(c));
+    }
+    else {
+      fputc(c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+static void write_geometry_info_args(FILE *file, const GeometryInfoLog &info)
+{
+  if (info.mesh_info) {
+    fprintf(file,
+            ",\"verts\":%d,\"edges\":%d,\"faces\":%d",
+            info.mesh_info->verts_num,
+            info.mesh_info->edges_num,
+            info.mesh_info->faces_num);
+  }
+  if (info.curve_info) {
+    fprintf(file,
+            ",\"curve_points\":%d,\"curves\":%d",
+            info.curve_info->points_num,
+            info.curve_info->splines_num);
+  }
+  if (info.pointcloud_info) {
+    fprintf(file, ",\"points\":%d", info.pointcloud_info->points_num);
+  }
+  if (info.instances_info) {
+    fprintf(file, ",\"instances\":%d", info.instances_info->instances_num);
+  }
+}
+
+bool GeoModifierLog::write_chrome_trace(FILE *file,
+                                        const bNodeTree &tree,
+                                        const StringRefNull modifier_name)
+{
+  ComputeContextBuilder compute_context_builder;
+  compute_context_builder.push<bke::ModifierComputeContext>(modifier_name);
+  Map<ComputeContextHash, const bNodeTree *> trees_by_context;
+  gather_trees_by_context(tree, compute_context_builder, trees_by_context);
+
+  std::optional<TimePoint> begin_time;
+  for (LocalData &local_data : data_per_thread_) {
+    for (const destruct_ptr<GeoTreeLogger> &tree_logger :
+         local_data.tree_logger_by_context.values()) {
+      for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger->node_execution_times) {
+        if (!begin_time || timings.start < *begin_time) {
+          begin_time = timings.start;
+        }
+      }
+    }
+  }
+  if (!begin_time) {
+    return false;
+  }
+  const auto to_us = [&](const TimePoint time) {
+    return std::chrono::duration<double, std::micro>(time - *begin_time).count();
+  };
+
+  fprintf(file, "{\"traceEvents\":[\n");
+  bool is_first_event = true;
+  int thread = 0;
+  for (LocalData &local_data : data_per_thread_) {
+    fprintf(file,
+            "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"name\":\"Thread %d\"}}",
+            is_first_event ? "" : ",\n",
+            thread,
+            thread);
+    is_first_event = false;
+    for (const auto item : local_data.tree_logger_by_context.items()) {
+      const GeoTreeLogger &tree_logger = *item.value;
+      const bNodeTree *context_tree = trees_by_context.lookup_default(item.key, nullptr);
+
+      /* Use the first logged output geometry of every node to show its size. */
+      Map<int32_t, const GeometryInfoLog *> geometry_by_node;
+      for (const GeoTreeLogger::SocketValueLog &value_log : tree_logger.output_socket_values) {
+        if (const GeometryInfoLog *geometry_log = dynamic_cast<const GeometryInfoLog *>(
+                value_log.value.get())) {
+          geometry_by_node.add(value_log.node_id, geometry_log);
+        }
+      }
+
+      for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger.node_execution_times) {
+        const bNode *node = context_tree ? context_tree->node_by_id(timings.node_id) : nullptr;
+        fprintf(file, ",\n{\"name\":");
+        if (node != nullptr) {
+          write_json_string(file, node->name);
+        }
+        else {
+          fprintf(file, "\"Node %d\"", int(timings.node_id));
+        }
+        fprintf(file, ",\"cat\":");
+        write_json_string(file, context_tree ? context_tree->id.name + 2 : "");
+        fprintf(file,
+                ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{"
+                "\"node_id\":%d",
+                thread,
+                to_us(timings.start),
+                to_us(timings.end) - to_us(timings.start),
+                int(timings.node_id));
+        if (const GeometryInfoLog *geometry_log = geometry_by_node.lookup_default(timings.node_id,
+                                                                                  nullptr)) {
+          write_geometry_info_args(file, *geometry_log);
+        }
+        fprintf(file, "}}");
+      }
+    }
+    thread++;
+  }
+  fprintf(file, "\n]}\n");
+  return true;
+}
+
 struct ObjectAndModifier {
   const Object *object;
   const NodesModifierData *nmd;
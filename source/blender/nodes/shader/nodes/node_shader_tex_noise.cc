@@ -178,7 +178,36 @@ class NoiseFunction : public mf::MultiFunction {
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        if (compute_factor && detail.is_single() && roughness.is_single() &&
+            distortion.is_single())
+        {
+          /* Evaluate the common case of uniform noise settings in batches, which allows the noise
+           * to be computed for multiple positions at once. */
+          const float detail_single = detail.get_internal_single();
+          const float roughness_single = roughness.get_internal_single();
+          const float distortion_single = distortion.get_internal_single();
+          constexpr int64_t batch_size = 256;
+          float3 positions[batch_size];
+          float factors[batch_size];
+          for (int64_t start = 0; start < mask.size(); start += batch_size) {
+            const IndexMask batch_mask = mask.slice(start,
+                                                    std::min(batch_size, mask.size() - start));
+            for (const int64_t i : batch_mask.index_range()) {
+              const int64_t index = batch_mask[i];
+              positions[i] = vector[index] * scale[index];
+            }
+            const int64_t size = batch_mask.size();
+            noise::perlin_fractal_distorted(Span<float3>(positions, size),
+                                            detail_single,
+                                            roughness_single,
+                                            distortion_single,
+                                            MutableSpan<float>(factors, size));
+            for (const int64_t i : batch_mask.index_range()) {
+              r_factor[batch_mask[i]] = factors[i];
+            }
+          }
+        }
+        else if (compute_factor) {
           for (int64_t i : mask) {
             const float3 position = vector[i] * scale[i];
             r_factor[i] = noise::perlin_fractal_distorted(
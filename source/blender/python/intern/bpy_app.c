@@ -31,6 +31,8 @@
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.h"
@@ -446,6 +448,12 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_global_flag_doc,
      (void *)G_FLAG_USERPREF_NO_SAVE_ON_EXIT},
 
+    {"use_render_node",
+     bpy_app_global_flag_get,
+     NULL,
+     bpy_app_global_flag_doc,
+     (void *)G_FLAG_RENDER_NODE},
+
     {"debug_value",
      bpy_app_debug_value_get,
      bpy_app_debug_value_set,
@@ -515,11 +523,33 @@ static PyObject *bpy_app_is_job_running(PyObject *UNUSED(self), PyObject *args,
   return PyBool_FromLong(WM_jobs_has_running_type(wm, job_type_enum.value));
 }
 
+PyDoc_STRVAR(bpy_app_memory_usage_by_tag_doc,
+             ".. staticmethod:: memory_usage_by_tag()\n"
+             "\n"
+             "   Memory currently used by each subsystem of Blender.\n"
+             "\n"
+             "   :return: Number of bytes per subsystem name.\n"
+             "   :rtype: dict of strings to ints\n");
+static PyObject *bpy_app_memory_usage_by_tag(PyObject *UNUSED(self))
+{
+  PyObject *ret = PyDict_New();
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    PyObject *value = PyLong_FromSize_t(MEM_get_memory_in_use_by_tag((eMemTag)tag));
+    PyDict_SetItemString(ret, MEM_tag_name((eMemTag)tag), value);
+    Py_DECREF(value);
+  }
+  return ret;
+}
+
 static struct PyMethodDef bpy_app_methods[] = {
     {"is_job_running",
      (PyCFunction)bpy_app_is_job_running,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_app_is_job_running_doc},
+    {"memory_usage_by_tag",
+     (PyCFunction)bpy_app_memory_usage_by_tag,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_usage_by_tag_doc},
     {NULL, NULL, 0, NULL},
 };
 
@@ -79,6 +79,9 @@ CLG_LOGREF_DECLARE_GLOBAL(BPY_LOG_RNA, "bpy.rna");
  * stop bpy_context_clear from invalidating. */
 static int py_call_level = 0;
 
+/* Memory tag to restore once Python is not running anymore. */
+static eMemTag py_call_prev_mem_tag = MEM_TAG_NONE;
+
 /* Set by command line arguments before Python starts. */
 static bool py_use_system_env = false;
 
@@ -115,6 +118,7 @@ void bpy_context_set(bContext *C, PyGILState_STATE *gilstate)
 
   if (py_call_level == 1) {
     BPY_context_update(C);
+    py_call_prev_mem_tag = MEM_tag_set(MEM_TAG_PYTHON);
 
 #ifdef TIME_PY_RUN
     if (bpy_timer_count == 0) {
@@ -141,6 +145,8 @@ void bpy_context_clear(bContext *UNUSED(C), const PyGILState_STATE *gilstate)
     fprintf(stderr, "ERROR: Python context internal state bug. this should not happen!\n");
   }
   else if (py_call_level == 0) {
+    MEM_tag_set(py_call_prev_mem_tag);
+
     /* XXX: Calling classes currently won't store the context :\,
      * can't set NULL because of this. but this is very flaky still. */
 #if 0
@@ -5316,6 +5316,67 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Raw type of a buffer that #RNA_property_collection_raw_get/set can convert from/to directly,
+ * #PROP_RAW_UNSET when the buffer has to be accessed as a sequence.
+ *
+ * Only signed and native types are supported since the conversion casts through C types.
+ */
+static RawPropertyType foreach_buffer_raw_type(const Py_buffer *buf)
+{
+  const char *format = buf->format ? buf->format : "B";
+  if (ELEM(*format, '@', '=')) {
+    format++;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return PROP_RAW_UNSET;
+  }
+
+  RawPropertyType raw_type;
+  switch (format[0]) {
+    case 'h':
+      raw_type = PROP_RAW_SHORT;
+      break;
+    case 'i':
+      raw_type = PROP_RAW_INT;
+      break;
+    case '?':
+      raw_type = PROP_RAW_BOOLEAN;
+      break;
+    case 'f':
+      raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      raw_type = PROP_RAW_DOUBLE;
+      break;
+    default:
+      return PROP_RAW_UNSET;
+  }
+  if (buf->itemsize != RNA_raw_type_sizeof(raw_type)) {
+    return PROP_RAW_UNSET;
+  }
+  return raw_type;
+}
+
+/**
+ * Raw type to use for accessing `buf` directly, without going through Python objects.
+ */
+static RawPropertyType foreach_buffer_access_type(const Py_buffer *buf,
+                                                  const RawPropertyType raw_type,
+                                                  const bool attr_signed,
+                                                  const int tot)
+{
+  if (foreach_compat_buffer(raw_type, attr_signed, buf->format)) {
+    return raw_type;
+  }
+  /* Let RNA convert between the types, as long as the buffer holds exactly the values. */
+  const RawPropertyType buf_raw_type = foreach_buffer_raw_type(buf);
+  if (buf_raw_type != PROP_RAW_UNSET && buf->len == (Py_ssize_t)tot * buf->itemsize) {
+    return buf_raw_type;
+  }
+  return PROP_RAW_UNSET;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5341,21 +5402,25 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 
   if (set) { /* Get the array from python. */
     buffer_is_compat = false;
-    if (PyObject_CheckBuffer(seq)) {
-      Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
-
-      /* Check if the buffer matches. */
-
-      buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
+    Py_buffer buf;
+    if (PyObject_CheckBuffer(seq) &&
+        PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT) != -1) {
+      /* Check if the buffer matches or can be converted. */
+      const RawPropertyType buf_raw_type = foreach_buffer_access_type(
+          &buf, raw_type, attr_signed, tot);
+      buffer_is_compat = (buf_raw_type != PROP_RAW_UNSET);
 
       if (buffer_is_compat) {
         ok = RNA_property_collection_raw_set(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+            NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
       }
 
       PyBuffer_Release(&buf);
     }
+    else {
+      /* Not a (contiguous) buffer, access as a sequence. */
+      PyErr_Clear();
+    }
 
     /* Could not use the buffer, fallback to sequence. */
     if (!buffer_is_compat) {
@@ -5397,21 +5462,25 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
   }
   else {
     buffer_is_compat = false;
-    if (PyObject_CheckBuffer(seq)) {
-      Py_buffer buf;
-      PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT);
-
-      /* Check if the buffer matches, TODO: signed/unsigned types. */
-
-      buffer_is_compat = foreach_compat_buffer(raw_type, attr_signed, buf.format);
+    Py_buffer buf;
+    if (PyObject_CheckBuffer(seq) &&
+        PyObject_GetBuffer(seq, &buf, PyBUF_SIMPLE | PyBUF_FORMAT | PyBUF_WRITABLE) != -1) {
+      /* Check if the buffer matches or can be converted. */
+      const RawPropertyType buf_raw_type = foreach_buffer_access_type(
+          &buf, raw_type, attr_signed, tot);
+      buffer_is_compat = (buf_raw_type != PROP_RAW_UNSET);
 
       if (buffer_is_compat) {
         ok = RNA_property_collection_raw_get(
-            NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
+            NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
       }
 
       PyBuffer_Release(&buf);
     }
+    else {
+      /* Not a (contiguous, writable) buffer, access as a sequence. */
+      PyErr_Clear();
+    }
 
     /* Could not use the buffer, fallback to sequence. */
     if (!buffer_is_compat) {
@@ -80,6 +80,12 @@ bool RE_bake_engine(struct Render *re,
                     int pass_filter,
                     float result[]);
 
+/**
+ * Free the render engine that #RE_bake_engine keeps when using persistent data. Has to be called
+ * once all objects of a depsgraph are baked.
+ */
+void RE_bake_engine_free(struct Render *re);
+
 /* bake.c */
 
 int RE_pass_depth(eScenePassType pass_type);
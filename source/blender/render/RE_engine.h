@@ -63,6 +63,8 @@ extern "C" {
 #define RE_ENGINE_RENDERING 16
 #define RE_ENGINE_HIGHLIGHT_TILES 32
 #define RE_ENGINE_CAN_DRAW 64
+/** More view layers of the same frame are rendered after the current one. */
+#define RE_ENGINE_VIEW_LAYERS_REMAINING 128
 
 extern ListBase R_engines;
 
@@ -715,6 +715,14 @@ static bool engine_keep_depsgraph(RenderEngine *engine)
   return (engine->re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT);
 }
 
+static bool engine_keep_depsgraph_for_next_view_layer(RenderEngine *engine)
+{
+  /* Even without persistent data, the depsgraph is reused by the following view layers of the
+   * same frame, so that only the objects differing between the view layers are evaluated again.
+   * It is freed once the last view layer is rendered. */
+  return engine_keep_depsgraph(engine) || (engine->flag & RE_ENGINE_VIEW_LAYERS_REMAINING);
+}
+
 /* Depsgraph */
 static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 {
@@ -777,7 +785,7 @@ static void engine_depsgraph_init(RenderEngine *engine, ViewLayer *view_layer)
 static void engine_depsgraph_exit(RenderEngine *engine)
 {
   if (engine->depsgraph) {
-    if (engine_keep_depsgraph(engine)) {
+    if (engine_keep_depsgraph_for_next_view_layer(engine)) {
       /* Clear recalc flags since the engine should have handled the updates for the currently
        * rendered framed by now. */
       DEG_ids_clear_recalc(engine->depsgraph, false);
@@ -893,8 +901,12 @@ bool RE_bake_engine(Render *re,
 
   engine_depsgraph_free(engine);
 
-  RE_engine_free(engine);
-  re->engine = nullptr;
+  /* With persistent data the engine is kept, so that baking more objects from the same depsgraph
+   * can reuse the synchronized scene. The caller frees it with #RE_bake_engine_free. */
+  if (!RE_engine_use_persistent_data(engine)) {
+    RE_engine_free(engine);
+    re->engine = nullptr;
+  }
 
   if (BKE_reports_contain(re->reports, RPT_ERROR)) {
     G.is_break = true;
@@ -903,6 +915,18 @@ bool RE_bake_engine(Render *re,
   return true;
 }
 
+void RE_bake_engine_free(Render *re)
+{
+  RenderEngine *engine = re->engine;
+  if (engine == nullptr) {
+    return;
+  }
+
+  engine_depsgraph_free(engine);
+  RE_engine_free(engine);
+  re->engine = nullptr;
+}
+
 /* Render */
 
 static void engine_render_view_layer(Render *re,
@@ -970,6 +994,17 @@ static void engine_render_view_layer(Render *re,
   engine_depsgraph_exit(engine);
 }
 
+static int engine_render_view_layers_num(Render *re)
+{
+  int view_layers_num = 0;
+  FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer_iter) {
+    UNUSED_VARS(view_layer_iter);
+    view_layers_num++;
+  }
+  FOREACH_VIEW_LAYER_TO_RENDER_END;
+  return view_layers_num;
+}
+
 /* Callback function for engine_render_create_result to add all render passes to the result. */
 static void engine_render_add_result_pass_cb(void *user_data,
                                              struct Scene * /*scene*/,
@@ -1104,9 +1139,14 @@ bool RE_engine_render(Render *re, bool do_all)
 
   /* Render view layers. */
   bool delay_grease_pencil = false;
+  const int view_layers_num = engine_render_view_layers_num(re);
 
   if (type->render) {
+    int view_layer_index = 0;
     FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer_iter) {
+      SET_FLAG_FROM_TEST(engine->flag,
+                         ++view_layer_index < view_layers_num,
+                         RE_ENGINE_VIEW_LAYERS_REMAINING);
       engine_render_view_layer(re, engine, view_layer_iter, true, true);
 
       /* If render passes are not allocated the render engine deferred final pixels write for
@@ -1119,6 +1159,7 @@ bool RE_engine_render(Render *re, bool do_all)
       }
     }
     FOREACH_VIEW_LAYER_TO_RENDER_END;
+    engine->flag &= ~RE_ENGINE_VIEW_LAYERS_REMAINING;
   }
 
   if (type->render_frame_finish) {
@@ -1127,13 +1168,18 @@ bool RE_engine_render(Render *re, bool do_all)
 
   /* Perform delayed grease pencil rendering. */
   if (delay_grease_pencil) {
+    int view_layer_index = 0;
     FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer_iter) {
+      SET_FLAG_FROM_TEST(engine->flag,
+                         ++view_layer_index < view_layers_num,
+                         RE_ENGINE_VIEW_LAYERS_REMAINING);
       engine_render_view_layer(re, engine, view_layer_iter, false, true);
       if (RE_engine_test_break(engine)) {
         break;
       }
     }
     FOREACH_VIEW_LAYER_TO_RENDER_END;
+    engine->flag &= ~RE_ENGINE_VIEW_LAYERS_REMAINING;
   }
 
   /* Clear tile data */
@@ -1212,7 +1258,7 @@ void RE_engine_free_blender_memory(RenderEngine *engine)
    *
    * TODO(sergey): Find better solution for this.
    */
-  if (engine->has_grease_pencil || engine_keep_depsgraph(engine)) {
+  if (engine->has_grease_pencil || engine_keep_depsgraph_for_next_view_layer(engine)) {
     return;
   }
   engine_depsgraph_free(engine);
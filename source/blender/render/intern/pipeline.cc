@@ -63,6 +63,8 @@
 
 #include "NOD_composite.h"
 
+#include "COM_compositor.h"
+
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_debug.h"
@@ -1354,8 +1356,11 @@ static void do_render_full_pipeline(Render *re)
 
   re->i.starttime = PIL_check_seconds_timer();
 
-  /* ensure no images are in memory from previous animated sequences */
-  BKE_image_all_free_anim_ibufs(re->main, re->r.cfra);
+  /* Ensure no images are in memory from previous animated sequences, except the frames that the
+   * compositor loaded ahead of time for the next frames of an animation. */
+  const int last_kept_frame = (re->flag & R_ANIMATION) ? re->r.cfra + COM_PREFETCH_FRAMES :
+                                                         re->r.cfra;
+  BKE_image_all_free_anim_ibufs(re->main, re->r.cfra, last_kept_frame);
   SEQ_cache_cleanup(re->scene);
 
   if (RE_engine_render(re, true)) {
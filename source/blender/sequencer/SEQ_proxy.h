@@ -33,6 +33,12 @@ void SEQ_proxy_rebuild(struct SeqIndexBuildContext *context,
                        bool *do_update,
                        float *progress);
 void SEQ_proxy_rebuild_finish(struct SeqIndexBuildContext *context, bool stop);
+/**
+ * Whether the context can be rebuilt concurrently with other contexts. This is the case for movie
+ * strips, whose index builder owns its decoder and encoders. Other strips render through the
+ * sequencer and are built one by one.
+ */
+bool SEQ_proxy_rebuild_is_threadsafe(const struct SeqIndexBuildContext *context);
 void SEQ_proxy_set(struct Sequence *seq, bool value);
 bool SEQ_can_use_proxy(const struct SeqRenderData *context, struct Sequence *seq, int psize);
 int SEQ_rendersize_to_proxysize(int render_size);
@@ -11,6 +11,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h" /* for FILE_MAX. */
@@ -28,6 +30,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_main.h"
@@ -66,6 +69,8 @@
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 2
+/* Number of images waiting to be written, after which writing an image waits for the others. */
+#define DCACHE_MAX_PENDING_WRITES 16
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
 
 typedef struct DiskCacheHeaderEntry {
@@ -87,6 +92,9 @@ typedef struct SeqDiskCache {
   ListBase files;
   ThreadMutex read_write_mutex;
   size_t size_total;
+  /* Images are written in a background thread, see #seq_disk_cache_write_file_async. */
+  TaskPool *write_pool;
+  int32_t pending_writes;
 } SeqDiskCache;
 
 typedef struct DiskCacheFile {
@@ -248,7 +256,8 @@ bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
   return true;
 }
 
-static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_cache, char *path)
+static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_cache,
+                                                             const char *path)
 {
   DiskCacheFile *cache_file = disk_cache->files.first;
 
@@ -262,7 +271,7 @@ static DiskCacheFile *seq_disk_cache_get_file_entry_by_path(SeqDiskCache *disk_c
 }
 
 /* Update file size and timestamp. */
-static void seq_disk_cache_update_file(SeqDiskCache *disk_cache, char *path)
+static void seq_disk_cache_update_file(SeqDiskCache *disk_cache, const char *path)
 {
   DiskCacheFile *cache_file;
   int64_t size_before;
@@ -410,6 +419,9 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   int start;
   int end;
 
+  /* Images written after deleting the files would be outdated. */
+  seq_disk_cache_wait_for_writes(disk_cache);
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   start = SEQ_time_left_handle_frame_get(scene, seq_changed) - DCACHE_IMAGES_PER_FILE;
@@ -483,7 +495,9 @@ static size_t seq_disk_cache_write_header(FILE *file, DiskCacheHeader *header)
   return fwrite(header, sizeof(*header), 1, file);
 }
 
-static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCacheHeader *header)
+static int seq_disk_cache_add_header_entry(float frame_index,
+                                           ImBuf *ibuf,
+                                           DiskCacheHeader *header)
 {
   int i;
   uint64_t offset = sizeof(*header);
@@ -516,7 +530,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   }
 
   header->entry[i].offset = offset;
-  header->entry[i].frameno = key->frame_index;
+  header->entry[i].frameno = frame_index;
 
   /* Store colorspace name of ibuf. */
   const char *colorspace_name;
@@ -545,13 +559,13 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, DiskCacheHeader *he
   return -1;
 }
 
-bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache,
+                                      const char *filepath,
+                                      float frame_index,
+                                      ImBuf *ibuf)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
-  char filepath[FILE_MAX];
-
-  seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
   BLI_make_existing_file(filepath);
 
   FILE *file = BLI_fopen(filepath, "rb+");
@@ -575,7 +589,7 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+  int entry_index = seq_disk_cache_add_header_entry(frame_index, ibuf, &header);
 
   size_t bytes_written = deflate_imbuf_to_file(
       ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
@@ -597,6 +611,52 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
   return false;
 }
 
+typedef struct DiskCacheWriteTask {
+  char filepath[FILE_MAX];
+  float frame_index;
+  ImBuf *ibuf;
+} DiskCacheWriteTask;
+
+static void seq_disk_cache_write_task(TaskPool *__restrict pool, void *taskdata)
+{
+  SeqDiskCache *disk_cache = BLI_task_pool_user_data(pool);
+  DiskCacheWriteTask *task = taskdata;
+
+  seq_disk_cache_write_file(disk_cache, task->filepath, task->frame_index, task->ibuf);
+  seq_disk_cache_enforce_limits(disk_cache);
+  atomic_sub_and_fetch_int32(&disk_cache->pending_writes, 1);
+}
+
+static void seq_disk_cache_write_task_free(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  DiskCacheWriteTask *task = taskdata;
+  IMB_freeImBuf(task->ibuf);
+  MEM_freeN(task);
+}
+
+void seq_disk_cache_write_file_async(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
+{
+  /* Don't let images pile up in memory when writing is slower than rendering. */
+  if (atomic_add_and_fetch_int32(&disk_cache->pending_writes, 1) > DCACHE_MAX_PENDING_WRITES) {
+    BLI_task_pool_work_and_wait(disk_cache->write_pool);
+  }
+
+  DiskCacheWriteTask *task = MEM_callocN(sizeof(DiskCacheWriteTask), "DiskCacheWriteTask");
+  /* The path is resolved now, since the strip may be freed before the image is written. */
+  seq_disk_cache_get_file_path(disk_cache, key, task->filepath, sizeof(task->filepath));
+  task->frame_index = key->frame_index;
+  task->ibuf = ibuf;
+  IMB_refImBuf(ibuf);
+
+  BLI_task_pool_push(
+      disk_cache->write_pool, seq_disk_cache_write_task, task, true, seq_disk_cache_write_task_free);
+}
+
+void seq_disk_cache_wait_for_writes(SeqDiskCache *disk_cache)
+{
+  BLI_task_pool_work_and_wait(disk_cache->write_pool);
+}
+
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
@@ -673,12 +733,15 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
   seq_disk_cache_handle_versioning(disk_cache);
   seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
   disk_cache->timestamp = scene->ed->disk_cache_timestamp;
+  disk_cache->write_pool = BLI_task_pool_create_background_serial(disk_cache, TASK_PRIORITY_LOW);
   BLI_mutex_unlock(&cache_create_lock);
   return disk_cache;
 }
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
+  BLI_task_pool_work_and_wait(disk_cache->write_pool);
+  BLI_task_pool_free(disk_cache->write_pool);
   BLI_freelistN(&disk_cache->files);
   BLI_mutex_end(&disk_cache->read_write_mutex);
   MEM_freeN(disk_cache);
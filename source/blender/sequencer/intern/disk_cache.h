@@ -26,9 +26,15 @@ struct SeqDiskCache *seq_disk_cache_create(struct Main *bmain, struct Scene *sce
 void seq_disk_cache_free(struct SeqDiskCache *disk_cache);
 bool seq_disk_cache_is_enabled(struct Main *bmain);
 struct ImBuf *seq_disk_cache_read_file(struct SeqDiskCache *disk_cache, struct SeqCacheKey *key);
-bool seq_disk_cache_write_file(struct SeqDiskCache *disk_cache,
-                               struct SeqCacheKey *key,
-                               struct ImBuf *ibuf);
+/**
+ * Write the image to the disk cache and enforce the size limit of the cache in a background
+ * thread. The image is referenced until it is written.
+ */
+void seq_disk_cache_write_file_async(struct SeqDiskCache *disk_cache,
+                                     struct SeqCacheKey *key,
+                                     struct ImBuf *ibuf);
+/** Wait until all images passed to #seq_disk_cache_write_file_async are written. */
+void seq_disk_cache_wait_for_writes(struct SeqDiskCache *disk_cache);
 bool seq_disk_cache_enforce_limits(struct SeqDiskCache *disk_cache);
 void seq_disk_cache_invalidate(struct SeqDiskCache *disk_cache,
                                struct Scene *scene,
@@ -281,67 +281,37 @@ static void seq_cache_relink_keys(SeqCacheKey *link_next, SeqCacheKey *link_prev
   }
 }
 
-/* Choose a key out of 2 candidates(leftmost and rightmost items)
- * to recycle based on currently used strategy */
-static SeqCacheKey *seq_cache_choose_key(Scene *scene, SeqCacheKey *lkey, SeqCacheKey *rkey)
+/* Memory used by the images of the frame of the given base key, which are freed all at once. */
+static size_t seq_cache_linked_memory_size(SeqCache *cache, SeqCacheKey *base)
 {
-  SeqCacheKey *finalkey = NULL;
-
-  /* Ideally, cache would not need to check the state of prefetching task
-   * that is tricky to do however, because prefetch would need to know,
-   * if a key, that is about to be created would be removed by itself.
-   *
-   * This can happen because only FINAL_OUT item insertion will trigger recycling
-   * but that is also the point, where prefetch can be suspended.
-   *
-   * We could use temp cache as a shield and later make it a non-temporary entry,
-   * but it is not worth of increasing system complexity.
-   */
-  if (scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE && seq_prefetch_job_is_running(scene)) {
-    int pfjob_start, pfjob_end;
-    seq_prefetch_get_time_range(scene, &pfjob_start, &pfjob_end);
+  size_t size = 0;
 
-    if (lkey) {
-      if (lkey->timeline_frame < pfjob_start || lkey->timeline_frame > pfjob_end) {
-        return lkey;
-      }
+  for (SeqCacheKey *key = base; key != NULL; key = key->link_prev) {
+    SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
+    if (item == NULL) {
+      break; /* Key has already been removed from cache. */
     }
-
-    if (rkey) {
-      if (rkey->timeline_frame < pfjob_start || rkey->timeline_frame > pfjob_end) {
-        return rkey;
-      }
+    if (item->ibuf) {
+      size += IMB_get_size_in_memory(item->ibuf);
     }
 
-    return NULL;
-  }
-
-  if (rkey && lkey) {
-    if (lkey->timeline_frame > rkey->timeline_frame) {
-      SeqCacheKey *swapkey = lkey;
-      lkey = rkey;
-      rkey = swapkey;
+    SeqCacheKey *prev = key->link_prev;
+    if (prev != NULL && prev->link_next != key) {
+      break; /* Key has been replaced and doesn't belong to this chain anymore. */
     }
+  }
 
-    int l_diff = scene->r.cfra - lkey->timeline_frame;
-    int r_diff = rkey->timeline_frame - scene->r.cfra;
+  return size;
+}
 
-    if (l_diff > r_diff) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
-    }
-  }
-  else {
-    if (lkey) {
-      finalkey = lkey;
-    }
-    else {
-      finalkey = rkey;
-    }
-  }
-  return finalkey;
+/* Frames far from the current frame, using a lot of memory and cheap to render again are freed
+ * first. The cost of a frame is its render time in frame durations, so frames which render in
+ * realtime have a cost below 1 and are always favored for removal over frames which don't. */
+static double seq_cache_key_removal_score(Scene *scene, SeqCache *cache, SeqCacheKey *base)
+{
+  const double distance = fabs(base->timeline_frame - scene->r.cfra) + 1.0;
+  const double size = seq_cache_linked_memory_size(cache, base);
+  return distance * size / (1.0 + base->cost);
 }
 
 static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
@@ -391,18 +361,30 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *finalkey = NULL;
-  /* Leftmost key. */
-  SeqCacheKey *lkey = NULL;
-  /* Rightmost key. */
-  SeqCacheKey *rkey = NULL;
-  SeqCacheKey *key = NULL;
+  double finalkey_score = 0.0;
+
+  /* Ideally, cache would not need to check the state of prefetching task
+   * that is tricky to do however, because prefetch would need to know,
+   * if a key, that is about to be created would be removed by itself.
+   *
+   * This can happen because only FINAL_OUT item insertion will trigger recycling
+   * but that is also the point, where prefetch can be suspended.
+   *
+   * We could use temp cache as a shield and later make it a non-temporary entry,
+   * but it is not worth of increasing system complexity.
+   */
+  const bool is_prefetching = scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE &&
+                              seq_prefetch_job_is_running(scene);
+  int pfjob_start = 0, pfjob_end = 0;
+  if (is_prefetching) {
+    seq_prefetch_get_time_range(scene, &pfjob_start, &pfjob_end);
+  }
 
   GHashIterator gh_iter;
   BLI_ghashIterator_init(&gh_iter, cache->hash);
-  int total_count = 0;
 
   while (!BLI_ghashIterator_done(&gh_iter)) {
-    key = BLI_ghashIterator_getKey(&gh_iter);
+    SeqCacheKey *key = BLI_ghashIterator_getKey(&gh_iter);
     SeqCacheItem *item = BLI_ghashIterator_getValue(&gh_iter);
     BLI_ghashIterator_step(&gh_iter);
 
@@ -411,6 +393,8 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       seq_cache_recycle_linked(scene, key);
       /* Can not continue iterating after linked remove. */
       BLI_ghashIterator_init(&gh_iter, cache->hash);
+      finalkey = NULL;
+      finalkey_score = 0.0;
       continue;
     }
 
@@ -418,28 +402,19 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
       continue;
     }
 
-    total_count++;
-
-    if (lkey) {
-      if (key->timeline_frame < lkey->timeline_frame) {
-        lkey = key;
-      }
-    }
-    else {
-      lkey = key;
-    }
-    if (rkey) {
-      if (key->timeline_frame > rkey->timeline_frame) {
-        rkey = key;
-      }
+    /* Don't remove frames that prefetch is rendering. */
+    if (is_prefetching && key->timeline_frame >= pfjob_start &&
+        key->timeline_frame <= pfjob_end) {
+      continue;
     }
-    else {
-      rkey = key;
+
+    const double score = seq_cache_key_removal_score(scene, cache, key);
+    if (finalkey == NULL || score > finalkey_score) {
+      finalkey = key;
+      finalkey_score = score;
     }
   }
 
-  finalkey = seq_cache_choose_key(scene, lkey, rkey);
-
   return finalkey;
 }
 
@@ -786,31 +761,6 @@ struct ImBuf *seq_cache_get(const SeqRenderData *context,
   return ibuf;
 }
 
-bool seq_cache_put_if_possible(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *ibuf)
-{
-  Scene *scene = context->scene;
-
-  if (context->is_prefetch_render) {
-    context = seq_prefetch_get_original_context(context);
-    scene = context->scene;
-    seq = seq_prefetch_get_original_sequence(seq, scene);
-  }
-
-  if (!seq) {
-    return false;
-  }
-
-  if (seq_cache_recycle_item(scene)) {
-    seq_cache_put(context, seq, timeline_frame, type, ibuf);
-    return true;
-  }
-
-  seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
-  scene->ed->cache->last_key = NULL;
-  return false;
-}
-
 void seq_cache_thumbnail_put(const SeqRenderData *context,
                              Sequence *seq,
                              float timeline_frame,
@@ -845,8 +795,12 @@ void seq_cache_thumbnail_put(const SeqRenderData *context,
   seq_cache_unlock(scene);
 }
 
-void seq_cache_put(
-    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *i)
+static void seq_cache_put_with_cost(const SeqRenderData *context,
+                                    Sequence *seq,
+                                    float timeline_frame,
+                                    int type,
+                                    ImBuf *i,
+                                    float cost)
 {
   if (i == NULL || context->skip_cache || context->is_proxy_render || !seq) {
     return;
@@ -875,21 +829,77 @@ void seq_cache_put(
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+  key->cost = cost;
   seq_cache_put_ex(scene, key, i);
   seq_cache_unlock(scene);
 
   if (!key->is_temp_cache) {
     if (seq_disk_cache_is_enabled(context->bmain)) {
       if (cache->disk_cache == NULL) {
-        seq_disk_cache_create(context->bmain, context->scene);
+        cache->disk_cache = seq_disk_cache_create(context->bmain, context->scene);
       }
 
-      seq_disk_cache_write_file(cache->disk_cache, key, i);
-      seq_disk_cache_enforce_limits(cache->disk_cache);
+      seq_disk_cache_write_file_async(cache->disk_cache, key, i);
     }
   }
 }
 
+void seq_cache_put(
+    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *i)
+{
+  seq_cache_put_with_cost(context, seq, timeline_frame, type, i, 0.0f);
+}
+
+static bool seq_cache_put_if_possible_with_cost(const SeqRenderData *context,
+                                                Sequence *seq,
+                                                float timeline_frame,
+                                                int type,
+                                                ImBuf *ibuf,
+                                                float cost)
+{
+  Scene *scene = context->scene;
+
+  if (context->is_prefetch_render) {
+    context = seq_prefetch_get_original_context(context);
+    scene = context->scene;
+    seq = seq_prefetch_get_original_sequence(seq, scene);
+  }
+
+  if (!seq) {
+    return false;
+  }
+
+  if (seq_cache_recycle_item(scene)) {
+    seq_cache_put_with_cost(context, seq, timeline_frame, type, ibuf, cost);
+    return true;
+  }
+
+  seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
+  scene->ed->cache->last_key = NULL;
+  return false;
+}
+
+bool seq_cache_put_if_possible(
+    const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *ibuf)
+{
+  return seq_cache_put_if_possible_with_cost(context, seq, timeline_frame, type, ibuf, 0.0f);
+}
+
+void seq_cache_final_out_put(const SeqRenderData *context,
+                             Sequence *seq,
+                             float timeline_frame,
+                             ImBuf *ibuf,
+                             float cost)
+{
+  if (context->is_prefetch_render) {
+    seq_cache_put_with_cost(context, seq, timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, ibuf, cost);
+  }
+  else {
+    seq_cache_put_if_possible_with_cost(
+        context, seq, timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, ibuf, cost);
+  }
+}
+
 void SEQ_cache_iterate(
     struct Scene *scene,
     void *userdata,
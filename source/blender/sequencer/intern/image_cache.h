@@ -54,6 +54,15 @@ bool seq_cache_put_if_possible(const struct SeqRenderData *context,
                                float timeline_frame,
                                int type,
                                struct ImBuf *nval);
+/**
+ * Store the final image of a frame along with the cost of rendering it, see #SeqCacheKey.cost.
+ * Prefetched frames are always stored, other frames only if the cache has room for them.
+ */
+void seq_cache_final_out_put(const struct SeqRenderData *context,
+                             struct Sequence *seq,
+                             float timeline_frame,
+                             struct ImBuf *ibuf,
+                             float cost);
 /**
  * Find only "base" keys.
  * Sources(other types) for a frame must be freed all at once.
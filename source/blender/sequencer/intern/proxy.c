@@ -546,6 +546,11 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context, bool *stop, bool *do_updat
   }
 }
 
+bool SEQ_proxy_rebuild_is_threadsafe(const SeqIndexBuildContext *context)
+{
+  return context->seq->type == SEQ_TYPE_MOVIE && context->index_context != NULL;
+}
+
 void SEQ_proxy_rebuild_finish(SeqIndexBuildContext *context, bool stop)
 {
   if (context->index_context) {
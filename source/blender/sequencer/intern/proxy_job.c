@@ -9,8 +9,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_math_base.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_timecode.h"
 
 #include "DNA_scene_types.h"
@@ -31,6 +36,12 @@
 
 #include "RNA_define.h"
 
+#include "PIL_time.h"
+
+/* Decoders and encoders of movie strips are threaded already, so only one strip is built per this
+ * many cores at the same time. */
+#define PROXY_JOB_THREADS_PER_STRIP 4
+
 static void proxy_freejob(void *pjv)
 {
   ProxyJob *pj = pjv;
@@ -40,16 +51,101 @@ static void proxy_freejob(void *pjv)
   MEM_freeN(pj);
 }
 
+typedef struct ProxyParallelData {
+  struct SeqIndexBuildContext **contexts;
+  /* Progress of every context, polled by the job thread. */
+  float *progress;
+  int contexts_num;
+  /* Index of the next context to be picked up by a worker. */
+  int32_t next_context;
+  int32_t running_workers;
+  bool *stop;
+} ProxyParallelData;
+
+static void proxy_parallel_worker(TaskPool *__restrict pool, void *UNUSED(taskdata))
+{
+  ProxyParallelData *data = BLI_task_pool_user_data(pool);
+  int i;
+
+  while (!*data->stop &&
+         (i = atomic_fetch_and_add_int32(&data->next_context, 1)) < data->contexts_num) {
+    bool do_update = false;
+    SEQ_proxy_rebuild(data->contexts[i], data->stop, &do_update, &data->progress[i]);
+    data->progress[i] = 1.0f;
+  }
+
+  atomic_sub_and_fetch_int32(&data->running_workers, 1);
+}
+
+/* Build the proxies of all movie strips in the queue, several strips at a time. The job thread
+ * only reports the combined progress while the workers run. */
+static void proxy_rebuild_parallel(ProxyJob *pj, bool *stop, bool *do_update, float *progress)
+{
+  ProxyParallelData data = {NULL};
+  LinkData *link;
+
+  for (link = pj->queue.first; link; link = link->next) {
+    if (SEQ_proxy_rebuild_is_threadsafe(link->data)) {
+      data.contexts_num++;
+    }
+  }
+
+  if (data.contexts_num == 0) {
+    return;
+  }
+
+  data.contexts = MEM_malloc_arrayN(data.contexts_num, sizeof(*data.contexts), __func__);
+  data.progress = MEM_calloc_arrayN(data.contexts_num, sizeof(*data.progress), __func__);
+  data.stop = stop;
+
+  int i = 0;
+  for (link = pj->queue.first; link; link = link->next) {
+    if (SEQ_proxy_rebuild_is_threadsafe(link->data)) {
+      data.contexts[i++] = link->data;
+    }
+  }
+
+  const int workers_num = min_ii(
+      data.contexts_num, max_ii(1, BLI_system_thread_count() / PROXY_JOB_THREADS_PER_STRIP));
+  data.running_workers = workers_num;
+
+  TaskPool *pool = BLI_task_pool_create_background(&data, TASK_PRIORITY_LOW);
+  for (i = 0; i < workers_num; i++) {
+    BLI_task_pool_push(pool, proxy_parallel_worker, NULL, false, NULL);
+  }
+
+  while (atomic_load_int32(&data.running_workers) > 0) {
+    float progress_sum = 0.0f;
+    for (i = 0; i < data.contexts_num; i++) {
+      progress_sum += data.progress[i];
+    }
+    *progress = progress_sum / data.contexts_num;
+    *do_update = true;
+
+    PIL_sleep_ms(100);
+  }
+
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+
+  MEM_freeN(data.contexts);
+  MEM_freeN(data.progress);
+}
+
 /* Only this runs inside thread. */
 static void proxy_startjob(void *pjv, bool *stop, bool *do_update, float *progress)
 {
   ProxyJob *pj = pjv;
   LinkData *link;
 
+  proxy_rebuild_parallel(pj, stop, do_update, progress);
+
   for (link = pj->queue.first; link; link = link->next) {
     struct SeqIndexBuildContext *context = link->data;
 
-    SEQ_proxy_rebuild(context, stop, do_update, progress);
+    if (!*stop && !SEQ_proxy_rebuild_is_threadsafe(context)) {
+      SEQ_proxy_rebuild(context, stop, do_update, progress);
+    }
 
     if (*stop) {
       pj->stop = true;
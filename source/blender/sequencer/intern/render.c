@@ -22,6 +22,9 @@
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
+
+#include "PIL_time.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -1077,10 +1080,10 @@ static ImBuf *seq_render_movie_strip_view(const SeqRenderData *context,
       ibuf = seq_render_movie_strip_custom_file_proxy(context, seq, timeline_frame);
     }
     else {
-      ibuf = IMB_anim_absolute(sanim->anim,
-                               frame_index + seq->anim_startofs,
-                               seq_render_movie_strip_timecode_get(seq),
-                               psize);
+      ibuf = IMB_anim_absolute_shared(sanim->anim,
+                                      frame_index + seq->anim_startofs,
+                                      seq_render_movie_strip_timecode_get(seq),
+                                      psize);
     }
 
     if (ibuf != NULL) {
@@ -1090,15 +1093,23 @@ static ImBuf *seq_render_movie_strip_view(const SeqRenderData *context,
 
   /* Fetching for requested proxy size failed, try fetching the original instead. */
   if (ibuf == NULL) {
-    ibuf = IMB_anim_absolute(sanim->anim,
-                             frame_index + seq->anim_startofs,
-                             seq_render_movie_strip_timecode_get(seq),
-                             IMB_PROXY_NONE);
+    ibuf = IMB_anim_absolute_shared(sanim->anim,
+                                    frame_index + seq->anim_startofs,
+                                    seq_render_movie_strip_timecode_get(seq),
+                                    IMB_PROXY_NONE);
   }
   if (ibuf == NULL) {
     return NULL;
   }
 
+  /* The frame can be shared with other users of the movie file, such as movie clips, so copy it
+   * before it gets converted in place. */
+  if (ibuf->rect_float != NULL ||
+      !STREQ(IMB_colormanagement_get_rect_colorspace(ibuf),
+             context->scene->sequencer_colorspace_settings.name)) {
+    ibuf = IMB_makeSingleUser(ibuf);
+  }
+
   seq_imbuf_to_sequencer_space(context->scene, ibuf, false);
 
   /* We don't need both (speed reasons)! */
@@ -1849,6 +1860,153 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Image and movie strips only read their own files, so they can be rendered concurrently. */
+static bool seq_can_render_in_parallel(const Sequence *seq)
+{
+  if (seq == NULL || !ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+
+  /* Modifiers can use other strips as masks, which may be rendered at the same time. */
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence != NULL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void seq_parallel_strips_add(Sequence **strips, int *strips_num, Sequence *seq)
+{
+  if (!seq_can_render_in_parallel(seq)) {
+    return;
+  }
+  for (int i = 0; i < *strips_num; i++) {
+    if (strips[i] == seq) {
+      return;
+    }
+  }
+  strips[(*strips_num)++] = seq;
+}
+
+typedef struct RenderStripsParallelData {
+  const SeqRenderData *context;
+  Sequence **strips;
+  float timeline_frame;
+} RenderStripsParallelData;
+
+static void seq_render_strips_parallel_fn(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RenderStripsParallelData *data = userdata;
+  SeqRenderState state;
+  seq_render_state_init(&state);
+
+  /* The image is stored in cache, where the strip stack will find it. */
+  ImBuf *ibuf = seq_render_strip(data->context, &state, data->strips[i], data->timeline_frame);
+  IMB_freeImBuf(ibuf);
+}
+
+static void seq_render_strips_parallel(const SeqRenderData *context,
+                                       Sequence **strips,
+                                       int strips_num,
+                                       float timeline_frame)
+{
+  RenderStripsParallelData data = {
+      .context = context,
+      .strips = strips,
+      .timeline_frame = timeline_frame,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = strips_num > 1;
+  BLI_task_parallel_range(0, strips_num, &data, seq_render_strips_parallel_fn, &settings);
+}
+
+/**
+ * Render image and movie strips of the stack, as well as image and movie inputs of effect strips,
+ * in parallel before they are blended in order by #seq_render_strip_stack. Only strips that the
+ * stack would render are considered, so this goes over the strips from the top with the same early
+ * out rules. An opaque alpha over strip can only be detected once it is rendered, so strips
+ * collected so far are rendered at that point, before deciding whether to continue.
+ *
+ * This relies on rendered images being stored in cache, so it does nothing when the cache is not
+ * used.
+ */
+static void seq_render_strip_stack_parallel(const SeqRenderData *context,
+                                            Sequence **seq_arr,
+                                            int count,
+                                            float timeline_frame)
+{
+  if (context->skip_cache || context->is_proxy_render) {
+    return;
+  }
+
+  /* Each strip of the stack adds either itself or up to 3 inputs. */
+  Sequence *strips[(MAXSEQ + 1) * 3];
+  int strips_num = 0;
+
+  for (int i = count - 1; i >= 0; i--) {
+    Sequence *seq = seq_arr[i];
+
+    ImBuf *composite = seq_cache_get(context, seq, timeline_frame, SEQ_CACHE_STORE_COMPOSITE);
+    if (composite) {
+      IMB_freeImBuf(composite);
+      break;
+    }
+
+    const int early_out = seq_get_early_out_for_blend_mode(seq);
+    const bool is_last = seq->blend_mode == SEQ_BLEND_REPLACE ||
+                         ELEM(early_out, EARLY_NO_INPUT, EARLY_USE_INPUT_2);
+    const bool is_alpha_over_test = !is_last && seq->blend_mode == SEQ_TYPE_ALPHAOVER &&
+                                    seq->blend_opacity == 100.0f;
+
+    if (early_out == EARLY_USE_INPUT_1 && !is_alpha_over_test) {
+      continue;
+    }
+
+    if (seq_can_render_in_parallel(seq)) {
+      seq_parallel_strips_add(strips, &strips_num, seq);
+    }
+    else if ((seq->type & SEQ_TYPE_EFFECT) && seq->type != SEQ_TYPE_SPEED) {
+      /* Speed effect renders its input at a different frame. */
+      seq_parallel_strips_add(strips, &strips_num, seq->seq1);
+      seq_parallel_strips_add(strips, &strips_num, seq->seq2);
+      seq_parallel_strips_add(strips, &strips_num, seq->seq3);
+    }
+
+    if (is_last) {
+      break;
+    }
+
+    if (is_alpha_over_test) {
+      /* Whether strips below are needed can't be known before rendering this strip. */
+      if (!seq_can_render_in_parallel(seq)) {
+        break;
+      }
+
+      seq_render_strips_parallel(context, strips, strips_num, timeline_frame);
+      strips_num = 0;
+
+      SeqRenderState state;
+      seq_render_state_init(&state);
+      ImBuf *test = seq_render_strip(context, &state, seq, timeline_frame);
+      const bool is_opaque = ELEM(test->planes, R_IMF_PLANES_BW, R_IMF_PLANES_RGB);
+      IMB_freeImBuf(test);
+      if (is_opaque) {
+        break;
+      }
+    }
+  }
+
+  if (strips_num > 0) {
+    seq_render_strips_parallel(context, strips, strips_num, timeline_frame);
+  }
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -1868,6 +2026,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     return NULL;
   }
 
+  seq_render_strip_stack_parallel(context, seq_arr, count, timeline_frame);
+
   for (i = count - 1; i >= 0; i--) {
     int early_out;
     Sequence *seq = seq_arr[i];
@@ -1988,15 +2148,12 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
 
   if (count && !out) {
     BLI_mutex_lock(&seq_render_mutex);
+    const double render_start = PIL_check_seconds_timer();
     out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
 
-    if (context->is_prefetch_render) {
-      seq_cache_put(context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
-    }
-    else {
-      seq_cache_put_if_possible(
-          context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
-    }
+    /* Render time in frame durations. */
+    const float cost = (PIL_check_seconds_timer() - render_start) * FPS;
+    seq_cache_final_out_put(context, seq_arr[count - 1], timeline_frame, out, cost);
     BLI_mutex_unlock(&seq_render_mutex);
   }
 
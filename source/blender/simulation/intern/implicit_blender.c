@@ -18,6 +18,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -34,6 +35,9 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum number of vertices handled by one thread in the solver's vector operations. */
+#  define CLOTH_THREADING_LIMIT 1024
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -170,19 +174,65 @@ DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float s
     VECSUBMUL(to[i], fLongVector[i], scalar);
   }
 }
+
+BLI_INLINE void cloth_parallel_range_settings(TaskParallelSettings *settings, uint items)
+{
+  BLI_parallel_range_settings_defaults(settings);
+  settings->use_threading = items > CLOTH_THREADING_LIMIT;
+  settings->min_iter_per_thread = CLOTH_THREADING_LIMIT;
+}
+
+typedef struct DotLFVectorData {
+  float (*a)[3];
+  float (*b)[3];
+  float *chunk_sums;
+  uint verts;
+} DotLFVectorData;
+
+static void dot_lfvector_chunk_cb(void *__restrict userdata,
+                                  const int chunk,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DotLFVectorData *data = (DotLFVectorData *)userdata;
+  const uint end = MIN2((uint)(chunk + 1) * CLOTH_THREADING_LIMIT, data->verts);
+  float temp = 0.0f;
+  for (uint i = (uint)chunk * CLOTH_THREADING_LIMIT; i < end; i++) {
+    temp += dot_v3v3(data->a[i], data->b[i]);
+  }
+  data->chunk_sums[chunk] = temp;
+}
+
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  //#pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < (long)verts; i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  /* Floating point addition is not associative, so a plain parallel reduction would give
+   * different results each time the simulation runs. Instead, sum fixed size chunks in parallel
+   * and add the chunk sums in order, which gives the same result for any number of threads. */
+  const uint chunks_num = (verts + CLOTH_THREADING_LIMIT - 1) / CLOTH_THREADING_LIMIT;
+  if (chunks_num <= 1) {
+    float temp = 0.0f;
+    for (uint i = 0; i < verts; i++) {
+      temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+    }
+    return temp;
+  }
+
+  float *chunk_sums = (float *)MEM_mallocN(sizeof(float) * chunks_num, __func__);
+  DotLFVectorData data = {
+      .a = fLongVectorA,
+      .b = fLongVectorB,
+      .chunk_sums = chunk_sums,
+      .verts = verts,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, (int)chunks_num, &data, dot_lfvector_chunk_cb, &settings);
+
+  float temp = 0.0f;
+  for (uint i = 0; i < chunks_num; i++) {
+    temp += chunk_sums[i];
   }
+  MEM_freeN(chunk_sums);
   return temp;
 }
 /* `A = B + C` -> for big vector. */
@@ -197,15 +247,29 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
     add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
   }
 }
+typedef struct AddLFVectorData {
+  float (*to)[3];
+  float (*a)[3];
+  float (*b)[3];
+  float bS;
+} AddLFVectorData;
+
+static void add_lfvector_lfvectorS_cb(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  AddLFVectorData *data = (AddLFVectorData *)userdata;
+  VECADDS(data->to[i], data->a[i], data->b[i], data->bS);
+}
+
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  AddLFVectorData data = {.to = to, .a = fLongVectorA, .b = fLongVectorB, .bS = bS};
+  TaskParallelSettings settings;
+  cloth_parallel_range_settings(&settings, verts);
+  BLI_task_parallel_range(0, (int)verts, &data, add_lfvector_lfvectorS_cb, &settings);
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -614,6 +678,103 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
   del_lfvector(temp);
 }
 
+/**
+ * The blocks of a sparse symmetric big matrix sorted by the row of the product they contribute
+ * to, so that the rows of a matrix-vector product can be computed independently of each other.
+ * For every row, the blocks stored in that row come first, followed by the off-diagonal blocks
+ * that contribute through their transpose (the upper triangle is not stored).
+ */
+typedef struct fmatrixRows {
+  uint *offsets;          /* vcount + 1 offsets into `blocks`. */
+  uint *transposed_start; /* Start of the transposed blocks of every row. */
+  uint *blocks;           /* Block indices. */
+} fmatrixRows;
+
+/* The rows only depend on the row and column numbers of the blocks,
+ * so they can be shared between matrices with the same layout. */
+static void create_bfmatrix_rows(fmatrixRows *rows, fmatrix3x3 *matrix)
+{
+  const uint vcount = matrix[0].vcount;
+  const uint total = vcount + matrix[0].scount;
+
+  uint *offsets = (uint *)MEM_callocN(sizeof(uint) * (vcount + 1), "cloth matrix row offsets");
+  for (uint i = 0; i < total; i++) {
+    offsets[matrix[i].r + 1]++;
+    if (i >= vcount) {
+      offsets[matrix[i].c + 1]++;
+    }
+  }
+  for (uint row = 0; row < vcount; row++) {
+    offsets[row + 1] += offsets[row];
+  }
+
+  /* Fill in block order, so every row sums its blocks in the same order as a serial loop. */
+  uint *blocks = (uint *)MEM_mallocN(sizeof(uint) * offsets[vcount], "cloth matrix row blocks");
+  uint *cursor = (uint *)MEM_mallocN(sizeof(uint) * vcount, "cloth matrix row starts");
+  memcpy(cursor, offsets, sizeof(uint) * vcount);
+  for (uint i = 0; i < total; i++) {
+    blocks[cursor[matrix[i].r]++] = i;
+  }
+  uint *transposed_start = (uint *)MEM_dupallocN(cursor);
+  for (uint i = vcount; i < total; i++) {
+    blocks[cursor[matrix[i].c]++] = i;
+  }
+  MEM_freeN(cursor);
+
+  rows->offsets = offsets;
+  rows->transposed_start = transposed_start;
+  rows->blocks = blocks;
+}
+
+static void free_bfmatrix_rows(fmatrixRows *rows)
+{
+  MEM_SAFE_FREE(rows->offsets);
+  MEM_SAFE_FREE(rows->transposed_start);
+  MEM_SAFE_FREE(rows->blocks);
+}
+
+typedef struct MulBFMatrixData {
+  float (*to)[3];
+  fmatrix3x3 *matrix;
+  const fmatrixRows *rows;
+  lfVector *vector;
+} MulBFMatrixData;
+
+static void mul_bfmatrix_rows_lfvector_cb(void *__restrict userdata,
+                                          const int row,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MulBFMatrixData *data = (MulBFMatrixData *)userdata;
+  const fmatrix3x3 *matrix = data->matrix;
+  const fmatrixRows *rows = data->rows;
+  float direct[3] = {0.0f, 0.0f, 0.0f};
+  float transposed[3] = {0.0f, 0.0f, 0.0f};
+
+  for (uint i = rows->offsets[row]; i < rows->transposed_start[row]; i++) {
+    const fmatrix3x3 *block = &matrix[rows->blocks[i]];
+    muladd_fmatrix_fvector(direct, block->m, data->vector[block->c]);
+  }
+  for (uint i = rows->transposed_start[row]; i < rows->offsets[row + 1]; i++) {
+    const fmatrix3x3 *block = &matrix[rows->blocks[i]];
+    muladd_fmatrixT_fvector(transposed, block->m, data->vector[block->r]);
+  }
+  add_v3_v3v3(data->to[row], transposed, direct);
+}
+
+/* SPARSE SYMMETRIC multiply big matrix with long vector, computing the rows in parallel.
+ * Gives the same result as #mul_bfmatrix_lfvector. */
+DO_INLINE void mul_bfmatrix_rows_lfvector(float (*to)[3],
+                                          fmatrix3x3 *from,
+                                          const fmatrixRows *rows,
+                                          lfVector *fLongVector)
+{
+  MulBFMatrixData data = {.to = to, .matrix = from, .rows = rows, .vector = fLongVector};
+  TaskParallelSettings settings;
+  cloth_parallel_range_settings(&settings, from[0].vcount);
+  BLI_task_parallel_range(
+      0, (int)from[0].vcount, &data, mul_bfmatrix_rows_lfvector_cb, &settings);
+}
+
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
 /* A -= B * float + C * float --> for big matrix */
 /* VERIFIED */
@@ -741,13 +902,26 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 /* ================================ */
 
-DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
+typedef struct FilterData {
+  lfVector *V;
+  fmatrix3x3 *S;
+} FilterData;
+
+static void filter_cb(void *__restrict userdata,
+                      const int i,
+                      const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  uint i = 0;
+  FilterData *data = (FilterData *)userdata;
+  mul_m3_v3(data->S[i].m, data->V[data->S[i].r]);
+}
 
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
+{
+  /* S only has diagonal blocks, so every block writes to a different vertex. */
+  FilterData data = {.V = V, .S = S};
+  TaskParallelSettings settings;
+  cloth_parallel_range_settings(&settings, S[0].vcount);
+  BLI_task_parallel_range(0, (int)S[0].vcount, &data, filter_cb, &settings);
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -822,6 +996,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const fmatrixRows *lA_rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -849,7 +1024,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_rows_lfvector(AdV, lA, lA_rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -872,7 +1047,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_rows_lfvector(q, lA, lA_rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1132,7 +1307,12 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All matrices get their off-diagonal blocks from #SIM_mass_spring_add_block,
+   * so they share the same layout. */
+  fmatrixRows rows;
+  create_bfmatrix_rows(&rows, data->A);
+
+  mul_bfmatrix_rows_lfvector(dFdXmV, data->dFdX, &rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1141,7 +1321,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &rows, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -1153,6 +1333,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
   /* advance velocities */
   add_lfvector_lfvector(data->Vnew, data->V, data->dV, numverts);
 
+  free_bfmatrix_rows(&rows);
   del_lfvector(dFdXmV);
 
   return result->status == SIM_SOLVER_SUCCESS;
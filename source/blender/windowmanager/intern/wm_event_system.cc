@@ -5308,6 +5308,8 @@ void wm_event_add_ghostevent(wmWindowManager *wm, wmWindow *win, int type, void
     return;
   }
 
+  wm_jobs_user_interaction_tag();
+
   /**
    * Having both, \a event and \a event_state, can be highly confusing to work with,
    * but is necessary for our current event system, so let's clear things up a bit:
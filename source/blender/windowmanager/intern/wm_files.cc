@@ -870,6 +870,27 @@ static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
             duration_lib_override_recursive_resync_minutes,
             duration_lib_override_recursive_resync_seconds);
 
+  if (G.debug & G_DEBUG_IO) {
+    const double mb = 1024.0 * 1024.0;
+    printf("Blend file read phases:\n");
+    printf("  Read data:                %9.3fs, %+10.2f MB\n",
+           bf_reports->duration.read_data,
+           double(bf_reports->memory.read_data) / mb);
+    printf("  Versioning:               %9.3fs, %+10.2f MB\n",
+           bf_reports->duration.versioning,
+           double(bf_reports->memory.versioning) / mb);
+    printf("  Libraries (with linking): %9.3fs, %+10.2f MB\n",
+           bf_reports->duration.libraries,
+           double(bf_reports->memory.libraries) / mb);
+    printf("  Lib-link:                 %9.3fs, %+10.2f MB\n",
+           bf_reports->duration.lib_link,
+           double(bf_reports->memory.lib_link) / mb);
+    printf("  ID user-count recompute:  %9.3fs\n", bf_reports->duration.id_refcount_recompute);
+    printf("  Overrides:                %9.3fs\n", bf_reports->duration.lib_overrides);
+    printf("  Overrides resync:         %9.3fs\n", bf_reports->duration.lib_overrides_resync);
+    printf("  Total:                    %9.3fs\n", bf_reports->duration.whole);
+  }
+
   if (bf_reports->resynced_lib_overrides_libraries_count != 0) {
     for (LinkNode *node_lib = bf_reports->resynced_lib_overrides_libraries; node_lib != nullptr;
          node_lib = node_lib->next) {
@@ -1961,6 +1982,55 @@ static void wm_autosave_location(char filepath[FILE_MAX])
   BLI_path_join(filepath, FILE_MAX, tempdir_base, path);
 }
 
+struct AutosaveJob {
+  char filepath[FILE_MAX];
+  /** Copy of the undo memfile, owned by the job. */
+  MemFile *memfile;
+};
+
+static void wm_autosave_job_startjob(void *customdata,
+                                     bool * /*stop*/,
+                                     bool * /*do_update*/,
+                                     float * /*progress*/)
+{
+  AutosaveJob *job = static_cast<AutosaveJob *>(customdata);
+  BLO_memfile_write_file(job->memfile, job->filepath);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  AutosaveJob *job = static_cast<AutosaveJob *>(customdata);
+  BLO_memfile_free(job->memfile);
+  MEM_freeN(job->memfile);
+  MEM_freeN(job);
+}
+
+/**
+ * Write the undo memfile from a background job, only copying the memory is done here.
+ * The memfile itself can't be used from the job since undo steps share unchanged chunks,
+ * which may be freed while writing (when undo steps are added & removed).
+ */
+static void wm_autosave_write_memfile_job(wmWindowManager *wm,
+                                          const MemFile *memfile,
+                                          const char *filepath)
+{
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    /* Previous auto-save is still being written, skip this one. */
+    return;
+  }
+
+  AutosaveJob *job = static_cast<AutosaveJob *>(MEM_callocN(sizeof(AutosaveJob), __func__));
+  STRNCPY(job->filepath, filepath);
+  job->memfile = BLO_memfile_copy_for_write(memfile);
+
+  wmJob *wm_job = WM_jobs_get(
+      wm, wm->winactive, wm, "Auto-Save", eWM_JobFlag(0), WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, job, wm_autosave_job_free);
+  WM_jobs_timer(wm_job, 0.1, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, nullptr, nullptr, nullptr);
+  WM_jobs_start(wm, wm_job);
+}
+
 static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
@@ -1971,7 +2041,12 @@ static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
   const bool use_memfile = (U.uiflag & USER_GLOBALUNDO) != 0;
   MemFile *memfile = use_memfile ? ED_undosys_stack_memfile_get_active(wm->undo_stack) : nullptr;
   if (memfile != nullptr) {
-    BLO_memfile_write_file(memfile, filepath);
+    if (G.background) {
+      BLO_memfile_write_file(memfile, filepath);
+    }
+    else {
+      wm_autosave_write_memfile_job(wm, memfile, filepath);
+    }
   }
   else {
     if (use_memfile) {
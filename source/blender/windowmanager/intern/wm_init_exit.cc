@@ -306,7 +306,9 @@ void WM_init(bContext *C, int argc, const char **argv)
   BLT_lang_set(nullptr);
 
   /* For file-system. Called here so can include user preference paths if needed. */
-  ED_file_init();
+  if ((G.f & G_FLAG_RENDER_NODE) == 0) {
+    ED_file_init();
+  }
 
   if (!G.background) {
     GPU_render_begin();
@@ -351,7 +353,10 @@ void WM_init(bContext *C, int argc, const char **argv)
   BKE_material_copybuf_clear();
   ED_render_clear_mtex_copybuf();
 
-  wm_history_file_read();
+  /* Recent files are only used by the interface. */
+  if ((G.f & G_FLAG_RENDER_NODE) == 0) {
+    wm_history_file_read();
+  }
 
   BLI_strncpy(G.lib, BKE_main_blendfile_path_from_global(), sizeof(G.lib));
 
@@ -14,6 +14,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_math_base.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -52,7 +53,20 @@
  *
  * When job is done:
  * - it puts timer to sleep (or removes?)
+ *
+ * Background jobs
+ * - jobs the user is not directly waiting for (previews, thumbnails, shader compilation...)
+ *   share a small budget of threads, jobs over the budget stay suspended until one ends
+ * - while the user interacts with the interface no new background jobs are started
+ */
+
+/**
+ * Background jobs are not started while there was user input in this time (in seconds).
  */
+#define WM_JOBS_INTERACTION_DELAY 0.25
+
+/** Time of the last user input, see #wm_jobs_user_interaction_tag. */
+static double wm_jobs_interaction_time = 0.0;
 
 struct wmJob {
   struct wmJob *next, *prev;
@@ -385,6 +399,56 @@ static void *do_job_thread(void *job_v)
   return NULL;
 }
 
+/**
+ * Background jobs are started by the interface on its own, they don't block the user but compete
+ * with the work the user is waiting for. Jobs the user started explicitly are never background
+ * jobs.
+ */
+static bool wm_job_is_background(const wmJob *wm_job)
+{
+  if (wm_job->flag & (WM_JOB_PRIORITY | WM_JOB_EXCL_RENDER)) {
+    return false;
+  }
+  return ELEM(wm_job->job_type,
+              WM_JOB_TYPE_RENDER_PREVIEW,
+              WM_JOB_TYPE_LOAD_PREVIEW,
+              WM_JOB_TYPE_CLIP_BUILD_PROXY,
+              WM_JOB_TYPE_CLIP_PREFETCH,
+              WM_JOB_TYPE_SEQ_BUILD_PROXY,
+              WM_JOB_TYPE_SEQ_BUILD_PREVIEW,
+              WM_JOB_TYPE_SHADER_COMPILATION,
+              WM_JOB_TYPE_STUDIOLIGHT,
+              WM_JOB_TYPE_FSMENU_BOOKMARK_VALIDATE,
+              WM_JOB_TYPE_SEQ_DRAW_THUMBNAIL);
+}
+
+/**
+ * Maximum number of background jobs running at the same time. Many of them use multiple threads
+ * internally, so only a fraction of the cores is given to them.
+ */
+static int wm_jobs_background_budget(void)
+{
+  return max_ii(1, BLI_system_thread_count() / 8);
+}
+
+/**
+ * Background jobs wait while the user interacts, or when the budget is used by other jobs.
+ */
+static bool wm_jobs_background_test_suspend(const wmWindowManager *wm, const wmJob *test)
+{
+  if (PIL_check_seconds_timer() - wm_jobs_interaction_time < WM_JOBS_INTERACTION_DELAY) {
+    return true;
+  }
+
+  int running_num = 0;
+  LISTBASE_FOREACH (const wmJob *, wm_job, &wm->jobs) {
+    if (wm_job != test && wm_job->running && wm_job_is_background(wm_job)) {
+      running_num++;
+    }
+  }
+  return running_num >= wm_jobs_background_budget();
+}
+
 /* don't allow same startjob to be executed twice */
 static void wm_jobs_test_suspend_stop(wmWindowManager *wm, wmJob *test)
 {
@@ -425,6 +489,10 @@ static void wm_jobs_test_suspend_stop(wmWindowManager *wm, wmJob *test)
         // printf("job stopped: %s\n", wm_job->name);
       }
     }
+
+    if (!suspend && wm_job_is_background(test)) {
+      suspend = wm_jobs_background_test_suspend(wm, test);
+    }
   }
 
   /* Possible suspend ourselves, waiting for other jobs, or de-suspend. */
@@ -604,6 +672,11 @@ void WM_jobs_kill(wmWindowManager *wm,
   }
 }
 
+void wm_jobs_user_interaction_tag(void)
+{
+  wm_jobs_interaction_time = PIL_check_seconds_timer();
+}
+
 void wm_jobs_timer_end(wmWindowManager *wm, wmTimer *wt)
 {
   LISTBASE_FOREACH (wmJob *, wm_job, &wm->jobs) {
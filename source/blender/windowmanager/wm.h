@@ -87,6 +87,10 @@ void wm_jobs_timer(wmWindowManager *wm, wmTimer *wt);
  * Kill job entirely, also removes timer itself.
  */
 void wm_jobs_timer_end(wmWindowManager *wm, wmTimer *wt);
+/**
+ * Tag user input, starting background jobs is delayed while the user interacts.
+ */
+void wm_jobs_user_interaction_tag(void);
 
 /* wm_files.cc */
 
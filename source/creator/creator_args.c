@@ -496,6 +496,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 
   printf("Render Options:\n");
   BLI_args_print_arg_doc(ba, "--background");
+  BLI_args_print_arg_doc(ba, "--render-node");
   BLI_args_print_arg_doc(ba, "--render-anim");
   BLI_args_print_arg_doc(ba, "--scene");
   BLI_args_print_arg_doc(ba, "--render-frame");
@@ -782,6 +783,23 @@ static int arg_handle_background_mode_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_render_node_mode_set_doc[] =
+    "\n\t"
+    "Run in background like '--background', also skipping the start-up of features only the\n"
+    "\tuser interface needs (file browser bookmarks, recent files), for render farms.\n"
+    "\tScripts can check for this mode with 'bpy.app.use_render_node'.";
+static int arg_handle_render_node_mode_set(int UNUSED(argc),
+                                           const char **UNUSED(argv),
+                                           void *UNUSED(data))
+{
+  if (!G.background) {
+    print_version_short();
+  }
+  G.background = 1;
+  G.f |= G_FLAG_RENDER_NODE;
+  return 0;
+}
+
 static const char arg_handle_log_level_set_doc[] =
     "<level>\n"
     "\tSet the logging verbosity level (higher for more details) defaults to 1,\n"
@@ -2160,6 +2178,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--disable-abort-handler", CB(arg_handle_abort_handler_disable), NULL);
 
   BLI_args_add(ba, "-b", "--background", CB(arg_handle_background_mode_set), NULL);
+  BLI_args_add(ba, NULL, "--render-node", CB(arg_handle_render_node_mode_set), NULL);
 
   BLI_args_add(ba, "-a", NULL, CB(arg_handle_playback_mode), NULL);
 
@@ -5,3 +5,4 @@ from .device import TestDevice, TestMachine
 from .config import TestEntry, TestQueue, TestConfig
 from .test import Test, TestCollection
 from .graph import TestGraph
+from .measure import PhaseTimer, peak_memory, run_iterations
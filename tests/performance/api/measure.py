@@ -0,0 +1,60 @@
+# SPDX-License-Identifier: Apache-2.0
+
+# Measurement utilities, used by the test functions running inside Blender.
+
+import sys
+import time
+from typing import Callable, Dict
+
+
+def peak_memory() -> float:
+    # Peak resident memory of the Blender process in bytes, -1 when unknown on this platform.
+    try:
+        import resource
+    except ImportError:
+        return -1.0
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Reported in bytes on macOS and in kilobytes on other platforms.
+    return float(peak) if sys.platform == 'darwin' else float(peak) * 1024.0
+
+
+class PhaseTimer:
+    # Accumulate timings of named phases over multiple iterations, to report the average
+    # time of each phase alongside the average total time.
+
+    def __init__(self):
+        self.phase_times = {}
+        self.iterations = 0
+
+    def phase(self, name: str, function: Callable, *args, **kwargs):
+        start_time = time.perf_counter()
+        result = function(*args, **kwargs)
+        elapsed_time = time.perf_counter() - start_time
+        self.phase_times[name] = self.phase_times.get(name, 0.0) + elapsed_time
+        return result
+
+    def next_iteration(self) -> None:
+        self.iterations += 1
+
+    def result(self) -> Dict:
+        iterations = max(self.iterations, 1)
+        result = {'time': sum(self.phase_times.values()) / iterations}
+        for name, phase_time in self.phase_times.items():
+            result['time_' + name] = phase_time / iterations
+        result['peak_memory'] = peak_memory()
+        return result
+
+
+def run_iterations(function: Callable, min_measurements=3, max_measurements=100, timeout=5.0) -> None:
+    # Run the function repeatedly, at least min_measurements times and until the timeout.
+    test_time_start = time.perf_counter()
+    measurements = 0
+    while True:
+        function()
+        measurements += 1
+
+        if measurements >= min_measurements and test_time_start + timeout < time.perf_counter():
+            break
+        if measurements >= max_measurements:
+            break
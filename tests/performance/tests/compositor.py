@@ -0,0 +1,45 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+
+    scene = bpy.context.scene
+    scene.render.use_compositing = True
+    scene.render.use_sequencer = False
+
+    # Files are expected to composite images rather than render layers, so that rendering is
+    # dominated by the compositor. Render once first to load images.
+    bpy.ops.render.render()
+
+    timer = api.PhaseTimer()
+
+    def iteration():
+        timer.phase('composite', bpy.ops.render.render)
+        timer.next_iteration()
+
+    api.run_iterations(iteration)
+    return timer.result()
+
+
+class CompositorTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, {}, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('compositor/*')
+    return [CompositorTest(filepath) for filepath in filepaths]
@@ -0,0 +1,85 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+OBJECTS_NUM = 5000
+
+
+def _create_scene(bpy):
+    # Many objects sharing a mesh, each with a modifier and parented in groups of ten, so that
+    # building relations has a realistic amount of nodes.
+    bpy.ops.wm.read_homefile(use_empty=True)
+    mesh = bpy.data.meshes.new("Mesh")
+    mesh.from_pydata([(0, 0, 0), (1, 0, 0), (1, 1, 0)], [], [(0, 1, 2)])
+    collection = bpy.context.collection
+    parent = None
+    for i in range(OBJECTS_NUM):
+        ob = bpy.data.objects.new("Object%d" % i, mesh)
+        ob.location = (i % 100, i // 100, 0.0)
+        ob.modifiers.new("Displace", 'DISPLACE')
+        if i % 10 != 0:
+            ob.parent = parent
+        else:
+            parent = ob
+        collection.objects.link(ob)
+    bpy.context.view_layer.update()
+
+
+def _run_relations(args):
+    import bpy
+
+    _create_scene(bpy)
+    extra = bpy.data.objects.new("Extra", None)
+    collection = bpy.context.collection
+    timer = api.PhaseTimer()
+
+    def iteration():
+        # Linking and unlinking an object tags the relations for a full rebuild.
+        collection.objects.link(extra)
+        timer.phase('relations_update', bpy.context.view_layer.update)
+        collection.objects.unlink(extra)
+        timer.phase('relations_update', bpy.context.view_layer.update)
+        timer.next_iteration()
+
+    api.run_iterations(iteration, min_measurements=5)
+    return timer.result()
+
+
+def _run_undo(args):
+    import bpy
+
+    _create_scene(bpy)
+    objects = list(bpy.context.view_layer.objects)
+    timer = api.PhaseTimer()
+
+    def iteration():
+        # Change one object, which is the common case for an undo step.
+        ob = objects[timer.iterations % len(objects)]
+        ob.location.z += 1.0
+        timer.phase('undo_push', bpy.ops.ed.undo_push, message="Benchmark")
+        timer.next_iteration()
+
+    api.run_iterations(iteration, min_measurements=5)
+    return timer.result()
+
+
+class DepsgraphTest(api.Test):
+    def __init__(self, test_name, function):
+        self.test_name = test_name
+        self.function = function
+
+    def name(self):
+        return self.test_name
+
+    def category(self):
+        return "depsgraph"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(self.function, {})
+        return result
+
+
+def generate(env):
+    return [DepsgraphTest('relations_rebuild', _run_relations),
+            DepsgraphTest('undo_push', _run_undo)]
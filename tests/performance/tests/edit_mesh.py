@@ -0,0 +1,74 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+# Edit-mode operators to measure, run on a generated grid with all elements selected.
+OPERATORS = {
+    'subdivide': ('mesh.subdivide', {'number_cuts': 1}),
+    'extrude': ('mesh.extrude_region', {}),
+    'bevel': ('mesh.bevel', {'offset': 0.001, 'affect': 'EDGES'}),
+    'triangulate': ('mesh.quads_convert_to_tris', {}),
+    'merge_by_distance': ('mesh.remove_doubles', {'threshold': 0.0001}),
+    'recalculate_normals': ('mesh.normals_make_consistent', {}),
+    'delete_faces': ('mesh.delete', {'type': 'FACE'}),
+}
+
+GRID_SUBDIVISIONS = 500
+
+
+def _run(args):
+    import bpy
+
+    operator_module, operator_name = args['operator'].split('.')
+    operator = getattr(getattr(bpy.ops, operator_module), operator_name)
+    operator_args = args['operator_args']
+
+    def create_grid():
+        bpy.ops.object.select_all(action='DESELECT')
+        bpy.ops.mesh.primitive_grid_add(x_subdivisions=GRID_SUBDIVISIONS,
+                                        y_subdivisions=GRID_SUBDIVISIONS,
+                                        size=10.0)
+        return bpy.context.view_layer.objects.active
+
+    timer = api.PhaseTimer()
+
+    def iteration():
+        ob = create_grid()
+
+        timer.phase('edit_enter', bpy.ops.object.mode_set, mode='EDIT')
+        bpy.ops.mesh.select_all(action='SELECT')
+        timer.phase('operator', operator, **operator_args)
+        timer.phase('edit_exit', bpy.ops.object.mode_set, mode='OBJECT')
+        timer.phase('evaluate', bpy.context.view_layer.update)
+        timer.next_iteration()
+
+        mesh = ob.data
+        bpy.data.objects.remove(ob)
+        bpy.data.meshes.remove(mesh)
+
+    api.run_iterations(iteration)
+    return timer.result()
+
+
+class EditMeshTest(api.Test):
+    def __init__(self, name, operator, operator_args):
+        self.test_name = name
+        self.operator = operator
+        self.operator_args = operator_args
+
+    def name(self):
+        return self.test_name
+
+    def category(self):
+        return "edit_mesh"
+
+    def run(self, env, device_id):
+        args = {'operator': self.operator, 'operator_args': self.operator_args}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [EditMeshTest(name, operator, operator_args)
+            for name, (operator, operator_args) in OPERATORS.items()]
@@ -0,0 +1,73 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import tempfile
+
+    file_format = args['format']
+    if file_format == 'alembic' and not bpy.app.build_options.alembic:
+        return {}
+
+    # Evaluate objects once first, exporters write evaluated geometry.
+    bpy.context.view_layer.update()
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        if file_format == 'obj':
+            filepath = os.path.join(temp_dir, "benchmark.obj")
+
+            def export_file():
+                bpy.ops.wm.obj_export(filepath=filepath)
+
+            def import_file():
+                bpy.ops.wm.obj_import(filepath=filepath)
+        else:
+            filepath = os.path.join(temp_dir, "benchmark.abc")
+
+            def export_file():
+                bpy.ops.wm.alembic_export(filepath=filepath, start=1, end=1)
+
+            def import_file():
+                bpy.ops.wm.alembic_import(filepath=filepath, as_background_job=False)
+
+        timer = api.PhaseTimer()
+
+        def iteration():
+            timer.phase('export', export_file)
+            objects = set(bpy.data.objects)
+            timer.phase('import', import_file)
+            for ob in set(bpy.data.objects) - objects:
+                bpy.data.objects.remove(ob)
+            timer.next_iteration()
+
+        api.run_iterations(iteration, max_measurements=10)
+        result = timer.result()
+        result['file_size'] = os.path.getsize(filepath)
+        return result
+
+
+class IOTest(api.Test):
+    def __init__(self, filepath, file_format):
+        self.filepath = filepath
+        self.file_format = file_format
+
+    def name(self):
+        return f"{self.filepath.stem}_{self.file_format}"
+
+    def category(self):
+        return "io"
+
+    def run(self, env, device_id):
+        args = {'format': self.file_format}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('io/*')
+    return [IOTest(filepath, file_format)
+            for filepath in filepaths
+            for file_format in ('obj', 'alembic')]
@@ -0,0 +1,107 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _create_subsurf(bpy):
+    bpy.ops.mesh.primitive_monkey_add()
+    ob = bpy.context.view_layer.objects.active
+    modifier = ob.modifiers.new("Subdivision", 'SUBSURF')
+    modifier.levels = 5
+    return ob
+
+
+def _create_boolean(bpy):
+    bpy.ops.mesh.primitive_uv_sphere_add(segments=256, ring_count=128, location=(0.5, 0.0, 0.0))
+    cutter = bpy.context.view_layer.objects.active
+    cutter.hide_set(True)
+
+    bpy.ops.mesh.primitive_uv_sphere_add(segments=256, ring_count=128)
+    ob = bpy.context.view_layer.objects.active
+    modifier = ob.modifiers.new("Boolean", 'BOOLEAN')
+    modifier.object = cutter
+    modifier.solver = 'EXACT'
+    return ob
+
+
+def _create_armature(bpy):
+    # Grid deformed by a chain of bones, every vertex weighted to the two nearest bones.
+    bones_num = 64
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=1000, y_subdivisions=100, size=2.0)
+    ob = bpy.context.view_layer.objects.active
+    ob.scale = (bones_num / 2.0, 1.0, 1.0)
+
+    armature = bpy.data.armatures.new("Armature")
+    rig = bpy.data.objects.new("Armature", armature)
+    bpy.context.collection.objects.link(rig)
+    bpy.context.view_layer.objects.active = rig
+    bpy.ops.object.mode_set(mode='EDIT')
+    for i in range(bones_num):
+        bone = armature.edit_bones.new("Bone%d" % i)
+        bone.head = (i - bones_num / 2.0, 0.0, 0.0)
+        bone.tail = (i + 1 - bones_num / 2.0, 0.0, 0.0)
+    bpy.ops.object.mode_set(mode='OBJECT')
+
+    groups = [ob.vertex_groups.new(name="Bone%d" % i) for i in range(bones_num)]
+    for vert in ob.data.vertices:
+        position = (vert.co.x * ob.scale.x) + bones_num / 2.0
+        index = min(max(int(position), 0), bones_num - 1)
+        factor = position - index
+        groups[index].add([vert.index], 1.0 - factor, 'REPLACE')
+        if index + 1 < bones_num:
+            groups[index + 1].add([vert.index], factor, 'REPLACE')
+
+    modifier = ob.modifiers.new("Armature", 'ARMATURE')
+    modifier.object = rig
+
+    for i, pose_bone in enumerate(rig.pose.bones):
+        pose_bone.rotation_mode = 'XYZ'
+        pose_bone.rotation_euler.x = 0.1 * i
+    return ob
+
+
+STACKS = {
+    'subsurf': _create_subsurf,
+    'boolean': _create_boolean,
+    'armature': _create_armature,
+}
+
+
+def _run(args):
+    import bpy
+
+    bpy.ops.wm.read_homefile(use_empty=True)
+    ob = STACKS[args['stack']](bpy)
+
+    # Evaluate once first, to avoid any possible lazy evaluation later.
+    bpy.context.view_layer.update()
+
+    timer = api.PhaseTimer()
+
+    def iteration():
+        ob.update_tag()
+        timer.phase('evaluate', bpy.context.view_layer.update)
+        timer.next_iteration()
+
+    api.run_iterations(iteration, min_measurements=5)
+    return timer.result()
+
+
+class ModifierStackTest(api.Test):
+    def __init__(self, stack):
+        self.stack = stack
+
+    def name(self):
+        return self.stack
+
+    def category(self):
+        return "modifiers"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, {'stack': self.stack})
+        return result
+
+
+def generate(env):
+    return [ModifierStackTest(stack) for stack in STACKS.keys()]
@@ -0,0 +1,113 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import os
+import time
+
+STROKES_NUM = 10
+STROKE_SAMPLES = 100
+LOG_KEY = "SCULPT_PERFORMANCE: "
+
+
+def _stroke(brush_radius):
+    # Horizontal stroke through the center of the region, in region space.
+    region = _find_region()
+    center_x = region.width / 2
+    center_y = region.height / 2
+    stroke = []
+    for i in range(STROKE_SAMPLES):
+        x = center_x + (i - STROKE_SAMPLES / 2) * (region.width / (2 * STROKE_SAMPLES))
+        stroke.append({
+            "name": "",
+            "location": (0.0, 0.0, 0.0),
+            "mouse": (x, center_y),
+            "mouse_event": (x, center_y),
+            "pressure": 1.0,
+            "size": brush_radius,
+            "pen_flip": False,
+            "time": float(i),
+            "is_start": i == 0,
+            "x_tilt": 0.0,
+            "y_tilt": 0.0,
+        })
+    return stroke
+
+
+def _find_region():
+    import bpy
+
+    for area in bpy.context.window_manager.windows[0].screen.areas:
+        if area.type == 'VIEW_3D':
+            for region in area.regions:
+                if region.type == 'WINDOW':
+                    return region
+    raise Exception("No 3D viewport found")
+
+
+def _run(args):
+    import bpy
+
+    # Strokes need a window and 3D viewport, run once the window is drawn.
+    bpy.app.timers.register(_run_strokes, first_interval=1.0)
+
+
+def _run_strokes():
+    import bpy
+    import resource
+    import sys
+
+    window = bpy.context.window_manager.windows[0]
+    screen = window.screen
+    area = next(area for area in screen.areas if area.type == 'VIEW_3D')
+    region = _find_region()
+
+    with bpy.context.temp_override(window=window, area=area, region=region):
+        if bpy.context.object.mode != 'SCULPT':
+            bpy.ops.object.mode_set(mode='SCULPT')
+
+        stroke = _stroke(bpy.context.tool_settings.unified_paint_settings.size)
+        bpy.ops.sculpt.brush_stroke(stroke=stroke)
+
+        start_time = time.perf_counter()
+        for _ in range(STROKES_NUM):
+            bpy.ops.sculpt.brush_stroke(stroke=stroke)
+        elapsed_time = time.perf_counter() - start_time
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    peak_memory = peak if sys.platform == 'darwin' else peak * 1024
+    samples_per_second = STROKES_NUM * STROKE_SAMPLES / elapsed_time
+    print(f"{LOG_KEY}{{'time': {elapsed_time / STROKES_NUM}, "
+          f"'samples_per_second': {samples_per_second}, 'peak_memory': {peak_memory} }}")
+    bpy.ops.wm.quit_blender()
+    return None
+
+
+if __name__ == '__main__':
+    _run(None)
+
+else:
+    import api
+
+    class SculptTest(api.Test):
+        def __init__(self, filepath):
+            self.filepath = filepath
+
+        def name(self):
+            return self.filepath.stem
+
+        def category(self):
+            return "sculpt"
+
+        def run(self, env, device_id):
+            args = {}
+            _, log = env.run_in_blender(_run, args, [self.filepath], foreground=True)
+            for line in log:
+                if line.startswith(LOG_KEY):
+                    result_str = line[len(LOG_KEY):]
+                    result = eval(result_str)
+                    return result
+
+            raise Exception("No sculpt performance result found in log.")
+
+    def generate(env):
+        filepaths = env.find_blend_files('sculpt/*')
+        return [SculptTest(filepath) for filepath in filepaths]
@@ -0,0 +1,51 @@
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+
+    scene = bpy.context.scene
+    scene.render.use_sequencer = True
+    scene.render.use_compositing = False
+    # Disable the cache, otherwise only the first playback would be measured.
+    scene.sequence_editor.use_cache_raw = False
+    scene.sequence_editor.use_cache_preprocessed = False
+    scene.sequence_editor.use_cache_composite = False
+    scene.sequence_editor.use_cache_final = False
+
+    frames_num = min(scene.frame_end - scene.frame_start + 1, 50)
+    timer = api.PhaseTimer()
+
+    def iteration():
+        for frame in range(scene.frame_start, scene.frame_start + frames_num):
+            scene.frame_set(frame)
+            timer.phase('frame', bpy.ops.render.render)
+        timer.next_iteration()
+
+    api.run_iterations(iteration, min_measurements=1, max_measurements=3)
+    result = timer.result()
+    result['fps'] = frames_num / result['time'] if result['time'] > 0.0 else 0.0
+    return result
+
+
+class SequencerTest(api.Test):
+    def __init__(self, filepath):
+        self.filepath = filepath
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return "sequencer"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, {}, [self.filepath])
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('sequencer/*')
+    return [SequencerTest(filepath) for filepath in filepaths]
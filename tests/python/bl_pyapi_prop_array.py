@@ -195,6 +195,43 @@ class TestPropArrayMultiDimensional(unittest.TestCase):
         del id_type.temp
 
 
+
+class TestPropCollectionForeach(unittest.TestCase):
+    def setUp(self):
+        self.mesh = bpy.data.meshes.new("test_foreach")
+        self.mesh.vertices.add(4)
+        self.attr_f = self.mesh.attributes.new("test_f", 'FLOAT', 'POINT')
+        self.attr_i = self.mesh.attributes.new("test_i", 'INT', 'POINT')
+
+    def tearDown(self):
+        bpy.data.meshes.remove(self.mesh)
+
+    def test_foreach_getset_converted(self):
+        # Buffers of other types than the property are converted without a sequence fallback.
+        self.attr_f.data.foreach_set("value", np.arange(4, dtype=np.float64) + 0.5)
+        b = np.zeros(4, dtype=np.float64)
+        self.attr_f.data.foreach_get("value", b)
+        self.assertEqual(list(b), [0.5, 1.5, 2.5, 3.5])
+
+        self.attr_i.data.foreach_set("value", np.array([1.0, -2.0, 3.0, -4.0], dtype=np.float32))
+        b = np.zeros(4, dtype=np.float64)
+        self.attr_i.data.foreach_get("value", b)
+        self.assertEqual(list(b), [1.0, -2.0, 3.0, -4.0])
+
+        co = np.arange(12, dtype=np.float64)
+        self.mesh.vertices.foreach_set("co", co)
+        b = np.zeros(12, dtype=np.float32)
+        self.mesh.vertices.foreach_get("co", b)
+        self.assertEqual(list(b), list(co))
+
+    def test_foreach_get_readonly_buffer(self):
+        # Read-only buffers must not be written to, they fall back to the sequence path.
+        b = np.zeros(4, dtype=np.float32)
+        b.flags.writeable = False
+        with self.assertRaises(TypeError):
+            self.attr_f.data.foreach_get("value", b)
+
+
 if __name__ == '__main__':
     import sys
     sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])